@@ -2,6 +2,8 @@ COMMON_SRC = \
             build/main.c \
             build/build_config.c \
             build/debug.c \
+            build/profiler.c \
+            build/benchmark.c \
             build/debug_pin.c \
             build/version.c \
             $(TARGET_DIR_SRC) \
@@ -49,11 +51,14 @@ COMMON_SRC = \
             drivers/timer.c \
             drivers/freq.c \
             fc/board_info.c \
+            fc/boot_timeline.c \
             fc/dispatch.c \
+            fc/eventlog.c \
             fc/hardfaults.c \
             fc/tasks.c \
             fc/runtime_config.c \
             fc/stats.c \
+            fc/watchdog.c \
             io/beeper.c \
             io/piniobox.c \
             io/serial.c \
@@ -97,9 +102,11 @@ COMMON_SRC = \
             flight/servos.c \
             flight/governor.c \
             flight/trainer.c \
+            flight/vibration.c \
             flight/leveling.c \
             flight/rescue.c \
             flight/setpoint.c \
+            flight/sysid.c \
             io/serial_4way.c \
             io/serial_4way_avrootloader.c \
             io/serial_4way_stk500v2.c \
@@ -112,10 +119,12 @@ COMMON_SRC = \
             rx/rx_bind.c \
             rx/rx_spi.c \
             rx/rx_spi_common.c \
+            rx/rx_timing.c \
             rx/crsf.c \
             rx/ghst.c \
             rx/sbus.c \
             rx/sbus_channels.c \
+            rx/serial_frame.c \
             rx/spektrum.c \
             rx/srxl2.c \
             io/spektrum_vtx_control.c \
@@ -184,6 +193,7 @@ COMMON_SRC = \
             telemetry/hott.c \
             telemetry/jetiexbus.c \
             telemetry/smartport.c \
+            telemetry/sensors.c \
             telemetry/ltm.c \
             telemetry/mavlink.c \
             telemetry/msp_shared.c \
@@ -218,6 +228,7 @@ SPEED_OPTIMISED_SRC := ""
 SIZE_OPTIMISED_SRC  := ""
 
 SPEED_OPTIMISED_SRC := $(SPEED_OPTIMISED_SRC) \
+            build/benchmark.c \
             common/encoding.c \
             common/filter.c \
             common/maths.c \
@@ -260,10 +271,12 @@ SPEED_OPTIMISED_SRC := $(SPEED_OPTIMISED_SRC) \
             rx/ibus.c \
             rx/rx.c \
             rx/rx_spi.c \
+            rx/rx_timing.c \
             rx/crsf.c \
             rx/frsky_crc.c \
             rx/sbus.c \
             rx/sbus_channels.c \
+            rx/serial_frame.c \
             rx/spektrum.c \
             rx/srxl2.c \
             rx/sumd.c \
@@ -313,6 +326,7 @@ SIZE_OPTIMISED_SRC := $(SIZE_OPTIMISED_SRC) \
             drivers/vtx_common.c \
             fc/init.c \
             fc/board_info.c \
+            fc/boot_timeline.c \
             config/config_eeprom.c \
             config/feature.c \
             config/config_streamer.c \
@@ -400,6 +414,7 @@ SRC += \
             drivers/flash_w25q128fv.c \
             drivers/flash_w25m.c \
             io/flashfs.c \
+            io/flashlog.c \
             $(MSC_SRC)
 endif
 
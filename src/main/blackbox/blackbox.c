@@ -68,6 +68,8 @@
 #include "flight/governor.h"
 #include "flight/rescue.h"
 #include "flight/position.h"
+#include "flight/setpoint.h"
+#include "flight/sysid.h"
 
 #include "io/beeper.h"
 #include "io/gps.h"
@@ -80,6 +82,8 @@
 
 #include "rx/rx.h"
 
+#include "scheduler/scheduler.h"
+
 #include "sensors/acceleration.h"
 #include "sensors/adcinternal.h"
 #include "sensors/barometer.h"
@@ -97,7 +101,7 @@
 #define DEFAULT_BLACKBOX_DEVICE     BLACKBOX_DEVICE_SERIAL
 #endif
 
-PG_REGISTER_WITH_RESET_TEMPLATE(blackboxConfig_t, blackboxConfig, PG_BLACKBOX_CONFIG, 2);
+PG_REGISTER_WITH_RESET_TEMPLATE(blackboxConfig_t, blackboxConfig, PG_BLACKBOX_CONFIG, 6);
 
 PG_RESET_TEMPLATE(blackboxConfig_t, blackboxConfig,
     .device = DEFAULT_BLACKBOX_DEVICE,
@@ -114,6 +118,12 @@ PG_RESET_TEMPLATE(blackboxConfig_t, blackboxConfig,
               BIT(FLIGHT_LOG_FIELD_SELECT_RPM) |
               BIT(FLIGHT_LOG_FIELD_SELECT_MOTOR) |
               BIT(FLIGHT_LOG_FIELD_SELECT_SERVO),
+    .serial_framing = false,
+    .compression = BLACKBOX_COMPRESSION_NONE,
+    .mixer_denom = 1,
+    .sensor_denom = 1,
+    .trigger = 0,
+    .trigger_time = 1000,
 );
 
 STATIC_ASSERT((sizeof(blackboxConfig()->fields) * 8) >= FLIGHT_LOG_FIELD_SELECT_COUNT, too_many_flight_log_fields_selections);
@@ -313,6 +323,14 @@ static const blackboxDeltaFieldDefinition_t blackboxMainFields[] =
     {"debug",       5, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),    .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB),  CONDITION(DEBUG)},
     {"debug",       6, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),    .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB),  CONDITION(DEBUG)},
     {"debug",       7, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),    .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB),  CONDITION(DEBUG)},
+    {"debug",       8, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),    .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB),  CONDITION(DEBUG_2)},
+    {"debug",       9, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),    .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB),  CONDITION(DEBUG_2)},
+    {"debug",      10, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),    .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB),  CONDITION(DEBUG_2)},
+    {"debug",      11, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),    .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB),  CONDITION(DEBUG_2)},
+    {"debug",      12, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),    .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB),  CONDITION(DEBUG_2)},
+    {"debug",      13, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),    .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB),  CONDITION(DEBUG_2)},
+    {"debug",      14, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),    .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB),  CONDITION(DEBUG_2)},
+    {"debug",      15, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),    .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB),  CONDITION(DEBUG_2)},
 
 };
 
@@ -342,7 +360,9 @@ static const blackboxSimpleFieldDefinition_t blackboxSlowFields[] = {
 
     {"failsafePhase",         -1, UNSIGNED, PREDICT(0),      ENCODING(TAG2_3S32)},
     {"rxSignalReceived",      -1, UNSIGNED, PREDICT(0),      ENCODING(TAG2_3S32)},
-    {"rxFlightChannelsValid", -1, UNSIGNED, PREDICT(0),      ENCODING(TAG2_3S32)}
+    {"rxFlightChannelsValid", -1, UNSIGNED, PREDICT(0),      ENCODING(TAG2_3S32)},
+    {"rxLatency",             -1, UNSIGNED, PREDICT(0),      ENCODING(UNSIGNED_VB)},
+    {"rxJitter",              -1, UNSIGNED, PREDICT(0),      ENCODING(UNSIGNED_VB)}
 };
 
 typedef enum BlackboxState {
@@ -410,7 +430,7 @@ typedef struct blackboxMainState_s {
     int16_t motor[MAX_SUPPORTED_MOTORS];
     int16_t servo[MAX_SUPPORTED_SERVOS];
 
-    int32_t debug[DEBUG_VALUE_COUNT];
+    int32_t debug[DEBUG_SLOT_COUNT];
 
 } blackboxMainState_t;
 
@@ -427,6 +447,8 @@ typedef struct blackboxSlowState_s {
     uint8_t failsafePhase;
     bool rxSignalReceived;
     bool rxFlightChannelsValid;
+    uint16_t rxLatency;
+    uint16_t rxJitter;
 } __attribute__((__packed__)) blackboxSlowState_t; // We pack this struct so that padding doesn't interfere with memcmp()
 
 //From rc_controls.c
@@ -441,6 +463,10 @@ static uint32_t blackboxLastFlightModeFlags = 0; // New event tracking of flight
 static uint8_t  blackboxLastGovState = 0;
 static uint8_t  blackboxLastRescueState = 0;
 static uint8_t  blackboxLastAirborneState = 0;
+static uint16_t blackboxLastGovAutotune = 0;
+#ifdef USE_SYSID
+static uint16_t blackboxLastSysid = 0;
+#endif
 
 static struct {
     uint32_t headerIndex;
@@ -462,6 +488,8 @@ STATIC_ASSERT((sizeof(blackboxConditionCache) * 8) >= FLIGHT_LOG_FIELD_CONDITION
 static uint32_t blackboxIteration;
 
 static uint32_t blackboxPInterval = 0;
+static uint32_t blackboxMixerDenom = 1;
+static uint32_t blackboxSensorDenom = 1;
 static uint32_t blackboxIInterval = 0;
 static uint32_t blackboxSInterval = 0;
 static uint32_t blackboxGInterval = 0;
@@ -481,12 +509,67 @@ static uint16_t vbatReference;
 static blackboxGpsState_t gpsHistory;
 static blackboxSlowState_t slowHistory;
 
-// Keep a history of length 2, plus a buffer for MW to store the new values into
-static blackboxMainState_t blackboxHistoryRing[3];
-
-// These point into blackboxHistoryRing, use them to know where to store history of a given age (0, 1 or 2 generations old)
+// The frame being encoded, and the two encoded before it (0, 1 or 2 generations old)
 static blackboxMainState_t* blackboxHistory[3];
 
+/*
+ * Main frames are captured in the PID loop into a small queue of
+ * snapshots, and encoded later from the BLACKBOX task. Only when the
+ * queue is full the encoding is done inline in the PID loop.
+ *
+ * The frames are encoded in place, and the history points into the queue,
+ * so the last two encoded snapshots are kept from being overwritten.
+ */
+#define BLACKBOX_SNAPSHOT_COUNT    8
+#define BLACKBOX_SNAPSHOT_HISTORY  2
+
+typedef struct {
+    blackboxMainState_t state;
+    uint32_t iteration;
+    bool iFrame;
+} blackboxSnapshot_t;
+
+static blackboxSnapshot_t blackboxSnapshot[BLACKBOX_SNAPSHOT_COUNT];
+
+static uint8_t blackboxSnapshotHead;
+static uint8_t blackboxSnapshotTail;
+
+STATIC_ASSERT((BLACKBOX_SNAPSHOT_COUNT & (BLACKBOX_SNAPSHOT_COUNT - 1)) == 0, blackbox_snapshot_count_not_power_of_two);
+
+static void blackboxEncodeSnapshots(void);
+
+/*
+ * With any trigger enabled, every PID loop is captured into the trigger
+ * ring, and the frames leave the ring BLACKBOX_TRIGGER_FRAMES loops
+ * later. A frame is logged when it falls on the normal logging rate, or
+ * inside the window around a trigger, where all of them are logged as
+ * I-frames.
+ */
+#if defined(STM32H7)
+#define BLACKBOX_TRIGGER_FRAMES  256
+#elif defined(STM32F7)
+#define BLACKBOX_TRIGGER_FRAMES  64
+#else
+#define BLACKBOX_TRIGGER_FRAMES  16
+#endif
+
+static blackboxSnapshot_t blackboxTriggerRing[BLACKBOX_TRIGGER_FRAMES];
+
+static uint16_t blackboxTriggerHead;
+static uint16_t blackboxTriggerCount;
+
+static bool blackboxTriggerEnabled;
+static bool blackboxTriggered;
+
+static uint32_t blackboxTriggerStart;
+static uint32_t blackboxTriggerEnd;
+static uint32_t blackboxTriggerFrames;
+
+static uint8_t blackboxTriggerState;
+static uint8_t blackboxTriggerGovState;
+
+static void blackboxTriggerFlush(void);
+
 
 /**
  * Return true if it is safe to edit the Blackbox configuration.
@@ -621,7 +704,10 @@ static bool testBlackboxConditionUncached(FlightLogFieldCondition condition)
         return adcIsEnabled(ADC_VBUS) && isFieldEnabled(FIELD_SELECT(VBUS));
 
     case CONDITION(DEBUG):
-        return (debugMode != DEBUG_NONE);
+        return (debugModes[0] != DEBUG_NONE);
+
+    case CONDITION(DEBUG_2):
+        return (debugModes[1] != DEBUG_NONE);
 
     case CONDITION(NOT_EVERY_FRAME):
         return (blackboxPInterval > 1);
@@ -651,6 +737,12 @@ static bool testBlackboxCondition(FlightLogFieldCondition condition)
 
 static void blackboxSetState(BlackboxState newState)
 {
+    // Write out the captured frames before anything else
+    if (blackboxState == BLACKBOX_STATE_RUNNING) {
+        blackboxTriggerFlush();
+        blackboxEncodeSnapshots();
+    }
+
     //Perform initial setup required for the new state
     switch (newState) {
     case BLACKBOX_STATE_PREPARE_LOG_FILE:
@@ -673,6 +765,10 @@ static void blackboxSetState(BlackboxState newState)
         break;
     case BLACKBOX_STATE_RUNNING:
         blackboxSlowFrameSkipCounter = blackboxSInterval; //Force a slow frame to be written on the first iteration
+        blackboxTriggerHead = 0;
+        blackboxTriggerCount = 0;
+        blackboxTriggered = false;
+        blackboxDeviceStartCompression();
         break;
     case BLACKBOX_STATE_SHUTTING_DOWN:
         xmitState.u.startTime = millis();
@@ -683,7 +779,7 @@ static void blackboxSetState(BlackboxState newState)
     blackboxState = newState;
 }
 
-static void writeIntraframe(void)
+static void writeIntraframe(uint32_t iteration)
 {
     blackboxMainState_t *blackboxCurrent = blackboxHistory[0];
 
@@ -692,7 +788,7 @@ static void writeIntraframe(void)
 
     blackboxWrite('I');
 
-    blackboxWriteUnsignedVB(blackboxIteration);
+    blackboxWriteUnsignedVB(iteration);
     blackboxWriteUnsignedVB(blackboxCurrent->time);
 
     if (testBlackboxCondition(CONDITION(COMMAND))) {
@@ -794,6 +890,9 @@ static void writeIntraframe(void)
     if (testBlackboxCondition(CONDITION(DEBUG))) {
         blackboxWriteSignedVBArray(blackboxCurrent->debug, DEBUG_VALUE_COUNT);
     }
+    if (testBlackboxCondition(CONDITION(DEBUG_2))) {
+        blackboxWriteSignedVBArray(&blackboxCurrent->debug[DEBUG_VALUE_COUNT], DEBUG_VALUE_COUNT);
+    }
 
     //Rotate our history buffers:
 
@@ -801,8 +900,6 @@ static void writeIntraframe(void)
     blackboxHistory[1] = blackboxHistory[0];
     //And since we have no other history, we also use it for the "before, before" state
     blackboxHistory[2] = blackboxHistory[0];
-    //And advance the current state over to a blank space ready to be filled
-    blackboxHistory[0] = ((blackboxHistory[0] - blackboxHistoryRing + 1) % 3) + blackboxHistoryRing;
 
     blackboxLoggedAnyFrames = true;
 }
@@ -823,7 +920,7 @@ static void blackboxWriteMainStateArrayUsingAveragePredictor(int arrOffsetInHist
 
 #define CALC_DELTAS(delta, next, prev, count) do {  \
     for (int i = 0; i < (count); i++)               \
-        delta[i] = next[i] - prev[i];               \
+        (delta)[i] = (next)[i] - (prev)[i];         \
 } while(0)
 
 
@@ -976,21 +1073,48 @@ static void writeInterframe(void)
         CALC_DELTAS(deltas, blackboxCurrent->debug, blackboxPrev->debug, DEBUG_VALUE_COUNT);
         blackboxWriteSignedVBArray(deltas, DEBUG_VALUE_COUNT);
     }
+    if (testBlackboxCondition(CONDITION(DEBUG_2))) {
+        CALC_DELTAS(deltas, &blackboxCurrent->debug[DEBUG_VALUE_COUNT], &blackboxPrev->debug[DEBUG_VALUE_COUNT], DEBUG_VALUE_COUNT);
+        blackboxWriteSignedVBArray(deltas, DEBUG_VALUE_COUNT);
+    }
 
     // Rotate our history buffers
     blackboxHistory[2] = blackboxHistory[1];
     blackboxHistory[1] = blackboxHistory[0];
-    blackboxHistory[0] = ((blackboxHistory[0] - blackboxHistoryRing + 1) % 3) + blackboxHistoryRing;
 
     blackboxLoggedAnyFrames = true;
 }
 
+static void blackboxEncodeSnapshot(void)
+{
+    blackboxSnapshot_t *snapshot = &blackboxSnapshot[blackboxSnapshotTail % BLACKBOX_SNAPSHOT_COUNT];
+
+    blackboxHistory[0] = &snapshot->state;
+
+    if (snapshot->iFrame)
+        writeIntraframe(snapshot->iteration);
+    else
+        writeInterframe();
+
+    blackboxSnapshotTail++;
+}
+
+static void blackboxEncodeSnapshots(void)
+{
+    while (blackboxSnapshotTail != blackboxSnapshotHead) {
+        blackboxEncodeSnapshot();
+    }
+}
+
 /* Write the contents of the global "slowHistory" to the log as an "S" frame. Because this data is logged so
  * infrequently, delta updates are not reasonable, so we log independent frames. */
 static void writeSlowFrame(void)
 {
     int32_t values[3];
 
+    // Keep the frames in the log order
+    blackboxEncodeSnapshots();
+
     blackboxWrite('S');
 
     blackboxWriteUnsignedVB(slowHistory.flightModeFlags);
@@ -1003,6 +1127,9 @@ static void writeSlowFrame(void)
     values[1] = slowHistory.rxSignalReceived ? 1 : 0;
     values[2] = slowHistory.rxFlightChannelsValid ? 1 : 0;
     blackboxWriteTag2_3S32(values);
+
+    blackboxWriteUnsignedVB(slowHistory.rxLatency);
+    blackboxWriteUnsignedVB(slowHistory.rxJitter);
 }
 
 /**
@@ -1015,6 +1142,8 @@ static void loadSlowState(blackboxSlowState_t *slow)
     slow->failsafePhase = failsafePhase();
     slow->rxSignalReceived = rxIsReceivingSignal();
     slow->rxFlightChannelsValid = rxAreFlightChannelsValid();
+    slow->rxLatency = getSetpointLatency()->avg;
+    slow->rxJitter = getSetpointLatency()->jitter;
 }
 
 /**
@@ -1084,13 +1213,15 @@ static void blackboxStart(void)
 
     memset(&gpsHistory, 0, sizeof(gpsHistory));
 
-    blackboxHistory[0] = &blackboxHistoryRing[0];
-    blackboxHistory[1] = &blackboxHistoryRing[1];
-    blackboxHistory[2] = &blackboxHistoryRing[2];
+    // The first frame is an intra, which replaces all the history
+    blackboxHistory[0] = &blackboxSnapshot[0].state;
+    blackboxHistory[1] = &blackboxSnapshot[0].state;
+    blackboxHistory[2] = &blackboxSnapshot[0].state;
 
-    vbatReference = getBatteryVoltageSample();
+    blackboxSnapshotHead = 0;
+    blackboxSnapshotTail = 0;
 
-    //No need to clear the content of blackboxHistoryRing since our first frame will be an intra which overwrites it
+    vbatReference = getBatteryVoltageSample();
 
     /*
      * We use conditional tests to decide whether or not certain fields should be logged. Since our headers
@@ -1110,6 +1241,13 @@ static void blackboxStart(void)
     blackboxLastGovState = getGovernorState();
     blackboxLastRescueState = getRescueState();
     blackboxLastAirborneState = isAirborne();
+    blackboxLastGovAutotune = getGovernorAutotune()->state << 8 | getGovernorAutotune()->steps;
+#ifdef USE_SYSID
+    blackboxLastSysid = sysidGetStatus()->state << 8 | sysidGetStatus()->axis;
+#endif
+
+    blackboxTriggerState = 0;
+    blackboxTriggerGovState = getGovernorState();
 
     blackboxSetState(BLACKBOX_STATE_PREPARE_LOG_FILE);
 }
@@ -1140,6 +1278,8 @@ void blackboxCheckEnabler(void)
 #ifdef USE_GPS
 static void writeGPSHomeFrame(void)
 {
+    blackboxEncodeSnapshots();
+
     blackboxWrite('H');
 
     blackboxWriteSignedVB(GPS_home[0]);
@@ -1152,6 +1292,8 @@ static void writeGPSHomeFrame(void)
 
 static void writeGPSFrame(timeUs_t currentTimeUs)
 {
+    blackboxEncodeSnapshots();
+
     blackboxWrite('G');
 
     /*
@@ -1181,10 +1323,19 @@ static void writeGPSFrame(timeUs_t currentTimeUs)
 /**
  * Fill the current state of the blackbox using values read from the flight controller
  */
-static void loadMainState(timeUs_t currentTimeUs)
+static void loadMainState(blackboxMainState_t *blackboxCurrent, const blackboxMainState_t *blackboxPrev, timeUs_t currentTimeUs)
 {
 #ifndef UNIT_TEST
-    blackboxMainState_t *blackboxCurrent = blackboxHistory[0];
+
+    /*
+     * Slowly changing field groups are sampled only every Nth main frame.
+     * In between, the previous values are repeated, which the P-frame
+     * predictors encode in a byte or less per field.
+     */
+    const uint32_t frameIndex = blackboxIteration / blackboxPInterval;
+    const bool iFrame = (blackboxIteration % blackboxIInterval) == 0;
+    const bool mixerDue = iFrame || (frameIndex % blackboxMixerDenom) == 0;
+    const bool sensorDue = iFrame || (frameIndex % blackboxSensorDenom) == 0;
 
     blackboxCurrent->time = currentTimeUs;
 
@@ -1196,10 +1347,24 @@ static void loadMainState(timeUs_t currentTimeUs)
 
     blackboxCurrent->command[THROTTLE] = lrintf(getThrottleCommand());
 
-    blackboxCurrent->mixer[0] = lrintf(mixerGetInput(MIXER_IN_STABILIZED_ROLL) * 1000);
-    blackboxCurrent->mixer[1] = lrintf(mixerGetInput(MIXER_IN_STABILIZED_PITCH) * 1000);
-    blackboxCurrent->mixer[2] = lrintf(mixerGetInput(MIXER_IN_STABILIZED_YAW) * 1000);
-    blackboxCurrent->mixer[3] = lrintf(mixerGetInput(MIXER_IN_STABILIZED_COLLECTIVE) * 1000);
+    if (mixerDue) {
+        blackboxCurrent->mixer[0] = lrintf(mixerGetInput(MIXER_IN_STABILIZED_ROLL) * 1000);
+        blackboxCurrent->mixer[1] = lrintf(mixerGetInput(MIXER_IN_STABILIZED_PITCH) * 1000);
+        blackboxCurrent->mixer[2] = lrintf(mixerGetInput(MIXER_IN_STABILIZED_YAW) * 1000);
+        blackboxCurrent->mixer[3] = lrintf(mixerGetInput(MIXER_IN_STABILIZED_COLLECTIVE) * 1000);
+
+        for (int i = 0; i < getMotorCount(); i++) {
+            blackboxCurrent->motor[i] = getMotorOutput(i);
+        }
+
+        for (int i = 0; i < getServoCount(); i++) {
+            blackboxCurrent->servo[i] = getServoOutput(i);
+        }
+    } else {
+        memcpy(blackboxCurrent->mixer, blackboxPrev->mixer, sizeof(blackboxCurrent->mixer));
+        memcpy(blackboxCurrent->motor, blackboxPrev->motor, sizeof(blackboxCurrent->motor));
+        memcpy(blackboxCurrent->servo, blackboxPrev->servo, sizeof(blackboxCurrent->servo));
+    }
 
     const pidAxisData_t *pidData = pidGetAxisData();
 
@@ -1224,48 +1389,60 @@ static void loadMainState(timeUs_t currentTimeUs)
 #endif
     }
 
+    if (sensorDue) {
 #ifdef USE_BARO
-    blackboxCurrent->altitude = getEstimatedAltitudeCm();
+        blackboxCurrent->altitude = getEstimatedAltitudeCm();
 #ifdef USE_VARIO
-    blackboxCurrent->vario = getEstimatedVario();
+        blackboxCurrent->vario = getEstimatedVario();
 #endif
 #endif
 
-    blackboxCurrent->rssi = getRssi();
-
-    blackboxCurrent->voltage = getBatteryVoltage();
-    blackboxCurrent->current = getBatteryCurrent();
+        blackboxCurrent->rssi = getRssi();
 
-    voltageMeter_t meter;
-    voltageSensorADCRead(VOLTAGE_SENSOR_ADC_BEC, &meter);
-    blackboxCurrent->vbec = meter.voltage / 10;
-    voltageSensorADCRead(VOLTAGE_SENSOR_ADC_BUS, &meter);
-    blackboxCurrent->vbus = meter.voltage / 10;
+        blackboxCurrent->voltage = getBatteryVoltage();
+        blackboxCurrent->current = getBatteryCurrent();
 
-    blackboxCurrent->tmcu = getCoreTemperatureCelsius();
+        voltageMeter_t meter;
+        voltageSensorADCRead(VOLTAGE_SENSOR_ADC_BEC, &meter);
+        blackboxCurrent->vbec = meter.voltage / 10;
+        voltageSensorADCRead(VOLTAGE_SENSOR_ADC_BUS, &meter);
+        blackboxCurrent->vbus = meter.voltage / 10;
 
-    const escSensorData_t *escData = getEscSensorData(ESC_SENSOR_COMBINED);
-    if (escData && escData->age <= ESC_BATTERY_AGE_MAX)
-        blackboxCurrent->tesc = escData->temperature / 10;
-    else
-        blackboxCurrent->tesc = 0;
-
-    blackboxCurrent->headspeed = getHeadSpeed();
-    blackboxCurrent->tailspeed = getTailSpeed();
-
-    for (int i = 0; i < getMotorCount(); i++) {
-        blackboxCurrent->motor[i] = getMotorOutput(i);
-    }
+        blackboxCurrent->tmcu = getCoreTemperatureCelsius();
 
-    for (int i = 0; i < getServoCount(); i++) {
-        blackboxCurrent->servo[i] = getServoOutput(i);
-    }
+        const escSensorData_t *escData = getEscSensorData(ESC_SENSOR_COMBINED);
+        if (escData && escData->age <= ESC_BATTERY_AGE_MAX)
+            blackboxCurrent->tesc = escData->temperature / 10;
+        else
+            blackboxCurrent->tesc = 0;
 
-    for (int i = 0; i < DEBUG_VALUE_COUNT; i++) {
+        blackboxCurrent->headspeed = getHeadSpeed();
+        blackboxCurrent->tailspeed = getTailSpeed();
+    } else {
+#ifdef USE_BARO
+        blackboxCurrent->altitude = blackboxPrev->altitude;
+#ifdef USE_VARIO
+        blackboxCurrent->vario = blackboxPrev->vario;
+#endif
+#endif
+        blackboxCurrent->rssi = blackboxPrev->rssi;
+        blackboxCurrent->voltage = blackboxPrev->voltage;
+        blackboxCurrent->current = blackboxPrev->current;
+        blackboxCurrent->vbec = blackboxPrev->vbec;
+        blackboxCurrent->vbus = blackboxPrev->vbus;
+        blackboxCurrent->tmcu = blackboxPrev->tmcu;
+        blackboxCurrent->tesc = blackboxPrev->tesc;
+        blackboxCurrent->headspeed = blackboxPrev->headspeed;
+        blackboxCurrent->tailspeed = blackboxPrev->tailspeed;
+    }
+
+    for (int i = 0; i < DEBUG_SLOT_COUNT; i++) {
         blackboxCurrent->debug[i] = debug[i];
     }
 
 #else
+    UNUSED(blackboxCurrent);
+    UNUSED(blackboxPrev);
     UNUSED(currentTimeUs);
 #endif // UNIT_TEST
 }
@@ -1435,9 +1612,12 @@ static bool blackboxWriteSysinfo(void)
 #endif
         BLACKBOX_PRINT_HEADER_LINE("Log start datetime", "%s",              blackboxGetStartDateTime(buf));
         BLACKBOX_PRINT_HEADER_LINE("Craft name", "%s",                      pilotConfig()->name);
+        BLACKBOX_PRINT_HEADER_LINE("Data compression", "%s",                blackboxDeviceCompression() ? "huffman" : "none");
         BLACKBOX_PRINT_HEADER_LINE("I interval", "%d",                      blackboxIInterval);
         BLACKBOX_PRINT_HEADER_LINE("P interval", "%d",                      blackboxPInterval);
         BLACKBOX_PRINT_HEADER_LINE("P ratio", "%d",                         blackboxIInterval / blackboxPInterval);
+        BLACKBOX_PRINT_HEADER_LINE("Mixer denom", "%d",                     blackboxMixerDenom);
+        BLACKBOX_PRINT_HEADER_LINE("Sensor denom", "%d",                    blackboxSensorDenom);
         BLACKBOX_PRINT_HEADER_LINE("features", "%d",                        featureConfig()->enabledFeatures);
         BLACKBOX_PRINT_HEADER_LINE("gyro_scale","0x%x",                     castFloatBytesToInt(1.0f));
 #if defined(USE_ACC)
@@ -1583,8 +1763,19 @@ static bool blackboxWriteSysinfo(void)
         BLACKBOX_PRINT_HEADER_LINE("minthrottle", "%d",                     motorConfig()->minthrottle);
         BLACKBOX_PRINT_HEADER_LINE("maxthrottle", "%d",                     motorConfig()->maxthrottle);
         BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_DEBUG_MODE, "%d",             debugMode);
+        BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_DEBUG_MODE_2, "%d",           debugModes[1]);
         BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_DEBUG_AXIS, "%d",             debugAxis);
         BLACKBOX_PRINT_HEADER_LINE("fields_mask", "%d",                     blackboxConfig()->fields);
+        BLACKBOX_PRINT_HEADER_LINE("trigger_mask", "%d",                    blackboxConfig()->trigger);
+        BLACKBOX_PRINT_HEADER_LINE("trigger_time", "%d",                    blackboxConfig()->trigger_time);
+#ifdef USE_SYSID
+        BLACKBOX_PRINT_HEADER_LINE("sysid_signal", "%d",                    sysidConfig()->signal);
+        BLACKBOX_PRINT_HEADER_LINE("sysid_axes", "%d",                      sysidConfig()->axes);
+        BLACKBOX_PRINT_HEADER_LINE("sysid_amplitude", "%d",                 sysidConfig()->amplitude);
+        BLACKBOX_PRINT_HEADER_LINE("sysid_duration", "%d",                  sysidConfig()->duration);
+        BLACKBOX_PRINT_HEADER_LINE("sysid_freq", "%d,%d",                   sysidConfig()->min_freq,
+                                                                            sysidConfig()->max_freq);
+#endif
 
         default:
             return true;
@@ -1607,6 +1798,8 @@ void blackboxLogEvent(FlightLogEvent event, flightLogEventData_t *data)
         return;
     }
 
+    blackboxEncodeSnapshots();
+
     //Shared header for event frames
     blackboxWrite('E');
     blackboxWrite(event);
@@ -1629,6 +1822,22 @@ void blackboxLogEvent(FlightLogEvent event, flightLogEventData_t *data)
     case FLIGHT_LOG_EVENT_AIRBORNE_STATE:
         blackboxWriteUnsignedVB(data->airborneState.airborneState);
         break;
+    case FLIGHT_LOG_EVENT_GOV_AUTOTUNE:
+        blackboxWriteUnsignedVB(data->govAutotune.state);
+        blackboxWriteUnsignedVB(data->govAutotune.steps);
+        blackboxWriteUnsignedVB(data->govAutotune.gain);
+        blackboxWriteUnsignedVB(data->govAutotune.delay);
+        blackboxWriteUnsignedVB(data->govAutotune.tau);
+        blackboxWriteUnsignedVB(data->govAutotune.p_gain);
+        blackboxWriteUnsignedVB(data->govAutotune.i_gain);
+        blackboxWriteUnsignedVB(data->govAutotune.d_gain);
+        break;
+    case FLIGHT_LOG_EVENT_SYSID:
+        blackboxWriteUnsignedVB(data->sysid.state);
+        blackboxWriteUnsignedVB(data->sysid.axis);
+        blackboxWriteUnsignedVB(data->sysid.signal);
+        blackboxWriteUnsignedVB(data->sysid.startTime);
+        break;
     case FLIGHT_LOG_EVENT_DISARM:
         blackboxWriteUnsignedVB(data->disarm.reason);
         break;
@@ -1727,6 +1936,38 @@ static void blackboxCheckAndLogFlightMode(void)
         eventData.airborneState = blackboxLastAirborneState;
         blackboxLogEvent(FLIGHT_LOG_EVENT_AIRBORNE_STATE, (flightLogEventData_t *)&eventData);
     }
+
+    // Autotune phase changes and completed steps
+    const govAutotune_t *autotune = getGovernorAutotune();
+    const uint16_t govAutotune = autotune->state << 8 | autotune->steps;
+    if (govAutotune != blackboxLastGovAutotune) {
+        blackboxLastGovAutotune = govAutotune;
+        flightLogEvent_govAutotune_t eventData;
+        eventData.state = autotune->state;
+        eventData.steps = autotune->steps;
+        eventData.gain = constrain(lrintf(autotune->gain * 1000), 0, UINT16_MAX);
+        eventData.delay = constrain(lrintf(autotune->delay * 1000), 0, UINT16_MAX);
+        eventData.tau = constrain(lrintf(autotune->tau * 1000), 0, UINT16_MAX);
+        eventData.p_gain = autotune->p_gain;
+        eventData.i_gain = autotune->i_gain;
+        eventData.d_gain = autotune->d_gain;
+        blackboxLogEvent(FLIGHT_LOG_EVENT_GOV_AUTOTUNE, (flightLogEventData_t *)&eventData);
+    }
+
+#ifdef USE_SYSID
+    // Excitation start on each axis, and the end of the run
+    const sysidStatus_t *sysid = sysidGetStatus();
+    const uint16_t sysidState = sysid->state << 8 | sysid->axis;
+    if (sysidState != blackboxLastSysid) {
+        blackboxLastSysid = sysidState;
+        flightLogEvent_sysid_t eventData;
+        eventData.state = sysid->state;
+        eventData.axis = sysid->axis;
+        eventData.signal = sysid->signal;
+        eventData.startTime = sysid->startTimeUs;
+        blackboxLogEvent(FLIGHT_LOG_EVENT_SYSID, (flightLogEventData_t *)&eventData);
+    }
+#endif
 }
 
 static bool blackboxShouldLogFastFrame(void)
@@ -1788,6 +2029,129 @@ static void blackboxAdvanceIterationTimers(void)
     blackboxIteration++;
 }
 
+// Next free slot in the encoding queue
+static blackboxSnapshot_t *blackboxNextSnapshot(void)
+{
+    // Queue full, the BLACKBOX task is falling behind
+    if ((uint8_t)(blackboxSnapshotHead - blackboxSnapshotTail) >= BLACKBOX_SNAPSHOT_COUNT - BLACKBOX_SNAPSHOT_HISTORY) {
+        blackboxEncodeSnapshot();
+    }
+
+    return &blackboxSnapshot[blackboxSnapshotHead % BLACKBOX_SNAPSHOT_COUNT];
+}
+
+// Queue the current state for encoding in the BLACKBOX task
+static void blackboxCaptureSnapshot(timeUs_t currentTimeUs)
+{
+    blackboxSnapshot_t *snapshot = blackboxNextSnapshot();
+    const blackboxSnapshot_t *previous = &blackboxSnapshot[(uint8_t)(blackboxSnapshotHead - 1) % BLACKBOX_SNAPSHOT_COUNT];
+
+    loadMainState(&snapshot->state, &previous->state, currentTimeUs);
+
+    snapshot->iteration = blackboxIteration;
+    snapshot->iFrame = blackboxShouldLogIFrame();
+
+    blackboxSnapshotHead++;
+}
+
+// Queue a frame leaving the trigger ring, if it is to be logged
+static void blackboxTriggerRelease(const blackboxSnapshot_t *frame)
+{
+    const uint32_t iteration = frame->iteration;
+    const bool onRate = (iteration % blackboxPInterval) == 0;
+
+    if (blackboxTriggered && cmp32(iteration, blackboxTriggerEnd) > 0) {
+        blackboxTriggered = false;
+    }
+
+    const bool inWindow = blackboxTriggered && cmp32(iteration, blackboxTriggerStart) >= 0;
+
+    if (onRate || inWindow) {
+        blackboxSnapshot_t *snapshot = blackboxNextSnapshot();
+
+        memcpy(&snapshot->state, &frame->state, sizeof(blackboxMainState_t));
+
+        snapshot->iteration = iteration;
+        snapshot->iFrame = !onRate || (iteration % blackboxIInterval) == 0;
+
+        blackboxSnapshotHead++;
+    }
+}
+
+// Capture the current state into the trigger ring
+static void blackboxTriggerCapture(timeUs_t currentTimeUs)
+{
+    blackboxSnapshot_t *frame = &blackboxTriggerRing[blackboxTriggerHead];
+    const blackboxSnapshot_t *previous = &blackboxTriggerRing[(blackboxTriggerHead + BLACKBOX_TRIGGER_FRAMES - 1) % BLACKBOX_TRIGGER_FRAMES];
+
+    // The oldest frame is in the slot about to be reused
+    if (blackboxTriggerCount == BLACKBOX_TRIGGER_FRAMES) {
+        blackboxTriggerRelease(frame);
+    } else {
+        blackboxTriggerCount++;
+    }
+
+    loadMainState(&frame->state, &previous->state, currentTimeUs);
+
+    frame->iteration = blackboxIteration;
+
+    blackboxTriggerHead = (blackboxTriggerHead + 1) % BLACKBOX_TRIGGER_FRAMES;
+}
+
+// Release all frames in the trigger ring
+static void blackboxTriggerFlush(void)
+{
+    if (blackboxTriggerEnabled) {
+        unsigned index = (blackboxTriggerHead + BLACKBOX_TRIGGER_FRAMES - blackboxTriggerCount) % BLACKBOX_TRIGGER_FRAMES;
+
+        while (blackboxTriggerCount > 0) {
+            blackboxTriggerRelease(&blackboxTriggerRing[index]);
+            index = (index + 1) % BLACKBOX_TRIGGER_FRAMES;
+            blackboxTriggerCount--;
+        }
+    }
+}
+
+static void blackboxCheckTrigger(void)
+{
+    uint8_t state = 0;
+
+    if (gyroOverflowDetected())
+        state |= BIT(BLACKBOX_TRIGGER_GYRO_OVERFLOW);
+    if (failsafeIsActive())
+        state |= BIT(BLACKBOX_TRIGGER_FAILSAFE);
+    if (FLIGHT_MODE(RESCUE_MODE))
+        state |= BIT(BLACKBOX_TRIGGER_RESCUE);
+    if (IS_RC_MODE_ACTIVE(BOXBLACKBOXTRIGGER))
+        state |= BIT(BLACKBOX_TRIGGER_SWITCH);
+#ifdef USE_SYSID
+    if (sysidIsActive())
+        state |= BIT(BLACKBOX_TRIGGER_SYSID);
+#endif
+
+    // Triggered on the rising edge, or any governor state change
+    uint8_t events = state & ~blackboxTriggerState;
+
+    // The whole excitation is logged at full rate
+    events |= state & BIT(BLACKBOX_TRIGGER_SYSID);
+
+    if (getGovernorState() != blackboxTriggerGovState) {
+        blackboxTriggerGovState = getGovernorState();
+        events |= BIT(BLACKBOX_TRIGGER_GOVERNOR);
+    }
+
+    blackboxTriggerState = state;
+
+    if (events & blackboxConfig()->trigger) {
+        // Start from the oldest frame still in the ring, unless already in a window
+        if (!blackboxTriggered) {
+            blackboxTriggerStart = blackboxIteration - BLACKBOX_TRIGGER_FRAMES;
+            blackboxTriggered = true;
+        }
+        blackboxTriggerEnd = blackboxIteration + blackboxTriggerFrames;
+    }
+}
+
 // Called once every FC loop in order to log the current state
 static void blackboxLogIteration(timeUs_t currentTimeUs)
 {
@@ -1795,13 +2159,14 @@ static void blackboxLogIteration(timeUs_t currentTimeUs)
         blackboxCheckAndLogArmingBeep();
         blackboxCheckAndLogFlightMode();
         blackboxCheckAndLogSlowFrame();
+    }
 
-        loadMainState(currentTimeUs);
-
-        if (blackboxShouldLogIFrame())
-            writeIntraframe();
-        else
-            writeInterframe();
+    if (blackboxTriggerEnabled) {
+        blackboxCheckTrigger();
+        blackboxTriggerCapture(currentTimeUs);
+    }
+    else if (blackboxShouldLogFastFrame()) {
+        blackboxCaptureSnapshot(currentTimeUs);
     }
 
 #ifdef USE_GPS
@@ -1923,7 +2288,16 @@ void blackboxUpdate(timeUs_t currentTimeUs)
         //On entry of this state, xmitState.headerIndex is 0
 
         //Keep writing chunks of the system info headers until it returns true to signal completion
-        if (blackboxWriteSysinfo()) {
+        bool sysinfoDone;
+        do {
+            const uint32_t headerIndex = xmitState.headerIndex;
+            sysinfoDone = blackboxWriteSysinfo();
+            // Resume on the next run when the buffer is full or the slice is used up
+            if (xmitState.headerIndex == headerIndex)
+                break;
+        } while (!sysinfoDone && !schedulerTaskSliceExpired());
+
+        if (sysinfoDone) {
             /*
              * Wait for header buffers to drain completely before data logging begins to ensure reliable header delivery
              * (overflowing circular buffers causes all data to be discarded, so the first few logged iterations
@@ -2017,6 +2391,21 @@ uint8_t blackboxGetRateDenom(void)
     return blackboxPInterval;
 }
 
+bool blackboxEncodeCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTimeUs)
+{
+    UNUSED(currentTimeUs);
+    UNUSED(currentDeltaTimeUs);
+
+    return (blackboxSnapshotTail != blackboxSnapshotHead);
+}
+
+void blackboxEncode(timeUs_t currentTimeUs)
+{
+    UNUSED(currentTimeUs);
+
+    blackboxEncodeSnapshots();
+}
+
 void blackboxFlush(timeUs_t currentTimeUs)
 {
     UNUSED(currentTimeUs);
@@ -2033,6 +2422,8 @@ void blackboxInit(void)
     blackboxResetIterationTimers();
 
     blackboxPInterval = constrain(blackboxConfig()->denom, 1, 8000);
+    blackboxMixerDenom = constrain(blackboxConfig()->mixer_denom, 1, 64);
+    blackboxSensorDenom = constrain(blackboxConfig()->sensor_denom, 1, 64);
 
     // I-frame is written at least every 32ms or 64 P-frames
     uint32_t Imul = (32 * gyro.targetRateHz) / (1000 * blackboxPInterval);
@@ -2051,6 +2442,10 @@ void blackboxInit(void)
     // GPS frame is written at least every 10s
     blackboxGInterval = 10 * gyro.targetRateHz / blackboxIInterval;
 
+    // Full rate logging after a trigger
+    blackboxTriggerEnabled = (blackboxConfig()->trigger != 0);
+    blackboxTriggerFrames = blackboxConfig()->trigger_time * gyro.targetRateHz / 1000;
+
     if (blackboxConfig()->device)
         blackboxSetState(BLACKBOX_STATE_STOPPED);
     else
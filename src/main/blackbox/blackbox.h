@@ -39,6 +39,21 @@ typedef enum BlackboxMode {
     BLACKBOX_MODE_SWITCH,
 } BlackboxMode;
 
+typedef enum {
+    BLACKBOX_TRIGGER_GYRO_OVERFLOW = 0,
+    BLACKBOX_TRIGGER_GOVERNOR,
+    BLACKBOX_TRIGGER_FAILSAFE,
+    BLACKBOX_TRIGGER_RESCUE,
+    BLACKBOX_TRIGGER_SWITCH,
+    BLACKBOX_TRIGGER_SYSID,
+    BLACKBOX_TRIGGER_COUNT
+} blackboxTrigger_e;
+
+typedef enum BlackboxCompression {
+    BLACKBOX_COMPRESSION_NONE = 0,
+    BLACKBOX_COMPRESSION_HUFFMAN,
+} BlackboxCompression_e;
+
 typedef enum FlightLogEvent {
     FLIGHT_LOG_EVENT_SYNC_BEEP = 0,
     FLIGHT_LOG_EVENT_INFLIGHT_ADJUSTMENT = 13,
@@ -48,6 +63,8 @@ typedef enum FlightLogEvent {
     FLIGHT_LOG_EVENT_GOVSTATE = 50,   // Add new event type for main motor governor state.
     FLIGHT_LOG_EVENT_RESCUE_STATE = 51,
     FLIGHT_LOG_EVENT_AIRBORNE_STATE = 52,
+    FLIGHT_LOG_EVENT_GOV_AUTOTUNE = 53,
+    FLIGHT_LOG_EVENT_SYSID = 54,
     FLIGHT_LOG_EVENT_CUSTOM_DATA = 100,
     FLIGHT_LOG_EVENT_CUSTOM_STRING = 101,
     FLIGHT_LOG_EVENT_LOG_END = 255
@@ -58,6 +75,12 @@ typedef struct blackboxConfig_s {
     uint8_t mode;
     uint16_t denom;
     uint32_t fields;
+    uint8_t serial_framing;
+    uint8_t compression;
+    uint8_t mixer_denom;
+    uint8_t sensor_denom;
+    uint8_t trigger;
+    uint16_t trigger_time;
 } blackboxConfig_t;
 
 PG_DECLARE(blackboxConfig_t, blackboxConfig);
@@ -70,6 +93,9 @@ void blackboxLogCustomString(const char *ptr);
 
 void blackboxUpdate(timeUs_t currentTimeUs);
 void blackboxFlush(timeUs_t currentTimeUs);
+
+bool blackboxEncodeCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTimeUs);
+void blackboxEncode(timeUs_t currentTimeUs);
 void blackboxInit(void);
 
 void blackboxErase(void);
@@ -85,17 +85,46 @@ void blackboxPrintfHeaderLine(const char *name, const char *fmt, ...)
     blackboxHeaderBudget -= written + 3;
 }
 
-/**
- * Write an unsigned integer to the blackbox serial port using variable byte encoding.
+/*
+ * The encoders assemble each field group in a local buffer and pass it
+ * to the device in one call, instead of dispatching every byte through
+ * blackboxWrite().
+ *
+ * Field sizes are found from the ZigZag encoded values: a signed value
+ * fits in n bits exactly when its ZigZag code is below 2^n, and the OR
+ * of the codes of a group is below 2^n only if all of them are.
  */
-void blackboxWriteUnsignedVB(uint32_t value)
+
+static inline int blackboxEncodeUnsignedVB(uint8_t *buf, uint32_t value)
 {
+    int len = 0;
+
     //While this isn't the final byte (we can only write 7 bits at a time)
     while (value > 127) {
-        blackboxWrite((uint8_t) (value | 0x80)); // Set the high bit to mean "more bytes follow"
+        buf[len++] = (uint8_t) (value | 0x80); // Set the high bit to mean "more bytes follow"
         value >>= 7;
     }
-    blackboxWrite(value);
+    buf[len++] = value;
+
+    return len;
+}
+
+static inline int blackboxEncodeBytes(uint8_t *buf, int32_t value, int count)
+{
+    for (int i = 0; i < count; i++) {
+        buf[i] = value >> (i * 8);
+    }
+    return count;
+}
+
+/**
+ * Write an unsigned integer to the blackbox serial port using variable byte encoding.
+ */
+void blackboxWriteUnsignedVB(uint32_t value)
+{
+    uint8_t buf[5];
+
+    blackboxWriteBytes(buf, blackboxEncodeUnsignedVB(buf, value));
 }
 
 /**
@@ -107,24 +136,39 @@ void blackboxWriteSignedVB(int32_t value)
     blackboxWriteUnsignedVB(zigzagEncode(value));
 }
 
+#define BLACKBOX_VB_ARRAY_CHUNK 8
+
 void blackboxWriteSignedVBArray(int32_t *array, int count)
 {
-    for (int i = 0; i < count; i++) {
-        blackboxWriteSignedVB(array[i]);
+    uint8_t buf[BLACKBOX_VB_ARRAY_CHUNK * 5];
+
+    for (int i = 0; i < count; ) {
+        int len = 0;
+        for (int n = 0; n < BLACKBOX_VB_ARRAY_CHUNK && i < count; n++, i++) {
+            len += blackboxEncodeUnsignedVB(buf + len, zigzagEncode(array[i]));
+        }
+        blackboxWriteBytes(buf, len);
     }
 }
 
 void blackboxWriteSigned16VBArray(int16_t *array, int count)
 {
-    for (int i = 0; i < count; i++) {
-        blackboxWriteSignedVB(array[i]);
+    uint8_t buf[BLACKBOX_VB_ARRAY_CHUNK * 5];
+
+    for (int i = 0; i < count; ) {
+        int len = 0;
+        for (int n = 0; n < BLACKBOX_VB_ARRAY_CHUNK && i < count; n++, i++) {
+            len += blackboxEncodeUnsignedVB(buf + len, zigzagEncode(array[i]));
+        }
+        blackboxWriteBytes(buf, len);
     }
 }
 
 void blackboxWriteS16(int16_t value)
 {
-    blackboxWrite(value & 0xFF);
-    blackboxWrite((value >> 8) & 0xFF);
+    uint8_t buf[2];
+
+    blackboxWriteBytes(buf, blackboxEncodeBytes(buf, value, 2));
 }
 
 /**
@@ -142,14 +186,8 @@ void blackboxWriteTag2_3S32(int32_t *values)
         BITS_32 = 3
     };
 
-    enum {
-        BYTES_1  = 0,
-        BYTES_2  = 1,
-        BYTES_3  = 2,
-        BYTES_4  = 3
-    };
-
-    int selector = BITS_2, selector2;
+    uint8_t buf[1 + 3 * 4];
+    int len = 0;
 
     /*
      * Find out how many bits the largest value requires to encode, and use it to choose one of the packing schemes
@@ -162,93 +200,55 @@ void blackboxWriteTag2_3S32(int32_t *values)
      * 6 bits per field  ss11 1111 0022 2222 0033 3333
      * 32 bits per field sstt tttt followed by fields of various byte counts
      */
-    for (int x = 0; x < NUM_FIELDS; x++) {
-        //Require more than 6 bits?
-        if (values[x] >= 32 || values[x] < -32) {
-            selector = BITS_32;
-            break;
-        }
-
-        //Require more than 4 bits?
-        if (values[x] >= 8 || values[x] < -8) {
-             if (selector < BITS_6) {
-                 selector = BITS_6;
-             }
-        } else if (values[x] >= 2 || values[x] < -2) { //Require more than 2 bits?
-            if (selector < BITS_4) {
-                selector = BITS_4;
-            }
-        }
-    }
+    const uint32_t mask = zigzagEncode(values[0]) | zigzagEncode(values[1]) | zigzagEncode(values[2]);
+    const int selector = (mask >= 0x04) + (mask >= 0x10) + (mask >= 0x40);
 
     switch (selector) {
     case BITS_2:
-        blackboxWrite((selector << 6) | ((values[0] & 0x03) << 4) | ((values[1] & 0x03) << 2) | (values[2] & 0x03));
+        buf[len++] = (selector << 6) | ((values[0] & 0x03) << 4) | ((values[1] & 0x03) << 2) | (values[2] & 0x03);
         break;
     case BITS_4:
-        blackboxWrite((selector << 6) | (values[0] & 0x0F));
-        blackboxWrite((values[1] << 4) | (values[2] & 0x0F));
+        buf[len++] = (selector << 6) | (values[0] & 0x0F);
+        buf[len++] = (values[1] << 4) | (values[2] & 0x0F);
         break;
     case BITS_6:
-        blackboxWrite((selector << 6) | (values[0] & 0x3F));
-        blackboxWrite((uint8_t)values[1]);
-        blackboxWrite((uint8_t)values[2]);
+        buf[len++] = (selector << 6) | (values[0] & 0x3F);
+        buf[len++] = (uint8_t)values[1];
+        buf[len++] = (uint8_t)values[2];
         break;
     case BITS_32:
-        /*
-         * Do another round to compute a selector for each field, assuming that they are at least 8 bits each
-         *
-         * Selector2 field possibilities
-         * 0 - 8 bits
-         * 1 - 16 bits
-         * 2 - 24 bits
-         * 3 - 32 bits
-         */
-        selector2 = 0;
-
-        //Encode in reverse order so the first field is in the low bits:
-        for (int x = NUM_FIELDS - 1; x >= 0; x--) {
-            selector2 <<= 2;
-
-            if (values[x] < 128 && values[x] >= -128) {
-                selector2 |= BYTES_1;
-            } else if (values[x] < 32768 && values[x] >= -32768) {
-                selector2 |= BYTES_2;
-            } else if (values[x] < 8388608 && values[x] >= -8388608) {
-                selector2 |= BYTES_3;
-            } else {
-                selector2 |= BYTES_4;
+        {
+            /*
+             * Compute a selector for each field, assuming that they are at least 8 bits each
+             *
+             * Selector2 field possibilities
+             * 0 - 8 bits
+             * 1 - 16 bits
+             * 2 - 24 bits
+             * 3 - 32 bits
+             */
+            int bytes[NUM_FIELDS];
+            int selector2 = 0;
+
+            //Encode in reverse order so the first field is in the low bits:
+            for (int x = NUM_FIELDS - 1; x >= 0; x--) {
+                const uint32_t code = zigzagEncode(values[x]);
+                bytes[x] = (code >= 0x100) + (code >= 0x10000) + (code >= 0x1000000);
+                selector2 = (selector2 << 2) | bytes[x];
             }
-        }
 
-        //Write the selectors
-        blackboxWrite((selector << 6) | selector2);
+            //Write the selectors
+            buf[len++] = (selector << 6) | selector2;
 
-        //And now the values according to the selectors we picked for them
-        for (int x = 0; x < NUM_FIELDS; x++, selector2 >>= 2) {
-            switch (selector2 & 0x03) {
-            case BYTES_1:
-                blackboxWrite(values[x]);
-                break;
-            case BYTES_2:
-                blackboxWrite(values[x]);
-                blackboxWrite(values[x] >> 8);
-                break;
-            case BYTES_3:
-                blackboxWrite(values[x]);
-                blackboxWrite(values[x] >> 8);
-                blackboxWrite(values[x] >> 16);
-                break;
-            case BYTES_4:
-                blackboxWrite(values[x]);
-                blackboxWrite(values[x] >> 8);
-                blackboxWrite(values[x] >> 16);
-                blackboxWrite(values[x] >> 24);
-                break;
+            //And now the values according to the selectors we picked for them
+            for (int x = 0; x < NUM_FIELDS; x++) {
+                len += blackboxEncodeBytes(buf + len, values[x], bytes[x] + 1);
             }
         }
         break;
     }
+
+    blackboxWriteBytes(buf, len);
 }
 
 /**
@@ -388,23 +388,17 @@ void blackboxWriteTag8_4S16(int32_t *values)
         FIELD_16BIT = 3
     };
 
+    uint8_t buf[1 + 4 * 2];
+    int len = 0;
+
     uint8_t selector = 0;
     //Encode in reverse order so the first field is in the low bits:
     for (int x = 3; x >= 0; x--) {
-        selector <<= 2;
-
-        if (values[x] == 0) {
-            selector |= FIELD_ZERO;
-        } else if (values[x] < 8 && values[x] >= -8) {
-            selector |= FIELD_4BIT;
-        } else if (values[x] < 128 && values[x] >= -128) {
-            selector |= FIELD_8BIT;
-        } else {
-            selector |= FIELD_16BIT;
-        }
+        const uint32_t code = zigzagEncode(values[x]);
+        selector = (selector << 2) | ((code != 0) + (code >= 0x10) + (code >= 0x100));
     }
 
-    blackboxWrite(selector);
+    buf[len++] = selector;
 
     int nibbleIndex = 0;
     uint8_t buffer = 0;
@@ -419,16 +413,16 @@ void blackboxWriteTag8_4S16(int32_t *values)
                 buffer = values[x] << 4;
                 nibbleIndex = 1;
             } else {
-                blackboxWrite(buffer | (values[x] & 0x0F));
+                buf[len++] = buffer | (values[x] & 0x0F);
                 nibbleIndex = 0;
             }
             break;
         case FIELD_8BIT:
             if (nibbleIndex == 0) {
-                blackboxWrite(values[x]);
+                buf[len++] = values[x];
             } else {
                 //Write the high bits of the value first (mask to avoid sign extension)
-                blackboxWrite(buffer | ((values[x] >> 4) & 0x0F));
+                buf[len++] = buffer | ((values[x] >> 4) & 0x0F);
                 //Now put the leftover low bits into the top of the next buffer entry
                 buffer = values[x] << 4;
             }
@@ -436,13 +430,13 @@ void blackboxWriteTag8_4S16(int32_t *values)
         case FIELD_16BIT:
             if (nibbleIndex == 0) {
                 //Write high byte first
-                blackboxWrite(values[x] >> 8);
-                blackboxWrite(values[x]);
+                buf[len++] = values[x] >> 8;
+                buf[len++] = values[x];
             } else {
                 //First write the highest 4 bits
-                blackboxWrite(buffer | ((values[x] >> 12) & 0x0F));
+                buf[len++] = buffer | ((values[x] >> 12) & 0x0F);
                 // Then the middle 8
-                blackboxWrite(values[x] >> 4);
+                buf[len++] = values[x] >> 4;
                 //Only the smallest 4 bits are still left to write
                 buffer = values[x] << 4;
             }
@@ -451,8 +445,10 @@ void blackboxWriteTag8_4S16(int32_t *values)
     }
     //Anything left over to write?
     if (nibbleIndex == 1) {
-        blackboxWrite(buffer);
+        buf[len++] = buffer;
     }
+
+    blackboxWriteBytes(buf, len);
 }
 
 /**
@@ -463,43 +459,41 @@ void blackboxWriteTag8_4S16(int32_t *values)
  */
 void blackboxWriteTag8_8SVB(int32_t *values, int valueCount)
 {
-    uint8_t header;
+    uint8_t buf[1 + 8 * 5];
+    int len = 0;
 
     if (valueCount > 0) {
         //If we're only writing one field then we can skip the header
         if (valueCount == 1) {
-            blackboxWriteSignedVB(values[0]);
+            len = blackboxEncodeUnsignedVB(buf, zigzagEncode(values[0]));
         } else {
             //First write a one-byte header that marks which fields are non-zero
-            header = 0;
+            uint8_t header = 0;
 
             // First field should be in low bits of header
             for (int i = valueCount - 1; i >= 0; i--) {
-                header <<= 1;
-
-                if (values[i] != 0) {
-                    header |= 0x01;
-                }
+                header = (header << 1) | (values[i] != 0);
             }
 
-            blackboxWrite(header);
+            buf[len++] = header;
 
             for (int i = 0; i < valueCount; i++) {
                 if (values[i] != 0) {
-                    blackboxWriteSignedVB(values[i]);
+                    len += blackboxEncodeUnsignedVB(buf + len, zigzagEncode(values[i]));
                 }
             }
         }
+
+        blackboxWriteBytes(buf, len);
     }
 }
 
 /** Write unsigned integer **/
 void blackboxWriteU32(int32_t value)
 {
-    blackboxWrite(value & 0xFF);
-    blackboxWrite((value >> 8) & 0xFF);
-    blackboxWrite((value >> 16) & 0xFF);
-    blackboxWrite((value >> 24) & 0xFF);
+    uint8_t buf[4];
+
+    blackboxWriteBytes(buf, blackboxEncodeBytes(buf, value, 4));
 }
 
 /** Write float value in the integer form **/
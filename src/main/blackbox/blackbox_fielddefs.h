@@ -63,6 +63,7 @@ typedef enum FlightLogFieldCondition {
     FLIGHT_LOG_FIELD_CONDITION_SERVO_8,
 
     FLIGHT_LOG_FIELD_CONDITION_DEBUG,
+    FLIGHT_LOG_FIELD_CONDITION_DEBUG_2,
 
     FLIGHT_LOG_FIELD_CONDITION_NOT_EVERY_FRAME,
 
@@ -174,6 +175,24 @@ typedef struct flightLogEvent_airborneState_s {
     uint8_t airborneState;
 } flightLogEvent_airborneState_t;
 
+typedef struct flightLogEvent_govAutotune_s {
+    uint8_t state;
+    uint8_t steps;
+    uint16_t gain;          // x1000
+    uint16_t delay;         // ms
+    uint16_t tau;           // ms
+    uint8_t p_gain;
+    uint8_t i_gain;
+    uint8_t d_gain;
+} flightLogEvent_govAutotune_t;
+
+typedef struct flightLogEvent_sysid_s {
+    uint8_t state;
+    uint8_t axis;
+    uint8_t signal;
+    uint32_t startTime;
+} flightLogEvent_sysid_t;
+
 typedef struct flightLogEvent_inflightAdjustment_s {
     int32_t newValue;
     float newFloatValue;
@@ -203,6 +222,8 @@ typedef union flightLogEventData_u {
     flightLogEvent_govState_t govState;
     flightLogEvent_rescueState_t rescueState;
     flightLogEvent_airborneState_t airborneState;
+    flightLogEvent_govAutotune_t govAutotune;
+    flightLogEvent_sysid_t sysid;
     flightLogEvent_disarm_t disarm;
     flightLogEvent_inflightAdjustment_t inflightAdjustment;
     flightLogEvent_customData_t data;
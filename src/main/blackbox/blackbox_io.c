@@ -36,6 +36,7 @@
 // 0: Average output bandwidth in last 100ms
 // 1: Maximum hold of above.
 // 2: Bytes dropped due to output buffer full.
+// 3: Free bytes in the output buffer.
 //
 // Note that bandwidth usage slightly increases when DEBUG_BB_OUTPUT is enabled,
 // as output will include debug variables themselves.
@@ -45,6 +46,8 @@
 #include "blackbox.h"
 #include "blackbox_io.h"
 
+#include "common/crc.h"
+#include "common/huffman.h"
 #include "common/maths.h"
 
 #include "sensors/gyro.h"
@@ -70,6 +73,27 @@ int32_t blackboxHeaderBudget;
 static serialPort_t *blackboxPort = NULL;
 static portSharing_e blackboxPortSharing;
 
+/*
+ * Framed serial stream (blackbox_serial_framing = ON)
+ *
+ *   SYNC0 SYNC1 SEQ_L SEQ_H LEN PAYLOAD[LEN] CRC
+ *
+ * The CRC (DVB-S2) covers SEQ, LEN and the payload. A frame that doesn't fit
+ * in the TX buffer is dropped whole, but its sequence number is still used,
+ * so the receiver can report the gap and resync on the next marker.
+ */
+#define BLACKBOX_FRAME_SYNC0            0xBB
+#define BLACKBOX_FRAME_SYNC1            0x5A
+#define BLACKBOX_FRAME_HEADER_SIZE      5
+#define BLACKBOX_FRAME_PAYLOAD_SIZE     200
+#define BLACKBOX_FRAME_SIZE             (BLACKBOX_FRAME_HEADER_SIZE + BLACKBOX_FRAME_PAYLOAD_SIZE + 1)
+
+static struct {
+    uint8_t buf[BLACKBOX_FRAME_SIZE];
+    uint8_t len;
+    uint16_t seq;
+} blackboxFrame;
+
 #ifdef USE_SDCARD
 
 static struct {
@@ -101,6 +125,32 @@ void blackboxOpen(void)
     }
 }
 
+#ifdef USE_HUFFMAN
+
+/*
+ * Compressed log data (blackbox_compression = HUFFMAN)
+ *
+ * Once the headers have been written, the flash and SD card output is
+ * cut into blocks of up to 256 bytes, each encoded with the static
+ * Huffman table also used for MSP dataflash reads:
+ *
+ *   SIZE(2) COUNT(2) DATA[SIZE & 0x7FFF]
+ *
+ * COUNT is the number of uncompressed bytes in the block. Blocks that
+ * wouldn't get smaller are stored as-is with bit 15 of SIZE set.
+ */
+#define BLACKBOX_COMPRESS_BLOCK_SIZE    256
+#define BLACKBOX_COMPRESS_RAW_FLAG      0x8000
+
+static struct {
+    bool active;
+    uint16_t len;
+    uint8_t in[BLACKBOX_COMPRESS_BLOCK_SIZE];
+    uint8_t out[4 + BLACKBOX_COMPRESS_BLOCK_SIZE];
+} blackboxCompress;
+
+#endif
+
 #ifdef DEBUG_BB_OUTPUT
 static uint32_t bbBits;
 static timeMs_t bbLastclearMs;
@@ -108,13 +158,144 @@ static uint16_t bbRateMax;
 static uint32_t bbDrops;
 #endif
 
+static void blackboxSerialFrameFlush(void)
+{
+    const uint8_t len = blackboxFrame.len;
+
+    if (len == 0) {
+        return;
+    }
+
+    uint8_t *frame = blackboxFrame.buf;
+
+    frame[0] = BLACKBOX_FRAME_SYNC0;
+    frame[1] = BLACKBOX_FRAME_SYNC1;
+    frame[2] = blackboxFrame.seq & 0xFF;
+    frame[3] = blackboxFrame.seq >> 8;
+    frame[4] = len;
+    frame[BLACKBOX_FRAME_HEADER_SIZE + len] = crc8_dvb_s2_update(0, frame + 2, len + 3);
+
+    const int frameSize = BLACKBOX_FRAME_HEADER_SIZE + len + 1;
+
+    if (serialTxBytesFree(blackboxPort) >= (uint32_t)frameSize) {
+        serialWriteBuf(blackboxPort, frame, frameSize);
+    } else {
+#ifdef DEBUG_BB_OUTPUT
+        bbDrops += len;
+        DEBUG_SET(DEBUG_BLACKBOX_OUTPUT, 2, bbDrops);
+#endif
+    }
+
+    blackboxFrame.seq++;
+    blackboxFrame.len = 0;
+}
+
+bool blackboxDeviceCompression(void)
+{
+#ifdef USE_HUFFMAN
+    switch (blackboxConfig()->device) {
+    case BLACKBOX_DEVICE_FLASH:
+    case BLACKBOX_DEVICE_SDCARD:
+        return blackboxConfig()->compression == BLACKBOX_COMPRESSION_HUFFMAN;
+    default:
+        break;
+    }
+#endif
+    return false;
+}
+
+void blackboxDeviceStartCompression(void)
+{
+#ifdef USE_HUFFMAN
+    blackboxCompress.active = blackboxDeviceCompression();
+#endif
+}
+
+#ifdef USE_HUFFMAN
+static void blackboxCompressFlush(void)
+{
+    const uint16_t count = blackboxCompress.len;
+
+    if (count == 0) {
+        return;
+    }
+
+    uint8_t *out = blackboxCompress.out;
+
+    huffmanState_t state = {
+        .bytesWritten = 0,
+        .outByte = out + 4,
+        .outBufLen = count - 1,
+        .outBit = 0x80,
+    };
+    *state.outByte = 0;
+
+    uint16_t size;
+
+    if (huffmanEncodeBufStreaming(&state, blackboxCompress.in, count, huffmanTable) == 0) {
+        if (state.outBit != 0x80) {
+            ++state.bytesWritten;
+        }
+        size = state.bytesWritten;
+    } else {
+        memcpy(out + 4, blackboxCompress.in, count);
+        size = count | BLACKBOX_COMPRESS_RAW_FLAG;
+    }
+
+    out[0] = size & 0xFF;
+    out[1] = size >> 8;
+    out[2] = count & 0xFF;
+    out[3] = count >> 8;
+
+    const int blockSize = 4 + (size & ~BLACKBOX_COMPRESS_RAW_FLAG);
+
+    switch (blackboxConfig()->device) {
+#ifdef USE_FLASHFS
+    case BLACKBOX_DEVICE_FLASH:
+        flashfsWrite(out, blockSize);
+        break;
+#endif
+#ifdef USE_SDCARD
+    case BLACKBOX_DEVICE_SDCARD:
+        afatfs_fwrite(blackboxSDCard.logFile, out, blockSize);
+        break;
+#endif
+    default:
+        UNUSED(blockSize);
+        break;
+    }
+
+    blackboxCompress.len = 0;
+}
+
+static void blackboxCompressWrite(const uint8_t *data, int length)
+{
+    while (length-- > 0) {
+        blackboxCompress.in[blackboxCompress.len++] = *data++;
+        if (blackboxCompress.len >= BLACKBOX_COMPRESS_BLOCK_SIZE) {
+            blackboxCompressFlush();
+        }
+    }
+}
+#endif
+
 void blackboxWrite(uint8_t value)
 {
 #ifdef DEBUG_BB_OUTPUT
     bbBits += 8;
 #endif
 
+#ifdef USE_HUFFMAN
+    if (blackboxCompress.active) {
+        blackboxCompressWrite(&value, 1);
+        return;
+    }
+#endif
+
     switch (blackboxConfig()->device) {
+    case BLACKBOX_DEVICE_NONE:
+        // No device, the output is discarded
+        break;
 #ifdef USE_FLASHFS
     case BLACKBOX_DEVICE_FLASH:
         flashfsWriteByte(value);
@@ -127,7 +308,12 @@ void blackboxWrite(uint8_t value)
 #endif
     case BLACKBOX_DEVICE_SERIAL:
     default:
-        {
+        if (blackboxConfig()->serial_framing) {
+            blackboxFrame.buf[BLACKBOX_FRAME_HEADER_SIZE + blackboxFrame.len++] = value;
+            if (blackboxFrame.len >= BLACKBOX_FRAME_PAYLOAD_SIZE) {
+                blackboxSerialFrameFlush();
+            }
+        } else {
             int txBytesFree = serialTxBytesFree(blackboxPort);
 
 #ifdef DEBUG_BB_OUTPUT
@@ -163,12 +349,59 @@ void blackboxWrite(uint8_t value)
 #endif
 }
 
+// Write a block of bytes to the blackbox device
+void blackboxWriteBytes(const uint8_t *data, int length)
+{
+#ifdef DEBUG_BB_OUTPUT
+    while (length-- > 0) {
+        blackboxWrite(*data++);
+    }
+#else
+#ifdef USE_HUFFMAN
+    if (blackboxCompress.active) {
+        blackboxCompressWrite(data, length);
+        return;
+    }
+#endif
+
+    switch (blackboxConfig()->device) {
+    case BLACKBOX_DEVICE_NONE:
+        // No device, the output is discarded
+        break;
+#ifdef USE_FLASHFS
+    case BLACKBOX_DEVICE_FLASH:
+        flashfsWrite(data, length);
+        break;
+#endif
+#ifdef USE_SDCARD
+    case BLACKBOX_DEVICE_SDCARD:
+        afatfs_fwrite(blackboxSDCard.logFile, data, length); // Ignore failures due to buffers filling up
+        break;
+#endif
+    case BLACKBOX_DEVICE_SERIAL:
+    default:
+        while (length-- > 0) {
+            blackboxWrite(*data++);
+        }
+        break;
+    }
+#endif
+}
+
 // Print the null-terminated string 's' to the blackbox device and return the number of bytes written
 int blackboxWriteString(const char *s)
 {
     int length;
     const uint8_t *pos;
 
+#ifdef USE_HUFFMAN
+    if (blackboxCompress.active) {
+        length = strlen(s);
+        blackboxCompressWrite((const uint8_t*) s, length);
+        return length;
+    }
+#endif
+
     switch (blackboxConfig()->device) {
 
 #ifdef USE_FLASHFS
@@ -214,10 +447,23 @@ void blackboxDeviceFlush(void)
          * devices will progressively write in the background without Blackbox calling anything.
          */
     case BLACKBOX_DEVICE_FLASH:
-        flashfsFlushAsync();
+        flashfsFlushAsync(false);
         break;
 #endif // USE_FLASHFS
 
+    case BLACKBOX_DEVICE_SERIAL:
+        /*
+         * Keep filling the current frame while the port is busy, but send a
+         * partial frame as soon as the port runs dry, so that the framing
+         * overhead stays low without adding latency.
+         */
+        if (blackboxConfig()->serial_framing && blackboxPort) {
+            if (blackboxFrame.len >= BLACKBOX_FRAME_PAYLOAD_SIZE / 2 || isSerialTransmitBufferEmpty(blackboxPort)) {
+                blackboxSerialFrameFlush();
+            }
+        }
+        break;
+
     default:
         ;
     }
@@ -230,14 +476,23 @@ void blackboxDeviceFlush(void)
  */
 bool blackboxDeviceFlushForce(void)
 {
+#ifdef USE_HUFFMAN
+    if (blackboxCompress.active) {
+        blackboxCompressFlush();
+    }
+#endif
+
     switch (blackboxConfig()->device) {
     case BLACKBOX_DEVICE_SERIAL:
         // Nothing to speed up flushing on serial, as serial is continuously being drained out of its buffer
+        if (blackboxConfig()->serial_framing) {
+            blackboxSerialFrameFlush();
+        }
         return isSerialTransmitBufferEmpty(blackboxPort);
 
 #ifdef USE_FLASHFS
     case BLACKBOX_DEVICE_FLASH:
-        return flashfsFlushAsync();
+        return flashfsFlushAsync(true);
 #endif // USE_FLASHFS
 
 #ifdef USE_SDCARD
@@ -280,6 +535,11 @@ bool blackboxDeviceFlushForceComplete(void)
  */
 bool blackboxDeviceOpen(void)
 {
+#ifdef USE_HUFFMAN
+    blackboxCompress.active = false;
+    blackboxCompress.len = 0;
+#endif
+
     switch (blackboxConfig()->device) {
     case BLACKBOX_DEVICE_SERIAL:
         {
@@ -304,6 +564,9 @@ bool blackboxDeviceOpen(void)
                 portOptions |= SERIAL_STOPBITS_1;
             }
 
+            blackboxFrame.len = 0;
+            blackboxFrame.seq = 0;
+
             blackboxPort = openSerialPort(portConfig->identifier, FUNCTION_BLACKBOX, NULL, NULL, baudRates[baudRateIndex],
                 BLACKBOX_SERIAL_PORT_MODE, portOptions);
 
@@ -565,6 +828,13 @@ bool blackboxDeviceBeginLog(void)
  */
 bool blackboxDeviceEndLog(bool retainLog)
 {
+#ifdef USE_HUFFMAN
+    if (blackboxCompress.active) {
+        blackboxCompressFlush();
+        blackboxCompress.active = false;
+    }
+#endif
+
 #ifndef USE_SDCARD
     UNUSED(retainLog);
 #endif
@@ -655,6 +925,10 @@ void blackboxReplenishHeaderBudget(void)
     switch (blackboxConfig()->device) {
     case BLACKBOX_DEVICE_SERIAL:
         freeSpace = serialTxBytesFree(blackboxPort);
+        if (blackboxConfig()->serial_framing) {
+            // Leave room for the frame being assembled
+            freeSpace = MAX(freeSpace - BLACKBOX_FRAME_SIZE, 0);
+        }
         break;
 #ifdef USE_FLASHFS
     case BLACKBOX_DEVICE_FLASH:
@@ -720,7 +994,7 @@ blackboxBufferReserveStatus_e blackboxDeviceReserveBufferSpace(int32_t bytes)
              * that the Blackbox header writing code doesn't have to guess about the best time to ask flashfs to
              * flush, and doesn't stall waiting for a flush that would otherwise not automatically be called.
              */
-            flashfsFlushAsync();
+            flashfsFlushAsync(false);
         }
         return BLACKBOX_RESERVE_TEMPORARY_FAILURE;
 #endif // USE_FLASHFS
@@ -42,8 +42,12 @@ extern int32_t blackboxHeaderBudget;
 
 void blackboxOpen(void);
 void blackboxWrite(uint8_t value);
+void blackboxWriteBytes(const uint8_t *data, int length);
 int blackboxWriteString(const char *s);
 
+bool blackboxDeviceCompression(void);
+void blackboxDeviceStartCompression(void);
+
 void blackboxDeviceFlush(void);
 bool blackboxDeviceFlushForce(void);
 bool blackboxDeviceFlushForceComplete(void);
@@ -0,0 +1,400 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#ifdef USE_BENCHMARK
+
+#include "blackbox/blackbox.h"
+#include "blackbox/blackbox_encoding.h"
+
+#include "common/filter.h"
+#include "common/maths.h"
+#include "common/printf.h"
+#include "common/sdft.h"
+
+#include "config/config.h"
+
+#include "drivers/system.h"
+#include "drivers/time.h"
+
+#include "flight/mixer.h"
+#include "flight/pid.h"
+#include "flight/rpm_filter.h"
+
+#include "benchmark.h"
+
+typedef struct {
+    const char *name;
+    const void *code;
+    bool (*setup)(void);
+    void (*run)(int iterations);
+    void (*done)(void);
+} benchmarkKernel_t;
+
+// Kernel state, only one kernel runs at a time
+static union {
+    biquadFilter_t  biquad[4];
+    sdft_t          sdft;
+    int32_t         frame[8];
+} work;
+
+static volatile float benchmarkSink;
+
+static uint8_t savedPidMode;
+
+// Test input, a 150Hz tone at 4kHz with some ripple
+static float benchmarkSample(int n)
+{
+    static const float wave[16] = {
+         0.00f,  0.92f,  0.71f, -0.38f, -1.00f, -0.38f,  0.71f,  0.92f,
+         0.05f, -0.88f, -0.74f,  0.35f,  0.98f,  0.41f, -0.69f, -0.95f,
+    };
+
+    return 100 * wave[n & 15];
+}
+
+/*
+ * Flash resident copies of the filter kernels.
+ *
+ * These are the same as biquadFilterApplyDF1(), biquadFilterApplyTF2() and
+ * filterStackApply(), without FAST_CODE, to tell the cost of the memory
+ * the code runs from.
+ */
+
+static NOINLINE float flashBiquadApplyDF1(biquadFilter_t *filter, float input)
+{
+    const float output =
+        filter->b0 * input +
+        filter->b1 * filter->x1 +
+        filter->b2 * filter->x2 -
+        filter->a1 * filter->y1 -
+        filter->a2 * filter->y2;
+
+    filter->x2 = filter->x1;
+    filter->x1 = input;
+    filter->y2 = filter->y1;
+    filter->y1 = output;
+
+    return output;
+}
+
+static NOINLINE float flashBiquadApplyTF2(biquadFilter_t *filter, float input)
+{
+    const float output = filter->b0 * input + filter->x1;
+
+    filter->x1 = filter->b1 * input - filter->a1 * output + filter->x2;
+    filter->x2 = filter->b2 * input - filter->a2 * output;
+
+    filter->y1 = output;
+
+    return output;
+}
+
+static NOINLINE float flashFilterStackApply(biquadFilter_t *filter, float input, int count)
+{
+    for (int i = 0; i < count; i++, filter++) {
+        const float output = filter->b0 * input + filter->x1;
+
+        filter->x1 = filter->b1 * input - filter->a1 * output + filter->x2;
+        filter->x2 = filter->b2 * input - filter->a2 * output;
+
+        input = output;
+    }
+
+    return input;
+}
+
+
+/** Filters **/
+
+static bool setupBiquad(void)
+{
+    biquadFilterInit(&work.biquad[0], 150, 4000, 3.0f, BIQUAD_NOTCH);
+    return true;
+}
+
+static bool setupStack(void)
+{
+    biquadFilterInit(&work.biquad[0], 150, 4000, 3.0f, BIQUAD_NOTCH);
+    biquadFilterInit(&work.biquad[1], 300, 4000, 3.0f, BIQUAD_NOTCH);
+    biquadFilterInit(&work.biquad[2], 120, 4000, BUTTER_4A_Q, BIQUAD_LPF);
+    biquadFilterInit(&work.biquad[3], 120, 4000, BUTTER_4B_Q, BIQUAD_LPF);
+    return true;
+}
+
+static void runBiquadDF1(int iterations)
+{
+    float out = 0;
+    for (int i = 0; i < iterations; i++)
+        out += biquadFilterApplyDF1(&work.biquad[0], benchmarkSample(i));
+    benchmarkSink = out;
+}
+
+static void runBiquadDF1Flash(int iterations)
+{
+    float out = 0;
+    for (int i = 0; i < iterations; i++)
+        out += flashBiquadApplyDF1(&work.biquad[0], benchmarkSample(i));
+    benchmarkSink = out;
+}
+
+static void runBiquadTF2(int iterations)
+{
+    float out = 0;
+    for (int i = 0; i < iterations; i++)
+        out += biquadFilterApplyTF2(&work.biquad[0], benchmarkSample(i));
+    benchmarkSink = out;
+}
+
+static void runBiquadTF2Flash(int iterations)
+{
+    float out = 0;
+    for (int i = 0; i < iterations; i++)
+        out += flashBiquadApplyTF2(&work.biquad[0], benchmarkSample(i));
+    benchmarkSink = out;
+}
+
+static void runStack(int iterations)
+{
+    float out = 0;
+    for (int i = 0; i < iterations; i++)
+        out += filterStackApply(work.biquad, benchmarkSample(i), 4);
+    benchmarkSink = out;
+}
+
+static void runStackFlash(int iterations)
+{
+    float out = 0;
+    for (int i = 0; i < iterations; i++)
+        out += flashFilterStackApply(work.biquad, benchmarkSample(i), 4);
+    benchmarkSink = out;
+}
+
+
+/** SDFT **/
+
+static bool setupSdft(void)
+{
+    sdftInit(&work.sdft, 1, SDFT_BIN_COUNT - 1, 3);
+    return true;
+}
+
+static void runSdft(int iterations)
+{
+    for (int i = 0; i < iterations; i++)
+        sdftPushBatch(&work.sdft, benchmarkSample(i), i % 3);
+    benchmarkSink = crealf(work.sdft.data[1]);
+}
+
+
+/** RPM filter **/
+
+#ifdef USE_RPM_FILTER
+static bool setupRpmFilter(void)
+{
+    return rpmFilterGetBankCount() > 0;
+}
+
+static void runRpmFilter(int iterations)
+{
+    float data[XYZ_AXIS_COUNT];
+    float out = 0;
+
+    for (int i = 0; i < iterations; i++) {
+        data[X] = benchmarkSample(i);
+        data[Y] = benchmarkSample(i + 5);
+        data[Z] = benchmarkSample(i + 11);
+        rpmFilterGyro(data);
+        out += data[X];
+    }
+
+    benchmarkSink = out;
+}
+#endif
+
+
+/** PID controller and mixer **/
+
+static bool setupPidMode(uint8_t mode)
+{
+    savedPidMode = currentPidProfile->pid_mode;
+    currentPidProfile->pid_mode = mode;
+    pidInitProfile(currentPidProfile);
+    return true;
+}
+
+static bool setupPidMode1(void)
+{
+    return setupPidMode(1);
+}
+
+static bool setupPidMode2(void)
+{
+    return setupPidMode(2);
+}
+
+static bool setupPidMode3(void)
+{
+    return setupPidMode(3);
+}
+
+static void runPid(int iterations)
+{
+    const timeUs_t currentTimeUs = micros();
+
+    for (int i = 0; i < iterations; i++)
+        pidController(currentPidProfile, currentTimeUs);
+    benchmarkSink = pidGetOutput(PID_ROLL);
+}
+
+static void donePid(void)
+{
+    currentPidProfile->pid_mode = savedPidMode;
+    pidInitProfile(currentPidProfile);
+    pidResetAxisErrors();
+}
+
+static void runMixer(int iterations)
+{
+    for (int i = 0; i < iterations; i++)
+        mixerUpdate();
+    benchmarkSink = mixerGetOutput(0);
+}
+
+
+/** Blackbox **/
+
+#ifdef USE_BLACKBOX
+static uint8_t savedBlackboxDevice;
+
+static bool setupBlackbox(void)
+{
+    // The encoder writes to the device, which is disabled while running
+    if (!blackboxMayEditConfig())
+        return false;
+
+    savedBlackboxDevice = blackboxConfig()->device;
+    blackboxConfigMutable()->device = BLACKBOX_DEVICE_NONE;
+
+    return true;
+}
+
+// Gyro, PID and setpoint deltas of a typical P-frame
+static void runBlackbox(int iterations)
+{
+    for (int i = 0; i < iterations; i++) {
+        for (int j = 0; j < 8; j++)
+            work.frame[j] = lrintf(benchmarkSample(i + j)) >> (j & 3);
+        blackboxWriteSignedVBArray(work.frame, 3);
+        blackboxWriteTag2_3S32(work.frame);
+        blackboxWriteTag8_4S16(work.frame + 4);
+        blackboxWriteTag8_8SVB(work.frame, 8);
+    }
+}
+
+static void doneBlackbox(void)
+{
+    blackboxConfigMutable()->device = savedBlackboxDevice;
+}
+#endif
+
+
+static const benchmarkKernel_t kernels[] = {
+    { "biquad_df1",         biquadFilterApplyDF1,   setupBiquad,    runBiquadDF1,       NULL },
+    { "biquad_df1",         flashBiquadApplyDF1,    setupBiquad,    runBiquadDF1Flash,  NULL },
+    { "biquad_tf2",         biquadFilterApplyTF2,   setupBiquad,    runBiquadTF2,       NULL },
+    { "biquad_tf2",         flashBiquadApplyTF2,    setupBiquad,    runBiquadTF2Flash,  NULL },
+    { "filter_stack4",      filterStackApply,       setupStack,     runStack,           NULL },
+    { "filter_stack4",      flashFilterStackApply,  setupStack,     runStackFlash,      NULL },
+    { "sdft_push_batch",    sdftPushBatch,          setupSdft,      runSdft,            NULL },
+#ifdef USE_RPM_FILTER
+    { "rpm_filter_gyro",    rpmFilterGyro,          setupRpmFilter, runRpmFilter,       NULL },
+#endif
+    { "pid_mode1",          pidController,          setupPidMode1,  runPid,             donePid },
+    { "pid_mode2",          pidController,          setupPidMode2,  runPid,             donePid },
+    { "pid_mode3",          pidController,          setupPidMode3,  runPid,             donePid },
+    { "mixer_update",       mixerUpdate,            NULL,           runMixer,           NULL },
+#ifdef USE_BLACKBOX
+    { "blackbox_frame",     blackboxWriteTag8_8SVB, setupBlackbox,  runBlackbox,        doneBlackbox },
+#endif
+};
+
+static const char *benchmarkRegion(const void *code)
+{
+    const uintptr_t addr = (uintptr_t)code;
+
+    if (addr < 0x00100000)
+        return "ITCM";
+    if (addr >= 0x08000000 && addr < 0x10000000)
+        return "FLASH";
+    if (addr >= 0x10000000 && addr < 0x18000000)
+        return "CCM";
+    if (addr >= 0x20000000 && addr < 0x40000000)
+        return "RAM";
+    if (addr >= 0x90000000 && addr < 0xA0000000)
+        return "XIP";
+
+    return "?";
+}
+
+int benchmarkCount(void)
+{
+    return ARRAYLEN(kernels);
+}
+
+bool benchmarkRun(int index, benchmarkResult_t *result)
+{
+    const benchmarkKernel_t *kernel = &kernels[index];
+
+    memset(result, 0, sizeof(*result));
+
+    tfp_sprintf(result->name, "%s", kernel->name);
+    result->region = benchmarkRegion(kernel->code);
+
+#ifdef USE_RPM_FILTER
+    if (kernel->run == runRpmFilter)
+        tfp_sprintf(result->name, "%s/%d", kernel->name, rpmFilterGetBankCount());
+#endif
+
+    if (kernel->setup && !kernel->setup())
+        return false;
+
+    // Warm up caches and flash prefetch
+    kernel->run(BENCHMARK_ITERATIONS);
+
+    uint32_t minCycles = UINT32_MAX;
+
+    for (int batch = 0; batch < BENCHMARK_BATCHES; batch++) {
+        const uint32_t start = getCycleCounter();
+        kernel->run(BENCHMARK_ITERATIONS);
+        const uint32_t cycles = getCycleCounter() - start;
+        minCycles = MIN(minCycles, cycles);
+    }
+
+    if (kernel->done)
+        kernel->done();
+
+    result->cycles = minCycles;
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "platform.h"
+
+/*
+ * On-target benchmark of the hot kernels.
+ *
+ * Each kernel is run BENCHMARK_BATCHES times for BENCHMARK_ITERATIONS
+ * operations, and the fastest batch is reported, so that interrupts
+ * hitting a batch do not skew the result. Kernels run from the memory
+ * region the build places them in, and the tight filter kernels are
+ * also run from a copy in flash for comparison.
+ */
+
+#define BENCHMARK_ITERATIONS    256
+#define BENCHMARK_BATCHES       8
+#define BENCHMARK_NAME_LEN      24
+
+typedef struct {
+    char        name[BENCHMARK_NAME_LEN];
+    const char *region;
+    uint32_t    cycles;         // fastest batch of BENCHMARK_ITERATIONS
+} benchmarkResult_t;
+
+#ifdef USE_BENCHMARK
+
+int  benchmarkCount(void);
+bool benchmarkRun(int index, benchmarkResult_t *result);
+
+#endif
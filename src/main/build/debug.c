@@ -22,12 +22,13 @@
 
 #include "debug.h"
 
-FAST_DATA_ZERO_INIT uint8_t debugMode;
+FAST_DATA_ZERO_INIT uint8_t debugModes[DEBUG_MODE_COUNT];
 FAST_DATA_ZERO_INIT uint8_t debugAxis;
 
-FAST_DATA_ZERO_INIT int32_t debug[DEBUG_VALUE_COUNT];
+FAST_DATA_ZERO_INIT int32_t debug[DEBUG_SLOT_COUNT];
+FAST_DATA_ZERO_INIT int32_t *debugBank[DEBUG_COUNT];
 
-FAST_DATA_ZERO_INIT uint32_t __timing[DEBUG_VALUE_COUNT];
+FAST_DATA_ZERO_INIT uint32_t __timing[DEBUG_SLOT_COUNT];
 
 #define DEBUG_NAME(x)  [DEBUG_ ## x] = #x
 
@@ -112,4 +113,22 @@ const char * const debugModeNames[DEBUG_COUNT] = {
     DEBUG_NAME(ERROR_DECAY),
     DEBUG_NAME(HS_OFFSET),
     DEBUG_NAME(HS_BLEED),
+    DEBUG_NAME(RPM_ORDERS),
+    DEBUG_NAME(GOV_LOAD),
+    DEBUG_NAME(PID_GAINS),
 };
+
+void debugInit(void)
+{
+    for (int mode = 0; mode < DEBUG_COUNT; mode++) {
+        debugBank[mode] = NULL;
+    }
+
+    // A mode selected twice keeps its first bank
+    for (int index = 0; index < DEBUG_MODE_COUNT; index++) {
+        const uint8_t mode = debugModes[index];
+        if (mode > DEBUG_NONE && mode < DEBUG_COUNT && !debugBank[mode]) {
+            debugBank[mode] = &debug[index * DEBUG_VALUE_COUNT];
+        }
+    }
+}
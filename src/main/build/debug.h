@@ -20,27 +20,40 @@
 
 #pragma once
 
+#include <stddef.h>
+
 #include "platform.h"
 
 #define DEBUG_VALUE_COUNT 8
+#define DEBUG_MODE_COUNT  2
+#define DEBUG_SLOT_COUNT  (DEBUG_VALUE_COUNT * DEBUG_MODE_COUNT)
+
+/*
+ * Each active debug mode owns DEBUG_VALUE_COUNT consecutive slots in
+ * debug[], found through debugBank[mode]. Inactive modes have a NULL
+ * bank, so a DEBUG_SET costs one load and branch whichever mode it is.
+ */
 
-extern uint8_t debugMode;
+extern uint8_t debugModes[DEBUG_MODE_COUNT];
 extern uint8_t debugAxis;
 
-extern int32_t debug[DEBUG_VALUE_COUNT];
+extern int32_t debug[DEBUG_SLOT_COUNT];
 
-extern uint32_t __timing[DEBUG_VALUE_COUNT];
+extern uint32_t __timing[DEBUG_SLOT_COUNT];
 
-#define DEBUG_SET(mode, index, value)             do { if (debugMode == (mode)) { debug[(index)] = (value); } } while (0)
-#define DEBUG_AXIS_SET(mode, axis, index, value)  do { if (debugAxis == (axis) && debugMode == (mode)) { debug[(index)] = (value); } } while (0)
-#define DEBUG_COND_SET(mode, cond, index, value)  do { if ((cond) && debugMode == (mode)) { debug[(index)] = (value); } } while (0)
+#define debugMode                                 debugModes[0]
+#define debugModeActive(mode)                     (debugBank[(mode)] != NULL)
+
+#define DEBUG_SET(mode, index, value)             do { int32_t *__bank = debugBank[(mode)]; if (__bank) { __bank[(index)] = (value); } } while (0)
+#define DEBUG_AXIS_SET(mode, axis, index, value)  do { int32_t *__bank = debugBank[(mode)]; if (__bank && debugAxis == (axis)) { __bank[(index)] = (value); } } while (0)
+#define DEBUG_COND_SET(mode, cond, index, value)  do { int32_t *__bank = debugBank[(mode)]; if (__bank && (cond)) { __bank[(index)] = (value); } } while (0)
 
 #define DEBUG(mode, index, value)                 DEBUG_SET(DEBUG_ ## mode, index, value)
 #define DEBUG_AXIS(mode, axis, index, value)      DEBUG_AXIS_SET(DEBUG_ ## mode, axis, index, value)
 #define DEBUG_COND(mode, cond, index, value)      DEBUG_COND_SET(DEBUG_ ## mode, cond, index, value)
 
-#define DEBUG_TIME_START(mode, index)             do { if (debugMode == (DEBUG_ ## mode)) { __timing[(index)] = micros(); } } while (0)
-#define DEBUG_TIME_END(mode, index)               do { if (debugMode == (DEBUG_ ## mode)) { debug[(index)] = micros() - __timing[(index)]; } } while (0)
+#define DEBUG_TIME_START(mode, index)             do { int32_t *__bank = debugBank[DEBUG_ ## mode]; if (__bank) { __timing[__bank - debug + (index)] = micros(); } } while (0)
+#define DEBUG_TIME_END(mode, index)               do { int32_t *__bank = debugBank[DEBUG_ ## mode]; if (__bank) { __bank[(index)] = micros() - __timing[__bank - debug + (index)]; } } while (0)
 
 
 typedef enum {
@@ -123,7 +136,14 @@ typedef enum {
     DEBUG_ERROR_DECAY,
     DEBUG_HS_OFFSET,
     DEBUG_HS_BLEED,
+    DEBUG_RPM_ORDERS,
+    DEBUG_GOV_LOAD,
+    DEBUG_PID_GAINS,
     DEBUG_COUNT
 } debugType_e;
 
+extern int32_t *debugBank[DEBUG_COUNT];
+
 extern const char * const debugModeNames[DEBUG_COUNT];
+
+void debugInit(void);
@@ -0,0 +1,175 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#include "common/maths.h"
+
+#include "config/config.h"
+
+#include "profiler.h"
+
+#define PROFILE_NAME(x)  [PROFILE_ ## x] = #x
+
+const char * const profileStageNames[PROFILE_STAGE_COUNT] = {
+    PROFILE_NAME(GYRO_UPDATE),
+    PROFILE_NAME(GYRO_DECIMATOR),
+    PROFILE_NAME(GYRO_FILTER),
+    PROFILE_NAME(GYRO_RPM_FILTER),
+    PROFILE_NAME(GYRO_LPF),
+    PROFILE_NAME(GYRO_NOTCH),
+    PROFILE_NAME(GYRO_DYN_NOTCH),
+    PROFILE_NAME(PID_CONTROLLER),
+    PROFILE_NAME(MIXER_UPDATE),
+};
+
+#ifdef USE_LOOP_PROFILER
+
+FAST_DATA_ZERO_INIT bool profilerActive;
+
+FAST_DATA_ZERO_INIT profileStage_t profileStages[PROFILE_STAGE_COUNT];
+
+
+FAST_CODE void profileRecord(profileStage_e stage, uint32_t cycles)
+{
+    profileStage_t *prof = &profileStages[stage];
+
+    // Bucket index from log2 of the cycle count
+    const int msb = cycles ? 31 - __builtin_clz(cycles) : 0;
+    const int bucket = constrain(msb - PROFILE_HISTOGRAM_SHIFT + 1, 0, PROFILE_HISTOGRAM_BUCKETS - 1);
+
+    prof->histogram[bucket]++;
+
+    if (cycles < prof->minCycles || prof->count == 0)
+        prof->minCycles = cycles;
+    if (cycles > prof->maxCycles)
+        prof->maxCycles = cycles;
+
+    prof->totalCycles += cycles;
+    prof->count++;
+}
+
+void profileReset(void)
+{
+    memset(profileStages, 0, sizeof(profileStages));
+}
+
+void profileInit(void)
+{
+    profileReset();
+
+    profilerActive = systemConfig()->task_statistics;
+}
+
+bool profileIsActive(void)
+{
+    return profilerActive;
+}
+
+void getProfileStage(profileStage_e stage, profileStage_t *info)
+{
+    *info = profileStages[stage];
+}
+
+#else
+
+void profileInit(void)
+{
+}
+
+void profileReset(void)
+{
+}
+
+bool profileIsActive(void)
+{
+    return false;
+}
+
+void getProfileStage(profileStage_e stage, profileStage_t *info)
+{
+    UNUSED(stage);
+    memset(info, 0, sizeof(profileStage_t));
+}
+
+#endif
+
+uint32_t profileStageMeanCycles(const profileStage_t *info)
+{
+    return info->count ? info->totalCycles / info->count : 0;
+}
+
+#ifdef USE_FUNCTION_PROFILER
+
+#define NO_INSTRUMENT  __attribute__((no_instrument_function))
+
+static funcProfileEntry_t funcProfile[FUNC_PROFILE_SLOTS];
+
+static uint32_t funcProfileDropCount;
+
+NO_INSTRUMENT void __cyg_profile_func_enter(void *func, void *caller)
+{
+    const uint32_t address = (uint32_t)func;
+
+    UNUSED(caller);
+
+    // Linear probing from the address hash. Races with interrupts may create
+    // a duplicate slot, which the placement tool sums up.
+    uint32_t index = (address >> 1) * 2654435761u;
+
+    for (int probe = 0; probe < FUNC_PROFILE_SLOTS; probe++) {
+        funcProfileEntry_t *entry = &funcProfile[(index + probe) % FUNC_PROFILE_SLOTS];
+        if (entry->address == address) {
+            entry->count++;
+            return;
+        }
+        if (entry->address == 0) {
+            entry->address = address;
+            entry->count = 1;
+            return;
+        }
+    }
+
+    funcProfileDropCount++;
+}
+
+NO_INSTRUMENT void __cyg_profile_func_exit(void *func, void *caller)
+{
+    UNUSED(func);
+    UNUSED(caller);
+}
+
+void funcProfileReset(void)
+{
+    memset(funcProfile, 0, sizeof(funcProfile));
+    funcProfileDropCount = 0;
+}
+
+uint32_t funcProfileDropped(void)
+{
+    return funcProfileDropCount;
+}
+
+const funcProfileEntry_t * getFuncProfileEntry(int index)
+{
+    return (index >= 0 && index < FUNC_PROFILE_SLOTS) ? &funcProfile[index] : NULL;
+}
+
+#endif
@@ -0,0 +1,127 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "platform.h"
+
+#include "drivers/system.h"
+
+/*
+ * Cycle-accurate profiler for the realtime loop stages.
+ *
+ * Each stage keeps min/max/mean cycle counts and a log2 histogram.
+ * The histogram bucket N counts samples below (PROFILE_HISTOGRAM_BASE << N)
+ * cycles, and the last bucket counts everything above.
+ */
+
+#define PROFILE_HISTOGRAM_BUCKETS   8
+#define PROFILE_HISTOGRAM_SHIFT     7
+#define PROFILE_HISTOGRAM_BASE      (1 << PROFILE_HISTOGRAM_SHIFT)
+
+typedef enum {
+    PROFILE_GYRO_UPDATE = 0,
+    PROFILE_GYRO_DECIMATOR,
+    PROFILE_GYRO_FILTER,
+    PROFILE_GYRO_RPM_FILTER,
+    PROFILE_GYRO_LPF,
+    PROFILE_GYRO_NOTCH,
+    PROFILE_GYRO_DYN_NOTCH,
+    PROFILE_PID_CONTROLLER,
+    PROFILE_MIXER_UPDATE,
+    PROFILE_STAGE_COUNT
+} profileStage_e;
+
+typedef struct {
+    uint32_t    count;
+    uint32_t    minCycles;
+    uint32_t    maxCycles;
+    uint64_t    totalCycles;
+    uint32_t    pendingCycles;
+    uint32_t    histogram[PROFILE_HISTOGRAM_BUCKETS];
+} profileStage_t;
+
+extern const char * const profileStageNames[PROFILE_STAGE_COUNT];
+
+#ifdef USE_LOOP_PROFILER
+
+extern bool profilerActive;
+extern profileStage_t profileStages[PROFILE_STAGE_COUNT];
+
+void profileRecord(profileStage_e stage, uint32_t cycles);
+
+static inline uint32_t profileLap(profileStage_e stage, uint32_t start)
+{
+    const uint32_t now = getCycleCounter();
+    profileStages[stage].pendingCycles += now - start;
+    return now;
+}
+
+static inline void profileCommit(profileStage_e stage)
+{
+    if (profilerActive) {
+        profileRecord(stage, profileStages[stage].pendingCycles);
+    }
+    profileStages[stage].pendingCycles = 0;
+}
+
+#define PROFILE_START(stage)            const uint32_t __profile_ ## stage = getCycleCounter()
+#define PROFILE_END(stage)              do { if (profilerActive) { profileRecord(PROFILE_ ## stage, getCycleCounter() - __profile_ ## stage); } } while (0)
+
+#define PROFILE_LAP_START(lap)          uint32_t lap = getCycleCounter()
+#define PROFILE_LAP(lap, stage)         lap = profileLap(PROFILE_ ## stage, lap)
+#define PROFILE_COMMIT(stage)           profileCommit(PROFILE_ ## stage)
+
+#else
+
+#define PROFILE_START(stage)
+#define PROFILE_END(stage)
+#define PROFILE_LAP_START(lap)
+#define PROFILE_LAP(lap, stage)
+#define PROFILE_COMMIT(stage)
+
+#endif
+
+void profileInit(void);
+void profileReset(void);
+bool profileIsActive(void);
+void getProfileStage(profileStage_e stage, profileStage_t *info);
+uint32_t profileStageMeanCycles(const profileStage_t *info);
+
+/*
+ * Function entry counter for FUNCTION_PROFILE=yes builds.
+ *
+ * Every instrumented function entry is counted by address into a small
+ * open addressing table. The table is dumped with the CLI 'funcprofile'
+ * command and turned into a fast RAM placement list by
+ * src/utils/fast-placement.py.
+ */
+
+#define FUNC_PROFILE_SLOTS          512
+
+typedef struct {
+    uint32_t    address;
+    uint32_t    count;
+} funcProfileEntry_t;
+
+#ifdef USE_FUNCTION_PROFILER
+
+void funcProfileReset(void);
+uint32_t funcProfileDropped(void);
+const funcProfileEntry_t * getFuncProfileEntry(int index);
+
+#endif
@@ -38,6 +38,8 @@ bool cliMode = false;
 
 #include "build/build_config.h"
 #include "build/debug.h"
+#include "build/benchmark.h"
+#include "build/profiler.h"
 #include "build/version.h"
 
 #include "cli/settings.h"
@@ -97,18 +99,22 @@ bool cliMode = false;
 #include "drivers/freq.h"
 
 #include "fc/board_info.h"
+#include "fc/boot_timeline.h"
 #include "fc/rc_rates.h"
 #include "fc/core.h"
 #include "fc/rc.h"
 #include "fc/rc_adjustments.h"
 #include "fc/rc_controls.h"
 #include "fc/runtime_config.h"
+#include "fc/watchdog.h"
 
 #include "flight/failsafe.h"
 #include "flight/imu.h"
 #include "flight/mixer.h"
 #include "flight/pid.h"
 #include "flight/position.h"
+#include "flight/rpm_filter.h"
+#include "flight/setpoint.h"
 #include "flight/servos.h"
 #include "flight/motors.h"
 
@@ -156,6 +162,7 @@ bool cliMode = false;
 
 #include "rx/rx_bind.h"
 #include "rx/rx_spi.h"
+#include "rx/rx_timing.h"
 
 #include "scheduler/scheduler.h"
 
@@ -179,7 +186,7 @@ static serialPort_t *cliPort = NULL;
 
 // Space required to set array parameters
 #define CLI_IN_BUFFER_SIZE 256
-#define CLI_OUT_BUFFER_SIZE 64
+#define CLI_OUT_BUFFER_SIZE 256
 
 static bufWriter_t cliWriterDesc;
 static bufWriter_t *cliWriter = NULL;
@@ -197,7 +204,13 @@ static int8_t rateProfileIndexToUse = CURRENT_PROFILE_INDEX;
 
 #ifdef USE_CLI_BATCH
 static bool commandBatchActive = false;
-static bool commandBatchError = false;
+static bool commandBatchFlowControl = false;
+static uint16_t commandBatchLines = 0;
+static uint16_t commandBatchErrors = 0;
+static uint16_t commandBatchErrorLine = 0;
+
+#define CLI_XON  0x11
+#define CLI_XOFF 0x13
 #endif
 
 #if defined(USE_BOARD_INFO)
@@ -401,13 +414,17 @@ static void cliWriterFlushInternal(bufWriter_t *writer)
     }
 }
 
+/*
+ * Output is only written out when the buffer fills up, on an explicit
+ * cliWriterFlush() and at the start of every cliProcess() call. A dump
+ * goes out in full buffers rather than one write per fragment.
+ */
 static void cliPrintInternal(bufWriter_t *writer, const char *str)
 {
     if (writer) {
         while (*str) {
             bufWriterAppend(writer, *str++);
         }
-        cliWriterFlushInternal(writer);
     }
 }
 
@@ -451,7 +468,6 @@ static void cliPrintfva(const char *format, va_list va)
 {
     if (cliWriter) {
         tfp_format(cliWriter, cliPutp, format, va);
-        cliWriterFlush();
     }
 }
 
@@ -525,7 +541,10 @@ static void cliPrintErrorVa(const char *cmdName, const char *format, va_list va)
 
 #ifdef USE_CLI_BATCH
     if (commandBatchActive) {
-        commandBatchError = true;
+        if (!commandBatchErrors) {
+            commandBatchErrorLine = commandBatchLines;
+        }
+        commandBatchErrors++;
     }
 #endif
 }
@@ -870,12 +889,24 @@ static const char *dumpPgValue(const char *cmdName, const clivalue_t *value, dum
 
 static void dumpAllValues(const char *cmdName, uint16_t valueSection, dumpFlags_t dumpMask, const char *headingStr)
 {
+    // In a diff, the values of a group that is identical to its defaults are skipped as a whole
+    const pgRegistry_t *pg = NULL;
+    bool pgEqualsDefault = false;
+
     headingStr = cliPrintSectionHeading(dumpMask, false, headingStr);
 
     for (uint32_t i = 0; i < valueTableEntryCount; i++) {
         const clivalue_t *value = &valueTable[i];
-        cliWriterFlush();
         if ((value->type & VALUE_SECTION_MASK) == valueSection || ((valueSection == MASTER_VALUE) && (value->type & VALUE_SECTION_MASK) == HARDWARE_VALUE)) {
+            if (dumpMask & DO_DIFF) {
+                if (!pg || pgN(pg) != value->pgn) {
+                    pg = pgFind(value->pgn);
+                    pgEqualsDefault = pg && memcmp(pg->copy, pg->address, pgSize(pg)) == 0;
+                }
+                if (pgEqualsDefault) {
+                    continue;
+                }
+            }
             headingStr = dumpPgValue(cmdName, value, dumpMask, headingStr);
         }
     }
@@ -1657,6 +1688,8 @@ static void cliSerialPassthrough(const char *cmdName, char *cmdline)
     }
 #endif
 
+    cliWriterFlush();
+
     serialPassthrough(ports[0].port, ports[1].port, NULL, NULL);
 }
 #endif
@@ -2181,6 +2214,7 @@ static void cliServo(const char *cmdName, char *cmdline)
         servo->rate = vals[RATE];
         servo->speed = vals[SPEED];
         servo->flags = vals[FLAGS];
+        servoUpdateLimits(index);
         cliPrintLinef(format,
             index + 1,
             servo->mid,
@@ -2587,7 +2621,6 @@ static void cliWriteBytes(const uint8_t *buffer, int count)
 static void cliSdInfo(const char *cmdName, char *cmdline)
 {
     UNUSED(cmdName);
-    UNUSED(cmdline);
 
     cliPrint("SD card: ");
 
@@ -2648,6 +2681,26 @@ static void cliSdInfo(const char *cmdName, char *cmdline)
         break;
     }
     cliPrintLinefeed();
+
+    if (strcasecmp(cmdline, "reset") == 0) {
+        sdcard_resetLatencyStats();
+    }
+
+    static const char * const operationNames[] = { "Read", "Write" };
+
+    for (int op = SDCARD_BLOCK_OPERATION_READ; op <= SDCARD_BLOCK_OPERATION_WRITE; op++) {
+        const sdcardLatencyStats_t *stats = sdcard_getLatencyStats(op);
+
+        cliPrintf("%s latency:", operationNames[op]);
+        for (int i = 0; i < SDCARD_LATENCY_BUCKET_COUNT; i++) {
+            if (i < SDCARD_LATENCY_BUCKET_COUNT - 1) {
+                cliPrintf(" <%uus:%u", SDCARD_LATENCY_BUCKET_BASE_US << i, stats->bucket[i]);
+            } else {
+                cliPrintf(" more:%u", stats->bucket[i]);
+            }
+        }
+        cliPrintLinef(" max:%uus", stats->maxUs);
+    }
 }
 
 #endif
@@ -3810,6 +3863,8 @@ static void cliGpsPassthrough(const char *cmdName, char *cmdline)
     UNUSED(cmdName);
     UNUSED(cmdline);
 
+    cliWriterFlush();
+
     gpsEnablePassthrough(cliPort);
 }
 #endif
@@ -3964,6 +4019,8 @@ static void cliEscPassthrough(const char *cmdName, char *cmdline)
         pch = strtok_r(NULL, " ", &saveptr);
     }
 
+    cliWriterFlush();
+
     if (!escEnablePassthrough(cliPort, &motorConfig()->dev, escIndex, mode)) {
         cliPrintErrorLinef(cmdName, "Error starting ESC connection");
     }
@@ -4167,6 +4224,7 @@ static void cliDumpRateProfile(const char *cmdName, uint8_t rateProfileIndex, du
 #ifdef USE_CLI_BATCH
 static void cliPrintCommandBatchWarning(const char *cmdName, const char *warning)
 {
+    cliPrintLinef("###%d ERRORS IN %d COMMANDS, FIRST IN COMMAND %d###", commandBatchErrors, commandBatchLines, commandBatchErrorLine);
     cliPrintErrorLinef(cmdName, "ERRORS WERE DETECTED - PLEASE REVIEW BEFORE CONTINUING");
     if (warning) {
         cliPrintErrorLinef(cmdName, warning);
@@ -4176,7 +4234,9 @@ static void cliPrintCommandBatchWarning(const char *cmdName, const char *warning
 static void resetCommandBatch(void)
 {
     commandBatchActive = false;
-    commandBatchError = false;
+    commandBatchFlowControl = false;
+    commandBatchLines = 0;
+    commandBatchErrors = 0;
 }
 
 static void cliBatch(const char *cmdName, char *cmdline)
@@ -4184,11 +4244,16 @@ static void cliBatch(const char *cmdName, char *cmdline)
     if (strncasecmp(cmdline, "start", 5) == 0) {
         if (!commandBatchActive) {
             commandBatchActive = true;
-            commandBatchError = false;
+            commandBatchLines = 0;
+            commandBatchErrors = 0;
+        }
+        // A nested 'batch start' (e.g. at the top of a pasted diff) keeps flow control on
+        if (strcasestr(cmdline, "flow")) {
+            commandBatchFlowControl = true;
         }
         cliPrintLine("Command batch started");
     } else if (strncasecmp(cmdline, "end", 3) == 0) {
-        if (commandBatchActive && commandBatchError) {
+        if (commandBatchActive && commandBatchErrors) {
             cliPrintCommandBatchWarning(cmdName, NULL);
         } else {
             cliPrintLine("Command batch ended");
@@ -4209,7 +4274,7 @@ static bool prepareSave(void)
 #endif
 
 #ifdef USE_CLI_BATCH
-    if (commandBatchActive && commandBatchError) {
+    if (commandBatchActive && commandBatchErrors) {
         return false;
     }
 #endif
@@ -4264,7 +4329,7 @@ bool resetConfigToCustomDefaults(void)
     resetConfig();
 
 #ifdef USE_CLI_BATCH
-    commandBatchError = false;
+    commandBatchErrors = 0;
 #endif
 
     cliProcessCustomDefaults(true);
@@ -4379,7 +4444,7 @@ static void cliDefaults(const char *cmdName, char *cmdline)
     // This way if a "defaults nosave" was issued after the "batch on" we'll
     // only reset the current error state but the batch will still be active
     // for subsequent commands.
-    commandBatchError = false;
+    commandBatchErrors = 0;
 #endif
 
 #if defined(USE_CUSTOM_DEFAULTS)
@@ -4472,16 +4537,52 @@ static uint8_t getWordLength(char *bufBegin, char *bufEnd)
     return bufEnd - bufBegin;
 }
 
+static int settingNameCompare(const void *a, const void *b)
+{
+    return strcasecmp(valueTable[*(const uint16_t *)a].name, valueTable[*(const uint16_t *)b].name);
+}
+
+static void cliBuildSettingIndex(void)
+{
+    static bool settingIndexValid = false;
+
+    if (!settingIndexValid) {
+        for (uint32_t i = 0; i < valueTableEntryCount; i++) {
+            valueTableNameIndex[i] = i;
+        }
+        qsort(valueTableNameIndex, valueTableEntryCount, sizeof(valueTableNameIndex[0]), settingNameCompare);
+        settingIndexValid = true;
+    }
+}
+
 uint16_t cliGetSettingIndex(char *name, uint8_t length)
 {
-    for (uint32_t i = 0; i < valueTableEntryCount; i++) {
-        const char *settingName = valueTable[i].name;
+    cliBuildSettingIndex();
+
+    // Binary search over the setting names in case-insensitive order
+    int lower = 0;
+    int upper = valueTableEntryCount - 1;
+
+    while (lower <= upper) {
+        const int middle = (lower + upper) / 2;
+        const uint16_t index = valueTableNameIndex[middle];
+        const char *settingName = valueTable[index].name;
 
         // ensure exact match when setting to prevent setting variables with shorter names
-        if (strncasecmp(name, settingName, strlen(settingName)) == 0 && length == strlen(settingName)) {
-            return i;
+        int cmp = strncasecmp(name, settingName, length);
+        if (cmp == 0 && settingName[length] != '\0') {
+            cmp = -1;
+        }
+
+        if (cmp == 0) {
+            return index;
+        } else if (cmp < 0) {
+            upper = middle - 1;
+        } else {
+            lower = middle + 1;
         }
     }
+
     return valueTableEntryCount;
 }
 
@@ -4726,6 +4827,25 @@ static void cliStatus(const char *cmdName, char *cmdline)
 #endif
     cliPrintLinefeed();
 
+#ifdef USE_FAST_DATA
+    extern uint8_t _sfastram_data;
+    extern uint8_t _efastram_data;
+    extern uint8_t __fastram_bss_start__;
+    extern uint8_t __fastram_bss_end__;
+    extern uint8_t _efastram;
+
+    // The stack may share the fast RAM region, above FAST_DATA
+    const uintptr_t fastDataEnd = (uintptr_t)&__fastram_bss_end__;
+    const uintptr_t stackLowMem = stackHighMem() - stackTotalSize();
+    uintptr_t fastRamEnd = (uintptr_t)&_efastram;
+    if (stackLowMem >= fastDataEnd && stackLowMem < fastRamEnd) {
+        fastRamEnd = stackLowMem;
+    }
+
+    cliPrintLinef("FAST_DATA: %d, FAST_DATA_ZERO_INIT: %d, free: %d",
+        (int)(&_efastram_data - &_sfastram_data), (int)(&__fastram_bss_end__ - &__fastram_bss_start__), (int)(fastRamEnd - fastDataEnd));
+#endif
+
     cliPrintLinef("Configuration: %s, size: %d, max available: %d", configurationStates[systemConfigMutable()->configurationState], getEEPROMConfigSize(), getEEPROMStorageSize());
 
     // Devices
@@ -4762,11 +4882,18 @@ static void cliStatus(const char *cmdName, char *cmdline)
     }
     if (gyroActiveDev()->gyroModeSPI == GYRO_EXTI_INT_DMA) {
         cliPrintf(" dma");
+#ifdef USE_GYRO_SAMPLE_QUEUE
+        cliPrintf(" overruns %u", gyroActiveDev()->queue.overruns);
+#endif
     }
     if (spiGetExtDeviceCount(&gyroActiveDev()->dev) > 1) {
         cliPrintf(" shared");
     }
 #endif
+    uint32_t periodNs, jitterNs;
+    if (gyroGetSampleTiming(&periodNs, &jitterNs)) {
+        cliPrintf(" period %uns jitter %uns", periodNs, jitterNs);
+    }
     cliPrintLinefeed();
 
 #if defined(USE_SENSOR_NAMES)
@@ -4825,6 +4952,30 @@ static void cliStatus(const char *cmdName, char *cmdline)
     cliPrintLinef("CPU:%d%%, cycle time: %d, GYRO rate: %d, RX rate: %d, System rate: %d",
             constrain(getAverageCPULoadPercent(), 0, 100), getTaskDeltaTimeUs(TASK_GYRO), gyroRate, rxRate, systemRate);
 
+    if (schedulerConfig()->idleSleep) {
+        cliPrintLinef("Idle sleep: %d%%", constrain(getAverageIdleLoadPercent(), 0, 100));
+    }
+
+    if (schedulerGetLoadShedLevel()) {
+        cliPrintLinef("Load shedding: OSD, LED and dashboard rates 1/%d", 1 << schedulerGetLoadShedLevel());
+    }
+
+    const loopRateStatus_t *loopRate = getLoopRateStatus();
+    if (loopRate->pidDenom) {
+        cliPrintLinef("Loop rate: cost %d.%d us, budget %d.%d us, pid_process_denom %d, filter_process_denom %d",
+                loopRate->cost / 10, loopRate->cost % 10, loopRate->budget / 10, loopRate->budget % 10,
+                loopRate->pidDenom, loopRate->filterDenom);
+    }
+
+    const setpointLatency_t *rxLatency = getSetpointLatency();
+    cliPrintLinef("RX latency: min %d, avg %d, max %d, jitter %d us",
+            rxLatency->min, rxLatency->avg, rxLatency->max, rxLatency->jitter);
+
+    const rxTiming_t *rxTiming = rxTimingGet();
+    cliPrintLinef("RX timing: period %d us, jitter %d us, %s, frames %u, missed %u",
+            (int)lrintf(rxTiming->periodUs), (int)lrintf(rxTiming->jitterUs), rxTiming->locked ? "locked" : "unlocked",
+            (unsigned)rxTiming->frames, (unsigned)rxTiming->missed);
+
     // Battery meter
 
     cliPrintLinef("Voltage: %d * 0.01V (%dS battery - %s)", getBatteryVoltage(), getBatteryCellCount(), getBatteryStateString());
@@ -4838,6 +4989,31 @@ static void cliStatus(const char *cmdName, char *cmdline)
 #endif
     cliPrintLinef("I2C Errors: %d", i2cErrorCounter);
 
+#ifdef USE_LOOP_WATCHDOG
+    loopWatchdogFault_t loopFault;
+    if (loopWatchdogGetFault(&loopFault)) {
+        taskInfo_t taskInfo;
+        getTaskInfo(loopFault.taskId < TASK_COUNT ? loopFault.taskId : TASK_SYSTEM, &taskInfo);
+        cliPrintLinef("Loop stalls: %d, task %s, pc 0x%08x, lr 0x%08x, sp 0x%08x%s",
+            loopFault.count, loopFault.taskId < TASK_COUNT ? taskInfo.taskName : "NONE",
+            loopFault.pc, loopFault.lr, loopFault.sp, loopWatchdogTripped() ? " (this boot)" : "");
+    }
+#endif
+
+#ifdef USE_BOOT_TIMELINE
+    const unsigned bootMarks = bootTimelineCount();
+    if (bootMarks) {
+        cliPrintf("Boot timeline: total %u ms,", (unsigned)(bootTimelineGet(bootMarks - 1)->timeUs / 1000));
+        uint32_t phaseStartUs = 0;
+        for (unsigned index = 0; index < bootMarks; index++) {
+            const bootTimelineEntry_t *entry = bootTimelineGet(index);
+            cliPrintf(" %s %u", entry->name, (unsigned)((entry->timeUs - phaseStartUs) / 1000));
+            phaseStartUs = entry->timeUs;
+        }
+        cliPrintLinefeed();
+    }
+#endif
+
 #ifdef USE_SDCARD
     cliSdInfo(cmdName, "");
 #endif
@@ -4900,20 +5076,174 @@ static void cliTasks(const char *cmdName, char *cmdline)
             schedulerResetTaskMaxExecutionTime(taskId);
         }
     }
+#if defined(USE_TASK_BUDGET_STATISTICS) && !defined(MINIMAL_CLI)
+    if (systemConfig()->task_statistics) {
+        cliPrintLine("Task budget               runs  p99/us worst/us  overrun maxover/us");
+        for (taskId_e taskId = 0; taskId < TASK_COUNT; taskId++) {
+            taskInfo_t taskInfo;
+            getTaskInfo(taskId, &taskInfo);
+            if (taskInfo.isEnabled && taskInfo.budgetSamples) {
+                cliPrintLinef("%02d - (%15s) %6u %7d %8d %8u %10d", taskId, taskInfo.taskName,
+                        taskInfo.budgetSamples, taskInfo.percentileExecutionTimeUs, taskInfo.worstExecutionTimeUs,
+                        taskInfo.deadlineOverrunCount, taskInfo.maxDeadlineOverrunUs);
+            }
+            schedulerResetTaskBudget(taskId);
+        }
+    }
+#endif
     if (systemConfig()->task_statistics) {
         cfCheckFuncInfo_t checkFuncInfo;
         getCheckFuncInfo(&checkFuncInfo);
         cliPrintLinef("RX Check Function %19d %7d %25d", checkFuncInfo.maxExecutionTimeUs, checkFuncInfo.averageExecutionTimeUs, checkFuncInfo.totalExecutionTimeUs / 1000);
         cliPrintLinef("Total (excluding SERIAL) %33d.%1d%%", averageLoadSum/10, averageLoadSum%10);
-        if (debugMode == DEBUG_SCHEDULER_DETERMINISM) {
+        if (debugModeActive(DEBUG_SCHEDULER_DETERMINISM)) {
             extern int32_t schedLoopStartCycles, taskGuardCycles;
 
             cliPrintLinef("Scheduler start cycles %d guard cycles %d", schedLoopStartCycles, taskGuardCycles);
         }
         schedulerResetCheckFunctionMaxExecutionTime();
     }
+#ifdef USE_LOOP_PROFILER
+    if (profileIsActive()) {
+        cliPrintLine("Loop stage              count  min/us  avg/us  max/us  histogram/cycles <128 .. >8192");
+        for (profileStage_e stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+            profileStage_t info;
+            getProfileStage(stage, &info);
+            const int minTime = clockCyclesTo10thMicros(info.minCycles);
+            const int avgTime = clockCyclesTo10thMicros(profileStageMeanCycles(&info));
+            const int maxTime = clockCyclesTo10thMicros(info.maxCycles);
+            cliPrintf("%02d - (%15s) %9u %5d.%1d %5d.%1d %5d.%1d ", stage, profileStageNames[stage],
+                    info.count, minTime/10, minTime%10, avgTime/10, avgTime%10, maxTime/10, maxTime%10);
+            for (int bucket = 0; bucket < PROFILE_HISTOGRAM_BUCKETS; bucket++) {
+                cliPrintf(" %u", info.histogram[bucket]);
+            }
+            cliPrintLinefeed();
+        }
+        profileReset();
+    }
+#endif
 }
 
+#ifdef USE_FUNCTION_PROFILER
+static void cliFuncProfile(const char *cmdName, char *cmdline)
+{
+    UNUSED(cmdName);
+
+    if (strcasecmp(cmdline, "reset") == 0) {
+        funcProfileReset();
+        return;
+    }
+
+    for (int index = 0; index < FUNC_PROFILE_SLOTS; index++) {
+        const funcProfileEntry_t *entry = getFuncProfileEntry(index);
+        if (entry->address) {
+            cliPrintLinef("func 0x%08x %u", entry->address, entry->count);
+        }
+    }
+    cliPrintLinef("# dropped %u", funcProfileDropped());
+}
+#endif
+
+#ifdef USE_BENCHMARK
+static void cliBenchmark(const char *cmdName, char *cmdline)
+{
+    UNUSED(cmdName);
+    UNUSED(cmdline);
+
+    const uint32_t cyclesPerUs = clockMicrosToCycles(1);
+
+    cliPrintLinef("# %d ops, best of %d batches @ %dMHz", BENCHMARK_ITERATIONS, BENCHMARK_BATCHES, cyclesPerUs);
+    cliPrintLine("Kernel                  region  cycles/op    ns/op");
+
+    for (int index = 0; index < benchmarkCount(); index++) {
+        benchmarkResult_t result;
+
+        if (benchmarkRun(index, &result)) {
+            const uint32_t cycles10 = result.cycles * 10 / BENCHMARK_ITERATIONS;
+            const uint32_t nanos10 = result.cycles * 10000 / (cyclesPerUs * BENCHMARK_ITERATIONS);
+            cliPrintLinef("%23s %7s %8d.%1d %6d.%1d", result.name, result.region,
+                cycles10 / 10, cycles10 % 10, nanos10 / 10, nanos10 % 10);
+        } else {
+            cliPrintLinef("%23s %7s    skipped", result.name, result.region);
+        }
+    }
+}
+#endif
+
+#ifdef USE_RPM_FILTER
+static void cliRpmTune(const char *cmdName, char *cmdline)
+{
+    uint8_t target = 95;
+    bool apply = false;
+
+    char *saveptr;
+    for (char *tok = strtok_r(cmdline, " ", &saveptr); tok; tok = strtok_r(NULL, " ", &saveptr)) {
+        if (strcasecmp(tok, "apply") == 0) {
+            apply = true;
+        } else if (strcasecmp(tok, "reset") == 0) {
+            rpmFilterResetAnalysis();
+            cliPrintLine("Hover analysis reset");
+            return;
+        } else {
+            const int value = atoi(tok);
+            if (value < 1 || value > 100) {
+                cliShowArgumentRangeError(cmdName, "TARGET", 1, 100);
+                return;
+            }
+            target = value;
+        }
+    }
+
+    if (rpmFilterGetBankCount() == 0 || rpmFilterGetAnalysisCount() == 0) {
+        cliPrintErrorLinef(cmdName, "NO HOVER DATA");
+        return;
+    }
+
+    rpmFilterTuning_t tune[RPM_FILTER_BANK_COUNT];
+    const int count = rpmFilterGetTuning(target, tune);
+
+    rpmFilterConfig_t *config = rpmFilterConfigMutable();
+
+    cliPrintLinef("# Banks covering %d%% of the harmonic energy", target);
+    cliPrintLine("Bank source  ratio freq/Hz   ampl  share   q  tuned");
+
+    for (int index = 0; index < count; index++) {
+        const rpmFilterTuning_t *bank = &tune[index];
+        const int ampl = lrintf(bank->amplitude * 100);
+        const int share = lrintf(bank->share * 1000);
+
+        char tuned[8];
+        if (bank->keep) {
+            tfp_sprintf(tuned, "%d", bank->notchQ);
+        } else {
+            strcpy(tuned, "off");
+        }
+
+        cliPrintLinef("%4d %6d %6d %7d %3d.%02d %3d.%1d%% %3d %6s",
+            bank->configIndex,
+            config->filter_bank_rpm_source[bank->configIndex],
+            config->filter_bank_rpm_ratio[bank->configIndex],
+            lrintf(bank->notchHz),
+            ampl / 100, ampl % 100,
+            share / 10, share % 10,
+            config->filter_bank_notch_q[bank->configIndex],
+            tuned);
+    }
+
+    if (apply) {
+        for (int index = 0; index < count; index++) {
+            const rpmFilterTuning_t *bank = &tune[index];
+            if (bank->keep) {
+                config->filter_bank_notch_q[bank->configIndex] = bank->notchQ;
+            } else {
+                config->filter_bank_rpm_source[bank->configIndex] = 0;
+            }
+        }
+        cliPrintHashLine("applied, save to take effect");
+    }
+}
+#endif
+
 static void printVersion(const char *cmdName, bool printBoardInfo)
 {
     UNUSED(cmdName);
@@ -5256,6 +5586,33 @@ static void showDma(void)
             cliPrintLinef(" %s", ownerNames[owner->owner]);
         }
     }
+
+    const uint8_t conflictCount = dmaGetConflictCount();
+    if (conflictCount) {
+        cliPrintLinefeed();
+#ifdef MINIMAL_CLI
+        cliPrintLine("DMA conflicts:");
+#else
+        cliPrintLine("Refused DMA requests (running without DMA):");
+        cliRepeat('-', 20);
+#endif
+        for (int i = 0; i < conflictCount; i++) {
+            const dmaConflict_t *conflict = dmaGetConflict(i);
+            const resourceOwner_t *holder = dmaGetOwner(conflict->identifier);
+
+            if (conflict->owner.resourceIndex > 0) {
+                cliPrintf("%s %d", ownerNames[conflict->owner.owner], conflict->owner.resourceIndex);
+            } else {
+                cliPrintf("%s", ownerNames[conflict->owner.owner]);
+            }
+            cliPrintf(" wants " DMA_OUTPUT_STRING, DMA_DEVICE_NO(conflict->identifier), DMA_DEVICE_INDEX(conflict->identifier));
+            if (holder->resourceIndex > 0) {
+                cliPrintLinef(" held by %s %d", ownerNames[holder->owner], holder->resourceIndex);
+            } else {
+                cliPrintLinef(" held by %s", ownerNames[holder->owner]);
+            }
+        }
+    }
 }
 #endif
 
@@ -6365,7 +6722,7 @@ const clicmd_t cmdTable[] = {
     CLI_COMMAND_DEF("adjfunc", "configure adjustment functions", "<index> <func> <enable channel> <start> <end> <value channel> <dec start> <dec end> <inc start> <inc end> <step size> <value min> <value max>", cliAdjustmentRange),
     CLI_COMMAND_DEF("aux", "configure modes", "<index> <mode> <aux> <start> <end> <logic>", cliAux),
 #ifdef USE_CLI_BATCH
-    CLI_COMMAND_DEF("batch", "start or end a batch of commands", "start | end", cliBatch),
+    CLI_COMMAND_DEF("batch", "start or end a batch of commands", "start [flow] | end", cliBatch),
 #endif
 #if defined(USE_BEEPER)
 #if defined(USE_DSHOT)
@@ -6375,6 +6732,9 @@ const clicmd_t cmdTable[] = {
     CLI_COMMAND_DEF("beeper", "enable/disable beeper for a condition", "list\r\n"
         "\t<->[name]", cliBeeper),
 #endif // USE_BEEPER
+#ifdef USE_BENCHMARK
+    CLI_COMMAND_DEF("bench", "run the kernel benchmarks", NULL, cliBenchmark),
+#endif
 #if defined(USE_RX_BIND)
     CLI_COMMAND_DEF("bind_rx", "initiate binding for RX SPI or SRXL2", NULL, cliRxBind),
 #endif
@@ -6431,6 +6791,9 @@ const clicmd_t cmdTable[] = {
     CLI_COMMAND_DEF("flash_scan", "scan flash device for errors", NULL, cliFlashVerify),
     CLI_COMMAND_DEF("flash_write", NULL, "<address> <message>", cliFlashWrite),
 #endif
+#endif
+#ifdef USE_FUNCTION_PROFILER
+    CLI_COMMAND_DEF("funcprofile", "show function entry counts", "[reset]", cliFuncProfile),
 #endif
     CLI_COMMAND_DEF("get", "get variable value", "[name]", cliGet),
 #ifdef USE_GPS
@@ -6491,11 +6854,14 @@ const clicmd_t cmdTable[] = {
     CLI_COMMAND_DEF("setpoint_info", "show setpoint smoothing operational settings", NULL,cliSetpointInfo),
 #ifdef USE_RESOURCE_MGMT
     CLI_COMMAND_DEF("resource", "show/set resources", "<> | <resource name> <index> [<pin>|none] | show [all]", cliResource),
+#endif
+#ifdef USE_RPM_FILTER
+    CLI_COMMAND_DEF("rpm_tune", "propose rpm filter banks from the hover analysis", "[<target %>] [apply] | reset", cliRpmTune),
 #endif
     CLI_COMMAND_DEF("rxfail", "show/set rx failsafe settings", NULL, cliRxFailsafe),
     CLI_COMMAND_DEF("save", "save and reboot", NULL, cliSave),
 #ifdef USE_SDCARD
-    CLI_COMMAND_DEF("sd_info", "sdcard info", NULL, cliSdInfo),
+    CLI_COMMAND_DEF("sd_info", "sdcard info", "[reset]", cliSdInfo),
 #endif
     CLI_COMMAND_DEF("serial", "configure serial ports", NULL, cliSerial),
 #if defined(USE_SERIAL_PASSTHROUGH)
@@ -6611,11 +6977,30 @@ static void processCharacter(const char c)
                     break;
                 }
             }
+
+#ifdef USE_CLI_BATCH
+            // Hold off the sender while the line is executed, so that a pasted
+            // script does not overrun the receive buffer. The command may end
+            // the batch, so XON is decided up front.
+            const bool flowControl = commandBatchFlowControl && cliPort;
+            if (commandBatchActive) {
+                commandBatchLines++;
+            }
+            if (flowControl) {
+                serialWrite(cliPort, CLI_XOFF);
+            }
+#endif
             if (cmd < cmdTable + ARRAYLEN(cmdTable)) {
                 cmd->cliCommand(cmd->name, options);
             } else {
                 cliPrintError("input", "UNKNOWN COMMAND, TRY 'HELP'");
             }
+#ifdef USE_CLI_BATCH
+            if (flowControl) {
+                cliWriterFlush();
+                serialWrite(cliPort, CLI_XON);
+            }
+#endif
             bufferIndex = 0;
         }
 
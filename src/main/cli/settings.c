@@ -42,6 +42,8 @@
 #include "drivers/mco.h"
 #include "drivers/pinio.h"
 #include "drivers/sdio.h"
+#include "drivers/serial.h"
+#include "drivers/serial_uart.h"
 #include "drivers/vtx_common.h"
 #include "drivers/vtx_table.h"
 
@@ -102,8 +104,10 @@
 #include "pg/usb.h"
 #include "pg/scheduler.h"
 #include "pg/sdio.h"
+#include "pg/serial_uart.h"
 #include "pg/rcdevice.h"
 #include "pg/stats.h"
+#include "pg/sysid.h"
 #include "pg/board.h"
 #include "pg/freq.h"
 
@@ -213,6 +217,10 @@ static const char * const lookupTableBlackboxDevice[] = {
 static const char * const lookupTableBlackboxMode[] = {
     "OFF", "NORMAL", "ARMED", "SWITCH"
 };
+
+static const char * const lookupTableBlackboxCompression[] = {
+    "NONE", "HUFFMAN"
+};
 #endif
 
 #ifdef USE_SERIAL_RX
@@ -504,6 +512,16 @@ const char * const lookupTableDtermMode[] = {
     "GYRO", "ERROR",
 };
 
+const char * const lookupTableRcSmoothingMode[] = {
+    "LOWPASS", "PREDICT",
+};
+
+#ifdef USE_SYSID
+const char * const lookupTableSysidSignal[] = {
+    "CHIRP", "PRBS",
+};
+#endif
+
 #define LOOKUP_TABLE_ENTRY(name) { name, ARRAYLEN(name) }
 
 const lookupTableEntry_t lookupTables[] = {
@@ -522,6 +540,7 @@ const lookupTableEntry_t lookupTables[] = {
 #ifdef USE_BLACKBOX
     LOOKUP_TABLE_ENTRY(lookupTableBlackboxDevice),
     LOOKUP_TABLE_ENTRY(lookupTableBlackboxMode),
+    LOOKUP_TABLE_ENTRY(lookupTableBlackboxCompression),
 #endif
     LOOKUP_TABLE_ENTRY(batteryCurrentSourceNames),
     LOOKUP_TABLE_ENTRY(batteryVoltageSourceNames),
@@ -618,6 +637,10 @@ const lookupTableEntry_t lookupTables[] = {
     LOOKUP_TABLE_ENTRY(lookupTableCrsfGpsReuse),
     LOOKUP_TABLE_ENTRY(lookupTableCrsfGpsSatsReuse),
     LOOKUP_TABLE_ENTRY(lookupTableDtermMode),
+    LOOKUP_TABLE_ENTRY(lookupTableRcSmoothingMode),
+#ifdef USE_SYSID
+    LOOKUP_TABLE_ENTRY(lookupTableSysidSignal),
+#endif
 };
 
 #undef LOOKUP_TABLE_ENTRY
@@ -634,6 +657,16 @@ const clivalue_t valueTable[] = {
 #endif
 #if defined(USE_GYRO_SPI_ICM20649)
     { "gyro_high_range",                VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_high_fsr) },
+#endif
+#ifdef USE_GYRO_FIFO_BURST
+    { "gyro_fifo_burst",                VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 0, GYRO_FIFO_BURST_MAX }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_fifo_burst) },
+    { "gyro_fixed_point",               VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_fixed_point) },
+    { "gyro_rate_correction",           VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_rate_correction) },
+#ifdef USE_MULTI_GYRO
+    { "gyro_fusion",                    VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_fusion) },
+    { "gyro_bias_tracking",             VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_bias_tracking) },
+    { "gyro_bias_temp_comp",            VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_bias_temp_comp) },
+#endif
 #endif
     { "gyro_rate_sync",                 VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_rate_sync) },
     { "gyro_calib_duration",            VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 50,  3000 }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyroCalibrationDuration) },
@@ -662,6 +695,7 @@ const clivalue_t valueTable[] = {
     { PARAM_NAME_DYN_NOTCH_Q,           VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 10, 100 }, PG_DYN_NOTCH_CONFIG, offsetof(dynNotchConfig_t, dyn_notch_q) },
     { PARAM_NAME_DYN_NOTCH_MIN_HZ,      VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 10, 200 }, PG_DYN_NOTCH_CONFIG, offsetof(dynNotchConfig_t, dyn_notch_min_hz) },
     { PARAM_NAME_DYN_NOTCH_MAX_HZ,      VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 100, 500 }, PG_DYN_NOTCH_CONFIG, offsetof(dynNotchConfig_t, dyn_notch_max_hz) },
+    { PARAM_NAME_DYN_NOTCH_PARALLEL,    VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_DYN_NOTCH_CONFIG, offsetof(dynNotchConfig_t, dyn_notch_parallel) },
 #endif
 
 // PG_ACCELEROMETER_CONFIG
@@ -759,6 +793,10 @@ const clivalue_t valueTable[] = {
     { "blackbox_mode",              VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_BLACKBOX_MODE }, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, mode) },
     { "blackbox_device",            VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_BLACKBOX_DEVICE }, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, device) },
     { "blackbox_rate_denom",        VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 1, 8000 }, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, denom) },
+    { "blackbox_mixer_denom",       VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 1, 64 }, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, mixer_denom) },
+    { "blackbox_sensor_denom",      VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 1, 64 }, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, sensor_denom) },
+    { "blackbox_serial_framing",    VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, serial_framing) },
+    { "blackbox_compression",       VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_BLACKBOX_COMPRESSION }, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, compression) },
     { "blackbox_log_command",       VAR_UINT32 | MASTER_VALUE | MODE_BITSET, .config.bitpos = FLIGHT_LOG_FIELD_SELECT_COMMAND, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, fields) },
     { "blackbox_log_setpoint",      VAR_UINT32 | MASTER_VALUE | MODE_BITSET, .config.bitpos = FLIGHT_LOG_FIELD_SELECT_SETPOINT, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, fields) },
     { "blackbox_log_mixer",         VAR_UINT32 | MASTER_VALUE | MODE_BITSET, .config.bitpos = FLIGHT_LOG_FIELD_SELECT_MIXER, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, fields) },
@@ -785,6 +823,15 @@ const clivalue_t valueTable[] = {
     { "blackbox_log_rpm",           VAR_UINT32 | MASTER_VALUE | MODE_BITSET, .config.bitpos = FLIGHT_LOG_FIELD_SELECT_RPM, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, fields) },
     { "blackbox_log_motors",        VAR_UINT32 | MASTER_VALUE | MODE_BITSET, .config.bitpos = FLIGHT_LOG_FIELD_SELECT_MOTOR, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, fields) },
     { "blackbox_log_servos",        VAR_UINT32 | MASTER_VALUE | MODE_BITSET, .config.bitpos = FLIGHT_LOG_FIELD_SELECT_SERVO, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, fields) },
+    { "blackbox_trigger_gyro_overflow", VAR_UINT8 | MASTER_VALUE | MODE_BITSET, .config.bitpos = BLACKBOX_TRIGGER_GYRO_OVERFLOW, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, trigger) },
+    { "blackbox_trigger_governor",  VAR_UINT8  | MASTER_VALUE | MODE_BITSET, .config.bitpos = BLACKBOX_TRIGGER_GOVERNOR, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, trigger) },
+    { "blackbox_trigger_failsafe",  VAR_UINT8  | MASTER_VALUE | MODE_BITSET, .config.bitpos = BLACKBOX_TRIGGER_FAILSAFE, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, trigger) },
+    { "blackbox_trigger_rescue",    VAR_UINT8  | MASTER_VALUE | MODE_BITSET, .config.bitpos = BLACKBOX_TRIGGER_RESCUE, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, trigger) },
+    { "blackbox_trigger_switch",    VAR_UINT8  | MASTER_VALUE | MODE_BITSET, .config.bitpos = BLACKBOX_TRIGGER_SWITCH, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, trigger) },
+#ifdef USE_SYSID
+    { "blackbox_trigger_sysid",     VAR_UINT8  | MASTER_VALUE | MODE_BITSET, .config.bitpos = BLACKBOX_TRIGGER_SYSID, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, trigger) },
+#endif
+    { "blackbox_trigger_time",      VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 0, 10000 }, PG_BLACKBOX_CONFIG, offsetof(blackboxConfig_t, trigger_time) },
 #endif
 
 // PG_MOTOR_CONFIG
@@ -810,6 +857,8 @@ const clivalue_t valueTable[] = {
     { "motor_poles",                VAR_UINT8  | MASTER_VALUE | MODE_ARRAY, .config.array.length = MAX_SUPPORTED_MOTORS, PG_MOTOR_CONFIG, offsetof(motorConfig_t, motorPoleCount) },
     { "motor_rpm_lpf",              VAR_UINT8  | MASTER_VALUE | MODE_ARRAY, .config.array.length = MAX_SUPPORTED_MOTORS, PG_MOTOR_CONFIG, offsetof(motorConfig_t, motorRpmLpf) },
     { "motor_rpm_factor",           VAR_INT16  | MASTER_VALUE | MODE_ARRAY, .config.array.length = MAX_SUPPORTED_MOTORS, PG_MOTOR_CONFIG, offsetof(motorConfig_t, motorRpmFactor) },
+    { "motor_rpm_tracker",          VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 0, 100 }, PG_MOTOR_CONFIG, offsetof(motorConfig_t, motorRpmTracker) },
+    { "motor_rpm_glitch_limit",     VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 0, 100 }, PG_MOTOR_CONFIG, offsetof(motorConfig_t, motorRpmGlitchLimit) },
 
     { "main_rotor_gear_ratio",      VAR_UINT16 | MASTER_VALUE | MODE_ARRAY, .config.array.length = 2, PG_MOTOR_CONFIG, offsetof(motorConfig_t, mainRotorGearRatio) },
     { "tail_rotor_gear_ratio",      VAR_UINT16 | MASTER_VALUE | MODE_ARRAY, .config.array.length = 2, PG_MOTOR_CONFIG, offsetof(motorConfig_t, tailRotorGearRatio) },
@@ -921,6 +970,18 @@ const clivalue_t valueTable[] = {
     { "gov_rpm_filter",             VAR_UINT8  |  MASTER_VALUE,  .config.minmaxUnsigned = { 0, 250 }, PG_GOVERNOR_CONFIG, offsetof(governorConfig_t, gov_rpm_filter) },
     { "gov_tta_filter",             VAR_UINT8  |  MASTER_VALUE,  .config.minmaxUnsigned = { 0, 250 }, PG_GOVERNOR_CONFIG, offsetof(governorConfig_t, gov_tta_filter) },
     { "gov_ff_filter",              VAR_UINT8  |  MASTER_VALUE,  .config.minmaxUnsigned = { 0, 250 }, PG_GOVERNOR_CONFIG, offsetof(governorConfig_t, gov_ff_filter) },
+    { "gov_latency_comp",           VAR_UINT8  |  MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_GOVERNOR_CONFIG, offsetof(governorConfig_t, gov_latency_comp) },
+    { "gov_sag_comp",               VAR_UINT8  |  MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_GOVERNOR_CONFIG, offsetof(governorConfig_t, gov_sag_comp) },
+
+// PG_SYSID_CONFIG
+#ifdef USE_SYSID
+    { "sysid_signal",               VAR_UINT8  |  MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_SYSID_SIGNAL }, PG_SYSID_CONFIG, offsetof(sysidConfig_t, signal) },
+    { "sysid_axes",                 VAR_UINT8  |  MASTER_VALUE,  .config.minmaxUnsigned = { 0, 7 }, PG_SYSID_CONFIG, offsetof(sysidConfig_t, axes) },
+    { "sysid_amplitude",            VAR_UINT16 |  MASTER_VALUE,  .config.minmaxUnsigned = { 0, 500 }, PG_SYSID_CONFIG, offsetof(sysidConfig_t, amplitude) },
+    { "sysid_duration",             VAR_UINT16 |  MASTER_VALUE,  .config.minmaxUnsigned = { 10, 1200 }, PG_SYSID_CONFIG, offsetof(sysidConfig_t, duration) },
+    { "sysid_min_freq",             VAR_UINT16 |  MASTER_VALUE,  .config.minmaxUnsigned = { 1, 5000 }, PG_SYSID_CONFIG, offsetof(sysidConfig_t, min_freq) },
+    { "sysid_max_freq",             VAR_UINT16 |  MASTER_VALUE,  .config.minmaxUnsigned = { 1, 5000 }, PG_SYSID_CONFIG, offsetof(sysidConfig_t, max_freq) },
+#endif
 
 // PG_CONTROLRATE_PROFILES
 #ifdef USE_PROFILE_NAMES
@@ -961,9 +1022,36 @@ const clivalue_t valueTable[] = {
     { "reboot_character",           VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 48, 126 }, PG_SERIAL_CONFIG, offsetof(serialConfig_t, reboot_character) },
     { "serial_update_rate_hz",      VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 100, 2000 }, PG_SERIAL_CONFIG, offsetof(serialConfig_t, serial_update_rate_hz) },
 
+// PG_SERIAL_UART_CONFIG
+#ifdef USE_UART1
+    { "uart1_rx_buffer_size",        VAR_UINT16 | HARDWARE_VALUE, .config.minmaxUnsigned = { 0, 4096 }, PG_SERIAL_UART_CONFIG, PG_ARRAY_ELEMENT_OFFSET(serialUartConfig_t, UARTDEV_1, rxBufferSize) },
+#endif
+#ifdef USE_UART2
+    { "uart2_rx_buffer_size",        VAR_UINT16 | HARDWARE_VALUE, .config.minmaxUnsigned = { 0, 4096 }, PG_SERIAL_UART_CONFIG, PG_ARRAY_ELEMENT_OFFSET(serialUartConfig_t, UARTDEV_2, rxBufferSize) },
+#endif
+#ifdef USE_UART3
+    { "uart3_rx_buffer_size",        VAR_UINT16 | HARDWARE_VALUE, .config.minmaxUnsigned = { 0, 4096 }, PG_SERIAL_UART_CONFIG, PG_ARRAY_ELEMENT_OFFSET(serialUartConfig_t, UARTDEV_3, rxBufferSize) },
+#endif
+#ifdef USE_UART4
+    { "uart4_rx_buffer_size",        VAR_UINT16 | HARDWARE_VALUE, .config.minmaxUnsigned = { 0, 4096 }, PG_SERIAL_UART_CONFIG, PG_ARRAY_ELEMENT_OFFSET(serialUartConfig_t, UARTDEV_4, rxBufferSize) },
+#endif
+#ifdef USE_UART5
+    { "uart5_rx_buffer_size",        VAR_UINT16 | HARDWARE_VALUE, .config.minmaxUnsigned = { 0, 4096 }, PG_SERIAL_UART_CONFIG, PG_ARRAY_ELEMENT_OFFSET(serialUartConfig_t, UARTDEV_5, rxBufferSize) },
+#endif
+#ifdef USE_UART6
+    { "uart6_rx_buffer_size",        VAR_UINT16 | HARDWARE_VALUE, .config.minmaxUnsigned = { 0, 4096 }, PG_SERIAL_UART_CONFIG, PG_ARRAY_ELEMENT_OFFSET(serialUartConfig_t, UARTDEV_6, rxBufferSize) },
+#endif
+#ifdef USE_UART7
+    { "uart7_rx_buffer_size",        VAR_UINT16 | HARDWARE_VALUE, .config.minmaxUnsigned = { 0, 4096 }, PG_SERIAL_UART_CONFIG, PG_ARRAY_ELEMENT_OFFSET(serialUartConfig_t, UARTDEV_7, rxBufferSize) },
+#endif
+#ifdef USE_UART8
+    { "uart8_rx_buffer_size",        VAR_UINT16 | HARDWARE_VALUE, .config.minmaxUnsigned = { 0, 4096 }, PG_SERIAL_UART_CONFIG, PG_ARRAY_ELEMENT_OFFSET(serialUartConfig_t, UARTDEV_8, rxBufferSize) },
+#endif
+
 // PG_IMU_CONFIG
     { "imu_dcm_kp",                 VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 0, 32000 }, PG_IMU_CONFIG, offsetof(imuConfig_t, dcm_kp) },
     { "imu_dcm_ki",                 VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 0, 32000 }, PG_IMU_CONFIG, offsetof(imuConfig_t, dcm_ki) },
+    { "imu_fast_update",            VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_IMU_CONFIG, offsetof(imuConfig_t, fast_update) },
 
 // PG_ARMING_CONFIG
     { "auto_disarm_delay",          VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 0, 60 }, PG_ARMING_CONFIG, offsetof(armingConfig_t, auto_disarm_delay) },
@@ -980,6 +1068,7 @@ const clivalue_t valueTable[] = {
     { "gps_ublox_use_galileo",      VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_GPS_CONFIG, offsetof(gpsConfig_t, gps_ublox_use_galileo) },
     { "gps_ublox_mode",             VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_GPS_UBLOX_MODE }, PG_GPS_CONFIG, offsetof(gpsConfig_t, gps_ublox_mode) },
     { "gps_set_home_point_once",    VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_GPS_CONFIG, offsetof(gpsConfig_t, gps_set_home_point_once) },
+    { "gps_update_rate_hz",         VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 1, GPS_UPDATE_RATE_MAX }, PG_GPS_CONFIG, offsetof(gpsConfig_t, gps_update_rate_hz) },
     { "gps_use_3d_speed",           VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_GPS_CONFIG, offsetof(gpsConfig_t, gps_use_3d_speed) },
 
 #ifdef USE_GPS_RESCUE
@@ -1022,6 +1111,7 @@ const clivalue_t valueTable[] = {
     { "rc_min_throttle",            VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { PWM_PULSE_MIN, PWM_PULSE_MAX }, PG_RC_CONTROLS_CONFIG, offsetof(rcControlsConfig_t, rc_min_throttle) },
     { "rc_max_throttle",            VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { PWM_PULSE_MIN, PWM_PULSE_MAX }, PG_RC_CONTROLS_CONFIG, offsetof(rcControlsConfig_t, rc_max_throttle) },
     { "rc_smoothness",              VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 0, 250 }, PG_RC_CONTROLS_CONFIG, offsetof(rcControlsConfig_t, rc_smoothness) },
+    { "rc_smoothing_mode",          VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_RC_SMOOTHING_MODE }, PG_RC_CONTROLS_CONFIG, offsetof(rcControlsConfig_t, rc_smoothing_mode) },
     { "rc_threshold",               VAR_UINT8  | MASTER_VALUE | MODE_ARRAY, .config.array.length = 4, PG_RC_CONTROLS_CONFIG, offsetof(rcControlsConfig_t, rc_threshold) },
 
     { "deadband",                   VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 0, 32 }, PG_RC_CONTROLS_CONFIG, offsetof(rcControlsConfig_t, rc_deadband) },
@@ -1030,6 +1120,7 @@ const clivalue_t valueTable[] = {
 // PG_PID_CONFIG
     { PARAM_NAME_PID_PROCESS_DENOM,    VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 1, MAX_PID_PROCESS_DENOM }, PG_PID_CONFIG, offsetof(pidConfig_t, pid_process_denom) },
     { PARAM_NAME_FILTER_PROCESS_DENOM, VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 0, MAX_PID_PROCESS_DENOM }, PG_PID_CONFIG, offsetof(pidConfig_t, filter_process_denom) },
+    { PARAM_NAME_PID_PROCESS_HEADROOM, VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 0, 50 }, PG_PID_CONFIG, offsetof(pidConfig_t, pid_process_headroom) },
 
 // PG_PID_PROFILE
 #ifdef USE_PROFILE_NAMES
@@ -1110,6 +1201,8 @@ const clivalue_t valueTable[] = {
     { "offset_bleed_rate_curve",    VAR_UINT8 | PROFILE_VALUE | MODE_ARRAY, .config.array.length = LOOKUP_CURVE_POINTS, PG_PID_PROFILE, offsetof(pidProfile_t, offset_bleed_rate_curve) },
     { "offset_bleed_limit_curve",   VAR_UINT8 | PROFILE_VALUE | MODE_ARRAY, .config.array.length = LOOKUP_CURVE_POINTS, PG_PID_PROFILE, offsetof(pidProfile_t, offset_bleed_limit_curve) },
     { "offset_charge_curve",        VAR_UINT8 | PROFILE_VALUE | MODE_ARRAY, .config.array.length = LOOKUP_CURVE_POINTS, PG_PID_PROFILE, offsetof(pidProfile_t, offset_charge_curve) },
+    { "pid_headspeed_curve",        VAR_UINT8 | PROFILE_VALUE | MODE_ARRAY, .config.array.length = LOOKUP_CURVE_POINTS, PG_PID_PROFILE, offsetof(pidProfile_t, pid_headspeed_curve) },
+    { "precomp_headspeed_curve",    VAR_UINT8 | PROFILE_VALUE | MODE_ARRAY, .config.array.length = LOOKUP_CURVE_POINTS, PG_PID_PROFILE, offsetof(pidProfile_t, precomp_headspeed_curve) },
 
     { "iterm_relax_type",           VAR_UINT8  | PROFILE_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_ITERM_RELAX_TYPE }, PG_PID_PROFILE, offsetof(pidProfile_t, iterm_relax_type) },
     { "iterm_relax_level",          VAR_UINT8  | PROFILE_VALUE | MODE_ARRAY, .config.array.length = 3, PG_PID_PROFILE, offsetof(pidProfile_t, iterm_relax_level) },
@@ -1399,6 +1492,9 @@ const clivalue_t valueTable[] = {
     { "osd_camera_frame_pos",   VAR_UINT16  | MASTER_VALUE, .config.minmaxUnsigned = { 0, OSD_POSCFG_MAX }, PG_OSD_ELEMENT_CONFIG, offsetof(osdElementConfig_t, item_pos[OSD_CAMERA_FRAME]) },
     { "osd_efficiency_pos",     VAR_UINT16  | MASTER_VALUE, .config.minmaxUnsigned = { 0, OSD_POSCFG_MAX }, PG_OSD_ELEMENT_CONFIG, offsetof(osdElementConfig_t, item_pos[OSD_EFFICIENCY]) },
     { "osd_total_flights_pos",     VAR_UINT16  | MASTER_VALUE, .config.minmaxUnsigned = { 0, OSD_POSCFG_MAX }, PG_OSD_ELEMENT_CONFIG, offsetof(osdElementConfig_t, item_pos[OSD_TOTAL_FLIGHTS]) },
+#ifdef USE_VIBRATION_ANALYSIS
+    { "osd_vibration_pos",      VAR_UINT16  | MASTER_VALUE, .config.minmaxUnsigned = { 0, OSD_POSCFG_MAX }, PG_OSD_ELEMENT_CONFIG, offsetof(osdElementConfig_t, item_pos[OSD_VIBRATION]) },
+#endif
 
     // OSD stats enabled flags are stored as bitmapped values inside a 32bit parameter
     // It is recommended to keep the settings order the same as the enumeration. This way the settings are displayed in the cli in the same order making it easier on the users
@@ -1456,6 +1552,7 @@ const clivalue_t valueTable[] = {
 #endif
     { "task_statistics",            VAR_INT8   | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_SYSTEM_CONFIG, offsetof(systemConfig_t, task_statistics) },
     { PARAM_NAME_DEBUG_MODE,        VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_DEBUG }, PG_SYSTEM_CONFIG, offsetof(systemConfig_t, debug_mode) },
+    { PARAM_NAME_DEBUG_MODE_2,      VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_DEBUG }, PG_SYSTEM_CONFIG, offsetof(systemConfig_t, debug_mode_2) },
     { PARAM_NAME_DEBUG_AXIS,        VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 0, 255 }, PG_SYSTEM_CONFIG, offsetof(systemConfig_t, debug_axis) },
 #ifdef USE_OVERCLOCK
     { "cpu_overclock",              VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OVERCLOCK }, PG_SYSTEM_CONFIG, offsetof(systemConfig_t, cpu_overclock) },
@@ -1530,6 +1627,7 @@ const clivalue_t valueTable[] = {
     { "esc_sensor_hw4_current_gain",    VAR_UINT8   | MASTER_VALUE, .config.minmaxUnsigned = { 0, 250 }, PG_ESC_SENSOR_CONFIG, offsetof(escSensorConfig_t, hw4_current_gain) },
     { "esc_sensor_hw4_voltage_gain",    VAR_UINT8   | MASTER_VALUE, .config.minmaxUnsigned = { 0, 250 }, PG_ESC_SENSOR_CONFIG, offsetof(escSensorConfig_t, hw4_voltage_gain) },
     { "esc_sensor_filter_cutoff",       VAR_UINT8   | MASTER_VALUE, .config.minmaxUnsigned = { 0, 250 }, PG_ESC_SENSOR_CONFIG, offsetof(escSensorConfig_t, filter_cutoff) },
+    { "esc_sensor_bl_pipeline",         VAR_UINT8   | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_ESC_SENSOR_CONFIG, offsetof(escSensorConfig_t, bl_pipeline) },
 #endif
 
 #ifdef USE_RX_FRSKY_SPI
@@ -1650,6 +1748,9 @@ const clivalue_t valueTable[] = {
 
     { "scheduler_relax_rx",  VAR_UINT16  | MASTER_VALUE, .config.minmaxUnsigned = { 0, 500 }, PG_SCHEDULER_CONFIG, PG_ARRAY_ELEMENT_OFFSET(schedulerConfig_t, 0, rxRelaxDeterminism) },
     { "scheduler_relax_osd", VAR_UINT16  | MASTER_VALUE, .config.minmaxUnsigned = { 0, 500 }, PG_SCHEDULER_CONFIG, PG_ARRAY_ELEMENT_OFFSET(schedulerConfig_t, 0, osdRelaxDeterminism) },
+    { "scheduler_deadline",  VAR_UINT8   | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_SCHEDULER_CONFIG, offsetof(schedulerConfig_t, deadlineScheduling) },
+    { "scheduler_idle_sleep", VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_SCHEDULER_CONFIG, offsetof(schedulerConfig_t, idleSleep) },
+    { "scheduler_load_shed", VAR_UINT8   | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_SCHEDULER_CONFIG, offsetof(schedulerConfig_t, loadShedding) },
 
 // PG_TIMECONFIG
 #ifdef USE_RTC_TIME
@@ -1661,6 +1762,7 @@ const clivalue_t valueTable[] = {
     { "gyro_rpm_filter_bank_rpm_ratio",  VAR_UINT16 | MASTER_VALUE | MODE_ARRAY, .config.array.length = RPM_FILTER_BANK_COUNT, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_bank_rpm_ratio) },
     { "gyro_rpm_filter_bank_rpm_limit",  VAR_UINT16 | MASTER_VALUE | MODE_ARRAY, .config.array.length = RPM_FILTER_BANK_COUNT, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_bank_rpm_limit) },
     { "gyro_rpm_filter_bank_notch_q",    VAR_UINT8  | MASTER_VALUE | MODE_ARRAY, .config.array.length = RPM_FILTER_BANK_COUNT, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_bank_notch_q) },
+    { "gyro_rpm_filter_adaptive_q",      VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_adaptive_q) },
 #endif
 
 #ifdef USE_RX_FLYSKY
@@ -1688,6 +1790,8 @@ const clivalue_t valueTable[] = {
     { "position_gps_offset_lpf",   VAR_UINT8 | MASTER_VALUE, .config.minmaxUnsigned = { 1, 250 }, PG_POSITION, offsetof(positionConfig_t, gps_offset_lpf) },
     { "position_gps_min_sats",     VAR_UINT8 | MASTER_VALUE, .config.minmaxUnsigned = { 0, 50 }, PG_POSITION, offsetof(positionConfig_t, gps_min_sats) },
     { "position_vario_lpf",        VAR_UINT8 | MASTER_VALUE, .config.minmaxUnsigned = { 1, 250 }, PG_POSITION, offsetof(positionConfig_t, vario_lpf) },
+    { "position_alt_fusion_lpf",   VAR_UINT8 | MASTER_VALUE, .config.minmaxUnsigned = { 0, 250 }, PG_POSITION, offsetof(positionConfig_t, alt_fusion_lpf) },
+    { "position_nav_fusion_lpf",   VAR_UINT8 | MASTER_VALUE, .config.minmaxUnsigned = { 0, 250 }, PG_POSITION, offsetof(positionConfig_t, nav_fusion_lpf) },
 
 // PG_MODE_ACTIVATION_CONFIG
 #if defined(USE_CUSTOM_BOX_NAMES)
@@ -1700,4 +1804,7 @@ const clivalue_t valueTable[] = {
 
 const uint16_t valueTableEntryCount = ARRAYLEN(valueTable);
 
+// valueTable indices sorted by name, built on first lookup
+uint16_t valueTableNameIndex[ARRAYLEN(valueTable)];
+
 STATIC_ASSERT(LOOKUP_TABLE_COUNT == ARRAYLEN(lookupTables), LOOKUP_TABLE_COUNT_incorrect);
@@ -41,6 +41,7 @@ typedef enum {
 #ifdef USE_BLACKBOX
     TABLE_BLACKBOX_DEVICE,
     TABLE_BLACKBOX_MODE,
+    TABLE_BLACKBOX_COMPRESSION,
 #endif
     TABLE_CURRENT_METER,
     TABLE_VOLTAGE_METER,
@@ -132,6 +133,10 @@ typedef enum {
     TABLE_CRSF_GPS_REUSE,
     TABLE_CRSF_GPS_SATS_REUSE,
     TABLE_DTERM_MODE,
+    TABLE_RC_SMOOTHING_MODE,
+#ifdef USE_SYSID
+    TABLE_SYSID_SIGNAL,
+#endif
 
     LOOKUP_TABLE_COUNT
 } lookupTableIndex_e;
@@ -224,6 +229,7 @@ extern const lookupTableEntry_t lookupTables[];
 extern const uint16_t valueTableEntryCount;
 
 extern const clivalue_t valueTable[];
+extern uint16_t valueTableNameIndex[];
 //extern const uint8_t lookupTablesEntryCount;
 
 extern const char * const lookupTableGyroHardware[];
@@ -45,6 +45,7 @@
 #include "cms/cms_menu_saveexit.h"
 #include "cms/cms_types.h"
 
+#include "common/crc.h"
 #include "common/maths.h"
 #include "common/typeconversion.h"
 
@@ -256,6 +257,10 @@ typedef struct cmsTableTicker_s {
 
 cmsTableTicker_t runtimeTableTicker[CMS_MAX_ROWS];
 
+// Hash of the last value text written on each row. A polled value is only
+// sent to the display again when its text changes.
+static uint32_t runtimeValueHash[CMS_MAX_ROWS];
+
 static void cmsPageSelect(displayPort_t *instance, int8_t newpage)
 {
     currentCtx.page = (newpage + pageCount) % pageCount;
@@ -376,10 +381,24 @@ static int cmsDisplayWrite(displayPort_t *instance, uint8_t x, uint8_t y, uint8_
     return displayWrite(instance, x, y, attr, buffer);
 }
 
-static int cmsDrawMenuItemValue(displayPort_t *pDisplay, char *buff, uint8_t row, uint8_t maxSize)
+static bool cmsValueChanged(uint32_t *valueHash, uint8_t col, const char *buff)
+{
+    uint32_t hash = fnv_update(FNV_OFFSET_BASIS, &col, sizeof(col));
+    hash = fnv_update(hash, buff, strlen(buff));
+
+    if (hash == *valueHash) {
+        return false;
+    }
+
+    *valueHash = hash;
+
+    return true;
+}
+
+static int cmsDrawMenuItemValue(displayPort_t *pDisplay, char *buff, uint8_t row, uint8_t maxSize, uint32_t *valueHash)
 {
     int colpos;
-    int cnt;
+    int cnt = 0;
 
     cmsPadToSize(buff, maxSize);
 #ifdef CMS_OSD_RIGHT_ALIGNED_VALUES
@@ -387,11 +406,13 @@ static int cmsDrawMenuItemValue(displayPort_t *pDisplay, char *buff, uint8_t row
 #else
     colpos = smallScreen ? rightMenuColumn - maxSize : rightMenuColumn;
 #endif
-    cnt = cmsDisplayWrite(pDisplay, colpos, row, DISPLAYPORT_ATTR_NONE, buff);
+    if (cmsValueChanged(valueHash, colpos, buff)) {
+        cnt = cmsDisplayWrite(pDisplay, colpos, row, DISPLAYPORT_ATTR_NONE, buff);
+    }
     return cnt;
 }
 
-static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t row, bool selectedRow, uint8_t *flags, cmsTableTicker_t *ticker)
+static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t row, bool selectedRow, uint8_t *flags, cmsTableTicker_t *ticker, uint32_t *valueHash)
 {
     #define CMS_DRAW_BUFFER_LEN 12
     #define CMS_TABLE_VALUE_MAX_LEN 30
@@ -414,7 +435,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
     case OME_String:
         if (IS_PRINTVALUE(*flags) && p->data) {
             strncpy(buff, p->data, CMS_DRAW_BUFFER_LEN);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_DRAW_BUFFER_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_DRAW_BUFFER_LEN, valueHash);
             CLR_PRINTVALUE(*flags);
         }
         break;
@@ -436,7 +457,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
             strncat(buff, ">", CMS_DRAW_BUFFER_LEN);
 
             row = smallScreen ? row - 1 : row;
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, strlen(buff));
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, strlen(buff), valueHash);
             CLR_PRINTVALUE(*flags);
         }
         break;
@@ -449,7 +470,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
               strcpy(buff, "NO ");
             }
 
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, 3);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, 3, valueHash);
             CLR_PRINTVALUE(*flags);
         }
         break;
@@ -490,7 +511,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
             }
             if (drawText) {
                 strncpy(tableBuff, (char *)(str + ticker->state), CMS_TABLE_VALUE_MAX_LEN);
-                cnt = cmsDrawMenuItemValue(pDisplay, tableBuff, row, availableSpace);
+                cnt = cmsDrawMenuItemValue(pDisplay, tableBuff, row, availableSpace, valueHash);
             }
             CLR_PRINTVALUE(*flags);
         }
@@ -516,7 +537,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
                     }
                 }
             }
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, 3);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, 3, valueHash);
             CLR_PRINTVALUE(*flags);
         }
         break;
@@ -526,7 +547,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
         if (IS_PRINTVALUE(*flags) && p->data) {
             OSD_UINT8_t *ptr = p->data;
             itoa(*ptr->val, buff, 10);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN, valueHash);
             CLR_PRINTVALUE(*flags);
         }
         break;
@@ -535,7 +556,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
         if (IS_PRINTVALUE(*flags) && p->data) {
             OSD_INT8_t *ptr = p->data;
             itoa(*ptr->val, buff, 10);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN, valueHash);
             CLR_PRINTVALUE(*flags);
         }
         break;
@@ -544,7 +565,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
         if (IS_PRINTVALUE(*flags) && p->data) {
             OSD_UINT16_t *ptr = p->data;
             itoa(*ptr->val, buff, 10);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN, valueHash);
             CLR_PRINTVALUE(*flags);
         }
         break;
@@ -553,7 +574,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
         if (IS_PRINTVALUE(*flags) && p->data) {
             OSD_INT16_t *ptr = p->data;
             itoa(*ptr->val, buff, 10);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN, valueHash);
             CLR_PRINTVALUE(*flags);
         }
         break;
@@ -562,7 +583,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
         if (IS_PRINTVALUE(*flags) && p->data) {
             OSD_UINT32_t *ptr = p->data;
             itoa(*ptr->val, buff, 10);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN, valueHash);
             CLR_PRINTVALUE(*flags);
         }
         break;
@@ -571,7 +592,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
         if (IS_PRINTVALUE(*flags) && p->data) {
             OSD_INT32_t *ptr = p->data;
             itoa(*ptr->val, buff, 10);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN, valueHash);
             CLR_PRINTVALUE(*flags);
         }
         break;
@@ -580,7 +601,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
         if (IS_PRINTVALUE(*flags) && p->data) {
             OSD_FLOAT_t *ptr = p->data;
             cmsFormatFloat(*ptr->val * ptr->multipler, buff);
-            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN);
+            cnt = cmsDrawMenuItemValue(pDisplay, buff, row, CMS_NUM_FIELD_LEN, valueHash);
             CLR_PRINTVALUE(*flags);
         }
         break;
@@ -599,7 +620,9 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
             else {
               start_column += (uint8_t)strlen(p->text) +1;
             }
-            cnt = cmsDisplayWrite(pDisplay, start_column, row, DISPLAYPORT_ATTR_NONE, p->data);
+            if (cmsValueChanged(valueHash, start_column, p->data)) {
+                cnt = cmsDisplayWrite(pDisplay, start_column, row, DISPLAYPORT_ATTR_NONE, p->data);
+            }
             CLR_PRINTVALUE(*flags);
         }
         break;
@@ -721,6 +744,7 @@ static void cmsDrawMenu(displayPort_t *pDisplay, uint32_t currentTimeUs)
             SET_PRINTLABEL(runtimeEntryFlags[i]);
             SET_PRINTVALUE(runtimeEntryFlags[i]);
         }
+        memset(runtimeValueHash, 0, sizeof(runtimeValueHash));
     } else if (drawPolled) {
         for (p = pageTop, i = 0; (p <= pageTop + pageMaxRow); p++, i++) {
             if (IS_DYNAMIC(p))
@@ -789,7 +813,7 @@ static void cmsDrawMenu(displayPort_t *pDisplay, uint32_t currentTimeUs)
 
         if (IS_PRINTVALUE(runtimeEntryFlags[i]) || IS_SCROLLINGTICKER(runtimeEntryFlags[i])) {
             bool selectedRow = i == currentCtx.cursorRow;
-            room -= cmsDrawMenuEntry(pDisplay, p, top + i * linesPerMenuItem, selectedRow, &runtimeEntryFlags[i], &runtimeTableTicker[i]);
+            room -= cmsDrawMenuEntry(pDisplay, p, top + i * linesPerMenuItem, selectedRow, &runtimeEntryFlags[i], &runtimeTableTicker[i], &runtimeValueHash[i]);
             if (room < 30) {
                 return;
             }
@@ -0,0 +1,51 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Little endian packed bitfields, as used by the SBUS and CRSF channel
+ * data: field n starts at bit n * bits, LSB first.
+ *
+ * A field of up to 17 bits is extracted from the three bytes starting
+ * at its first byte. A wider load would run past the end of the frame
+ * on the last field.
+ */
+
+static inline uint32_t bitUnpack(const uint8_t *data, unsigned bitIndex, unsigned bits)
+{
+    const uint8_t *p = data + (bitIndex >> 3);
+    const uint32_t window = p[0] | (p[1] << 8) | (p[2] << 16);
+
+    return (window >> (bitIndex & 7)) & ((1U << bits) - 1);
+}
+
+static inline void bitUnpack16(uint16_t *dst, const uint8_t *data, unsigned count, unsigned bits)
+{
+    for (unsigned n = 0, bitIndex = 0; n < count; n++, bitIndex += bits) {
+        dst[n] = bitUnpack(data, bitIndex, bits);
+    }
+}
+
+static inline void bitUnpack32(uint32_t *dst, const uint8_t *data, unsigned count, unsigned bits)
+{
+    for (unsigned n = 0, bitIndex = 0; n < count; n++, bitIndex += bits) {
+        dst[n] = bitUnpack(data, bitIndex, bits);
+    }
+}
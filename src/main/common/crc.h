@@ -20,17 +20,38 @@
 
 #pragma once
 
+#include <stdint.h>
+
 struct sbuf_s;
 
+extern const uint8_t crc8_dvb_s2_table[256];
+extern const uint16_t crc16_ccitt_table[256];
+
+static inline uint8_t crc8_table_calc(uint8_t crc, uint8_t data, const uint8_t *table)
+{
+    return table[crc ^ data];
+}
+
+static inline uint16_t crc16_table_calc(uint16_t crc, uint8_t data, const uint16_t *table)
+{
+    return (crc << 8) ^ table[(crc >> 8) ^ data];
+}
+
+uint8_t crc8_table_update(uint8_t crc, const void *data, uint32_t length, const uint8_t *table);
+void crc8_table_sbuf_append(struct sbuf_s *dst, const void *data, const uint8_t *table);
+
+uint16_t crc16_table_update(uint16_t crc, const void *data, uint32_t length, const uint16_t *table);
+void crc16_table_sbuf_append(struct sbuf_s *dst, const void *data, const uint16_t *table);
+
 uint8_t crc8_calc(uint8_t crc, uint8_t data, uint8_t poly);
 uint8_t crc8_update(uint8_t crc, const void *data, uint32_t length, uint8_t poly);
 void crc8_sbuf_append(struct sbuf_s *dst, const void *data, uint8_t poly);
 
 #define crc8_kiss_update(crc, data, len)            crc8_update((crc), (data), (len), 0x07)
 
-#define crc8_dvb_s2(crc, data)                      crc8_calc((crc), (data), 0xD5)
-#define crc8_dvb_s2_update(crc, data, len)          crc8_update((crc), (data), (len), 0xD5)
-#define crc8_dvb_s2_sbuf_append(dst, data)          crc8_sbuf_append((dst), (data), 0xD5)
+#define crc8_dvb_s2(crc, data)                      crc8_table_calc((crc), (data), crc8_dvb_s2_table)
+#define crc8_dvb_s2_update(crc, data, len)          crc8_table_update((crc), (data), (len), crc8_dvb_s2_table)
+#define crc8_dvb_s2_sbuf_append(dst, data)          crc8_table_sbuf_append((dst), (data), crc8_dvb_s2_table)
 
 #define crc8_poly_0xba(crc, data)                   crc8_calc((crc), (data), 0xBA)
 #define crc8_poly_0xba_sbuf_append(dst, data)       crc8_sbuf_append((dst), (data), 0xBA)
@@ -39,9 +60,9 @@ uint16_t crc16_calc(uint16_t crc, uint8_t data, uint16_t poly);
 uint16_t crc16_update(uint16_t crc, const void *data, uint32_t length, uint16_t poly);
 void crc16_sbuf_append(struct sbuf_s *dst, const void *data, uint16_t poly);
 
-#define crc16_ccitt(crc, data)                      crc16_calc((crc), (data), 0x1021)
-#define crc16_ccitt_update(crc, data, len)          crc16_update((crc), (data), (len), 0x1021)
-#define crc16_ccitt_sbuf_append(dst, data)          crc16_sbuf_append((dst), (data), 0x1021)
+#define crc16_ccitt(crc, data)                      crc16_table_calc((crc), (data), crc16_ccitt_table)
+#define crc16_ccitt_update(crc, data, len)          crc16_table_update((crc), (data), (len), crc16_ccitt_table)
+#define crc16_ccitt_sbuf_append(dst, data)          crc16_table_sbuf_append((dst), (data), crc16_ccitt_table)
 
 uint8_t crc8_xor_update(uint8_t crc, const void *data, uint32_t length);
 void crc8_xor_sbuf_append(struct sbuf_s *dst, const void *data);
@@ -23,4 +23,15 @@
 #include <stdint.h>
 
 uint32_t castFloatBytesToInt(float f);
-uint32_t zigzagEncode(int32_t value);
+
+/**
+ * ZigZag encoding maps all values of a signed integer into those of an unsigned integer in such
+ * a way that numbers of small absolute value correspond to small integers in the result.
+ *
+ * (Compared to just casting a signed to an unsigned which creates huge resulting numbers for
+ * small negative integers).
+ */
+static inline uint32_t zigzagEncode(int32_t value)
+{
+    return (uint32_t)((value << 1) ^ (value >> 31));
+}
@@ -530,8 +530,10 @@ FAST_CODE void biquadFilterUpdate(biquadFilter_t *filter, float cutoff, float sa
     cutoff = limitCutoff(cutoff, sampleRate);
 
     const float omega = M_2PIf * cutoff / sampleRate;
-    const float sinom = sin_approx(omega);
-    const float cosom = cos_approx(omega);
+
+    float sinom, cosom;
+    sincos_approx(omega, &sinom, &cosom);
+
     const float alpha = sinom / (2 * Q);
 
     switch (filterType) {
@@ -622,6 +624,91 @@ FAST_CODE float filterStackApply(biquadFilter_t *filter, float input, int count)
 }
 
 
+// Fixed-point BiQuad filter, Direct Form 1
+//
+// The products are 32x32->64 and map to SMLAL on Cortex-M4/M7.
+// 16-bit SMLAD coefficients cannot place the poles of a low-cutoff
+// decimator accurately enough.
+
+#define FIXED_SAMPLE_SCALE  ((float)(1 << BIQUAD_FIXED_SAMPLE_BITS))
+#define FIXED_COEFF_SCALE   ((float)(1 << BIQUAD_FIXED_COEFF_BITS))
+
+static inline int32_t fixedSat32(int64_t value)
+{
+    return (value > INT32_MAX) ? INT32_MAX : (value < INT32_MIN) ? INT32_MIN : (int32_t)value;
+}
+
+static inline int32_t fixedFromFloat(float value)
+{
+    return lrintf(constrainf(value, -32767.0f, 32767.0f) * FIXED_SAMPLE_SCALE);
+}
+
+static inline float fixedToFloat(int32_t value)
+{
+    return value * (1.0f / FIXED_SAMPLE_SCALE);
+}
+
+void biquadFixedFilterInit(biquadFixedFilter_t *filter, float cutoff, float sampleRate, float Q, uint8_t filterType)
+{
+    filter->y = 0;
+    filter->x1 = filter->x2 = 0;
+    filter->y1 = filter->y2 = 0;
+
+    biquadFixedFilterUpdate(filter, cutoff, sampleRate, Q, filterType);
+}
+
+void biquadFixedFilterUpdate(biquadFixedFilter_t *filter, float cutoff, float sampleRate, float Q, uint8_t filterType)
+{
+    biquadFilter_t sos;
+
+    biquadFilterUpdate(&sos, cutoff, sampleRate, Q, filterType);
+
+    filter->b0 = lrintf(sos.b0 * FIXED_COEFF_SCALE);
+    filter->b1 = lrintf(sos.b1 * FIXED_COEFF_SCALE);
+    filter->b2 = lrintf(sos.b2 * FIXED_COEFF_SCALE);
+    filter->a1 = lrintf(sos.a1 * FIXED_COEFF_SCALE);
+    filter->a2 = lrintf(sos.a2 * FIXED_COEFF_SCALE);
+}
+
+static inline int32_t biquadFixedFilterStep(biquadFixedFilter_t *filter, int32_t input)
+{
+    int64_t acc = 1LL << (BIQUAD_FIXED_COEFF_BITS - 1);
+
+    acc += (int64_t)filter->b0 * input;
+    acc += (int64_t)filter->b1 * filter->x1;
+    acc += (int64_t)filter->b2 * filter->x2;
+    acc -= (int64_t)filter->a1 * filter->y1;
+    acc -= (int64_t)filter->a2 * filter->y2;
+
+    const int32_t output = fixedSat32(acc >> BIQUAD_FIXED_COEFF_BITS);
+
+    filter->x2 = filter->x1;
+    filter->x1 = input;
+    filter->y2 = filter->y1;
+    filter->y1 = output;
+
+    return output;
+}
+
+FAST_CODE float biquadFixedFilterApply(biquadFixedFilter_t *filter, float input)
+{
+    filter->y = fixedToFloat(biquadFixedFilterStep(filter, fixedFromFloat(input)));
+
+    return filter->y;
+}
+
+FAST_CODE float filterFixedStackApply(biquadFixedFilter_t *filter, float input, int count)
+{
+    int32_t value = fixedFromFloat(input);
+
+    for (int i = 0; i < count; i++, filter++) {
+        value = biquadFixedFilterStep(filter, value);
+    }
+
+    return fixedToFloat(value);
+}
+
+
 // First order filter
 
 void firstOrderFilterInit(order1Filter_t *filter, float cutoff, float sampleRate)
@@ -800,6 +887,23 @@ void lowpassFilterInit(filter_t *filter, uint8_t type, float cutoff, float sampl
     filterInit(filter, cutoff, sampleRate);
 }
 
+void lowpassFilterChange(filter_t *filter, uint8_t type, float cutoff, float sampleRate, uint32_t flags)
+{
+    filter_t next;
+
+    lowpassFilterInit(&next, type, cutoff, sampleRate, flags);
+
+    if (next.init == filter->init && next.apply == filter->apply) {
+        // Same filter, only the cutoff may differ. The LPF_UPDATE variant
+        // provides the coefficient update for every type, which keeps the
+        // filter state.
+        lowpassFilterInit(&next, type, cutoff, sampleRate, flags | LPF_UPDATE);
+        next.update(&filter->data, cutoff, sampleRate);
+    } else {
+        *filter = next;
+    }
+}
+
 
 void notchFilterInit(filter_t *filter, float cutoff, float Q, float sampleRate, uint32_t flags)
 {
@@ -807,7 +911,11 @@ void notchFilterInit(filter_t *filter, float cutoff, float Q, float sampleRate,
     filter->update = (filterUpdateFn)nilFilterUpdate;
     filter->apply  = (filterApplyFn)nilFilterApply;
 
-    if (cutoff > 0 && Q > 0) {
+    if (cutoff > 0 && Q > 0 && (flags & LPF_FIXED)) {
+        filter->apply = (filterApplyFn)biquadFixedFilterApply;
+        biquadFixedFilterInit(&filter->data.fix, cutoff, sampleRate, Q, BIQUAD_NOTCH);
+    }
+    else if (cutoff > 0 && Q > 0) {
         if (flags & LPF_UPDATE)
             filter->apply = (filterApplyFn)biquadFilterApplyDF1;
         else
@@ -819,8 +927,12 @@ void notchFilterInit(filter_t *filter, float cutoff, float Q, float sampleRate,
 
 void notchFilterUpdate(filter_t *filter, float cutoff, float Q, float sampleRate)
 {
-    if (cutoff > 0 && Q > 0)
-        biquadFilterUpdate(&filter->data.sos, cutoff, sampleRate, Q, BIQUAD_NOTCH);
+    if (cutoff > 0 && Q > 0) {
+        if (filter->apply == (filterApplyFn)biquadFixedFilterApply)
+            biquadFixedFilterUpdate(&filter->data.fix, cutoff, sampleRate, Q, BIQUAD_NOTCH);
+        else
+            biquadFilterUpdate(&filter->data.sos, cutoff, sampleRate, Q, BIQUAD_NOTCH);
+    }
 }
 
 // Get notch filter Q given center frequency (f0) and lower cutoff frequency (f1)
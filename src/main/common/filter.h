@@ -140,6 +140,27 @@ typedef struct {
     float a2;
 } biquadFilter_t;
 
+/*
+ * Fixed-point biquad. Samples are Q16.16 and coefficients Q2.29,
+ * accumulated in 64 bits. The float output is kept first in the
+ * struct for filterOutput().
+ */
+#define BIQUAD_FIXED_SAMPLE_BITS    16
+#define BIQUAD_FIXED_COEFF_BITS     29
+
+typedef struct {
+    float   y;
+    int32_t x1;
+    int32_t x2;
+    int32_t y1;
+    int32_t y2;
+    int32_t b0;
+    int32_t b1;
+    int32_t b2;
+    int32_t a1;
+    int32_t a2;
+} biquadFixedFilter_t;
+
 typedef union {
     nilFilter_t     nil;
     pt1Filter_t     pt1;
@@ -150,6 +171,7 @@ typedef union {
     ewma3Filter_t   ew3;
     order1Filter_t  fos;
     biquadFilter_t  sos;
+    biquadFixedFilter_t fix;
 } filterData_t;
 
 typedef struct filter_s filter_t;
@@ -168,6 +190,7 @@ typedef struct filter_s {
 enum {
     LPF_UPDATE  = BIT(0),
     LPF_EWMA    = BIT(1),
+    LPF_FIXED   = BIT(2),
 };
 
 
@@ -200,6 +223,11 @@ void nilFilterInit(nilFilter_t *filter, float cutoff, float sampleRate);
 void nilFilterUpdate(nilFilter_t *filter, float cutoff, float sampleRate);
 float nilFilterApply(nilFilter_t *filter, float input);
 
+static inline bool filterIsActive(const filter_t *filter)
+{
+    return filter->apply && filter->apply != (filterApplyFn)nilFilterApply;
+}
+
 void pt1FilterInit(pt1Filter_t *filter, float cutoff, float sampleRate);
 void pt1FilterUpdate(pt1Filter_t *filter, float cutoff, float sampleRate);
 void pt1FilterInitGain(pt1Filter_t *filter, float gain);
@@ -265,7 +293,7 @@ void biquadFilterUpdate(biquadFilter_t *filter, float cutoff, float sampleRate,
 
 float biquadFilterApply(biquadFilter_t *filter, float input);
 float biquadFilterApplyDF1(biquadFilter_t *filter, float input);
-float biquadFilterApplyDF2(biquadFilter_t *filter, float input);
+float biquadFilterApplyTF2(biquadFilter_t *filter, float input);
 
 void firstOrderFilterInit(order1Filter_t *filter, float cutoff, float sampleRate);
 void firstOrderFilterUpdate(order1Filter_t *filter, float cutoff, float sampleRate);
@@ -274,7 +302,19 @@ float firstOrderFilterApplyTF2(order1Filter_t *filter, float input);
 
 float filterStackApply(biquadFilter_t *filter, float input, int count);
 
+static inline bool filterIsBiquadSection(const filter_t *filter)
+{
+    return filter->apply == (filterApplyFn)biquadFilterApplyTF2;
+}
+
+void biquadFixedFilterInit(biquadFixedFilter_t *filter, float cutoff, float sampleRate, float Q, uint8_t filterType);
+void biquadFixedFilterUpdate(biquadFixedFilter_t *filter, float cutoff, float sampleRate, float Q, uint8_t filterType);
+float biquadFixedFilterApply(biquadFixedFilter_t *filter, float input);
+
+float filterFixedStackApply(biquadFixedFilter_t *filter, float input, int count);
+
 void lowpassFilterInit(filter_t *filter, uint8_t type, float cutoff, float sampleRate, uint32_t flags);
+void lowpassFilterChange(filter_t *filter, uint8_t type, float cutoff, float sampleRate, uint32_t flags);
 
 void notchFilterInit(filter_t *filter, float cutoff, float Q, float sampleRate, uint32_t flags);
 void notchFilterUpdate(filter_t *filter, float cutoff, float Q, float sampleRate);
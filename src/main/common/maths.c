@@ -61,6 +61,82 @@ FAST_CODE float cos_approx(float x)
     return sin_approx(x + M_PI2f);
 }
 
+#define sinFastPolyCoef3 -1.660790828e-1f
+#define sinFastPolyCoef5  7.634041833e-3f
+
+/*
+ * Reduce x to [-PI/2,PI/2] for the sin polynomials, and return the
+ * sign of the cosine. The cosine is then sin(PI/2 - |x|), which falls
+ * in the same range, so both share one reduction.
+ */
+static inline float sincosReduce(float *px)
+{
+    float x = *px;
+    float sign = 1.0f;
+
+    while (x >  M_PIf)
+        x -= M_2PIf;
+    while (x < -M_PIf)
+        x += M_2PIf;
+
+    if (x > M_PI2f) {
+        x =  M_PIf - x;
+        sign = -1.0f;
+    }
+    else if (x < -M_PI2f) {
+        x = -M_PIf - x;
+        sign = -1.0f;
+    }
+
+    *px = x;
+
+    return sign;
+}
+
+static inline float sinPoly(float x)
+{
+    const float x2 = x * x;
+    return x + x * x2 * (sinPolyCoef3 + x2 * (sinPolyCoef5 + x2 * sinPolyCoef7));
+}
+
+static inline float sinFastPoly(float x)
+{
+    const float x2 = x * x;
+    return x + x * x2 * (sinFastPolyCoef3 + x2 * sinFastPolyCoef5);
+}
+
+FAST_CODE void sincos_approx(float x, float *sinx, float *cosx)
+{
+    int32_t xint = x;
+
+    if (xint < -32 || xint > 32) {
+        *sinx = 0;
+        *cosx = 1;
+        return;
+    }
+
+    const float sign = sincosReduce(&x);
+
+    *sinx = sinPoly(x);
+    *cosx = sinPoly(M_PI2f - fabsf(x)) * sign;
+}
+
+FAST_CODE void sincos_approx_fast(float x, float *sinx, float *cosx)
+{
+    int32_t xint = x;
+
+    if (xint < -32 || xint > 32) {
+        *sinx = 0;
+        *cosx = 1;
+        return;
+    }
+
+    const float sign = sincosReduce(&x);
+
+    *sinx = sinFastPoly(x);
+    *cosx = sinFastPoly(M_PI2f - fabsf(x)) * sign;
+}
+
 FAST_CODE float asin_approx(float x)
 {
     return M_PI2f - acos_approx(x);
@@ -149,12 +225,9 @@ void buildRotationMatrix(fp_angles_t *delta, fp_rotationMatrix_t *rotation)
     float cosx, sinx, cosy, siny, cosz, sinz;
     float coszcosx, sinzcosx, coszsinx, sinzsinx;
 
-    cosx = cos_approx(delta->angles.roll);
-    sinx = sin_approx(delta->angles.roll);
-    cosy = cos_approx(delta->angles.pitch);
-    siny = sin_approx(delta->angles.pitch);
-    cosz = cos_approx(delta->angles.yaw);
-    sinz = sin_approx(delta->angles.yaw);
+    sincos_approx(delta->angles.roll, &sinx, &cosx);
+    sincos_approx(delta->angles.pitch, &siny, &cosy);
+    sincos_approx(delta->angles.yaw, &sinz, &cosz);
 
     coszcosx = cosz * cosx;
     sinzcosx = sinz * cosx;
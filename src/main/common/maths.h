@@ -23,6 +23,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <math.h>
 
 /*
  * Floating point constants
@@ -43,8 +44,24 @@
 
 #ifndef USE_STANDARD_MATH
 
+/*
+ * Maximum absolute errors over the valid input range:
+ *
+ *   sin_approx, cos_approx     3.5e-6     |x| < 32
+ *   sincos_approx              3.5e-6     |x| < 32
+ *   sincos_approx_fast         1.5e-4     |x| < 32
+ *   atan2_approx               1e-6 rad
+ *   asin_approx, acos_approx   1e-4 rad   |x| <= 1
+ *
+ * sincos_approx() returns both values for the cost of little more than
+ * one sin_approx(). The _fast variant drops a polynomial term, and is
+ * meant for angles where 1e-4 is below the noise, like phase offsets.
+ */
+
 float sin_approx(float x);
 float cos_approx(float x);
+void sincos_approx(float x, float *sinx, float *cosx);
+void sincos_approx_fast(float x, float *sinx, float *cosx);
 float atan2_approx(float y, float x);
 float asin_approx(float x);
 float acos_approx(float x);
@@ -61,6 +78,15 @@ static inline float tan_approx(float x)
 
 #define sin_approx(x)       sinf(x)
 #define cos_approx(x)       cosf(x)
+
+static inline void sincos_approx(float x, float *sinx, float *cosx)
+{
+    *sinx = sinf(x);
+    *cosx = cosf(x);
+}
+
+#define sincos_approx_fast(x,s,c)   sincos_approx(x,s,c)
+
 #define tan_approx(x)       tanf(x)
 #define asin_approx(x)      asinf(x)
 #define acos_approx(x)      acosf(x)
@@ -136,6 +162,11 @@ static inline float tan_approx(float x)
  * Basic math operations
  */
 
+static inline float invSqrt(float x)
+{
+    return 1.0f / sqrtf(x);
+}
+
 static inline int constrain(int value, int low, int high)
 {
     if (value < low)
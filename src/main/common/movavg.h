@@ -0,0 +1,47 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "common/utils.h"
+
+/*
+ * Sliding window average with a running sum.
+ *
+ * The sample buffer is supplied by the caller and its length must be
+ * a power of two. The window starts out filled with zeros.
+ */
+
+typedef struct {
+    int32_t   sum;
+    int16_t * samples;
+    uint8_t   index;
+    uint8_t   mask;
+} movingAverage_t;
+
+#define MOVING_AVERAGE_INIT(buffer)  { .sum = 0, .samples = (buffer), .index = 0, .mask = ARRAYLEN(buffer) - 1 }
+
+static inline int32_t movingAverageUpdate(movingAverage_t *avg, int16_t value)
+{
+    avg->sum += value - avg->samples[avg->index];
+    avg->samples[avg->index] = value;
+    avg->index = (avg->index + 1) & avg->mask;
+
+    return avg->sum / (avg->mask + 1);
+}
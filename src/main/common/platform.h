@@ -118,6 +118,9 @@
 
 #include "target/common_pre.h"
 #include "target.h"
+#ifdef USE_CONFIG_SPECIALIZED
+#include "config_specialized.h"
+#endif
 #include "target/common_deprecated_post.h"
 #include "target/common_post.h"
 #include "target/common_defaults_post.h"
@@ -109,6 +109,58 @@ FAST_CODE void sdftPushBatch(sdft_t *sdft, const float sample, const int batchId
 }
 
 
+// data = twiddle * (data + delta), without the C99 complex NaN/Inf recovery
+static inline void rotateBin(complex_t *data, const float twr, const float twi, const float delta)
+{
+    const float re = crealf(*data) + delta;
+    const float im = cimagf(*data);
+
+    __real__ *data = re * twr - im * twi;
+    __imag__ *data = re * twi + im * twr;
+}
+
+// Add new sample to three identically configured spectrums in parts.
+// Twiddle factors and loop control are shared between the axes.
+FAST_CODE void sdftPushBatchXYZ(sdft_t sdft[XYZ_AXIS_COUNT], const float sample[XYZ_AXIS_COUNT], const int batchIdx)
+{
+    sdft_t *sx = &sdft[X];
+    sdft_t *sy = &sdft[Y];
+    sdft_t *sz = &sdft[Z];
+
+    const int batchStart = sx->batchSize * batchIdx + sx->startBin;
+    int batchEnd = batchStart;
+
+    const int idx = sx->idx;
+
+    const float dx = sample[X] - rPowerN * sx->samples[idx];
+    const float dy = sample[Y] - rPowerN * sy->samples[idx];
+    const float dz = sample[Z] - rPowerN * sz->samples[idx];
+
+    if (batchIdx == sx->numBatches - 1) {
+        const int next = (idx + 1 < SDFT_SAMPLE_SIZE) ? idx + 1 : 0;
+        sx->samples[idx] = sample[X];
+        sy->samples[idx] = sample[Y];
+        sz->samples[idx] = sample[Z];
+        sx->idx = sy->idx = sz->idx = next;
+        batchEnd += sx->endBin - batchStart + 1;
+    } else {
+        batchEnd += sx->batchSize;
+    }
+
+    for (int i = batchStart; i < batchEnd; i++) {
+        const float twr = crealf(twiddle[i]);
+        const float twi = cimagf(twiddle[i]);
+        rotateBin(&sx->data[i], twr, twi, dx);
+        rotateBin(&sy->data[i], twr, twi, dy);
+        rotateBin(&sz->data[i], twr, twi, dz);
+    }
+
+    updateEdges(sx, dx, batchIdx);
+    updateEdges(sy, dy, batchIdx);
+    updateEdges(sz, dz, batchIdx);
+}
+
+
 // Get squared magnitude of frequency spectrum
 FAST_CODE void sdftMagSq(const sdft_t *sdft, float *output)
 {
@@ -168,6 +220,45 @@ FAST_CODE void sdftWinSq(const sdft_t *sdft, float *output)
 }
 
 
+// Get squared magnitude of three spectra with Hann window applied in one interleaved pass.
+// All three must share the same active bin range.
+FAST_CODE void sdftWinSqXYZ(const sdft_t sdft[3], float output[3][SDFT_BIN_COUNT])
+{
+    const int startBin = sdft[0].startBin;
+    const int endBin = sdft[0].endBin;
+
+    for (int axis = 0; axis < 3; axis++) {
+        const complex_t *data = sdft[axis].data;
+        complex_t val;
+
+        // Apply window at the lower edge of active range
+        if (startBin == 0) {
+            val = data[startBin] - data[startBin + 1];
+        } else {
+            val = data[startBin] - 0.5f * (data[startBin - 1] + data[startBin + 1]);
+        }
+        output[axis][startBin] = crealf(val) * crealf(val) + cimagf(val) * cimagf(val);
+
+        // Apply window at the upper edge of active range
+        if (endBin == SDFT_BIN_COUNT - 1) {
+            val = data[endBin] - data[endBin - 1];
+        } else {
+            val = data[endBin] - 0.5f * (data[endBin - 1] + data[endBin + 1]);
+        }
+        output[axis][endBin] = crealf(val) * crealf(val) + cimagf(val) * cimagf(val);
+    }
+
+    for (int i = (startBin + 1); i < endBin; i++) {
+        const complex_t x = sdft[0].data[i] - 0.5f * (sdft[0].data[i - 1] + sdft[0].data[i + 1]);
+        const complex_t y = sdft[1].data[i] - 0.5f * (sdft[1].data[i - 1] + sdft[1].data[i + 1]);
+        const complex_t z = sdft[2].data[i] - 0.5f * (sdft[2].data[i - 1] + sdft[2].data[i + 1]);
+        output[0][i] = crealf(x) * crealf(x) + cimagf(x) * cimagf(x);
+        output[1][i] = crealf(y) * crealf(y) + cimagf(y) * cimagf(y);
+        output[2][i] = crealf(z) * crealf(z) + cimagf(z) * cimagf(z);
+    }
+}
+
+
 // Get magnitude of frequency spectrum with Hann window applied (slower)
 FAST_CODE void sdftWindow(const sdft_t *sdft, float *output)
 {
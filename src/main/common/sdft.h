@@ -26,12 +26,23 @@
 #include <stdint.h>
 #include <complex.h>
 
+#include "common/axis.h"
+
 // avoid collision of imaginary unit I with variable I in pid.h
 #undef I
 
 typedef float complex complex_t;
 
+// Number of samples in the SDFT window. Can be overridden per target
+// for finer frequency resolution (sampleRate / SDFT_SAMPLE_SIZE per bin).
+#ifndef SDFT_SAMPLE_SIZE
 #define SDFT_SAMPLE_SIZE 72
+#endif
+
+#if (SDFT_SAMPLE_SIZE % 2) || (SDFT_SAMPLE_SIZE < 8)
+#error "SDFT_SAMPLE_SIZE must be even and at least 8"
+#endif
+
 #define SDFT_BIN_COUNT   (SDFT_SAMPLE_SIZE / 2)
 
 typedef struct sdft_s {
@@ -50,7 +61,9 @@ typedef struct sdft_s {
 void sdftInit(sdft_t *sdft, const int startBin, const int endBin, const int numBatches);
 void sdftPush(sdft_t *sdft, const float sample);
 void sdftPushBatch(sdft_t *sdft, const float sample, const int batchIdx);
+void sdftPushBatchXYZ(sdft_t sdft[XYZ_AXIS_COUNT], const float sample[XYZ_AXIS_COUNT], const int batchIdx);
 void sdftMagSq(const sdft_t *sdft, float *output);
 void sdftMagnitude(const sdft_t *sdft, float *output);
 void sdftWinSq(const sdft_t *sdft, float *output);
+void sdftWinSqXYZ(const sdft_t sdft[3], float output[3][SDFT_BIN_COUNT]);
 void sdftWindow(const sdft_t *sdft, float *output);
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 // simple buffer-based serializer/deserializer without implicit size check
@@ -54,3 +55,56 @@ const uint8_t* sbufConstPtr(const sbuf_t *buf);
 void sbufAdvance(sbuf_t *buf, int size);
 
 void sbufSwitchToReader(sbuf_t *buf, uint8_t * base);
+
+// Reservation for a fixed layout block of writes. sbufReserve() checks
+// the available space once and returns a cursor, or NULL if len bytes
+// don't fit. The block is then written with the unchecked sbufPut*
+// helpers, and completed with sbufCommit() on the final cursor.
+
+static inline uint8_t *sbufReserve(sbuf_t *dst, int len)
+{
+    return (dst->end - dst->ptr >= len) ? dst->ptr : NULL;
+}
+
+static inline void sbufCommit(sbuf_t *dst, uint8_t *ptr)
+{
+    dst->ptr = ptr;
+}
+
+static inline uint8_t *sbufPutU8(uint8_t *ptr, uint8_t val)
+{
+    ptr[0] = val;
+    return ptr + 1;
+}
+
+static inline uint8_t *sbufPutU16(uint8_t *ptr, uint16_t val)
+{
+    ptr[0] = val >> 0;
+    ptr[1] = val >> 8;
+    return ptr + 2;
+}
+
+static inline uint8_t *sbufPutU32(uint8_t *ptr, uint32_t val)
+{
+    ptr[0] = val >> 0;
+    ptr[1] = val >> 8;
+    ptr[2] = val >> 16;
+    ptr[3] = val >> 24;
+    return ptr + 4;
+}
+
+static inline uint8_t *sbufPutU16BigEndian(uint8_t *ptr, uint16_t val)
+{
+    ptr[0] = val >> 8;
+    ptr[1] = val >> 0;
+    return ptr + 2;
+}
+
+static inline uint8_t *sbufPutU32BigEndian(uint8_t *ptr, uint32_t val)
+{
+    ptr[0] = val >> 24;
+    ptr[1] = val >> 16;
+    ptr[2] = val >> 8;
+    ptr[3] = val >> 0;
+    return ptr + 4;
+}
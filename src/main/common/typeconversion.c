@@ -18,6 +18,7 @@
  * If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include <math.h>
@@ -151,6 +152,65 @@ char *itoa(int i, char *a, int base)
 
 #endif
 
+static int fmtDigits(char *buf, unsigned num, bool negative, unsigned width, char pad)
+{
+    char digits[10];
+    unsigned count = 0;
+
+    do {
+        digits[count++] = '0' + num % 10;
+        num /= 10;
+    } while (num);
+
+    // Same as tfp_format(): the sign is counted in the width, and any
+    // padding goes in front of it
+    unsigned len = count + negative;
+    int pos = 0;
+
+    while (width > len) {
+        buf[pos++] = pad;
+        width--;
+    }
+    if (negative) {
+        buf[pos++] = '-';
+    }
+    while (count) {
+        buf[pos++] = digits[--count];
+    }
+    buf[pos] = 0;
+
+    return pos;
+}
+
+int fmtUnsigned(char *buf, unsigned num, unsigned width, char pad)
+{
+    return fmtDigits(buf, num, false, width, pad);
+}
+
+int fmtInt(char *buf, int num, unsigned width, char pad)
+{
+    return fmtDigits(buf, (num < 0) ? -(unsigned)num : (unsigned)num, num < 0, width, pad);
+}
+
+int fmtFixed(char *buf, int num, unsigned decimals)
+{
+    unsigned divider = 1;
+
+    for (unsigned i = 0; i < decimals; i++) {
+        divider *= 10;
+    }
+
+    const unsigned absNum = (num < 0) ? -(unsigned)num : (unsigned)num;
+    int pos = fmtDigits(buf, absNum / divider, num < 0, 0, 0);
+
+    if (decimals) {
+        buf[pos++] = '.';
+        pos += fmtDigits(buf + pos, absNum % divider, false, decimals, '0');
+    }
+
+    return pos;
+}
+
 char *ftoa(float x, char *floatString)
 {
     int32_t value;
@@ -28,6 +28,14 @@ void ui2a(unsigned int num, unsigned int base, int uc, char *bf);
 void i2a(int num, char *bf);
 char a2i(char ch, const char **src, int base, int *nump);
 char *ftoa(float x, char *floatString);
+
+// Fixed format decimal output, without parsing a format string.
+// Equivalent to tfp_sprintf() with "%<pad><width>u", "%<pad><width>d"
+// and "%d.%0<decimals>u". The output is NUL terminated, and the return
+// value is the length excluding the NUL.
+int fmtUnsigned(char *buf, unsigned num, unsigned width, char pad);
+int fmtInt(char *buf, int num, unsigned width, char pad);
+int fmtFixed(char *buf, int num, unsigned decimals);
 float fastA2F(const char *p);
 
 #ifndef HAVE_ITOA_FUNCTION
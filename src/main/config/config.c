@@ -47,6 +47,7 @@
 #include "fc/rc_controls.h"
 #include "fc/runtime_config.h"
 #include "fc/dispatch.h"
+#include "fc/stats.h"
 
 #include "flight/failsafe.h"
 #include "flight/imu.h"
@@ -114,7 +115,7 @@ PG_RESET_TEMPLATE(pilotConfig_t, pilotConfig,
     .displayName = { 0 },
 );
 
-PG_REGISTER_WITH_RESET_TEMPLATE(systemConfig_t, systemConfig, PG_SYSTEM_CONFIG, 3);
+PG_REGISTER_WITH_RESET_TEMPLATE(systemConfig_t, systemConfig, PG_SYSTEM_CONFIG, 4);
 
 PG_RESET_TEMPLATE(systemConfig_t, systemConfig,
     .pidProfileIndex = 0,
@@ -129,6 +130,7 @@ PG_RESET_TEMPLATE(systemConfig_t, systemConfig,
     .configurationState = CONFIGURATION_STATE_DEFAULTS_BARE,
     .enableStickArming = false,
     .enableStickCommands = false,
+    .debug_mode_2 = DEBUG_NONE,
 );
 
 bool isEepromWriteInProgress(void)
@@ -757,6 +759,24 @@ void writeUnmodifiedConfigToEEPROM(void)
     eepromWriteInProgress = false;
     resumeRxSignal();
     configIsDirty = false;
+
+#ifdef USE_PERSISTENT_STATS
+    statsOnConfigWrite();
+#endif
+}
+
+void writePGToEEPROM(pgn_t pgn)
+{
+    suspendRxSignal();
+    eepromWriteInProgress = true;
+    const bool appended = appendPGToEEPROM(pgn);
+    eepromWriteInProgress = false;
+    resumeRxSignal();
+
+    // No room left to append - compact the whole config
+    if (!appended) {
+        writeUnmodifiedConfigToEEPROM();
+    }
 }
 
 void writeEEPROM(void)
@@ -779,7 +799,7 @@ void dispatchConfigWrite(struct dispatchEntry_s* self)
 
 dispatchEntry_t writeConfigEntry =
 {
-    dispatchConfigWrite, 0, NULL, false
+    .dispatch = dispatchConfigWrite,
 };
 
 void writeEEPROMDelayed(int delayUs)
@@ -53,6 +53,7 @@ typedef struct systemConfig_s {
     uint8_t configurationState;     // The state of the configuration (defaults / configured)
     uint8_t enableStickArming; // boolean that determines whether stick arming can be used
     uint8_t enableStickCommands; // boolean that determines whether stick commands can be used
+    uint8_t debug_mode_2;           // second debug mode, logged in debug[8..15]
 } systemConfig_t;
 
 PG_DECLARE(systemConfig_t, systemConfig);
@@ -66,6 +67,7 @@ bool readEEPROM(void);
 void writeEEPROM(void);
 void writeEEPROMDelayed(int delayUs);
 void writeUnmodifiedConfigToEEPROM(void);
+void writePGToEEPROM(pgn_t pgn);
 
 void saveConfigAndNotify(void);
 void validateAndFixGyroConfig(void);
@@ -52,11 +52,16 @@ typedef enum {
 #define CRC_START_VALUE         0xFFFF
 #define CRC_CHECK_VALUE         0x1D0F  // pre-calculated value of CRC that includes the CRC itself
 
+#define CONFIG_MAGIC            0xBE    // magic of the saved copy
+#define CONFIG_SEGMENT_MAGIC    0xA5    // magic of a segment appended by an incremental save
+
 // Header for the saved copy.
 typedef struct {
     uint8_t eepromConfigVersion;
-    uint8_t magic_be;           // magic number, should be 0xBE
+    uint8_t magic_be;           // magic number, CONFIG_MAGIC or CONFIG_SEGMENT_MAGIC
 } PG_PACKED configHeader_t;
+// Incremental saves append segments holding only the changed PGs after the
+// saved copy, each with the same layout and aligned to the streamer write size.
 
 // Header for each stored PG.
 typedef struct {
@@ -281,14 +286,14 @@ bool isEEPROMVersionValid(void)
     return true;
 }
 
-// Scan the EEPROM config. Returns true if the config is valid.
-bool isEEPROMStructureValid(void)
+// Scan one saved copy or appended segment starting at p.
+// Returns a pointer just past its CRC, or NULL if it is not valid.
+static const uint8_t *scanEEPROMSegment(const uint8_t *p, uint8_t magic)
 {
-    const uint8_t *p = &__config_start;
     const configHeader_t *header = (const configHeader_t *)p;
 
-    if (header->magic_be != 0xBE) {
-        return false;
+    if (p + sizeof(*header) >= &__config_end || header->magic_be != magic) {
+        return NULL;
     }
 
     uint16_t crc = CRC_START_VALUE;
@@ -305,7 +310,7 @@ bool isEEPROMStructureValid(void)
         if (p + record->size >= &__config_end
             || record->size < sizeof(*record)) {
             // Too big or too small.
-            return false;
+            return NULL;
         }
 
         crc = crc16_ccitt_update(crc, p, record->size);
@@ -313,6 +318,10 @@ bool isEEPROMStructureValid(void)
         p += record->size;
     }
 
+    if (p + sizeof(configFooter_t) + sizeof(uint16_t) > &__config_end) {
+        return NULL;
+    }
+
     const configFooter_t *footer = (const configFooter_t *)p;
     crc = crc16_ccitt_update(crc, footer, sizeof(*footer));
     p += sizeof(*footer);
@@ -320,12 +329,41 @@ bool isEEPROMStructureValid(void)
     // include stored CRC in the CRC calculation
     const uint16_t *storedCrc = (const uint16_t *)p;
     crc = crc16_ccitt_update(crc, storedCrc, sizeof(*storedCrc));
-    p += sizeof(storedCrc);
+    p += sizeof(*storedCrc);
+
+    // CRC has the property that if the CRC itself is included in the calculation the resulting CRC will have constant value
+    return (crc == CRC_CHECK_VALUE) ? p : NULL;
+}
+
+// Segments are appended at the streamer write size granularity
+static const uint8_t *alignEEPROMSegment(const uint8_t *p)
+{
+    const uintptr_t offset = p - &__config_start;
+    return &__config_start + ((offset + CONFIG_STREAMER_BUFFER_SIZE - 1) & ~(CONFIG_STREAMER_BUFFER_SIZE - 1));
+}
+
+// Scan the EEPROM config. Returns true if the config is valid.
+bool isEEPROMStructureValid(void)
+{
+    const uint8_t *p = scanEEPROMSegment(&__config_start, CONFIG_MAGIC);
+
+    if (!p) {
+        return false;
+    }
+
+    // Follow the segments appended by incremental saves. An erased or
+    // partially written segment ends the config.
+    for (;;) {
+        const uint8_t *next = scanEEPROMSegment(alignEEPROMSegment(p), CONFIG_SEGMENT_MAGIC);
+        if (!next) {
+            break;
+        }
+        p = next;
+    }
 
     eepromConfigSize = p - &__config_start;
 
-    // CRC has the property that if the CRC itself is included in the calculation the resulting CRC will have constant value
-    return crc == CRC_CHECK_VALUE;
+    return true;
 }
 
 uint16_t getEEPROMConfigSize(void)
@@ -349,35 +387,81 @@ size_t getEEPROMStorageSize(void)
 
 // find config record for reg + classification (profile info) in EEPROM
 // return NULL when record is not found
-// this function assumes that EEPROM content is valid
+// this function assumes that EEPROM content is valid and has been scanned
+// by isEEPROMStructureValid(). Appended segments override earlier records.
 static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFlags_e classification)
 {
+    const configRecord_t *found = NULL;
     const uint8_t *p = &__config_start;
-    p += sizeof(configHeader_t);             // skip header
-    while (true) {
-        const configRecord_t *record = (const configRecord_t *)p;
-        if (record->size == 0
-            || p + record->size >= &__config_end
-            || record->size < sizeof(*record))
-            break;
-        if (pgN(reg) == record->pgn
-            && (record->flags & CR_CLASSIFICATION_MASK) == classification)
-            return record;
-        p += record->size;
+    const uint8_t *end = &__config_start + eepromConfigSize;
+    while (p < end) {
+        p += sizeof(configHeader_t);             // skip header
+        while (true) {
+            const configRecord_t *record = (const configRecord_t *)p;
+            if (record->size == 0
+                || p + record->size >= &__config_end
+                || record->size < sizeof(*record))
+                break;
+            if (pgN(reg) == record->pgn
+                && (record->flags & CR_CLASSIFICATION_MASK) == classification)
+                found = record;
+            p += record->size;
+        }
+        p = alignEEPROMSegment(p + sizeof(configFooter_t) + sizeof(uint16_t));
     }
-    // record not found
-    return NULL;
+    return found;
+}
+
+// A PG needs saving if it has changed since loaded or saved, or
+// if the stored record does not match the current layout.
+static bool isEEPROMRecordDirty(const pgRegistry_t *reg)
+{
+    if (pgIsDirty(reg)) {
+        return true;
+    }
+
+    const configRecord_t *rec = findEEPROM(reg, CR_CLASSICATION_SYSTEM);
+
+    return !rec || rec->version != pgVersion(reg)
+        || rec->size != sizeof(configRecord_t) + pgSize(reg);
 }
 
 // Initialize all PG records from EEPROM.
-// This functions processes all PGs sequentially, scanning EEPROM for each one. This is suboptimal,
-//   but each PG is loaded/initialized exactly once and in defined order.
+// The stored records are walked once, picking the last record of each PG,
+// as appended segments override earlier records. Each PG is then loaded or
+// reset exactly once and in defined order.
+// This function assumes that EEPROM content is valid and has been scanned
+// by isEEPROMStructureValid().
 bool loadEEPROM(void)
 {
+    const configRecord_t *records[PG_REGISTRY_SIZE];
+    memset(records, 0, sizeof(records));
+
+    const uint8_t *p = &__config_start;
+    const uint8_t *end = &__config_start + eepromConfigSize;
+    while (p < end) {
+        p += sizeof(configHeader_t);             // skip header
+        while (true) {
+            const configRecord_t *record = (const configRecord_t *)p;
+            if (record->size == 0
+                || p + record->size >= &__config_end
+                || record->size < sizeof(*record))
+                break;
+            if ((record->flags & CR_CLASSIFICATION_MASK) == CR_CLASSICATION_SYSTEM) {
+                const pgRegistry_t *reg = pgFind(record->pgn);
+                if (reg) {
+                    records[reg - __pg_registry_start] = record;
+                }
+            }
+            p += record->size;
+        }
+        p = alignEEPROMSegment(p + sizeof(configFooter_t) + sizeof(uint16_t));
+    }
+
     bool success = true;
 
     PG_FOREACH(reg) {
-        const configRecord_t *rec = findEEPROM(reg, CR_CLASSICATION_SYSTEM);
+        const configRecord_t *rec = records[reg - __pg_registry_start];
         if (rec) {
             // config from EEPROM is available, use it to initialize PG. pgLoad will handle version mismatch
             if (!pgLoad(reg, rec->pg, rec->size - offsetof(configRecord_t, pg), rec->version)) {
@@ -394,18 +478,66 @@ bool loadEEPROM(void)
     return success;
 }
 
-static bool writeSettingsToEEPROM(void)
+static void writeSegmentToEEPROM(config_streamer_t *streamer, uint8_t magic, bool dirtyOnly, const pgRegistry_t *only)
 {
-    bool dirtyConfig = !isEEPROMVersionValid() || !isEEPROMStructureValid();
-
     configHeader_t header = {
         .eepromConfigVersion =  EEPROM_CONF_VERSION,
-        .magic_be =             0xBE,
+        .magic_be =             magic,
     };
 
+    config_streamer_write(streamer, (uint8_t *)&header, sizeof(header));
+    uint16_t crc = CRC_START_VALUE;
+    crc = crc16_ccitt_update(crc, (uint8_t *)&header, sizeof(header));
     PG_FOREACH(reg) {
-        if (*reg->fnv_hash != fnv_update(FNV_OFFSET_BASIS, reg->address, pgSize(reg))) {
-            dirtyConfig = true;
+        if (dirtyOnly && !isEEPROMRecordDirty(reg)) {
+            continue;
+        }
+        if (only && reg != only) {
+            continue;
+        }
+
+        const uint16_t regSize = pgSize(reg);
+        configRecord_t record = {
+            .size = sizeof(configRecord_t) + regSize,
+            .pgn = pgN(reg),
+            .version = pgVersion(reg),
+            .flags = 0,
+        };
+
+        record.flags |= CR_CLASSICATION_SYSTEM;
+        config_streamer_write(streamer, (uint8_t *)&record, sizeof(record));
+        crc = crc16_ccitt_update(crc, (uint8_t *)&record, sizeof(record));
+        config_streamer_write(streamer, reg->address, regSize);
+        crc = crc16_ccitt_update(crc, reg->address, regSize);
+    }
+
+    configFooter_t footer = {
+        .terminator = 0,
+    };
+
+    config_streamer_write(streamer, (uint8_t *)&footer, sizeof(footer));
+    crc = crc16_ccitt_update(crc, (uint8_t *)&footer, sizeof(footer));
+
+    // include inverted CRC in big endian format in the CRC
+    const uint16_t invertedBigEndianCrc = ~(((crc & 0xFF) << 8) | (crc >> 8));
+    config_streamer_write(streamer, (uint8_t *)&invertedBigEndianCrc, sizeof(crc));
+
+    config_streamer_flush(streamer);
+}
+
+static bool writeSettingsToEEPROM(void)
+{
+    const bool validConfig = isEEPROMVersionValid() && isEEPROMStructureValid();
+
+    bool dirtyConfig = !validConfig;
+    int segmentSize = sizeof(configHeader_t) + sizeof(configFooter_t) + sizeof(uint16_t);
+
+    if (validConfig) {
+        PG_FOREACH(reg) {
+            if (isEEPROMRecordDirty(reg)) {
+                segmentSize += sizeof(configRecord_t) + pgSize(reg);
+                dirtyConfig = true;
+            }
         }
     }
 
@@ -414,45 +546,66 @@ static bool writeSettingsToEEPROM(void)
         config_streamer_t streamer;
         config_streamer_init(&streamer);
 
-        config_streamer_start(&streamer, (uintptr_t)&__config_start, &__config_end - &__config_start);
+        // Append the changed PGs after the saved copy if the flash there is
+        // still erased, otherwise compact everything into a new copy.
+        const uintptr_t segment = (uintptr_t)alignEEPROMSegment(&__config_start + eepromConfigSize);
+        segmentSize = (segmentSize + CONFIG_STREAMER_BUFFER_SIZE - 1) & ~(CONFIG_STREAMER_BUFFER_SIZE - 1);
 
-        config_streamer_write(&streamer, (uint8_t *)&header, sizeof(header));
-        uint16_t crc = CRC_START_VALUE;
-        crc = crc16_ccitt_update(crc, (uint8_t *)&header, sizeof(header));
-        PG_FOREACH(reg) {
-            const uint16_t regSize = pgSize(reg);
-            configRecord_t record = {
-                .size = sizeof(configRecord_t) + regSize,
-                .pgn = pgN(reg),
-                .version = pgVersion(reg),
-                .flags = 0,
-            };
-
-
-            record.flags |= CR_CLASSICATION_SYSTEM;
-            config_streamer_write(&streamer, (uint8_t *)&record, sizeof(record));
-            crc = crc16_ccitt_update(crc, (uint8_t *)&record, sizeof(record));
-            config_streamer_write(&streamer, reg->address, regSize);
-            crc = crc16_ccitt_update(crc, reg->address, regSize);
+        if (validConfig && segment + segmentSize <= (uintptr_t)&__config_end && config_streamer_is_blank(segment, segmentSize)) {
+            config_streamer_start(&streamer, segment, segmentSize);
+            writeSegmentToEEPROM(&streamer, CONFIG_SEGMENT_MAGIC, true, NULL);
+        } else {
+            config_streamer_start(&streamer, (uintptr_t)&__config_start, &__config_end - &__config_start);
+            writeSegmentToEEPROM(&streamer, CONFIG_MAGIC, false, NULL);
         }
 
-        configFooter_t footer = {
-            .terminator = 0,
-        };
+        if (config_streamer_finish(&streamer) != 0) {
+            return false;
+        }
+
+        PG_FOREACH(reg) {
+            pgMarkClean(reg);
+        }
+    }
 
-        config_streamer_write(&streamer, (uint8_t *)&footer, sizeof(footer));
-        crc = crc16_ccitt_update(crc, (uint8_t *)&footer, sizeof(footer));
+    return true;
+}
 
-        // include inverted CRC in big endian format in the CRC
-        const uint16_t invertedBigEndianCrc = ~(((crc & 0xFF) << 8) | (crc >> 8));
-        config_streamer_write(&streamer, (uint8_t *)&invertedBigEndianCrc, sizeof(crc));
+// Append a single PG to the saved config, leaving any other changes
+// unsaved. Returns false without writing if the PG can't be appended,
+// and the caller must then save the whole config instead.
+bool appendPGToEEPROM(pgn_t pgn)
+{
+    const pgRegistry_t *reg = pgFind(pgn);
 
-        config_streamer_flush(&streamer);
+    if (!reg || !isEEPROMVersionValid() || !isEEPROMStructureValid()) {
+        return false;
+    }
 
-        return (config_streamer_finish(&streamer) == 0);
-    } else {
+    if (!isEEPROMRecordDirty(reg)) {
         return true;
     }
+
+    const uintptr_t segment = (uintptr_t)alignEEPROMSegment(&__config_start + eepromConfigSize);
+    int segmentSize = sizeof(configHeader_t) + sizeof(configRecord_t) + pgSize(reg) + sizeof(configFooter_t) + sizeof(uint16_t);
+    segmentSize = (segmentSize + CONFIG_STREAMER_BUFFER_SIZE - 1) & ~(CONFIG_STREAMER_BUFFER_SIZE - 1);
+
+    if (segment + segmentSize > (uintptr_t)&__config_end || !config_streamer_is_blank(segment, segmentSize)) {
+        return false;
+    }
+
+    config_streamer_t streamer;
+    config_streamer_init(&streamer);
+    config_streamer_start(&streamer, segment, segmentSize);
+    writeSegmentToEEPROM(&streamer, CONFIG_SEGMENT_MAGIC, false, reg);
+
+    if (config_streamer_finish(&streamer) != 0 || !isEEPROMStructureValid()) {
+        return false;
+    }
+
+    pgMarkClean(reg);
+
+    return true;
 }
 
 void writeConfigToEEPROM(void)
@@ -23,12 +23,15 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "pg/pg.h"
+
 #define EEPROM_CONF_VERSION 174
 
 bool isEEPROMVersionValid(void);
 bool isEEPROMStructureValid(void);
 bool loadEEPROM(void);
 void writeConfigToEEPROM(void);
+bool appendPGToEEPROM(pgn_t pgn);
 
 uint16_t getEEPROMConfigSize(void);
 size_t getEEPROMStorageSize(void);
@@ -22,6 +22,8 @@
 
 #include "platform.h"
 
+#include "common/utils.h"
+
 #include "drivers/system.h"
 #include "drivers/flash.h"
 
@@ -84,7 +86,8 @@ void config_streamer_init(config_streamer_t *c)
 
 void config_streamer_start(config_streamer_t *c, uintptr_t base, int size)
 {
-    // base must start at FLASH_PAGE_SIZE boundary when using embedded flash.
+    // base must start at FLASH_PAGE_SIZE boundary when using embedded flash,
+    // unless the area has been checked with config_streamer_is_blank().
     c->address = base;
     c->size = size;
     if (!c->unlocked) {
@@ -522,6 +525,31 @@ int config_streamer_write(config_streamer_t *c, const uint8_t *p, uint32_t size)
     return c->err;
 }
 
+// Returns true if the area can be programmed without an erase. That is only
+// possible on embedded flash, when the area is still erased and does not
+// reach a page boundary, where write_word() would erase the page.
+bool config_streamer_is_blank(uintptr_t address, int size)
+{
+#if defined(CONFIG_IN_FLASH) && !defined(UNIT_TEST) && !defined(SIMULATOR_BUILD)
+    if (size <= 0 || address % CONFIG_STREAMER_BUFFER_SIZE != 0) {
+        return false;
+    }
+    if (address % FLASH_PAGE_SIZE == 0 || address / FLASH_PAGE_SIZE != (address + size - 1) / FLASH_PAGE_SIZE) {
+        return false;
+    }
+    for (const uint8_t *p = (const uint8_t *)address; p != (const uint8_t *)(address + size); p++) {
+        if (*p != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+#else
+    UNUSED(address);
+    UNUSED(size);
+    return false;
+#endif
+}
+
 int config_streamer_status(config_streamer_t *c)
 {
     return c->err;
@@ -30,6 +30,7 @@
 #include "drivers/bus.h"
 #include "drivers/sensor.h"
 #include "drivers/accgyro/accgyro_mpu.h"
+#include "drivers/accgyro/gyro_queue.h"
 
 #pragma GCC diagnostic push
 #if defined(SIMULATOR_BUILD) && defined(SIMULATOR_MULTITHREAD)
@@ -105,6 +106,8 @@ typedef struct gyroDev_s {
     int32_t gyroADCRawPrevious[XYZ_AXIS_COUNT];
     int16_t gyroADCRaw[XYZ_AXIS_COUNT];                      // raw data from sensor
     int16_t temperature;
+    volatile int16_t temperatureRaw;                         // raw temperature from the gyro DMA burst
+    bool hasTemperatureRaw;
     mpuDetectionResult_t mpuDetectionResult;
     sensor_align_e gyroAlign;
     gyroRateKHz_e gyroRateKHz;
@@ -115,6 +118,17 @@ typedef struct gyroDev_s {
     int32_t gyroShortPeriod;
     int32_t gyroDmaMaxDuration;
     busSegment_t segments[2];
+#ifdef USE_GYRO_SAMPLE_QUEUE
+    gyroSampleQueue_t queue;
+#endif
+#ifdef USE_GYRO_FIFO_BURST
+    uint8_t fifoBurst;                                       // samples per FIFO interrupt (0 = FIFO burst off)
+#endif
+    int32_t samplePeriod;                                    // mean EXTI sample interval, 1/16 cycles
+    int32_t sampleJitter;                                    // mean absolute deviation of the interval, 1/16 cycles
+    volatile uint32_t accSumSeq;                             // bumped by the DMA callback around accSum updates
+    uint32_t accSum[XYZ_AXIS_COUNT];                         // running sums of accel samples from the gyro DMA burst
+    uint32_t accSumCount;
     volatile bool dataReady;
     bool gyro_high_fsr;
     bool gyro_rate_sync;
@@ -122,6 +136,8 @@ typedef struct gyroDev_s {
     uint8_t mpuDividerDrops;
     ioTag_t mpuIntExtiTag;
     uint8_t gyroHasOverflowProtection;
+    bool gyroHasSaturationFlags;                             // the read sets saturation from the raw sample
+    uint8_t saturation;                                      // axes of the last sample at the end of the range
     gyroHardware_e gyroHardware;
     fp_rotationMatrix_t rotationMatrix;
     uint16_t gyroSampleRateHz;
@@ -130,6 +146,48 @@ typedef struct gyroDev_s {
     uint8_t gyroDataReg;
 } gyroDev_t;
 
+#define GYRO_TIMING_SHIFT       4
+#define GYRO_TIMING_WEIGHT      64
+
+// Sample interval statistics from the EXTI timestamps.
+// Called in ISR context, before gyroLastEXTI is updated.
+static inline void gyroUpdateSampleTiming(gyroDev_t *gyro, uint32_t nowCycles)
+{
+    if (gyro->detectedEXTI == 0) {
+        return;
+    }
+
+    int32_t period = (int32_t)(nowCycles - gyro->gyroLastEXTI) << GYRO_TIMING_SHIFT;
+#ifdef USE_GYRO_FIFO_BURST
+    period /= (gyro->fifoBurst > 1) ? gyro->fifoBurst : 1;
+#endif
+
+    if (gyro->samplePeriod == 0) {
+        gyro->samplePeriod = period;
+    }
+    // Ignore missed interrupts
+    else if (period > 0 && period < 4 * gyro->samplePeriod) {
+        const int32_t delta = period - gyro->samplePeriod;
+        gyro->samplePeriod += delta / GYRO_TIMING_WEIGHT;
+        gyro->sampleJitter += ((delta < 0 ? -delta : delta) - gyro->sampleJitter) / GYRO_TIMING_WEIGHT;
+    }
+}
+
+// Axes at the end of the sensor range, one bit per axis. The ICM426xx and
+// BMI270 also return INT16_MIN for invalid data, which is flagged the same.
+static inline uint8_t gyroSaturationMask(const int16_t *raw)
+{
+    uint8_t mask = 0;
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        if (raw[axis] == INT16_MAX || raw[axis] <= -INT16_MAX) {
+            mask |= 1 << axis;
+        }
+    }
+
+    return mask;
+}
+
 typedef struct accDev_s {
 #if defined(SIMULATOR_BUILD) && defined(SIMULATOR_MULTITHREAD)
     pthread_mutex_t lock;
@@ -146,6 +204,8 @@ typedef struct accDev_s {
     bool acc_high_fsr;
     char revisionCode;                                      // a revision code for the sensor, if known
     uint8_t filler[2];
+    uint32_t accSumPrev[XYZ_AXIS_COUNT];                    // gyro accSum at the previous read
+    uint32_t accSumCountPrev;
     fp_rotationMatrix_t rotationMatrix;
 } accDev_t;
 
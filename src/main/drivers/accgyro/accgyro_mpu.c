@@ -38,6 +38,7 @@
 #include "drivers/exti.h"
 #include "drivers/io.h"
 #include "drivers/nvic.h"
+#include "drivers/persistent.h"
 #include "drivers/sensor.h"
 #include "drivers/system.h"
 #include "drivers/time.h"
@@ -73,9 +74,19 @@
 // Allow 100ms before attempting to access SPI bus
 #define GYRO_SPI_STARTUP_MS 100
 
+// MPU datasheet specifies 30ms from power on
+#define GYRO_POWER_ON_MS 35
+
+// Detection function index per gyro, cached over warm resets
+#define GYRO_DETECT_CACHE_MAGIC     0x6D000000
+#define GYRO_DETECT_CACHE_MAGIC_MASK 0xFF000000
+#define GYRO_DETECT_CACHE_BITS      4
+
 // Need to see at least this many interrupts during initialisation to confirm EXTI connectivity
 #define GYRO_EXTI_DETECT_THRESHOLD 100
 
+static bool gyroDetectCacheHit;
+
 #ifdef USE_I2C_GYRO
 static void mpu6050FindRevision(gyroDev_t *gyro)
 {
@@ -127,6 +138,34 @@ busStatus_e mpuIntcallback(uint32_t arg)
         gyro->gyroDmaMaxDuration = gyroDmaDuration;
     }
 
+    const int16_t *gyroData = (int16_t *)gyro->dev.rxBuf;
+
+    // Accumulate every accel sample from the burst, so that the acc task
+    // gets a gyro aligned average instead of one aliased sample
+    gyro->accSumSeq++;
+    GYRO_QUEUE_BARRIER();
+    gyro->accSum[X] += (int16_t)__builtin_bswap16(gyroData[1]);
+    gyro->accSum[Y] += (int16_t)__builtin_bswap16(gyroData[2]);
+    gyro->accSum[Z] += (int16_t)__builtin_bswap16(gyroData[3]);
+    gyro->accSumCount++;
+    GYRO_QUEUE_BARRIER();
+    gyro->accSumSeq++;
+
+    // MPU6xxx and ICM20xxx have the temperature just before the gyro data
+    if (gyro->hasTemperatureRaw) {
+        gyro->temperatureRaw = __builtin_bswap16(gyroData[((gyro->gyroDataReg - gyro->accDataReg) >> 1)]);
+    }
+
+#ifdef USE_GYRO_SAMPLE_QUEUE
+    // Acc and gyro data may not be continuous (MPU6xxx has temperature in between)
+    const uint8_t gyroDataIndex = ((gyro->gyroDataReg - gyro->accDataReg) >> 1) + 1;
+
+    gyroQueuePush(&gyro->queue,
+        __builtin_bswap16(gyroData[gyroDataIndex]),
+        __builtin_bswap16(gyroData[gyroDataIndex + 1]),
+        __builtin_bswap16(gyroData[gyroDataIndex + 2]));
+#endif
+
     gyro->dataReady = true;
 
     return BUS_READY;
@@ -144,13 +183,19 @@ static void mpuIntExtiHandler(extiCallbackRec_t *cb)
     if ((gyro->gyroShortPeriod == 0) || (gyroLastPeriod < gyro->gyroShortPeriod)) {
         gyro->gyroSyncEXTI = gyro->gyroLastEXTI + gyro->gyroDmaMaxDuration;
     }
+    gyroUpdateSampleTiming(gyro, nowCycles);
     gyro->gyroLastEXTI = nowCycles;
 
     if (gyro->gyroModeSPI == GYRO_EXTI_INT_DMA) {
         spiSequence(&gyro->dev, gyro->segments);
     }
 
+#ifdef USE_GYRO_FIFO_BURST
+    // In FIFO burst mode each interrupt stands for several samples
+    gyro->detectedEXTI += MAX(gyro->fifoBurst, 1);
+#else
     gyro->detectedEXTI++;
+#endif
 }
 #else
 static void mpuIntExtiHandler(extiCallbackRec_t *cb)
@@ -215,6 +260,39 @@ bool mpuGyroRead(gyroDev_t *gyro)
 
 
 #ifdef USE_SPI_GYRO
+// Consumer side of the accSum seqlock, task context only
+static bool mpuAccReadAverage(accDev_t *acc)
+{
+    const gyroDev_t *gyro = acc->gyro;
+    uint32_t sum[XYZ_AXIS_COUNT];
+    uint32_t count;
+    uint32_t seq;
+
+    do {
+        seq = gyro->accSumSeq;
+        GYRO_QUEUE_BARRIER();
+        sum[X] = gyro->accSum[X];
+        sum[Y] = gyro->accSum[Y];
+        sum[Z] = gyro->accSum[Z];
+        count = gyro->accSumCount;
+        GYRO_QUEUE_BARRIER();
+    } while (seq != gyro->accSumSeq);
+
+    const int32_t samples = count - acc->accSumCountPrev;
+
+    if (samples <= 0) {
+        return false;
+    }
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        acc->ADCRaw[axis] = (int32_t)(sum[axis] - acc->accSumPrev[axis]) / samples;
+        acc->accSumPrev[axis] = sum[axis];
+    }
+    acc->accSumCountPrev = count;
+
+    return true;
+}
+
 bool mpuAccReadSPI(accDev_t *acc)
 {
     switch (acc->gyro->gyroModeSPI) {
@@ -241,10 +319,12 @@ bool mpuAccReadSPI(accDev_t *acc)
 
     case GYRO_EXTI_INT_DMA:
     {
-        // If read was triggered in interrupt don't bother waiting. The worst that could happen is that we pick
-        // up an old value.
+        // Average of the accel samples read together with the gyro since the last call
+        if (acc->gyro->gyroModeSPI == GYRO_EXTI_INT_DMA && mpuAccReadAverage(acc)) {
+            break;
+        }
 
-        // This data was read from the gyro, which is the same SPI device as the acc
+        // Polled read, or no new burst yet, use the latest data. This was read from the gyro, which is the same SPI device as the acc
         int16_t *accData = (int16_t *)acc->gyro->dev.rxBuf;
         acc->ADCRaw[X] = __builtin_bswap16(accData[1]);
         acc->ADCRaw[Y] = __builtin_bswap16(accData[2]);
@@ -282,6 +362,10 @@ bool mpuGyroReadSPI(gyroDev_t *gyro)
                 gyro->segments[0].u.buffers.txData = gyro->dev.txBuf;
                 gyro->segments[0].u.buffers.rxData = &gyro->dev.rxBuf[1];
                 gyro->segments[0].negateCS = true;
+                gyro->hasTemperatureRaw = (gyro->gyroDataReg - gyro->accDataReg == 8);
+#ifdef USE_GYRO_SAMPLE_QUEUE
+                gyroQueueInit(&gyro->queue);
+#endif
                 gyro->gyroModeSPI = GYRO_EXTI_INT_DMA;
             } else {
                 // Interrupts are present, but no DMA
@@ -318,6 +402,15 @@ bool mpuGyroReadSPI(gyroDev_t *gyro)
 
     case GYRO_EXTI_INT_DMA:
     {
+#ifdef USE_GYRO_SAMPLE_QUEUE
+        UNUSED(gyroData);
+
+        // Samples are decoded in the DMA callback. Consume them in order.
+        if (!gyroQueuePop(&gyro->queue, gyro->gyroADCRaw)) {
+            return false;
+        }
+        break;
+#else
         // Acc and gyro data may not be continuous (MPU6xxx has temperature in between)
         const uint8_t gyroDataIndex = ((gyro->gyroDataReg - gyro->accDataReg) >> 1) + 1;
 
@@ -327,12 +420,15 @@ bool mpuGyroReadSPI(gyroDev_t *gyro)
         gyro->gyroADCRaw[Y] = __builtin_bswap16(gyroData[gyroDataIndex + 1]);
         gyro->gyroADCRaw[Z] = __builtin_bswap16(gyroData[gyroDataIndex + 2]);
         break;
+#endif
     }
 
     default:
         break;
     }
 
+    gyro->saturation = gyroSaturationMask(gyro->gyroADCRaw);
+
     return true;
 }
 
@@ -372,6 +468,44 @@ static gyroSpiDetectFn_t gyroSpiDetectFnTable[] = {
     NULL // Avoid an empty array
 };
 
+#ifdef USE_PERSISTENT_OBJECTS
+static uint32_t gyroDetectCacheRead(void)
+{
+    const uint32_t cache = persistentObjectRead(PERSISTENT_OBJECT_GYRO_DETECT);
+
+    return ((cache & GYRO_DETECT_CACHE_MAGIC_MASK) == GYRO_DETECT_CACHE_MAGIC) ? cache : GYRO_DETECT_CACHE_MAGIC;
+}
+
+// Returns the cached detection function index, or -1 if none
+static int gyroDetectCacheGet(int gyroIndex)
+{
+    const int shift = gyroIndex * GYRO_DETECT_CACHE_BITS;
+
+    return (int)((gyroDetectCacheRead() >> shift) & ((1 << GYRO_DETECT_CACHE_BITS) - 1)) - 1;
+}
+
+static void gyroDetectCacheSet(int gyroIndex, int fnIndex)
+{
+    const int shift = gyroIndex * GYRO_DETECT_CACHE_BITS;
+    const uint32_t mask = ((1 << GYRO_DETECT_CACHE_BITS) - 1) << shift;
+    const uint32_t cache = (gyroDetectCacheRead() & ~mask) | (((uint32_t)(fnIndex + 1) << shift) & mask);
+
+    persistentObjectWrite(PERSISTENT_OBJECT_GYRO_DETECT, cache);
+}
+#else
+static int gyroDetectCacheGet(int gyroIndex)
+{
+    UNUSED(gyroIndex);
+    return -1;
+}
+
+static void gyroDetectCacheSet(int gyroIndex, int fnIndex)
+{
+    UNUSED(gyroIndex);
+    UNUSED(fnIndex);
+}
+#endif
+
 static bool detectSPISensorsAndUpdateDetectionResult(gyroDev_t *gyro, const gyroDeviceConfig_t *config)
 {
     if (!config->csnTag || !spiSetBusInstance(&gyro->dev, config->spiBus)) {
@@ -380,6 +514,9 @@ static bool detectSPISensorsAndUpdateDetectionResult(gyroDev_t *gyro, const gyro
 
     gyro->dev.busType_u.spi.csnPin = IOGetByTag(config->csnTag);
 
+    // Gyro reads go ahead of flash, OSD and other transfers on a shared bus
+    gyro->dev.priority = BUS_PRIORITY_HIGH;
+
     IOInit(gyro->dev.busType_u.spi.csnPin, OWNER_GYRO_CS, RESOURCE_INDEX(config->index));
     IOConfigGPIO(gyro->dev.busType_u.spi.csnPin, SPI_IO_CS_CFG);
     IOHi(gyro->dev.busType_u.spi.csnPin); // Ensure device is disabled, important when two devices are on the same bus.
@@ -397,11 +534,31 @@ static bool detectSPISensorsAndUpdateDetectionResult(gyroDev_t *gyro, const gyro
     // as hardware type and detection function name doesn't match.
     // May need a bitmap of hardware to detection function to do it right?
 
+    // On known hardware the cached detection function is tried first,
+    // skipping the probes of all the other devices
+    const int cachedIndex = (config->index < 2) ? gyroDetectCacheGet(config->index) : -1;
+
+    if (cachedIndex >= 0 && cachedIndex < (int)ARRAYLEN(gyroSpiDetectFnTable) - 1) {
+        sensor = (gyroSpiDetectFnTable[cachedIndex])(&gyro->dev);
+        if (sensor != MPU_NONE) {
+            gyro->mpuDetectionResult.sensor = sensor;
+            busDeviceRegister(&gyro->dev);
+            gyroDetectCacheHit = true;
+            return true;
+        }
+    }
+
     for (size_t index = 0 ; gyroSpiDetectFnTable[index] ; index++) {
+        if ((int)index == cachedIndex) {
+            continue;
+        }
         sensor = (gyroSpiDetectFnTable[index])(&gyro->dev);
         if (sensor != MPU_NONE) {
             gyro->mpuDetectionResult.sensor = sensor;
             busDeviceRegister(&gyro->dev);
+            if (config->index < 2) {
+                gyroDetectCacheSet(config->index, index);
+            }
             return true;
         }
     }
@@ -414,6 +571,11 @@ static bool detectSPISensorsAndUpdateDetectionResult(gyroDev_t *gyro, const gyro
 }
 #endif
 
+bool mpuDetectedFromCache(void)
+{
+    return gyroDetectCacheHit;
+}
+
 void mpuPreInit(const struct gyroDeviceConfig_s *config)
 {
 #ifdef USE_SPI_GYRO
@@ -428,8 +590,8 @@ bool mpuDetect(gyroDev_t *gyro, const gyroDeviceConfig_t *config)
     static busDevice_t bus;
     gyro->dev.bus = &bus;
 
-    // MPU datasheet specifies 30ms.
-    delay(35);
+    // Wait for the power on time only once, as measured from boot
+    while (millis() < GYRO_POWER_ON_MS);
 
     if (config->busType == BUS_TYPE_NONE) {
         return false;
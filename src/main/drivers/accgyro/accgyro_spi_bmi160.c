@@ -289,6 +289,7 @@ void bmi160ExtiHandler(extiCallbackRec_t *cb)
     // Ideally we'd use a timer to capture such information, but unfortunately the port used for EXTI interrupt does
     // not have an associated timer
     uint32_t nowCycles = getCycleCounter();
+    gyroUpdateSampleTiming(gyro, nowCycles);
     gyro->gyroSyncEXTI = gyro->gyroLastEXTI + gyro->gyroDmaMaxDuration;
     gyro->gyroLastEXTI = nowCycles;
 
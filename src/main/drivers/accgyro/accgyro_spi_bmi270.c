@@ -217,6 +217,10 @@ static void bmi270Config(gyroDev_t *gyro)
     const bool fifoMode = false;
 #endif
 
+#ifdef USE_GYRO_FIFO_BURST
+    gyro->fifoBurst = (fifoMode && gyroConfig()->gyro_fifo_burst > 1) ? MIN(gyroConfig()->gyro_fifo_burst, GYRO_FIFO_BURST_MAX) : 0;
+#endif
+
     // Perform a soft reset to set all configuration to default
     // Delay 100ms before continuing configuration
     bmi270RegisterWrite(dev, BMI270_REG_CMD, BMI270_VAL_CMD_SOFTRESET, 100);
@@ -228,10 +232,19 @@ static void bmi270Config(gyroDev_t *gyro)
 
     // Configure the FIFO
     if (fifoMode) {
+        uint8_t fifoWatermark = BMI270_VAL_FIFO_WTM_0;
+
+#ifdef USE_GYRO_FIFO_BURST
+        // Interrupt once per fifoBurst samples, read together in bmi270GyroReadFifo()
+        if (gyro->fifoBurst) {
+            fifoWatermark = gyro->fifoBurst * BMI270_FIFO_FRAME_SIZE;
+            gyroQueueInit(&gyro->queue);
+        }
+#endif
         bmi270RegisterWrite(dev, BMI270_REG_FIFO_CONFIG_0, BMI270_VAL_FIFO_CONFIG_0, 1);
         bmi270RegisterWrite(dev, BMI270_REG_FIFO_CONFIG_1, BMI270_VAL_FIFO_CONFIG_1, 1);
         bmi270RegisterWrite(dev, BMI270_REG_FIFO_DOWNS, BMI270_VAL_FIFO_DOWNS, 1);
-        bmi270RegisterWrite(dev, BMI270_REG_FIFO_WTM_0, BMI270_VAL_FIFO_WTM_0, 1);
+        bmi270RegisterWrite(dev, BMI270_REG_FIFO_WTM_0, fifoWatermark, 1);
         bmi270RegisterWrite(dev, BMI270_REG_FIFO_WTM_1, BMI270_VAL_FIFO_WTM_1, 1);
     }
 
@@ -287,6 +300,11 @@ busStatus_e bmi270Intcallback(uint32_t arg)
         gyro->gyroDmaMaxDuration = gyroDmaDuration;
     }
 
+#ifdef USE_GYRO_SAMPLE_QUEUE
+    const int16_t *gyroData = (int16_t *)gyro->dev.rxBuf;
+    gyroQueuePush(&gyro->queue, gyroData[4], gyroData[5], gyroData[6]);
+#endif
+
     gyro->dataReady = true;
 
     return BUS_READY;
@@ -300,6 +318,7 @@ void bmi270ExtiHandler(extiCallbackRec_t *cb)
     // Ideally we'd use a timer to capture such information, but unfortunately the port used for EXTI interrupt does
     // not have an associated timer
     uint32_t nowCycles = getCycleCounter();
+    gyroUpdateSampleTiming(gyro, nowCycles);
     gyro->gyroSyncEXTI = gyro->gyroLastEXTI + gyro->gyroDmaMaxDuration;
     gyro->gyroLastEXTI = nowCycles;
 
@@ -307,7 +326,12 @@ void bmi270ExtiHandler(extiCallbackRec_t *cb)
         spiSequence(dev, gyro->segments);
     }
 
+#ifdef USE_GYRO_FIFO_BURST
+    // In FIFO burst mode each interrupt stands for several samples
+    gyro->detectedEXTI += MAX(gyro->fifoBurst, 1);
+#else
     gyro->detectedEXTI++;
+#endif
 
 }
 
@@ -397,6 +421,9 @@ static bool bmi270GyroReadRegister(gyroDev_t *gyro)
                 gyro->segments[0].u.buffers.txData = dev->txBuf;
                 gyro->segments[0].u.buffers.rxData = dev->rxBuf;
                 gyro->segments[0].negateCS = true;
+#ifdef USE_GYRO_SAMPLE_QUEUE
+                gyroQueueInit(&gyro->queue);
+#endif
                 gyro->gyroModeSPI = GYRO_EXTI_INT_DMA;
             } else {
                 // Interrupts are present, but no DMA
@@ -434,12 +461,17 @@ static bool bmi270GyroReadRegister(gyroDev_t *gyro)
 
     case GYRO_EXTI_INT_DMA:
     {
+#ifdef USE_GYRO_SAMPLE_QUEUE
+        // Samples are decoded in the DMA callback. Consume them in order.
+        return gyroQueuePop(&gyro->queue, gyro->gyroADCRaw);
+#else
         // If read was triggered in interrupt don't bother waiting. The worst that could happen is that we pick
         // up an old value.
         gyro->gyroADCRaw[X] = gyroData[4];
         gyro->gyroADCRaw[Y] = gyroData[5];
         gyro->gyroADCRaw[Z] = gyroData[6];
         break;
+#endif
     }
 
     default:
@@ -450,6 +482,12 @@ static bool bmi270GyroReadRegister(gyroDev_t *gyro)
 }
 
 #ifdef USE_GYRO_DLPF_EXPERIMENTAL
+#ifdef USE_GYRO_FIFO_BURST
+#define BMI270_FIFO_BURST_MAX   GYRO_FIFO_BURST_MAX
+#else
+#define BMI270_FIFO_BURST_MAX   1
+#endif
+
 static bool bmi270GyroReadFifo(gyroDev_t *gyro)
 {
     enum {
@@ -457,73 +495,108 @@ static bool bmi270GyroReadFifo(gyroDev_t *gyro)
         IDX_SKIP,
         IDX_FIFO_LENGTH_L,
         IDX_FIFO_LENGTH_H,
-        IDX_GYRO_XOUT_L,
-        IDX_GYRO_XOUT_H,
-        IDX_GYRO_YOUT_L,
-        IDX_GYRO_YOUT_H,
-        IDX_GYRO_ZOUT_L,
-        IDX_GYRO_ZOUT_H,
-        BUFFER_SIZE,
+        IDX_GYRO_DATA,
+        BUFFER_SIZE = IDX_GYRO_DATA + BMI270_FIFO_BURST_MAX * BMI270_FIFO_FRAME_SIZE,
     };
 
+#ifdef USE_GYRO_FIFO_BURST
+    // Samples left from the previous burst are consumed first
+    if (gyro->fifoBurst && gyroQueuePop(&gyro->queue, gyro->gyroADCRaw)) {
+        return true;
+    }
+
+    const int frames = MAX(gyro->fifoBurst, 1);
+#else
+    const int frames = 1;
+#endif
+
     bool dataRead = false;
     STATIC_DMA_DATA_AUTO uint8_t bmi270_tx_buf[BUFFER_SIZE] = {BMI270_REG_FIFO_LENGTH_LSB | 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0};
     STATIC_DMA_DATA_AUTO uint8_t bmi270_rx_buf[BUFFER_SIZE];
 
-    // Burst read the FIFO length followed by the next 6 bytes containing the gyro axis data for
-    // the first sample in the queue. It's possible for the FIFO to be empty so we need to check the
-    // length before using the sample.
-    spiReadWriteBuf(&gyro->dev, (uint8_t *)bmi270_tx_buf, bmi270_rx_buf, BUFFER_SIZE);   // receive response
+    // Burst read the FIFO length followed by the gyro axis data for up to 'frames' samples
+    // in the queue. It's possible for the FIFO to hold fewer samples so we need to check the
+    // length before using them.
+    spiReadWriteBuf(&gyro->dev, (uint8_t *)bmi270_tx_buf, bmi270_rx_buf, IDX_GYRO_DATA + frames * BMI270_FIFO_FRAME_SIZE);   // receive response
 
     int fifoLength = (uint16_t)((bmi270_rx_buf[IDX_FIFO_LENGTH_H] << 8) | bmi270_rx_buf[IDX_FIFO_LENGTH_L]);
 
-    if (fifoLength >= BMI270_FIFO_FRAME_SIZE) {
+    for (int frame = 0; frame < frames && fifoLength >= BMI270_FIFO_FRAME_SIZE; frame++) {
+        const uint8_t *data = &bmi270_rx_buf[IDX_GYRO_DATA + frame * BMI270_FIFO_FRAME_SIZE];
 
-        const int16_t gyroX = (int16_t)((bmi270_rx_buf[IDX_GYRO_XOUT_H] << 8) | bmi270_rx_buf[IDX_GYRO_XOUT_L]);
-        const int16_t gyroY = (int16_t)((bmi270_rx_buf[IDX_GYRO_YOUT_H] << 8) | bmi270_rx_buf[IDX_GYRO_YOUT_L]);
-        const int16_t gyroZ = (int16_t)((bmi270_rx_buf[IDX_GYRO_ZOUT_H] << 8) | bmi270_rx_buf[IDX_GYRO_ZOUT_L]);
+        const int16_t gyroX = (int16_t)((data[1] << 8) | data[0]);
+        const int16_t gyroY = (int16_t)((data[3] << 8) | data[2]);
+        const int16_t gyroZ = (int16_t)((data[5] << 8) | data[4]);
 
         // If the FIFO data is invalid then the returned values will be 0x8000 (-32768) (pg. 43 of datasheet).
         // This shouldn't happen since we're only using the data if the FIFO length indicates
         // that data is available, but this safeguard is needed to prevent bad things in
         // case it does happen.
         if ((gyroX != INT16_MIN) || (gyroY != INT16_MIN) || (gyroZ != INT16_MIN)) {
-            gyro->gyroADCRaw[X] = gyroX;
-            gyro->gyroADCRaw[Y] = gyroY;
-            gyro->gyroADCRaw[Z] = gyroZ;
+#ifdef USE_GYRO_FIFO_BURST
+            if (gyro->fifoBurst) {
+                gyroQueuePush(&gyro->queue, gyroX, gyroY, gyroZ);
+            } else
+#endif
+            {
+                gyro->gyroADCRaw[X] = gyroX;
+                gyro->gyroADCRaw[Y] = gyroY;
+                gyro->gyroADCRaw[Z] = gyroZ;
+            }
             dataRead = true;
         }
         fifoLength -= BMI270_FIFO_FRAME_SIZE;
     }
 
     // If there are additional samples in the FIFO then we don't use those for now and simply
-    // flush the FIFO. Under normal circumstances we only expect one sample in the FIFO since
+    // flush the FIFO. Under normal circumstances we only expect one burst in the FIFO since
     // the gyro loop is running at the native sample rate of 6.4KHz.
     // However the way the FIFO works in the sensor is that if a frame is partially read then
     // it remains in the queue instead of bein removed. So if we ever got into a state where there
     // was a partial frame or other unexpected data in the FIFO is may never get cleared and we
     // would end up in a lock state of always re-reading the same partial or invalid sample.
+#ifdef USE_GYRO_FIFO_BURST
+    // In burst mode whole frames left behind are read with the next burst
+    if (gyro->fifoBurst) {
+        fifoLength %= BMI270_FIFO_FRAME_SIZE;
+    }
+#endif
+
     if (fifoLength > 0) {
         // Partial or additional frames left - flush the FIFO
         bmi270RegisterWrite(&gyro->dev, BMI270_REG_CMD, BMI270_VAL_CMD_FIFOFLUSH, 0);
     }
 
+#ifdef USE_GYRO_FIFO_BURST
+    if (gyro->fifoBurst) {
+        return gyroQueuePop(&gyro->queue, gyro->gyroADCRaw);
+    }
+#endif
+
     return dataRead;
 }
 #endif
 
 static bool bmi270GyroRead(gyroDev_t *gyro)
 {
+    bool dataRead;
+
 #ifdef USE_GYRO_DLPF_EXPERIMENTAL
     if (gyro->hardware_lpf == GYRO_HARDWARE_LPF_EXPERIMENTAL) {
         // running in 6.4KHz FIFO mode
-        return bmi270GyroReadFifo(gyro);
+        dataRead = bmi270GyroReadFifo(gyro);
     } else
 #endif
     {
         // running in 3.2KHz register mode
-        return bmi270GyroReadRegister(gyro);
+        dataRead = bmi270GyroReadRegister(gyro);
     }
+
+    if (dataRead) {
+        gyro->saturation = gyroSaturationMask(gyro->gyroADCRaw);
+    }
+
+    return dataRead;
 }
 
 static void bmi270SpiGyroInit(gyroDev_t *gyro)
@@ -25,6 +25,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -41,6 +42,7 @@
 #include "drivers/exti.h"
 #include "drivers/io.h"
 #include "drivers/sensor.h"
+#include "drivers/system.h"
 #include "drivers/time.h"
 
 #include "sensors/gyro.h"
@@ -111,6 +113,39 @@
 #define ICM426XX_RA_INT_SOURCE0                     0x65  // User Bank 0
 #define ICM426XX_UI_DRDY_INT1_EN_DISABLED           (0 << 3)
 #define ICM426XX_UI_DRDY_INT1_EN_ENABLED            (1 << 3)
+#define ICM426XX_FIFO_THS_INT1_EN_ENABLED           (1 << 2)
+
+// --- Registers for FIFO burst mode ------------------------
+#define ICM426XX_RA_FIFO_CONFIG                     0x16  // User Bank 0
+#define ICM426XX_FIFO_MODE_STREAM                   (1 << 6)
+
+#define ICM426XX_RA_FIFO_COUNTH                     0x2E  // User Bank 0, followed by FIFO_COUNTL and FIFO_DATA
+
+#define ICM426XX_RA_SIGNAL_PATH_RESET               0x4B  // User Bank 0
+#define ICM426XX_FIFO_FLUSH                         (1 << 1)
+
+#define ICM426XX_RA_INTF_CONFIG0                    0x4C  // User Bank 0
+#define ICM426XX_FIFO_COUNT_REC                     (1 << 6)
+
+#define ICM426XX_RA_FIFO_CONFIG1                    0x5F  // User Bank 0
+#define ICM426XX_FIFO_WM_GT_TH                      (1 << 5)
+#define ICM426XX_FIFO_TEMP_EN                       (1 << 2)
+#define ICM426XX_FIFO_GYRO_EN                       (1 << 1)
+#define ICM426XX_FIFO_ACCEL_EN                      (1 << 0)
+
+#define ICM426XX_RA_FIFO_CONFIG2                    0x60  // User Bank 0, watermark [7:0]
+#define ICM426XX_RA_FIFO_CONFIG3                    0x61  // User Bank 0, watermark [11:8]
+
+// FIFO packet 3: header, accel XYZ, gyro XYZ, temperature, timestamp
+#define ICM426XX_FIFO_PACKET_SIZE                   16
+#define ICM426XX_FIFO_HEADER_EMPTY                  (1 << 7)
+#define ICM426XX_FIFO_HEADER_ACCEL                  (1 << 6)
+#define ICM426XX_FIFO_HEADER_GYRO                   (1 << 5)
+#define ICM426XX_FIFO_COUNT_OFFSET                  1
+#define ICM426XX_FIFO_DATA_OFFSET                   3
+
+#define ICM426XX_EXTI_DETECT_THRESHOLD              100
+// ----------------------------------------------------------
 
 typedef enum {
     ODR_CONFIG_8K = 0,
@@ -195,6 +230,105 @@ void icm426xxAccInit(accDev_t *acc)
     acc->acc_1G = 512 * 4;
 }
 
+#ifdef USE_GYRO_FIFO_BURST
+static inline bool icm426xxFifoBurstActive(const gyroDev_t *gyro)
+{
+    return gyro->fifoBurst && gyro->gyroModeSPI == GYRO_EXTI_INT_DMA;
+}
+
+// In FIFO burst mode the accelerometer sample arrives with the gyro samples
+static bool icm426xxAccReadSPI(accDev_t *acc)
+{
+    if (icm426xxFifoBurstActive(acc->gyro)) {
+        acc->ADCRaw[X] = acc->gyro->queue.acc[X];
+        acc->ADCRaw[Y] = acc->gyro->queue.acc[Y];
+        acc->ADCRaw[Z] = acc->gyro->queue.acc[Z];
+        return true;
+    }
+
+    return mpuAccReadSPI(acc);
+}
+
+// Called in ISR context
+// FIFO burst read has just completed
+static busStatus_e icm426xxFifoCallback(uint32_t arg)
+{
+    gyroDev_t *gyro = (gyroDev_t *)arg;
+    const uint8_t *rxBuf = gyro->dev.rxBuf;
+    int32_t gyroDmaDuration = cmpTimeCycles(getCycleCounter(), gyro->gyroLastEXTI);
+
+    if (gyroDmaDuration > gyro->gyroDmaMaxDuration) {
+        gyro->gyroDmaMaxDuration = gyroDmaDuration;
+    }
+
+    // FIFO count is in records, read in the same transfer before the packets
+    const unsigned fifoCount = (rxBuf[ICM426XX_FIFO_COUNT_OFFSET] << 8) | rxBuf[ICM426XX_FIFO_COUNT_OFFSET + 1];
+    const unsigned count = MIN(fifoCount, gyro->fifoBurst);
+
+    const uint8_t *packet = &rxBuf[ICM426XX_FIFO_DATA_OFFSET];
+
+    for (unsigned i = 0; i < count; i++, packet += ICM426XX_FIFO_PACKET_SIZE) {
+        const uint8_t header = packet[0];
+
+        if ((header & (ICM426XX_FIFO_HEADER_EMPTY | ICM426XX_FIFO_HEADER_ACCEL)) == ICM426XX_FIFO_HEADER_ACCEL) {
+            gyro->queue.acc[X] = (int16_t)((packet[1] << 8) | packet[2]);
+            gyro->queue.acc[Y] = (int16_t)((packet[3] << 8) | packet[4]);
+            gyro->queue.acc[Z] = (int16_t)((packet[5] << 8) | packet[6]);
+        }
+
+        if ((header & (ICM426XX_FIFO_HEADER_EMPTY | ICM426XX_FIFO_HEADER_GYRO)) == ICM426XX_FIFO_HEADER_GYRO) {
+            gyroQueuePush(&gyro->queue,
+                (int16_t)((packet[7] << 8) | packet[8]),
+                (int16_t)((packet[9] << 8) | packet[10]),
+                (int16_t)((packet[11] << 8) | packet[12]));
+        }
+    }
+
+    gyro->dataReady = true;
+
+    return BUS_READY;
+}
+
+static bool icm426xxGyroReadSPI(gyroDev_t *gyro)
+{
+    // Set up a single DMA transfer of the FIFO count and fifoBurst packets per interrupt
+    if (gyro->fifoBurst && gyro->gyroModeSPI == GYRO_EXTI_INIT &&
+        gyro->detectedEXTI > ICM426XX_EXTI_DETECT_THRESHOLD && spiUseDMA(&gyro->dev)) {
+
+        memset(gyro->dev.txBuf, 0xff, GYRO_DEV_BUF_SIZE);
+
+        gyro->gyroDmaMaxDuration = 5;
+        gyro->dev.callbackArg = (uint32_t)gyro;
+        gyro->dev.txBuf[0] = ICM426XX_RA_FIFO_COUNTH | 0x80;
+        gyro->segments[0].len = ICM426XX_FIFO_DATA_OFFSET + gyro->fifoBurst * ICM426XX_FIFO_PACKET_SIZE;
+        gyro->segments[0].callback = icm426xxFifoCallback;
+        gyro->segments[0].u.buffers.txData = gyro->dev.txBuf;
+        gyro->segments[0].u.buffers.rxData = gyro->dev.rxBuf;
+        gyro->segments[0].negateCS = true;
+        gyroQueueInit(&gyro->queue);
+        gyro->gyroModeSPI = GYRO_EXTI_INT_DMA;
+
+        return false;
+    }
+
+    return mpuGyroReadSPI(gyro);
+}
+
+static void icm426xxFifoConfig(const extDevice_t *dev, uint8_t burst)
+{
+    // Count FIFO in records rather than bytes, watermark is then the number of packets
+    const uint8_t intfConfig0Value = spiReadRegMsk(dev, ICM426XX_RA_INTF_CONFIG0);
+    spiWriteReg(dev, ICM426XX_RA_INTF_CONFIG0, intfConfig0Value | ICM426XX_FIFO_COUNT_REC);
+
+    // Interrupt on every sample while above the watermark, so a backlog is drained
+    spiWriteReg(dev, ICM426XX_RA_FIFO_CONFIG1, ICM426XX_FIFO_WM_GT_TH | ICM426XX_FIFO_TEMP_EN | ICM426XX_FIFO_GYRO_EN | ICM426XX_FIFO_ACCEL_EN);
+    spiWriteReg(dev, ICM426XX_RA_FIFO_CONFIG2, burst);
+    spiWriteReg(dev, ICM426XX_RA_FIFO_CONFIG3, 0);
+
+    spiWriteReg(dev, ICM426XX_RA_FIFO_CONFIG, ICM426XX_FIFO_MODE_STREAM);
+}
+#endif
+
 bool icm426xxSpiAccDetect(accDev_t *acc)
 {
     switch (acc->mpuDetectionResult.sensor) {
@@ -207,7 +341,11 @@ bool icm426xxSpiAccDetect(accDev_t *acc)
     }
 
     acc->initFn = icm426xxAccInit;
+#ifdef USE_GYRO_FIFO_BURST
+    acc->readFn = icm426xxAccReadSPI;
+#else
     acc->readFn = mpuAccReadSPI;
+#endif
 
     return true;
 }
@@ -269,7 +407,17 @@ void icm426xxGyroInit(gyroDev_t *gyro)
     spiWriteReg(dev, ICM426XX_RA_INT_CONFIG, ICM426XX_INT1_MODE_PULSED | ICM426XX_INT1_DRIVE_CIRCUIT_PP | ICM426XX_INT1_POLARITY_ACTIVE_HIGH);
     spiWriteReg(dev, ICM426XX_RA_INT_CONFIG0, ICM426XX_UI_DRDY_INT_CLEAR_ON_SBR);
 
-    spiWriteReg(dev, ICM426XX_RA_INT_SOURCE0, ICM426XX_UI_DRDY_INT1_EN_ENABLED);
+#ifdef USE_GYRO_FIFO_BURST
+    gyro->fifoBurst = (gyroConfig()->gyro_fifo_burst > 1) ? MIN(gyroConfig()->gyro_fifo_burst, GYRO_FIFO_BURST_MAX) : 0;
+
+    if (gyro->fifoBurst) {
+        icm426xxFifoConfig(dev, gyro->fifoBurst);
+        spiWriteReg(dev, ICM426XX_RA_INT_SOURCE0, ICM426XX_FIFO_THS_INT1_EN_ENABLED);
+    } else
+#endif
+    {
+        spiWriteReg(dev, ICM426XX_RA_INT_SOURCE0, ICM426XX_UI_DRDY_INT1_EN_ENABLED);
+    }
 
     uint8_t intConfig1Value = spiReadRegMsk(dev, ICM426XX_RA_INT_CONFIG1);
     // Datasheet says: "User should change setting to 0 from default setting of 1, for proper INT1 and INT2 pin operation"
@@ -307,6 +455,13 @@ void icm426xxGyroInit(gyroDev_t *gyro)
     STATIC_ASSERT(INV_FSR_16G == 3, "INV_FSR_16G must be 3 to generate correct value");
     spiWriteReg(dev, ICM426XX_RA_ACCEL_CONFIG0, (3 - INV_FSR_16G) << 5 | (odrConfig & 0x0F));
     delay(15);
+
+#ifdef USE_GYRO_FIFO_BURST
+    // Discard samples collected while configuring
+    if (gyro->fifoBurst) {
+        spiWriteReg(dev, ICM426XX_RA_SIGNAL_PATH_RESET, ICM426XX_FIFO_FLUSH);
+    }
+#endif
 }
 
 bool icm426xxSpiGyroDetect(gyroDev_t *gyro)
@@ -321,7 +476,11 @@ bool icm426xxSpiGyroDetect(gyroDev_t *gyro)
     }
 
     gyro->initFn = icm426xxGyroInit;
+#ifdef USE_GYRO_FIFO_BURST
+    gyro->readFn = icm426xxGyroReadSPI;
+#else
     gyro->readFn = mpuGyroReadSPI;
+#endif
 
     gyro->scale = GYRO_SCALE_2000DPS;
 
@@ -0,0 +1,109 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/axis.h"
+
+/*
+ * Single-producer/single-consumer queue of raw gyro samples.
+ *
+ * The producer is the SPI DMA completion callback (ISR context), the consumer
+ * is the gyro task. Only the producer writes head and only the consumer writes
+ * tail, so no locking is required. A full queue drops the new sample and
+ * counts an overrun, keeping the queued samples in order.
+ */
+
+#define GYRO_QUEUE_SIZE     8       // must be a power of two
+#define GYRO_QUEUE_MASK     (GYRO_QUEUE_SIZE - 1)
+
+// Maximum number of samples read from the sensor FIFO per interrupt
+#define GYRO_FIFO_BURST_MAX     4
+// Largest FIFO record read in burst mode (ICM426xx packet 3)
+#define GYRO_FIFO_PACKET_MAX    16
+// SPI buffer size per direction, a full burst plus register/count bytes, kept cache line aligned
+#define GYRO_DEV_BUF_SIZE       (GYRO_FIFO_BURST_MAX * GYRO_FIFO_PACKET_MAX + 32)
+
+typedef struct {
+    volatile uint8_t head;
+    volatile uint8_t tail;
+    bool active;
+    uint32_t overruns;
+    int16_t sample[GYRO_QUEUE_SIZE][XYZ_AXIS_COUNT];
+    int16_t acc[XYZ_AXIS_COUNT];   // latest accelerometer sample from a FIFO burst
+} gyroSampleQueue_t;
+
+#define GYRO_QUEUE_BARRIER()    __asm__ volatile ("" ::: "memory")
+
+// Start queueing. The gyro task then consumes samples only from the queue.
+static inline void gyroQueueInit(gyroSampleQueue_t *queue)
+{
+    queue->head = 0;
+    queue->tail = 0;
+    queue->overruns = 0;
+    queue->active = true;
+}
+
+static inline unsigned gyroQueueCount(const gyroSampleQueue_t *queue)
+{
+    return (uint8_t)(queue->head - queue->tail);
+}
+
+// Called from ISR context only
+static inline void gyroQueuePush(gyroSampleQueue_t *queue, int16_t x, int16_t y, int16_t z)
+{
+    const uint8_t head = queue->head;
+
+    if ((uint8_t)(head - queue->tail) >= GYRO_QUEUE_SIZE) {
+        queue->overruns++;
+        return;
+    }
+
+    int16_t *sample = queue->sample[head & GYRO_QUEUE_MASK];
+    sample[X] = x;
+    sample[Y] = y;
+    sample[Z] = z;
+
+    // Sample must be visible before the index is published
+    GYRO_QUEUE_BARRIER();
+    queue->head = head + 1;
+}
+
+// Called from the gyro task only
+static inline bool gyroQueuePop(gyroSampleQueue_t *queue, int16_t *data)
+{
+    const uint8_t tail = queue->tail;
+
+    if (tail == queue->head) {
+        return false;
+    }
+
+    GYRO_QUEUE_BARRIER();
+
+    const int16_t *sample = queue->sample[tail & GYRO_QUEUE_MASK];
+    data[X] = sample[X];
+    data[Y] = sample[Y];
+    data[Z] = sample[Z];
+
+    GYRO_QUEUE_BARRIER();
+    queue->tail = tail + 1;
+
+    return true;
+}
@@ -43,6 +43,10 @@
 #define ADC_TAG_MAP_COUNT 10
 #endif
 
+// Conversions averaged into each ADC result. G4 and H7 use the hardware
+// oversampler, F4 and F7 average the scans held in the circular DMA buffer.
+#define ADC_OVERSAMPLE_COUNT 16
+
 typedef struct adcTagMap_s {
     ioTag_t tag;
     uint8_t devices;
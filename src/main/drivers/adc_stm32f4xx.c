@@ -129,6 +129,10 @@ const adcTagMap_t adcTagMap[] = {
 #define TS_CAL1_ADDR      0x1FFF7A2C
 #define TS_CAL2_ADDR      0x1FFF7A2E
 
+// Circular DMA buffer holding ADC_OVERSAMPLE_COUNT scans
+static volatile uint16_t adcConversionBuffer[ADC_CHANNEL_COUNT * ADC_OVERSAMPLE_COUNT];
+static uint8_t adcScanLength;
+
 void adcInitDevice(ADC_TypeDef *adcdev, int channelCount)
 {
     ADC_InitTypeDef ADC_InitStructure;
@@ -335,11 +339,13 @@ void adcInit(const adcConfig_t *config)
     DMA_InitStructure.DMA_Channel = adc.channel;
 #endif
 
-    DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)adcValues;
+    adcScanLength = configuredAdcChannels;
+
+    DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)adcConversionBuffer;
     DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralToMemory;
-    DMA_InitStructure.DMA_BufferSize = configuredAdcChannels;
+    DMA_InitStructure.DMA_BufferSize = configuredAdcChannels * ADC_OVERSAMPLE_COUNT;
     DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
-    DMA_InitStructure.DMA_MemoryInc = configuredAdcChannels > 1 ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
     DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
     DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
     DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
@@ -358,6 +364,18 @@ void adcInit(const adcConfig_t *config)
 
 void adcGetChannelValues(void)
 {
-    // Nothing to do
+    // Average the scans in the DMA buffer into adcValues[]
+    for (unsigned i = 0; i < ADC_CHANNEL_COUNT; i++) {
+        if (adcOperatingConfig[i].enabled) {
+            const unsigned index = adcOperatingConfig[i].dmaIndex;
+            uint32_t sum = 0;
+
+            for (unsigned scan = 0; scan < ADC_OVERSAMPLE_COUNT; scan++) {
+                sum += adcConversionBuffer[scan * adcScanLength + index];
+            }
+
+            adcValues[index] = sum / ADC_OVERSAMPLE_COUNT;
+        }
+    }
 }
 #endif
@@ -95,6 +95,10 @@ const adcTagMap_t adcTagMap[] = {
     { DEFIO_TAG_E__PA7, ADC_DEVICES_12,  ADC_CHANNEL_7  },
 };
 
+// Circular DMA buffer holding ADC_OVERSAMPLE_COUNT scans
+static volatile FAST_DATA_ZERO_INIT uint16_t adcConversionBuffer[ADC_CHANNEL_COUNT * ADC_OVERSAMPLE_COUNT];
+static uint8_t adcScanLength;
+
 void adcInitDevice(adcDevice_t *adcdev, int channelCount)
 {
     adcdev->ADCHandle.Init.ClockPrescaler        = ADC_CLOCK_SYNC_PCLK_DIV8;
@@ -309,7 +313,7 @@ void adcInit(const adcConfig_t *config)
 
     adc.DmaHandle.Init.Direction = DMA_PERIPH_TO_MEMORY;
     adc.DmaHandle.Init.PeriphInc = DMA_PINC_DISABLE;
-    adc.DmaHandle.Init.MemInc = configuredAdcChannels > 1 ? DMA_MINC_ENABLE : DMA_MINC_DISABLE;
+    adc.DmaHandle.Init.MemInc = DMA_MINC_ENABLE;
     adc.DmaHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
     adc.DmaHandle.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
     adc.DmaHandle.Init.Mode = DMA_CIRCULAR;
@@ -327,9 +331,9 @@ void adcInit(const adcConfig_t *config)
 
     __HAL_LINKDMA(&adc.ADCHandle, DMA_Handle, adc.DmaHandle);
 
-    //HAL_CLEANINVALIDATECACHE((uint32_t*)&adcValues, configuredAdcChannels);
+    adcScanLength = configuredAdcChannels;
 
-    if (HAL_ADC_Start_DMA(&adc.ADCHandle, (uint32_t*)&adcValues, configuredAdcChannels) != HAL_OK)
+    if (HAL_ADC_Start_DMA(&adc.ADCHandle, (uint32_t*)adcConversionBuffer, configuredAdcChannels * ADC_OVERSAMPLE_COUNT) != HAL_OK)
     {
         /* Start Conversion Error */
     }
@@ -337,6 +341,18 @@ void adcInit(const adcConfig_t *config)
 
 void adcGetChannelValues(void)
 {
-    // Nothing to do
+    // Average the scans in the DMA buffer into adcValues[]
+    for (unsigned i = 0; i < ADC_CHANNEL_COUNT; i++) {
+        if (adcOperatingConfig[i].enabled) {
+            const unsigned index = adcOperatingConfig[i].dmaIndex;
+            uint32_t sum = 0;
+
+            for (unsigned scan = 0; scan < ADC_OVERSAMPLE_COUNT; scan++) {
+                sum += adcConversionBuffer[scan * adcScanLength + index];
+            }
+
+            adcValues[index] = sum / ADC_OVERSAMPLE_COUNT;
+        }
+    }
 }
 #endif
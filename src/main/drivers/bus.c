@@ -165,6 +165,35 @@ bool busReadRegisterBufferStart(const extDevice_t *dev, uint8_t reg, uint8_t *da
     }
 }
 
+// Start the read, calling back on completion. On I2C the callback runs from the bus interrupt.
+bool busReadRegisterBufferCallback(const extDevice_t *dev, uint8_t reg, uint8_t *data, uint8_t length, busStatus_e (*callback)(uint32_t arg))
+{
+#if !defined(USE_SPI) && !defined(USE_I2C)
+    UNUSED(reg);
+    UNUSED(data);
+    UNUSED(length);
+    UNUSED(callback);
+#endif
+    switch (dev->bus->busType) {
+#ifdef USE_SPI
+    case BUS_TYPE_SPI:
+        // SPI reads complete before returning
+        do {
+            if (!spiReadRegMskBufRB(dev, reg | 0x80, data, length)) {
+                return false;
+            }
+        } while (callback && callback(dev->callbackArg) == BUS_BUSY);
+        return true;
+#endif
+#ifdef USE_I2C
+    case BUS_TYPE_I2C:
+        return i2cBusReadRegisterBufferCallback(dev, reg, data, length, callback);
+#endif
+    default:
+        return false;
+    }
+}
+
 // Returns true if bus is still busy
 bool busBusy(const extDevice_t *dev, bool *error)
 {
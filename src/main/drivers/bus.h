@@ -42,6 +42,12 @@ typedef enum {
     BUS_ABORT
 } busStatus_e;
 
+// Order in which queued transfers on a shared bus are run
+typedef enum {
+    BUS_PRIORITY_NORMAL = 0,
+    BUS_PRIORITY_HIGH,      // Runs ahead of queued transfers, and preempts others between segments
+} busPriority_e;
+
 
 // Bus interface, independent of connected device
 typedef struct busDevice_s {
@@ -109,6 +115,8 @@ typedef struct extDevice_s {
     uint8_t *txBuf, *rxBuf;
     // Connected devices on the same bus may support different speeds
     uint32_t callbackArg;
+    // Scheduling of transfers against other devices on the bus
+    busPriority_e priority;
 } extDevice_t;
 
 /* Each SPI access may comprise multiple parts, for example, wait/write enable/write/data each of which
@@ -152,6 +160,7 @@ bool busWriteRegisterStart(const extDevice_t *dev, uint8_t reg, uint8_t data);
 // Read routines where the register is ORed with 0x80
 bool busReadRegisterBuffer(const extDevice_t *dev, uint8_t reg, uint8_t *data, uint8_t length);
 bool busReadRegisterBufferStart(const extDevice_t *dev, uint8_t reg, uint8_t *data, uint8_t length);
+bool busReadRegisterBufferCallback(const extDevice_t *dev, uint8_t reg, uint8_t *data, uint8_t length, busStatus_e (*callback)(uint32_t arg));
 uint8_t busReadRegister(const extDevice_t *dev, uint8_t reg);
 
 bool busBusy(const extDevice_t *dev, bool *error);
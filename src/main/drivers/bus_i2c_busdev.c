@@ -26,11 +26,164 @@
 
 #if defined(USE_I2C)
 
+#include "common/utils.h"
+
 #include "drivers/bus.h"
 #include "drivers/bus_i2c.h"
 
+#include "drivers/bus_i2c_impl.h"
+
 static uint8_t i2cRegisteredDeviceCount = 0;
 
+/*
+ * Non-blocking accesses are queued per bus, and started back to back from
+ * the transfer complete interrupt. Each may have a callback, which is run
+ * from the interrupt with the device callbackArg once the transfer is done.
+ * The callback may queue further accesses, to chain a sequence of reads
+ * without returning to the task in between.
+ */
+
+#define I2C_QUEUE_LENGTH    8
+
+typedef struct i2cTransaction_s {
+    const extDevice_t *dev;
+    uint8_t *data;
+    busStatus_e (*callback)(uint32_t arg);
+    uint8_t reg;
+    uint8_t len;
+    uint8_t byte;       // Data for single register writes
+    bool read;
+} i2cTransaction_t;
+
+typedef struct i2cQueue_s {
+    i2cTransaction_t transaction[I2C_QUEUE_LENGTH];
+    volatile uint8_t head;
+    volatile uint8_t tail;
+    volatile bool active;
+} i2cQueue_t;
+
+static i2cQueue_t i2cQueue[I2CDEV_COUNT];
+
+#define I2C_QUEUE_NEXT(x)   (((x) + 1) % I2C_QUEUE_LENGTH)
+
+// Keep the bus interrupts out while the queue is modified
+static void i2cQueueLock(I2CDevice device)
+{
+    NVIC_DisableIRQ(i2cDevice[device].hardware->ev_irq);
+    NVIC_DisableIRQ(i2cDevice[device].hardware->er_irq);
+}
+
+static void i2cQueueUnlock(I2CDevice device)
+{
+    NVIC_EnableIRQ(i2cDevice[device].hardware->er_irq);
+    NVIC_EnableIRQ(i2cDevice[device].hardware->ev_irq);
+}
+
+// Start the transaction at the head of the queue, if the bus is free
+static void i2cQueueStart(I2CDevice device)
+{
+    i2cQueue_t *queue = &i2cQueue[device];
+
+    while (!queue->active && queue->head != queue->tail && !i2cBusy(device, NULL)) {
+        i2cTransaction_t *txn = &queue->transaction[queue->head];
+        const uint8_t addr = txn->dev->busType_u.i2c.address;
+
+        if (txn->read)
+            queue->active = i2cReadBuffer(device, addr, txn->reg, txn->len, txn->data);
+        else
+            queue->active = i2cWriteBuffer(device, addr, txn->reg, txn->len, txn->data);
+
+        if (!queue->active) {
+            // The hardware has failed, drop the transaction
+            queue->head = I2C_QUEUE_NEXT(queue->head);
+        }
+    }
+}
+
+// Called from the driver interrupts when a non-blocking transfer has finished
+void i2cTransferComplete(I2CDevice device)
+{
+    i2cQueue_t *queue = &i2cQueue[device];
+
+    // The transfer was not queued, but others may be waiting for it
+    if (!queue->active) {
+        i2cQueueStart(device);
+        return;
+    }
+
+    i2cTransaction_t *txn = &queue->transaction[queue->head];
+    busStatus_e status = BUS_READY;
+
+    // Any accesses queued by the callback go behind this one
+    if (txn->callback) {
+        status = txn->callback(txn->dev->callbackArg);
+    }
+
+    switch (status) {
+    case BUS_BUSY:
+        // Repeat the transaction
+        break;
+
+    case BUS_ABORT:
+        // No further callbacks for the rest of this device's accesses
+        for (uint8_t i = I2C_QUEUE_NEXT(queue->head); i != queue->tail; i = I2C_QUEUE_NEXT(i)) {
+            if (queue->transaction[i].dev == txn->dev)
+                queue->transaction[i].callback = NULL;
+        }
+        FALLTHROUGH;
+
+    case BUS_READY:
+    default:
+        queue->head = I2C_QUEUE_NEXT(queue->head);
+        break;
+    }
+
+    queue->active = false;
+
+    i2cQueueStart(device);
+}
+
+static bool i2cBusQueueTransfer(const extDevice_t *dev, bool read, uint8_t reg, uint8_t *data, uint8_t length, busStatus_e (*callback)(uint32_t arg))
+{
+    const I2CDevice device = dev->bus->busType_u.i2c.device;
+
+    if (device == I2CINVALID || device >= I2CDEV_COUNT || !i2cDevice[device].hardware) {
+        return false;
+    }
+
+    i2cQueue_t *queue = &i2cQueue[device];
+    bool queued = false;
+
+    i2cQueueLock(device);
+
+    if (I2C_QUEUE_NEXT(queue->tail) != queue->head) {
+        i2cTransaction_t *txn = &queue->transaction[queue->tail];
+
+        txn->dev = dev;
+        txn->read = read;
+        txn->reg = reg;
+        txn->len = length;
+        txn->callback = callback;
+
+        if (!read && length == 1) {
+            // Need a copy of the value, not on the stack
+            txn->byte = *data;
+            txn->data = &txn->byte;
+        } else {
+            txn->data = data;
+        }
+
+        queue->tail = I2C_QUEUE_NEXT(queue->tail);
+        queued = true;
+
+        i2cQueueStart(device);
+    }
+
+    i2cQueueUnlock(device);
+
+    return queued;
+}
+
 bool i2cBusWriteRegister(const extDevice_t *dev, uint8_t reg, uint8_t data)
 {
     return i2cWrite(dev->bus->busType_u.i2c.device, dev->busType_u.i2c.address, reg, data);
@@ -38,12 +191,7 @@ bool i2cBusWriteRegister(const extDevice_t *dev, uint8_t reg, uint8_t data)
 
 bool i2cBusWriteRegisterStart(const extDevice_t *dev, uint8_t reg, uint8_t data)
 {
-    // Need a static value, not on the stack
-    static uint8_t byte;
-
-    byte = data;
-
-    return i2cWriteBuffer(dev->bus->busType_u.i2c.device, dev->busType_u.i2c.address, reg, sizeof(byte), &byte);
+    return i2cBusQueueTransfer(dev, false, reg, &data, sizeof(data), NULL);
 }
 
 bool i2cBusReadRegisterBuffer(const extDevice_t *dev, uint8_t reg, uint8_t *data, uint8_t length)
@@ -60,12 +208,45 @@ uint8_t i2cBusReadRegister(const extDevice_t *dev, uint8_t reg)
 
 bool i2cBusReadRegisterBufferStart(const extDevice_t *dev, uint8_t reg, uint8_t *data, uint8_t length)
 {
-    return i2cReadBuffer(dev->bus->busType_u.i2c.device, dev->busType_u.i2c.address, reg, length, data);
+    return i2cBusQueueTransfer(dev, true, reg, data, length, NULL);
+}
+
+bool i2cBusReadRegisterBufferCallback(const extDevice_t *dev, uint8_t reg, uint8_t *data, uint8_t length, busStatus_e (*callback)(uint32_t arg))
+{
+    return i2cBusQueueTransfer(dev, true, reg, data, length, callback);
 }
 
+// Returns true while the device has queued accesses
 bool i2cBusBusy(const extDevice_t *dev, bool *error)
 {
-    return i2cBusy(dev->bus->busType_u.i2c.device, error);
+    const I2CDevice device = dev->bus->busType_u.i2c.device;
+
+    if (device == I2CINVALID || device >= I2CDEV_COUNT || !i2cDevice[device].hardware) {
+        return false;
+    }
+
+    i2cQueue_t *queue = &i2cQueue[device];
+    bool busy = false;
+
+    i2cQueueLock(device);
+
+    // Restart the queue if a transfer could not be started before
+    i2cQueueStart(device);
+
+    for (uint8_t i = queue->head; i != queue->tail; i = I2C_QUEUE_NEXT(i)) {
+        if (queue->transaction[i].dev == dev) {
+            busy = true;
+            break;
+        }
+    }
+
+    i2cQueueUnlock(device);
+
+    if (error) {
+        i2cBusy(device, error);
+    }
+
+    return busy;
 }
 
 bool i2cBusSetInstance(extDevice_t *dev, uint32_t device)
@@ -25,6 +25,7 @@ bool i2cBusWriteRegisterStart(const extDevice_t *dev, uint8_t reg, uint8_t data)
 bool i2cBusReadRegisterBuffer(const extDevice_t *dev, uint8_t reg, uint8_t *data, uint8_t length);
 uint8_t i2cBusReadRegister(const extDevice_t *dev, uint8_t reg);
 bool i2cBusReadRegisterBufferStart(const extDevice_t *dev, uint8_t reg, uint8_t *data, uint8_t length);
+bool i2cBusReadRegisterBufferCallback(const extDevice_t *dev, uint8_t reg, uint8_t *data, uint8_t length, busStatus_e (*callback)(uint32_t arg));
 bool i2cBusBusy(const extDevice_t *dev, bool *error);
 // Associate a device with an I2C bus
 bool i2cBusSetInstance(const extDevice_t *dev, uint32_t device);
@@ -85,6 +85,32 @@ void I2C4_EV_IRQHandler(void)
 
 static volatile uint16_t i2cErrorCount = 0;
 
+// Non-blocking transfers finish in the HAL interrupt handlers
+static void i2cTransferCallback(I2C_HandleTypeDef *pHandle)
+{
+    for (I2CDevice device = I2CDEV_1; device < I2CDEV_COUNT; device++) {
+        if (&i2cDevice[device].handle == pHandle) {
+            i2cTransferComplete(device);
+            return;
+        }
+    }
+}
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    i2cTransferCallback(hi2c);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    i2cTransferCallback(hi2c);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    i2cTransferCallback(hi2c);
+}
+
 static bool i2cHandleHardwareFailure(I2CDevice device)
 {
     (void)device;
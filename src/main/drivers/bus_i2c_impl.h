@@ -91,3 +91,5 @@ typedef struct i2cDevice_s {
 } i2cDevice_t;
 
 extern i2cDevice_t i2cDevice[];
+
+void i2cTransferComplete(I2CDevice device);
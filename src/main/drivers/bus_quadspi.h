@@ -121,6 +121,11 @@ bool quadSpiTransmitWithAddress4LINES(QUADSPI_TypeDef *instance, uint8_t instruc
 
 bool quadSpiInstructionWithAddress1LINE(QUADSPI_TypeDef *instance, uint8_t instruction, uint8_t dummyCycles, uint32_t address, uint8_t addressSize);
 
+bool quadSpiEnableMemoryMapped4LINES(QUADSPI_TypeDef *instance, uint8_t instruction, uint8_t dummyCycles, uint8_t addressSize);
+void quadSpiDisableMemoryMapped(QUADSPI_TypeDef *instance);
+bool quadSpiIsMemoryMapped(QUADSPI_TypeDef *instance);
+void quadSpiReadMemoryMapped(QUADSPI_TypeDef *instance, uint32_t address, uint8_t *in, int length);
+
 //bool quadSpiIsBusBusy(SPI_TypeDef *instance);
 
 uint16_t quadSpiGetErrorCounter(QUADSPI_TypeDef *instance);
@@ -22,6 +22,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -204,11 +205,123 @@ void quadSpiDeselectDevice(QUADSPI_TypeDef *instance)
 
 
 
+/*
+ * Memory mapped mode
+ *
+ * The controller issues the read command by itself on an access to the
+ * QSPI window, so that the flash is read through the bus matrix with no
+ * command overhead. Needs the chip select driven by the controller. Any
+ * indirect transfer leaves the mode first, which also keeps a program or
+ * erase from running while mapped.
+ */
+static void quadSpiLeaveMemoryMapped(QUADSPIDevice device)
+{
+    quadSpiDevice_t *quadSpi = &quadSpiDevice[device];
+
+    if (quadSpi->memoryMapped) {
+        HAL_QSPI_Abort(&quadSpi->hquadSpi);
+        quadSpi->memoryMapped = false;
+    }
+}
+
+bool quadSpiEnableMemoryMapped4LINES(QUADSPI_TypeDef *instance, uint8_t instruction, uint8_t dummyCycles, uint8_t addressSize)
+{
+    QUADSPIDevice device = quadSpiDeviceByInstance(instance);
+    quadSpiDevice_t *quadSpi = &quadSpiDevice[device];
+
+    if (quadSpi->memoryMapped) {
+        return true;
+    }
+
+    const uint8_t csFlags = quadSpiConfig(device)->csFlags;
+
+    switch (quadSpiConfig(device)->mode) {
+    case QUADSPI_MODE_BK1_ONLY:
+        if ((csFlags & QUADSPI_BK1_CS_MASK) != QUADSPI_BK1_CS_HARDWARE) {
+            return false;
+        }
+        break;
+    case QUADSPI_MODE_BK2_ONLY:
+        if ((csFlags & QUADSPI_BK2_CS_MASK) != QUADSPI_BK2_CS_HARDWARE) {
+            return false;
+        }
+        break;
+    default:
+        // Dual flash interleaves the address space
+        return false;
+    }
+
+    QSPI_CommandTypeDef cmd;
+    cmd.InstructionMode   = QSPI_INSTRUCTION_1_LINE;
+    cmd.AddressMode       = QSPI_ADDRESS_1_LINE;
+    cmd.AlternateByteMode = QSPI_ALTERNATE_BYTES_NONE;
+    cmd.DataMode          = QSPI_DATA_4_LINES;
+    cmd.DummyCycles       = dummyCycles;
+    cmd.DdrMode           = QSPI_DDR_MODE_DISABLE;
+    cmd.DdrHoldHalfCycle  = QSPI_DDR_HHC_ANALOG_DELAY;
+    cmd.SIOOMode          = QSPI_SIOO_INST_EVERY_CMD;
+
+    cmd.Instruction       = instruction;
+    cmd.AddressSize       = quadSpi_addressSizeFromValue(addressSize);
+
+    QSPI_MemoryMappedTypeDef mapping;
+    // Release the chip select when the bus has been idle for a while
+    mapping.TimeOutActivation = QSPI_TIMEOUT_COUNTER_ENABLE;
+    mapping.TimeOutPeriod     = 64;
+
+    if (HAL_QSPI_MemoryMapped(&quadSpi->hquadSpi, &cmd, &mapping) != HAL_OK) {
+        quadSpiTimeoutUserCallback(instance);
+        return false;
+    }
+
+    quadSpi->memoryMapped = true;
+
+    return true;
+}
+
+void quadSpiDisableMemoryMapped(QUADSPI_TypeDef *instance)
+{
+    quadSpiLeaveMemoryMapped(quadSpiDeviceByInstance(instance));
+}
+
+bool quadSpiIsMemoryMapped(QUADSPI_TypeDef *instance)
+{
+    return quadSpiDevice[quadSpiDeviceByInstance(instance)].memoryMapped;
+}
+
+// The QSPI window is strongly ordered, so the reads have to be aligned
+void quadSpiReadMemoryMapped(QUADSPI_TypeDef *instance, uint32_t address, uint8_t *in, int length)
+{
+    UNUSED(instance);
+
+    const volatile uint8_t *src = (const volatile uint8_t *)(QSPI_BASE + address);
+
+    while (length > 0 && ((uintptr_t)src & 3)) {
+        *in++ = *src++;
+        length--;
+    }
+
+    while (length >= 4) {
+        const uint32_t word = *(const volatile uint32_t *)src;
+        memcpy(in, &word, sizeof(word));
+        src += 4;
+        in += 4;
+        length -= 4;
+    }
+
+    while (length > 0) {
+        *in++ = *src++;
+        length--;
+    }
+}
+
 bool quadSpiTransmit1LINE(QUADSPI_TypeDef *instance, uint8_t instruction, uint8_t dummyCycles, const uint8_t *out, int length)
 {
     QUADSPIDevice device = quadSpiDeviceByInstance(instance);
     HAL_StatusTypeDef status;
 
+    quadSpiLeaveMemoryMapped(device);
+
 
     QSPI_CommandTypeDef cmd;
     cmd.InstructionMode   = QSPI_INSTRUCTION_1_LINE;
@@ -253,6 +366,8 @@ bool quadSpiReceive1LINE(QUADSPI_TypeDef *instance, uint8_t instruction, uint8_t
     QUADSPIDevice device = quadSpiDeviceByInstance(instance);
     HAL_StatusTypeDef status;
 
+    quadSpiLeaveMemoryMapped(device);
+
     QSPI_CommandTypeDef cmd;
     cmd.InstructionMode   = QSPI_INSTRUCTION_1_LINE;
     cmd.AddressMode       = QSPI_ADDRESS_NONE;
@@ -291,6 +406,8 @@ bool quadSpiReceive4LINES(QUADSPI_TypeDef *instance, uint8_t instruction, uint8_
     QUADSPIDevice device = quadSpiDeviceByInstance(instance);
     HAL_StatusTypeDef status;
 
+    quadSpiLeaveMemoryMapped(device);
+
     QSPI_CommandTypeDef cmd;
     cmd.InstructionMode   = QSPI_INSTRUCTION_4_LINES;
     cmd.AddressMode       = QSPI_ADDRESS_NONE;
@@ -329,6 +446,8 @@ bool quadSpiReceiveWithAddress1LINE(QUADSPI_TypeDef *instance, uint8_t instructi
     QUADSPIDevice device = quadSpiDeviceByInstance(instance);
     HAL_StatusTypeDef status;
 
+    quadSpiLeaveMemoryMapped(device);
+
     QSPI_CommandTypeDef cmd;
     cmd.InstructionMode   = QSPI_INSTRUCTION_1_LINE;
     cmd.AddressMode       = QSPI_ADDRESS_1_LINE;
@@ -369,6 +488,8 @@ bool quadSpiReceiveWithAddress4LINES(QUADSPI_TypeDef *instance, uint8_t instruct
     QUADSPIDevice device = quadSpiDeviceByInstance(instance);
     HAL_StatusTypeDef status;
 
+    quadSpiLeaveMemoryMapped(device);
+
     QSPI_CommandTypeDef cmd;
     cmd.InstructionMode   = QSPI_INSTRUCTION_1_LINE;
     cmd.AddressMode       = QSPI_ADDRESS_1_LINE;
@@ -407,6 +528,8 @@ bool quadSpiTransmitWithAddress1LINE(QUADSPI_TypeDef *instance, uint8_t instruct
     QUADSPIDevice device = quadSpiDeviceByInstance(instance);
     HAL_StatusTypeDef status;
 
+    quadSpiLeaveMemoryMapped(device);
+
     QSPI_CommandTypeDef cmd;
     cmd.InstructionMode   = QSPI_INSTRUCTION_1_LINE;
     cmd.AddressMode       = QSPI_ADDRESS_1_LINE;
@@ -447,6 +570,8 @@ bool quadSpiTransmitWithAddress4LINES(QUADSPI_TypeDef *instance, uint8_t instruc
     QUADSPIDevice device = quadSpiDeviceByInstance(instance);
     HAL_StatusTypeDef status;
 
+    quadSpiLeaveMemoryMapped(device);
+
     QSPI_CommandTypeDef cmd;
     cmd.InstructionMode   = QSPI_INSTRUCTION_1_LINE;
     cmd.AddressMode       = QSPI_ADDRESS_1_LINE;
@@ -487,6 +612,8 @@ bool quadSpiInstructionWithAddress1LINE(QUADSPI_TypeDef *instance, uint8_t instr
     QUADSPIDevice device = quadSpiDeviceByInstance(instance);
     HAL_StatusTypeDef status;
 
+    quadSpiLeaveMemoryMapped(device);
+
     QSPI_CommandTypeDef cmd;
     cmd.InstructionMode   = QSPI_INSTRUCTION_1_LINE;
     cmd.AddressMode       = QSPI_ADDRESS_1_LINE;
@@ -523,6 +650,8 @@ bool quadSpiInstructionWithData1LINE(QUADSPI_TypeDef *instance, uint8_t instruct
     QUADSPIDevice device = quadSpiDeviceByInstance(instance);
     HAL_StatusTypeDef status;
 
+    quadSpiLeaveMemoryMapped(device);
+
     QSPI_CommandTypeDef cmd;
     cmd.InstructionMode   = QSPI_INSTRUCTION_1_LINE;
     cmd.AddressMode       = QSPI_ADDRESS_NONE;
@@ -559,6 +688,9 @@ bool quadSpiInstructionWithData1LINE(QUADSPI_TypeDef *instance, uint8_t instruct
 void quadSpiSetDivisor(QUADSPI_TypeDef *instance, uint16_t divisor)
 {
     QUADSPIDevice device = quadSpiDeviceByInstance(instance);
+
+    quadSpiLeaveMemoryMapped(device);
+
     if (HAL_QSPI_DeInit(&quadSpiDevice[device].hquadSpi) != HAL_OK)
     {
         Error_Handler();
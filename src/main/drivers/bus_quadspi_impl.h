@@ -81,6 +81,7 @@ typedef struct QUADSPIDevice_s {
 #endif
     rccPeriphTag_t rcc;
     volatile uint16_t errorCount;
+    bool memoryMapped;
 #if defined(USE_HAL_DRIVER)
     QSPI_HandleTypeDef hquadSpi;
 #endif
@@ -31,6 +31,7 @@
 #include "drivers/bus.h"
 #include "drivers/bus_spi.h"
 #include "drivers/bus_spi_impl.h"
+#include "drivers/dma.h"
 #include "drivers/dma_reqmap.h"
 #include "drivers/exti.h"
 #include "drivers/io.h"
@@ -424,6 +425,32 @@ static void spiIrqHandler(const extDevice_t *dev)
         // Do as much processing as possible before asserting CS to avoid violating minimum high time
         bool negateCS = bus->curSegment->negateCS;
 
+        // With CS negated a waiting high priority transfer may run before the rest of this one
+        if (negateCS && dev->priority != BUS_PRIORITY_HIGH) {
+            busSegment_t *endSegment;
+
+            for (endSegment = nextSegment; endSegment->len; endSegment++);
+
+            const extDevice_t *preemptDev = endSegment->u.link.dev;
+
+            if (preemptDev && preemptDev->priority == BUS_PRIORITY_HIGH) {
+                busSegment_t *preemptSegments = (busSegment_t *)endSegment->u.link.segments;
+                busSegment_t *preemptEndSegment;
+
+                for (preemptEndSegment = preemptSegments; preemptEndSegment->len; preemptEndSegment++);
+
+                // Unlink the high priority transfer, and resume this one after it
+                endSegment->u.link.dev = preemptEndSegment->u.link.dev;
+                endSegment->u.link.segments = preemptEndSegment->u.link.segments;
+                preemptEndSegment->u.link.dev = dev;
+                preemptEndSegment->u.link.segments = nextSegment;
+
+                bus->curSegment = preemptSegments;
+                spiSequenceStart(preemptDev);
+                return;
+            }
+        }
+
         bus->curSegment = nextSegment;
 
         // After the completion of the first segment setup the init structure for the subsequent segment
@@ -471,10 +498,7 @@ static void spiRxIrqHandler(dmaChannelDescriptor_t* descriptor)
     if (bus->curSegment->u.buffers.rxData) {
 #endif
          // Invalidate the D cache covering the area into which data has been read
-        SCB_InvalidateDCache_by_Addr(
-            (uint32_t *)((uint32_t)bus->curSegment->u.buffers.rxData & ~CACHE_LINE_MASK),
-            (((uint32_t)bus->curSegment->u.buffers.rxData & CACHE_LINE_MASK) +
-              bus->curSegment->len - 1 + CACHE_LINE_SIZE) & ~CACHE_LINE_MASK);
+        dmaCacheInvalidate(bus->curSegment->u.buffers.rxData, bus->curSegment->len);
     }
 #endif // __DCACHE_PRESENT
 
@@ -728,6 +752,9 @@ void spiSequence(const extDevice_t *dev, busSegment_t *segments)
             // Safe to discard the volatile qualifier as we're in an atomic block
             busSegment_t *endCmpSegment = (busSegment_t *)bus->curSegment;
 
+            // Terminating segment after which the new transfer is linked
+            busSegment_t *insertSegment = NULL;
+
             if (endCmpSegment) {
                 while (true) {
                     // Find the last segment of the current transfer
@@ -741,6 +768,12 @@ void spiSequence(const extDevice_t *dev, busSegment_t *segments)
                         return;
                     }
 
+                    // High priority transfers go ahead of the first normal priority one queued
+                    if (!insertSegment && dev->priority == BUS_PRIORITY_HIGH &&
+                        (endCmpSegment->u.link.dev == NULL || endCmpSegment->u.link.dev->priority != BUS_PRIORITY_HIGH)) {
+                        insertSegment = endCmpSegment;
+                    }
+
                     if (endCmpSegment->u.link.dev == NULL) {
                         // End of the segment list queue reached
                         break;
@@ -751,6 +784,13 @@ void spiSequence(const extDevice_t *dev, busSegment_t *segments)
                 }
             }
 
+            if (insertSegment) {
+                // Carry on with the rest of the queue after the new transfer
+                endSegment->u.link.dev = insertSegment->u.link.dev;
+                endSegment->u.link.segments = insertSegment->u.link.segments;
+                endCmpSegment = insertSegment;
+            }
+
             // Record the dev and segments parameters in the terminating segment entry
             endCmpSegment->u.link.dev = dev;
             endCmpSegment->u.link.segments = segments;
@@ -315,9 +315,7 @@ void spiInternalInitStream(const extDevice_t *dev, bool preInit)
         if (!IS_DTCM(txData)) {
 #endif
             // Flush the D cache to ensure the data to be written is in main memory
-            SCB_CleanDCache_by_Addr(
-                    (uint32_t *)((uint32_t)txData & ~CACHE_LINE_MASK),
-                    (((uint32_t)txData & CACHE_LINE_MASK) + len - 1 + CACHE_LINE_SIZE) & ~CACHE_LINE_MASK);
+            dmaCacheClean(txData, len);
         }
 #endif // __DCACHE_PRESENT
         initTx->MemoryOrM2MDstAddress = (uint32_t)txData;
@@ -347,9 +345,7 @@ void spiInternalInitStream(const extDevice_t *dev, bool preInit)
             // No need to flush DTCM memory
             if (!IS_DTCM(rxData)) {
 #endif
-                SCB_CleanInvalidateDCache_by_Addr(
-                        (uint32_t *)((uint32_t)rxData & ~CACHE_LINE_MASK),
-                        (((uint32_t)rxData & CACHE_LINE_MASK) + len - 1 + CACHE_LINE_SIZE) & ~CACHE_LINE_MASK);
+                dmaCacheCleanInvalidate(rxData, len);
             }
 #endif // __DCACHE_PRESENT
         initRx->MemoryOrM2MDstAddress = (uint32_t)rxData;
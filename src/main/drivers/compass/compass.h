@@ -36,4 +36,7 @@ typedef struct magDev_s {
     fp_rotationMatrix_t rotationMatrix;
     ioTag_t magIntExtiTag;
     int16_t magGain[3];
+    uint16_t sampleRateHz;                                  // output data rate, set by the driver init
+    volatile bool dataReady;                                // set by the DRDY interrupt
+    bool useDataReady;
 } magDev_t;
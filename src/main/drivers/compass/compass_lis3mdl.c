@@ -138,6 +138,8 @@ static bool lis3mdlInit(magDev_t *mag)
 
     delay(100);
 
+    mag->sampleRateHz = 80;
+
     return true;
 }
 
@@ -72,6 +72,38 @@
 #define QMC5883L_REG_ID 0x0D
 #define QMC5883_ID_VAL 0xFF
 
+static uint8_t qmc5883lBuf[6];
+static uint8_t qmc5883lStatus;
+
+static volatile enum {
+    STATE_IDLE,
+    STATE_PENDING,
+    STATE_DATA_READY,
+} qmc5883lState = STATE_IDLE;
+
+// Called on completion of the data read
+static busStatus_e qmc5883lDataDone(uint32_t arg)
+{
+    UNUSED(arg);
+
+    qmc5883lState = STATE_DATA_READY;
+
+    return BUS_READY;
+}
+
+// Called on completion of the status read, chains the data read if ready
+static busStatus_e qmc5883lStatusDone(uint32_t arg)
+{
+    magDev_t *magDev = (magDev_t *)arg;
+
+    if ((qmc5883lStatus & 0x04) == 0 ||
+        !busReadRegisterBufferCallback(&magDev->dev, QMC5883L_REG_DATA_OUTPUT_X, qmc5883lBuf, sizeof(qmc5883lBuf), qmc5883lDataDone)) {
+        qmc5883lState = STATE_IDLE;
+    }
+
+    return BUS_READY;
+}
+
 static bool qmc5883lInit(magDev_t *magDev)
 {
     bool ack = true;
@@ -79,6 +111,8 @@ static bool qmc5883lInit(magDev_t *magDev)
 
     busDeviceRegister(dev);
 
+    dev->callbackArg = (uint32_t)magDev;
+
     ack = ack && busWriteRegister(dev, 0x0B, 0x01);
     ack = ack && busWriteRegister(dev, QMC5883L_REG_CONF1, QMC5883L_MODE_CONTINUOUS | QMC5883L_ODR_200HZ | QMC5883L_OSR_512 | QMC5883L_RNG_8G);
 
@@ -86,50 +120,34 @@ static bool qmc5883lInit(magDev_t *magDev)
         return false;
     }
 
+    magDev->sampleRateHz = 200;
+
     return true;
 }
 
 static bool qmc5883lRead(magDev_t *magDev, int16_t *magData)
 {
-    static uint8_t buf[6];
-    static uint8_t status;
-    static enum {
-        STATE_READ_STATUS,
-        STATE_WAIT_STATUS,
-        STATE_WAIT_READ,
-    } state = STATE_READ_STATUS;
-
-    extDevice_t *dev = &magDev->dev;
-
-    switch (state) {
+    switch (qmc5883lState) {
         default:
-        case STATE_READ_STATUS:
-            busReadRegisterBufferStart(dev, QMC5883L_REG_STATUS, &status, sizeof(status));
-            state = STATE_WAIT_STATUS;
-            return false;
-
-        case STATE_WAIT_STATUS:
-            if ((status & 0x04) == 0) {
-                state = STATE_READ_STATUS;
-                return false;
+        case STATE_IDLE:
+            qmc5883lState = STATE_PENDING;
+            if (!busReadRegisterBufferCallback(&magDev->dev, QMC5883L_REG_STATUS, &qmc5883lStatus, sizeof(qmc5883lStatus), qmc5883lStatusDone)) {
+                qmc5883lState = STATE_IDLE;
             }
-
-            busReadRegisterBufferStart(dev, QMC5883L_REG_DATA_OUTPUT_X, buf, sizeof(buf));
-            state = STATE_WAIT_READ;
             return false;
 
-        case STATE_WAIT_READ:
+        case STATE_PENDING:
+            return false;
 
-            magData[X] = (int16_t)(buf[1] << 8 | buf[0]);
-            magData[Y] = (int16_t)(buf[3] << 8 | buf[2]);
-            magData[Z] = (int16_t)(buf[5] << 8 | buf[4]);
+        case STATE_DATA_READY:
+            magData[X] = (int16_t)(qmc5883lBuf[1] << 8 | qmc5883lBuf[0]);
+            magData[Y] = (int16_t)(qmc5883lBuf[3] << 8 | qmc5883lBuf[2]);
+            magData[Z] = (int16_t)(qmc5883lBuf[5] << 8 | qmc5883lBuf[4]);
 
-            state = STATE_READ_STATUS;
+            qmc5883lState = STATE_IDLE;
 
             return true;
     }
-
-    return false;
 }
 
 bool qmc5883lDetect(magDev_t *magDev)
@@ -36,6 +36,7 @@ void displayClearScreen(displayPort_t *instance, displayClearOption_e options)
     instance->vTable->clearScreen(instance, options);
     instance->cleared = true;
     instance->cursorRow = -1;
+    instance->clearCount++;
 }
 
 // Return true if screen still being transferred
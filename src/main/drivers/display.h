@@ -92,6 +92,10 @@ typedef struct displayPort_s {
 
     // Displayport device capability
     bool useDeviceBlink;
+    bool retainsCanvas;         // Canvas is kept between frames until cleared
+
+    // Incremented on every screen clear
+    uint8_t clearCount;
 
     // The type of display device
     displayPortDeviceType_e deviceType;
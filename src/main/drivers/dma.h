@@ -25,6 +25,40 @@
 #define CACHE_LINE_SIZE 32
 #define CACHE_LINE_MASK (CACHE_LINE_SIZE - 1)
 
+// Round a DMA buffer size up to whole cache lines
+#define CACHE_ALIGN_SIZE(size) (((size) + CACHE_LINE_MASK) & ~CACHE_LINE_MASK)
+
+// D-cache maintenance of a DMA buffer, widened to the cache lines it touches.
+// Buffers in DMA_RAM on the H7 and in DTCM are not cached and need none.
+#ifdef __DCACHE_PRESENT
+#define DMA_CACHE_ARGS(buffer, size) \
+    (uint32_t *)((uint32_t)(buffer) & ~CACHE_LINE_MASK), \
+    CACHE_ALIGN_SIZE(((uint32_t)(buffer) & CACHE_LINE_MASK) + (size))
+
+// Before memory to peripheral: write the buffer out to memory
+static inline void dmaCacheClean(const void *buffer, uint32_t size)
+{
+    SCB_CleanDCache_by_Addr(DMA_CACHE_ARGS(buffer, size));
+}
+
+// Before peripheral to memory: write out the partial lines at either end,
+// so invalidating afterwards cannot drop data next to the buffer
+static inline void dmaCacheCleanInvalidate(void *buffer, uint32_t size)
+{
+    SCB_CleanInvalidateDCache_by_Addr(DMA_CACHE_ARGS(buffer, size));
+}
+
+// After peripheral to memory: drop the stale cached copy
+static inline void dmaCacheInvalidate(void *buffer, uint32_t size)
+{
+    SCB_InvalidateDCache_by_Addr(DMA_CACHE_ARGS(buffer, size));
+}
+#else
+static inline void dmaCacheClean(const void *buffer, uint32_t size) { (void)buffer; (void)size; }
+static inline void dmaCacheCleanInvalidate(void *buffer, uint32_t size) { (void)buffer; (void)size; }
+static inline void dmaCacheInvalidate(void *buffer, uint32_t size) { (void)buffer; (void)size; }
+#endif
+
 // dmaResource_t is a opaque data type which represents a single DMA engine,
 // called and implemented differently in different families of STM32s.
 // The opaque data type provides uniform handling of the engine in source code.
@@ -244,7 +278,15 @@ typedef enum {
 #define DMAx_SetMemoryAddress(reg, address) ((DMA_ARCH_TYPE *)(reg))->CMAR = (uint32_t)&s->port.txBuffer[s->port.txBufferTail]
 #endif
 
+// A DMA request that was refused because the stream was already taken
+typedef struct {
+    dmaIdentifier_e identifier;
+    resourceOwner_t owner;
+} dmaConflict_t;
+
 dmaIdentifier_e dmaAllocate(dmaIdentifier_e identifier, resourceOwner_e owner, uint8_t resourceIndex);
+uint8_t dmaGetConflictCount(void);
+const dmaConflict_t *dmaGetConflict(uint8_t index);
 void dmaEnable(dmaIdentifier_e identifier);
 void dmaSetHandler(dmaIdentifier_e identifier, dmaCallbackHandlerFuncPtr callback, uint32_t priority, uint32_t userParam);
 
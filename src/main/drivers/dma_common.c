@@ -26,9 +26,40 @@
 
 #include "dma.h"
 
+#define DMA_MAX_CONFLICTS 8
+
+static dmaConflict_t dmaConflicts[DMA_MAX_CONFLICTS];
+static uint8_t dmaConflictCount;
+
+static void dmaRecordConflict(dmaIdentifier_e identifier, resourceOwner_e owner, uint8_t resourceIndex)
+{
+    if (dmaConflictCount < DMA_MAX_CONFLICTS) {
+        dmaConflict_t *conflict = &dmaConflicts[dmaConflictCount++];
+        conflict->identifier = identifier;
+        conflict->owner.owner = owner;
+        conflict->owner.resourceIndex = resourceIndex;
+    }
+}
+
+uint8_t dmaGetConflictCount(void)
+{
+    return dmaConflictCount;
+}
+
+const dmaConflict_t *dmaGetConflict(uint8_t index)
+{
+    return (index < dmaConflictCount) ? &dmaConflicts[index] : NULL;
+}
+
 dmaIdentifier_e dmaAllocate(dmaIdentifier_e identifier, resourceOwner_e owner, uint8_t resourceIndex)
 {
+    if (identifier == DMA_NONE) {
+        return DMA_NONE;
+    }
+
     if (dmaGetOwner(identifier)->owner != OWNER_FREE) {
+        // The caller falls back to interrupts or polling
+        dmaRecordConflict(identifier, owner, resourceIndex);
         return DMA_NONE;
     }
 
@@ -506,7 +506,35 @@ static bool bbUpdateStart(void)
             return false;
         }
 
+#ifndef DEBUG_BBDECODE
+        // Decode all motor pins of a port in one pass over its input buffer
+        uint32_t portValues[MAX_SUPPORTED_MOTOR_PORTS][BB_PORT_PINS];
+
+        for (int i = 0; i < usedMotorPorts; i++) {
+            bbPort_t *bbPort = &bbPorts[i];
+            uint32_t pinMask = 0;
+
+            for (int motorIndex = 0; motorIndex < MAX_SUPPORTED_MOTORS && motorIndex < motorCount; motorIndex++) {
+                if (bbMotors[motorIndex].bbPort == bbPort) {
+                    pinMask |= 1 << bbMotors[motorIndex].pinIndex;
+                }
+            }
+
+            if (!pinMask) {
+                continue;
+            }
+
+#ifdef USE_DSHOT_CACHE_MGMT
+            SCB_InvalidateDCache_by_Addr((uint32_t *)bbPort->portInputBuffer, DSHOT_BB_PORT_IP_BUF_CACHE_ALIGN_BYTES);
+#endif
+            decode_bb_port(bbPort->portInputBuffer, bbPort->portInputCount - bbDMA_Count(bbPort), pinMask, portValues[i]);
+        }
+#endif
+
         for (int motorIndex = 0; motorIndex < MAX_SUPPORTED_MOTORS && motorIndex < motorCount; motorIndex++) {
+#ifndef DEBUG_BBDECODE
+            const uint32_t value = portValues[bbMotors[motorIndex].bbPort - bbPorts][bbMotors[motorIndex].pinIndex];
+#else
 #ifdef USE_DSHOT_CACHE_MGMT
             // Only invalidate the buffer once. If all motors are on a common port they'll share a buffer.
             bool invalidated = false;
@@ -532,6 +560,7 @@ static bool bbUpdateStart(void)
                 bbMotors[motorIndex].bbPort->portInputCount - bbDMA_Count(bbMotors[motorIndex].bbPort),
                 bbMotors[motorIndex].pinIndex);
 #endif
+#endif // DEBUG_BBDECODE
             if (value == BB_NOEDGE) {
                 continue;
             }
@@ -292,4 +292,121 @@ FAST_CODE uint32_t decode_bb( uint16_t buffer[], uint32_t count, uint32_t bit)
     return decode_bb_value(value, buffer, count, bit);
 }
 
+// Per pin state of the port decoder
+typedef struct {
+    uint32_t value;
+    uint16_t last;      // One past the sample of the previous edge
+    uint16_t end;       // One past the last sample of the frame
+    uint8_t bits;
+} bbPinState_t;
+
+static inline void decode_bb_port_level(bbPinState_t *pin, uint32_t edge)
+{
+    // A level of length n gets decoded to a sequence of bits of
+    // the form 1000 with a length of (n+1) / 3 to account for 3x
+    // oversampling.
+    const int len = MAX((int)(edge - pin->last + 1) / 3, 1);
+    pin->bits += len;
+    pin->value <<= len;
+    pin->value |= 1 << (len - 1);
+    pin->last = edge;
+}
+
+/*
+ * Decode the frames of all pins in pinMask in a single pass over the port input buffer.
+ *
+ * All pins are compared against their current level with one word wide xor per sample,
+ * so samples without an edge on any pin cost only a compare. Gives the same result as
+ * decode_bb() for each pin, written to values[pin] (BB_NOEDGE for pins not in pinMask).
+ */
+FAST_CODE void decode_bb_port(uint16_t buffer[], uint32_t count, uint32_t pinMask, uint32_t values[])
+{
+    bbPinState_t state[BB_PORT_PINS];
+
+    uint32_t searchMask = pinMask;  // Pins waiting for the leading low level
+    uint32_t runMask = 0;           // Pins inside their frame
+    uint32_t levelBits = 0;         // Current level of the pins inside their frame
+    uint32_t startedMask = 0;       // Pins where a frame start was found
+
+    const uint32_t searchEnd = (count > MIN_VALID_BBSAMPLES) ? count - MIN_VALID_BBSAMPLES : 0;
+
+    for (uint32_t i = 0; i < count && (searchMask | runMask); i++) {
+        const uint32_t sample = buffer[i];
+
+        // Edges on all pins inside their frame at once
+        uint32_t edges = (sample ^ levelBits) & runMask;
+
+        while (edges) {
+            const int pin = __builtin_ctz(edges);
+            const uint32_t bit = 1 << pin;
+            bbPinState_t *st = &state[pin];
+
+            edges &= ~bit;
+
+            if (i + 1 < st->end) {
+                decode_bb_port_level(st, i + 1);
+                levelBits ^= bit;
+            } else {
+                // Edge beyond the frame, stop decoding this pin
+                runMask &= ~bit;
+            }
+        }
+
+        if (searchMask) {
+            if (i >= searchEnd) {
+                // No leading low level found, ESC didn't respond
+                searchMask = 0;
+                continue;
+            }
+
+            // Eliminate leading high signal level by looking for first zero bit in data stream
+            uint32_t lows = ~sample & searchMask;
+
+            while (lows) {
+                const int pin = __builtin_ctz(lows);
+                const uint32_t bit = 1 << pin;
+                bbPinState_t *st = &state[pin];
+
+                lows &= ~bit;
+                searchMask &= ~bit;
+
+                // Single sample glitches are not a frame start
+                if (!(buffer[i + 1] & bit)) {
+                    st->value = 0;
+                    st->bits = 0;
+                    st->last = i + 1;
+                    st->end = i + 1 + MIN(count - (i + 1), (uint32_t)MAX_VALID_BBSAMPLES);
+                    levelBits &= ~bit;
+                    runMask |= bit;
+                    startedMask |= bit;
+                }
+            }
+        }
+    }
+
+    for (int pin = 0; pin < BB_PORT_PINS; pin++) {
+        const uint32_t bit = 1 << pin;
+        const bbPinState_t *st = &state[pin];
+
+        if (!(startedMask & bit) || st->bits < 18) {
+            values[pin] = BB_NOEDGE;
+            continue;
+        }
+
+        // length of last sequence has to be inferred since the last bit with inverted dshot is high
+        const int nlen = 21 - st->bits;
+        uint32_t value = st->value;
+
+        if (nlen < 0) {
+            value = BB_INVALID;
+        }
+        if (nlen > 0) {
+            value <<= nlen;
+            value |= 1 << (nlen - 1);
+        }
+
+        values[pin] = decode_bb_value(value, buffer, count, pin);
+    }
+}
+
 #endif
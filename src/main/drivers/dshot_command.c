@@ -54,24 +54,25 @@ typedef enum {
 
 typedef struct dshotCommandControl_s {
     dshotCommandState_e state;
-    uint32_t nextCommandCycleDelay;
+    timeUs_t nextCommandUs;
     timeUs_t delayAfterCommandUs;
     uint8_t repeats;
     uint8_t command[MAX_SUPPORTED_MOTORS];
 } dshotCommandControl_t;
 
-static timeUs_t dshotCommandPidLoopTimeUs = 125; // default to 8KHz (125us) loop to prevent possible div/0
+static timeUs_t dshotCommandPidLoopTimeUs = 125; // default to 8KHz (125us) loop
                                                  // gets set to the actual value when the PID loop is initialized
 
-// XXX Optimization opportunity here.
-// https://github.com/betaflight/betaflight/pull/8534#pullrequestreview-258947278
-// @ledvinap: queue entry is quite large - it may be better to handle empty/full queue using different mechanism (magic value for Head or Tail / explicit element count)
-// Explicit element count will make code below simpler, but care has to be taken to avoid race conditions
-
+// Single producer (dshotCommandWrite) and single consumer (motor update),
+// both running in the main loop context. The head is only moved by the
+// producer and the tail only by the consumer.
 static dshotCommandControl_t commandQueue[DSHOT_MAX_COMMANDS + 1];
 static uint8_t commandQueueHead;
 static uint8_t commandQueueTail;
 
+// Commands to load into the next motor frame, NULL for normal output
+FAST_DATA_ZERO_INIT const uint8_t *dshotCommandOutput;
+
 void dshotSetPidLoopTime(uint32_t pidLoopTime)
 {
     dshotCommandPidLoopTimeUs = pidLoopTime;
@@ -92,7 +93,7 @@ static FAST_CODE bool isLastDshotCommand(void)
     return ((commandQueueTail + 1) % (DSHOT_MAX_COMMANDS + 1) == commandQueueHead);
 }
 
-FAST_CODE bool dshotCommandIsProcessing(void)
+static FAST_CODE bool isDshotCommandProcessing(void)
 {
     if (dshotCommandQueueEmpty()) {
         return false;
@@ -104,7 +105,14 @@ FAST_CODE bool dshotCommandIsProcessing(void)
     return commandIsProcessing;
 }
 
-static FAST_CODE bool dshotCommandQueueUpdate(void)
+// Decide once what the motor writers load into the next frame, so they
+// only need to test a pointer
+static FAST_CODE void dshotCommandUpdateOutput(void)
+{
+    dshotCommandOutput = isDshotCommandProcessing() ? commandQueue[commandQueueTail].command : NULL;
+}
+
+static FAST_CODE bool dshotCommandQueueUpdate(timeUs_t currentTimeUs)
 {
     if (!dshotCommandQueueEmpty()) {
         commandQueueTail = (commandQueueTail + 1) % (DSHOT_MAX_COMMANDS + 1);
@@ -114,21 +122,13 @@ static FAST_CODE bool dshotCommandQueueUpdate(void)
             // the DSHOT_COMMAND_STATE_IDLEWAIT and DSHOT_COMMAND_STATE_STARTDELAY states.
             dshotCommandControl_t* nextCommand = &commandQueue[commandQueueTail];
             nextCommand->state = DSHOT_COMMAND_STATE_ACTIVE;
-            nextCommand->nextCommandCycleDelay = 0;
+            nextCommand->nextCommandUs = currentTimeUs;
             return true;
         }
     }
     return false;
 }
 
-static FAST_CODE uint32_t dshotCommandCyclesFromTime(timeUs_t delayUs)
-{
-    // Find the minimum number of motor output cycles needed to
-    // provide at least delayUs time delay
-
-    return (delayUs + dshotCommandPidLoopTimeUs - 1) / dshotCommandPidLoopTimeUs;
-}
-
 static dshotCommandControl_t* addCommand()
 {
     int newHead = (commandQueueHead + 1) % (DSHOT_MAX_COMMANDS + 1);
@@ -140,6 +140,30 @@ static dshotCommandControl_t* addCommand()
     return control;
 }
 
+// A command for a single motor can share the frames of the last queued
+// command, if that has not started yet, has the same timing and leaves
+// this motor stopped.
+static dshotCommandControl_t* mergeCommand(uint8_t index, uint8_t repeats, timeUs_t delayAfterCommandUs)
+{
+    if (index == ALL_MOTORS || index >= MAX_SUPPORTED_MOTORS || dshotCommandQueueEmpty()) {
+        return NULL;
+    }
+
+    const int last = (commandQueueHead + DSHOT_MAX_COMMANDS) % (DSHOT_MAX_COMMANDS + 1);
+    dshotCommandControl_t* control = &commandQueue[last];
+
+    const bool pending = (last != commandQueueTail) ||
+        control->state == DSHOT_COMMAND_STATE_IDLEWAIT ||
+        control->state == DSHOT_COMMAND_STATE_STARTDELAY;
+
+    if (pending && control->repeats == repeats && control->delayAfterCommandUs == delayAfterCommandUs &&
+        control->command[index] == DSHOT_CMD_MOTOR_STOP) {
+        return control;
+    }
+
+    return NULL;
+}
+
 static bool allMotorsAreIdle(void)
 {
     for (unsigned i = 0; i < motorDeviceCount(); i++) {
@@ -180,7 +204,7 @@ static bool dshotCommandsAreEnabled(dshotCommandType_e commandType)
 
 void dshotCommandWrite(uint8_t index, uint8_t motorCount, uint8_t command, dshotCommandType_e commandType)
 {
-    if (!isMotorProtocolDshot() || !dshotCommandsAreEnabled(commandType) || (command > DSHOT_MAX_COMMAND) || dshotCommandQueueFull()) {
+    if (!isMotorProtocolDshot() || !dshotCommandsAreEnabled(commandType) || (command > DSHOT_MAX_COMMAND)) {
         return;
     }
 
@@ -232,12 +256,16 @@ void dshotCommandWrite(uint8_t index, uint8_t motorCount, uint8_t command, dshot
         }
         delayMicroseconds(delayAfterCommandUs);
     } else if (commandType == DSHOT_CMD_TYPE_INLINE) {
-        dshotCommandControl_t *commandControl = addCommand();
+        dshotCommandControl_t *commandControl = mergeCommand(index, repeats, delayAfterCommandUs);
         if (commandControl) {
+            commandControl->command[index] = command;
+        }
+        else if (!dshotCommandQueueFull()) {
+            commandControl = addCommand();
             commandControl->repeats = repeats;
             commandControl->delayAfterCommandUs = delayAfterCommandUs;
-            for (unsigned i = 0; i < motorCount; i++) {
-                if (index == i || index == ALL_MOTORS) {
+            for (unsigned i = 0; i < MAX_SUPPORTED_MOTORS; i++) {
+                if (i < motorCount && (index == i || index == ALL_MOTORS)) {
                     commandControl->command[i] = command;
                 } else {
                     commandControl->command[i] = DSHOT_CMD_MOTOR_STOP;
@@ -246,20 +274,16 @@ void dshotCommandWrite(uint8_t index, uint8_t motorCount, uint8_t command, dshot
             if (allMotorsAreIdle()) {
                 // we can skip the motors idle wait state
                 commandControl->state = DSHOT_COMMAND_STATE_STARTDELAY;
-                commandControl->nextCommandCycleDelay = dshotCommandCyclesFromTime(DSHOT_INITIAL_DELAY_US);
+                commandControl->nextCommandUs = micros() + DSHOT_INITIAL_DELAY_US;
             } else {
                 commandControl->state = DSHOT_COMMAND_STATE_IDLEWAIT;
-                commandControl->nextCommandCycleDelay = 0;  // will be set after idle wait completes
+                commandControl->nextCommandUs = 0;  // will be set after idle wait completes
             }
         }
+        dshotCommandUpdateOutput();
     }
 }
 
-uint8_t dshotCommandGetCurrent(uint8_t index)
-{
-    return commandQueue[commandQueueTail].command[index];
-}
-
 // This function is used to synchronize the dshot command output timing with
 // the normal motor output timing tied to the PID loop frequency. A "true" result
 // allows the motor output to be sent, "false" means delay until next loop. So take
@@ -269,56 +293,62 @@ FAST_CODE_NOINLINE bool dshotCommandOutputIsEnabled(uint8_t motorCount)
 {
     UNUSED(motorCount);
 
+    const timeUs_t currentTimeUs = micros();
+    bool enabled = true;
+
     dshotCommandControl_t* command = &commandQueue[commandQueueTail];
     switch (command->state) {
     case DSHOT_COMMAND_STATE_IDLEWAIT:
         if (allMotorsAreIdle()) {
             command->state = DSHOT_COMMAND_STATE_STARTDELAY;
-            command->nextCommandCycleDelay = dshotCommandCyclesFromTime(DSHOT_INITIAL_DELAY_US);
+            command->nextCommandUs = currentTimeUs + DSHOT_INITIAL_DELAY_US;
         }
         break;
 
     case DSHOT_COMMAND_STATE_STARTDELAY:
-        if (command->nextCommandCycleDelay) {
-            --command->nextCommandCycleDelay;
-            return false;  // Delay motor output until the start of the command sequence
+        if (cmpTimeUs(command->nextCommandUs, currentTimeUs) > 0) {
+            enabled = false;  // Delay motor output until the start of the command sequence
+            break;
         }
         command->state = DSHOT_COMMAND_STATE_ACTIVE;
-        command->nextCommandCycleDelay = 0;  // first iteration of the repeat happens now
+        command->nextCommandUs = currentTimeUs;  // first iteration of the repeat happens now
         FALLTHROUGH;
 
     case DSHOT_COMMAND_STATE_ACTIVE:
-        if (command->nextCommandCycleDelay) {
-            --command->nextCommandCycleDelay;
-            return false;  // Delay motor output until the next command repeat
+        if (cmpTimeUs(command->nextCommandUs, currentTimeUs) > 0) {
+            enabled = false;  // Delay motor output until the next command repeat
+            break;
         }
 
         command->repeats--;
         if (command->repeats) {
-            command->nextCommandCycleDelay = dshotCommandCyclesFromTime(DSHOT_COMMAND_DELAY_US);
+            command->nextCommandUs = currentTimeUs + DSHOT_COMMAND_DELAY_US;
         } else {
             command->state = DSHOT_COMMAND_STATE_POSTDELAY;
-            command->nextCommandCycleDelay = dshotCommandCyclesFromTime(command->delayAfterCommandUs);
-            if (!isLastDshotCommand() && command->nextCommandCycleDelay > 0) {
+            command->nextCommandUs = currentTimeUs + command->delayAfterCommandUs;
+            if (!isLastDshotCommand()) {
                 // Account for the 1 extra motor output loop between commands.
                 // Otherwise the inter-command delay will be DSHOT_COMMAND_DELAY_US + 1 loop.
-                command->nextCommandCycleDelay--;
+                command->nextCommandUs -= dshotCommandPidLoopTimeUs;
             }
         }
         break;
 
     case DSHOT_COMMAND_STATE_POSTDELAY:
-        if (command->nextCommandCycleDelay) {
-            --command->nextCommandCycleDelay;
-            return false;  // Delay motor output until the end of the post-command delay
+        if (cmpTimeUs(command->nextCommandUs, currentTimeUs) > 0) {
+            enabled = false;  // Delay motor output until the end of the post-command delay
+            break;
         }
-        if (dshotCommandQueueUpdate()) {
+        if (dshotCommandQueueUpdate(currentTimeUs)) {
             // Will be true if the command queue is not empty and we
             // want to wait for the next command to start in sequence.
-            return false;
+            enabled = false;
         }
+        break;
     }
 
-    return true;
+    dshotCommandUpdateOutput();
+
+    return enabled;
 }
 #endif // USE_DSHOT
@@ -20,6 +20,10 @@
 
 #pragma once
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 #define DSHOT_MAX_COMMAND 47
 
 /*
@@ -68,7 +72,18 @@ typedef enum {
 void dshotCommandWrite(uint8_t index, uint8_t motorCount, uint8_t command, dshotCommandType_e commandType);
 void dshotSetPidLoopTime(uint32_t pidLoopTime);
 bool dshotCommandQueueEmpty(void);
-bool dshotCommandIsProcessing(void);
-uint8_t dshotCommandGetCurrent(uint8_t index);
 bool dshotCommandOutputIsEnabled(uint8_t motorCount);
+
+extern const uint8_t *dshotCommandOutput;
+
+// True if the next motor frame carries dshot commands instead of the motor values
+static inline bool dshotCommandIsProcessing(void)
+{
+    return dshotCommandOutput != NULL;
+}
+
+static inline uint8_t dshotCommandGetCurrent(uint8_t index)
+{
+    return dshotCommandOutput[index];
+}
 bool dshotStreamingCommandsAreEnabled(void);
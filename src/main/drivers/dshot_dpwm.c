@@ -135,6 +135,17 @@ static FAST_CODE void dshotWrite(uint8_t index, uint8_t mode, float value)
     pwmWriteDshotInt(index, dshotConvertToInternal(index,mode,value));
 }
 
+static FAST_CODE void dshotWriteAll(uint8_t count, const uint8_t *mode, const float *value)
+{
+    uint16_t values[MAX_SUPPORTED_MOTORS];
+
+    for (int index = 0; index < count; index++) {
+        values[index] = dshotConvertToInternal(index, mode[index], value[index]);
+    }
+
+    pwmWriteDshotAll(count, values);
+}
+
 static motorVTable_t dshotPwmVTable = {
     .postInit = motorPostInitNull,
     .enable = dshotPwmEnableMotors,
@@ -143,6 +154,7 @@ static motorVTable_t dshotPwmVTable = {
     .updateStart = motorUpdateStartNull,
     .updateComplete = pwmCompleteDshotMotorUpdate,
     .write = dshotWrite,
+    .writeAll = dshotWriteAll,
     .writeInt = dshotWriteInt,
     .isMotorEnabled = dshotPwmIsMotorEnabled,
 };
@@ -193,6 +205,7 @@ motorDevice_t *dshotPwmDevInit(const motorDevConfig_t *motorConfig, uint8_t moto
 
         /* not enough motors initialised for the mixer or a break in the motors */
         dshotPwmDevice.vTable.write = motorWriteNull;
+        dshotPwmDevice.vTable.writeAll = NULL;
         dshotPwmDevice.vTable.updateComplete = motorUpdateCompleteNull;
 
         /* TODO: block arming and add reason system cannot arm */
@@ -378,6 +378,18 @@ static void flashConfigurePartitions(void)
     startSector = 0;
 #endif
 
+#if defined(USE_FLASH_LOG)
+    // Records are programmed one at a time, which NAND pages don't allow
+    if (flashGeometry->flashType == FLASH_TYPE_NOR) {
+        startSector = (endSector + 1) - FLASH_RECORDS_SECTORS;
+
+        flashPartitionSet(FLASH_PARTITION_TYPE_RECORDS, startSector, endSector);
+
+        endSector = startSector - 1;
+        startSector = 0;
+    }
+#endif
+
 #ifdef USE_FLASHFS
     flashPartitionSet(FLASH_PARTITION_TYPE_FLASHFS, startSector, endSector);
 #endif
@@ -428,6 +440,7 @@ static const char *flashPartitionNames[] = {
     "BBMGMT   ",
     "FIRMWARE ",
     "CONFIG   ",
+    "RECORDS  ",
 };
 
 const char *flashPartitionGetTypeName(flashPartitionType_e type)
@@ -72,6 +72,8 @@ typedef struct flashPartition_s {
     flashSector_t endSector;
 } flashPartition_t;
 
+#define FLASH_RECORDS_SECTORS 2 // Sectors of the RECORDS partition, written alternately by the flash log
+
 #define FLASH_PARTITION_SECTOR_COUNT(partition) (partition->endSector + 1 - partition->startSector) // + 1 for inclusive, start and end sector can be the same sector.
 
 // Must be in sync with flashPartitionTypeNames[]
@@ -83,6 +85,7 @@ typedef enum {
     FLASH_PARTITION_TYPE_BADBLOCK_MANAGEMENT,
     FLASH_PARTITION_TYPE_FIRMWARE,
     FLASH_PARTITION_TYPE_CONFIG,
+    FLASH_PARTITION_TYPE_RECORDS,
     FLASH_MAX_PARTITIONS
 } flashPartitionType_e;
 
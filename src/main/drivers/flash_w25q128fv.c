@@ -29,6 +29,7 @@
 
 #define USE_FLASH_WRITES_USING_4LINES
 #define USE_FLASH_READS_USING_4LINES
+#define USE_FLASH_READS_USING_MEMORY_MAPPING
 
 #include "build/debug.h"
 #include "common/utils.h"
@@ -393,11 +394,27 @@ void w25q128fv_flush(flashDevice_t *fdevice)
 
 static int w25q128fv_readBytes(flashDevice_t *fdevice, uint32_t address, uint8_t *buffer, uint32_t length)
 {
+    QUADSPI_TypeDef *quadSpi = fdevice->io.handle.quadSpi;
+
+#ifdef USE_FLASH_READS_USING_MEMORY_MAPPING
+    // Nothing can be programmed or erased while mapped, the chip is ready
+    if (quadSpiIsMemoryMapped(quadSpi)) {
+        quadSpiReadMemoryMapped(quadSpi, address, buffer, length);
+        return length;
+    }
+#endif
+
     if (!w25q128fv_waitForReady(fdevice)) {
         return 0;
     }
 
-    QUADSPI_TypeDef *quadSpi = fdevice->io.handle.quadSpi;
+#ifdef USE_FLASH_READS_USING_MEMORY_MAPPING
+    if (quadSpiEnableMemoryMapped4LINES(quadSpi, W25Q128FV_INSTRUCTION_FAST_READ_QUAD_OUTPUT, 8, W25Q128FV_ADDRESS_BITS)) {
+        quadSpiReadMemoryMapped(quadSpi, address, buffer, length);
+        return length;
+    }
+#endif
+
 #ifdef USE_FLASH_READS_USING_4LINES
     bool status = quadSpiReceiveWithAddress4LINES(quadSpi, W25Q128FV_INSTRUCTION_FAST_READ_QUAD_OUTPUT, 8, address, W25Q128FV_ADDRESS_BITS, buffer, length);
 #else
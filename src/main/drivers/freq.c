@@ -27,6 +27,7 @@
 #include "build/build_config.h"
 #include "build/debug.h"
 
+#include "common/maths.h"
 #include "common/utils.h"
 
 #include "drivers/io.h"
@@ -65,6 +66,12 @@
 // Timeout for missing signal [40ms]
 #define FREQ_TIMEOUT(clk)     ((clk)/25)
 
+// Input capture prescaler. Above these capture rates [Hz] every 2nd,
+// 4th or 8th edge is captured, to keep the interrupt rate down.
+#define FREQ_ICPSC_SHIFT_MAX  3
+#define FREQ_ICPSC_RATE_MAX   1000
+#define FREQ_ICPSC_RATE_MIN   400
+
 // Input signal max deviation from average 66%..150%
 #define FREQ_PERIOD_MIN(p)    ((uint32_t)(p)*2/3)
 #define FREQ_PERIOD_MAX(p)    ((uint32_t)(p)*3/2)
@@ -95,6 +102,8 @@ typedef struct {
     uint32_t timeout;
     uint32_t overflows;
 
+    uint8_t icshift;
+
     timerCCHandlerRec_t edgeCb;
     timerOvrHandlerRec_t overflowCb;
 
@@ -152,6 +161,46 @@ static void freqSetBaseClock(freqInputPort_t *input, uint32_t prescaler)
     tim->EGR = TIM_EGR_UG;
 }
 
+static void freqSetCapturePrescaler(freqInputPort_t *input, uint8_t shift)
+{
+    TIM_TypeDef *tim = input->timerHardware->tim;
+
+    // TIM_CHANNEL_x / TIM_Channel_x are 0x0,0x4,0x8,0xC
+    const unsigned channel = input->timerHardware->channel >> 2;
+    volatile uint32_t *ccmr = (channel < 2) ? &tim->CCMR1 : &tim->CCMR2;
+    const unsigned pos = (channel & 1) ? 10 : 2;
+
+    *ccmr = (*ccmr & ~(3U << pos)) | ((uint32_t)shift << pos);
+
+    input->icshift = shift;
+}
+
+// Returns true if the capture prescaler was changed
+static FAST_CODE bool freqUpdateCapturePrescaler(freqInputPort_t *input)
+{
+    const float rate = input->freq / (1 << input->icshift);
+
+    if (rate > FREQ_ICPSC_RATE_MAX && input->icshift < FREQ_ICPSC_SHIFT_MAX) {
+        freqSetCapturePrescaler(input, input->icshift + 1);
+        input->period <<= 1;
+        return true;
+    }
+    if (rate < FREQ_ICPSC_RATE_MIN && input->icshift > 0) {
+        freqSetCapturePrescaler(input, input->icshift - 1);
+        input->period >>= 1;
+        return true;
+    }
+
+    return false;
+}
+
+// The filters are tuned for one edge per capture. With the capture
+// prescaler, each capture already averages several edges.
+static inline uint16_t freqCaptureCoeff(const freqInputPort_t *input, uint8_t coeff)
+{
+    return MAX(coeff >> input->icshift, 1);
+}
+
 static void freqResetCapture(freqInputPort_t *input, uint8_t port)
 {
     input->period = FREQ_PERIOD_INIT;
@@ -161,6 +210,10 @@ static void freqResetCapture(freqInputPort_t *input, uint8_t port)
     input->percoef = 1;
     input->freqcoef = 1;
 
+    if (input->icshift) {
+        freqSetCapturePrescaler(input, 0);
+    }
+
     if (port == debugAxis) {
         for (int i = 0; i < 4; i++)
             DEBUG(FREQ_SENSOR, i, 0);
@@ -201,7 +254,7 @@ static FAST_CODE void freqEdgeCallback16(timerCCHandlerRec_t *cbRec, captureComp
             // Must use uint16 here because of wraparound
             const uint16_t period = capture - input->capture;
             if (period) {
-                float freq = input->clock / (input->prescaler * period);
+                float freq = input->clock * (1 << input->icshift) / (input->prescaler * period);
                 if (period > FREQ_PERIOD_MIN(input->period) && period < FREQ_PERIOD_MAX(input->period)) {
                     if (freq < FREQ_RANGE_MIN)
                         freq = 0;
@@ -211,9 +264,9 @@ static FAST_CODE void freqEdgeCallback16(timerCCHandlerRec_t *cbRec, captureComp
 
                 UPDATE_PERIOD_FILTER(input, period);
 
-                const uint8_t zeros = __builtin_clz(input->period * input->prescaler);
-                input->percoef = perCoeffs[zeros];
-                input->freqcoef = freqCoeffs[zeros];
+                const uint8_t zeros = __builtin_clz((input->period * input->prescaler) >> input->icshift);
+                input->percoef = freqCaptureCoeff(input, perCoeffs[zeros]);
+                input->freqcoef = freqCaptureCoeff(input, freqCoeffs[zeros]);
 
                 const uint8_t port = input - freqInputPorts;
                 if (port == debugAxis) {
@@ -223,10 +276,15 @@ static FAST_CODE void freqEdgeCallback16(timerCCHandlerRec_t *cbRec, captureComp
                     DEBUG(FREQ_SENSOR, 3, period);
                     DEBUG(FREQ_SENSOR, 4, zeros);
                     DEBUG(FREQ_SENSOR, 5, 32 - __builtin_clz(input->prescaler));
+                    DEBUG(FREQ_SENSOR, 6, input->icshift);
                 }
 
+                // Capture rate out of range. Change capture prescaler.
+                if (freqUpdateCapturePrescaler(input)) {
+                    capture = 0;
+                }
                 // Filtered period out of range. Change prescaler.
-                if (input->period < FREQ_SHIFT_MIN && input->prescaler > FREQ_PRESCALER_MIN) {
+                else if (input->period < FREQ_SHIFT_MIN && input->prescaler > FREQ_PRESCALER_MIN) {
                     freqSetBaseClock(input, input->prescaler >> 1);
                     input->period <<= 1;
                     capture = 0;
@@ -254,7 +312,7 @@ static FAST_CODE void freqEdgeCallback32(timerCCHandlerRec_t *cbRec, captureComp
         if (input->capture) {
             const uint32_t period = capture - input->capture;
             if (period) {
-                float freq = input->clock / period;
+                float freq = input->clock * (1 << input->icshift) / period;
                 if (period > FREQ_PERIOD_MIN(input->period) && period < FREQ_PERIOD_MAX(input->period)) {
                     if (freq < FREQ_RANGE_MIN)
                         freq = 0;
@@ -264,9 +322,9 @@ static FAST_CODE void freqEdgeCallback32(timerCCHandlerRec_t *cbRec, captureComp
 
                 UPDATE_PERIOD_FILTER(input, period);
 
-                const uint8_t zeros = __builtin_clz(input->period);
-                input->percoef = perCoeffs[zeros];
-                input->freqcoef = freqCoeffs[zeros];
+                const uint8_t zeros = __builtin_clz(input->period >> input->icshift);
+                input->percoef = freqCaptureCoeff(input, perCoeffs[zeros]);
+                input->freqcoef = freqCaptureCoeff(input, freqCoeffs[zeros]);
 
                 const uint8_t port = input - freqInputPorts;
                 if (port == debugAxis) {
@@ -275,6 +333,12 @@ static FAST_CODE void freqEdgeCallback32(timerCCHandlerRec_t *cbRec, captureComp
                     DEBUG(FREQ_SENSOR, 2, input->period);
                     DEBUG(FREQ_SENSOR, 3, period);
                     DEBUG(FREQ_SENSOR, 4, zeros);
+                    DEBUG(FREQ_SENSOR, 6, input->icshift);
+                }
+
+                if (freqUpdateCapturePrescaler(input)) {
+                    input->capture = 0;
+                    return;
                 }
             }
         }
@@ -336,6 +400,7 @@ void freqInit(const freqConfig_t *freqConfig)
             input->percoef = 1;
             input->freqcoef = 1;
             input->freq = 0;
+            input->icshift = 0;
 
             input->pin = IOGetByTag(freqConfig->ioTag[port]);
             IOInit(input->pin, OWNER_FREQ, RESOURCE_INDEX(port));
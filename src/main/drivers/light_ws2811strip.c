@@ -42,6 +42,7 @@
 
 #include "drivers/dma.h"
 #include "drivers/io.h"
+#include "drivers/time.h"
 
 #include "light_ws2811strip.h"
 
@@ -79,6 +80,28 @@ uint32_t ledsWithInvertedLedFormat = 0;
 
 static hsvColor_t ledColorBuffer[WS2811_DATA_BUFFER_SIZE];
 
+// Colours as sent, in the bit order of the LED format
+static uint32_t ledPackedColorBuffer[WS2811_DATA_BUFFER_SIZE];
+static ledStripFormatRGB_e lastLedFormat;
+static timeUs_t lastFrameAtUs;
+
+// Resend an unchanged strip now and then, in case it was powered up late
+#define WS2811_REFRESH_INTERVAL_US 1000000
+
+#if defined(USE_WS2811_SINGLE_COLOUR)
+#define WS2811_PACKED_INDEX(led)   0
+#else
+#define WS2811_PACKED_INDEX(led)   (led)
+#endif
+
+// Encoder state of the frame being sent
+static unsigned encodeLedCount;
+static unsigned encodeLedIndex;
+static uint32_t encodeTopBit;
+static uint32_t encodeMask;
+static unsigned frameSlotCount;
+static unsigned frameSlotsSent;
+
 #if !defined(USE_WS2811_SINGLE_COLOUR)
 void setLedHsv(uint16_t index, const hsvColor_t *color)
 {
@@ -158,15 +181,13 @@ bool isWS2811LedStripReady(void)
     return ws2811Initialised && !ws2811LedDataTransferInProgress;
 }
 
-STATIC_UNIT_TESTED void updateLEDDMABuffer(ledStripFormatRGB_e ledFormat, rgbColor24bpp_t *color, unsigned ledIndex)
+STATIC_UNIT_TESTED bool updateLEDPackedColor(ledStripFormatRGB_e ledFormat, rgbColor24bpp_t *color, unsigned ledIndex)
 {
-    uint32_t bits_per_led;
     uint32_t packed_colour;
 
     switch (ledFormat) {
         case LED_RGB: // WS2811 drivers use RGB format
             packed_colour = (color->rgb.r << 16) | (color->rgb.g << 8) | (color->rgb.b);
-            bits_per_led = 24;
             break;
 
         case LED_GRBW: // SK6812 drivers use this
@@ -174,26 +195,83 @@ STATIC_UNIT_TESTED void updateLEDDMABuffer(ledStripFormatRGB_e ledFormat, rgbCol
             /* reconstruct white channel from RGB, making the intensity a bit nonlinear, but thats fine for this use case */
             uint8_t white = MIN(MIN(color->rgb.r, color->rgb.g), color->rgb.b);
             packed_colour = (color->rgb.g << 24) | (color->rgb.r << 16) | (color->rgb.b << 8) | (white);
-            bits_per_led = 32;
             break;
         }
 
         case LED_GRB: // WS2812 drivers use GRB format
         default:
             packed_colour = (color->rgb.g << 16) | (color->rgb.r << 8) | (color->rgb.b);
-            bits_per_led = 24;
         break;
     }
 
-    unsigned dmaBufferOffset = 0;
-    for (int index = bits_per_led-1; index >= 0; index--) {
-        ledStripDMABuffer[ledIndex * bits_per_led + dmaBufferOffset++] = (packed_colour & (1 << index)) ? BIT_COMPARE_1 : BIT_COMPARE_0;
+    const bool changed = (ledPackedColorBuffer[ledIndex] != packed_colour);
+
+    ledPackedColorBuffer[ledIndex] = packed_colour;
+
+    return changed;
+}
+
+STATIC_UNIT_TESTED void ws2811EncodeStart(unsigned ledCount, unsigned bitsPerLed)
+{
+    encodeLedCount = ledCount;
+    encodeLedIndex = 0;
+    encodeTopBit = 1U << (bitsPerLed - 1);
+    encodeMask = encodeTopBit;
+
+    frameSlotCount = ledCount * bitsPerLed + WS2811_DELAY_BUFFER_LENGTH;
+    frameSlotsSent = 0;
+}
+
+// Fill the next timer periods of the frame, one per bit, MSB first
+STATIC_UNIT_TESTED void ws2811EncodeSlots(uint32_t *buffer, unsigned count)
+{
+    for (unsigned i = 0; i < count; i++) {
+        if (encodeLedIndex < encodeLedCount) {
+            buffer[i] = (ledPackedColorBuffer[WS2811_PACKED_INDEX(encodeLedIndex)] & encodeMask) ? BIT_COMPARE_1 : BIT_COMPARE_0;
+            encodeMask >>= 1;
+            if (encodeMask == 0) {
+                encodeMask = encodeTopBit;
+                encodeLedIndex++;
+            }
+        } else {
+            // Output low for the reset delay
+            buffer[i] = 0;
+        }
+    }
+}
+
+/*
+ * Called from the DMA interrupt when one half of the buffer has been sent.
+ * Returns false once the whole frame is out and the DMA should be stopped.
+ */
+bool ws2811LedStripDMAHalfComplete(unsigned half)
+{
+    if (!ws2811LedDataTransferInProgress) {
+        return false;
+    }
+
+    frameSlotsSent += WS2811_DMA_HALF_SIZE;
+
+    if (frameSlotsSent >= frameSlotCount) {
+        ws2811LedDataTransferInProgress = false;
+        return false;
     }
+
+    uint32_t *buffer = &ledStripDMABuffer[half * WS2811_DMA_HALF_SIZE];
+
+    ws2811EncodeSlots(buffer, WS2811_DMA_HALF_SIZE);
+
+#ifdef USE_LEDSTRIP_CACHE_MGMT
+    SCB_CleanDCache_by_Addr(buffer, WS2811_DMA_HALF_SIZE * sizeof(uint32_t));
+#endif
+
+    return true;
 }
 
 /*
  * This method is non-blocking unless an existing LED update is in progress.
  * it does not wait until all the LEDs have been updated, that happens in the background.
+ * Nothing is sent unless a pixel has changed.
  */
 void ws2811UpdateStrip(ledStripFormatRGB_e ledFormat, uint8_t brightness)
 {
@@ -205,10 +283,10 @@ void ws2811UpdateStrip(ledStripFormatRGB_e ledFormat, uint8_t brightness)
 
     unsigned ledIndex = 0;              // reset led index
 
-    // fill transmit buffer with correct compare values to achieve
-    // correct pulse widths according to color values
+    // pack the colors in the LED format, and see if any has changed
     const unsigned ledUpdateCount = needsFullRefresh ? WS2811_DATA_BUFFER_SIZE : usedLedCount;
     const hsvColor_t hsvBlack = { 0, 0, 0 };
+    bool changed = needsFullRefresh || (ledFormat != lastLedFormat);
     while (ledIndex < ledUpdateCount) {
         hsvColor_t scaledLed = ledIndex < usedLedCount ? ledColorBuffer[ledIndex] : hsvBlack;
         // Scale the LED brightness
@@ -216,10 +294,29 @@ void ws2811UpdateStrip(ledStripFormatRGB_e ledFormat, uint8_t brightness)
 
         rgbColor24bpp_t *rgb24 = hsvToRgb24(&scaledLed);
 
-        updateLEDDMABuffer(ledFormat ^ ((ledsWithInvertedLedFormat >> ledIndex) & 1), rgb24, ledIndex);
+        changed |= updateLEDPackedColor(ledFormat ^ ((ledsWithInvertedLedFormat >> ledIndex) & 1), rgb24, ledIndex);
         ++ledIndex;
     }
+
+    const timeUs_t currentTimeUs = micros();
+
+    if (!changed && cmpTimeUs(currentTimeUs, lastFrameAtUs) < WS2811_REFRESH_INTERVAL_US) {
+        return;
+    }
+
     needsFullRefresh = false;
+    lastLedFormat = ledFormat;
+    lastFrameAtUs = currentTimeUs;
+
+#if defined(USE_WS2811_SINGLE_COLOUR)
+    const unsigned frameLedCount = WS2811_LED_STRIP_LENGTH;
+#else
+    const unsigned frameLedCount = ledUpdateCount;
+#endif
+
+    // encode the start of the frame, the DMA interrupt encodes the rest
+    ws2811EncodeStart(frameLedCount, (ledFormat == LED_GRBW) ? 32 : 24);
+    ws2811EncodeSlots(ledStripDMABuffer, WS2811_DMA_BUFFER_SIZE);
 
 #ifdef USE_LEDSTRIP_CACHE_MGMT
     SCB_CleanDCache_by_Addr(ledStripDMABuffer, WS2811_DMA_BUF_CACHE_ALIGN_BYTES);
@@ -29,17 +29,19 @@
 #define WS2811_BITS_PER_LED_MAX    32
 
 #if defined(USE_WS2811_SINGLE_COLOUR)
+// The same colour is sent to all WS2811_LED_STRIP_LENGTH LEDs
 #define WS2811_DATA_BUFFER_SIZE    1
-#define WS2811_DMA_BUFFER_SIZE     (WS2811_DATA_BUFFER_SIZE * WS2811_BITS_PER_LED_MAX)
-// Do 2 extra iterations of the DMA transfer with the output set to low to generate the > 50us delay.
-#define WS2811_DELAY_ITERATIONS    2
 #else
 #define WS2811_DATA_BUFFER_SIZE    WS2811_LED_STRIP_LENGTH
+#endif
+
 // for 50us delay
 #define WS2811_DELAY_BUFFER_LENGTH 42
-// number of bytes needed is #LEDs * 24 bytes + 42 trailing bytes)
-#define WS2811_DMA_BUFFER_SIZE     (WS2811_DATA_BUFFER_SIZE * WS2811_BITS_PER_LED_MAX + WS2811_DELAY_BUFFER_LENGTH)
-#endif
+
+// The DMA buffer is circular. Each half holds the timer compare values for two
+// LEDs, and is encoded from the packed colours while the other half is sent.
+#define WS2811_DMA_HALF_SIZE       (2 * WS2811_BITS_PER_LED_MAX)
+#define WS2811_DMA_BUFFER_SIZE     (2 * WS2811_DMA_HALF_SIZE)
 
 #ifdef USE_LEDSTRIP_CACHE_MGMT
 // WS2811_DMA_BUFFER_SIZE is multiples of uint32_t
@@ -87,6 +89,8 @@ void setUsedLedCount(unsigned ledCount);
 
 bool isWS2811LedStripReady(void);
 
+bool ws2811LedStripDMAHalfComplete(unsigned half);
+
 extern volatile bool ws2811LedDataTransferInProgress;
 
 extern uint16_t BIT_COMPARE_1;
@@ -42,11 +42,30 @@ static IO_t ws2811IO = IO_NONE;
 static TIM_HandleTypeDef TimHandle;
 static uint16_t timerChannel = 0;
 
+static void ws2811DMAStop(DMA_HandleTypeDef *hdma)
+{
+    TIM_DMACmd(&TimHandle, timerChannel, DISABLE);
+    HAL_DMA_Abort(hdma);
+    TimHandle.State = HAL_TIM_STATE_READY;
+}
+
+static void ws2811DMAHalfCplt(DMA_HandleTypeDef *hdma)
+{
+    if (!ws2811LedStripDMAHalfComplete(0)) {
+        ws2811DMAStop(hdma);
+    }
+}
+
+static void ws2811DMACplt(DMA_HandleTypeDef *hdma)
+{
+    if (!ws2811LedStripDMAHalfComplete(1)) {
+        ws2811DMAStop(hdma);
+    }
+}
+
 FAST_IRQ_HANDLER void WS2811_DMA_IRQHandler(dmaChannelDescriptor_t* descriptor)
 {
     HAL_DMA_IRQHandler(TimHandle.hdma[descriptor->userParam]);
-    TIM_DMACmd(&TimHandle, timerChannel, DISABLE);
-    ws2811LedDataTransferInProgress = false;
 }
 
 bool ws2811LedStripHardwareInit(ioTag_t ioTag)
@@ -121,7 +140,7 @@ bool ws2811LedStripHardwareInit(ioTag_t ioTag)
     hdma_tim.Init.MemInc = DMA_MINC_ENABLE;
     hdma_tim.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
     hdma_tim.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
-    hdma_tim.Init.Mode = DMA_NORMAL;
+    hdma_tim.Init.Mode = DMA_CIRCULAR;
     hdma_tim.Init.Priority = DMA_PRIORITY_HIGH;
 #if !defined(STM32G4)
     hdma_tim.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
@@ -147,6 +166,9 @@ bool ws2811LedStripHardwareInit(ioTag_t ioTag)
         return false;
     }
 
+    /* The half transfer interrupt is only enabled with a callback */
+    hdma_tim.XferHalfCpltCallback = ws2811DMAHalfCplt;
+
     TIM_OC_InitTypeDef TIM_OCInitStructure;
 
     /* PWM1 Mode configuration: Channel1 */
@@ -183,6 +205,8 @@ void ws2811LedStripDMAEnable(void)
         ws2811LedDataTransferInProgress = false;
         return;
     }
+    /* Refill the buffer halves as they are sent */
+    TimHandle.hdma[timerDmaIndex(timerChannel)]->XferCpltCallback = ws2811DMACplt;
     /* Reset timer counter */
     __HAL_TIM_SET_COUNTER(&TimHandle,0);
     /* Enable channel DMA requests */
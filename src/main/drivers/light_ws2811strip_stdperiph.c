@@ -49,27 +49,20 @@ static TIM_TypeDef *timer = NULL;
 
 static void WS2811_DMA_IRQHandler(dmaChannelDescriptor_t *descriptor)
 {
-#if defined(USE_WS2811_SINGLE_COLOUR)
-    static uint32_t counter = 0;
-#endif
+    if (DMA_GET_FLAG_STATUS(descriptor, DMA_IT_HTIF)) {
+        DMA_CLEAR_FLAG(descriptor, DMA_IT_HTIF);
 
-    if (DMA_GET_FLAG_STATUS(descriptor, DMA_IT_TCIF)) {
-#if defined(USE_WS2811_SINGLE_COLOUR)
-        counter++;
-        if (counter == WS2811_LED_STRIP_LENGTH) {
-            // Output low for 50us delay
-            memset(ledStripDMABuffer, 0, sizeof(ledStripDMABuffer));
-        } else if (counter == (WS2811_LED_STRIP_LENGTH + WS2811_DELAY_ITERATIONS)) {
-            counter = 0;
-            ws2811LedDataTransferInProgress = false;
+        if (!ws2811LedStripDMAHalfComplete(0)) {
             xDMA_Cmd(descriptor->ref, DISABLE);
         }
-#else
-        ws2811LedDataTransferInProgress = false;
-        xDMA_Cmd(descriptor->ref, DISABLE);
-#endif
+    }
 
+    if (DMA_GET_FLAG_STATUS(descriptor, DMA_IT_TCIF)) {
         DMA_CLEAR_FLAG(descriptor, DMA_IT_TCIF);
+
+        if (!ws2811LedStripDMAHalfComplete(1)) {
+            xDMA_Cmd(descriptor->ref, DISABLE);
+        }
     }
 }
 
@@ -190,15 +183,11 @@ bool ws2811LedStripHardwareInit(ioTag_t ioTag)
     DMA_InitStructure.DMA_Priority = DMA_Priority_VeryHigh;
 #endif
 
-#if defined(USE_WS2811_SINGLE_COLOUR)
     DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
-#else
-    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
-#endif
 
     xDMA_Init(dmaRef, &DMA_InitStructure);
     TIM_DMACmd(timer, timerDmaSource(timerHardware->channel), ENABLE);
-    xDMA_ITConfig(dmaRef, DMA_IT_TC, ENABLE);
+    xDMA_ITConfig(dmaRef, DMA_IT_HT | DMA_IT_TC, ENABLE);
 
     return true;
 }
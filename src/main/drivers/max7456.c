@@ -182,8 +182,11 @@
 
 #define MAX7456_SUPPORTED_LAYER_COUNT (DISPLAYPORT_LAYER_BACKGROUND + 1)
 
+#define MAX7456_ALL_ROWS    ((1 << VIDEO_LINES_PAL) - 1)
+
 typedef struct max7456Layer_s {
     uint8_t buffer[VIDEO_BUFFER_CHARS_PAL];
+    uint16_t dirtyRows;         // Rows written since they were last compared with the shadow buffer
 } max7456Layer_t;
 
 static max7456Layer_t displayLayers[MAX7456_SUPPORTED_LAYER_COUNT];
@@ -207,6 +210,7 @@ static uint8_t shadowBuffer[VIDEO_BUFFER_CHARS_PAL];
 
 #define MAX_BYTES2SEND          250
 #define MAX_BYTES2SEND_POLLED   12
+#define MAX_BYTES2SEND_CHUNK    64      // Whole register writes, a gyro read may run between chunks
 #define MAX_ENCODE_US           20
 #define MAX_ENCODE_US_POLLED    10
 
@@ -273,12 +277,17 @@ uint8_t max7456GetRowsCount(void)
 static void max7456ClearShadowBuffer(void)
 {
     memset(shadowBuffer, 0, maxScreenSize);
+
+    for (int layer = 0; layer < MAX7456_SUPPORTED_LAYER_COUNT; layer++) {
+        displayLayers[layer].dirtyRows = MAX7456_ALL_ROWS;
+    }
 }
 
 // Buffer is filled with the whitespace character (0x20)
 static void max7456ClearLayer(displayPortLayer_e layer)
 {
     memset(getLayerBuffer(layer), 0x20, VIDEO_BUFFER_CHARS_PAL);
+    displayLayers[layer].dirtyRows = MAX7456_ALL_ROWS;
 }
 
 void max7456ReInit(void)
@@ -495,6 +504,7 @@ void max7456WriteChar(uint8_t x, uint8_t y, uint8_t c)
     uint8_t *buffer = getActiveLayerBuffer();
     if (x < CHARS_PER_LINE && y < VIDEO_LINES_PAL) {
         buffer[y * CHARS_PER_LINE + x] = c;
+        displayLayers[activeLayer].dirtyRows |= BIT(y);
     }
 }
 
@@ -505,6 +515,7 @@ void max7456Write(uint8_t x, uint8_t y, const char *buff)
         for (int i = 0; buff[i] && x + i < CHARS_PER_LINE; i++) {
             buffer[y * CHARS_PER_LINE + x + i] = buff[i];
         }
+        displayLayers[activeLayer].dirtyRows |= BIT(y);
     }
 }
 
@@ -531,6 +542,7 @@ bool max7456LayerCopy(displayPortLayer_e destLayer, displayPortLayer_e sourceLay
 {
     if ((sourceLayer != destLayer) && max7456LayerSupported(sourceLayer) && max7456LayerSupported(destLayer)) {
         memcpy(getLayerBuffer(destLayer), getLayerBuffer(sourceLayer), VIDEO_BUFFER_CHARS_PAL);
+        displayLayers[destLayer].dirtyRows = MAX7456_ALL_ROWS;
         return true;
     } else {
         return false;
@@ -615,13 +627,11 @@ bool max7456DrawScreen(void)
 {
     static uint16_t pos = 0;
     // This routine doesn't block so need to use static data
-    static busSegment_t segments[] = {
-            {.u.link = {NULL, NULL}, 0, true, NULL},
-            {.u.link = {NULL, NULL}, 0, true, NULL},
-    };
+    static busSegment_t segments[(MAX_BYTES2SEND + MAX_BYTES2SEND_CHUNK - 1) / MAX_BYTES2SEND_CHUNK + 1];
 
     if (!fontIsLoading) {
-        uint8_t *buffer = getActiveLayerBuffer();
+        max7456Layer_t *layer = &displayLayers[activeLayer];
+        uint8_t *buffer = layer->buffer;
         int spiBufIndex = 0;
         int maxSpiBufStartIndex;
         timeDelta_t maxEncodeTime;
@@ -645,6 +655,31 @@ bool max7456DrawScreen(void)
 
         // Initialise the transfer buffer
         while ((spiBufIndex < maxSpiBufStartIndex) && (pos < posLimit) && (cmpTimeUs(micros(), startTime) < maxEncodeTime)) {
+            if (pos % CHARS_PER_LINE == 0) {
+                const uint16_t rowBit = BIT(pos / CHARS_PER_LINE);
+
+                if (!(layer->dirtyRows & rowBit)) {
+                    // Nothing written to this row, so skip the compare
+                    if (!setAddress) {
+                        setAddress = true;
+                        if (autoInc) {
+                            spiBuf[spiBufIndex++] = MAX7456ADD_DMDI;
+                            spiBuf[spiBufIndex++] = END_STRING;
+                        }
+                    }
+
+                    pos += CHARS_PER_LINE;
+                    if (pos >= maxScreenSize) {
+                        pos = 0;
+                        break;
+                    }
+                    continue;
+                }
+
+                // Writes made before the row is done set the bit again
+                layer->dirtyRows &= ~rowBit;
+            }
+
             if (buffer[pos] != shadowBuffer[pos]) {
                 if (buffer[pos] == 0xff) {
                     buffer[pos] = ' ';
@@ -702,8 +737,21 @@ bool max7456DrawScreen(void)
         }
 
         if (spiBufIndex) {
-            segments[0].u.buffers.txData = spiBuf;
-            segments[0].len = spiBufIndex;
+            int count = 0;
+
+            // Split the transfer so it doesn't hold the bus for its full length
+            for (int index = 0; index < spiBufIndex; index += MAX_BYTES2SEND_CHUNK) {
+                segments[count].u.buffers.txData = &spiBuf[index];
+                segments[count].u.buffers.rxData = NULL;
+                segments[count].len = MIN(spiBufIndex - index, MAX_BYTES2SEND_CHUNK);
+                segments[count].negateCS = true;
+                segments[count].callback = NULL;
+                count++;
+            }
+
+            segments[count].u.link.dev = NULL;
+            segments[count].u.link.segments = NULL;
+            segments[count].len = 0;
 
             spiSequence(dev, &segments[0]);
 
@@ -29,6 +29,7 @@ typedef struct mpuRegion_s {
     uint8_t  shareable;
     uint8_t  cacheable;
     uint8_t  bufferable;
+    uint8_t  tex;        // MPU_TEX_LEVELx, non-cacheable normal memory is level 1
 } mpuRegion_t;
 
 extern mpuRegion_t mpuRegions[];
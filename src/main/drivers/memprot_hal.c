@@ -42,7 +42,6 @@ void memProtConfigure(mpuRegion_t *regions, unsigned regionCount)
     // Setup common members
     MPU_InitStruct.Enable           = MPU_REGION_ENABLE;
     MPU_InitStruct.SubRegionDisable = 0x00;
-    MPU_InitStruct.TypeExtField     = MPU_TEX_LEVEL0;
 
     for (unsigned number = 0; number < regionCount; number++) {
         mpuRegion_t *region = &regions[number];
@@ -81,6 +80,7 @@ void memProtConfigure(mpuRegion_t *regions, unsigned regionCount)
         MPU_InitStruct.IsShareable      = region->shareable;
         MPU_InitStruct.IsCacheable      = region->cacheable;
         MPU_InitStruct.IsBufferable     = region->bufferable;
+        MPU_InitStruct.TypeExtField     = region->tex;
 
         HAL_MPU_ConfigRegion(&MPU_InitStruct);
     }
@@ -47,16 +47,18 @@ mpuRegion_t mpuRegions[] = {
 #endif
 #ifdef USE_DMA_RAM
     {
-        // DMA transmit buffer in D2 SRAM1
-        // Reading needs cache coherence operation
+        // DMA buffers in D2 SRAM1
+        // Normal memory, not cached, so the drivers need no cache maintenance.
+        // The D-cache stays enabled for all other memory.
         .start      = (uint32_t)&dmaram_start,
         .end        = (uint32_t)&dmaram_end,
         .size       = 0,  // Size determined by ".end"
         .perm       = MPU_REGION_FULL_ACCESS,
         .exec       = MPU_INSTRUCTION_ACCESS_ENABLE,
         .shareable  = MPU_ACCESS_SHAREABLE,
-        .cacheable  = MPU_ACCESS_CACHEABLE,
+        .cacheable  = MPU_ACCESS_NOT_CACHEABLE,
         .bufferable = MPU_ACCESS_NOT_BUFFERABLE,
+        .tex        = MPU_TEX_LEVEL1,
     },
     {
         // A region in AXI RAM accessible from SDIO internal DMA
@@ -70,6 +72,20 @@ mpuRegion_t mpuRegions[] = {
         .bufferable = MPU_ACCESS_NOT_BUFFERABLE,
     },
 #endif
+#ifdef USE_QUADSPI
+    {
+        // QSPI memory mapped window, read only.
+        // Strongly ordered to keep speculative reads away while not mapped.
+        .start      = QSPI_BASE,
+        .end        = 0, // Size defined by "size"
+        .size       = MPU_REGION_SIZE_256MB,
+        .perm       = MPU_REGION_PRIV_RO_URO,
+        .exec       = MPU_INSTRUCTION_ACCESS_DISABLE,
+        .shareable  = MPU_ACCESS_SHAREABLE,
+        .cacheable  = MPU_ACCESS_NOT_CACHEABLE,
+        .bufferable = MPU_ACCESS_NOT_BUFFERABLE,
+    },
+#endif
 };
 
 unsigned mpuRegionCount = ARRAYLEN(mpuRegions);
@@ -185,16 +185,21 @@ void motorWriteAll(float *values)
             return;
         }
 #endif
-        for (int i = 0; i < motorDevice->count; i++) {
-            motorDevice->vTable.write(i, motorDevice->motorControlMode[i], values[i]);
+        if (motorDevice->vTable.writeAll) {
+            motorDevice->vTable.writeAll(motorDevice->count, motorDevice->motorControlMode, values);
+        }
+        else {
+            for (int i = 0; i < motorDevice->count; i++) {
+                motorDevice->vTable.write(i, motorDevice->motorControlMode[i], values[i]);
+            }
         }
         motorDevice->vTable.updateComplete();
     }
 #if defined(USE_DSHOT) && defined(USE_DSHOT_TELEMETRY_STATS)
-    if (debugMode == DEBUG_DSHOT_RPM_ERRORS && useDshotTelemetry) {
+    if (debugModeActive(DEBUG_DSHOT_RPM_ERRORS) && useDshotTelemetry) {
         const uint8_t count = MIN(motorDevice->count, 4);
         for (uint8_t i = 0; i < count; i++) {
-            debug[i] = getDshotTelemetryMotorInvalidPercent(i);
+            DEBUG(DSHOT_RPM_ERRORS, i, getDshotTelemetryMotorInvalidPercent(i));
         }
     }
 #endif
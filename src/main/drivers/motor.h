@@ -53,6 +53,7 @@ typedef struct motorVTable_s {
     bool (*updateStart)(void);
     void (*updateComplete)(void);
     void (*write)(uint8_t index, uint8_t mode, float value);
+    void (*writeAll)(uint8_t count, const uint8_t *mode, const float *value);   // optional, NULL => write() per motor
     void (*writeInt)(uint8_t index, uint16_t value);
     bool (*isMotorEnabled)(uint8_t index);
 } motorVTable_t;
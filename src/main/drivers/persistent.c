@@ -138,7 +138,11 @@ void persistentObjectInit(void)
 
     if (!wasSoftReset || (persistentObjectRead(PERSISTENT_OBJECT_MAGIC) != PERSISTENT_OBJECT_MAGIC_VALUE)) {
         for (int i = 1; i < PERSISTENT_OBJECT_COUNT; i++) {
-            persistentObjectWrite(i, 0);
+            // The hardware detection cache is self-validating and also speeds up
+            // the boot after brownout and watchdog resets
+            if (i != PERSISTENT_OBJECT_GYRO_DETECT || persistentObjectRead(PERSISTENT_OBJECT_MAGIC) != PERSISTENT_OBJECT_MAGIC_VALUE) {
+                persistentObjectWrite(i, 0);
+            }
         }
         persistentObjectWrite(PERSISTENT_OBJECT_MAGIC, PERSISTENT_OBJECT_MAGIC_VALUE);
     }
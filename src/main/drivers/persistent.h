@@ -38,6 +38,11 @@ typedef enum {
     PERSISTENT_OBJECT_RTC_HIGH,           // high 32 bits of rtcTime_t
     PERSISTENT_OBJECT_RTC_LOW,            // low 32 bits of rtcTime_t
     PERSISTENT_OBJECT_SERIALRX_BAUD,      // serial rx baudrate
+    PERSISTENT_OBJECT_GYRO_DETECT,        // cached gyro detection result, kept over all warm resets
+    PERSISTENT_OBJECT_LOOP_STALL_PC,      // loop watchdog fault record: preempted PC, zero if none
+    PERSISTENT_OBJECT_LOOP_STALL_LR,      // preempted LR
+    PERSISTENT_OBJECT_LOOP_STALL_SP,      // preempted stack pointer
+    PERSISTENT_OBJECT_LOOP_STALL_INFO,    // task id, stall count
     PERSISTENT_OBJECT_COUNT,
 #ifdef USE_SPRACING_PERSISTENT_RTC_WORKAROUND
     // On SPRACING H7 firmware use this alternate location for all reset reasons interpreted by this firmware
@@ -81,25 +81,8 @@ uint8_t getTimerIndex(TIM_TypeDef *timer)
 }
 
 
-FAST_CODE void pwmWriteDshotInt(uint8_t index, uint16_t value)
+static FAST_CODE void pwmLoadDshotPacket(motorDmaOutput_t *const motor, uint16_t packet)
 {
-    motorDmaOutput_t *const motor = &dmaMotors[index];
-
-    if (!motor->configured) {
-        return;
-    }
-
-    /*If there is a command ready to go overwrite the value and send that instead*/
-    if (dshotCommandIsProcessing()) {
-        value = dshotCommandGetCurrent(index);
-        if (value) {
-            motor->protocolControl.requestTelemetry = true;
-        }
-    }
-
-    motor->protocolControl.value = value;
-
-    uint16_t packet = prepareDshotPacket(&motor->protocolControl);
     uint8_t bufferSize;
 
 #ifdef USE_DSHOT_DMAR
@@ -121,6 +104,65 @@ FAST_CODE void pwmWriteDshotInt(uint8_t index, uint16_t value)
     }
 }
 
+FAST_CODE void pwmWriteDshotInt(uint8_t index, uint16_t value)
+{
+    motorDmaOutput_t *const motor = &dmaMotors[index];
+
+    if (!motor->configured) {
+        return;
+    }
+
+    /*If there is a command ready to go overwrite the value and send that instead*/
+    if (dshotCommandIsProcessing()) {
+        value = dshotCommandGetCurrent(index);
+        if (value) {
+            motor->protocolControl.requestTelemetry = true;
+        }
+    }
+
+    motor->protocolControl.value = value;
+
+    pwmLoadDshotPacket(motor, prepareDshotPacket(&motor->protocolControl));
+}
+
+/*
+ * Encode the packets of all motors in one pass before touching any DMA buffer,
+ * so the buffers are loaded back to back right before the timers are started.
+ */
+FAST_CODE void pwmWriteDshotAll(uint8_t count, const uint16_t *values)
+{
+    uint16_t packets[MAX_SUPPORTED_MOTORS];
+
+    const bool commandProcessing = dshotCommandIsProcessing();
+
+    for (int index = 0; index < count; index++) {
+        motorDmaOutput_t *const motor = &dmaMotors[index];
+        uint16_t value = values[index];
+
+        if (!motor->configured) {
+            continue;
+        }
+
+        if (commandProcessing) {
+            value = dshotCommandGetCurrent(index);
+            if (value) {
+                motor->protocolControl.requestTelemetry = true;
+            }
+        }
+
+        motor->protocolControl.value = value;
+
+        packets[index] = prepareDshotPacket(&motor->protocolControl);
+    }
+
+    for (int index = 0; index < count; index++) {
+        motorDmaOutput_t *const motor = &dmaMotors[index];
+
+        if (motor->configured) {
+            pwmLoadDshotPacket(motor, packets[index]);
+        }
+    }
+}
 
 #ifdef USE_DSHOT_TELEMETRY
 
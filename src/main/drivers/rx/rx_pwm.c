@@ -30,6 +30,8 @@
 
 #include "common/utils.h"
 
+#include "drivers/dma.h"
+#include "drivers/dma_reqmap.h"
 #include "drivers/io.h"
 #include "drivers/nvic.h"
 #include "drivers/pwm_output.h"
@@ -113,8 +115,16 @@ static ppmDevice_t ppmDev;
 #define PPM_IN_MIN_NUM_CHANNELS     4
 #define PPM_IN_MAX_NUM_CHANNELS     PWM_PORTS_OR_PPM_CAPTURE_COUNT
 
+#ifdef USE_PPM_DMA
+static void ppmDmaDecode(void);
+#endif
+
 bool isPPMDataBeingReceived(void)
 {
+#ifdef USE_PPM_DMA
+    ppmDmaDecode();
+#endif
+
     return (ppmFrameCount != lastPPMFrameCount);
 }
 
@@ -175,45 +185,10 @@ static void ppmOverflowCallback(timerOvrHandlerRec_t* cbRec, captureCompare_t ca
     }
 }
 
-static void ppmEdgeCallback(timerCCHandlerRec_t* cbRec, captureCompare_t capture)
+static void ppmProcessPulse(void)
 {
-    UNUSED(cbRec);
-    ppmISREvent(SOURCE_EDGE, capture);
-
     int32_t i;
 
-    uint32_t previousTime = ppmDev.currentTime;
-    uint32_t previousCapture = ppmDev.currentCapture;
-
-    /* Grab the new count */
-    uint32_t currentTime = capture;
-
-    /* Convert to 32-bit timer result */
-    currentTime += ppmDev.largeCounter;
-
-    if (capture < previousCapture) {
-        if (ppmDev.overflowed) {
-            currentTime += PPM_TIMER_PERIOD;
-        }
-    }
-
-    // Divide value if Oneshot, Multishot or brushed motors are active and the timer is shared
-    currentTime = currentTime / ppmCountDivisor;
-
-    /* Capture computation */
-    if (currentTime > previousTime) {
-        ppmDev.deltaTime    = currentTime - (previousTime + (ppmDev.overflowed ? (PPM_TIMER_PERIOD / ppmCountDivisor) : 0));
-    } else {
-        ppmDev.deltaTime    = (PPM_TIMER_PERIOD / ppmCountDivisor) + currentTime - previousTime;
-    }
-
-    ppmDev.overflowed = false;
-
-
-    /* Store the current measurement */
-    ppmDev.currentTime = currentTime;
-    ppmDev.currentCapture = capture;
-
     /* Sync pulse detection */
     if (ppmDev.deltaTime > PPM_IN_MIN_SYNC_PULSE_US) {
         if (ppmDev.pulseIndex == ppmDev.numChannelsPrevFrame
@@ -265,6 +240,179 @@ static void ppmEdgeCallback(timerCCHandlerRec_t* cbRec, captureCompare_t capture
     }
 }
 
+static void ppmEdgeCallback(timerCCHandlerRec_t* cbRec, captureCompare_t capture)
+{
+    UNUSED(cbRec);
+    ppmISREvent(SOURCE_EDGE, capture);
+
+    uint32_t previousTime = ppmDev.currentTime;
+    uint32_t previousCapture = ppmDev.currentCapture;
+
+    /* Grab the new count */
+    uint32_t currentTime = capture;
+
+    /* Convert to 32-bit timer result */
+    currentTime += ppmDev.largeCounter;
+
+    if (capture < previousCapture) {
+        if (ppmDev.overflowed) {
+            currentTime += PPM_TIMER_PERIOD;
+        }
+    }
+
+    // Divide value if Oneshot, Multishot or brushed motors are active and the timer is shared
+    currentTime = currentTime / ppmCountDivisor;
+
+    /* Capture computation */
+    if (currentTime > previousTime) {
+        ppmDev.deltaTime    = currentTime - (previousTime + (ppmDev.overflowed ? (PPM_TIMER_PERIOD / ppmCountDivisor) : 0));
+    } else {
+        ppmDev.deltaTime    = (PPM_TIMER_PERIOD / ppmCountDivisor) + currentTime - previousTime;
+    }
+
+    ppmDev.overflowed = false;
+
+
+    /* Store the current measurement */
+    ppmDev.currentTime = currentTime;
+    ppmDev.currentCapture = capture;
+
+    ppmProcessPulse();
+}
+
+#ifdef USE_PPM_DMA
+/*
+ * PPM input capture by DMA
+ *
+ * Every capture on the PPM channel raises a DMA request, and a circular
+ * stream copies the captured count into a ring of timestamps. No interrupt
+ * is taken per edge; the edges are decoded in bulk when the RX task polls
+ * for a new frame. The ring holds several frames, so it only overruns if
+ * the RX task stalls for longer than that.
+ *
+ * The timer runs free at 1MHz with a 16-bit period, so the pulse lengths
+ * are plain 16-bit differences of the timestamps.
+ */
+
+#define PPM_DMA_BUFFER_SIZE     64
+
+static volatile DMA_DATA_ZERO_INIT uint16_t ppmDmaBuffer[PPM_DMA_BUFFER_SIZE];
+
+static struct {
+    dmaResource_t *dmaRef;
+    uint16_t readIndex;
+    uint16_t lastCapture;
+} ppmDma;
+
+static void ppmDmaDecode(void)
+{
+    if (!ppmDma.dmaRef) {
+        return;
+    }
+
+#ifdef USE_HAL_DRIVER
+    const unsigned remaining = xLL_EX_DMA_GetDataLength(ppmDma.dmaRef);
+#else
+    const unsigned remaining = xDMA_GetCurrDataCounter(ppmDma.dmaRef);
+#endif
+    const unsigned writeIndex = (PPM_DMA_BUFFER_SIZE - remaining) % PPM_DMA_BUFFER_SIZE;
+
+    while (ppmDma.readIndex != writeIndex) {
+        const uint16_t capture = ppmDmaBuffer[ppmDma.readIndex];
+
+        ppmDev.deltaTime = (uint16_t)(capture - ppmDma.lastCapture);
+        ppmDma.lastCapture = capture;
+        ppmDma.readIndex = (ppmDma.readIndex + 1) % PPM_DMA_BUFFER_SIZE;
+
+        ppmProcessPulse();
+    }
+}
+
+static bool ppmDmaInit(const timerHardware_t *timer)
+{
+    dmaResource_t *dmaRef = NULL;
+    uint32_t dmaChannel = 0;
+#if defined(USE_DMA_SPEC)
+    const dmaChannelSpec_t *dmaSpec = dmaGetChannelSpecByTimer(timer);
+
+    if (dmaSpec != NULL) {
+        dmaRef = dmaSpec->ref;
+        dmaChannel = dmaSpec->channel;
+    }
+#else
+    dmaRef = timer->dmaRef;
+    dmaChannel = timer->dmaChannel;
+#endif
+
+    if (dmaRef == NULL) {
+        return false;
+    }
+
+    const dmaIdentifier_e dmaIdentifier = dmaGetIdentifier(dmaRef);
+
+    if (!dmaAllocate(dmaIdentifier, OWNER_PPMINPUT, 0)) {
+        return false;
+    }
+
+    dmaEnable(dmaIdentifier);
+
+#ifdef USE_HAL_DRIVER
+    LL_DMA_InitTypeDef dmaInit;
+
+    LL_DMA_StructInit(&dmaInit);
+#if defined(STM32H7) || defined(STM32G4)
+    dmaInit.PeriphRequest = dmaChannel;
+#else
+    dmaInit.Channel = dmaChannel;
+#endif
+    dmaInit.PeriphOrM2MSrcAddress = (uint32_t)timerChCCR(timer);
+    dmaInit.MemoryOrM2MDstAddress = (uint32_t)ppmDmaBuffer;
+    dmaInit.Direction = LL_DMA_DIRECTION_PERIPH_TO_MEMORY;
+    dmaInit.NbData = PPM_DMA_BUFFER_SIZE;
+    dmaInit.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
+    dmaInit.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
+    dmaInit.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_HALFWORD;
+    dmaInit.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_HALFWORD;
+    dmaInit.Mode = LL_DMA_MODE_CIRCULAR;
+    dmaInit.Priority = LL_DMA_PRIORITY_MEDIUM;
+
+    xLL_EX_DMA_DisableResource(dmaRef);
+    xLL_EX_DMA_DeInit(dmaRef);
+    xLL_EX_DMA_Init(dmaRef, &dmaInit);
+    xLL_EX_DMA_EnableResource(dmaRef);
+
+    LL_EX_TIM_EnableIT(timer->tim, timerDmaSource(timer->channel));
+#else
+    DMA_InitTypeDef dmaInit;
+
+    DMA_StructInit(&dmaInit);
+    dmaInit.DMA_Channel = dmaChannel;
+    dmaInit.DMA_PeripheralBaseAddr = (uint32_t)timerChCCR(timer);
+    dmaInit.DMA_Memory0BaseAddr = (uint32_t)ppmDmaBuffer;
+    dmaInit.DMA_DIR = DMA_DIR_PeripheralToMemory;
+    dmaInit.DMA_BufferSize = PPM_DMA_BUFFER_SIZE;
+    dmaInit.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    dmaInit.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    dmaInit.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+    dmaInit.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+    dmaInit.DMA_Mode = DMA_Mode_Circular;
+    dmaInit.DMA_Priority = DMA_Priority_Medium;
+
+    xDMA_Cmd(dmaRef, DISABLE);
+    xDMA_DeInit(dmaRef);
+    xDMA_Init(dmaRef, &dmaInit);
+    xDMA_Cmd(dmaRef, ENABLE);
+
+    TIM_DMACmd(timer->tim, timerDmaSource(timer->channel), ENABLE);
+#endif
+
+    ppmDma.dmaRef = dmaRef;
+    ppmDma.readIndex = 0;
+
+    return true;
+}
+#endif
+
 #define MAX_MISSED_PWM_EVENTS 10
 
 bool isPWMDataBeingReceived(void)
@@ -451,6 +599,13 @@ void ppmRxInit(const ppmConfig_t *ppmConfig)
 #else
     pwmICConfig(timer->tim, timer->channel, TIM_ICPolarity_Rising);
 #endif
+
+#ifdef USE_PPM_DMA
+    // A timer shared with the motors does not run at 1MHz: keep the interrupts
+    if (ppmCountDivisor == 1 && ppmDmaInit(timer)) {
+        timerChConfigCallbacks(timer, NULL, NULL);
+    }
+#endif
 }
 
 uint16_t ppmRead(uint8_t channel)
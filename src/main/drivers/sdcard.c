@@ -20,6 +20,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -30,6 +31,8 @@
 #include "dma.h"
 #include "dma_reqmap.h"
 
+#include "common/maths.h"
+
 #include "drivers/bus_spi.h"
 #include "drivers/time.h"
 
@@ -181,4 +184,37 @@ const sdcardMetadata_t* sdcard_getMetadata(void)
 {
     return sdcardVTable->sdcard_getMetadata();
 }
+
+/**
+ * Latency statistics
+ */
+static sdcardLatencyStats_t sdcardReadLatency;
+static sdcardLatencyStats_t sdcardWriteLatency;
+
+void sdcard_recordLatency(sdcardBlockOperation_e operation, uint32_t durationUs)
+{
+    sdcardLatencyStats_t *stats = (operation == SDCARD_BLOCK_OPERATION_READ) ? &sdcardReadLatency : &sdcardWriteLatency;
+
+    int index = 0;
+    uint32_t limit = SDCARD_LATENCY_BUCKET_BASE_US;
+
+    while (index < SDCARD_LATENCY_BUCKET_COUNT - 1 && durationUs >= limit) {
+        limit <<= 1;
+        index++;
+    }
+
+    stats->bucket[index]++;
+    stats->maxUs = MAX(stats->maxUs, durationUs);
+}
+
+const sdcardLatencyStats_t *sdcard_getLatencyStats(sdcardBlockOperation_e operation)
+{
+    return (operation == SDCARD_BLOCK_OPERATION_READ) ? &sdcardReadLatency : &sdcardWriteLatency;
+}
+
+void sdcard_resetLatencyStats(void)
+{
+    memset(&sdcardReadLatency, 0, sizeof(sdcardReadLatency));
+    memset(&sdcardWriteLatency, 0, sizeof(sdcardWriteLatency));
+}
 #endif
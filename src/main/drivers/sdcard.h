@@ -73,3 +73,20 @@ bool sdcard_poll(void);
 const sdcardMetadata_t* sdcard_getMetadata(void);
 
 void sdcard_setProfilerCallback(sdcard_profilerCallback_c callback);
+
+/*
+ * Latency histogram of completed block operations. Bucket N counts the
+ * operations that took less than 250us << N, the last bucket collects
+ * everything slower.
+ */
+#define SDCARD_LATENCY_BUCKET_COUNT     8
+#define SDCARD_LATENCY_BUCKET_BASE_US   250
+
+typedef struct sdcardLatencyStats_s {
+    uint32_t bucket[SDCARD_LATENCY_BUCKET_COUNT];
+    uint32_t maxUs;
+} sdcardLatencyStats_t;
+
+void sdcard_recordLatency(sdcardBlockOperation_e operation, uint32_t durationUs);
+const sdcardLatencyStats_t *sdcard_getLatencyStats(sdcardBlockOperation_e operation);
+void sdcard_resetLatencyStats(void);
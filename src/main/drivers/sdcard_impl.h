@@ -30,9 +30,8 @@
 #include "sdcard.h"
 #include "sdcard_standard.h"
 
-#ifdef AFATFS_USE_INTROSPECTIVE_LOGGING
-    #define SDCARD_PROFILING
-#endif
+// Operation timing is always collected for the latency histograms
+#define SDCARD_PROFILING
 
 #define SDCARD_TIMEOUT_INIT_MILLIS                  200
 #define SDCARD_MAX_CONSECUTIVE_FAILURES             8
@@ -85,6 +85,9 @@ static bool sdcardSdio_isFunctional(void)
  */
 static void sdcard_reset(void)
 {
+    // Whatever was gathered for the failed chain is lost
+    cache_reset();
+
     if (SD_Init() != 0) {
         sdcard.failureCount++;
         if (sdcard.failureCount >= SDCARD_MAX_CONSECUTIVE_FAILURES || !sdcard_isInserted()) {
@@ -270,8 +273,21 @@ static bool sdcard_isReady()
 static sdcardOperationStatus_e sdcard_endWriteBlocks()
 {
     sdcard.multiWriteBlocksRemain = 0;
-    if (sdcard.useCache) {
-        cache_reset();
+
+    if (cache_getCount() > 0) {
+        // The caller was told the cached blocks were written, so they must go out before the chain can end
+        const uint16_t blockCount = cache_getCount();
+
+        sdcard.pendingOperation.buffer = NULL;
+        sdcard.pendingOperation.blockIndex = sdcard.multiWriteNextBlock - 1;
+        sdcard.pendingOperation.callback = NULL;
+        sdcard.state = SDCARD_STATE_SENDING_WRITE;
+
+        if (SD_WriteBlocks_DMA(sdcard.multiWriteNextBlock - blockCount, (uint32_t*) writeCache, 512, blockCount) != SD_OK) {
+            sdcard_reset();
+        }
+
+        return SDCARD_OPERATION_IN_PROGRESS;
     }
 
     // 8 dummy clocks to guarantee N_WR clocks between the last card response and this token
@@ -287,6 +303,18 @@ static sdcardOperationStatus_e sdcard_endWriteBlocks()
         return SDCARD_OPERATION_IN_PROGRESS;
     }
 }
+
+static void sdcard_profileOperation(sdcardBlockOperation_e operation)
+{
+    const uint32_t duration = micros() - sdcard.pendingOperation.profileStartTime;
+
+    sdcard_recordLatency(operation, duration);
+
+    if (sdcard.profiler) {
+        sdcard.profiler(operation, sdcard.pendingOperation.blockIndex, duration);
+    }
+}
+
 /**
  * Call periodically for the SD card to perform in-progress transfers.
  *
@@ -363,12 +391,13 @@ static bool sdcardSdio_poll(void)
                 sdcard.failureCount = 0; // Assume the card is good if it can complete a write
 
                 // Still more blocks left to write in a multi-block chain?
-                if (sdcard.multiWriteBlocksRemain > 1) {
+                if (cache_getCount() > 0) {
+                    // The cached blocks were already counted off the chain as they were accepted
+                    cache_reset();
+                    sdcard.state = (sdcard.multiWriteBlocksRemain > 0) ? SDCARD_STATE_WRITING_MULTIPLE_BLOCKS : SDCARD_STATE_READY;
+                } else if (sdcard.multiWriteBlocksRemain > 1) {
                     sdcard.multiWriteBlocksRemain--;
                     sdcard.multiWriteNextBlock++;
-                    if (sdcard.useCache) {
-                        cache_reset();
-                    }
                     sdcard.state = SDCARD_STATE_WRITING_MULTIPLE_BLOCKS;
                 } else if (sdcard.multiWriteBlocksRemain == 1) {
                     // This function changes the sd card state for us whether immediately succesful or delayed:
@@ -378,8 +407,8 @@ static bool sdcardSdio_poll(void)
                 }
 
 #ifdef SDCARD_PROFILING
-                if (profilingComplete && sdcard.profiler) {
-                    sdcard.profiler(SDCARD_BLOCK_OPERATION_WRITE, sdcard.pendingOperation.blockIndex, micros() - sdcard.pendingOperation.profileStartTime);
+                if (profilingComplete) {
+                    sdcard_profileOperation(SDCARD_BLOCK_OPERATION_WRITE);
                 }
 #endif
             } else if (millis() > sdcard.operationStartTime + SDCARD_TIMEOUT_WRITE_MSEC) {
@@ -400,9 +429,7 @@ static bool sdcardSdio_poll(void)
                     sdcard.failureCount = 0; // Assume the card is good if it can complete a read
 
 #ifdef SDCARD_PROFILING
-                    if (sdcard.profiler) {
-                        sdcard.profiler(SDCARD_BLOCK_OPERATION_READ, sdcard.pendingOperation.blockIndex, micros() - sdcard.pendingOperation.profileStartTime);
-                    }
+                    sdcard_profileOperation(SDCARD_BLOCK_OPERATION_READ);
 #endif
 
                     if (sdcard.pendingOperation.callback) {
@@ -430,9 +457,7 @@ static bool sdcardSdio_poll(void)
                 sdcard.state = SDCARD_STATE_READY;
 
 #ifdef SDCARD_PROFILING
-                if (sdcard.profiler) {
-                    sdcard.profiler(SDCARD_BLOCK_OPERATION_WRITE, sdcard.pendingOperation.blockIndex, micros() - sdcard.pendingOperation.profileStartTime);
-                }
+                sdcard_profileOperation(SDCARD_BLOCK_OPERATION_WRITE);
 #endif
             } else if (millis() > sdcard.operationStartTime + SDCARD_TIMEOUT_WRITE_MSEC) {
                 sdcard_reset();
@@ -499,21 +524,23 @@ static sdcardOperationStatus_e sdcardSdio_writeBlock(uint32_t blockIndex, uint8_
     sdcard.pendingOperation.blockIndex = blockIndex;
 
     uint16_t block_count = 1;
-    if ((cache_getCount() < FATFS_BLOCK_CACHE_SIZE) &&
-        (sdcard.multiWriteBlocksRemain != 0) && sdcard.useCache) {
+    if (sdcard.useCache && sdcard.state == SDCARD_STATE_WRITING_MULTIPLE_BLOCKS) {
+        /* Gather the consecutive blocks of the chain and send them with a single CMD25 transfer. The blocks are
+         * taken off the chain as they are cached, so the caller can reuse the buffer straight away.
+         */
         cache_write(buffer);
-        if (cache_getCount() == FATFS_BLOCK_CACHE_SIZE || sdcard.multiWriteBlocksRemain == 1) {
-            //Relocate buffer
-            buffer = (uint8_t*)writeCache;
-            //Recalculate block index
-            blockIndex -= cache_getCount() - 1;
-            block_count = cache_getCount();
-        } else {
-            sdcard.multiWriteBlocksRemain--;
-            sdcard.multiWriteNextBlock++;
-            sdcard.state = SDCARD_STATE_READY;
+        sdcard.multiWriteBlocksRemain--;
+        sdcard.multiWriteNextBlock++;
+
+        if (cache_getCount() < FATFS_BLOCK_CACHE_SIZE && sdcard.multiWriteBlocksRemain > 0) {
             return SDCARD_OPERATION_SUCCESS;
         }
+
+        //Relocate buffer
+        buffer = (uint8_t*)writeCache;
+        //Recalculate block index
+        blockIndex -= cache_getCount() - 1;
+        block_count = cache_getCount();
     }
 
     sdcard.pendingOperation.callback = callback;
@@ -644,6 +644,17 @@ static sdcardOperationStatus_e sdcard_endWriteBlocks(void)
     }
 }
 
+static void sdcard_profileOperation(sdcardBlockOperation_e operation)
+{
+    const uint32_t duration = micros() - sdcard.pendingOperation.profileStartTime;
+
+    sdcard_recordLatency(operation, duration);
+
+    if (sdcard.profiler) {
+        sdcard.profiler(operation, sdcard.pendingOperation.blockIndex, duration);
+    }
+}
+
 /**
  * Call periodically for the SD card to perform in-progress transfers.
  *
@@ -811,8 +822,8 @@ static bool sdcardSpi_poll(void)
                 }
 
 #ifdef SDCARD_PROFILING
-                if (profilingComplete && sdcard.profiler) {
-                    sdcard.profiler(SDCARD_BLOCK_OPERATION_WRITE, sdcard.pendingOperation.blockIndex, micros() - sdcard.pendingOperation.profileStartTime);
+                if (profilingComplete) {
+                    sdcard_profileOperation(SDCARD_BLOCK_OPERATION_WRITE);
                 }
 #endif
             } else if (millis() > sdcard.operationStartTime + SDCARD_TIMEOUT_WRITE_MSEC) {
@@ -834,9 +845,7 @@ static bool sdcardSpi_poll(void)
                     sdcard.failureCount = 0; // Assume the card is good if it can complete a read
 
 #ifdef SDCARD_PROFILING
-                    if (sdcard.profiler) {
-                        sdcard.profiler(SDCARD_BLOCK_OPERATION_READ, sdcard.pendingOperation.blockIndex, micros() - sdcard.pendingOperation.profileStartTime);
-                    }
+                    sdcard_profileOperation(SDCARD_BLOCK_OPERATION_READ);
 #endif
 
                     if (sdcard.pendingOperation.callback) {
@@ -880,9 +889,7 @@ static bool sdcardSpi_poll(void)
                 sdcard.state = SDCARD_STATE_READY;
 
 #ifdef SDCARD_PROFILING
-                if (sdcard.profiler) {
-                    sdcard.profiler(SDCARD_BLOCK_OPERATION_WRITE, sdcard.pendingOperation.blockIndex, micros() - sdcard.pendingOperation.profileStartTime);
-                }
+                sdcard_profileOperation(SDCARD_BLOCK_OPERATION_WRITE);
 #endif
             } else if (millis() > sdcard.operationStartTime + SDCARD_TIMEOUT_WRITE_MSEC) {
                 sdcard_reset();
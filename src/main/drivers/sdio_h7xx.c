@@ -36,6 +36,7 @@
 
 #include "pg/sdio.h"
 
+#include "drivers/dma.h"
 #include "drivers/io.h"
 #include "drivers/io_impl.h"
 #include "drivers/nvic.h"
@@ -564,7 +565,7 @@ SD_Error_t SD_WriteBlocks_DMA(uint64_t WriteAddress, uint32_t *buffer, uint32_t
     }
 
     // Ensure the data is flushed to main memory
-    SCB_CleanDCache_by_Addr(buffer, NumberOfBlocks * BlockSize);
+    dmaCacheClean(buffer, NumberOfBlocks * BlockSize);
 
     HAL_StatusTypeDef status;
     if ((status = HAL_SD_WriteBlocks_DMA(&hsd1, (uint8_t *)buffer, WriteAddress, NumberOfBlocks)) != HAL_OK) {
@@ -631,12 +632,7 @@ void HAL_SD_RxCpltCallback(SD_HandleTypeDef *hsd)
 
     SD_Handle.RXCplt = 0;
 
-    /*
-       the SCB_InvalidateDCache_by_Addr() requires a 32-Byte aligned address,
-       adjust the address and the D-Cache size to invalidate accordingly.
-     */
-    uint32_t alignedAddr = (uint32_t)sdReadParameters.buffer &  ~0x1F;
-    SCB_InvalidateDCache_by_Addr((uint32_t*)alignedAddr, sdReadParameters.NumberOfBlocks * sdReadParameters.BlockSize + ((uint32_t)sdReadParameters.buffer - alignedAddr));
+    dmaCacheInvalidate(sdReadParameters.buffer, sdReadParameters.NumberOfBlocks * sdReadParameters.BlockSize);
 }
 
 void HAL_SD_ErrorCallback(SD_HandleTypeDef *hsd)
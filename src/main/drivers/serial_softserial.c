@@ -94,6 +94,8 @@ typedef struct softSerial_s {
     uint8_t          softSerialPortIndex;
     timerMode_e      timerMode;
 
+    volatile bool    bitClockActive;
+
     timerOvrHandlerRec_t overCb;
     timerCCHandlerRec_t edgeCb;
 } softSerial_t;
@@ -202,6 +204,43 @@ static void serialTimerConfigureTimebase(const timerHardware_t *timerHardwarePtr
     timerConfigure(timerHardwarePtr, timerPeriod, baseClock);
 }
 
+// The bit clock interrupt only runs while a byte is being sent or received.
+// It is stopped when the port goes idle, and restarted by a write or a start bit.
+static void serialBitClockEnable(softSerial_t *softSerial, bool enable)
+{
+    timerOvrHandlerRec_t *overCb = enable ? &softSerial->overCb : NULL;
+
+    if (softSerial->timerMode == TIMER_MODE_DUAL) {
+        timerChConfigCallbacks(softSerial->exTimerHardware, NULL, overCb);
+    } else {
+        timerChConfigCallbacks(softSerial->timerHardware, &softSerial->edgeCb, overCb);
+    }
+
+    softSerial->bitClockActive = enable;
+}
+
+static void serialBitClockStart(softSerial_t *softSerial)
+{
+    if (!softSerial->bitClockActive) {
+        const timerHardware_t *timerHardware = (softSerial->timerMode == TIMER_MODE_DUAL) ? softSerial->exTimerHardware : softSerial->timerHardware;
+
+        // A stale update flag would end the first bit period right away.
+        // It is left alone if another user of the timer has the interrupt enabled.
+        if (!(timerHardware->tim->DIER & TIM_DIER_UIE)) {
+            timerHardware->tim->SR = (uint32_t)~TIM_SR_UIF;
+        }
+
+        serialBitClockEnable(softSerial, true);
+    }
+}
+
+static bool serialIsIdle(const softSerial_t *softSerial)
+{
+    return !softSerial->isTransmittingData && isSoftSerialTransmitBufferEmpty(&softSerial->port)
+        && (softSerial->rxActive || !(softSerial->port.options & SERIAL_BIDIR))
+        && (softSerial->isSearchingForStartBit || !(softSerial->port.mode & MODE_RX));
+}
+
 static void resetBuffers(softSerial_t *softSerial)
 {
     softSerial->port.rxBufferSize = SOFTSERIAL_BUFFER_SIZE;
@@ -317,6 +356,9 @@ serialPort_t *openSoftSerial(softSerialPortIndex_e portIndex, serialReceiveCallb
         timerChConfigCallbacks(softSerial->timerHardware, &softSerial->edgeCb, &softSerial->overCb);
     }
 
+    // Stopped on the first bit period if there is nothing to do
+    softSerial->bitClockActive = true;
+
 #ifdef USE_HAL_DRIVER
     softSerial->timerHandle = timerFindTimerHandle(softSerial->timerHardware->tim);
 #endif
@@ -476,6 +518,10 @@ void onSerialTimerOverflow(timerOvrHandlerRec_t *cbRec, captureCompare_t capture
 
     if (self->port.mode & MODE_RX)
         processRxState(self);
+
+    if (serialIsIdle(self)) {
+        serialBitClockEnable(self, false);
+    }
 }
 
 void onSerialRxPinChange(timerCCHandlerRec_t *cbRec, captureCompare_t capture)
@@ -518,6 +564,8 @@ void onSerialRxPinChange(timerCCHandlerRec_t *cbRec, captureCompare_t capture)
         self->rxLastLeadingEdgeAtBitIndex = 0;
         self->internalRxBuffer = 0;
         self->isSearchingForStartBit = false;
+
+        serialBitClockStart(self);
         return;
     }
 
@@ -593,6 +641,10 @@ void softSerialWriteByte(serialPort_t *s, uint8_t ch)
 
     s->txBuffer[s->txBufferHead] = ch;
     s->txBufferHead = (s->txBufferHead + 1) % s->txBufferSize;
+
+    ATOMIC_BLOCK(NVIC_PRIO_TIMER) {
+        serialBitClockStart((softSerial_t *)s);
+    }
 }
 
 void softSerialSetBaudRate(serialPort_t *s, uint32_t baudRate)
@@ -44,9 +44,14 @@ static const struct serialPortVTable tcpVTable; // Forward
 static tcpPort_t tcpSerialPorts[SERIAL_PORT_COUNT];
 static bool tcpPortInitialized[SERIAL_PORT_COUNT];
 static bool tcpStart = false;
+static int tcpPortOffset = 0;
 bool tcpIsStart(void) {
     return tcpStart;
 }
+// UARTx binds on BASE_PORT + offset + x
+void tcpSetPortOffset(int offset) {
+    tcpPortOffset = offset;
+}
 static void onData(dyad_Event *e) {
     tcpPort_t* s = (tcpPort_t*)(e->udata);
     tcpDataIn(s, (uint8_t*)e->data, e->size);
@@ -106,10 +111,10 @@ static tcpPort_t* tcpReconfigure(tcpPort_t *s, int id)
     dyad_setNoDelay(s->serv, 1);
     dyad_addListener(s->serv, DYAD_EVENT_ACCEPT, onAccept, s);
 
-    if (dyad_listenEx(s->serv, NULL, BASE_PORT + id + 1, 10) == 0) {
-        fprintf(stderr, "bind port %u for UART%u\n", (unsigned)BASE_PORT + id + 1, (unsigned)id + 1);
+    if (dyad_listenEx(s->serv, NULL, BASE_PORT + tcpPortOffset + id + 1, 10) == 0) {
+        fprintf(stderr, "bind port %u for UART%u\n", (unsigned)BASE_PORT + tcpPortOffset + id + 1, (unsigned)id + 1);
     } else {
-        fprintf(stderr, "bind port %u for UART%u failed!!\n", (unsigned)BASE_PORT + id + 1, (unsigned)id + 1);
+        fprintf(stderr, "bind port %u for UART%u failed!!\n", (unsigned)BASE_PORT + tcpPortOffset + id + 1, (unsigned)id + 1);
     }
     return s;
 }
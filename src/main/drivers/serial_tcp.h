@@ -48,5 +48,6 @@ void tcpDataIn(tcpPort_t *instance, uint8_t* ch, int size);
 void tcpDataOut(tcpPort_t *instance);
 
 bool tcpIsStart(void);
+void tcpSetPortOffset(int offset);
 bool* tcpGetUsed(void);
 tcpPort_t* tcpGetPool(void);
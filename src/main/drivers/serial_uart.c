@@ -27,6 +27,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -34,6 +35,7 @@
 
 #include "build/build_config.h"
 
+#include "common/maths.h"
 #include "common/utils.h"
 
 #include "drivers/dma.h"
@@ -115,6 +117,39 @@ LPUART_BUFFERS(1);
 
 #undef UART_BUFFERS
 
+#if UART_RX_BUFFER_POOL_SIZE > 0
+static UART_RX_BUFFER_ATTRIBUTE volatile uint8_t uartRxBufferPool[UART_RX_BUFFER_POOL_SIZE];
+static unsigned uartRxBufferPoolUsed;
+#endif
+
+// An RX buffer configured larger than the static one is taken from the pool
+// on the first open, and kept by the device for later opens. The static
+// buffer is used if the pool has run out.
+static void uartConfigureRxBuffer(uartDevice_t *uartdev)
+{
+    uartPort_t *uartPort = &uartdev->port;
+
+    if (!uartdev->rxBuffer) {
+        uartdev->rxBuffer = uartPort->port.rxBuffer;
+        uartdev->rxBufferSize = uartPort->port.rxBufferSize;
+
+#if UART_RX_BUFFER_POOL_SIZE > 0
+        const UARTDevice_e device = uartdev->hardware->device;
+        if (device < UARTDEV_CONFIG_MAX) {
+            const unsigned size = serialUartConfig(device)->rxBufferSize;
+            if (size > uartdev->rxBufferSize && size <= UART_RX_BUFFER_POOL_SIZE - uartRxBufferPoolUsed) {
+                uartdev->rxBuffer = &uartRxBufferPool[uartRxBufferPoolUsed];
+                uartdev->rxBufferSize = size;
+                uartRxBufferPoolUsed += MIN((size + 3) & ~3U, UART_RX_BUFFER_POOL_SIZE - uartRxBufferPoolUsed);
+            }
+        }
+#endif
+    }
+
+    uartPort->port.rxBuffer = uartdev->rxBuffer;
+    uartPort->port.rxBufferSize = uartdev->rxBufferSize;
+}
+
 serialPort_t *uartOpen(UARTDevice_e device, serialReceiveCallbackPtr rxCallback, void *rxCallbackData, uint32_t baudRate, portMode_e mode, portOptions_e options)
 {
     uartPort_t *uartPort = serialUART(device, baudRate, mode, options);
@@ -122,9 +157,12 @@ serialPort_t *uartOpen(UARTDevice_e device, serialReceiveCallbackPtr rxCallback,
     if (!uartPort)
         return (serialPort_t *)uartPort;
 
+    uartConfigureRxBuffer(container_of(uartPort, uartDevice_t, port));
+
 #ifdef USE_DMA
     uartPort->txDMAEmpty = true;
 #endif
+    uartPort->txDeferred = false;
 
     // common serial initialisation code should move to serialPort::init()
     uartPort->port.rxBufferHead = uartPort->port.rxBufferTail = 0;
@@ -263,18 +301,8 @@ static uint8_t uartRead(serialPort_t *instance)
     return ch;
 }
 
-static void uartWrite(serialPort_t *instance, uint8_t ch)
+static void uartStartTx(uartPort_t *uartPort)
 {
-    uartPort_t *uartPort = (uartPort_t *)instance;
-
-    uartPort->port.txBuffer[uartPort->port.txBufferHead] = ch;
-
-    if (uartPort->port.txBufferHead + 1 >= uartPort->port.txBufferSize) {
-        uartPort->port.txBufferHead = 0;
-    } else {
-        uartPort->port.txBufferHead++;
-    }
-
 #ifdef USE_DMA
     if (uartPort->txDMAResource) {
         uartTryStartTxDMA(uartPort);
@@ -289,6 +317,73 @@ static void uartWrite(serialPort_t *instance, uint8_t ch)
     }
 }
 
+static void uartWrite(serialPort_t *instance, uint8_t ch)
+{
+    uartPort_t *uartPort = (uartPort_t *)instance;
+
+    uartPort->port.txBuffer[uartPort->port.txBufferHead] = ch;
+
+    if (uartPort->port.txBufferHead + 1 >= uartPort->port.txBufferSize) {
+        uartPort->port.txBufferHead = 0;
+    } else {
+        uartPort->port.txBufferHead++;
+    }
+
+    uartStartTx(uartPort);
+}
+
+// Copy a buffer into the TX ring in at most two chunks. Between
+// beginWrite and endWrite the transmission is only started at the end,
+// so that a frame written in pieces goes out in a single DMA transfer.
+static void uartWriteBuf(serialPort_t *instance, const void *data, int count)
+{
+    uartPort_t *uartPort = (uartPort_t *)instance;
+    const uint8_t *p = data;
+
+    while (count > 0) {
+        const uint32_t bytesFree = uartTotalTxBytesFree(instance);
+
+        if (bytesFree == 0) {
+            // Ring is full, send what has been gathered so far
+            uartStartTx(uartPort);
+            continue;
+        }
+
+        const uint32_t head = uartPort->port.txBufferHead;
+        const uint32_t chunk = MIN(MIN((uint32_t)count, bytesFree), uartPort->port.txBufferSize - head);
+
+        memcpy((uint8_t *)&uartPort->port.txBuffer[head], p, chunk);
+        __DMB();
+
+        uartPort->port.txBufferHead = (head + chunk >= uartPort->port.txBufferSize) ? 0 : head + chunk;
+
+        p += chunk;
+        count -= chunk;
+    }
+
+    if (!uartPort->txDeferred) {
+        uartStartTx(uartPort);
+    }
+}
+
+static void uartBeginWrite(serialPort_t *instance)
+{
+    uartPort_t *uartPort = (uartPort_t *)instance;
+
+    uartPort->txDeferred = true;
+}
+
+static void uartEndWrite(serialPort_t *instance)
+{
+    uartPort_t *uartPort = (uartPort_t *)instance;
+
+    uartPort->txDeferred = false;
+
+    if (uartPort->port.txBufferHead != uartPort->port.txBufferTail) {
+        uartStartTx(uartPort);
+    }
+}
+
 const struct serialPortVTable uartVTable[] = {
     {
         .serialWrite = uartWrite,
@@ -300,9 +395,9 @@ const struct serialPortVTable uartVTable[] = {
         .setMode = uartSetMode,
         .setCtrlLineStateCb = NULL,
         .setBaudRateCb = NULL,
-        .writeBuf = NULL,
-        .beginWrite = NULL,
-        .endWrite = NULL,
+        .writeBuf = uartWriteBuf,
+        .beginWrite = uartBeginWrite,
+        .endWrite = uartEndWrite,
     }
 };
 
@@ -325,7 +420,7 @@ void uartConfigureDma(uartDevice_t *uartdev)
     }
 
     if (serialUartConfig(device)->rxDmaopt != DMA_OPT_UNUSED) {
-        dmaChannelSpec = dmaGetChannelSpecByPeripheral(DMA_PERIPH_UART_RX, device, serialUartConfig(device)->txDmaopt);
+        dmaChannelSpec = dmaGetChannelSpecByPeripheral(DMA_PERIPH_UART_RX, device, serialUartConfig(device)->rxDmaopt);
         if (dmaChannelSpec) {
             uartPort->rxDMAResource = dmaChannelSpec->ref;
             uartPort->rxDMAChannel = dmaChannelSpec->channel;
@@ -78,6 +78,15 @@
 #error unknown MCU family
 #endif
 
+// Shared by the RX buffers configured larger than UART_RX_BUFFER_SIZE
+#ifndef UART_RX_BUFFER_POOL_SIZE
+#if defined(STM32F4) || defined(STM32G4)
+#define UART_RX_BUFFER_POOL_SIZE 512
+#else
+#define UART_RX_BUFFER_POOL_SIZE 1024
+#endif
+#endif
+
 // Count number of configured UARTs
 
 #ifdef USE_UART1
@@ -204,6 +213,7 @@ typedef struct uartDevice_s {
     uartPinDef_t tx;
     volatile uint8_t *rxBuffer;
     volatile uint8_t *txBuffer;
+    uint16_t rxBufferSize;
 #if !defined(STM32F4) // Don't support pin swap.
     bool pinSwap;
 #endif
@@ -34,6 +34,8 @@
 #include "drivers/persistent.h"
 #include "drivers/sound_beeper.h"
 
+#include "fc/watchdog.h"
+
 #include "flight/servos.h"
 #include "flight/motors.h"
 
@@ -103,6 +105,9 @@ void SysTick_Handler(void)
     // used by the HAL for some timekeeping and timeouts, should always be 1ms
     HAL_IncTick();
 #endif
+#ifdef USE_LOOP_WATCHDOG
+    loopWatchdogCheck();
+#endif
 }
 
 // Return system uptime in microseconds (rollover in 70minutes)
@@ -0,0 +1,62 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * Boot timeline
+ *
+ * init() marks the end of each init phase with the time since reset, so the
+ * phases that take long, like probing absent sensors or mounting the SD
+ * card, can be found from the CLI status or over MSP. The duration of
+ * a phase is the difference to the previous mark.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "platform.h"
+
+#ifdef USE_BOOT_TIMELINE
+
+#include "drivers/time.h"
+
+#include "fc/boot_timeline.h"
+
+static bootTimelineEntry_t bootTimeline[BOOT_TIMELINE_SIZE];
+static unsigned bootTimelineEntries;
+
+void bootTimelineMark(const char *name)
+{
+    if (bootTimelineEntries < BOOT_TIMELINE_SIZE) {
+        bootTimelineEntry_t *entry = &bootTimeline[bootTimelineEntries++];
+        entry->name = name;
+        entry->timeUs = micros();
+    }
+}
+
+unsigned bootTimelineCount(void)
+{
+    return bootTimelineEntries;
+}
+
+const bootTimelineEntry_t *bootTimelineGet(unsigned index)
+{
+    return (index < bootTimelineEntries) ? &bootTimeline[index] : NULL;
+}
+
+#endif
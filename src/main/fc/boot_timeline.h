@@ -0,0 +1,42 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+
+#define BOOT_TIMELINE_SIZE      32u     // Marks, the later ones are dropped
+#define BOOT_TIMELINE_PAGE_SIZE 16u     // Marks per MSP reply
+
+typedef struct {
+    const char *name;           // init phase that ended at the mark
+    uint32_t timeUs;            // micros() at the end of the phase
+} bootTimelineEntry_t;
+
+#ifdef USE_BOOT_TIMELINE
+
+void bootTimelineMark(const char *name);
+
+unsigned bootTimelineCount(void);
+const bootTimelineEntry_t *bootTimelineGet(unsigned index);
+
+#else
+
+static inline void bootTimelineMark(const char *name) { (void)name; }
+
+#endif
@@ -29,6 +29,7 @@
 #include "blackbox/blackbox_fielddefs.h"
 
 #include "build/debug.h"
+#include "build/profiler.h"
 
 #include "cli/cli.h"
 
@@ -51,12 +52,14 @@
 #include "drivers/time.h"
 #include "drivers/freq.h"
 
+#include "fc/eventlog.h"
 #include "fc/rc_rates.h"
 #include "fc/rc.h"
 #include "fc/rc_adjustments.h"
 #include "fc/rc_controls.h"
 #include "fc/runtime_config.h"
 #include "fc/stats.h"
+#include "fc/watchdog.h"
 
 #include "flight/failsafe.h"
 #include "flight/gps_rescue.h"
@@ -205,20 +208,169 @@ static bool accNeedsCalibration(void)
 }
 #endif
 
-void updateArmingStatus(void)
+#define LOOP_RATE_SETTLE_US     5000000     // let boot transients pass before measuring
+#define LOOP_RATE_MEASURE_US    2000000     // measurement window
+
+static loopRateStatus_t loopRate;
+
+const loopRateStatus_t *getLoopRateStatus(void)
+{
+    return &loopRate;
+}
+
+static uint32_t loopRateFilterDenom(uint32_t pidDenom)
+{
+    uint32_t filtDenom = pidConfig()->filter_process_denom;
+
+    if (filtDenom == 0 || filtDenom >= pidDenom)
+        return pidDenom;
+
+    while (pidDenom % filtDenom)
+        filtDenom++;
+
+    return filtDenom;
+}
+
+/*
+ * Measure the realtime cost of the gyro, filter and PID tasks while disarmed,
+ * and pick the fastest PID/filter loop rate that leaves the configured headroom.
+ * Work per gyro sample is modelled as
+ *
+ *    gyro + filter / filterDenom + pidWork / pidDenom
+ *
+ * where pidWork is the PID task work of one full PID cycle, as the PID subtasks
+ * are spread over pidDenom gyro samples. A slower rate is saved to the config
+ * and takes effect on the next boot.
+ */
+static void updateLoopRateFallback(void)
+{
+    static timeUs_t measureStartUs = 0;
+
+    const uint8_t headroom = pidConfig()->pid_process_headroom;
+    const timeUs_t currentTimeUs = micros();
+
+    if (!headroom || loopRate.pidDenom || !gyro.sampleLooptime || currentTimeUs < LOOP_RATE_SETTLE_US)
+        return;
+
+    if (!measureStartUs) {
+        measureStartUs = currentTimeUs;
+        return;
+    }
+
+    if (cmpTimeUs(currentTimeUs, measureStartUs) < LOOP_RATE_MEASURE_US)
+        return;
+
+    taskInfo_t gyroTask, filterTask, pidTask;
+
+    getTaskInfo(TASK_GYRO, &gyroTask);
+    getTaskInfo(TASK_FILTER, &filterTask);
+    getTaskInfo(TASK_PID, &pidTask);
+
+    const uint32_t gyroCost = gyroTask.averageExecutionTime10thUs;
+    const uint32_t filterCost = filterTask.averageExecutionTime10thUs;
+    const uint32_t pidWork = pidTask.averageExecutionTime10thUs * activePidLoopDenom;
+    const uint32_t budget = gyro.sampleLooptime * 10 * (100 - headroom) / 100;
+
+    uint32_t pidDenom = pidConfig()->pid_process_denom;
+    uint32_t filtDenom = loopRateFilterDenom(pidDenom);
+    uint32_t cost = gyroCost + filterCost / filtDenom + pidWork / pidDenom;
+
+    while (cost > budget && pidDenom < MAX_PID_PROCESS_DENOM &&
+           gyro.sampleRateHz / (pidDenom + 1) >= MIN_PID_PROCESS_SPEED) {
+        pidDenom++;
+        filtDenom = loopRateFilterDenom(pidDenom);
+        cost = gyroCost + filterCost / filtDenom + pidWork / pidDenom;
+    }
+
+    loopRate.cost = MIN(cost, (uint32_t)UINT16_MAX);
+    loopRate.budget = MIN(budget, (uint32_t)UINT16_MAX);
+    loopRate.pidDenom = pidDenom;
+    loopRate.filterDenom = filtDenom;
+
+    if (pidDenom != pidConfig()->pid_process_denom) {
+        pidConfigMutable()->pid_process_denom = pidDenom;
+        if (pidConfig()->filter_process_denom)
+            pidConfigMutable()->filter_process_denom = filtDenom;
+        saveConfigAndNotify();
+    }
+}
+
+// Arming checks that do not depend on the RC switches
+#define ARMING_SYSTEM_CHECK_MS  100
+
+static timeMs_t armingSystemCheckTime = 0;
+
+static void updateArmingSystemStatus(void)
+{
+    // Check if the power on arming grace time has elapsed
+    if ((getArmingDisableFlags() & ARMING_DISABLED_BOOT_GRACE_TIME) && (millis() >= systemConfig()->powerOnArmingGraceTime * 1000)
+#ifdef USE_DSHOT
+        // We also need to prevent arming until it's possible to send DSHOT commands.
+        && (!isMotorProtocolDshot() || dshotStreamingCommandsAreEnabled())
+#endif
+    ) {
+        // If so, unset the grace time arming disable flag
+        unsetArmingDisabled(ARMING_DISABLED_BOOT_GRACE_TIME);
+    }
+
+    updateLoopRateFallback();
+
+    if (!isUpright()) {
+        setArmingDisabled(ARMING_DISABLED_ANGLE);
+    } else {
+        unsetArmingDisabled(ARMING_DISABLED_ANGLE);
+    }
+
+    if (getMaxRealTimeLoad() > 750 || getAverageCPULoad() > 750 || getAverageSystemLoad() > 750) {
+        setArmingDisabled(ARMING_DISABLED_LOAD);
+    } else {
+        unsetArmingDisabled(ARMING_DISABLED_LOAD);
+    }
+
+    if (isCalibrating()) {
+        setArmingDisabled(ARMING_DISABLED_CALIBRATING);
+    } else {
+        unsetArmingDisabled(ARMING_DISABLED_CALIBRATING);
+    }
+
+#ifdef USE_GPS_RESCUE
+    if (gpsRescueIsConfigured()) {
+        if (gpsRescueConfig()->allowArmingWithoutFix || STATE(GPS_FIX) || ARMING_FLAG(WAS_EVER_ARMED)) {
+            unsetArmingDisabled(ARMING_DISABLED_GPS);
+        } else {
+            setArmingDisabled(ARMING_DISABLED_GPS);
+        }
+    }
+#endif
+
+#ifdef USE_DSHOT_BITBANG
+    if (isDshotBitbangActive(&motorConfig()->dev) && dshotBitbangGetStatus() != DSHOT_BITBANG_STATUS_OK) {
+        setArmingDisabled(ARMING_DISABLED_DSHOT_BITBANG);
+    } else {
+        unsetArmingDisabled(ARMING_DISABLED_DSHOT_BITBANG);
+    }
+#endif
+
+#ifdef USE_ACC
+    if (accNeedsCalibration()) {
+        setArmingDisabled(ARMING_DISABLED_ACC_CALIBRATION);
+    } else {
+        unsetArmingDisabled(ARMING_DISABLED_ACC_CALIBRATION);
+    }
+#endif
+
+    if (!isMotorProtocolEnabled()) {
+        setArmingDisabled(ARMING_DISABLED_MOTOR_PROTOCOL);
+    }
+}
+
+static void updateArmingStatusInternal(bool systemCheck)
 {
     if (ARMING_FLAG(ARMED)) {
         LED0_ON;
     } else {
-        // Check if the power on arming grace time has elapsed
-        if ((getArmingDisableFlags() & ARMING_DISABLED_BOOT_GRACE_TIME) && (millis() >= systemConfig()->powerOnArmingGraceTime * 1000)
-#ifdef USE_DSHOT
-            // We also need to prevent arming until it's possible to send DSHOT commands.
-            && (!isMotorProtocolDshot() || dshotStreamingCommandsAreEnabled())
-#endif
-        ) {
-            // If so, unset the grace time arming disable flag
-            unsetArmingDisabled(ARMING_DISABLED_BOOT_GRACE_TIME);
+        if (systemCheck) {
+            updateArmingSystemStatus();
         }
 
         // If switch is used for arming then check it is not defaulting to on when the RX link recovers from a fault
@@ -251,24 +403,6 @@ void updateArmingStatus(void)
             unsetArmingDisabled(ARMING_DISABLED_THROTTLE);
         }
 
-        if (!isUpright()) {
-            setArmingDisabled(ARMING_DISABLED_ANGLE);
-        } else {
-            unsetArmingDisabled(ARMING_DISABLED_ANGLE);
-        }
-
-        if (getMaxRealTimeLoad() > 750 || getAverageCPULoad() > 750 || getAverageSystemLoad() > 750) {
-            setArmingDisabled(ARMING_DISABLED_LOAD);
-        } else {
-            unsetArmingDisabled(ARMING_DISABLED_LOAD);
-        }
-
-        if (isCalibrating()) {
-            setArmingDisabled(ARMING_DISABLED_CALIBRATING);
-        } else {
-            unsetArmingDisabled(ARMING_DISABLED_CALIBRATING);
-        }
-
         if (isModeActivationConditionPresent(BOXPREARM)) {
             if (IS_RC_MODE_ACTIVE(BOXPREARM) && !ARMING_FLAG(WAS_ARMED_WITH_PREARM)) {
                 unsetArmingDisabled(ARMING_DISABLED_NOPREARM);
@@ -279,11 +413,6 @@ void updateArmingStatus(void)
 
 #ifdef USE_GPS_RESCUE
         if (gpsRescueIsConfigured()) {
-            if (gpsRescueConfig()->allowArmingWithoutFix || STATE(GPS_FIX) || ARMING_FLAG(WAS_EVER_ARMED)) {
-                unsetArmingDisabled(ARMING_DISABLED_GPS);
-            } else {
-                setArmingDisabled(ARMING_DISABLED_GPS);
-            }
             if (IS_RC_MODE_ACTIVE(BOXGPSRESCUE)) {
                 setArmingDisabled(ARMING_DISABLED_RESC);
             } else {
@@ -292,30 +421,10 @@ void updateArmingStatus(void)
         }
 #endif
 
-#ifdef USE_DSHOT_BITBANG
-        if (isDshotBitbangActive(&motorConfig()->dev) && dshotBitbangGetStatus() != DSHOT_BITBANG_STATUS_OK) {
-            setArmingDisabled(ARMING_DISABLED_DSHOT_BITBANG);
-        } else {
-            unsetArmingDisabled(ARMING_DISABLED_DSHOT_BITBANG);
-        }
-#endif
-
         if (IS_RC_MODE_ACTIVE(BOXPARALYZE)) {
             setArmingDisabled(ARMING_DISABLED_PARALYZE);
         }
 
-#ifdef USE_ACC
-        if (accNeedsCalibration()) {
-            setArmingDisabled(ARMING_DISABLED_ACC_CALIBRATION);
-        } else {
-            unsetArmingDisabled(ARMING_DISABLED_ACC_CALIBRATION);
-        }
-#endif
-
-        if (!isMotorProtocolEnabled()) {
-            setArmingDisabled(ARMING_DISABLED_MOTOR_PROTOCOL);
-        }
-
         if (!isUsingSticksForArming()) {
             /* Ignore ARMING_DISABLED_CALIBRATING if we are going to calibrate gyro on first arm */
             bool ignoreGyro = armingConfig()->gyro_cal_on_first_arm
@@ -341,12 +450,32 @@ void updateArmingStatus(void)
     }
 }
 
+void updateArmingStatus(void)
+{
+    updateArmingStatusInternal(true);
+}
+
+// Called on every RC update. The system state changes slowly, so it is
+// checked at a lower rate than the switches.
+void updateArmingStatusRx(void)
+{
+    const timeMs_t now = millis();
+    const bool systemCheck = cmp32(now, armingSystemCheckTime) >= 0;
+
+    if (systemCheck) {
+        armingSystemCheckTime = now + ARMING_SYSTEM_CHECK_MS;
+    }
+
+    updateArmingStatusInternal(systemCheck);
+}
+
 void disarm(flightLogDisarmReason_e reason)
 {
     if (ARMING_FLAG(ARMED)) {
         ENABLE_ARMING_FLAG(WAS_EVER_ARMED);
         DISABLE_ARMING_FLAG(ARMED);
         lastDisarmTimeUs = micros();
+        eventLog(EVENT_DISARMED, reason);
 
 #ifdef USE_BLACKBOX
         flightLogEvent_disarm_t eventData;
@@ -357,13 +486,21 @@ void disarm(flightLogDisarmReason_e reason)
 #endif
         BEEP_OFF;
 
-        bool saveRequired = isConfigDirty();
 #ifdef USE_PERSISTENT_STATS
-        saveRequired |= statsOnDisarm();
+        statsOnDisarm();
+#endif
+
+        gyroBiasOnDisarm();
+
+#ifdef USE_LOOP_WATCHDOG
+        // Do not take off again with a misbehaving scheduler
+        if (loopWatchdogTripped()) {
+            setArmingDisabled(ARMING_DISABLED_REBOOT_REQUIRED);
+        }
 #endif
 
         // let the disarming process complete and then execute the actual save
-        if (saveRequired) {
+        if (isConfigDirty()) {
             writeEEPROMDelayed(500000);
         }
     }
@@ -397,6 +534,7 @@ void tryArm(void)
         osdSuppressStats(false);
 #endif
         ENABLE_ARMING_FLAG(ARMED);
+        eventLog(EVENT_ARMED, 0);
 
         resetTryingToArm();
 
@@ -644,32 +782,38 @@ static void subTaskSetpoint(timeUs_t currentTimeUs)
 {
     UNUSED(currentTimeUs);
 
+#ifdef USE_ACC
+    imuUpdateGyroAttitude(pidGetDT());
+#endif
     setpointUpdate();
     rescueUpdate();
 }
 
 static void subTaskPidController(timeUs_t currentTimeUs)
 {
-    if (debugMode == DEBUG_CYCLETIME) {
+    if (debugModeActive(DEBUG_CYCLETIME)) {
         static uint32_t previousUpdateTime;
         uint32_t startTime = micros();
         uint32_t currentDeltaTime = startTime - previousUpdateTime;
-        debug[0] = getTaskDeltaTimeUs(TASK_SELF);
-        debug[1] = getAverageCPULoadPercent();
-        debug[2] = currentDeltaTime;
-        debug[3] = currentDeltaTime - gyro.targetLooptime;
+        DEBUG(CYCLETIME, 0, getTaskDeltaTimeUs(TASK_SELF));
+        DEBUG(CYCLETIME, 1, getAverageCPULoadPercent());
+        DEBUG(CYCLETIME, 2, currentDeltaTime);
+        DEBUG(CYCLETIME, 3, currentDeltaTime - gyro.targetLooptime);
         previousUpdateTime = startTime;
     }
 
+    PROFILE_START(PID_CONTROLLER);
     pidController(currentPidProfile, currentTimeUs);
-
+    PROFILE_END(PID_CONTROLLER);
 }
 
 static void subTaskMixerUpdate(timeUs_t currentTimeUs)
 {
     UNUSED(currentTimeUs);
 
+    PROFILE_START(MIXER_UPDATE);
     mixerUpdate();
+    PROFILE_END(MIXER_UPDATE);
 }
 
 static void subTaskMotorsServosUpdate(timeUs_t currentTimeUs)
@@ -749,13 +893,13 @@ void taskFiltering(timeUs_t currentTimeUs)
 {
     DEBUG_TIME_START(CYCLETIME, 5);
 
-    if (debugMode == DEBUG_CYCLETIME) {
+    if (debugModeActive(DEBUG_CYCLETIME)) {
         static uint32_t previousUpdateTime;
         uint32_t startTime = micros();
         uint32_t currentDeltaTime = startTime - previousUpdateTime;
-        debug[4] = getTaskDeltaTimeUs(TASK_SELF);
-        debug[6] = currentDeltaTime;
-        debug[7] = currentDeltaTime - gyro.filterLooptime;
+        DEBUG(CYCLETIME, 4, getTaskDeltaTimeUs(TASK_SELF));
+        DEBUG(CYCLETIME, 6, currentDeltaTime);
+        DEBUG(CYCLETIME, 7, currentDeltaTime - gyro.filterLooptime);
         previousUpdateTime = startTime;
     }
 
@@ -768,6 +912,10 @@ void taskMainPidLoop(timeUs_t currentTimeUs)
 {
     DEBUG_TIME_START(PIDLOOP, pidUpdateCounter & 7);
 
+#ifdef USE_LOOP_WATCHDOG
+    loopWatchdogKick();
+#endif
+
     if (activePidLoopDenom == 1) {
         subTaskPosition(currentTimeUs);
         subTaskSetpoint(currentTimeUs);
@@ -44,6 +44,13 @@ typedef enum {
 
 union rollAndPitchTrims_u;
 
+typedef struct {
+    uint16_t cost;          // Measured realtime cost per gyro sample, 0.1us
+    uint16_t budget;        // Realtime budget per gyro sample after headroom, 0.1us
+    uint8_t  pidDenom;      // Selected pid_process_denom, 0 = not measured yet
+    uint8_t  filterDenom;   // Selected filter_process_denom
+} loopRateStatus_t;
+
 void resetArmingDisabled(void);
 
 void disarm(flightLogDisarmReason_e reason);
@@ -52,6 +59,7 @@ void tryArm(void);
 bool processRx(timeUs_t currentTimeUs);
 void processRxModes(timeUs_t currentTimeUs);
 void updateArmingStatus(void);
+void updateArmingStatusRx(void);
 
 void taskGyroSample(timeUs_t currentTimeUs);
 bool gyroFilterReady(void);
@@ -60,6 +68,8 @@ void taskFiltering(timeUs_t currentTimeUs);
 void taskMainPidLoop(timeUs_t currentTimeUs);
 
 timeUs_t getLastDisarmTimeUs(void);
+
+const loopRateStatus_t *getLoopRateStatus(void);
 bool isTryingToArm();
 void resetTryingToArm();
 
@@ -32,7 +32,9 @@
 
 #include "scheduler/scheduler.h"
 
-static dispatchEntry_t *head = NULL;
+// Pending entries, kept as a binary min-heap ordered by delayedUntil
+static dispatchEntry_t *heap[DISPATCH_QUEUE_SIZE];
+static uint8_t heapSize = 0;
 static bool dispatchEnabled = false;
 
 bool dispatchIsEnabled(void)
@@ -45,14 +47,61 @@ void dispatchEnable(void)
     dispatchEnabled = true;
 }
 
-void dispatchProcess(uint32_t currentTimeUs)
+static inline bool dispatchBefore(const dispatchEntry_t *a, const dispatchEntry_t *b)
+{
+    return cmp32(a->delayedUntil, b->delayedUntil) < 0;
+}
+
+static void heapSiftUp(unsigned index)
 {
-    for (dispatchEntry_t **p = &head; *p; ) {
-        if (cmp32(currentTimeUs, (*p)->delayedUntil) < 0)
+    dispatchEntry_t *entry = heap[index];
+
+    while (index > 0) {
+        const unsigned parent = (index - 1) / 2;
+        if (!dispatchBefore(entry, heap[parent]))
+            break;
+        heap[index] = heap[parent];
+        index = parent;
+    }
+
+    heap[index] = entry;
+}
+
+static void heapSiftDown(unsigned index)
+{
+    dispatchEntry_t *entry = heap[index];
+
+    while (true) {
+        unsigned child = 2 * index + 1;
+        if (child >= heapSize)
+            break;
+        if (child + 1 < heapSize && dispatchBefore(heap[child + 1], heap[child]))
+            child++;
+        if (!dispatchBefore(heap[child], entry))
             break;
+        heap[index] = heap[child];
+        index = child;
+    }
+
+    heap[index] = entry;
+}
+
+bool dispatchCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTimeUs)
+{
+    UNUSED(currentDeltaTimeUs);
+
+    return heapSize && cmp32(currentTimeUs, heap[0]->delayedUntil) >= 0;
+}
+
+void dispatchProcess(uint32_t currentTimeUs)
+{
+    while (heapSize && cmp32(currentTimeUs, heap[0]->delayedUntil) >= 0) {
         // unlink entry first, so handler can replan self
-        dispatchEntry_t *current = *p;
-        *p = (*p)->next;
+        dispatchEntry_t *current = heap[0];
+        if (--heapSize) {
+            heap[0] = heap[heapSize];
+            heapSiftDown(0);
+        }
         current->inQue = false;
         (*current->dispatch)(current);
     }
@@ -60,18 +109,13 @@ void dispatchProcess(uint32_t currentTimeUs)
 
 void dispatchAdd(dispatchEntry_t *entry, int delayUs)
 {
-    uint32_t delayedUntil = micros() + delayUs;
-    dispatchEntry_t **p = &head;
-
-    if (entry->inQue) {
-      return;    // Allready in Queue, abort
+    if (entry->inQue || heapSize >= DISPATCH_QUEUE_SIZE) {
+      return;    // Allready in Queue or no room, abort
     }
 
-    while (*p && cmp32((*p)->delayedUntil, delayedUntil) < 0)
-        p = &(*p)->next;
-
-    entry->next = *p;
-    entry->delayedUntil = delayedUntil;
+    entry->delayedUntil = micros() + delayUs;
     entry->inQue = true;
-    *p = entry;
+
+    heap[heapSize] = entry;
+    heapSiftUp(heapSize++);
 }
@@ -20,17 +20,21 @@
 
 #pragma once
 
+#include "common/time.h"
+
+#define DISPATCH_QUEUE_SIZE 8
+
 struct dispatchEntry_s;
 typedef void dispatchFunc(struct dispatchEntry_s* self);
 
 typedef struct dispatchEntry_s {
     dispatchFunc *dispatch;
     uint32_t delayedUntil;
-    struct dispatchEntry_s *next;
     bool inQue;
 } dispatchEntry_t;
 
 bool dispatchIsEnabled(void);
 void dispatchEnable(void);
+bool dispatchCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTimeUs);
 void dispatchProcess(uint32_t currentTime);
 void dispatchAdd(dispatchEntry_t *entry, int delayUs);
@@ -0,0 +1,111 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Runtime event log
+ *
+ * A ring of the last EVENT_LOG_SIZE state changes, independent of blackbox.
+ * Events can be logged from any context, including interrupts; a record is
+ * written in one short critical section, so readers never see a partial one.
+ *
+ * On MCUs with PERSISTENT RAM the log survives soft reboots, and each
+ * record carries the boot count so the events before a reboot can be told
+ * apart from the current ones.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#ifdef USE_EVENT_LOG
+
+#include "build/atomic.h"
+
+#include "common/maths.h"
+
+#include "drivers/nvic.h"
+#include "drivers/time.h"
+
+#include "fc/eventlog.h"
+
+#define EVENT_LOG_MAGIC         0x45564C47  // "EVLG"
+
+typedef struct {
+    uint32_t magic;
+    uint32_t total;             // Records ever written, the next one goes to total % EVENT_LOG_SIZE
+    uint8_t  boot;
+    eventLogRecord_t records[EVENT_LOG_SIZE];
+} eventLog_t;
+
+#ifdef PERSISTENT
+static PERSISTENT eventLog_t eventLogData;
+#else
+static eventLog_t eventLogData;
+#endif
+
+void eventLogInit(void)
+{
+    // Persistent RAM holds garbage after a power up
+    if (eventLogData.magic != EVENT_LOG_MAGIC) {
+        memset(&eventLogData, 0, sizeof(eventLogData));
+        eventLogData.magic = EVENT_LOG_MAGIC;
+    } else {
+        eventLogData.boot++;
+    }
+
+    eventLog(EVENT_BOOT, eventLogData.boot);
+}
+
+void eventLog(eventType_e type, uint16_t value)
+{
+    const uint32_t timeMs = millis();
+
+    ATOMIC_BLOCK(NVIC_PRIO_MAX) {
+        eventLogRecord_t *record = &eventLogData.records[eventLogData.total % EVENT_LOG_SIZE];
+
+        record->timeMs = timeMs;
+        record->boot = eventLogData.boot;
+        record->type = type;
+        record->value = value;
+
+        eventLogData.total++;
+    }
+}
+
+unsigned eventLogCount(void)
+{
+    return MIN(eventLogData.total, EVENT_LOG_SIZE);
+}
+
+uint32_t eventLogTotal(void)
+{
+    return eventLogData.total;
+}
+
+// Index 0 is the oldest record still in the log
+void eventLogGet(unsigned index, eventLogRecord_t *record)
+{
+    ATOMIC_BLOCK(NVIC_PRIO_MAX) {
+        const uint32_t first = eventLogData.total - eventLogCount();
+
+        *record = eventLogData.records[(first + index) % EVENT_LOG_SIZE];
+    }
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define EVENT_LOG_SIZE          64u     // Records, power of two
+#define EVENT_LOG_PAGE_SIZE     20u     // Records per MSP reply
+
+typedef enum {
+    EVENT_NONE = 0,
+    EVENT_BOOT,                 // value: boot count
+    EVENT_ARMED,
+    EVENT_DISARMED,             // value: flightLogDisarmReason_e
+    EVENT_ARMING_DISABLED,      // value: bit index of the armingDisableFlags_e set
+    EVENT_ARMING_ENABLED,       // value: bit index of the armingDisableFlags_e cleared
+    EVENT_FAILSAFE_PHASE,       // value: failsafePhase_e
+    EVENT_RESCUE_STATE,         // value: rescue state
+    EVENT_GOVERNOR_STATE,       // value: governor state
+    EVENT_RX_SIGNAL,            // value: 1 received, 0 lost
+    EVENT_GYRO_OVERFLOW,        // value: gyroOverflow_e axes
+    EVENT_LOOP_STALL,           // value: taskId_e running when the PID loop stalled
+    EVENT_GOV_AUTOTUNE,         // value: govAutotuneState_e
+    EVENT_COUNT
+} eventType_e;
+
+typedef struct {
+    uint32_t timeMs;            // millis() of the boot the event happened in
+    uint8_t  boot;              // boot count, wraps
+    uint8_t  type;              // eventType_e
+    uint16_t value;
+} eventLogRecord_t;
+
+#ifdef USE_EVENT_LOG
+
+void eventLogInit(void);
+void eventLog(eventType_e type, uint16_t value);
+
+unsigned eventLogCount(void);
+uint32_t eventLogTotal(void);
+void eventLogGet(unsigned index, eventLogRecord_t *record);
+
+#else
+
+static inline void eventLog(eventType_e type, uint16_t value) { (void)type; (void)value; }
+
+#endif
@@ -30,6 +30,7 @@
 #include "build/build_config.h"
 #include "build/debug.h"
 #include "build/debug_pin.h"
+#include "build/profiler.h"
 
 #include "cms/cms.h"
 #include "cms/cms_types.h"
@@ -86,12 +87,15 @@
 #include "drivers/vtx_table.h"
 
 #include "fc/board_info.h"
+#include "fc/boot_timeline.h"
 #include "fc/dispatch.h"
+#include "fc/eventlog.h"
 #include "fc/init.h"
 #include "fc/rc_controls.h"
 #include "fc/runtime_config.h"
 #include "fc/stats.h"
 #include "fc/tasks.h"
+#include "fc/watchdog.h"
 
 #include "flight/failsafe.h"
 #include "flight/position.h"
@@ -101,6 +105,7 @@
 #include "flight/servos.h"
 #include "flight/governor.h"
 #include "flight/rpm_filter.h"
+#include "flight/vibration.h"
 
 #include "io/asyncfatfs/asyncfatfs.h"
 #include "io/beeper.h"
@@ -109,6 +114,7 @@
 #include "io/displayport_max7456.h"
 #include "io/displayport_msp.h"
 #include "io/flashfs.h"
+#include "io/flashlog.h"
 #include "io/gps.h"
 #include "io/ledstrip.h"
 #include "io/piniobox.h"
@@ -262,6 +268,16 @@ void init(void)
 
     systemInit();
 
+    bootTimelineMark("system");
+
+#ifdef USE_EVENT_LOG
+    eventLogInit();
+#endif
+
+#ifdef USE_LOOP_WATCHDOG
+    loopWatchdogInit();
+#endif
+
     // Initialize task data as soon as possible. Has to be done before tasksInit(),
     // and any init code that may try to modify task behaviour before tasksInit().
     tasksInitData();
@@ -391,6 +407,8 @@ void init(void)
 
     systemState |= SYSTEM_STATE_CONFIG_LOADED;
 
+    bootTimelineMark("config");
+
 #if defined(USE_BOARD_INFO)
     initBoardInformation();
 #endif
@@ -399,8 +417,12 @@ void init(void)
     dbgPinInit();
 #endif
 
-    debugMode = systemConfig()->debug_mode;
+    debugModes[0] = systemConfig()->debug_mode;
+    debugModes[1] = systemConfig()->debug_mode_2;
     debugAxis = systemConfig()->debug_axis;
+    debugInit();
+
+    profileInit();
 
 #ifdef TARGET_PREINIT
     targetPreInit();
@@ -454,6 +476,8 @@ void init(void)
 
 #endif // USE_BUTTONS
 
+    bootTimelineMark("buttons");
+
     // Note that spektrumBind checks if a call is immediately after
     // hard reset (including power cycle), so it should be called before
     // systemClockSetHSEValue and OverclockRebootIfNecessary, as these
@@ -526,6 +550,8 @@ void init(void)
     serialInit(featureIsEnabled(FEATURE_SOFTSERIAL), SERIAL_PORT_NONE);
 #endif
 
+    bootTimelineMark("serial");
+
     mixerInit();
 
 #ifdef USE_MOTOR
@@ -553,6 +579,8 @@ void init(void)
     initInverters(serialPinConfig());
 #endif
 
+    bootTimelineMark("motors");
+
 
 #ifdef TARGET_BUS_INIT
     targetBusInit();
@@ -636,6 +664,8 @@ void init(void)
 
 #endif // TARGET_BUS_INIT
 
+    bootTimelineMark("buses");
+
 #ifdef USE_HARDWARE_REVISION_DETECTION
     updateHardwareRevision();
 #endif
@@ -668,6 +698,8 @@ void init(void)
 
     systemState |= SYSTEM_STATE_SENSORS_READY;
 
+    bootTimelineMark("sensors");
+
     // Set the targetLooptime based on the detected gyro sampleRateHz and pid_process_denom
     gyroSetLooptime(pidConfig()->pid_process_denom, pidConfig()->filter_process_denom);
 
@@ -699,11 +731,15 @@ void init(void)
     pinioBoxInit(pinioBoxConfig());
 #endif
 
+    bootTimelineMark("pid");
+
     LED1_ON;
     LED0_OFF;
     LED2_OFF;
 
-    for (int i = 0; i < 10; i++) {
+    // A warm reset on known hardware (e.g. an in-flight brownout) skips the
+    // boot indication to get back to an armable state sooner
+    for (int i = 0; i < 10 && !gyroDetectedFromCache(); i++) {
         LED1_TOGGLE;
         LED0_TOGGLE;
 #if defined(USE_BEEPER)
@@ -720,6 +756,8 @@ void init(void)
     LED0_OFF;
     LED1_OFF;
 
+    bootTimelineMark("indication");
+
     imuInit();
 
     setpointInit();
@@ -744,6 +782,8 @@ void init(void)
     }
 #endif
 
+    bootTimelineMark("rx");
+
 #ifdef USE_ESC_SENSOR
     if (featureIsEnabled(FEATURE_ESC_SENSOR)) {
         escSensorInit();
@@ -770,10 +810,18 @@ void init(void)
     }
 #endif
 
+#ifdef USE_VIBRATION_ANALYSIS
+    if (sensors(SENSOR_ACC)) {
+        vibrationInit();
+    }
+#endif
+
     if (featureIsEnabled(FEATURE_GOVERNOR)) {
         governorInit(currentPidProfile);
     }
 
+    bootTimelineMark("rpm");
+
 #ifdef USE_USB_DETECT
     usbCableDetectInit();
 #endif
@@ -787,6 +835,11 @@ void init(void)
 #ifdef USE_FLASHFS
     flashfsInit();
 #endif
+#ifdef USE_FLASH_LOG
+    flashLogInit();
+#endif
+
+    bootTimelineMark("flash");
 
 #ifdef USE_BLACKBOX
 #ifdef USE_SDCARD
@@ -802,6 +855,8 @@ void init(void)
     blackboxInit();
 #endif
 
+    bootTimelineMark("blackbox");
+
     gyroStartCalibration(false);
 #ifdef USE_BARO
     baroStartCalibration();
@@ -834,6 +889,8 @@ void init(void)
 
 #endif // VTX_CONTROL
 
+    bootTimelineMark("vtx");
+
 #ifdef USE_TIMER
     // start all timers
     // TODO - not implemented yet
@@ -854,6 +911,8 @@ void init(void)
     mspInit();
     mspSerialInit();
 
+    bootTimelineMark("msp");
+
 /*
  * CMS, display devices and OSD
  */
@@ -949,6 +1008,8 @@ void init(void)
     }
 #endif
 
+    bootTimelineMark("osd");
+
 #ifdef USE_TELEMETRY
     // Telemetry will initialise displayport and register with CMS by itself.
     if (featureIsEnabled(FEATURE_TELEMETRY)) {
@@ -956,6 +1017,8 @@ void init(void)
     }
 #endif
 
+    bootTimelineMark("telemetry");
+
     setArmingDisabled(ARMING_DISABLED_BOOT_GRACE_TIME);
 
     // On F4/F7 allocate SPI DMA streams before motor timers
@@ -985,5 +1048,7 @@ void init(void)
 
     tasksInit();
 
+    bootTimelineMark("tasks");
+
     systemState |= SYSTEM_STATE_READY;
 }
@@ -28,6 +28,7 @@
 #define PARAM_NAME_GYRO_LPF2_STATIC_HZ "gyro_lpf2_static_hz"
 #define PARAM_NAME_GYRO_TO_USE "gyro_to_use"
 #define PARAM_NAME_DYN_NOTCH_MAX_HZ "dyn_notch_max_hz"
+#define PARAM_NAME_DYN_NOTCH_PARALLEL "dyn_notch_parallel"
 #define PARAM_NAME_DYN_NOTCH_COUNT "dyn_notch_count"
 #define PARAM_NAME_DYN_NOTCH_Q "dyn_notch_q"
 #define PARAM_NAME_DYN_NOTCH_MIN_HZ "dyn_notch_min_hz"
@@ -45,8 +46,10 @@
 #define PARAM_NAME_GYRO_CAL_ON_FIRST_ARM "gyro_cal_on_first_arm"
 #define PARAM_NAME_PID_PROCESS_DENOM "pid_process_denom"
 #define PARAM_NAME_FILTER_PROCESS_DENOM "filter_process_denom"
+#define PARAM_NAME_PID_PROCESS_HEADROOM "pid_process_headroom"
 #define PARAM_NAME_PID_AT_MIN_THROTTLE "pid_at_min_throttle"
 #define PARAM_NAME_D_MAX_GAIN "d_max_gain"
 #define PARAM_NAME_D_MAX_ADVANCE "d_max_advance"
 #define PARAM_NAME_DEBUG_MODE "debug_mode"
 #define PARAM_NAME_DEBUG_AXIS "debug_axis"
+#define PARAM_NAME_DEBUG_MODE_2 "debug_mode_2"
@@ -47,6 +47,7 @@
 #include "pg/rx.h"
 
 #include "rx/rx.h"
+#include "rx/rx_timing.h"
 
 #include "rc.h"
 
@@ -67,6 +68,7 @@ static FAST_DATA_ZERO_INIT float rcDeadband[4];
 static FAST_DATA_ZERO_INIT uint16_t currentRxRefreshRate;
 static FAST_DATA_ZERO_INIT float    averageRxRefreshRate;
 static FAST_DATA_ZERO_INIT timeUs_t lastRxTimeUs;
+static FAST_DATA_ZERO_INIT timeUs_t rcCommandTimeUs;
 
 static FAST_DATA_ZERO_INIT uint32_t changeCount;
 static FAST_DATA_ZERO_INIT uint16_t repeatCount;
@@ -112,6 +114,11 @@ float getAverageRxRefreshRate(void)
     return averageRxRefreshRate;
 }
 
+timeUs_t getRcCommandTimeUs(void)
+{
+    return rcCommandTimeUs;
+}
+
 float getAverageRxUpdateRate(void)
 {
     return averageRxRefreshRate * currentMult;
@@ -163,7 +170,12 @@ void updateRcRefreshRate(timeUs_t currentTimeUs)
 
     currentRxRefreshRate = frameDeltaUs;
 
-    if (rxIsReceivingSignal() && currentRxRefreshRate > RX_REFRESH_RATE_MIN_US && currentRxRefreshRate < RX_REFRESH_RATE_MAX_US) {
+    if (rxIsReceivingSignal() && rxTimingIsLocked()) {
+        // Frame period from the RX frame timing estimate
+        averageRxRefreshRate = rxTimingGetPeriodUs();
+        updateRcChange();
+    }
+    else if (rxIsReceivingSignal() && currentRxRefreshRate > RX_REFRESH_RATE_MIN_US && currentRxRefreshRate < RX_REFRESH_RATE_MAX_US) {
         averageRxRefreshRate += (frameDeltaUs - averageRxRefreshRate) / RX_REFRESH_RATE_AVERAGING;
         updateRcChange();
     }
@@ -181,6 +193,9 @@ void updateRcCommands(void)
 
     setpointUpdateTiming(averageRxRefreshRate * currentMult);
 
+    // RX frame timestamp of the data in rcDeflection
+    rcCommandTimeUs = rxGetChannelsTimeUs();
+
     // rcInput => rcDeflection => rcCommand
     for (int axis = 0; axis < 4; axis++) {
         // Center point
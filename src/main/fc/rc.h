@@ -74,5 +74,6 @@ throttleStatus_e getThrottleStatus(void);
 
 uint16_t getCurrentRxRefreshRate(void);
 float getAverageRxRefreshRate(void);
+timeUs_t getRcCommandTimeUs(void);
 
 void updateRcRefreshRate(timeUs_t currentTimeUs);
@@ -62,6 +62,10 @@ PG_REGISTER_ARRAY(adjustmentRange_t, MAX_ADJUSTMENT_RANGE_COUNT, adjustmentRange
 
 static adjustmentState_t adjustmentState[MAX_ADJUSTMENT_RANGE_COUNT];
 
+// Indices of the ranges with a function assigned
+static uint8_t adjustmentActiveRange[MAX_ADJUSTMENT_RANGE_COUNT];
+static uint8_t adjustmentActiveCount = 0;
+
 static timeMs_t       adjustmentTime   = 0;
 static const char *   adjustmentName   = NULL;
 static int            adjustmentFunc   = 0;
@@ -609,8 +613,11 @@ void processRcAdjustments(void)
 
     if (rxIsReceivingSignal())
     {
-        for (int index = 0; index < MAX_ADJUSTMENT_RANGE_COUNT; index++)
+        const timeMs_t now = millis();
+
+        for (int active = 0; active < adjustmentActiveCount; active++)
         {
+            const int index = adjustmentActiveRange[active];
             const adjustmentRange_t * adjRange = adjustmentRanges(index);
             const adjustmentConfig_t * adjConfig = &adjustmentConfigs[adjRange->function];
 
@@ -618,7 +625,6 @@ void processRcAdjustments(void)
             {
                 adjustmentState_t * adjState = &adjustmentState[index];
                 const uint8_t adjFunc = adjRange->function;
-                const timeMs_t now = millis();
                 int adjval = adjState->adjValue;
 
                 if (cmp32(now, adjState->deadTime) < 0)
@@ -715,17 +721,37 @@ int getAdjustmentsRangeValue(void)
     return adjustmentValue;
 }
 
-void adjustmentRangeInit(void)
+static void adjustmentRangeCompile(void)
 {
+    adjustmentActiveCount = 0;
+
     for (int index = 0; index < MAX_ADJUSTMENT_RANGE_COUNT; index++) {
-        adjustmentRangeReset(index);
+        const uint8_t adjFunc = adjustmentRanges(index)->function;
+        if (adjFunc > ADJUSTMENT_NONE && adjFunc < ADJUSTMENT_FUNCTION_COUNT) {
+            adjustmentActiveRange[adjustmentActiveCount++] = index;
+        }
     }
 }
 
-void adjustmentRangeReset(int index)
+static void adjustmentStateReset(int index)
 {
     adjustmentState[index].deadTime = 0;
     adjustmentState[index].trigTime = 0;
-    adjustmentState[index].adjValue = getAdjustmentValue(index);
+    adjustmentState[index].adjValue = getAdjustmentValue(adjustmentRanges(index)->function);
     adjustmentState[index].chValue  = 0;
 }
+
+void adjustmentRangeInit(void)
+{
+    for (int index = 0; index < MAX_ADJUSTMENT_RANGE_COUNT; index++) {
+        adjustmentStateReset(index);
+    }
+
+    adjustmentRangeCompile();
+}
+
+void adjustmentRangeReset(int index)
+{
+    adjustmentStateReset(index);
+    adjustmentRangeCompile();
+}
@@ -49,10 +49,46 @@
 boxBitmask_t rcModeActivationMask; // one bit per mode defined in boxId_e
 static boxBitmask_t stickyModesEverDisabled;
 
-static int activeMacCount = 0;
-static uint8_t activeMacArray[MAX_MODE_ACTIVATION_CONDITION_COUNT];
-static int activeLinkedMacCount = 0;
-static uint8_t activeLinkedMacArray[MAX_MODE_ACTIVATION_CONDITION_COUNT];
+#define MODE_COND_AND       BIT(0)
+#define MODE_COND_STICKY    BIT(1)
+
+// Condition on a channel, with the range in channel units
+typedef struct {
+    uint16_t low;               // inclusive
+    uint16_t high;              // exclusive
+    uint8_t  modeId;
+    uint8_t  flags;
+} modeCondition_t;
+
+// Run of conditions on the same channel
+typedef struct {
+    uint8_t  channel;           // index to rcInput
+    uint8_t  first;
+    uint8_t  count;
+} modeChannel_t;
+
+// Condition on the state of another mode
+typedef struct {
+    uint8_t  modeId;
+    uint8_t  linkedTo;
+    uint8_t  flags;
+} modeLink_t;
+
+// Mode activation table, compiled from the conditions at config load
+static struct {
+    modeCondition_t cond[MAX_MODE_ACTIVATION_CONDITION_COUNT];
+    modeChannel_t   channel[MAX_MODE_ACTIVATION_CONDITION_COUNT];
+    modeLink_t      link[MAX_MODE_ACTIVATION_CONDITION_COUNT];
+    uint8_t         channelCount;
+    uint8_t         linkCount;
+} modeTable;
+
+// Per mode: an OR condition is active, AND conditions exist, an AND condition is inactive
+typedef struct {
+    boxBitmask_t orActive;
+    boxBitmask_t andPresent;
+    boxBitmask_t andInactive;
+} modeState_t;
 
 PG_REGISTER_ARRAY(modeActivationCondition_t, MAX_MODE_ACTIVATION_CONDITION_COUNT, modeActivationConditions, PG_MODE_ACTIVATION_PROFILE, 2);
 
@@ -74,86 +110,84 @@ bool IS_RC_MODE_ACTIVE(boxId_e boxId)
 
 void rcModeUpdate(boxBitmask_t *newState)
 {
-    rcModeActivationMask = *newState;
+    if (memcmp(&rcModeActivationMask, newState, sizeof(rcModeActivationMask)) != 0) {
+        rcModeActivationMask = *newState;
+#ifdef USE_PINIOBOX
+        pinioBoxUpdate();
+#endif
+    }
 }
 
-/*
- *  updateMasksForMac:
- *
- *  The following are the possible logic states at each MAC update:
- *      AND     NEW
- *      ---     ---
- *       F       F      - no previous AND macs evaluated, no previous active OR macs
- *       F       T      - at least 1 previous active OR mac (***this state is latched True***)
- *       T       F      - all previous AND macs active, no previous active OR macs
- *       T       T      - at least 1 previous inactive AND mac, no previous active OR macs
- */
-void updateMasksForMac(const modeActivationCondition_t *mac, boxBitmask_t *andMask, boxBitmask_t *newMask, bool bActive)
+static void updateModeState(modeState_t *state, unsigned modeId, uint8_t flags, bool active)
 {
-    if (bitArrayGet(andMask, mac->modeId) || !bitArrayGet(newMask, mac->modeId)) {
-        bool bAnd = mac->modeLogic == MODELOGIC_AND;
-
-        if (!bAnd) {    // OR mac
-            if (bActive) {
-                bitArrayClr(andMask, mac->modeId);
-                bitArraySet(newMask, mac->modeId);
-            }
-        } else {        // AND mac
-            bitArraySet(andMask, mac->modeId);
-            if (!bActive) {
-                bitArraySet(newMask, mac->modeId);
-            }
+    if (flags & MODE_COND_AND) {
+        bitArraySet(&state->andPresent, modeId);
+        if (!active) {
+            bitArraySet(&state->andInactive, modeId);
         }
+    } else if (active) {
+        bitArraySet(&state->orActive, modeId);
     }
 }
 
-void updateMasksForStickyModes(const modeActivationCondition_t *mac, boxBitmask_t *andMask, boxBitmask_t *newMask)
+static bool getModeState(const modeState_t *state, unsigned modeId)
 {
-    if (IS_RC_MODE_ACTIVE(mac->modeId)) {
-        bitArrayClr(andMask, mac->modeId);
-        bitArraySet(newMask, mac->modeId);
-    } else {
-        bool bActive = isRangeActive(mac->auxChannelIndex, &mac->range);
+    return bitArrayGet(&state->orActive, modeId) ||
+        (bitArrayGet(&state->andPresent, modeId) && !bitArrayGet(&state->andInactive, modeId));
+}
 
-        if (bitArrayGet(&stickyModesEverDisabled, mac->modeId)) {
-            updateMasksForMac(mac, andMask, newMask, bActive);
-        } else {
-            if (micros() >= STICKY_MODE_BOOT_DELAY_US && !bActive) {
-                bitArraySet(&stickyModesEverDisabled, mac->modeId);
-            }
-        }
+/*
+ * Sticky modes stay on once activated. They can be activated only after
+ * the switch has been seen off, to prevent activation at power on.
+ */
+static void updateStickyModeState(modeState_t *state, unsigned modeId, uint8_t flags, bool active)
+{
+    if (IS_RC_MODE_ACTIVE(modeId)) {
+        bitArraySet(&state->orActive, modeId);
+    } else if (bitArrayGet(&stickyModesEverDisabled, modeId)) {
+        updateModeState(state, modeId, flags, active);
+    } else if (micros() >= STICKY_MODE_BOOT_DELAY_US && !active) {
+        bitArraySet(&stickyModesEverDisabled, modeId);
     }
 }
 
+/*
+ * A mode is active if any of its OR conditions is active, or if it has
+ * AND conditions and all of them are active. Each channel is read once,
+ * and linked modes follow the state of their target in table order.
+ */
 void updateActivatedModes(void)
 {
-    boxBitmask_t newMask, andMask, stickyModes;
-    memset(&andMask, 0, sizeof(andMask));
-    memset(&newMask, 0, sizeof(newMask));
-    memset(&stickyModes, 0, sizeof(stickyModes));
-    bitArraySet(&stickyModes, BOXPARALYZE);
-
-    // determine which conditions set/clear the mode
-    for (int i = 0; i < activeMacCount; i++) {
-        const modeActivationCondition_t *mac = modeActivationConditions(activeMacArray[i]);
-
-        if (bitArrayGet(&stickyModes, mac->modeId)) {
-            updateMasksForStickyModes(mac, &andMask, &newMask);
-        } else if (mac->modeId < CHECKBOX_ITEM_COUNT) {
-            bool bActive = isRangeActive(mac->auxChannelIndex, &mac->range);
-            updateMasksForMac(mac, &andMask, &newMask, bActive);
+    modeState_t state;
+    memset(&state, 0, sizeof(state));
+
+    for (int i = 0; i < modeTable.channelCount; i++) {
+        const modeChannel_t *channel = &modeTable.channel[i];
+        const uint16_t value = rcInput[channel->channel];
+
+        for (int j = channel->first; j < channel->first + channel->count; j++) {
+            const modeCondition_t *cond = &modeTable.cond[j];
+            const bool active = (value >= cond->low && value < cond->high);
+
+            if (cond->flags & MODE_COND_STICKY) {
+                updateStickyModeState(&state, cond->modeId, cond->flags, active);
+            } else {
+                updateModeState(&state, cond->modeId, cond->flags, active);
+            }
         }
     }
 
-    // Update linked modes
-    for (int i = 0; i < activeLinkedMacCount; i++) {
-        const modeActivationCondition_t *mac = modeActivationConditions(activeLinkedMacArray[i]);
-        bool bActive = bitArrayGet(&andMask, mac->linkedTo) != bitArrayGet(&newMask, mac->linkedTo);
+    for (int i = 0; i < modeTable.linkCount; i++) {
+        const modeLink_t *link = &modeTable.link[i];
 
-        updateMasksForMac(mac, &andMask, &newMask, bActive);
+        updateModeState(&state, link->modeId, link->flags, getModeState(&state, link->linkedTo));
     }
 
-    bitArrayXor(&newMask, sizeof(newMask), &newMask, &andMask);
+    boxBitmask_t newMask;
+
+    for (unsigned i = 0; i < ARRAYLEN(newMask.bits); i++) {
+        newMask.bits[i] = state.orActive.bits[i] | (state.andPresent.bits[i] & ~state.andInactive.bits[i]);
+    }
 
     rcModeUpdate(&newMask);
 }
@@ -217,25 +251,83 @@ bool isModeActivationConditionConfigured(const modeActivationCondition_t *mac, c
     }
 }
 
-// Build the list of used modeActivationConditions indices
-// We can then use this to speed up processing by only evaluating used conditions
+static uint8_t getModeConditionFlags(const modeActivationCondition_t *mac)
+{
+    uint8_t flags = 0;
+
+    if (mac->modeLogic == MODELOGIC_AND) {
+        flags |= MODE_COND_AND;
+    }
+    if (mac->modeId == BOXPARALYZE) {
+        flags |= MODE_COND_STICKY;
+    }
+
+    return flags;
+}
+
+// Compile the used modeActivationConditions into the mode table, with the
+// conditions grouped by channel and the ranges converted to channel values
 void analyzeModeActivationConditions(void)
 {
     modeActivationCondition_t emptyMac;
     memset(&emptyMac, 0, sizeof(emptyMac));
 
-    activeMacCount = 0;
-    activeLinkedMacCount = 0;
+    memset(&modeTable, 0, sizeof(modeTable));
+
+    unsigned condCount = 0;
+
+    for (unsigned channel = CONTROL_CHANNEL_COUNT; channel < MAX_SUPPORTED_RC_CHANNEL_COUNT && condCount < MAX_MODE_ACTIVATION_CONDITION_COUNT; channel++) {
+        modeChannel_t *run = &modeTable.channel[modeTable.channelCount];
+
+        run->channel = channel;
+        run->first = condCount;
+
+        for (unsigned i = 0; i < MAX_MODE_ACTIVATION_CONDITION_COUNT; i++) {
+            const modeActivationCondition_t *mac = modeActivationConditions(i);
+
+            if (mac->linkedTo || mac->modeId >= CHECKBOX_ITEM_COUNT ||
+                !isModeActivationConditionConfigured(mac, &emptyMac)) {
+                continue;
+            }
+
+            // Unusable ranges are never active; they go with the first channel
+            const bool usable = isRangeUsable(&mac->range) &&
+                mac->auxChannelIndex < MAX_AUX_CHANNEL_COUNT;
+
+            const unsigned macChannel = usable ? mac->auxChannelIndex + CONTROL_CHANNEL_COUNT : CONTROL_CHANNEL_COUNT;
 
-    for (uint8_t i = 0; i < MAX_MODE_ACTIVATION_CONDITION_COUNT; i++) {
+            if (macChannel != channel) {
+                continue;
+            }
+
+            modeCondition_t *cond = &modeTable.cond[condCount++];
+
+            cond->low = usable ? STEP_TO_CHANNEL_VALUE(mac->range.startStep) : 0;
+            cond->high = usable ? STEP_TO_CHANNEL_VALUE(mac->range.endStep) : 0;
+            cond->modeId = mac->modeId;
+            cond->flags = getModeConditionFlags(mac);
+        }
+
+        run->count = condCount - run->first;
+
+        if (run->count) {
+            modeTable.channelCount++;
+        }
+    }
+
+    for (unsigned i = 0; i < MAX_MODE_ACTIVATION_CONDITION_COUNT; i++) {
         const modeActivationCondition_t *mac = modeActivationConditions(i);
-        if (mac->linkedTo) {
-            activeLinkedMacArray[activeLinkedMacCount++] = i;
-        } else if (isModeActivationConditionConfigured(mac, &emptyMac)) {
-            activeMacArray[activeMacCount++] = i;
+
+        if (mac->linkedTo && mac->linkedTo < CHECKBOX_ITEM_COUNT && mac->modeId < CHECKBOX_ITEM_COUNT) {
+            modeLink_t *link = &modeTable.link[modeTable.linkCount++];
+
+            link->modeId = mac->modeId;
+            link->linkedTo = mac->linkedTo;
+            link->flags = getModeConditionFlags(mac) & MODE_COND_AND;
         }
     }
+
 #ifdef USE_PINIOBOX
-    pinioBoxTaskControl();
+    pinioBoxUpdate();
 #endif
 }
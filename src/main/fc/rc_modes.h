@@ -66,6 +66,9 @@ typedef enum {
     BOXUSER2,
     BOXUSER3,
     BOXUSER4,
+    BOXBLACKBOXTRIGGER,
+    BOXGOVTUNE,
+    BOXSYSID,
 
     CHECKBOX_ITEM_COUNT,
 
@@ -89,6 +89,11 @@ FAST_DATA_ZERO_INIT applyRatesCurveFn applyRatesFn;
 
 FAST_DATA_ZERO_INIT controlRateConfig_t * currentControlRateProfile;
 
+// All rate curves are odd, so only the positive half is tabulated
+#define RATES_CURVE_POINTS  128
+
+static float ratesCurve[4][RATES_CURVE_POINTS + 1];
+
 
 /*** Rates Curve Functions ***/
 
@@ -187,11 +192,26 @@ static float applyQuickRates(const int axis, float rcCommandf)
     return angleRate;
 }
 
+static void initRatesCurve(void)
+{
+    for (int axis = 0; axis < 4; axis++) {
+        for (int i = 0; i <= RATES_CURVE_POINTS; i++) {
+            const float rate = applyRatesFn(axis, (float)i / RATES_CURVE_POINTS);
+            ratesCurve[axis][i] = constrainf(rate, -SETPOINT_RATE_LIMIT, SETPOINT_RATE_LIMIT);
+        }
+    }
+}
+
 float applyRatesCurve(const int axis, float rcCommandf)
 {
-    float rate = applyRatesFn(axis, rcCommandf);
+    const float index = fminf(fabsf(rcCommandf), 1.0f) * RATES_CURVE_POINTS;
+    const int i = MIN((int)index, RATES_CURVE_POINTS - 1);
+    const float * curve = ratesCurve[axis];
+
+    float rate = curve[i] + (curve[i+1] - curve[i]) * (index - i);
 
-    rate = constrainf(rate, -SETPOINT_RATE_LIMIT, SETPOINT_RATE_LIMIT);
+    if (rcCommandf < 0)
+        rate = -rate;
 
     // Collective is an angle - scale it here so that 480°/s => 12°
     if (axis == COLLECTIVE)
@@ -226,6 +246,7 @@ INIT_CODE void loadControlRateProfile(void)
             break;
     }
 
+    initRatesCurve();
     setpointInitProfile();
 }
 
@@ -23,6 +23,7 @@
 
 #include "platform.h"
 
+#include "fc/eventlog.h"
 #include "fc/runtime_config.h"
 #include "io/beeper.h"
 
@@ -66,11 +67,17 @@ static armingDisableFlags_e armingDisableFlags = 0;
 
 void setArmingDisabled(armingDisableFlags_e flag)
 {
+    if (flag & ~armingDisableFlags) {
+        eventLog(EVENT_ARMING_DISABLED, __builtin_ctz(flag & ~armingDisableFlags));
+    }
     armingDisableFlags = armingDisableFlags | flag;
 }
 
 void unsetArmingDisabled(armingDisableFlags_e flag)
 {
+    if (flag & armingDisableFlags) {
+        eventLog(EVENT_ARMING_ENABLED, __builtin_ctz(flag & armingDisableFlags));
+    }
     armingDisableFlags = armingDisableFlags & ~flag;
 }
 
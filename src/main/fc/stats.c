@@ -18,22 +18,33 @@
  * If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
+
 #include "platform.h"
 
 #ifdef USE_PERSISTENT_STATS
 
+#include "common/maths.h"
+#include "common/utils.h"
+
 #include "drivers/time.h"
 
 #include "config/config.h"
 #include "fc/dispatch.h"
+#include "fc/eventlog.h"
 #include "fc/runtime_config.h"
 #include "fc/stats.h"
 
 #include "io/beeper.h"
+#include "io/flashlog.h"
 #include "io/gps.h"
 
+#include "pg/pg_ids.h"
 #include "pg/stats.h"
 
+// Let the disarming process complete first
+#define STATS_WRITE_DELAY_US 500000
+
 
 static timeMs_t arm_millis;
 static uint32_t arm_distance_cm;
@@ -44,8 +55,116 @@ static uint32_t arm_distance_cm;
     #define DISTANCE_FLOWN_CM (0)
 #endif
 
+static void statsWrite(struct dispatchEntry_s* self)
+{
+    UNUSED(self);
+
+    // Only the stats are appended to the saved config
+    writePGToEEPROM(PG_STATS_CONFIG);
+}
+
+static dispatchEntry_t statsWriteEntry =
+{
+    .dispatch = statsWrite,
+};
+
+#ifdef USE_FLASH_LOG
+
+// Stats in the config as it was last saved
+static uint32_t savedFlights;
+static uint32_t savedTimeS;
+static uint32_t savedDistM;
+
+#ifdef USE_EVENT_LOG
+static uint32_t eventsLogged;
+#endif
+
+void statsOnConfigWrite(void)
+{
+    savedFlights = statsConfig()->stats_total_flights;
+    savedTimeS   = statsConfig()->stats_total_time_s;
+    savedDistM   = statsConfig()->stats_total_dist_m;
+}
+
+static void statsLoadRecord(void)
+{
+    flashLogRecord_t record;
+    statsRecord_t stats;
+
+    statsOnConfigWrite();
+
+    if (flashLogFindLatest(FLASH_LOG_STATS, &record) && record.length == sizeof(stats)) {
+        memcpy(&stats, record.data, sizeof(stats));
+
+        // Unless the stats were changed and saved since the record was written
+        if (stats.savedFlights == savedFlights && stats.savedTimeS == savedTimeS && stats.savedDistM == savedDistM) {
+            statsConfigMutable()->stats_total_flights = stats.flights;
+            statsConfigMutable()->stats_total_time_s  = stats.timeS;
+            statsConfigMutable()->stats_total_dist_m  = stats.distM;
+        }
+    }
+
+#ifdef USE_EVENT_LOG
+    eventsLogged = eventLogTotal();
+#endif
+}
+
+static void statsLogRecord(void)
+{
+    const statsRecord_t stats = {
+        .flights = statsConfig()->stats_total_flights,
+        .timeS   = statsConfig()->stats_total_time_s,
+        .distM   = statsConfig()->stats_total_dist_m,
+        .savedFlights = savedFlights,
+        .savedTimeS   = savedTimeS,
+        .savedDistM   = savedDistM,
+    };
+
+    flashLogAppend(FLASH_LOG_STATS, &stats, sizeof(stats));
+}
+
+#ifdef USE_EVENT_LOG
+// Copy the events since the last flight, three to a record, as long as the queue takes them
+static void statsLogEvents(void)
+{
+    const uint32_t total = eventLogTotal();
+    const unsigned perRecord = FLASH_LOG_PAYLOAD_SIZE / sizeof(eventLogRecord_t);
+
+    // Skip the events the ring has dropped already
+    if (total - eventsLogged > eventLogCount())
+        eventsLogged = total - eventLogCount();
+
+    while (eventsLogged != total) {
+        eventLogRecord_t records[FLASH_LOG_PAYLOAD_SIZE / sizeof(eventLogRecord_t)];
+        const unsigned first = eventLogCount() - (total - eventsLogged);
+        const unsigned count = MIN(total - eventsLogged, perRecord);
+
+        for (unsigned index = 0; index < count; index++)
+            eventLogGet(first + index, &records[index]);
+
+        if (!flashLogAppend(FLASH_LOG_EVENT, records, count * sizeof(eventLogRecord_t)))
+            break;
+
+        eventsLogged += count;
+    }
+}
+#endif
+
+#else
+
+void statsOnConfigWrite(void)
+{
+}
+
+#endif
+
 void statsInit(void)
 {
+#ifdef USE_FLASH_LOG
+    if (flashLogIsReady())
+        statsLoadRecord();
+#endif
+
     dispatchEnable();
 }
 
@@ -55,7 +174,7 @@ void statsOnArm(void)
     arm_distance_cm = DISTANCE_FLOWN_CM;
 }
 
-bool statsOnDisarm(void)
+void statsOnDisarm(void)
 {
     int8_t minArmedTimeS = statsConfig()->stats_min_armed_time_s;
     if (minArmedTimeS >= 0) {
@@ -65,10 +184,17 @@ bool statsOnDisarm(void)
             statsConfigMutable()->stats_total_time_s += dtS;
             statsConfigMutable()->stats_total_dist_m += (DISTANCE_FLOWN_CM - arm_distance_cm) / 100;
 
-            return true;
+#ifdef USE_FLASH_LOG
+            if (flashLogIsReady()) {
+                statsLogRecord();
+#ifdef USE_EVENT_LOG
+                statsLogEvents();
+#endif
+                return;
+            }
+#endif
+            dispatchAdd(&statsWriteEntry, STATS_WRITE_DELAY_US);
         }
     }
-
-    return false;
 }
 #endif
@@ -20,7 +20,20 @@
 
 #pragma once
 
+#include <stdint.h>
+
+// Payload of the FLASH_LOG_STATS records
+typedef struct {
+    uint32_t flights;
+    uint32_t timeS;
+    uint32_t distM;
+    uint32_t savedFlights;      // stats in the saved config when the record was written
+    uint32_t savedTimeS;
+    uint32_t savedDistM;
+} statsRecord_t;
+
 void statsInit(void);
+void statsOnConfigWrite(void);
 
 void statsOnArm(void);
-bool statsOnDisarm(void);
+void statsOnDisarm(void);
@@ -24,6 +24,8 @@
 
 #include "platform.h"
 
+#include "blackbox/blackbox.h"
+
 #include "build/debug.h"
 
 #include "cli/cli.h"
@@ -56,6 +58,7 @@
 #include "flight/imu.h"
 #include "flight/mixer.h"
 #include "flight/pid.h"
+#include "flight/vibration.h"
 
 #include "io/asyncfatfs/asyncfatfs.h"
 #include "io/beeper.h"
@@ -63,7 +66,6 @@
 #include "io/flashfs.h"
 #include "io/gps.h"
 #include "io/ledstrip.h"
-#include "io/piniobox.h"
 #include "io/serial.h"
 #include "io/vtx_tramp.h" // Will be gone
 #include "io/rcdevice_cam.h"
@@ -90,7 +92,6 @@
 #include "sensors/esc_sensor.h"
 #include "sensors/gyro.h"
 #include "sensors/sensors.h"
-#include "sensors/rangefinder.h"
 
 #include "telemetry/telemetry.h"
 #include "telemetry/crsf.h"
@@ -155,6 +156,10 @@ static void taskHandleSerial(timeUs_t currentTimeUs)
 static void taskUpdateAccelerometer(timeUs_t currentTimeUs)
 {
     accUpdate(currentTimeUs, &accelerometerConfigMutable()->accelerometerTrims);
+
+#ifdef USE_VIBRATION_ANALYSIS
+    vibrationPush(acc.accADC);
+#endif
 }
 #endif
 
@@ -202,7 +207,7 @@ static void taskUpdateRxMain(timeUs_t currentTimeUs)
     case RX_STATE_UPDATE:
         // updateRcCommands sets rcCommand, which is needed by updateAltHoldState and updateSonarAltHoldState
         updateRcCommands();
-        updateArmingStatus();
+        updateArmingStatusRx();
 
 #ifdef USE_USB_CDC_HID
         if (!ARMING_FLAG(ARMED)) {
@@ -230,9 +235,7 @@ static void taskUpdateRxMain(timeUs_t currentTimeUs)
         }
     }
 
-    if (debugMode == DEBUG_RX_STATE_TIME) {
-        debug[oldRxState] = rxStateDurationFractionUs[oldRxState] >> RX_TASK_DECAY_SHIFT;
-    }
+    DEBUG(RX_STATE_TIME, oldRxState, rxStateDurationFractionUs[oldRxState] >> RX_TASK_DECAY_SHIFT);
 
     schedulerSetNextStateTime(rxStateDurationFractionUs[rxState] >> RX_TASK_DECAY_SHIFT);
 }
@@ -258,26 +261,8 @@ static void taskUpdateMag(timeUs_t currentTimeUs)
     UNUSED(currentTimeUs);
 
     if (sensors(SENSOR_MAG)) {
-        const uint32_t newDeadline = compassUpdate(currentTimeUs);
-        if (newDeadline != 0) {
-            rescheduleTask(TASK_SELF, newDeadline);
-        }
-    }
-}
-#endif
-
-#if defined(USE_RANGEFINDER)
-void taskUpdateRangefinder(timeUs_t currentTimeUs)
-{
-    UNUSED(currentTimeUs);
-
-    if (!sensors(SENSOR_RANGEFINDER)) {
-        return;
+        compassUpdate(currentTimeUs);
     }
-
-    rangefinderUpdate();
-
-    rangefinderProcess(getCosTiltAngle());
 }
 #endif
 
@@ -309,7 +294,18 @@ static void taskCameraControl(uint32_t currentTime)
     .checkFunc = checkFuncParam, \
     .taskFunc = taskFuncParam, \
     .desiredPeriodUs = desiredPeriodParam, \
-    .staticPriority = staticPriorityParam \
+    .staticPriority = staticPriorityParam, \
+    .taskClass = TASK_CLASS_PRIORITY \
+}
+
+#define DEFINE_DEADLINE_TASK(taskNameParam, subTaskNameParam, checkFuncParam, taskFuncParam, desiredPeriodParam, staticPriorityParam) {  \
+    .taskName = taskNameParam, \
+    .subTaskName = subTaskNameParam, \
+    .checkFunc = checkFuncParam, \
+    .taskFunc = taskFuncParam, \
+    .desiredPeriodUs = desiredPeriodParam, \
+    .staticPriority = staticPriorityParam, \
+    .taskClass = TASK_CLASS_DEADLINE \
 }
 
 // Task info in .bss (unitialised data)
@@ -336,7 +332,7 @@ task_attribute_t task_attributes[TASK_COUNT] = {
     [TASK_ATTITUDE] = DEFINE_TASK("ATTITUDE", NULL, NULL, imuUpdateAttitude, TASK_PERIOD_HZ(500), TASK_PRIORITY_MEDIUM),
 #endif
     [TASK_RX] = DEFINE_TASK("RX", NULL, rxUpdateCheck, taskUpdateRxMain, TASK_PERIOD_HZ(33), TASK_PRIORITY_HIGH), // If event-based scheduling doesn't work, fallback to periodic scheduling
-    [TASK_DISPATCH] = DEFINE_TASK("DISPATCH", NULL, NULL, dispatchProcess, TASK_PERIOD_HZ(1000), TASK_PRIORITY_HIGH),
+    [TASK_DISPATCH] = DEFINE_TASK("DISPATCH", NULL, dispatchCheck, dispatchProcess, TASK_PERIOD_HZ(1000), TASK_PRIORITY_HIGH),
 
 #ifdef USE_BEEPER
     [TASK_BEEPER] = DEFINE_TASK("BEEPER", NULL, NULL, beeperUpdate, TASK_PERIOD_HZ(100), TASK_PRIORITY_LOW),
@@ -347,7 +343,7 @@ task_attribute_t task_attributes[TASK_COUNT] = {
 #endif
 
 #ifdef USE_MAG
-    [TASK_COMPASS] = DEFINE_TASK("COMPASS", NULL, NULL, taskUpdateMag, TASK_PERIOD_HZ(10), TASK_PRIORITY_LOW),
+    [TASK_COMPASS] = DEFINE_TASK("COMPASS", NULL, compassCheck, taskUpdateMag, TASK_PERIOD_HZ(10), TASK_PRIORITY_LOW),
 #endif
 
 #ifdef USE_BARO
@@ -355,19 +351,19 @@ task_attribute_t task_attributes[TASK_COUNT] = {
 #endif
 
 #ifdef USE_DASHBOARD
-    [TASK_DASHBOARD] = DEFINE_TASK("DASHBOARD", NULL, NULL, dashboardUpdate, TASK_PERIOD_HZ(10), TASK_PRIORITY_LOW),
+    [TASK_DASHBOARD] = DEFINE_DEADLINE_TASK("DASHBOARD", NULL, NULL, dashboardUpdate, TASK_PERIOD_HZ(10), TASK_PRIORITY_LOW),
 #endif
 
 #ifdef USE_OSD
-    [TASK_OSD] = DEFINE_TASK("OSD", NULL, osdUpdateCheck, osdUpdate, TASK_PERIOD_HZ(OSD_FRAMERATE_DEFAULT_HZ), TASK_PRIORITY_LOW),
+    [TASK_OSD] = DEFINE_DEADLINE_TASK("OSD", NULL, osdUpdateCheck, osdUpdate, TASK_PERIOD_HZ(OSD_FRAMERATE_DEFAULT_HZ), TASK_PRIORITY_LOW),
 #endif
 
 #ifdef USE_TELEMETRY
-    [TASK_TELEMETRY] = DEFINE_TASK("TELEMETRY", NULL, NULL, taskTelemetry, TASK_PERIOD_HZ(250), TASK_PRIORITY_LOW),
+    [TASK_TELEMETRY] = DEFINE_DEADLINE_TASK("TELEMETRY", NULL, NULL, taskTelemetry, TASK_PERIOD_HZ(250), TASK_PRIORITY_LOW),
 #endif
 
 #ifdef USE_LED_STRIP
-    [TASK_LEDSTRIP] = DEFINE_TASK("LEDSTRIP", NULL, NULL, ledStripUpdate, TASK_PERIOD_HZ(100), TASK_PRIORITY_LOW),
+    [TASK_LEDSTRIP] = DEFINE_DEADLINE_TASK("LEDSTRIP", NULL, NULL, ledStripUpdate, TASK_PERIOD_HZ(100), TASK_PRIORITY_LOW),
 #endif
 
 #ifdef USE_BST
@@ -379,7 +375,7 @@ task_attribute_t task_attributes[TASK_COUNT] = {
 #endif
 
 #ifdef USE_CMS
-    [TASK_CMS] = DEFINE_TASK("CMS", NULL, NULL, cmsHandler, TASK_PERIOD_HZ(20), TASK_PRIORITY_LOW),
+    [TASK_CMS] = DEFINE_DEADLINE_TASK("CMS", NULL, NULL, cmsHandler, TASK_PERIOD_HZ(20), TASK_PRIORITY_LOW),
 #endif
 
 #ifdef USE_VTX_CONTROL
@@ -398,16 +394,16 @@ task_attribute_t task_attributes[TASK_COUNT] = {
     [TASK_ADC_INTERNAL] = DEFINE_TASK("ADCINTERNAL", NULL, NULL, adcInternalProcess, TASK_PERIOD_HZ(1), TASK_PRIORITY_LOWEST),
 #endif
 
-#ifdef USE_PINIOBOX
-    [TASK_PINIOBOX] = DEFINE_TASK("PINIOBOX", NULL, NULL, pinioBoxUpdate, TASK_PERIOD_HZ(20), TASK_PRIORITY_LOWEST),
+#ifdef USE_CRSF_V3
+    [TASK_SPEED_NEGOTIATION] = DEFINE_TASK("SPEED_NEGOTIATION", NULL, NULL, speedNegotiationProcess, TASK_PERIOD_HZ(100), TASK_PRIORITY_LOW),
 #endif
 
-#ifdef USE_RANGEFINDER
-    [TASK_RANGEFINDER] = DEFINE_TASK("RANGEFINDER", NULL, NULL, taskUpdateRangefinder, TASK_PERIOD_HZ(10), TASK_PRIORITY_LOWEST),
+#ifdef USE_BLACKBOX
+    [TASK_BLACKBOX] = DEFINE_TASK("BLACKBOX", NULL, blackboxEncodeCheck, blackboxEncode, TASK_PERIOD_HZ(1000), TASK_PRIORITY_LOW), // Encodes the frames captured in the PID loop
 #endif
 
-#ifdef USE_CRSF_V3
-    [TASK_SPEED_NEGOTIATION] = DEFINE_TASK("SPEED_NEGOTIATION", NULL, NULL, speedNegotiationProcess, TASK_PERIOD_HZ(100), TASK_PRIORITY_LOW),
+#ifdef USE_VIBRATION_ANALYSIS
+    [TASK_VIBRATION] = DEFINE_TASK("VIBRATION", NULL, NULL, vibrationUpdate, TASK_PERIOD_HZ(10), TASK_PRIORITY_LOWEST),
 #endif
 };
 
@@ -463,12 +459,12 @@ void tasksInit(void)
         setTaskEnabled(TASK_ACCEL, true);
         rescheduleTask(TASK_ACCEL, TASK_PERIOD_HZ(acc.sampleRateHz));
         setTaskEnabled(TASK_ATTITUDE, true);
-    }
+        if (imuConfig()->fast_update) {
+            rescheduleTask(TASK_ATTITUDE, TASK_PERIOD_HZ(IMU_CORRECTION_RATE_HZ));
+        }
+#ifdef USE_VIBRATION_ANALYSIS
+        setTaskEnabled(TASK_VIBRATION, true);
 #endif
-
-#ifdef USE_RANGEFINDER
-    if (sensors(SENSOR_RANGEFINDER)) {
-        setTaskEnabled(TASK_RANGEFINDER, featureIsEnabled(FEATURE_RANGEFINDER));
     }
 #endif
 
@@ -531,10 +527,6 @@ void tasksInit(void)
     setTaskEnabled(TASK_ADC_INTERNAL, true);
 #endif
 
-#ifdef USE_PINIOBOX
-    pinioBoxTaskControl();
-#endif
-
 #ifdef USE_CMS
     setTaskEnabled(TASK_CMS, featureIsEnabled(FEATURE_CMS));
 #endif
@@ -557,5 +549,9 @@ void tasksInit(void)
     const bool useCRSF = rxRuntimeState.serialrxProvider == SERIALRX_CRSF;
     setTaskEnabled(TASK_SPEED_NEGOTIATION, useCRSF);
 #endif
+
+#ifdef USE_BLACKBOX
+    setTaskEnabled(TASK_BLACKBOX, blackboxConfig()->device);
+#endif
 }
 
@@ -0,0 +1,128 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PID loop watchdog
+ *
+ * The PID loop kicks the watchdog every cycle, and the SysTick interrupt
+ * checks once per millisecond that it has. If the loop has not run for
+ * LOOP_WATCHDOG_TIMEOUT_MS while armed, PendSV is raised. It runs at the
+ * lowest priority, so it preempts the task code only, and its exception
+ * frame holds the PC, LR and SP of whatever was hogging the CPU.
+ *
+ * The fault record goes to the RTC backup registers and survives soft
+ * resets. The flight controller is not reset - a reset while flying would
+ * stop the motors - but arming is blocked after the next disarm until the
+ * board is rebooted.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "platform.h"
+
+#ifdef USE_LOOP_WATCHDOG
+
+#include "common/maths.h"
+
+#include "drivers/persistent.h"
+
+#include "fc/eventlog.h"
+#include "fc/runtime_config.h"
+#include "fc/watchdog.h"
+
+#include "scheduler/scheduler.h"
+
+volatile uint32_t loopWatchdogCounter;
+
+static struct {
+    uint32_t lastCounter;
+    uint32_t stallTicks;
+    bool     pending;
+    bool     tripped;
+} watchdog;
+
+void loopWatchdogInit(void)
+{
+    // PendSV resets to the highest priority
+    NVIC_SetPriority(PendSV_IRQn, (1 << __NVIC_PRIO_BITS) - 1);
+}
+
+// Called from SysTick_Handler
+void loopWatchdogCheck(void)
+{
+    const uint32_t counter = loopWatchdogCounter;
+
+    if (counter != watchdog.lastCounter || !ARMING_FLAG(ARMED)) {
+        watchdog.lastCounter = counter;
+        watchdog.stallTicks = 0;
+        watchdog.pending = false;
+    }
+    else if (!watchdog.pending && ++watchdog.stallTicks >= LOOP_WATCHDOG_TIMEOUT_MS) {
+        // Only one capture per stall
+        watchdog.pending = true;
+        SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+    }
+}
+
+// Called from PendSV_Handler with the exception frame of the preempted code
+void __attribute__((used)) loopWatchdogCapture(const uint32_t *frame)
+{
+    const taskId_e taskId = getCurrentTaskId();
+    const uint32_t count = (persistentObjectRead(PERSISTENT_OBJECT_LOOP_STALL_INFO) >> 8) & 0xff;
+
+    // Exception frame: R0-R3, R12, LR, PC, xPSR
+    persistentObjectWrite(PERSISTENT_OBJECT_LOOP_STALL_PC, frame[6]);
+    persistentObjectWrite(PERSISTENT_OBJECT_LOOP_STALL_LR, frame[5]);
+    persistentObjectWrite(PERSISTENT_OBJECT_LOOP_STALL_SP, (uint32_t)frame);
+    persistentObjectWrite(PERSISTENT_OBJECT_LOOP_STALL_INFO, (MIN(count + 1, 0xffU) << 8) | taskId);
+
+    watchdog.tripped = true;
+
+    eventLog(EVENT_LOOP_STALL, taskId);
+}
+
+void __attribute__((naked)) PendSV_Handler(void)
+{
+    __asm volatile (
+        "tst lr, #4         \n"
+        "ite eq             \n"
+        "mrseq r0, msp      \n"
+        "mrsne r0, psp      \n"
+        "b loopWatchdogCapture \n"
+    );
+}
+
+bool loopWatchdogTripped(void)
+{
+    return watchdog.tripped;
+}
+
+bool loopWatchdogGetFault(loopWatchdogFault_t *fault)
+{
+    const uint32_t info = persistentObjectRead(PERSISTENT_OBJECT_LOOP_STALL_INFO);
+
+    fault->pc = persistentObjectRead(PERSISTENT_OBJECT_LOOP_STALL_PC);
+    fault->lr = persistentObjectRead(PERSISTENT_OBJECT_LOOP_STALL_LR);
+    fault->sp = persistentObjectRead(PERSISTENT_OBJECT_LOOP_STALL_SP);
+    fault->taskId = info & 0xff;
+    fault->count = (info >> 8) & 0xff;
+
+    return fault->pc != 0;
+}
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define LOOP_WATCHDOG_TIMEOUT_MS    20      // PID loop stall while armed
+
+typedef struct {
+    uint32_t pc;                // preempted program counter
+    uint32_t lr;                // preempted link register
+    uint32_t sp;                // preempted stack pointer
+    uint8_t  taskId;            // task running when the stall was caught
+    uint8_t  count;             // stalls caught since the record was cleared
+} loopWatchdogFault_t;
+
+#ifdef USE_LOOP_WATCHDOG
+
+extern volatile uint32_t loopWatchdogCounter;
+
+void loopWatchdogInit(void);
+void loopWatchdogCheck(void);
+
+bool loopWatchdogTripped(void);
+bool loopWatchdogGetFault(loopWatchdogFault_t *fault);
+
+// Called by the PID loop every cycle
+static inline void loopWatchdogKick(void) { loopWatchdogCounter++; }
+
+#endif
@@ -51,10 +51,11 @@
 #include "fc/rc.h"
 
 #include "sensors/gyro.h"
+#include "sensors/gyro_init.h"
 
 #include "dyn_notch_filter.h"
 
-// SDFT_SAMPLE_SIZE defaults to 72 (common/sdft.h).
+// SDFT_SAMPLE_SIZE defaults to 72 (common/sdft.h), and can be raised per target for finer resolution.
 // We get 36 frequency bins from 72 consecutive data values, called SDFT_BIN_COUNT (common/sdft.h)
 // Bin 0 is DC and can't be used.
 // Only bins 1 to 35 are usable.
@@ -80,6 +81,8 @@
 // At 4k, it takes twice as long to update an axis, i.e. each axis updates only every 3ms.
 // Four points in the buffer will have changed in that time, and each point will be the average of three samples.
 // Hence output jitter at 4k is about four times worse than at 8k. At 2k output jitter is quite bad.
+// In parallel mode each step processes all three axes, so all axes are updated every 4 PID loops
+// at three times the cost per step.
 
 // Each SDFT output bin has width sdftSampleRateHz/72, ie 18.5Hz per bin at 1333Hz.
 // Usable bandwidth is half this, ie 666Hz if sdftSampleRateHz is 1333Hz, i.e. bin 1 is 18.5Hz, bin 2 is 37.0Hz etc.
@@ -114,6 +117,7 @@ typedef struct dynNotch_s {
     float minHz;
     float maxHz;
     int count;
+    bool parallel;
 
     int maxCenterFreq;
     float centerFreq[XYZ_AXIS_COUNT][DYN_NOTCH_COUNT_MAX];
@@ -136,12 +140,13 @@ static FAST_DATA_ZERO_INIT float sampleAvg[XYZ_AXIS_COUNT];
 // parameters for peak detection and frequency analysis
 static FAST_DATA_ZERO_INIT state_t state;
 static FAST_DATA_ZERO_INIT sdft_t  sdft[XYZ_AXIS_COUNT];
-static FAST_DATA_ZERO_INIT peak_t  peaks[DYN_NOTCH_COUNT_MAX];
-static FAST_DATA_ZERO_INIT float   sdftData[SDFT_BIN_COUNT];
+static FAST_DATA_ZERO_INIT peak_t  peaks[XYZ_AXIS_COUNT][DYN_NOTCH_COUNT_MAX];
+static FAST_DATA_ZERO_INIT float   sdftData[XYZ_AXIS_COUNT][SDFT_BIN_COUNT];
 static FAST_DATA_ZERO_INIT float   sdftSampleRateHz;
 static FAST_DATA_ZERO_INIT float   sdftResolutionHz;
 static FAST_DATA_ZERO_INIT int     sdftStartBin;
 static FAST_DATA_ZERO_INIT int     sdftEndBin;
+static FAST_DATA_ZERO_INIT float   sampleRateCorrection;
 
 
 INIT_CODE void dynNotchInit(const dynNotchConfig_t *config)
@@ -158,6 +163,7 @@ INIT_CODE void dynNotchInit(const dynNotchConfig_t *config)
     dynNotch.maxHz = MAX(dynNotch.minHz, config->dyn_notch_max_hz);
     dynNotch.maxHz = MIN(dynNotch.maxHz, updateNyquistHz); // Ensure to not go above the nyquist limit
     dynNotch.count = MIN(config->dyn_notch_count, DYN_NOTCH_COUNT_MAX);
+    dynNotch.parallel = config->dyn_notch_parallel;
     dynNotch.maxCenterFreq = 0;
 
     // Disable dynamic notch if dynNotchUpdate() would run at less than 1kHz
@@ -182,6 +188,7 @@ INIT_CODE void dynNotchInit(const dynNotchConfig_t *config)
     sdftResolutionHz = sdftSampleRateHz / SDFT_SAMPLE_SIZE; // 18.5hz per bin at 8k and 600Hz maxHz
     sdftStartBin = MAX(2, lrintf(dynNotch.minHz / sdftResolutionHz)); // can't use bin 0 because it is DC.
     sdftEndBin = MIN(SDFT_BIN_COUNT - 1, lrintf(dynNotch.maxHz / sdftResolutionHz)); // can't use more than SDFT_BIN_COUNT bins.
+    sampleRateCorrection = 1.0f;
 
     for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
         sdftInit(&sdft[axis], sdftStartBin, sdftEndBin, sampleCount);
@@ -221,16 +228,15 @@ FAST_CODE void dynNotchUpdate(void)
         // recalculation of filters takes 4 calls per axis => each filter gets updated every DYN_NOTCH_CALC_TICKS calls
         // at 8kHz PID loop rate this means 8kHz / 4 / 3 = 666Hz => update every 1.5ms
         // at 4kHz PID loop rate this means 4kHz / 4 / 3 = 333Hz => update every 3ms
-        state.tick = DYN_NOTCH_CALC_TICKS;
+        state.tick = dynNotch.parallel ? STEP_COUNT : DYN_NOTCH_CALC_TICKS;
     }
 
     // 2us @ F722
     DEBUG_TIME_START(DYN_NOTCH_TIME, 1);
 
-    // SDFT processing in batches to synchronize with incoming downsampled data
-    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-        sdftPushBatch(&sdft[axis], sampleAvg[axis], sampleIndex);
-    }
+    // SDFT processing in batches to synchronize with incoming downsampled data.
+    // All axes share the bin range, so they are updated in a single pass.
+    sdftPushBatchXYZ(sdft, sampleAvg, sampleIndex);
     DEBUG_TIME_END(DYN_NOTCH_TIME, 1);
 
     sampleIndex++;
@@ -244,104 +250,146 @@ FAST_CODE void dynNotchUpdate(void)
     DEBUG_TIME_END(DYN_NOTCH_TIME, 0);
 }
 
+// Search for the N biggest peaks in the spectrum of one axis
+static FAST_CODE void dynNotchDetectPeaks(const float *data, peak_t *peak)
+{
+    int minIndex = 0;
+
+    for (int p = 0; p < dynNotch.count; p++) {
+        peak[p].bin = 0;
+        peak[p].value = 0.0f;
+    }
+
+    // Partial selection: a new peak replaces the smallest one kept so far
+    for (int bin = (sdftStartBin + 1); bin < sdftEndBin; bin++) {
+        if ((data[bin] > data[bin - 1]) && (data[bin] > data[bin + 1])) {
+            if (data[bin] > peak[minIndex].value) {
+                peak[minIndex].bin = bin;
+                peak[minIndex].value = data[bin];
+
+                minIndex = 0;
+                for (int p = 1; p < dynNotch.count; p++) {
+                    if (peak[p].value < peak[minIndex].value) {
+                        minIndex = p;
+                    }
+                }
+            }
+            bin++; // If bin is peak, next bin can't be peak => skip it
+        }
+    }
+
+    // Sort the N peaks in descending height order
+    for (int p = 1; p < dynNotch.count; p++) {
+        const peak_t tmp = peak[p];
+        int k = p;
+        while (k > 0 && peak[k - 1].value < tmp.value) {
+            peak[k] = peak[k - 1];
+            k--;
+        }
+        peak[k] = tmp;
+    }
+}
+
+static FAST_CODE void dynNotchCalcFrequencies(int axis, const float *data, const peak_t *peak)
+{
+    for (int p = 0; p < dynNotch.count; p++) {
+
+        // Only update dynNotch.centerFreq if there is a peak (ignore void peaks) and if peak is above noise floor
+        if (peak[p].bin != 0 && peak[p].value > 0.0f) {
+
+            float meanBin = peak[p].bin;
+
+            // Height of peak bin (y1) and shoulder bins (y0, y2)
+            const float y0 = data[peak[p].bin - 1];
+            const float y1 = data[peak[p].bin];
+            const float y2 = data[peak[p].bin + 1];
+
+            // Estimate true peak position aka. meanBin (fit parabola y(x) over y0, y1 and y2, solve dy/dx=0 for x)
+            const float denom = 2.0f * (y0 - 2 * y1 + y2);
+            if (denom != 0.0f) {
+                meanBin += (y0 - y2) / denom;
+            }
+
+            // Convert bin to frequency: freq = bin * binResoultion (bin 0 is 0Hz)
+            const float centerFreq = constrainf(meanBin * sdftResolutionHz * sampleRateCorrection, dynNotch.minHz, dynNotch.maxHz);
+
+            dynNotch.centerFreq[axis][p] = centerFreq;
+        }
+    }
+
+    if (getThrottlePercent() > DYN_NOTCH_OSD_MIN_THROTTLE) {
+        for (int p = 0; p < dynNotch.count; p++) {
+            dynNotch.maxCenterFreq = MAX(dynNotch.maxCenterFreq, dynNotch.centerFreq[axis][p]);
+        }
+    }
+
+    if (axis == debugAxis) {
+        for (int p = 0; p < dynNotch.count; p++) {
+            if (p < 8) {
+                DEBUG(DYN_NOTCH_FREQ, p, lrintf(dynNotch.centerFreq[axis][p] * 10.0f));
+            }
+            if (p < 4) {
+                DEBUG(DYN_NOTCH, p+4, lrintf(dynNotch.centerFreq[axis][p]));
+            }
+        }
+    }
+}
+
+static FAST_CODE void dynNotchUpdateFilters(int axis, const peak_t *peak)
+{
+    for (int p = 0; p < dynNotch.count; p++) {
+        // Only update notch filter coefficients if the corresponding peak got its center frequency updated in the previous step
+        if (peak[p].bin != 0 && peak[p].value > 0.0f) {
+            biquadFilterUpdate(&dynNotch.notch[axis][p], dynNotch.centerFreq[axis][p], gyro.filterRateHz * sampleRateCorrection, dynNotch.q + p * DYN_NOTCH_Q_ADVANCE, BIQUAD_NOTCH);
+        }
+    }
+}
+
 // Find frequency peaks and update filters
 static FAST_CODE void dynNotchProcess(void)
 {
     DEBUG_TIME_START(DYN_NOTCH_TIME, state.step + 2); // 2-5
 
+    // In parallel mode every step covers all axes, otherwise just state.axis
+    const int first = dynNotch.parallel ? 0 : state.axis;
+    const int last = dynNotch.parallel ? XYZ_AXIS_COUNT - 1 : state.axis;
+
     switch (state.step) {
 
         case STEP_WINDOW: // 4.1us (3-6us) @ F722
         {
-            sdftWinSq(&sdft[state.axis], sdftData);
+            if (dynNotch.parallel) {
+                sdftWinSqXYZ(sdft, sdftData);
+            } else {
+                sdftWinSq(&sdft[state.axis], sdftData[state.axis]);
+            }
+
+            // Compensate for gyro oscillator drift
+            sampleRateCorrection = gyroGetSampleRateCorrection();
 
             break;
         }
         case STEP_DETECT_PEAKS: // 5.5us (4-7us) @ F722
         {
-            // Get memory ready for new peak data on current axis
-            for (int p = 0; p < dynNotch.count; p++) {
-                peaks[p].bin = 0;
-                peaks[p].value = 0.0f;
+            for (int axis = first; axis <= last; axis++) {
+                dynNotchDetectPeaks(sdftData[axis], peaks[axis]);
             }
-
-            // Search for N biggest peaks in frequency spectrum
-            for (int bin = (sdftStartBin + 1); bin < sdftEndBin; bin++) {
-                // Check if bin is peak
-                if ((sdftData[bin] > sdftData[bin - 1]) && (sdftData[bin] > sdftData[bin + 1])) {
-                    // Check if peak is big enough to be one of N biggest peaks.
-                    // If so, insert peak and sort peaks in descending height order
-                    for (int p = 0; p < dynNotch.count; p++) {
-                        if (sdftData[bin] > peaks[p].value) {
-                            for (int k = dynNotch.count - 1; k > p; k--) {
-                                peaks[k] = peaks[k - 1];
-                            }
-                            peaks[p].bin = bin;
-                            peaks[p].value = sdftData[bin];
-                            break;
-                        }
-                    }
-                    bin++; // If bin is peak, next bin can't be peak => skip it
-                }
-            }
-
             break;
         }
         case STEP_CALC_FREQUENCIES: // 4.0us (2-7us) @ F722
         {
-            for (int p = 0; p < dynNotch.count; p++) {
-
-                // Only update dynNotch.centerFreq if there is a peak (ignore void peaks) and if peak is above noise floor
-                if (peaks[p].bin != 0 && peaks[p].value > 0.0f) {
-
-                    float meanBin = peaks[p].bin;
-
-                    // Height of peak bin (y1) and shoulder bins (y0, y2)
-                    const float y0 = sdftData[peaks[p].bin - 1];
-                    const float y1 = sdftData[peaks[p].bin];
-                    const float y2 = sdftData[peaks[p].bin + 1];
-
-                    // Estimate true peak position aka. meanBin (fit parabola y(x) over y0, y1 and y2, solve dy/dx=0 for x)
-                    const float denom = 2.0f * (y0 - 2 * y1 + y2);
-                    if (denom != 0.0f) {
-                        meanBin += (y0 - y2) / denom;
-                    }
-
-                    // Convert bin to frequency: freq = bin * binResoultion (bin 0 is 0Hz)
-                    const float centerFreq = constrainf(meanBin * sdftResolutionHz, dynNotch.minHz, dynNotch.maxHz);
-
-                    dynNotch.centerFreq[state.axis][p] = centerFreq;
-                }
-            }
-
-            if (getThrottlePercent() > DYN_NOTCH_OSD_MIN_THROTTLE) {
-                for (int p = 0; p < dynNotch.count; p++) {
-                    dynNotch.maxCenterFreq = MAX(dynNotch.maxCenterFreq, dynNotch.centerFreq[state.axis][p]);
-                }
-            }
-
-            if (state.axis == debugAxis) {
-                for (int p = 0; p < dynNotch.count; p++) {
-                    if (p < 8) {
-                        DEBUG(DYN_NOTCH_FREQ, p, lrintf(dynNotch.centerFreq[state.axis][p] * 10.0f));
-                    }
-                    if (p < 4) {
-                        DEBUG(DYN_NOTCH, p+4, lrintf(dynNotch.centerFreq[state.axis][p]));
-                    }
-                }
+            for (int axis = first; axis <= last; axis++) {
+                dynNotchCalcFrequencies(axis, sdftData[axis], peaks[axis]);
             }
             break;
         }
         case STEP_UPDATE_FILTERS: // 5.4us (2-9us) @ F722
         {
-            for (int p = 0; p < dynNotch.count; p++) {
-                // Only update notch filter coefficients if the corresponding peak got its center frequency updated in the previous step
-                if (peaks[p].bin != 0 && peaks[p].value > 0.0f) {
-                    biquadFilterUpdate(&dynNotch.notch[state.axis][p], dynNotch.centerFreq[state.axis][p], gyro.filterRateHz, dynNotch.q + p * DYN_NOTCH_Q_ADVANCE, BIQUAD_NOTCH);
-                }
+            for (int axis = first; axis <= last; axis++) {
+                dynNotchUpdateFilters(axis, peaks[axis]);
             }
 
-            state.axis = (state.axis + 1) % XYZ_AXIS_COUNT;
+            state.axis = dynNotch.parallel ? 0 : (state.axis + 1) % XYZ_AXIS_COUNT;
 
             break;
         }
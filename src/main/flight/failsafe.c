@@ -35,6 +35,7 @@
 
 #include "config/config.h"
 #include "fc/core.h"
+#include "fc/eventlog.h"
 #include "fc/rc_controls.h"
 #include "fc/rc_modes.h"
 #include "fc/runtime_config.h"
@@ -239,6 +240,7 @@ void failsafeUpdateState(void)
         beeperMode = BEEPER_RX_LOST;
     }
 
+    const failsafePhase_e previousPhase = failsafeState.phase;
     bool reprocessState;
 
     do {
@@ -406,6 +408,10 @@ void failsafeUpdateState(void)
         }
     } while (reprocessState);
 
+    if (failsafeState.phase != previousPhase) {
+        eventLog(EVENT_FAILSAFE_PHASE, failsafeState.phase);
+    }
+
     if (beeperMode != BEEPER_SILENCE) {
         beeper(beeperMode);
     }
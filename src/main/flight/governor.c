@@ -33,11 +33,14 @@
 
 #include "drivers/time.h"
 
+#include "fc/eventlog.h"
 #include "fc/runtime_config.h"
 #include "fc/rc_controls.h"
+#include "fc/rc_modes.h"
 #include "fc/rc.h"
 
 #include "sensors/battery.h"
+#include "sensors/esc_sensor.h"
 #include "sensors/gyro.h"
 
 #include "rx/rx.h"
@@ -68,8 +71,40 @@
 // Nominal battery cell voltage
 #define GOV_NOMINAL_CELL_VOLTAGE        3.70f
 
+// Battery model averaging time (s)
+#define GOV_BATTERY_MODEL_TIME          2.0f
 
-PG_REGISTER_WITH_RESET_TEMPLATE(governorConfig_t, governorConfig, PG_GOVERNOR_CONFIG, 0);
+// Minimum current variance for a resistance update (A²)
+#define GOV_BATTERY_MODEL_MIN_VAR       4.0f
+
+// Battery internal resistance limit (Ohm)
+#define GOV_BATTERY_MAX_RESISTANCE      0.5f
+
+// Load current filter cutoff for sag compensation (Hz)
+#define GOV_LOAD_CURRENT_CUTOFF         20
+
+// Autotune throttle step size and number of steps
+#define GOV_AUTOTUNE_STEP_SIZE          0.04f
+#define GOV_AUTOTUNE_STEPS              4
+
+// Autotune phase durations (ms)
+#define GOV_AUTOTUNE_SETTLE_TIME        1000
+#define GOV_AUTOTUNE_BASELINE_TIME      250
+#define GOV_AUTOTUNE_STEP_TIME          1500
+
+// Autotune step response samples
+#define GOV_AUTOTUNE_SAMPLES            100
+
+// Autotune headspeed ratio limits
+#define GOV_AUTOTUNE_STABLE_ERROR       0.02f
+#define GOV_AUTOTUNE_ABORT_ERROR        0.10f
+#define GOV_AUTOTUNE_MIN_RESPONSE       0.005f
+
+// Autotune averaging cutoff (Hz)
+#define GOV_AUTOTUNE_AVERAGE_CUTOFF     2
+
+
+PG_REGISTER_WITH_RESET_TEMPLATE(governorConfig_t, governorConfig, PG_GOVERNOR_CONFIG, 1);
 
 PG_RESET_TEMPLATE(governorConfig_t, governorConfig,
     .gov_mode = GM_PASSTHROUGH,
@@ -87,6 +122,8 @@ PG_RESET_TEMPLATE(governorConfig_t, governorConfig,
     .gov_rpm_filter = 10,
     .gov_tta_filter = 0,
     .gov_ff_filter = 10,
+    .gov_latency_comp = 0,
+    .gov_sag_comp = 0,
 );
 
 
@@ -116,6 +153,7 @@ typedef struct {
 
     // Throttle handover level
     float           maxIdleThrottle;
+    float           idleThrottleGain;
 
     // Current headspeed
     float           actualHeadSpeed;
@@ -143,6 +181,11 @@ typedef struct {
     float           motorRPMGlitchLimit;
     uint32_t        motorRPMDetectTime;
 
+    // RPM filter delay compensation
+    bool            latencyComp;
+    float           motorRPMFilterDelay;
+    float           motorRPMFilteredPrev;
+
     // Battery voltage & current
     float           motorVoltage;
     filter_t        motorVoltageFilter;
@@ -152,6 +195,23 @@ typedef struct {
     // Nominal battery voltage
     float           nominalVoltage;
 
+    // Battery model: V = Voc - R * I
+    bool            sagComp;
+    bool            batteryModelActive;
+    float           batteryModelGain;
+    float           batteryMeanVoltage;
+    float           batteryMeanCurrent;
+    float           batteryVarCurrent;
+    float           batteryCovariance;
+    float           batteryResistance;
+    float           batteryOpenVoltage;
+
+    // Load observer
+    float           loadCurrent;
+    filter_t        loadCurrentFilter;
+    float           loadVoltage;
+    float           loadTorque;
+
     // PID terms
     float           P;
     float           I;
@@ -209,6 +269,47 @@ typedef struct {
 static FAST_DATA_ZERO_INIT govData_t gov;
 
 
+//// Autotune Data
+
+#ifdef USE_GOVERNOR_AUTOTUNE
+
+typedef struct {
+
+    // Results
+    govAutotune_t   result;
+
+    // Switch state
+    bool            request;
+
+    // Phase timing
+    timeMs_t        entryTime;
+
+    // Operating point
+    float           throttle;
+    float           headSpeed;
+    float           requestedHeadSpeed;
+    float           voltageGain;
+    float           averageGain;
+
+    // Step direction
+    float           sign;
+
+    // Identified model sums
+    float           sumGain;
+    float           sumDelay;
+    float           sumTau;
+
+    // Step response, headspeed ratio change
+    uint8_t         sampleCount;
+    float           samples[GOV_AUTOTUNE_SAMPLES];
+
+} govAutotuneData_t;
+
+static govAutotuneData_t tune;
+
+#endif
+
+
 //// Handler functions
 
 typedef void  (*govVoidFn)(void);
@@ -236,6 +337,11 @@ static float govMode2Control(void);
 static void governorUpdateState(void);
 static void governorUpdatePassthrough(void);
 
+#ifdef USE_GOVERNOR_AUTOTUNE
+static void govAutotuneCheck(void);
+static float govAutotuneUpdate(float output);
+#endif
+
 
 
 //// Access functions
@@ -306,6 +412,16 @@ float getSpoolUpRatio(void)
     return 0;
 }
 
+const govAutotune_t *getGovernorAutotune(void)
+{
+#ifdef USE_GOVERNOR_AUTOTUNE
+    return &tune.result;
+#else
+    static const govAutotune_t off = { 0 };
+    return &off;
+#endif
+}
+
 bool isSpooledUp(void)
 {
     if (!ARMING_FLAG(ARMED))
@@ -347,8 +463,7 @@ static inline float idleMap(float throttle)
     //     0%..5%    => 0%
     //     5%..N%    => 0%..N%
     //     >N%       => N%
-    throttle = (throttle - GOV_THROTTLE_OFF_LIMIT) * gov.maxIdleThrottle /
-        (gov.maxIdleThrottle - GOV_THROTTLE_OFF_LIMIT);
+    throttle = (throttle - GOV_THROTTLE_OFF_LIMIT) * gov.idleThrottleGain;
 
     return constrainf(throttle, 0, gov.maxIdleThrottle);
 }
@@ -360,6 +475,10 @@ static inline float angleDrag(float angle)
 
 static inline void govChangeState(uint8_t futureState)
 {
+    if (gov.state != futureState) {
+        eventLog(EVENT_GOVERNOR_STATE, futureState);
+    }
+
     gov.state = futureState;
     gov.stateEntryTime = millis();
 }
@@ -381,6 +500,87 @@ static void govDebugStats(void)
     DEBUG(GOVERNOR, 7, gov.F * 1000);
 }
 
+static float govGetCurrentSample(void)
+{
+#ifdef USE_ESC_SENSOR
+    // Use ESC telemetry if there is no current sensor
+    if (!isBatteryCurrentConfigured()) {
+        const escSensorData_t *escData = getEscSensorData(ESC_SENSOR_COMBINED);
+        return escData ? escData->current * 0.001f : 0;
+    }
+#endif
+    return getBatterySnapshot()->currentSample * 0.001f;
+}
+
+/*
+ * Battery internal resistance and rotor load observer.
+ *
+ * The slow V/I averages give the open circuit voltage and the internal
+ * resistance as the slope of V against I, by exponentially weighted
+ * linear regression. The resistance is only updated when the current
+ * has varied enough to make the slope meaningful.
+ *
+ * With these, the voltage at the ESC follows the fast load current:
+ *
+ *   V = Voc - R * I
+ *
+ * which is what the Mode2 voltage compensation uses when gov_sag_comp
+ * is enabled, instead of the slowly filtered measured voltage.
+ */
+
+static void govUpdateLoadObserver(void)
+{
+    if (gov.nominalVoltage > 0 && gov.motorVoltage > 0) {
+        if (!gov.batteryModelActive) {
+            gov.batteryModelActive = true;
+            gov.batteryMeanVoltage = gov.motorVoltage;
+            gov.batteryMeanCurrent = gov.motorCurrent;
+            gov.batteryVarCurrent = 0;
+            gov.batteryCovariance = 0;
+            gov.batteryResistance = 0;
+        }
+
+        const float k = gov.batteryModelGain;
+        const float dV = gov.motorVoltage - gov.batteryMeanVoltage;
+        const float dI = gov.motorCurrent - gov.batteryMeanCurrent;
+
+        gov.batteryMeanVoltage += dV * k;
+        gov.batteryMeanCurrent += dI * k;
+        gov.batteryVarCurrent = (1 - k) * (gov.batteryVarCurrent + k * dI * dI);
+        gov.batteryCovariance = (1 - k) * (gov.batteryCovariance + k * dI * dV);
+
+        if (gov.batteryVarCurrent > GOV_BATTERY_MODEL_MIN_VAR) {
+            gov.batteryResistance = constrainf(-gov.batteryCovariance / gov.batteryVarCurrent, 0, GOV_BATTERY_MAX_RESISTANCE);
+        }
+
+        gov.batteryOpenVoltage = gov.batteryMeanVoltage + gov.batteryResistance * gov.batteryMeanCurrent;
+        gov.loadVoltage = fmaxf(gov.batteryOpenVoltage - gov.batteryResistance * gov.loadCurrent, 1.0f);
+    }
+    else {
+        // Battery unplugged - start over
+        gov.batteryModelActive = false;
+        gov.batteryOpenVoltage = gov.motorVoltage;
+        gov.loadVoltage = gov.motorVoltage;
+    }
+
+    // Rotor torque from the electrical power, in Nm
+    const float headSpeedRad = gov.actualHeadSpeed * (M_2PIf / 60);
+    gov.loadTorque = (headSpeedRad > 1) ? (gov.loadVoltage * gov.loadCurrent) / headSpeedRad : 0;
+
+    DEBUG(GOV_LOAD, 0, gov.motorVoltage * 100);
+    DEBUG(GOV_LOAD, 1, gov.motorCurrent * 100);
+    DEBUG(GOV_LOAD, 2, gov.loadCurrent * 100);
+    DEBUG(GOV_LOAD, 3, gov.batteryResistance * 10000);
+    DEBUG(GOV_LOAD, 4, gov.batteryOpenVoltage * 100);
+    DEBUG(GOV_LOAD, 5, gov.loadVoltage * 100);
+    DEBUG(GOV_LOAD, 6, gov.loadTorque * 1000);
+}
+
+static inline float govVoltageGain(void)
+{
+    return gov.nominalVoltage / (gov.sagComp ? gov.loadVoltage : gov.motorVoltage);
+}
+
 static void govUpdateInputs(void)
 {
     // Update throttle state
@@ -388,13 +588,21 @@ static void govUpdateInputs(void)
     gov.throttleInputLow = (getThrottleStatus() == THROTTLE_LOW);
 
     // Assume motor[0]
-    gov.motorRPM = getMotorRawRPMf(0);
+    gov.motorRPM = getMotorTrackedRPMf(0);
 
     // RPM signal is noisy - filtering is required
     float filteredRPM = filterApply(&gov.motorRPMFilter, gov.motorRPM);
 
     // Calculate headspeed from filtered motor speed
-    gov.actualHeadSpeed = filteredRPM * gov.mainGearRatio;
+    if (gov.latencyComp) {
+        // Extrapolate the filtered RPM over the filter group delay
+        const float rpmRate = (filteredRPM - gov.motorRPMFilteredPrev) / pidGetDT();
+        gov.motorRPMFilteredPrev = filteredRPM;
+        gov.actualHeadSpeed = fmaxf(filteredRPM + rpmRate * gov.motorRPMFilterDelay, 0) * gov.mainGearRatio;
+    }
+    else {
+        gov.actualHeadSpeed = filteredRPM * gov.mainGearRatio;
+    }
 
     // Calculate HS vs FullHS ratio
     gov.fullHeadSpeedRatio = gov.actualHeadSpeed / gov.fullHeadSpeed;
@@ -426,8 +634,12 @@ static void govUpdateInputs(void)
     gov.nominalVoltage = getBatteryCellCount() * GOV_NOMINAL_CELL_VOLTAGE;
 
     // Voltage & current filters
-    gov.motorVoltage = filterApply(&gov.motorVoltageFilter, getBatteryVoltageSample() * 0.01f);
-    gov.motorCurrent = filterApply(&gov.motorCurrentFilter, getBatteryCurrentSample() * 0.01f);
+    const float current = govGetCurrentSample();
+    gov.motorVoltage = filterApply(&gov.motorVoltageFilter, getBatterySnapshot()->voltageSample * 0.001f);
+    gov.motorCurrent = filterApply(&gov.motorCurrentFilter, current);
+    gov.loadCurrent = filterApply(&gov.loadCurrentFilter, current);
+
+    govUpdateLoadObserver();
 }
 
 static void govUpdateData(void)
@@ -458,8 +670,9 @@ static void govUpdateData(void)
     // Angle-of-attack vs. FeedForward curve
     float totalFF = angleDrag(collectiveFF + cyclicFF) + angleDrag(yawFF);
 
-    // Filtered FeedForward
-    totalFF = filterApply(&gov.FFFilter, totalFF);
+    // Filtered FeedForward, unless applied without delay
+    if (!gov.latencyComp)
+        totalFF = filterApply(&gov.FFFilter, totalFF);
 
     // Tail Torque Assist
     if (mixerMotorizedTail() && gov.TTAGain != 0) {
@@ -719,6 +932,9 @@ static void governorUpdateState(void)
                 } else {
                     govMain = govActiveCalc();
                     gov.targetHeadSpeed = slewLimit(gov.targetHeadSpeed, gov.requestedHeadSpeed, gov.headSpeedTrackingRate);
+#ifdef USE_GOVERNOR_AUTOTUNE
+                    govMain = govAutotuneUpdate(govMain);
+#endif
                 }
                 break;
 
@@ -922,7 +1138,7 @@ static float govMode1Control(void)
 static void govMode2Init(void)
 {
     // Normalized battery voltage
-    float pidGain = gov.nominalVoltage / gov.motorVoltage;
+    float pidGain = govVoltageGain();
 
     // Expected PID output
     float pidTarget = gov.throttle / pidGain;
@@ -944,7 +1160,7 @@ static float govMode2Control(void)
     float output;
 
     // Normalized battery voltage
-    float pidGain = gov.nominalVoltage / gov.motorVoltage;
+    float pidGain = govVoltageGain();
 
     // PID limits
     gov.P = constrainf(gov.P, -0.25f, 0.25f);
@@ -969,6 +1185,246 @@ static float govMode2Control(void)
 }
 
 
+/*
+ * Autotune
+ *
+ * With the GOVERNOR AUTOTUNE mode on in a steady hover, the governor is
+ * opened for short throttle steps around the hover throttle, alternately
+ * up and down. The headspeed response of each step is fitted with a first
+ * order plus dead time model by Smith's two-point method:
+ *
+ *   tau   = 1.5 * (t63 - t28)
+ *   delay = t63 - tau
+ *   gain  = headspeed ratio change / throttle change
+ *
+ * The averaged model gives the PID gains by the SIMC rules, with the closed
+ * loop time constant tc = max(delay, tau / 4):
+ *
+ *   Kp = tau / (gain * (tc + delay))
+ *   Ki = Kp / min(tau, 4 * (tc + delay))
+ *   Kd = Kp * delay / 3
+ *
+ * The gains are applied to the current profile when the tune completes,
+ * and saved on disarm. The tune is aborted if the headspeed goes off by
+ * more than GOV_AUTOTUNE_ABORT_ERROR, the headspeed request changes, or
+ * the governor leaves the ACTIVE state.
+ */
+
+#ifdef USE_GOVERNOR_AUTOTUNE
+
+static void govAutotuneChangeState(uint8_t state)
+{
+    if (state == GOV_AUTOTUNE_SETTLE)
+        tune.throttle = gov.throttle;
+
+    tune.result.state = state;
+    tune.entryTime = millis();
+}
+
+static inline long govAutotuneTime(void)
+{
+    return cmp32(millis(), tune.entryTime);
+}
+
+static inline bool govAutotuneRunning(void)
+{
+    return tune.result.state >= GOV_AUTOTUNE_SETTLE && tune.result.state <= GOV_AUTOTUNE_STEP;
+}
+
+static inline bool govAutotuneOpenLoop(void)
+{
+    return tune.result.state == GOV_AUTOTUNE_BASELINE || tune.result.state == GOV_AUTOTUNE_STEP;
+}
+
+static void govAutotuneAbort(void)
+{
+    // Back to closed loop from the open loop throttle
+    if (govAutotuneOpenLoop() && gov.state == GS_ACTIVE)
+        govActiveInit();
+
+    govAutotuneChangeState(GOV_AUTOTUNE_ABORTED);
+    eventLog(EVENT_GOV_AUTOTUNE, GOV_AUTOTUNE_ABORTED);
+}
+
+// Time (s) the step response first reaches level, or -1
+static float govAutotuneCrossing(float level)
+{
+    const float sampleTime = GOV_AUTOTUNE_STEP_TIME * 0.001f / GOV_AUTOTUNE_SAMPLES;
+
+    for (int index = 1; index < GOV_AUTOTUNE_SAMPLES; index++) {
+        const float prev = tune.samples[index - 1];
+        const float curr = tune.samples[index];
+        if (curr >= level && curr > prev) {
+            return (index - 1 + (level - prev) / (curr - prev)) * sampleTime;
+        }
+    }
+
+    return -1;
+}
+
+static bool govAutotuneFit(void)
+{
+    const int tail = GOV_AUTOTUNE_SAMPLES / 5;
+
+    float final = 0;
+
+    for (int index = GOV_AUTOTUNE_SAMPLES - tail; index < GOV_AUTOTUNE_SAMPLES; index++)
+        final += tune.samples[index];
+
+    final /= tail;
+
+    if (final < GOV_AUTOTUNE_MIN_RESPONSE)
+        return false;
+
+    const float t28 = govAutotuneCrossing(0.283f * final);
+    const float t63 = govAutotuneCrossing(0.632f * final);
+
+    if (t28 < 0 || t63 <= t28)
+        return false;
+
+    const float tau = 1.5f * (t63 - t28);
+
+    tune.sumGain  += final / GOV_AUTOTUNE_STEP_SIZE;
+    tune.sumDelay += fmaxf(t63 - tau, 0);
+    tune.sumTau   += tau;
+
+    return true;
+}
+
+static void govAutotuneFinish(void)
+{
+    govAutotune_t *result = &tune.result;
+
+    result->gain  = tune.sumGain  / result->steps;
+    result->delay = tune.sumDelay / result->steps;
+    result->tau   = tune.sumTau   / result->steps;
+
+    // Mode2 scales the PID output with the battery voltage
+    const float plantGain = result->gain * tune.voltageGain;
+    const float tc = fmaxf(result->delay, result->tau / 4);
+
+    const float Kp = result->tau / (plantGain * (tc + result->delay));
+    const float Ki = Kp / fminf(result->tau, 4 * (tc + result->delay));
+    const float Kd = Kp * result->delay / 3;
+
+    // The gains are relative to the master gain, see governorInitProfile()
+    if (gov.K > 0) {
+        result->p_gain = constrain(lrintf(Kp / gov.K * 10), 0, 250);
+        result->i_gain = constrain(lrintf(Ki / gov.K * 10), 0, 250);
+        result->d_gain = constrain(lrintf(Kd / gov.K * 1000), 0, 250);
+
+        currentPidProfile->governor.p_gain = result->p_gain;
+        currentPidProfile->governor.i_gain = result->i_gain;
+        currentPidProfile->governor.d_gain = result->d_gain;
+
+        governorInitProfile(currentPidProfile);
+        setConfigDirty();
+    }
+
+    govAutotuneChangeState(GOV_AUTOTUNE_DONE);
+    eventLog(EVENT_GOV_AUTOTUNE, GOV_AUTOTUNE_DONE);
+}
+
+static void govAutotuneCheck(void)
+{
+    const bool request = ARMING_FLAG(ARMED) && IS_RC_MODE_ACTIVE(BOXGOVTUNE);
+
+    if (request && !tune.request) {
+        memset(&tune.result, 0, sizeof(tune.result));
+        tune.sign = 1;
+        tune.sumGain = 0;
+        tune.sumDelay = 0;
+        tune.sumTau = 0;
+        govAutotuneChangeState(GOV_AUTOTUNE_SETTLE);
+        eventLog(EVENT_GOV_AUTOTUNE, GOV_AUTOTUNE_SETTLE);
+    }
+    else if (govAutotuneRunning() && (!request || gov.state != GS_ACTIVE)) {
+        govAutotuneAbort();
+    }
+
+    tune.request = request;
+}
+
+// Called in the ACTIVE state with the closed loop throttle
+static float govAutotuneUpdate(float output)
+{
+    const float headSpeedError = fabsf(gov.targetHeadSpeed - gov.actualHeadSpeed) / gov.fullHeadSpeed;
+    const float requestChange = fabsf(gov.targetHeadSpeed - gov.requestedHeadSpeed) / gov.fullHeadSpeed;
+
+    switch (tune.result.state)
+    {
+        // Wait for a steady headspeed, and average the hover throttle
+        case GOV_AUTOTUNE_SETTLE:
+            if (headSpeedError > GOV_AUTOTUNE_STABLE_ERROR || requestChange > GOV_AUTOTUNE_STABLE_ERROR) {
+                tune.throttle = output;
+                tune.entryTime = millis();
+            }
+            else {
+                tune.throttle += (output - tune.throttle) * tune.averageGain;
+                if (govAutotuneTime() > GOV_AUTOTUNE_SETTLE_TIME) {
+                    tune.headSpeed = gov.fullHeadSpeedRatio;
+                    tune.requestedHeadSpeed = gov.requestedHeadSpeed;
+                    tune.voltageGain = (gov.mode == GM_MODE2) ? govVoltageGain() : 1.0f;
+                    govAutotuneChangeState(GOV_AUTOTUNE_BASELINE);
+                }
+            }
+            return output;
+
+        // Hold the hover throttle, and average the headspeed
+        case GOV_AUTOTUNE_BASELINE:
+            tune.headSpeed += (gov.fullHeadSpeedRatio - tune.headSpeed) * tune.averageGain;
+            if (govAutotuneTime() > GOV_AUTOTUNE_BASELINE_TIME) {
+                tune.sampleCount = 0;
+                govAutotuneChangeState(GOV_AUTOTUNE_STEP);
+            }
+            return tune.throttle;
+
+        // Throttle step, record the headspeed response
+        case GOV_AUTOTUNE_STEP:
+            {
+                const float response = (gov.fullHeadSpeedRatio - tune.headSpeed) * tune.sign;
+
+                if (fabsf(response) > GOV_AUTOTUNE_ABORT_ERROR ||
+                    fabsf(gov.requestedHeadSpeed - tune.requestedHeadSpeed) / gov.fullHeadSpeed > GOV_AUTOTUNE_STABLE_ERROR) {
+                    govAutotuneAbort();
+                    return output;
+                }
+
+                const long sample = govAutotuneTime() * GOV_AUTOTUNE_SAMPLES / GOV_AUTOTUNE_STEP_TIME;
+
+                while (tune.sampleCount <= sample && tune.sampleCount < GOV_AUTOTUNE_SAMPLES)
+                    tune.samples[tune.sampleCount++] = response;
+
+                const float stepThrottle = tune.throttle + tune.sign * GOV_AUTOTUNE_STEP_SIZE;
+
+                if (tune.sampleCount >= GOV_AUTOTUNE_SAMPLES) {
+                    if (!govAutotuneFit()) {
+                        govAutotuneAbort();
+                        return stepThrottle;
+                    }
+
+                    tune.result.steps++;
+                    tune.sign = -tune.sign;
+
+                    if (tune.result.steps >= GOV_AUTOTUNE_STEPS)
+                        govAutotuneFinish();
+                    else
+                        govAutotuneChangeState(GOV_AUTOTUNE_SETTLE);
+
+                    // Closed loop again from the step throttle
+                    govActiveInit();
+                }
+
+                return stepThrottle;
+            }
+    }
+
+    return output;
+}
+
+#endif
+
+
 static inline float govCalcRate(uint16_t param, uint16_t min, uint16_t max)
 {
     if (param)
@@ -991,6 +1447,12 @@ void governorUpdate(void)
         // Update internal state data
         govUpdateData();
 
+#ifdef USE_GOVERNOR_AUTOTUNE
+        // Start or abort the autotune
+        if (gov.mode >= GM_STANDARD)
+            govAutotuneCheck();
+#endif
+
         // Run state machine
         govStateUpdate();
     }
@@ -1116,6 +1578,7 @@ void governorInit(const pidProfile_t *pidProfile)
         gov.lostHeadspeedTimeout = governorConfig()->gov_lost_headspeed_timeout * 100;
 
         gov.maxIdleThrottle = constrain(governorConfig()->gov_handover_throttle, 10, 50) / 100.0f;
+        gov.idleThrottleGain = gov.maxIdleThrottle / (gov.maxIdleThrottle - GOV_THROTTLE_OFF_LIMIT);
 
         const float diff_cutoff = governorConfig()->gov_rpm_filter ?
             constrainf(governorConfig()->gov_rpm_filter, 1, 50) : 20;
@@ -1124,10 +1587,24 @@ void governorInit(const pidProfile_t *pidProfile)
 
         lowpassFilterInit(&gov.motorVoltageFilter, LPF_DAMPED, governorConfig()->gov_pwr_filter, gyro.targetRateHz, 0);
         lowpassFilterInit(&gov.motorCurrentFilter, LPF_DAMPED, governorConfig()->gov_pwr_filter, gyro.targetRateHz, 0);
+        lowpassFilterInit(&gov.loadCurrentFilter, LPF_PT1, GOV_LOAD_CURRENT_CUTOFF, gyro.targetRateHz, 0);
         lowpassFilterInit(&gov.motorRPMFilter, LPF_DAMPED, governorConfig()->gov_rpm_filter, gyro.targetRateHz, 0);
         lowpassFilterInit(&gov.TTAFilter, LPF_DAMPED, governorConfig()->gov_tta_filter, gyro.targetRateHz, 0);
         lowpassFilterInit(&gov.FFFilter, LPF_DAMPED, governorConfig()->gov_ff_filter, gyro.targetRateHz, 0);
 
+        // Group delay of the RPM filter at low frequencies: 1 / (Q * w0)
+        gov.latencyComp = governorConfig()->gov_latency_comp;
+
+        // Battery model & load observer
+        gov.sagComp = governorConfig()->gov_sag_comp;
+        gov.batteryModelGain = pt1FilterGain(1.0f / (M_2PIf * GOV_BATTERY_MODEL_TIME), gyro.targetRateHz);
+        gov.motorRPMFilterDelay = governorConfig()->gov_rpm_filter ?
+            1.0f / (DAMPED_Q * M_2PIf * DAMPED_C * governorConfig()->gov_rpm_filter) : 0;
+
+#ifdef USE_GOVERNOR_AUTOTUNE
+        tune.averageGain = pt1FilterGain(GOV_AUTOTUNE_AVERAGE_CUTOFF, gyro.targetRateHz);
+#endif
+
         governorInitProfile(pidProfile);
     }
 }
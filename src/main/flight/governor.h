@@ -43,6 +43,26 @@ typedef enum {
     GS_AUTOROTATION_BAILOUT,
 } govState_e;
 
+typedef enum {
+    GOV_AUTOTUNE_OFF = 0,
+    GOV_AUTOTUNE_SETTLE,
+    GOV_AUTOTUNE_BASELINE,
+    GOV_AUTOTUNE_STEP,
+    GOV_AUTOTUNE_DONE,
+    GOV_AUTOTUNE_ABORTED,
+} govAutotuneState_e;
+
+typedef struct {
+    uint8_t  state;         // govAutotuneState_e
+    uint8_t  steps;         // Throttle steps identified
+    float    gain;          // Headspeed ratio change per throttle change
+    float    delay;         // Dead time (s)
+    float    tau;           // Time constant (s)
+    uint8_t  p_gain;        // Proposed gov_p_gain
+    uint8_t  i_gain;        // Proposed gov_i_gain
+    uint8_t  d_gain;        // Proposed gov_d_gain
+} govAutotune_t;
+
 typedef struct governorConfig_s {
     uint8_t  gov_mode;
     uint16_t gov_startup_time;
@@ -59,6 +79,8 @@ typedef struct governorConfig_s {
     uint8_t  gov_rpm_filter;
     uint8_t  gov_tta_filter;
     uint8_t  gov_ff_filter;
+    uint8_t  gov_latency_comp;
+    uint8_t  gov_sag_comp;
 } governorConfig_t;
 
 PG_DECLARE(governorConfig_t, governorConfig);
@@ -80,3 +102,5 @@ float getTTAIncrease(void);
 
 bool isSpooledUp(void);
 
+const govAutotune_t *getGovernorAutotune(void);
+
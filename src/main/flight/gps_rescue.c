@@ -461,9 +461,23 @@ static void sensorUpdate()
     const uint32_t currentTimeUs = micros();
     const float dTime = currentTimeUs - previousTimeUs;
 
-    if (newGPSData) { // Calculate velocity at lowest common denominator
+    // Home vector from the predicted position, fresh on every update
+    if (positionNavValid()) {
+        const float north = getPositionNorth();
+        const float east = getPositionEast();
+        int16_t direction = lrintf(atan2_approx(-east, -north) / RAD);
+        if (direction < 0) {
+            direction += 360;
+        }
+        rescueState.sensor.distanceToHomeM = sqrtf(sq(north) + sq(east));
+        rescueState.sensor.directionToHome = direction;
+    }
+    else if (newGPSData) {
         rescueState.sensor.distanceToHomeM = GPS_distanceToHome;
         rescueState.sensor.directionToHome = GPS_directionToHome;
+    }
+
+    if (newGPSData) { // Calculate velocity at lowest common denominator
         rescueState.sensor.numSat = gpsSol.numSat;
         rescueState.sensor.groundSpeed = gpsSol.groundSpeed;
 
@@ -106,11 +106,12 @@ STATIC_UNIT_TESTED quaternionProducts qP = QUATERNION_PRODUCTS_INITIALIZE;
 // absolute angle inclination in multiple of 0.1 degree    180 deg = 1800
 attitudeEulerAngles_t attitude = EULER_INITIALIZE;
 
-PG_REGISTER_WITH_RESET_TEMPLATE(imuConfig_t, imuConfig, PG_IMU_CONFIG, 1);
+PG_REGISTER_WITH_RESET_TEMPLATE(imuConfig_t, imuConfig, PG_IMU_CONFIG, 2);
 
 PG_RESET_TEMPLATE(imuConfig_t, imuConfig,
     .dcm_kp = 2500,                // 1.0 * 10000
     .dcm_ki = 0,                   // 0.003 * 10000
+    .fast_update = false,
 );
 
 static void imuQuaternionComputeProducts(quaternion *quat, quaternionProducts *quatProd)
@@ -160,6 +161,7 @@ void imuConfigure(void)
 {
     imuRuntimeConfig.dcm_kp = imuConfig()->dcm_kp / 10000.0f;
     imuRuntimeConfig.dcm_ki = imuConfig()->dcm_ki / 10000.0f;
+    imuRuntimeConfig.fast_update = imuConfig()->fast_update;
 
     fc_acc = calculateAccZLowPassFilterRCTimeConstant(5.0f); // Set to fix value
 }
@@ -182,12 +184,26 @@ void imuInit(void)
 }
 
 #if defined(USE_ACC)
-static float invSqrt(float x)
+/*
+ * Rotate the attitude quaternion by the half-angle vector (hx,hy,hz) = ω·dt/2
+ * and renormalise. Straight-line code, no branches.
+ */
+static FAST_CODE void imuQuaternionIntegrate(float hx, float hy, float hz)
 {
-    return 1.0f / sqrtf(x);
+    const float qw = q.w + (-q.x * hx - q.y * hy - q.z * hz);
+    const float qx = q.x + (+q.w * hx + q.y * hz - q.z * hy);
+    const float qy = q.y + (+q.w * hy - q.x * hz + q.z * hx);
+    const float qz = q.z + (+q.w * hz + q.x * hy - q.y * hx);
+
+    const float recipNorm = invSqrt(sq(qw) + sq(qx) + sq(qy) + sq(qz));
+
+    q.w = qw * recipNorm;
+    q.x = qx * recipNorm;
+    q.y = qy * recipNorm;
+    q.z = qz * recipNorm;
 }
 
-static void imuMahonyAHRSupdate(float dt, float gx, float gy, float gz,
+static void imuMahonyAHRSupdate(float dt, bool useGyro, float gx, float gy, float gz,
                                 bool useAcc, float ax, float ay, float az,
                                 bool useMag,
                                 bool useCOG, float courseOverGround, const float dcmKpGain)
@@ -208,7 +224,10 @@ static void imuMahonyAHRSupdate(float dt, float gx, float gy, float gz,
             courseOverGround += (2.0f * M_PIf);
         }
 
-        const float ez_ef = (- sin_approx(courseOverGround) * rMat[0][0] - cos_approx(courseOverGround) * rMat[1][0]);
+        float sinCOG, cosCOG;
+        sincos_approx(courseOverGround, &sinCOG, &cosCOG);
+
+        const float ez_ef = (- sinCOG * rMat[0][0] - cosCOG * rMat[1][0]);
 
         ex = rMat[2][0] * ez_ef;
         ey = rMat[2][1] * ez_ef;
@@ -279,33 +298,18 @@ static void imuMahonyAHRSupdate(float dt, float gx, float gy, float gz,
         integralFBz = 0.0f;
     }
 
+    // Gyro already integrated at PID rate in fast update mode
+    if (!useGyro) {
+        gx = gy = gz = 0;
+    }
+
     // Apply proportional and integral feedback
     gx += dcmKpGain * ex + integralFBx;
     gy += dcmKpGain * ey + integralFBy;
     gz += dcmKpGain * ez + integralFBz;
 
     // Integrate rate of change of quaternion
-    gx *= (0.5f * dt);
-    gy *= (0.5f * dt);
-    gz *= (0.5f * dt);
-
-    quaternion buffer;
-    buffer.w = q.w;
-    buffer.x = q.x;
-    buffer.y = q.y;
-    buffer.z = q.z;
-
-    q.w += (-buffer.x * gx - buffer.y * gy - buffer.z * gz);
-    q.x += (+buffer.w * gx + buffer.y * gz - buffer.z * gy);
-    q.y += (+buffer.w * gy - buffer.x * gz + buffer.z * gx);
-    q.z += (+buffer.w * gz + buffer.x * gy - buffer.y * gx);
-
-    // Normalise quaternion
-    float recipNorm = invSqrt(sq(q.w) + sq(q.x) + sq(q.y) + sq(q.z));
-    q.w *= recipNorm;
-    q.x *= recipNorm;
-    q.y *= recipNorm;
-    q.z *= recipNorm;
+    imuQuaternionIntegrate(gx * (0.5f * dt), gy * (0.5f * dt), gz * (0.5f * dt));
 
     // Pre-compute rotation matrix from quaternion
     imuComputeRotationMatrix();
@@ -418,14 +422,14 @@ static void imuComputeQuaternionFromRPY(quaternionProducts *quatProd, int16_t in
         initialYaw -= 3600;
     }
 
-    const float cosRoll = cos_approx(DECIDEGREES_TO_RADIANS(initialRoll) * 0.5f);
-    const float sinRoll = sin_approx(DECIDEGREES_TO_RADIANS(initialRoll) * 0.5f);
+    float cosRoll, sinRoll;
+    sincos_approx(DECIDEGREES_TO_RADIANS(initialRoll) * 0.5f, &sinRoll, &cosRoll);
 
-    const float cosPitch = cos_approx(DECIDEGREES_TO_RADIANS(initialPitch) * 0.5f);
-    const float sinPitch = sin_approx(DECIDEGREES_TO_RADIANS(initialPitch) * 0.5f);
+    float cosPitch, sinPitch;
+    sincos_approx(DECIDEGREES_TO_RADIANS(initialPitch) * 0.5f, &sinPitch, &cosPitch);
 
-    const float cosYaw = cos_approx(DECIDEGREES_TO_RADIANS(-initialYaw) * 0.5f);
-    const float sinYaw = sin_approx(DECIDEGREES_TO_RADIANS(-initialYaw) * 0.5f);
+    float cosYaw, sinYaw;
+    sincos_approx(DECIDEGREES_TO_RADIANS(-initialYaw) * 0.5f, &sinYaw, &cosYaw);
 
     const float q0 = cosRoll * cosPitch * cosYaw + sinRoll * sinPitch * sinYaw;
     const float q1 = sinRoll * cosPitch * cosYaw - cosRoll * sinPitch * sinYaw;
@@ -506,7 +510,7 @@ static void imuCalculateEstimatedAttitude(timeUs_t currentTimeUs)
         useAcc = imuIsAccelerometerHealthy(accAverage);
     }
 
-    imuMahonyAHRSupdate(deltaT * 1e-6f,
+    imuMahonyAHRSupdate(deltaT * 1e-6f, !imuRuntimeConfig.fast_update,
                         DEGREES_TO_RADIANS(gyro.gyroADCf[X]),
                         DEGREES_TO_RADIANS(gyro.gyroADCf[Y]),
                         DEGREES_TO_RADIANS(gyro.gyroADCf[Z]),
@@ -539,6 +543,53 @@ void imuUpdateAttitude(timeUs_t currentTimeUs)
         schedulerIgnoreTaskStateTime();
     }
 }
+
+/*
+ * Gyro-only attitude propagation, called from the PID loop when
+ * imu_fast_update is enabled. The accelerometer/GPS/mag correction
+ * then runs in TASK_ATTITUDE at IMU_CORRECTION_RATE_HZ.
+ */
+void FAST_CODE imuUpdateGyroAttitude(float dT)
+{
+    if (imuRuntimeConfig.fast_update && attitudeIsEstablished) {
+        IMU_LOCK;
+        const float scale = DEGREES_TO_RADIANS(0.5f * dT);
+        imuQuaternionIntegrate(gyro.gyroADCf[X] * scale,
+                               gyro.gyroADCf[Y] * scale,
+                               gyro.gyroADCf[Z] * scale);
+        imuComputeRotationMatrix();
+        IMU_UNLOCK;
+    }
+}
+
+/*
+ * Roll and pitch tilt in degrees, taken as the axis-angle rotation between
+ * the body Z axis and the earth vertical, straight from the rotation matrix.
+ * Unlike the Euler angles this has no singularity at ±90° pitch, and it is
+ * current at PID rate in fast update mode. With inverted set, the tilt is
+ * relative to the upside down attitude, with the same signs as the inverted
+ * Euler angles (roll - 180°, -pitch).
+ */
+void FAST_CODE imuGetTiltAngles(bool inverted, float *roll, float *pitch)
+{
+    const float vx = rMat[2][0];
+    const float vy = inverted ? -rMat[2][1] : rMat[2][1];
+    const float vz = inverted ? -rMat[2][2] : rMat[2][2];
+
+    const float sine = sqrtf(sq(vx) + sq(vy));
+    const float angle = atan2_approx(sine, vz);
+
+    if (sine > 1e-6f) {
+        const float scale = angle * (180.0f / M_PIf) / sine;
+        *roll = vy * scale;
+        *pitch = (inverted ? vx : -vx) * scale;
+    }
+    else {
+        // Level, or exactly on the opposite pole - flip on roll
+        *roll = (vz < 0) ? 180 : 0;
+        *pitch = 0;
+    }
+}
 #endif // USE_ACC
 
 bool shouldInitializeGPSHeading()
@@ -56,6 +56,7 @@ extern float rMat[3][3];
 typedef struct imuConfig_s {
     uint16_t dcm_kp;                        // DCM filter proportional gain ( x 10000)
     uint16_t dcm_ki;                        // DCM filter integral gain ( x 10000)
+    uint8_t  fast_update;                   // Integrate gyro at PID rate, correct at IMU_CORRECTION_RATE_HZ
 } imuConfig_t;
 
 PG_DECLARE(imuConfig_t, imuConfig);
@@ -63,13 +64,18 @@ PG_DECLARE(imuConfig_t, imuConfig);
 typedef struct imuRuntimeConfig_s {
     float dcm_ki;
     float dcm_kp;
+    bool  fast_update;
 } imuRuntimeConfig_t;
 
+#define IMU_CORRECTION_RATE_HZ  100
+
 void imuConfigure(void);
 
 float getCosTiltAngle(void);
 void getQuaternion(quaternion * q);
 void imuUpdateAttitude(timeUs_t currentTimeUs);
+void imuUpdateGyroAttitude(float dT);
+void imuGetTiltAngles(bool inverted, float *roll, float *pitch);
 
 void imuInit(void);
 
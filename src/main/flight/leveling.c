@@ -100,18 +100,17 @@ static float calcLevelErrorAngle(int axis)
 #endif
     angle = constrainf(angle, -level.AngleLimit, level.AngleLimit);
 
-    float currentAngle = ((attitude.raw[axis] - angleTrim->raw[axis]) / 10.0f);
-
-    if (isUpsidedown() && FLIGHT_MODE(HORIZON_MODE)) {
-        switch (axis) {
-            case FD_PITCH:
-                currentAngle = -currentAngle;
-                break;
-            case FD_ROLL:
-                currentAngle -= SIGN(currentAngle) * 180;
-                break;
-        }
-    }
+    const bool inverted = isUpsidedown() && FLIGHT_MODE(HORIZON_MODE);
+    float tilt[2];
+
+    imuGetTiltAngles(inverted, &tilt[FD_ROLL], &tilt[FD_PITCH]);
+
+    // Pitch trim is mirrored when upside down
+    float currentAngle = tilt[axis];
+    if (inverted && axis == FD_PITCH)
+        currentAngle += angleTrim->raw[axis] / 10.0f;
+    else
+        currentAngle -= angleTrim->raw[axis] / 10.0f;
 
     float error = angle - currentAngle;
 
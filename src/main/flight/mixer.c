@@ -113,24 +113,67 @@ typedef struct {
     float           totalPitchLimit;
     float           cyclicRingLimit;
     float           cyclicSpeedLimit;
+    float           cyclicRingScale;
 
     float           cyclicPhaseSin;
     float           cyclicPhaseCos;
 
     uint32_t        cyclicMapping;
 
+    uint8_t         rcInputCount;
+    uint8_t         rcInput[MIXER_INPUT_COUNT];
+
 } mixerData_t;
 
 static FAST_DATA_ZERO_INIT mixerData_t mixer;
 
 
+/*
+ * Compiled mixer
+ *
+ * The swash mixer and the mixer rules are linear in the inputs, unless
+ * a MUL rule is present. They are compiled into an affine map over the
+ * inputs actually used, including the input rates, trims and SET/ADD
+ * ordering. The runtime cost becomes a fixed multiply-accumulate pass.
+ */
+
+// Number of distinct inputs in the compiled mixer
+#define MIXER_MATRIX_COLUMNS    12
+
+// Pseudo input: collective with geometry correction, as used by the swash mixer
+#define MIXER_MATRIX_SWASH_COLL MIXER_INPUT_COUNT
+
+typedef struct {
+
+    bool            active;
+
+    uint8_t         columnCount;
+    uint8_t         column[MIXER_MATRIX_COLUMNS];
+
+    float           offset[MIXER_OUTPUT_COUNT];
+    float           weight[MIXER_OUTPUT_COUNT][MIXER_MATRIX_COLUMNS];
+
+} mixerMatrix_t;
+
+static FAST_DATA_ZERO_INIT mixerMatrix_t matrix;
+
+
 #ifdef USE_MIXER_HISTORY
 
-// History lengh is 1024 samples (must be power of 2)
+// History length in samples (must be power of 2). Targets may set a shorter history.
+#ifndef MIXER_HISTORY_TIME
 #define MIXER_HISTORY_TIME   (1<<10)
+#endif
 #define MIXER_HISTORY_MASK   (MIXER_HISTORY_TIME-1)
 
+STATIC_ASSERT((MIXER_HISTORY_TIME & MIXER_HISTORY_MASK) == 0, mixer_history_time_not_power_of_two);
+
+// Histories up to 4kB are kept in fast RAM
+#if (MIXER_HISTORY_TIME <= 256)
+static FAST_DATA_ZERO_INIT float mixerInputHistory[4][MIXER_HISTORY_TIME];
+#else
 static float mixerInputHistory[4][MIXER_HISTORY_TIME];
+#endif
 
 static FAST_DATA_ZERO_INIT uint16_t historyIndex;
 
@@ -139,6 +182,31 @@ float mixerGetInputHistory(uint8_t i, uint16_t delay)
     return mixerInputHistory[i][(historyIndex - delay) & MIXER_HISTORY_MASK];
 }
 
+/*
+ * History value with a fractional delay in samples,
+ * linearly interpolated from the two nearest samples.
+ */
+float mixerGetInputHistoryf(uint8_t i, float delay)
+{
+    delay = constrainf(delay, 0, MIXER_HISTORY_TIME - 2);
+
+    const int n = delay;
+    const float frac = delay - n;
+
+    const float a = mixerInputHistory[i][(historyIndex - n) & MIXER_HISTORY_MASK];
+    const float b = mixerInputHistory[i][(historyIndex - n - 1) & MIXER_HISTORY_MASK];
+
+    return a + (b - a) * frac;
+}
+
+/*
+ * History value with a delay in seconds, independent of the loop rate.
+ */
+float mixerGetInputDelayed(uint8_t i, float delay)
+{
+    return mixerGetInputHistoryf(i, delay * pidGetPidFrequency());
+}
+
 static inline void mixerUpdateHistory(void)
 {
     historyIndex = (historyIndex + 1) & MIXER_HISTORY_MASK;
@@ -244,42 +312,40 @@ static void mixerUpdateCyclic(void)
     float SR = mixer.input[MIXER_IN_STABILIZED_ROLL];
     float SP = mixer.input[MIXER_IN_STABILIZED_PITCH];
 
+    // Squared cyclic deflection
+    const float cyclic2 = sq(SR) + sq(SP);
+
+    // Cyclic limit factor
+    float factor = 1.0f;
+
     // Limit action active
     if (mixer.cyclicRingLimit > 0 || mixer.totalPitchLimit > 0)
     {
-        float factor = 1.0f;
-
         // Apply cyclic ring limit
-        if (mixer.cyclicRingLimit > 0 ) {
+        if (mixer.cyclicRingLimit > 0) {
             // Inidividual limits on SP and SR
             const mixerInput_t *mixR = mixerInputs(MIXER_IN_STABILIZED_ROLL);
             const mixerInput_t *mixP = mixerInputs(MIXER_IN_STABILIZED_PITCH);
 
             // Assume min<0 and max>0
-            const float maxR = MAX(abs((SR < 0) ? mixR->min : mixR->max), 10) / 1000.0f;
-            const float maxP = MAX(abs((SP < 0) ? mixP->min : mixP->max), 10) / 1000.0f;
+            const float maxR = MAX(abs((SR < 0) ? mixR->min : mixR->max), 10);
+            const float maxP = MAX(abs((SP < 0) ? mixP->min : mixP->max), 10);
 
-            // Stretch the values to a unit circle limit
-            const float SSR = SR / (maxR * mixer.cyclicRingLimit);
-            const float SSP = SP / (maxP * mixer.cyclicRingLimit);
-
-            // Stretched cyclic deflection
-            const float cyclic = sqrtf(sq(SSR) + sq(SSP));
+            // Ellipse (SR/maxR)² + (SP/maxP)² = ring² without the divisions
+            const float ellipse2 = sq(SR * maxP) + sq(SP * maxR);
+            const float ring = maxR * maxP * mixer.cyclicRingScale;
 
             // Cyclic limits reached - scale back
-            if (cyclic > 1.0f) {
-                factor = 1.0f / cyclic;
+            if (ellipse2 > sq(ring)) {
+                factor = ring * invSqrt(ellipse2);
             }
         }
 
         // Apply dynamic cyclic limit
         if (mixer.totalPitchLimit > 0) {
             // Total cyclic after ring limit
-            const float cyclic = sqrtf(sq(SR) + sq(SP)) * factor;
-
-            // Cyclic limits reached - scale back
-            if (cyclic > mixer.cyclicLimit) {
-                factor *= mixer.cyclicLimit / cyclic;
+            if (cyclic2 * sq(factor) > sq(mixer.cyclicLimit)) {
+                factor = mixer.cyclicLimit * invSqrt(cyclic2);
             }
         }
 
@@ -292,7 +358,11 @@ static void mixerUpdateCyclic(void)
         }
     }
 
-    // Swash phasing
+    // Swash phasing, with sin/cos precomputed in mixerInitConfig().
+    // It must come after the ring limit, which is elliptic and not rotation
+    // invariant, so it can't be merged with the roll/pitch transforms in the
+    // PID controller. The rotated values are also what blackbox and the
+    // pitch precomp see.
     if (mixer.cyclicPhaseSin != 0)
     {
         const float P = SP;
@@ -305,8 +375,8 @@ static void mixerUpdateCyclic(void)
     mixer.input[MIXER_IN_STABILIZED_ROLL]  = SR;
     mixer.input[MIXER_IN_STABILIZED_PITCH] = SP;
 
-    // Total cyclic deflection
-    mixer.cyclicTotal = sqrtf(sq(SP) + sq(SR));
+    // Total cyclic deflection (phasing keeps the length)
+    mixer.cyclicTotal = sqrtf(cyclic2) * factor;
 }
 
 static void mixerUpdateCollective(void)
@@ -481,20 +551,192 @@ static void mixerUpdateRules(void)
     }
 }
 
-static void mixerUpdateInputs(void)
+static void mixerUpdateMatrix(void)
+{
+    float value[MIXER_MATRIX_COLUMNS];
+
+    for (int j = 0; j < matrix.columnCount; j++) {
+        const int in = matrix.column[j];
+        if (in == MIXER_MATRIX_SWASH_COLL)
+            value[j] = mixerCollectiveCorrection(inputValue(COLLECTIVE));
+        else
+            value[j] = mixer.input[in];
+    }
+
+    for (int i = 0; i < MIXER_OUTPUT_COUNT; i++) {
+        const float *weight = matrix.weight[i];
+        float out = matrix.offset[i];
+
+        for (int j = 0; j < matrix.columnCount; j++)
+            out += weight[j] * value[j];
+
+        mixer.output[i] = out;
+    }
+}
+
+static int INIT_CODE mixerMatrixColumn(int in)
+{
+    for (int j = 0; j < matrix.columnCount; j++) {
+        if (matrix.column[j] == in)
+            return j;
+    }
+
+    if (matrix.columnCount >= MIXER_MATRIX_COLUMNS) {
+        matrix.active = false;
+        return 0;
+    }
+
+    matrix.column[matrix.columnCount] = in;
+
+    return matrix.columnCount++;
+}
+
+static void INIT_CODE mixerMatrixAdd(int out, int in, float weight)
 {
-    // Flight Dynamics
-    mixerSetInput(MIXER_IN_RC_COMMAND_ROLL, getRcDeflection(ROLL));
-    mixerSetInput(MIXER_IN_RC_COMMAND_PITCH, getRcDeflection(PITCH));
-    mixerSetInput(MIXER_IN_RC_COMMAND_YAW, getRcDeflection(YAW));
-    mixerSetInput(MIXER_IN_RC_COMMAND_COLLECTIVE, getRcDeflection(COLLECTIVE));
+    const int j = mixerMatrixColumn(in);
+
+    // Input rates are applied to the real inputs only
+    if (in != MIXER_MATRIX_SWASH_COLL)
+        weight *= mixerInputs(in)->rate / 1000.0f;
+
+    matrix.weight[out][j] += weight;
+}
+
+static void INIT_CODE mixerMatrixAddSwash(int servo, float R, float P, float C)
+{
+    const int out = MIXER_SERVO_OFFSET + servo;
+
+    if (R != 0)
+        mixerMatrixAdd(out, MIXER_IN_STABILIZED_ROLL, R);
+    if (P != 0)
+        mixerMatrixAdd(out, MIXER_IN_STABILIZED_PITCH, P);
+    if (C != 0)
+        mixerMatrixAdd(out, MIXER_MATRIX_SWASH_COLL, C);
+
+    matrix.offset[out] += R * mixer.swashTrim[0] + P * mixer.swashTrim[1] + C * mixer.swashTrim[2];
+}
+
+static void INIT_CODE mixerCompileMatrix(void)
+{
+    memset(&matrix, 0, sizeof(matrix));
+
+    matrix.active = true;
 
-    // Throttle input
+    if (mixerConfig()->swash_type)
+    {
+        switch (mixerConfig()->swash_type) {
+            case SWASH_TYPE_120:
+                mixerMatrixAddSwash(0,  0,           -1,          0.5f);
+                mixerMatrixAddSwash(1,  0.86602540f,  0.5f,       0.5f);
+                mixerMatrixAddSwash(2, -0.86602540f,  0.5f,       0.5f);
+                break;
+
+            case SWASH_TYPE_135:
+                mixerMatrixAddSwash(0,  0,           -1,          0.5f);
+                mixerMatrixAddSwash(1,  0.70710678f,  0.70710678f, 0.5f);
+                mixerMatrixAddSwash(2, -0.70710678f,  0.70710678f, 0.5f);
+                break;
+
+            case SWASH_TYPE_140:
+                mixerMatrixAddSwash(0,  0,           -1,          0.5f);
+                mixerMatrixAddSwash(1,  0.64278760f,  0.76604444f, 0.5f);
+                mixerMatrixAddSwash(2, -0.64278760f,  0.76604444f, 0.5f);
+                break;
+
+            case SWASH_TYPE_90L:
+                mixerMatrixAddSwash(0,  0,            1,          0);
+                mixerMatrixAddSwash(1,  1,            0,          0);
+                break;
+
+            case SWASH_TYPE_90V:
+                mixerMatrixAddSwash(0,  0.70710678f,  0.70710678f, 0);
+                mixerMatrixAddSwash(1, -0.70710678f,  0.70710678f, 0);
+                break;
+
+            case SWASH_TYPE_THRU:
+                mixerMatrixAddSwash(0,  0,            1,          0);
+                mixerMatrixAddSwash(1,  1,            0,          0);
+                mixerMatrixAddSwash(2,  0,            0,          1);
+                break;
+        }
+
+        mixerMatrixAdd(MIXER_MOTOR_OFFSET, MIXER_IN_STABILIZED_THROTTLE, 1);
+
+        if (mixerMotorizedTail()) {
+            mixerMatrixAdd(MIXER_MOTOR_OFFSET + 1, MIXER_IN_STABILIZED_YAW, 1);
+        }
+        else {
+            mixerMatrixAdd(MIXER_SERVO_OFFSET + 3, MIXER_IN_STABILIZED_YAW, 1);
+            matrix.offset[MIXER_SERVO_OFFSET + 3] += mixer.tailCenterTrim;
+        }
+    }
+
+    for (int i = 0; i < MIXER_RULE_COUNT && matrix.active; i++) {
+        const mixerRule_t *rule = mixerRules(i);
+        const int out = rule->output;
+
+        switch (rule->oper)
+        {
+            case MIXER_OP_SET:
+                matrix.offset[out] = 0;
+                for (int j = 0; j < MIXER_MATRIX_COLUMNS; j++)
+                    matrix.weight[out][j] = 0;
+                FALLTHROUGH;
+            case MIXER_OP_ADD:
+                matrix.offset[out] += rule->offset / 1000.0f;
+                mixerMatrixAdd(out, rule->input, rule->weight / 1000.0f);
+                break;
+            case MIXER_OP_MUL:
+                // Not linear - use the rule interpreter
+                matrix.active = false;
+                break;
+        }
+    }
+}
+
+/*
+ * The RC inputs are only read by the mixer rules. Only the ones
+ * referenced by an active rule are fetched each loop.
+ */
+static void INIT_CODE mixerCompileInputs(void)
+{
+    uint32_t used = 0;
+
+    for (int i = 0; i < MIXER_RULE_COUNT; i++) {
+        const mixerRule_t *rule = mixerRules(i);
+        if (rule->oper && rule->input >= MIXER_IN_RC_COMMAND_ROLL &&
+            rule->input != MIXER_IN_RC_COMMAND_THROTTLE && rule->input < MIXER_INPUT_COUNT) {
+            used |= BIT(rule->input);
+        }
+    }
+
+    mixer.rcInputCount = 0;
+
+    for (int i = MIXER_IN_RC_COMMAND_ROLL; i < MIXER_INPUT_COUNT; i++) {
+        if (used & BIT(i)) {
+            mixer.rcInput[mixer.rcInputCount++] = i;
+        }
+    }
+}
+
+static inline float mixerGetRcInput(int index)
+{
+    if (index >= MIXER_IN_RC_CHANNEL_ROLL)
+        return rcCommand[index - MIXER_IN_RC_CHANNEL_ROLL] / 500;
+
+    return getRcDeflection(index - MIXER_IN_RC_COMMAND_ROLL);
+}
+
+static void mixerUpdateInputs(void)
+{
+    // Throttle input, always needed by mixerGetThrottle()
     mixerSetInput(MIXER_IN_RC_COMMAND_THROTTLE, getThrottle());
 
-    // RC channels
-    for (int i = 0; i < MAX_SUPPORTED_RC_CHANNEL_COUNT; i++)
-        mixerSetInput(MIXER_IN_RC_CHANNEL_ROLL + i, rcCommand[i] / 500);
+    // Flight Dynamics and RC channels used by the rules
+    for (int i = 0; i < mixer.rcInputCount; i++) {
+        const int index = mixer.rcInput[i];
+        mixerSetInput(index, mixerGetRcInput(index));
+    }
 
     // Stabilised inputs
     mixerSetInput(MIXER_IN_STABILIZED_ROLL, pidGetOutput(PID_ROLL));
@@ -539,11 +781,17 @@ void mixerUpdate(void)
     // Fetch input values
     mixerUpdateInputs();
 
-    // Evaluate hard-coded mixer
-    mixerUpdateSwash();
+    if (matrix.active) {
+        // Evaluate compiled mixer
+        mixerUpdateMatrix();
+    }
+    else {
+        // Evaluate hard-coded mixer
+        mixerUpdateSwash();
 
-    // Evaluate rule-based mixer
-    mixerUpdateRules();
+        // Evaluate rule-based mixer
+        mixerUpdateRules();
+    }
 }
 
 void INIT_CODE validateAndFixMixerConfig(void)
@@ -589,10 +837,12 @@ void INIT_CODE mixerInitConfig(void)
     else
         mixer.cyclicRingLimit = 0;
 
+    // Ring limit in the units of the input limits
+    mixer.cyclicRingScale = mixer.cyclicRingLimit / 1000.0f;
+
     if (mixerConfig()->swash_phase) {
         const float angle = DECIDEGREES_TO_RADIANS(mixerConfig()->swash_phase);
-        mixer.cyclicPhaseSin = sin_approx(angle);
-        mixer.cyclicPhaseCos = cos_approx(angle);
+        sincos_approx(angle, &mixer.cyclicPhaseSin, &mixer.cyclicPhaseCos);
     }
     else {
         mixer.cyclicPhaseSin = 0;
@@ -607,6 +857,9 @@ void INIT_CODE mixerInitConfig(void)
 
     mixer.tailMotorIdle = mixerConfig()->tail_motor_idle / 1000.0f;
     mixer.tailCenterTrim = mixerConfig()->tail_center_trim / 1000.0f;
+
+    mixerCompileInputs();
+    mixerCompileMatrix();
 }
 
 static void INIT_CODE setMapping(uint8_t in, uint8_t out)
@@ -174,6 +174,8 @@ void mixerUpdate(void);
 
 float mixerGetInput(uint8_t index);
 float mixerGetInputHistory(uint8_t index, uint16_t delay);
+float mixerGetInputHistoryf(uint8_t index, float delay);
+float mixerGetInputDelayed(uint8_t index, float delay);
 
 float mixerGetOutput(uint8_t index);
 
@@ -61,8 +61,31 @@ typedef enum {
     RPM_SRC_DSHOT_TELEM,
     RPM_SRC_FREQ_SENSOR,
     RPM_SRC_ESC_SENSOR,
+    RPM_SRC_SIMULATOR,
 } rpmSource_e;
 
+// Hold time after which an unchanged RPM value is taken as a new measurement
+#define RPM_TRACKER_HOLD_US     20000
+
+// Outlier rejection window, in measurements
+#define RPM_GLITCH_WINDOW       5
+
+typedef struct {
+    float           rpm;        // Estimated RPM at the last update
+    float           rate;       // Estimated RPM change rate [RPM/s]
+    float           meas;       // Last measurement
+    timeUs_t        measUs;     // Arrival time of the last measurement
+    timeUs_t        updateUs;   // Time of the last update
+} rpmTracker_t;
+
+typedef struct {
+    float           window[RPM_GLITCH_WINDOW];  // Latest measurements
+    float           meas;       // Last measurement
+    float           output;     // Last accepted value
+    uint8_t         index;
+    uint8_t         count;
+} rpmGlitchFilter_t;
+
 
 static FAST_DATA_ZERO_INIT uint8_t        motorCount;
 
@@ -74,6 +97,14 @@ static FAST_DATA_ZERO_INIT float          motorRpmRaw[MAX_SUPPORTED_MOTORS];
 static FAST_DATA_ZERO_INIT uint8_t        motorRpmDiv[MAX_SUPPORTED_MOTORS];
 static FAST_DATA_ZERO_INIT uint8_t        motorRpmSource[MAX_SUPPORTED_MOTORS];
 static FAST_DATA_ZERO_INIT filter_t       motorRpmFilter[MAX_SUPPORTED_MOTORS];
+static FAST_DATA_ZERO_INIT rpmTracker_t   motorRpmTracker[MAX_SUPPORTED_MOTORS];
+static FAST_DATA_ZERO_INIT float          motorRpmTracked[MAX_SUPPORTED_MOTORS];
+static FAST_DATA_ZERO_INIT rpmGlitchFilter_t motorRpmGlitch[MAX_SUPPORTED_MOTORS];
+
+static FAST_DATA_ZERO_INIT float          rpmGlitchLimit;
+
+static FAST_DATA_ZERO_INIT float          rpmTrackerAlpha;
+static FAST_DATA_ZERO_INIT float          rpmTrackerBeta;
 
 static FAST_DATA_ZERO_INIT float          headSpeed;
 static FAST_DATA_ZERO_INIT float          tailSpeed;
@@ -152,6 +183,16 @@ float getMotorRawRPMf(uint8_t motor)
     return motorRpmRaw[motor];
 }
 
+float getMotorTrackedRPMf(uint8_t motor)
+{
+    return motorRpmTracked[motor];
+}
+
+float getMotorRPMRatef(uint8_t motor)
+{
+    return motorRpmTracker[motor].rate;
+}
+
 int calcMotorRPM(uint8_t motor, int erpm)
 {
     return erpm / motorRpmDiv[motor];
@@ -165,7 +206,9 @@ bool isMotorRpmSourceActive(uint8_t motor)
 
 bool isMotorFastRpmSourceActive(uint8_t motor)
 {
-    return (motor < motorCount && (motorRpmSource[motor] == RPM_SRC_DSHOT_TELEM || motorRpmSource[motor] == RPM_SRC_FREQ_SENSOR));
+    return (motor < motorCount && (motorRpmSource[motor] == RPM_SRC_DSHOT_TELEM ||
+                                   motorRpmSource[motor] == RPM_SRC_FREQ_SENSOR ||
+                                   motorRpmSource[motor] == RPM_SRC_SIMULATOR));
 }
 
 bool isRpmSourceActive(void)
@@ -190,7 +233,18 @@ bool areMotorsRunning(void)
 
 INIT_CODE void rpmSourceInit(void)
 {
+    // Critically damped alpha-beta gains
+    rpmTrackerAlpha = motorConfig()->motorRpmTracker / 100.0f;
+    rpmTrackerBeta = sq(rpmTrackerAlpha) / (2 - rpmTrackerAlpha);
+
+    rpmGlitchLimit = motorConfig()->motorRpmGlitchLimit / 100.0f;
+
     for (int i = 0; i < MAX_SUPPORTED_MOTORS; i++) {
+#ifdef SIMULATOR_BUILD
+        if (simulatorHasMotorRpm(i))
+            motorRpmSource[i] = RPM_SRC_SIMULATOR;
+        else
+#endif
 #ifdef USE_FREQ_SENSOR
         if (featureIsEnabled(FEATURE_FREQ_SENSOR) && isFreqSensorPortInitialized(i))
             motorRpmSource[i] = RPM_SRC_FREQ_SENSOR;
@@ -243,6 +297,11 @@ static float getSensorRPMf(uint8_t motor)
 {
     float erpm;
 
+#ifdef SIMULATOR_BUILD
+    if (motorRpmSource[motor] == RPM_SRC_SIMULATOR)
+        erpm = simulatorGetMotorERPM(motor);
+    else
+#endif
 #ifdef USE_FREQ_SENSOR
     if (motorRpmSource[motor] == RPM_SRC_FREQ_SENSOR)
         erpm = getFreqSensorFreq(motor) * 60;
@@ -263,6 +322,98 @@ static float getSensorRPMf(uint8_t motor)
     return motorRpmFactor[motor] * erpm / motorRpmDiv[motor];
 }
 
+/*
+ * Outlier rejection for the motor RPM
+ *
+ * A Hampel filter over the last RPM_GLITCH_WINDOW measurements. A new
+ * measurement further than the limit from the window median is taken
+ * as a glitch (e.g. a bidir DShot frame with a bit error that passed
+ * the CRC) and replaced by the median. Good values pass unchanged, so
+ * there is no added lag. Only new arrivals are checked; a repeated
+ * value of a slow source keeps the last accepted value.
+ */
+static float rpmGlitchFilterApply(rpmGlitchFilter_t *flt, float meas)
+{
+    if (meas == flt->meas)
+        return flt->output;
+
+    flt->meas = meas;
+
+    // Motor stopped or no signal
+    if (meas <= 0) {
+        flt->count = 0;
+        flt->output = meas;
+        return meas;
+    }
+
+    flt->window[flt->index] = meas;
+    flt->index = (flt->index + 1) % RPM_GLITCH_WINDOW;
+
+    if (flt->count < RPM_GLITCH_WINDOW) {
+        flt->count++;
+        flt->output = meas;
+    }
+    else {
+        const float median = quickMedianFilter5f(flt->window);
+
+        if (fabsf(meas - median) > rpmGlitchLimit * median)
+            flt->output = median;
+        else
+            flt->output = meas;
+    }
+
+    return flt->output;
+}
+
+/*
+ * Alpha-beta tracker for the motor RPM
+ *
+ * The RPM sources deliver new values at their own rate, from every
+ * DShot frame down to a few times per second with the ESC sensor.
+ * New values are timestamped on arrival, and the estimate is
+ * extrapolated with the tracked rate of change in between. This gives
+ * a continuous RPM signal at the loop rate, without the staircase
+ * of the slow sources, and without the lag of a stronger lowpass.
+ */
+static void rpmTrackerUpdate(rpmTracker_t *trk, float meas, timeUs_t currentUs)
+{
+    const float dT = cmpTimeUs(currentUs, trk->updateUs) * 1e-6f;
+    const timeDelta_t measDelta = cmpTimeUs(currentUs, trk->measUs);
+
+    trk->updateUs = currentUs;
+
+    // Motor stopped or no signal
+    if (meas <= 0) {
+        trk->rpm = 0;
+        trk->rate = 0;
+        trk->meas = 0;
+        trk->measUs = currentUs;
+        return;
+    }
+
+    // Prediction step
+    trk->rpm += trk->rate * dT;
+
+    // Correction step, when a new value has arrived
+    if (meas != trk->meas || measDelta > RPM_TRACKER_HOLD_US) {
+        const float residual = meas - trk->rpm;
+
+        if (trk->meas > 0 && measDelta > 0) {
+            trk->rpm += rpmTrackerAlpha * residual;
+            trk->rate += rpmTrackerBeta * residual / (measDelta * 1e-6f);
+        }
+        else {
+            trk->rpm = meas;
+            trk->rate = 0;
+        }
+
+        trk->meas = meas;
+        trk->measUs = currentUs;
+    }
+
+    trk->rpm = fmaxf(trk->rpm, 0);
+}
+
 void motorUpdate(void)
 {
     float output;
@@ -278,9 +429,22 @@ void motorUpdate(void)
 
     motorWriteAll(motorOutput);
 
+    const timeUs_t currentUs = micros();
+
     for (int i = 0; i < motorCount; i++) {
         motorRpmRaw[i] = getSensorRPMf(i);
-        motorRpm[i] = fmaxf(filterApply(&motorRpmFilter[i], motorRpmRaw[i]), 0);
+
+        const float rpm = (rpmGlitchLimit > 0) ?
+            rpmGlitchFilterApply(&motorRpmGlitch[i], motorRpmRaw[i]) : motorRpmRaw[i];
+
+        if (rpmTrackerAlpha > 0) {
+            rpmTrackerUpdate(&motorRpmTracker[i], rpm, currentUs);
+            motorRpmTracked[i] = motorRpmTracker[i].rpm;
+        }
+        else {
+            motorRpmTracked[i] = rpm;
+        }
+        motorRpm[i] = fmaxf(filterApply(&motorRpmFilter[i], motorRpmTracked[i]), 0);
         DEBUG(RPM_SOURCE, i, motorRpmRaw[i]);
     }
 
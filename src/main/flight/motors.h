@@ -50,6 +50,8 @@ int getMotorRPM(uint8_t motor);
 float getMotorRPMf(uint8_t motor);
 
 float getMotorRawRPMf(uint8_t motor);
+float getMotorTrackedRPMf(uint8_t motor);
+float getMotorRPMRatef(uint8_t motor);
 
 int calcMotorRPM(uint8_t motor, int erpm);
 
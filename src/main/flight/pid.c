@@ -61,6 +61,11 @@
 
 static FAST_DATA_ZERO_INIT pid_t pid;
 
+static void pidApplyMode0(void);
+static void pidApplyMode1(void);
+static void pidApplyMode2(void);
+static void pidApplyMode3(void);
+
 
 float pidGetDT()
 {
@@ -74,12 +79,12 @@ float pidGetPidFrequency()
 
 float pidGetSetpoint(int axis)
 {
-    return pid.data[axis].setPoint;
+    return pid.axis[axis].data.setPoint;
 }
 
 float pidGetOutput(int axis)
 {
-    return pid.data[axis].pidSum;
+    return pid.axis[axis].data.pidSum;
 }
 
 float pidGetCollective(void)
@@ -94,24 +99,25 @@ const pidAxisData_t * pidGetAxisData(void)
 
 void INIT_CODE pidReset(void)
 {
-    memset(pid.data, 0, sizeof(pid.data));
+    for (int axis = 0; axis < PID_AXIS_COUNT; axis++)
+        memset(&pid.axis[axis].data, 0, sizeof(pidAxisData_t));
 }
 
 void INIT_CODE pidResetAxisError(int axis)
 {
-    pid.data[axis].I = 0;
-    pid.data[axis].axisError = 0;
-    pid.data[axis].O = 0;
-    pid.data[axis].axisOffset = 0;
+    pid.axis[axis].data.I = 0;
+    pid.axis[axis].data.axisError = 0;
+    pid.axis[axis].data.O = 0;
+    pid.axis[axis].data.axisOffset = 0;
 }
 
 void INIT_CODE pidResetAxisErrors(void)
 {
     for (int axis = 0; axis < 3; axis++) {
-        pid.data[axis].I = 0;
-        pid.data[axis].axisError = 0;
-        pid.data[axis].O = 0;
-        pid.data[axis].axisOffset = 0;
+        pid.axis[axis].data.I = 0;
+        pid.axis[axis].data.axisError = 0;
+        pid.axis[axis].data.O = 0;
+        pid.axis[axis].data.axisOffset = 0;
     }
 }
 
@@ -129,52 +135,81 @@ static void INIT_CODE pidSetLooptime(uint32_t pidLooptime)
 void INIT_CODE pidInit(const pidProfile_t *pidProfile)
 {
     pidSetLooptime(gyro.targetLooptime);
+
+    pid.filtersReady = false;
     pidInitProfile(pidProfile);
 }
 
+static void INIT_CODE pidCurveInit(pidCurve_t *curve, const uint8_t *table, float scale)
+{
+    for (int i = 0; i < LOOKUP_CURVE_POINTS; i++) {
+        curve->y[i] = table[i] * scale;
+    }
+}
+
 void INIT_CODE pidInitProfile(const pidProfile_t *pidProfile)
 {
+    // On a profile change the filters keep their state,
+    // only the coefficients are updated
+    const bool keepFilters = pid.filtersReady;
+    const bool keepRelax = keepFilters && pid.itermRelaxType;
+
     // PID algorithm
     pid.pidMode = pidProfile->pid_mode;
 
+    switch (pid.pidMode) {
+        case 3:
+            pid.applyMode = pidApplyMode3;
+            break;
+        case 2:
+            pid.applyMode = pidApplyMode2;
+            break;
+        case 1:
+            pid.applyMode = pidApplyMode1;
+            break;
+        default:
+            pid.applyMode = pidApplyMode0;
+            break;
+    }
+
     // Roll axis
-    pid.coef[PID_ROLL].Kp = ROLL_P_TERM_SCALE * pidProfile->pid[PID_ROLL].P;
-    pid.coef[PID_ROLL].Ki = ROLL_I_TERM_SCALE * pidProfile->pid[PID_ROLL].I;
-    pid.coef[PID_ROLL].Kd = ROLL_D_TERM_SCALE * pidProfile->pid[PID_ROLL].D;
-    pid.coef[PID_ROLL].Kf = ROLL_F_TERM_SCALE * pidProfile->pid[PID_ROLL].F;
-    pid.coef[PID_ROLL].Kb = ROLL_B_TERM_SCALE * pidProfile->pid[PID_ROLL].B;
-    pid.coef[PID_ROLL].Ko = ROLL_I_TERM_SCALE * pidProfile->pid[PID_ROLL].O;
+    pid.axis[PID_ROLL].coef.Kp = ROLL_P_TERM_SCALE * pidProfile->pid[PID_ROLL].P;
+    pid.axis[PID_ROLL].coef.Ki = ROLL_I_TERM_SCALE * pidProfile->pid[PID_ROLL].I;
+    pid.axis[PID_ROLL].coef.Kd = ROLL_D_TERM_SCALE * pidProfile->pid[PID_ROLL].D;
+    pid.axis[PID_ROLL].coef.Kf = ROLL_F_TERM_SCALE * pidProfile->pid[PID_ROLL].F;
+    pid.axis[PID_ROLL].coef.Kb = ROLL_B_TERM_SCALE * pidProfile->pid[PID_ROLL].B;
+    pid.axis[PID_ROLL].coef.Ko = ROLL_I_TERM_SCALE * pidProfile->pid[PID_ROLL].O;
 
     // Pitch axis
-    pid.coef[PID_PITCH].Kp = PITCH_P_TERM_SCALE * pidProfile->pid[PID_PITCH].P;
-    pid.coef[PID_PITCH].Ki = PITCH_I_TERM_SCALE * pidProfile->pid[PID_PITCH].I;
-    pid.coef[PID_PITCH].Kd = PITCH_D_TERM_SCALE * pidProfile->pid[PID_PITCH].D;
-    pid.coef[PID_PITCH].Kf = PITCH_F_TERM_SCALE * pidProfile->pid[PID_PITCH].F;
-    pid.coef[PID_PITCH].Kb = PITCH_B_TERM_SCALE * pidProfile->pid[PID_PITCH].B;
-    pid.coef[PID_PITCH].Ko = PITCH_I_TERM_SCALE * pidProfile->pid[PID_PITCH].O;
+    pid.axis[PID_PITCH].coef.Kp = PITCH_P_TERM_SCALE * pidProfile->pid[PID_PITCH].P;
+    pid.axis[PID_PITCH].coef.Ki = PITCH_I_TERM_SCALE * pidProfile->pid[PID_PITCH].I;
+    pid.axis[PID_PITCH].coef.Kd = PITCH_D_TERM_SCALE * pidProfile->pid[PID_PITCH].D;
+    pid.axis[PID_PITCH].coef.Kf = PITCH_F_TERM_SCALE * pidProfile->pid[PID_PITCH].F;
+    pid.axis[PID_PITCH].coef.Kb = PITCH_B_TERM_SCALE * pidProfile->pid[PID_PITCH].B;
+    pid.axis[PID_PITCH].coef.Ko = PITCH_I_TERM_SCALE * pidProfile->pid[PID_PITCH].O;
 
     // Yaw axis
-    pid.coef[PID_YAW].Kp = YAW_P_TERM_SCALE * pidProfile->pid[PID_YAW].P;
-    pid.coef[PID_YAW].Ki = YAW_I_TERM_SCALE * pidProfile->pid[PID_YAW].I;
-    pid.coef[PID_YAW].Kd = YAW_D_TERM_SCALE * pidProfile->pid[PID_YAW].D;
-    pid.coef[PID_YAW].Kf = YAW_F_TERM_SCALE * pidProfile->pid[PID_YAW].F;
-    pid.coef[PID_YAW].Kb = YAW_B_TERM_SCALE * pidProfile->pid[PID_YAW].B;
+    pid.axis[PID_YAW].coef.Kp = YAW_P_TERM_SCALE * pidProfile->pid[PID_YAW].P;
+    pid.axis[PID_YAW].coef.Ki = YAW_I_TERM_SCALE * pidProfile->pid[PID_YAW].I;
+    pid.axis[PID_YAW].coef.Kd = YAW_D_TERM_SCALE * pidProfile->pid[PID_YAW].D;
+    pid.axis[PID_YAW].coef.Kf = YAW_F_TERM_SCALE * pidProfile->pid[PID_YAW].F;
+    pid.axis[PID_YAW].coef.Kb = YAW_B_TERM_SCALE * pidProfile->pid[PID_YAW].B;
 
     // Bleed conversion for pitch
     if (pidProfile->pid[PID_PITCH].O > 0 && pidProfile->pid[PID_PITCH].I > 0)
-      pid.coef[PID_PITCH].Kc = pid.coef[PID_PITCH].Ko / pid.coef[PID_PITCH].Ki;
+      pid.axis[PID_PITCH].coef.Kc = pid.axis[PID_PITCH].coef.Ko / pid.axis[PID_PITCH].coef.Ki;
     else
-      pid.coef[PID_PITCH].Kc = 0;
+      pid.axis[PID_PITCH].coef.Kc = 0;
 
     // Bleed conversion for roll
     if (pidProfile->pid[PID_ROLL].O > 0 && pidProfile->pid[PID_ROLL].I > 0)
-      pid.coef[PID_ROLL].Kc = pid.coef[PID_ROLL].Ko / pid.coef[PID_ROLL].Ki;
+      pid.axis[PID_ROLL].coef.Kc = pid.axis[PID_ROLL].coef.Ko / pid.axis[PID_ROLL].coef.Ki;
     else
-      pid.coef[PID_ROLL].Kc = 0;
+      pid.axis[PID_ROLL].coef.Kc = 0;
 
     // Accumulated error limit
     for (int i = 0; i < XYZ_AXIS_COUNT; i++)
-        pid.errorLimit[i] = pidProfile->error_limit[i];
+        pid.axis[i].errorLimit = pidProfile->error_limit[i];
     for (int i = 0; i < XY_AXIS_COUNT; i++)
         pid.offsetLimit[i] = pidProfile->offset_limit[i];
 
@@ -187,23 +222,61 @@ void INIT_CODE pidInitProfile(const pidProfile_t *pidProfile)
     pid.errorDecayLimitCyclic = (pidProfile->error_decay_limit_cyclic) ? pidProfile->error_decay_limit_cyclic : 3600;
     pid.errorDecayLimitYaw    = (pidProfile->error_decay_limit_yaw)    ? pidProfile->error_decay_limit_yaw : 3600;
 
+    // Collective/cyclic dependent curves
+    pidCurveInit(&pid.errorDecayRateCurve, pidProfile->error_decay_rate_curve, pid.errorDecayRateCyclic * 0.08f);
+    pidCurveInit(&pid.errorDecayLimitCurve, pidProfile->error_decay_limit_curve, pid.errorDecayLimitCyclic * 0.08f);
+    pidCurveInit(&pid.offsetChargeCurve, pidProfile->offset_charge_curve, 0.01f);
+    pidCurveInit(&pid.offsetDecayRateCurve, pidProfile->offset_decay_rate_curve, 0.04f);
+    pidCurveInit(&pid.offsetDecayLimitCurve, pidProfile->offset_decay_limit_curve, 1.0f);
+    pidCurveInit(&pid.offsetBleedRateCurve, pidProfile->offset_bleed_rate_curve, 0.04f);
+    pidCurveInit(&pid.offsetBleedLimitCurve, pidProfile->offset_bleed_limit_curve, 1.0f);
+
+    // Headspeed dependent gain curves
+    pidCurveInit(&pid.pidGainCurve, pidProfile->pid_headspeed_curve, 0.01f);
+    pidCurveInit(&pid.precompGainCurve, pidProfile->precomp_headspeed_curve, 0.01f);
+
+    pid.gainScheduling = false;
+    for (int i = 0; i < LOOKUP_CURVE_POINTS; i++) {
+        if (pidProfile->pid_headspeed_curve[i] != 100 || pidProfile->precomp_headspeed_curve[i] != 100)
+            pid.gainScheduling = true;
+    }
+
+    // Unscheduled gains, scaled from these in pidApplyGainSchedule
+    for (int i = 0; i < PID_AXIS_COUNT; i++)
+        pid.coefBase[i] = pid.axis[i].coef;
+    pid.precomp.gainScale = 1.0f;
+
     // Error Rotation enable
     pid.errorRotation = pidProfile->error_rotation;
 
     // Filters
     for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
-        lowpassFilterInit(&pid.gyrorFilter[i], pidProfile->gyro_filter_type, pidProfile->gyro_cutoff[i], pid.freq, 0);
-        lowpassFilterInit(&pid.errorFilter[i], LPF_ORDER1, pidProfile->error_cutoff[i], pid.freq, 0);
-        difFilterInit(&pid.dtermFilter[i], pidProfile->dterm_cutoff[i], pid.freq);
-        difFilterInit(&pid.btermFilter[i], pidProfile->bterm_cutoff[i], pid.freq);
+        if (keepFilters) {
+            lowpassFilterChange(&pid.axis[i].gyrorFilter, pidProfile->gyro_filter_type, pidProfile->gyro_cutoff[i], pid.freq, 0);
+            lowpassFilterChange(&pid.axis[i].errorFilter, LPF_ORDER1, pidProfile->error_cutoff[i], pid.freq, 0);
+            difFilterUpdate(&pid.axis[i].dtermFilter, pidProfile->dterm_cutoff[i], pid.freq);
+            difFilterUpdate(&pid.axis[i].btermFilter, pidProfile->bterm_cutoff[i], pid.freq);
+        } else {
+            lowpassFilterInit(&pid.axis[i].gyrorFilter, pidProfile->gyro_filter_type, pidProfile->gyro_cutoff[i], pid.freq, 0);
+            lowpassFilterInit(&pid.axis[i].errorFilter, LPF_ORDER1, pidProfile->error_cutoff[i], pid.freq, 0);
+            difFilterInit(&pid.axis[i].dtermFilter, pidProfile->dterm_cutoff[i], pid.freq);
+            difFilterInit(&pid.axis[i].btermFilter, pidProfile->bterm_cutoff[i], pid.freq);
+        }
     }
 
     // Error relax
     pid.itermRelaxType = pidProfile->iterm_relax_type;
+    for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+        pid.itermRelax[i] = (pid.itermRelaxType == ITERM_RELAX_RPY) ||
+                            (pid.itermRelaxType == ITERM_RELAX_RP && i != PID_YAW);
+    }
     if (pid.itermRelaxType) {
         for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
             uint8_t freq = constrain(pidProfile->iterm_relax_cutoff[i], 1, 100);
-            pt1FilterInit(&pid.relaxFilter[i], freq, pid.freq);
+            if (keepRelax)
+                pt1FilterUpdate(&pid.axis[i].relaxFilter, freq, pid.freq);
+            else
+                pt1FilterInit(&pid.axis[i].relaxFilter, freq, pid.freq);
             pid.itermRelaxLevel[i] = constrain(pidProfile->iterm_relax_level[i], 10, 250);
         }
     }
@@ -217,12 +290,22 @@ void INIT_CODE pidInitProfile(const pidProfile_t *pidProfile)
     pid.yawCCWStopGain = pidProfile->yaw_ccw_stop_gain / 100.0f;
 
     // Collective/cyclic deflection lowpass filters
-    lowpassFilterInit(&pid.precomp.collDeflectionFilter, pidProfile->yaw_precomp_filter_type, pidProfile->yaw_precomp_cutoff, pid.freq, 0);
-    lowpassFilterInit(&pid.precomp.pitchDeflectionFilter, pidProfile->yaw_precomp_filter_type, pidProfile->yaw_precomp_cutoff, pid.freq, 0);
-    lowpassFilterInit(&pid.precomp.rollDeflectionFilter, pidProfile->yaw_precomp_filter_type, pidProfile->yaw_precomp_cutoff, pid.freq, 0);
+    if (keepFilters) {
+        lowpassFilterChange(&pid.precomp.collDeflectionFilter, pidProfile->yaw_precomp_filter_type, pidProfile->yaw_precomp_cutoff, pid.freq, 0);
+        lowpassFilterChange(&pid.precomp.pitchDeflectionFilter, pidProfile->yaw_precomp_filter_type, pidProfile->yaw_precomp_cutoff, pid.freq, 0);
+        lowpassFilterChange(&pid.precomp.rollDeflectionFilter, pidProfile->yaw_precomp_filter_type, pidProfile->yaw_precomp_cutoff, pid.freq, 0);
+    } else {
+        lowpassFilterInit(&pid.precomp.collDeflectionFilter, pidProfile->yaw_precomp_filter_type, pidProfile->yaw_precomp_cutoff, pid.freq, 0);
+        lowpassFilterInit(&pid.precomp.pitchDeflectionFilter, pidProfile->yaw_precomp_filter_type, pidProfile->yaw_precomp_cutoff, pid.freq, 0);
+        lowpassFilterInit(&pid.precomp.rollDeflectionFilter, pidProfile->yaw_precomp_filter_type, pidProfile->yaw_precomp_cutoff, pid.freq, 0);
+    }
 
     // Collective dynamic filter
-    pt1FilterInit(&pid.precomp.collDynamicFilter, 100.0f / constrainf(pidProfile->yaw_collective_dynamic_decay, 1, 250), pid.freq);
+    const float collDynamicCutoff = 100.0f / constrainf(pidProfile->yaw_collective_dynamic_decay, 1, 250);
+    if (keepFilters)
+        pt1FilterUpdate(&pid.precomp.collDynamicFilter, collDynamicCutoff, pid.freq);
+    else
+        pt1FilterInit(&pid.precomp.collDynamicFilter, collDynamicCutoff, pid.freq);
 
     // Tail/yaw precomp
     pid.precomp.yawCyclicFFGain = pidProfile->yaw_cyclic_ff_gain / 100.0f;
@@ -237,8 +320,15 @@ void INIT_CODE pidInitProfile(const pidProfile_t *pidProfile)
     pid.cyclicCrossCouplingGain[FD_ROLL]  = pid.cyclicCrossCouplingGain[FD_PITCH] * pidProfile->cyclic_cross_coupling_ratio / -100.0f;
 
     // Cross-coupling derivative filters
-    difFilterInit(&pid.crossCouplingFilter[FD_PITCH], pidProfile->cyclic_cross_coupling_cutoff, pid.freq);
-    difFilterInit(&pid.crossCouplingFilter[FD_ROLL], pidProfile->cyclic_cross_coupling_cutoff, pid.freq);
+    if (keepFilters) {
+        difFilterUpdate(&pid.crossCouplingFilter[FD_PITCH], pidProfile->cyclic_cross_coupling_cutoff, pid.freq);
+        difFilterUpdate(&pid.crossCouplingFilter[FD_ROLL], pidProfile->cyclic_cross_coupling_cutoff, pid.freq);
+    } else {
+        difFilterInit(&pid.crossCouplingFilter[FD_PITCH], pidProfile->cyclic_cross_coupling_cutoff, pid.freq);
+        difFilterInit(&pid.crossCouplingFilter[FD_ROLL], pidProfile->cyclic_cross_coupling_cutoff, pid.freq);
+    }
+
+    pid.filtersReady = true;
 
     // Initialise sub-profiles
     governorInitProfile(pidProfile);
@@ -293,28 +383,26 @@ static inline void rotateAxisError(void)
         const float C = t * (1 - t / 6);
         const float S = r * (1 - t / 3);
 
-        const float x = pid.data[PID_ROLL].axisError;
-        const float y = pid.data[PID_PITCH].axisError;
+        const float x = pid.axis[PID_ROLL].data.axisError;
+        const float y = pid.axis[PID_PITCH].data.axisError;
 
-        pid.data[PID_ROLL].axisError  -= x * C - y * S;
-        pid.data[PID_PITCH].axisError -= y * C + x * S;
+        pid.axis[PID_ROLL].data.axisError  -= x * C - y * S;
+        pid.axis[PID_PITCH].data.axisError -= y * C + x * S;
 
-        const float fx = pid.data[PID_ROLL].axisOffset;
-        const float fy = pid.data[PID_PITCH].axisOffset;
+        const float fx = pid.axis[PID_ROLL].data.axisOffset;
+        const float fy = pid.axis[PID_PITCH].data.axisOffset;
 
-        pid.data[PID_ROLL].axisOffset  -= fx * C - fy * S;
-        pid.data[PID_PITCH].axisOffset -= fy * C + fx * S;
+        pid.axis[PID_ROLL].data.axisOffset  -= fx * C - fy * S;
+        pid.axis[PID_PITCH].data.axisOffset -= fy * C + fx * S;
     }
 }
 
 
 static float applyItermRelax(int axis, float itermError, float gyroRate, float setpoint)
 {
-    if ((pid.itermRelaxType == ITERM_RELAX_RPY) ||
-        (pid.itermRelaxType == ITERM_RELAX_RP && axis == PID_ROLL) ||
-        (pid.itermRelaxType == ITERM_RELAX_RP && axis == PID_PITCH))
+    if (pid.itermRelax[axis])
     {
-        const float setpointLpf = pt1FilterApply(&pid.relaxFilter[axis], setpoint);
+        const float setpointLpf = pt1FilterApply(&pid.axis[axis].relaxFilter, setpoint);
         const float setpointHpf = setpoint - setpointLpf;
 
         const float itermRelaxFactor = MAX(0, 1.0f - fabsf(setpointHpf) / pid.itermRelaxLevel[axis]);
@@ -356,7 +444,7 @@ static float pidApplySetpoint(uint8_t axis)
 #endif
 
     // Save setpoint
-    pid.data[axis].setPoint = setpoint;
+    pid.axis[axis].data.setPoint = setpoint;
 
     return setpoint;
 }
@@ -367,10 +455,10 @@ static float pidApplyGyroRate(uint8_t axis)
     float gyroRate = gyro.gyroADCf[axis];
 
     // Bandwidth limiter
-    gyroRate = filterApply(&pid.gyrorFilter[axis], gyroRate);
+    gyroRate = filterApply(&pid.axis[axis].gyrorFilter, gyroRate);
 
     // Save current rate
-    pid.data[axis].gyroRate = gyroRate;
+    pid.axis[axis].data.gyroRate = gyroRate;
 
     return gyroRate;
 }
@@ -413,11 +501,11 @@ static void pidApplyPrecomp(void)
     float yawCyclicFF = fabsf(cyclicDeflection) * pid.precomp.yawCyclicFFGain;
 
     // Calculate total precompensation
-    float yawPrecomp = (yawCollectiveFF + yawCollectiveHF + yawCyclicFF) * masterGain;
+    float yawPrecomp = (yawCollectiveFF + yawCollectiveHF + yawCyclicFF) * masterGain * pid.precomp.gainScale;
 
     // Add to YAW feedforward
-    pid.data[FD_YAW].F += yawPrecomp;
-    pid.data[FD_YAW].pidSum += yawPrecomp;
+    pid.axis[FD_YAW].data.F += yawPrecomp;
+    pid.axis[FD_YAW].data.pidSum += yawPrecomp;
 
     DEBUG(YAW_PRECOMP, 0, collectiveDeflection * 1000);
     DEBUG(YAW_PRECOMP, 1, collectiveLF * 1000);
@@ -432,11 +520,11 @@ static void pidApplyPrecomp(void)
   //// Collective-to-Pitch precomp
 
     // Collective component
-    const float pitchPrecomp = collectiveDeflection * pid.precomp.pitchCollectiveFFGain;
+    const float pitchPrecomp = collectiveDeflection * pid.precomp.pitchCollectiveFFGain * pid.precomp.gainScale;
 
     // Add to PITCH feedforward
-    pid.data[FD_PITCH].F += pitchPrecomp;
-    pid.data[FD_PITCH].pidSum += pitchPrecomp;
+    pid.axis[FD_PITCH].data.F += pitchPrecomp;
+    pid.axis[FD_PITCH].data.pidSum += pitchPrecomp;
 
     DEBUG(PITCH_PRECOMP, 0, collectiveDeflection * 1000);
     DEBUG(PITCH_PRECOMP, 1, pitchPrecomp * 1000);
@@ -445,14 +533,14 @@ static void pidApplyPrecomp(void)
 static void pidApplyCyclicCrossCoupling(void)
 {
     // Setpoint derivative filter
-    const float pitchDeriv = difFilterApply(&pid.crossCouplingFilter[FD_PITCH], pid.data[FD_PITCH].setPoint);
-    const float rollDeriv  = difFilterApply(&pid.crossCouplingFilter[FD_ROLL], pid.data[FD_ROLL].setPoint);
+    const float pitchDeriv = difFilterApply(&pid.crossCouplingFilter[FD_PITCH], pid.axis[FD_PITCH].data.setPoint);
+    const float rollDeriv  = difFilterApply(&pid.crossCouplingFilter[FD_ROLL], pid.axis[FD_ROLL].data.setPoint);
     const float pitchComp  = rollDeriv * pid.cyclicCrossCouplingGain[FD_ROLL];
     const float rollComp   = pitchDeriv * pid.cyclicCrossCouplingGain[FD_PITCH];
 
     // Add de-coupling terms
-    pid.data[FD_ROLL].pidSum += rollComp;
-    pid.data[FD_PITCH].pidSum += pitchComp;
+    pid.axis[FD_ROLL].data.pidSum += rollComp;
+    pid.axis[FD_PITCH].data.pidSum += pitchComp;
 
     DEBUG(CROSS_COUPLING, 0, rollDeriv);
     DEBUG(CROSS_COUPLING, 1, pitchDeriv);
@@ -460,36 +548,62 @@ static void pidApplyCyclicCrossCoupling(void)
     DEBUG(CROSS_COUPLING, 3, pitchComp * 1000);
 }
 
-static float pidTableLookup(float x, const uint8_t * table, int points)
+static float pidCurveLookup(float x, const pidCurve_t *curve)
 {
     /* Number of bins */
-    const int bins = points - 1;
+    const int bins = LOOKUP_CURVE_POINTS - 1;
 
     /* Map x in range 0..1 to piecewise linear table of size count */
-    const int index = constrain(x * bins, 0, bins - 1);
+    const float xb = x * bins;
+    const int index = constrain(xb, 0, bins - 1);
 
-    const int a = table[index + 0];
-    const int b = table[index + 1];
+    const float a = curve->y[index + 0];
+    const float b = curve->y[index + 1];
 
-    const float dy = b - a;
-    const float dx = x * bins - index;
-    const float y = a + dx * dy;
+    const float y = a + (xb - index) * (b - a);
 
     return fmaxf(y, 0);
 }
 
-static void pidApplyOffsetBleed(const pidProfile_t * pidProfile)
+static void pidApplyGainSchedule(void)
+{
+    // Gains for the full headspeed are the profile values
+    const float headspeed = constrainf(getFullHeadSpeedRatio(), 0, 1);
+
+    const float pidGain = pidCurveLookup(headspeed, &pid.pidGainCurve);
+    const float precompGain = pidCurveLookup(headspeed, &pid.precompGainCurve);
+
+    for (int axis = 0; axis < PID_AXIS_COUNT; axis++) {
+        const pidAxisCoef_t *base = &pid.coefBase[axis];
+        pidAxisCoef_t *coef = &pid.axis[axis].coef;
+
+        coef->Kp = base->Kp * pidGain;
+        coef->Ki = base->Ki * pidGain;
+        coef->Kd = base->Kd * pidGain;
+        coef->Kf = base->Kf * pidGain;
+        coef->Kb = base->Kb * pidGain;
+        coef->Ko = base->Ko * pidGain;
+    }
+
+    pid.precomp.gainScale = precompGain;
+
+    DEBUG(PID_GAINS, 0, headspeed * 1000);
+    DEBUG(PID_GAINS, 1, pidGain * 1000);
+    DEBUG(PID_GAINS, 2, precompGain * 1000);
+}
+
+static void pidApplyOffsetBleed(void)
 {
     // Actual collective
     const float collective = getCollectiveDeflection();
 
     // Offset vector
-    const float Bx = pid.data[PID_PITCH].axisOffset;
-    const float By = pid.data[PID_ROLL ].axisOffset;
+    const float Bx = pid.axis[PID_PITCH].data.axisOffset;
+    const float By = pid.axis[PID_ROLL ].data.axisOffset;
 
     // Cyclic vector
-    const float Ax = pid.data[PID_PITCH].setPoint;
-    const float Ay = pid.data[PID_ROLL].setPoint;
+    const float Ax = pid.axis[PID_PITCH].data.setPoint;
+    const float Ay = pid.axis[PID_ROLL].data.setPoint;
 
     // Cyclic norm²
     const float A2 = Ax * Ax + Ay * Ay;
@@ -505,23 +619,23 @@ static void pidApplyOffsetBleed(const pidProfile_t * pidProfile)
     const float Py = Ay * Dp;
 
     // Bleed variables
-    float bleedRate = pidTableLookup(Cx, pidProfile->offset_bleed_rate_curve, LOOKUP_CURVE_POINTS) * 0.04f;
-    float bleedLimit = pidTableLookup(Cx, pidProfile->offset_bleed_limit_curve, LOOKUP_CURVE_POINTS);
+    float bleedRate = pidCurveLookup(Cx, &pid.offsetBleedRateCurve);
+    float bleedLimit = pidCurveLookup(Cx, &pid.offsetBleedLimitCurve);
 
     // Offset bleed amount
     float bleedP = limitf(Px * bleedRate, bleedLimit) * pid.dT;
     float bleedR = limitf(Py * bleedRate, bleedLimit) * pid.dT;
 
     // Bleed from axisOffset to axisError
-    pid.data[PID_PITCH].axisOffset -= bleedP;
-    pid.data[PID_ROLL].axisOffset  -= bleedR;
-    pid.data[PID_PITCH].axisError  += bleedP * pid.coef[PID_PITCH].Kc * collective;
-    pid.data[PID_ROLL].axisError   += bleedR * pid.coef[PID_ROLL].Kc * collective;
-
-    DEBUG(HS_BLEED, 0, pid.data[PID_PITCH].axisOffset * 10);
-    DEBUG(HS_BLEED, 1, pid.data[PID_ROLL].axisOffset * 10);
-    DEBUG(HS_BLEED, 2, pid.data[PID_PITCH].axisError * 10);
-    DEBUG(HS_BLEED, 3, pid.data[PID_ROLL].axisError * 10);
+    pid.axis[PID_PITCH].data.axisOffset -= bleedP;
+    pid.axis[PID_ROLL].data.axisOffset  -= bleedR;
+    pid.axis[PID_PITCH].data.axisError  += bleedP * pid.axis[PID_PITCH].coef.Kc * collective;
+    pid.axis[PID_ROLL].data.axisError   += bleedR * pid.axis[PID_ROLL].coef.Kc * collective;
+
+    DEBUG(HS_BLEED, 0, pid.axis[PID_PITCH].data.axisOffset * 10);
+    DEBUG(HS_BLEED, 1, pid.axis[PID_ROLL].data.axisOffset * 10);
+    DEBUG(HS_BLEED, 2, pid.axis[PID_PITCH].data.axisError * 10);
+    DEBUG(HS_BLEED, 3, pid.axis[PID_ROLL].data.axisError * 10);
     DEBUG(HS_BLEED, 4, bleedRate * 1000);
     DEBUG(HS_BLEED, 5, bleedLimit * 1000);
     DEBUG(HS_BLEED, 6, bleedP * 1e6);
@@ -535,25 +649,25 @@ static void pidApplyOffsetBleed(const pidProfile_t * pidProfile)
  **
  ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** **/
 
-static void pidApplyMode0(uint8_t axis)
+static void pidApplyAxisMode0(uint8_t axis)
 {
     // Rate setpoint
     float setpoint = pidApplySetpoint(axis);
 
   //// Unused term
-    pid.data[axis].P = 0;
-    pid.data[axis].I = 0;
-    pid.data[axis].D = 0;
+    pid.axis[axis].data.P = 0;
+    pid.axis[axis].data.I = 0;
+    pid.axis[axis].data.D = 0;
 
   //// F-term
 
     // Calculate feedforward component
-    pid.data[axis].F = pid.coef[axis].Kf * setpoint;
+    pid.axis[axis].data.F = pid.axis[axis].coef.Kf * setpoint;
 
   //// PID Sum
 
     // Calculate PID sum
-    pid.data[axis].pidSum = pid.data[axis].F;
+    pid.axis[axis].data.pidSum = pid.axis[axis].data.F;
 }
 
 
@@ -586,23 +700,23 @@ static void pidApplyCyclicMode1(uint8_t axis)
   //// P-term
 
     // P-term with extra filtering
-    float pTerm = filterApply(&pid.errorFilter[axis], errorRate);
+    float pTerm = filterApply(&pid.axis[axis].errorFilter, errorRate);
 
     // Calculate P-component
-    pid.data[axis].P = pid.coef[axis].Kp * pTerm;
+    pid.axis[axis].data.P = pid.axis[axis].coef.Kp * pTerm;
 
 
   //// D-term
 
     // Calculate D-term with bandwidth limit
-    float dTerm = difFilterApply(&pid.dtermFilter[axis], -gyroRate);
+    float dTerm = difFilterApply(&pid.axis[axis].dtermFilter, -gyroRate);
 
     // No accumulation if axis saturated
     if (pidAxisSaturated(axis))
         dTerm = 0;
 
     // Calculate D-term
-    pid.data[axis].D = pid.coef[axis].Kd * dTerm;
+    pid.axis[axis].data.D = pid.axis[axis].coef.Kd * dTerm;
 
 
   //// I-term
@@ -619,24 +733,24 @@ static void pidApplyCyclicMode1(uint8_t axis)
     }
 
     // Calculate I-component
-    pid.data[axis].axisError = limitf(pid.data[axis].axisError + itermDelta, pid.errorLimit[axis]);
-    pid.data[axis].I = pid.coef[axis].Ki * pid.data[axis].axisError;
+    pid.axis[axis].data.axisError = limitf(pid.axis[axis].data.axisError + itermDelta, pid.axis[axis].errorLimit);
+    pid.axis[axis].data.I = pid.axis[axis].coef.Ki * pid.axis[axis].data.axisError;
 
     // Apply I-term error decay
     if (!isAirborne())
-        pid.data[axis].axisError -= pid.data[axis].axisError * pid.errorDecayRateGround;
+        pid.axis[axis].data.axisError -= pid.axis[axis].data.axisError * pid.errorDecayRateGround;
 
 
   //// Feedforward
 
     // Calculate F component
-    pid.data[axis].F = pid.coef[axis].Kf * setpoint;
+    pid.axis[axis].data.F = pid.axis[axis].coef.Kf * setpoint;
 
 
   //// PID Sum
 
     // Calculate PID sum
-    pid.data[axis].pidSum = pid.data[axis].P + pid.data[axis].I + pid.data[axis].D + pid.data[axis].F;
+    pid.axis[axis].data.pidSum = pid.axis[axis].data.P + pid.axis[axis].data.I + pid.axis[axis].data.D + pid.axis[axis].data.F;
 }
 
 
@@ -657,26 +771,26 @@ static void pidApplyYawMode1(void)
   //// P-term
 
     // P-term
-    float pTerm = filterApply(&pid.errorFilter[axis], errorRate);
+    float pTerm = filterApply(&pid.axis[axis].errorFilter, errorRate);
 
     // Select stop gain
     float stopGain = (pTerm > 0) ? pid.yawCWStopGain : pid.yawCCWStopGain;
 
     // Calculate P-component
-    pid.data[axis].P = pid.coef[axis].Kp * pTerm * stopGain;
+    pid.axis[axis].data.P = pid.axis[axis].coef.Kp * pTerm * stopGain;
 
 
   //// D-term
 
     // Calculate D-term with bandwidth limit
-    float dTerm = difFilterApply(&pid.dtermFilter[axis], -gyroRate);
+    float dTerm = difFilterApply(&pid.axis[axis].dtermFilter, -gyroRate);
 
     // No D if axis saturated
     if (pidAxisSaturated(axis))
         dTerm = 0;
 
     // Calculate D-component
-    pid.data[axis].D = pid.coef[axis].Kd * dTerm * stopGain;
+    pid.axis[axis].data.D = pid.axis[axis].coef.Kd * dTerm * stopGain;
 
 
   //// I-term
@@ -693,24 +807,24 @@ static void pidApplyYawMode1(void)
     }
 
     // Calculate I-component
-    pid.data[axis].axisError = limitf(pid.data[axis].axisError + itermDelta, pid.errorLimit[axis]);
-    pid.data[axis].I = pid.coef[axis].Ki * pid.data[axis].axisError;
+    pid.axis[axis].data.axisError = limitf(pid.axis[axis].data.axisError + itermDelta, pid.axis[axis].errorLimit);
+    pid.axis[axis].data.I = pid.axis[axis].coef.Ki * pid.axis[axis].data.axisError;
 
     // Apply I-term error decay
     if (!isSpooledUp())
-        pid.data[axis].axisError -= pid.data[axis].axisError * pid.errorDecayRateGround;
+        pid.axis[axis].data.axisError -= pid.axis[axis].data.axisError * pid.errorDecayRateGround;
 
 
   //// Feedforward
 
     // Calculate F component
-    pid.data[axis].F = pid.coef[axis].Kf * setpoint;
+    pid.axis[axis].data.F = pid.axis[axis].coef.Kf * setpoint;
 
 
   //// PID Sum
 
     // Calculate PID sum
-    pid.data[axis].pidSum = pid.data[axis].P + pid.data[axis].I + pid.data[axis].D + pid.data[axis].F;
+    pid.axis[axis].data.pidSum = pid.axis[axis].data.P + pid.axis[axis].data.I + pid.axis[axis].data.D + pid.axis[axis].data.F;
 }
 
 
@@ -742,7 +856,7 @@ static void pidApplyCyclicMode2(uint8_t axis)
   //// P-term
 
     // Calculate P-component
-    pid.data[axis].P = pid.coef[axis].Kp * errorRate;
+    pid.axis[axis].data.P = pid.axis[axis].coef.Kp * errorRate;
 
 
   //// D-term
@@ -751,10 +865,10 @@ static void pidApplyCyclicMode2(uint8_t axis)
     const float dError = pid.dtermMode ? errorRate : -gyroRate;
 
     // Calculate D-term with bandwidth limit
-    const float dTerm = difFilterApply(&pid.dtermFilter[axis], dError);
+    const float dTerm = difFilterApply(&pid.axis[axis].dtermFilter, dError);
 
     // Calculate D-component
-    pid.data[axis].D = pid.coef[axis].Kd * dTerm;
+    pid.axis[axis].data.D = pid.axis[axis].coef.Kd * dTerm;
 
 
   //// I-term
@@ -763,40 +877,40 @@ static void pidApplyCyclicMode2(uint8_t axis)
     const float itermErrorRate = applyItermRelax(axis, errorRate, gyroRate, setpoint);
 
     // Saturation
-    const bool saturation = (pidAxisSaturated(axis) && pid.data[axis].I * itermErrorRate > 0);
+    const bool saturation = (pidAxisSaturated(axis) && pid.axis[axis].data.I * itermErrorRate > 0);
 
     // I-term change
     const float itermDelta = saturation ? 0 : itermErrorRate * pid.dT;
 
     // Calculate I-component
-    pid.data[axis].axisError = limitf(pid.data[axis].axisError + itermDelta, pid.errorLimit[axis]);
-    pid.data[axis].I = pid.coef[axis].Ki * pid.data[axis].axisError;
+    pid.axis[axis].data.axisError = limitf(pid.axis[axis].data.axisError + itermDelta, pid.axis[axis].errorLimit);
+    pid.axis[axis].data.I = pid.axis[axis].coef.Ki * pid.axis[axis].data.axisError;
 
     // Apply I-term error decay
-    pid.data[axis].axisError -= pid.dT * (isAirborne() ?
-      limitf(pid.data[axis].axisError * pid.errorDecayRateCyclic, pid.errorDecayLimitCyclic) :
-      pid.data[axis].axisError * pid.errorDecayRateGround);
+    pid.axis[axis].data.axisError -= pid.dT * (isAirborne() ?
+      limitf(pid.axis[axis].data.axisError * pid.errorDecayRateCyclic, pid.errorDecayLimitCyclic) :
+      pid.axis[axis].data.axisError * pid.errorDecayRateGround);
 
 
   //// Feedforward
 
     // Calculate F component
-    pid.data[axis].F = pid.coef[axis].Kf * setpoint;
+    pid.axis[axis].data.F = pid.axis[axis].coef.Kf * setpoint;
 
   //// Feedforward Boost (FF Derivative)
 
     // Calculate B-term with bandwidth limit
-    const float bTerm = difFilterApply(&pid.btermFilter[axis], setpoint);
+    const float bTerm = difFilterApply(&pid.axis[axis].btermFilter, setpoint);
 
     // Calculate B-component
-    pid.data[axis].B = pid.coef[axis].Kb * bTerm;
+    pid.axis[axis].data.B = pid.axis[axis].coef.Kb * bTerm;
 
 
   //// PID Sum
 
     // Calculate sum of all terms
-    pid.data[axis].pidSum = pid.data[axis].P + pid.data[axis].I + pid.data[axis].D +
-                            pid.data[axis].F + pid.data[axis].B;
+    pid.axis[axis].data.pidSum = pid.axis[axis].data.P + pid.axis[axis].data.I + pid.axis[axis].data.D +
+                            pid.axis[axis].data.F + pid.axis[axis].data.B;
 }
 
 
@@ -820,7 +934,7 @@ static void pidApplyYawMode2(void)
   //// P-term
 
     // Calculate P-component
-    pid.data[axis].P = pid.coef[axis].Kp * errorRate * stopGain;
+    pid.axis[axis].data.P = pid.axis[axis].coef.Kp * errorRate * stopGain;
 
 
   //// D-term
@@ -829,10 +943,10 @@ static void pidApplyYawMode2(void)
     const float dError = pid.dtermModeYaw ? errorRate : -gyroRate;
 
     // Calculate D-term with bandwidth limit
-    const float dTerm = difFilterApply(&pid.dtermFilter[axis], dError);
+    const float dTerm = difFilterApply(&pid.axis[axis].dtermFilter, dError);
 
     // Calculate D-component
-    pid.data[axis].D = pid.coef[axis].Kd * dTerm;
+    pid.axis[axis].data.D = pid.axis[axis].coef.Kd * dTerm;
 
 
   //// I-term
@@ -841,41 +955,41 @@ static void pidApplyYawMode2(void)
     const float itermErrorRate = applyItermRelax(axis, errorRate, gyroRate, setpoint);
 
     // Saturation
-    const bool saturation = (pidAxisSaturated(axis) && pid.data[axis].I * itermErrorRate > 0);
+    const bool saturation = (pidAxisSaturated(axis) && pid.axis[axis].data.I * itermErrorRate > 0);
 
     // I-term change
     const float itermDelta = saturation ? 0 : itermErrorRate * pid.dT;
 
     // Calculate I-component
-    pid.data[axis].axisError = limitf(pid.data[axis].axisError + itermDelta, pid.errorLimit[axis]);
-    pid.data[axis].I = pid.coef[axis].Ki * pid.data[axis].axisError;
+    pid.axis[axis].data.axisError = limitf(pid.axis[axis].data.axisError + itermDelta, pid.axis[axis].errorLimit);
+    pid.axis[axis].data.I = pid.axis[axis].coef.Ki * pid.axis[axis].data.axisError;
 
     // Apply I-term error decay
-    pid.data[axis].axisError -= pid.dT * (isSpooledUp() ?
-      limitf(pid.data[axis].axisError * pid.errorDecayRateYaw, pid.errorDecayLimitYaw) :
-      pid.data[axis].axisError * pid.errorDecayRateGround);
+    pid.axis[axis].data.axisError -= pid.dT * (isSpooledUp() ?
+      limitf(pid.axis[axis].data.axisError * pid.errorDecayRateYaw, pid.errorDecayLimitYaw) :
+      pid.axis[axis].data.axisError * pid.errorDecayRateGround);
 
 
   //// Feedforward
 
     // Calculate F component
-    pid.data[axis].F = pid.coef[axis].Kf * setpoint;
+    pid.axis[axis].data.F = pid.axis[axis].coef.Kf * setpoint;
 
 
   //// Feedforward Boost (FF Derivative)
 
     // Calculate B-term with bandwidth limit
-    const float bTerm = difFilterApply(&pid.btermFilter[axis], setpoint);
+    const float bTerm = difFilterApply(&pid.axis[axis].btermFilter, setpoint);
 
     // Calculate B-component
-    pid.data[axis].B = pid.coef[axis].Kb * bTerm;
+    pid.axis[axis].data.B = pid.axis[axis].coef.Kb * bTerm;
 
 
   //// PID Sum
 
     // Calculate sum of all terms
-    pid.data[axis].pidSum = pid.data[axis].P + pid.data[axis].I + pid.data[axis].D +
-                            pid.data[axis].F + pid.data[axis].B;
+    pid.axis[axis].data.pidSum = pid.axis[axis].data.P + pid.axis[axis].data.I + pid.axis[axis].data.D +
+                            pid.axis[axis].data.F + pid.axis[axis].data.B;
 }
 
 
@@ -894,7 +1008,7 @@ static void pidApplyYawMode2(void)
  **
  ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** ** **/
 
-static void pidApplyCyclicMode3(uint8_t axis, const pidProfile_t * pidProfile)
+static void pidApplyCyclicMode3(uint8_t axis)
 {
     // Rate setpoint
     const float setpoint = pidApplySetpoint(axis);
@@ -909,7 +1023,7 @@ static void pidApplyCyclicMode3(uint8_t axis, const pidProfile_t * pidProfile)
   //// P-term
 
     // Calculate P-component
-    pid.data[axis].P = pid.coef[axis].Kp * errorRate;
+    pid.axis[axis].data.P = pid.axis[axis].coef.Kp * errorRate;
 
 
   //// D-term (gyro only)
@@ -918,10 +1032,10 @@ static void pidApplyCyclicMode3(uint8_t axis, const pidProfile_t * pidProfile)
     const float dError = pid.dtermMode ? errorRate : -gyroRate;
 
     // Calculate D-term with bandwidth limit
-    const float dTerm = difFilterApply(&pid.dtermFilter[axis], dError);
+    const float dTerm = difFilterApply(&pid.axis[axis].dtermFilter, dError);
 
     // Calculate D-component
-    pid.data[axis].D = pid.coef[axis].Kd * dTerm;
+    pid.axis[axis].data.D = pid.axis[axis].coef.Kd * dTerm;
 
 
   //// I-term
@@ -930,14 +1044,14 @@ static void pidApplyCyclicMode3(uint8_t axis, const pidProfile_t * pidProfile)
     const float itermErrorRate = applyItermRelax(axis, errorRate, gyroRate, setpoint);
 
     // Saturation
-    const bool saturation = (pidAxisSaturated(axis) && pid.data[axis].axisError * itermErrorRate > 0);
+    const bool saturation = (pidAxisSaturated(axis) && pid.axis[axis].data.axisError * itermErrorRate > 0);
 
     // I-term change
     const float itermDelta = saturation ? 0 : itermErrorRate * pid.dT;
 
     // Calculate I-component
-    pid.data[axis].axisError = limitf(pid.data[axis].axisError + itermDelta, pid.errorLimit[axis]);
-    pid.data[axis].I = pid.coef[axis].Ki * pid.data[axis].axisError;
+    pid.axis[axis].data.axisError = limitf(pid.axis[axis].data.axisError + itermDelta, pid.axis[axis].errorLimit);
+    pid.axis[axis].data.I = pid.axis[axis].coef.Ki * pid.axis[axis].data.axisError;
 
     // Get actual collective from the mixer
     const float collective = getCollectiveDeflection();
@@ -949,88 +1063,88 @@ static void pidApplyCyclicMode3(uint8_t axis, const pidProfile_t * pidProfile)
     float errorDecayRate, errorDecayLimit;
 
     if (isAirborne() || pid.errorDecayRateGround == 0) {
-      errorDecayRate  = pid.errorDecayRateCyclic * pidTableLookup(curve, pidProfile->error_decay_rate_curve, LOOKUP_CURVE_POINTS) * 0.08f;
-      errorDecayLimit = pid.errorDecayLimitCyclic * pidTableLookup(curve, pidProfile->error_decay_limit_curve, LOOKUP_CURVE_POINTS) * 0.08f;
+      errorDecayRate  = pidCurveLookup(curve, &pid.errorDecayRateCurve);
+      errorDecayLimit = pidCurveLookup(curve, &pid.errorDecayLimitCurve);
     }
     else {
       errorDecayRate  = pid.errorDecayRateGround;
       errorDecayLimit = 3600;
     }
 
-    const float errorDecay = limitf(pid.data[axis].axisError * errorDecayRate, errorDecayLimit);
+    const float errorDecay = limitf(pid.axis[axis].data.axisError * errorDecayRate, errorDecayLimit);
 
-    pid.data[axis].axisError -= errorDecay * pid.dT;
+    pid.axis[axis].data.axisError -= errorDecay * pid.dT;
 
     DEBUG_AXIS(ERROR_DECAY, axis, 0, errorDecayRate * 100);
     DEBUG_AXIS(ERROR_DECAY, axis, 1, errorDecayLimit);
     DEBUG_AXIS(ERROR_DECAY, axis, 2, errorDecay * 100);
-    DEBUG_AXIS(ERROR_DECAY, axis, 3, pid.data[axis].axisError * 10);
+    DEBUG_AXIS(ERROR_DECAY, axis, 3, pid.axis[axis].data.axisError * 10);
 
 
   //// Offset term
 
     // Offset saturation
-    const bool offSaturation = (pidAxisSaturated(axis) && pid.data[axis].axisOffset * itermErrorRate * collective > 0);
+    const bool offSaturation = (pidAxisSaturated(axis) && pid.axis[axis].data.axisOffset * itermErrorRate * collective > 0);
 
     // Offset change modulated by collective
-    const float offMod = copysignf(pidTableLookup(curve, pidProfile->offset_charge_curve, LOOKUP_CURVE_POINTS), collective) / 100.0f;
+    const float offMod = copysignf(pidCurveLookup(curve, &pid.offsetChargeCurve), collective);
     const float offDelta = offSaturation ? 0 : itermErrorRate * pid.dT * offMod;
 
     // Calculate Offset component
-    pid.data[axis].axisOffset = limitf(pid.data[axis].axisOffset + offDelta, pid.offsetLimit[axis]);
-    pid.data[axis].O = pid.coef[axis].Ko * pid.data[axis].axisOffset * collective;
+    pid.axis[axis].data.axisOffset = limitf(pid.axis[axis].data.axisOffset + offDelta, pid.offsetLimit[axis]);
+    pid.axis[axis].data.O = pid.axis[axis].coef.Ko * pid.axis[axis].data.axisOffset * collective;
 
     DEBUG_AXIS(HS_OFFSET, axis, 0, errorRate * 10);
     DEBUG_AXIS(HS_OFFSET, axis, 1, itermErrorRate * 10);
     DEBUG_AXIS(HS_OFFSET, axis, 2, offMod * 1000);
     DEBUG_AXIS(HS_OFFSET, axis, 3, offDelta * 1000000);
-    DEBUG_AXIS(HS_OFFSET, axis, 4, pid.data[axis].axisError * 10);
-    DEBUG_AXIS(HS_OFFSET, axis, 5, pid.data[axis].axisOffset * 10);
-    DEBUG_AXIS(HS_OFFSET, axis, 6, pid.data[axis].O * 1000);
-    DEBUG_AXIS(HS_OFFSET, axis, 7, pid.data[axis].I * 1000);
+    DEBUG_AXIS(HS_OFFSET, axis, 4, pid.axis[axis].data.axisError * 10);
+    DEBUG_AXIS(HS_OFFSET, axis, 5, pid.axis[axis].data.axisOffset * 10);
+    DEBUG_AXIS(HS_OFFSET, axis, 6, pid.axis[axis].data.O * 1000);
+    DEBUG_AXIS(HS_OFFSET, axis, 7, pid.axis[axis].data.I * 1000);
 
     // Apply offset decay
     float offsetDecayRate, offsetDecayLimit;
 
     if (isAirborne() || pid.errorDecayRateGround == 0) {
-      offsetDecayRate  = pidTableLookup(curve, pidProfile->offset_decay_rate_curve, LOOKUP_CURVE_POINTS) * 0.04f;
-      offsetDecayLimit = pidTableLookup(curve, pidProfile->offset_decay_limit_curve, LOOKUP_CURVE_POINTS);
+      offsetDecayRate  = pidCurveLookup(curve, &pid.offsetDecayRateCurve);
+      offsetDecayLimit = pidCurveLookup(curve, &pid.offsetDecayLimitCurve);
     }
     else {
       offsetDecayRate  = pid.errorDecayRateGround;
       offsetDecayLimit = 3600;
     }
 
-    const float offsetDecay = limitf(pid.data[axis].axisOffset * offsetDecayRate, offsetDecayLimit);
+    const float offsetDecay = limitf(pid.axis[axis].data.axisOffset * offsetDecayRate, offsetDecayLimit);
 
-    pid.data[axis].axisOffset -= offsetDecay * pid.dT;
+    pid.axis[axis].data.axisOffset -= offsetDecay * pid.dT;
 
     DEBUG_AXIS(ERROR_DECAY, axis, 4, offsetDecayRate * 100);
     DEBUG_AXIS(ERROR_DECAY, axis, 5, offsetDecayLimit);
     DEBUG_AXIS(ERROR_DECAY, axis, 6, offsetDecay * 100);
-    DEBUG_AXIS(ERROR_DECAY, axis, 7, pid.data[axis].axisOffset * 10);
+    DEBUG_AXIS(ERROR_DECAY, axis, 7, pid.axis[axis].data.axisOffset * 10);
 
 
   //// Feedforward
 
     // Calculate F component
-    pid.data[axis].F = pid.coef[axis].Kf * setpoint;
+    pid.axis[axis].data.F = pid.axis[axis].coef.Kf * setpoint;
 
 
   //// Feedforward Boost (FF Derivative)
 
     // Calculate B-term with bandwidth limit
-    const float bTerm = difFilterApply(&pid.btermFilter[axis], setpoint);
+    const float bTerm = difFilterApply(&pid.axis[axis].btermFilter, setpoint);
 
     // Calculate B-component
-    pid.data[axis].B = pid.coef[axis].Kb * bTerm;
+    pid.axis[axis].data.B = pid.axis[axis].coef.Kb * bTerm;
 
 
   //// PID Sum
 
     // Calculate sum of all terms
-    pid.data[axis].pidSum = pid.data[axis].P + pid.data[axis].I + pid.data[axis].D +
-                            pid.data[axis].F + pid.data[axis].B + pid.data[axis].O;
+    pid.axis[axis].data.pidSum = pid.axis[axis].data.P + pid.axis[axis].data.I + pid.axis[axis].data.D +
+                            pid.axis[axis].data.F + pid.axis[axis].data.B + pid.axis[axis].data.O;
 }
 
 
@@ -1054,7 +1168,7 @@ static void pidApplyYawMode3(void)
   //// P-term
 
     // Calculate P-component
-    pid.data[axis].P = pid.coef[axis].Kp * errorRate * stopGain;
+    pid.axis[axis].data.P = pid.axis[axis].coef.Kp * errorRate * stopGain;
 
 
   //// D-term
@@ -1063,10 +1177,10 @@ static void pidApplyYawMode3(void)
     const float dError = pid.dtermModeYaw ? errorRate : -gyroRate;
 
     // Calculate D-term with bandwidth limit
-    const float dTerm = difFilterApply(&pid.dtermFilter[axis], dError);
+    const float dTerm = difFilterApply(&pid.axis[axis].dtermFilter, dError);
 
     // Calculate D-component
-    pid.data[axis].D = pid.coef[axis].Kd * dTerm;
+    pid.axis[axis].data.D = pid.axis[axis].coef.Kd * dTerm;
 
 
   //// I-term
@@ -1075,14 +1189,14 @@ static void pidApplyYawMode3(void)
     const float itermErrorRate = applyItermRelax(axis, errorRate, gyroRate, setpoint);
 
     // Saturation
-    const bool saturation = (pidAxisSaturated(axis) && pid.data[axis].axisError * itermErrorRate > 0);
+    const bool saturation = (pidAxisSaturated(axis) && pid.axis[axis].data.axisError * itermErrorRate > 0);
 
     // I-term change
     const float itermDelta = saturation ? 0 : itermErrorRate * pid.dT;
 
     // Calculate I-component
-    pid.data[axis].axisError = limitf(pid.data[axis].axisError + itermDelta, pid.errorLimit[axis]);
-    pid.data[axis].I = pid.coef[axis].Ki * pid.data[axis].axisError;
+    pid.axis[axis].data.axisError = limitf(pid.axis[axis].data.axisError + itermDelta, pid.axis[axis].errorLimit);
+    pid.axis[axis].data.I = pid.axis[axis].coef.Ki * pid.axis[axis].data.axisError;
 
     // Apply error decay
     float decayRate, decayLimit, errorDecay;
@@ -1096,38 +1210,74 @@ static void pidApplyYawMode3(void)
       decayLimit = 3600;
     }
 
-    errorDecay = limitf(pid.data[axis].axisError * decayRate, decayLimit);
+    errorDecay = limitf(pid.axis[axis].data.axisError * decayRate, decayLimit);
 
-    pid.data[axis].axisError -= pid.dT * limitf(pid.data[axis].axisError *
+    pid.axis[axis].data.axisError -= pid.dT * limitf(pid.axis[axis].data.axisError *
       (isSpooledUp() ? pid.errorDecayRateYaw : pid.errorDecayRateGround),
       pid.errorDecayLimitYaw);
 
     DEBUG_AXIS(ERROR_DECAY, axis, 0, decayRate * 100);
     DEBUG_AXIS(ERROR_DECAY, axis, 1, decayLimit);
     DEBUG_AXIS(ERROR_DECAY, axis, 2, errorDecay * 100);
-    DEBUG_AXIS(ERROR_DECAY, axis, 3, pid.data[axis].axisError * 10);
+    DEBUG_AXIS(ERROR_DECAY, axis, 3, pid.axis[axis].data.axisError * 10);
 
 
   //// Feedforward
 
     // Calculate F component
-    pid.data[axis].F = pid.coef[axis].Kf * setpoint;
+    pid.axis[axis].data.F = pid.axis[axis].coef.Kf * setpoint;
 
 
   //// Feedforward Boost (FF Derivative)
 
     // Calculate B-term with bandwidth limit
-    const float bTerm = difFilterApply(&pid.btermFilter[axis], setpoint);
+    const float bTerm = difFilterApply(&pid.axis[axis].btermFilter, setpoint);
 
     // Calculate B-component
-    pid.data[axis].B = pid.coef[axis].Kb * bTerm;
+    pid.axis[axis].data.B = pid.axis[axis].coef.Kb * bTerm;
 
 
   //// PID Sum
 
     // Calculate sum of all terms
-    pid.data[axis].pidSum = pid.data[axis].P + pid.data[axis].I + pid.data[axis].D +
-                            pid.data[axis].F + pid.data[axis].B;
+    pid.axis[axis].data.pidSum = pid.axis[axis].data.P + pid.axis[axis].data.I + pid.axis[axis].data.D +
+                            pid.axis[axis].data.F + pid.axis[axis].data.B;
+}
+
+
+/*
+ * Full PID controller for each pid_mode, selected once in pidInitProfile
+ */
+
+static void pidApplyMode0(void)
+{
+    pidApplyAxisMode0(PID_ROLL);
+    pidApplyAxisMode0(PID_PITCH);
+    pidApplyAxisMode0(PID_YAW);
+}
+
+static void pidApplyMode1(void)
+{
+    pidApplyCyclicMode1(PID_ROLL);
+    pidApplyCyclicMode1(PID_PITCH);
+    pidApplyYawMode1();
+}
+
+static void pidApplyMode2(void)
+{
+    pidApplyCyclicMode2(PID_ROLL);
+    pidApplyCyclicMode2(PID_PITCH);
+    pidApplyCyclicCrossCoupling();
+    pidApplyYawMode2();
+}
+
+static void pidApplyMode3(void)
+{
+    pidApplyCyclicMode3(PID_ROLL);
+    pidApplyCyclicMode3(PID_PITCH);
+    pidApplyOffsetBleed();
+    pidApplyCyclicCrossCoupling();
+    pidApplyYawMode3();
 }
 
 
@@ -1139,35 +1289,20 @@ void pidController(const pidProfile_t *pidProfile, timeUs_t currentTimeUs)
     UNUSED(pidProfile);
     UNUSED(currentTimeUs);
 
+    // Scale the gains with the headspeed, once for all axes
+    if (pid.gainScheduling)
+        pidApplyGainSchedule();
+
     // Rotate pitch/roll axis error with yaw rotation
     rotateAxisError();
 
-    // Apply PID for each axis
-    switch (pid.pidMode) {
-        case 3:
-            pidApplyCyclicMode3(PID_ROLL, pidProfile);
-            pidApplyCyclicMode3(PID_PITCH, pidProfile);
-            pidApplyOffsetBleed(pidProfile);
-            pidApplyCyclicCrossCoupling();
-            pidApplyYawMode3();
-            break;
-        case 2:
-            pidApplyCyclicMode2(PID_ROLL);
-            pidApplyCyclicMode2(PID_PITCH);
-            pidApplyCyclicCrossCoupling();
-            pidApplyYawMode2();
-            break;
-        case 1:
-            pidApplyCyclicMode1(PID_ROLL);
-            pidApplyCyclicMode1(PID_PITCH);
-            pidApplyYawMode1();
-            break;
-        default:
-            pidApplyMode0(PID_ROLL);
-            pidApplyMode0(PID_PITCH);
-            pidApplyMode0(PID_YAW);
-            break;
-    }
+#ifdef USE_ACRO_TRAINER
+    // Evaluate the trainer angles for all axes
+    acroTrainerUpdate();
+#endif
+
+    // Apply PID for each axis, as selected in pidInitProfile
+    pid.applyMode();
 
     // Calculate stabilized collective
     pidApplyCollective();
@@ -1178,4 +1313,8 @@ void pidController(const pidProfile_t *pidProfile, timeUs_t currentTimeUs)
     // Reset PID control if gyro overflow detected
     if (gyroOverflowDetected())
         pidReset();
+
+    // Publish the axis data
+    for (int axis = 0; axis < PID_AXIS_COUNT; axis++)
+        pid.data[axis] = pid.axis[axis].data;
 }
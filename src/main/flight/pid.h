@@ -77,6 +77,18 @@ typedef struct {
     float Kc;
 } pidAxisCoef_t;
 
+// Per-axis state of the inner loop, in the order the axis update uses it
+typedef struct {
+    pidAxisData_t data;
+    filter_t gyrorFilter;
+    filter_t errorFilter;
+    pidAxisCoef_t coef;
+    difFilter_t dtermFilter;
+    pt1Filter_t relaxFilter;
+    float errorLimit;
+    difFilter_t btermFilter;
+} pidAxisState_t;
+
 typedef struct {
 
     filter_t collDeflectionFilter;
@@ -91,8 +103,17 @@ typedef struct {
 
     float pitchCollectiveFFGain;
 
+    float gainScale;
+
 } pidPrecomp_t;
 
+typedef void (*pidModeFn)(void);
+
+// Profile curve with the scaling folded in, sampled at uniform steps over 0..1
+typedef struct {
+    float y[LOOKUP_CURVE_POINTS];
+} pidCurve_t;
+
 typedef struct pid_s {
     float dT;
     float freq;
@@ -101,8 +122,13 @@ typedef struct pid_s {
     uint8_t dtermMode;
     uint8_t dtermModeYaw;
 
+    pidModeFn applyMode;
+
+    bool filtersReady;
+
     uint8_t itermRelaxType;
     uint8_t itermRelaxLevel[PID_AXIS_COUNT];
+    bool itermRelax[PID_AXIS_COUNT];
 
     uint8_t errorRotation;
 
@@ -112,6 +138,19 @@ typedef struct pid_s {
     float errorDecayRateYaw;
     float errorDecayLimitYaw;
 
+    pidCurve_t errorDecayRateCurve;
+    pidCurve_t errorDecayLimitCurve;
+    pidCurve_t offsetChargeCurve;
+    pidCurve_t offsetDecayRateCurve;
+    pidCurve_t offsetDecayLimitCurve;
+    pidCurve_t offsetBleedRateCurve;
+    pidCurve_t offsetBleedLimitCurve;
+
+    bool gainScheduling;
+    pidCurve_t pidGainCurve;
+    pidCurve_t precompGainCurve;
+    pidAxisCoef_t coefBase[PID_AXIS_COUNT];
+
     float offsetLimit[XY_AXIS_COUNT];
     float errorLimit[PID_AXIS_COUNT];
 
@@ -124,19 +163,13 @@ typedef struct pid_s {
 
     pidPrecomp_t precomp;
 
-    pidAxisCoef_t coef[PID_ITEM_COUNT];
-    pidAxisData_t data[PID_AXIS_COUNT];
-
-    filter_t gyrorFilter[PID_AXIS_COUNT];
-    filter_t errorFilter[PID_AXIS_COUNT];
-
-    pt1Filter_t relaxFilter[PID_AXIS_COUNT];
-
-    difFilter_t dtermFilter[PID_AXIS_COUNT];
-    difFilter_t btermFilter[PID_AXIS_COUNT];
+    pidAxisState_t axis[PID_AXIS_COUNT];
 
     difFilter_t crossCouplingFilter[XY_AXIS_COUNT];
 
+    // Copy of axis[].data for blackbox and replay, published once per loop
+    pidAxisData_t data[PID_AXIS_COUNT];
+
 } pid_t;
 
 
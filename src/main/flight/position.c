@@ -27,6 +27,9 @@
 
 #include "common/maths.h"
 #include "common/filter.h"
+#include "common/utils.h"
+
+#include "drivers/time.h"
 
 #include "fc/runtime_config.h"
 
@@ -38,11 +41,20 @@
 
 #include "sensors/sensors.h"
 #include "sensors/barometer.h"
+#include "sensors/acceleration.h"
 
 #include "flight/imu.h"
 #include "flight/pid.h"
 #include "flight/position.h"
 
+#define GRAVITY_MSS     9.80665f
+
+// Metres per 1e-7 degree of latitude
+#define GPS_DEGREES_TO_METRES   1.113195e-2f
+
+// Fix gap after which the navigation estimate is dropped
+#define NAV_FIX_TIMEOUT_MS      1000
+
 
 typedef struct {
 
@@ -68,10 +80,46 @@ typedef struct {
     filter_t    gpsOffsetFilter;
     filter_t    baroOffsetFilter;
 
+    // Accelerometer fusion
+    bool        fusion;
+    bool        fusionValid;
+    float       fusionK1;
+    float       fusionK2;
+    float       fusionK3;
+    float       fusionAlt;
+    float       fusionVel;
+    float       fusionBias;
+    float       dT;
+
 } altState_t;
 
 static FAST_DATA altState_t alt;
 
+typedef struct {
+
+    bool        fusion;
+    bool        valid;
+    bool        newFix;
+
+    timeMs_t    fixTime;
+
+    int32_t     homeLat;
+    int32_t     homeLon;
+
+    float       K1;
+    float       K2;
+    float       K3;
+
+    float       pos[2];
+    float       vel[2];
+    float       bias[2];
+
+    float       dT;
+
+} navState_t;
+
+static FAST_DATA_ZERO_INIT navState_t nav;
+
 
 float getAltitude(void)
 {
@@ -93,12 +141,188 @@ int16_t getEstimatedVario(void)
     return lrintf(alt.variometer * 100);
 }
 
+bool positionNavValid(void)
+{
+    return nav.valid;
+}
+
+float getPositionNorth(void)
+{
+    return nav.pos[0];
+}
+
+float getPositionEast(void)
+{
+    return nav.pos[1];
+}
+
+float getVelocityNorth(void)
+{
+    return nav.vel[0];
+}
+
+float getVelocityEast(void)
+{
+    return nav.vel[1];
+}
+
+void positionNewGpsData(void)
+{
+    nav.newFix = true;
+}
+
 
 static float calculateVario(float altitude)
 {
     return difFilterApply(&alt.varioFilter, altitude);
 }
 
+#ifdef USE_ACC
+// Upwards acceleration in the earth frame, gravity removed
+static float getVerticalAcceleration(void)
+{
+    const float accZ =
+        rMat[2][0] * acc.accADC[X] +
+        rMat[2][1] * acc.accADC[Y] +
+        rMat[2][2] * acc.accADC[Z];
+
+    return (accZ * acc.dev.acc_1G_rec - 1.0f) * GRAVITY_MSS;
+}
+
+/*
+ * Third order complementary filter. The acceleration is integrated into
+ * vertical speed and altitude at the PID rate, and the error to the measured
+ * altitude corrects both, and an accelerometer bias. All three poles are
+ * at the fusion cutoff frequency.
+ */
+static void updateFusion(float altitude)
+{
+    if (!alt.fusionValid) {
+        alt.fusionAlt = altitude;
+        alt.fusionVel = 0;
+        alt.fusionBias = 0;
+        alt.fusionValid = true;
+    }
+
+    const float error = altitude - alt.fusionAlt;
+    const float accel = getVerticalAcceleration() - alt.fusionBias;
+
+    alt.fusionBias -= error * alt.fusionK3 * alt.dT;
+    alt.fusionVel += (accel + error * alt.fusionK2) * alt.dT;
+    alt.fusionAlt += (alt.fusionVel + error * alt.fusionK1) * alt.dT;
+}
+#endif
+
+#ifdef USE_GPS
+#ifdef USE_ACC
+// North and east acceleration in the earth frame
+static void getHorizontalAcceleration(float *accel)
+{
+    const float accN =
+        rMat[0][0] * acc.accADC[X] +
+        rMat[0][1] * acc.accADC[Y] +
+        rMat[0][2] * acc.accADC[Z];
+    const float accW =
+        rMat[1][0] * acc.accADC[X] +
+        rMat[1][1] * acc.accADC[Y] +
+        rMat[1][2] * acc.accADC[Z];
+
+    accel[0] = accN * acc.dev.acc_1G_rec * GRAVITY_MSS;
+    accel[1] = -accW * acc.dev.acc_1G_rec * GRAVITY_MSS;
+}
+#endif
+
+static void resetNavigation(const float *pos)
+{
+    const float speed = gpsSol.groundSpeed / 100.0f;
+    const float course = DEGREES_TO_RADIANS(gpsSol.groundCourse / 10.0f);
+
+    nav.pos[0] = pos[0];
+    nav.pos[1] = pos[1];
+    nav.vel[0] = speed * cos_approx(course);
+    nav.vel[1] = speed * sin_approx(course);
+    nav.bias[0] = 0;
+    nav.bias[1] = 0;
+
+    nav.homeLat = GPS_home[GPS_LATITUDE];
+    nav.homeLon = GPS_home[GPS_LONGITUDE];
+
+    nav.valid = true;
+}
+
+/*
+ * Horizontal position in a flat-earth frame at the home point.
+ *
+ * Position and velocity are propagated at the PID rate with the earth
+ * frame acceleration, and corrected on each GPS fix. The correction gains
+ * are those of the altitude fusion, applied once per fix interval, so that
+ * the GPS rescue sees a fresh position between the fixes.
+ */
+static void updateNavigation(void)
+{
+    if (!nav.fusion || !STATE(GPS_FIX_HOME)) {
+        nav.valid = false;
+        nav.newFix = false;
+        return;
+    }
+
+    if (nav.valid) {
+        float accel[2] = { 0, 0 };
+
+#ifdef USE_ACC
+        getHorizontalAcceleration(accel);
+#endif
+
+        for (int axis = 0; axis < 2; axis++) {
+            nav.vel[axis] += (accel[axis] - nav.bias[axis]) * nav.dT;
+            nav.pos[axis] += nav.vel[axis] * nav.dT;
+        }
+    }
+
+    const timeMs_t now = millis();
+
+    if (nav.newFix) {
+        nav.newFix = false;
+
+        if (gpsSol.numSat >= positionConfig()->gps_min_sats) {
+            const float pos[2] = {
+                (gpsSol.llh.lat - GPS_home[GPS_LATITUDE]) * GPS_DEGREES_TO_METRES,
+                (gpsSol.llh.lon - GPS_home[GPS_LONGITUDE]) * GPS_DEGREES_TO_METRES * GPS_scaleLonDown,
+            };
+
+            if (!nav.valid || nav.homeLat != GPS_home[GPS_LATITUDE] ||
+                nav.homeLon != GPS_home[GPS_LONGITUDE] ||
+                cmp32(now, nav.fixTime) > NAV_FIX_TIMEOUT_MS) {
+                resetNavigation(pos);
+            }
+            else {
+                const float dT = cmp32(now, nav.fixTime) / 1000.0f;
+                const float K1 = MIN(nav.K1 * dT, 1.0f);
+                const float K2 = nav.K2 * dT;
+                const float K3 = nav.K3 * dT;
+
+                for (int axis = 0; axis < 2; axis++) {
+                    const float error = pos[axis] - nav.pos[axis];
+                    nav.pos[axis] += error * K1;
+                    nav.vel[axis] += error * K2;
+#ifdef USE_ACC
+                    nav.bias[axis] -= error * K3;
+#else
+                    UNUSED(K3);
+#endif
+                }
+            }
+
+            nav.fixTime = now;
+        }
+    }
+
+    if (cmp32(now, nav.fixTime) > NAV_FIX_TIMEOUT_MS) {
+        nav.valid = false;
+    }
+}
+#endif
+
 void positionUpdate(void)
 {
 #ifdef USE_BARO
@@ -142,6 +366,8 @@ void positionUpdate(void)
         }
     }
 
+    bool haveAlt = true;
+
     if (alt.haveBaroAlt && alt.baroAltOffset) {
         alt.altitude = alt.baroAlt - alt.baroAltOffset;
         alt.variometer = calculateVario(alt.baroAlt);
@@ -153,8 +379,24 @@ void positionUpdate(void)
     else {
         alt.altitude = 0;
         alt.variometer = 0;
+        haveAlt = false;
     }
 
+#ifdef USE_ACC
+    if (alt.fusion && haveAlt) {
+        updateFusion(alt.altitude);
+        alt.altitude = alt.fusionAlt;
+        alt.variometer = alt.fusionVel;
+    }
+    else {
+        alt.fusionValid = false;
+    }
+#endif
+
+#ifdef USE_GPS
+    updateNavigation();
+#endif
+
     DEBUG(ALTITUDE, 0, alt.altitude * 100);
     DEBUG(ALTITUDE, 1, alt.variometer * 100);
     DEBUG(ALTITUDE, 2, alt.baroAlt * 100);
@@ -168,6 +410,30 @@ void positionUpdate(void)
 void INIT_CODE positionInit(void)
 {
     alt.source = positionConfig()->alt_source;
+    alt.dT = pidGetDT();
+
+#ifdef USE_ACC
+    if (positionConfig()->alt_fusion_lpf && sensors(SENSOR_ACC)) {
+        const float omega = M_2PIf * positionConfig()->alt_fusion_lpf / 100.0f;
+
+        alt.fusion = true;
+        alt.fusionK1 = 3 * omega;
+        alt.fusionK2 = 3 * sq(omega);
+        alt.fusionK3 = sq(omega) * omega;
+    }
+#endif
+
+#ifdef USE_GPS
+    if (positionConfig()->nav_fusion_lpf) {
+        const float omega = M_2PIf * positionConfig()->nav_fusion_lpf / 100.0f;
+
+        nav.fusion = true;
+        nav.K1 = 3 * omega;
+        nav.K2 = 3 * sq(omega);
+        nav.K3 = sq(omega) * omega;
+        nav.dT = pidGetDT();
+    }
+#endif
 
     difFilterInit(&alt.varioFilter, positionConfig()->vario_lpf / 100.0f, pidGetPidFrequency());
 
@@ -26,3 +26,12 @@ float getVario(void);
 // compat: integer in cm
 int32_t getEstimatedAltitudeCm(void);
 int16_t getEstimatedVario(void);
+
+// Horizontal position from home, metres north and east
+bool positionNavValid(void);
+float getPositionNorth(void);
+float getPositionEast(void);
+float getVelocityNorth(void);
+float getVelocityEast(void);
+
+void positionNewGpsData(void);
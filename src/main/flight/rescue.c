@@ -36,6 +36,7 @@
 #include "sensors/acceleration.h"
 #include "sensors/barometer.h"
 
+#include "fc/eventlog.h"
 #include "fc/runtime_config.h"
 #include "fc/rc_controls.h"
 
@@ -113,6 +114,8 @@ static inline void rescueChangeState(uint8_t newState)
     rescue.state = newState;
     rescue.stateEntryTime = millis();
 
+    eventLog(EVENT_RESCUE_STATE, newState);
+
     if (newState == RSTATE_CLIMB)
         rescue.alt_Iterm = rescue.hoverCollective;
 }
@@ -167,28 +170,28 @@ static void rescueApplyLimits(void)
     }
 }
 
-static void rescueApplyLeveling(bool allow_inverted)
+// Current tilt in decidegrees, relative to upright or inverted
+static bool rescueGetTilt(bool allow_inverted, float *roll, float *pitch)
 {
     const rollAndPitchTrims_t *trim = &accelerometerConfig()->accelerometerTrims;
+    const bool inverted = allow_inverted && getCosTiltAngle() < 0;
 
-    float rollError = -(attitude.values.roll - trim->values.roll);
-    float pitchError = -(attitude.values.pitch - trim->values.pitch);
+    imuGetTiltAngles(inverted, roll, pitch);
 
-    if (allow_inverted) {
-        if (attitude.values.roll > 900) {
-            pitchError = -pitchError;
-            rollError += 1800;
-        }
-        else if (attitude.values.roll < -900) {
-            pitchError = -pitchError;
-            rollError -= 1800;
-        }
-    }
+    *roll = *roll * 10 - trim->values.roll;
+    *pitch = *pitch * 10 + (inverted ? trim->values.pitch : -trim->values.pitch);
 
-    // Avoid "gimbal lock"
-    if (attitude.values.pitch > 800 || attitude.values.pitch < -800) {
-        rollError = 0;
-    }
+    return inverted;
+}
+
+static void rescueApplyLeveling(bool allow_inverted)
+{
+    float roll, pitch;
+
+    rescueGetTilt(allow_inverted, &roll, &pitch);
+
+    const float rollError = -roll;
+    const float pitchError = -pitch;
 
     rescue.setpoint[FD_PITCH] = pitchError * rescue.flipGain;
     rescue.setpoint[FD_ROLL] = rollError * rescue.flipGain;
@@ -197,28 +200,15 @@ static void rescueApplyLeveling(bool allow_inverted)
 
 static void rescueApplyStabilisation(bool allow_inverted)
 {
-    const rollAndPitchTrims_t *trim = &accelerometerConfig()->accelerometerTrims;
+    float roll, pitch;
 
-    float rollError = getRcDeflection(FD_ROLL) * RESCUE_MAX_DECIANGLE  -
-        (attitude.values.roll - trim->values.roll);
-    float pitchError = getRcDeflection(FD_PITCH) * RESCUE_MAX_DECIANGLE -
-        (attitude.values.pitch - trim->values.pitch);
+    const bool inverted = rescueGetTilt(allow_inverted, &roll, &pitch);
 
-    if (allow_inverted) {
-        if (attitude.values.roll > 900) {
-            pitchError = -pitchError;
-            rollError += 1800;
-        }
-        else if (attitude.values.roll < -900) {
-            pitchError = -pitchError;
-            rollError -= 1800;
-        }
-    }
+    const float rollError = getRcDeflection(FD_ROLL) * RESCUE_MAX_DECIANGLE - roll;
+    float pitchError = getRcDeflection(FD_PITCH) * RESCUE_MAX_DECIANGLE;
 
-    // Avoid "gimbal lock"
-    if (attitude.values.pitch > 800 || attitude.values.pitch < -800) {
-        rollError = 0;
-    }
+    // Stick pitch is mirrored when upside down
+    pitchError = (inverted ? -pitchError : pitchError) - pitch;
 
     rescue.setpoint[FD_PITCH] = pitchError * rescue.levelGain;
     rescue.setpoint[FD_ROLL] = rollError * rescue.levelGain;
@@ -17,6 +17,7 @@
 
 #include <math.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -35,33 +36,151 @@
 #include "scheduler/scheduler.h"
 #include "sensors/esc_sensor.h"
 #include "sensors/gyro.h"
+#include "flight/governor.h"
 #include "flight/mixer.h"
 
 #include "rpm_filter.h"
 
 // Number of banks to update in one cycle
-#define RPM_UPDATE_BANK_COUNT 1
+#define RPM_UPDATE_BANK_COUNT 2
+
+// Relative notch frequency change that triggers a coefficient update
+#define RPM_UPDATE_THRESHOLD  0.002f
+
+// Sin/cos table size over [0,PI]
+#define RPM_SINCOS_TABLE_SIZE 64
+
+// Smoothing of the tracked harmonic amplitudes, per update
+#define RPM_AMPLITUDE_GAIN    0.01f
+
+// Adaptive Q range relative to the configured Q
+#define RPM_ADAPTIVE_Q_MIN    0.5f
+#define RPM_ADAPTIVE_Q_MAX    2.0f
+
+// Hover analysis averages over this many updates, then becomes a running average
+#define RPM_ANALYSIS_MAX_COUNT  100000
 
 typedef struct rpmFilterBank_s
 {
     uint8_t  motor;
+    uint8_t  configIndex;   // Index in rpmFilterConfig
 
     float    ratio;
     float    minHz;
     float    maxHz;
     float    notchQ;
 
-    biquadFilter_t notch[XYZ_AXIS_COUNT];
+    float    notchHz;       // Notch frequency of the current coefficients
+    float    Q;             // Q of the current coefficients
+
+    float    amplitude;     // RMS of the signal removed by the notch
 
 } rpmFilterBank_t;
 
+typedef struct rpmSinCos_s
+{
+    float    sin;
+    float    cos;
+
+} rpmSinCos_t;
+
+/*
+ * Notch states of one bank, stored per axis
+ */
+typedef struct rpmNotchState_s
+{
+    float    x1[XYZ_AXIS_COUNT];
+    float    x2[XYZ_AXIS_COUNT];
+    float    y1[XYZ_AXIS_COUNT];
+    float    y2[XYZ_AXIS_COUNT];
+
+} rpmNotchState_t;
+
+/*
+ * Batched notch engine in struct-of-arrays layout.
+ *
+ * The coefficients are identical on all axes, and for a
+ * normalised notch b2 == b0 and a1 == b1. Thus only three
+ * coefficients are stored per bank.
+ */
+typedef struct rpmNotchEngine_s
+{
+    float    b0[RPM_FILTER_BANK_COUNT];
+    float    b1[RPM_FILTER_BANK_COUNT];
+    float    a2[RPM_FILTER_BANK_COUNT];
+
+    rpmNotchState_t state[RPM_FILTER_BANK_COUNT];
+
+    // Energy removed by each notch since the last update
+    float    energy[RPM_FILTER_BANK_COUNT];
+    uint32_t energyCount;
+
+} rpmNotchEngine_t;
+
+/*
+ * Harmonic amplitudes averaged while spooled up
+ */
+typedef struct rpmAnalysis_s
+{
+    float    amplitude[RPM_FILTER_BANK_COUNT];
+    float    notchHz[RPM_FILTER_BANK_COUNT];
+    uint32_t count;
+
+} rpmAnalysis_t;
 
 FAST_DATA_ZERO_INIT static rpmFilterBank_t filterBank[RPM_FILTER_BANK_COUNT];
+FAST_DATA_ZERO_INIT static rpmNotchEngine_t notchEngine;
+
+static rpmAnalysis_t analysis;
 
 FAST_DATA_ZERO_INIT static uint8_t activeBankCount;
-FAST_DATA_ZERO_INIT static uint8_t updateBankNumber;
+FAST_DATA_ZERO_INIT static float updateRateHz;
+FAST_DATA_ZERO_INIT static bool adaptiveQ;
+
+FAST_DATA_ZERO_INIT static rpmSinCos_t sinCosTable[RPM_SINCOS_TABLE_SIZE + 1];
 
 
+/*
+ * Fast sin/cos on [0,PI]
+ *
+ * The nearest table entry is rotated by the small remaining angle d,
+ * with sin(d) and cos(d) from their Taylor series. With |d| < PI/128
+ * the error is below 1e-7, which keeps the notch accurate also at low
+ * frequencies, where a plain interpolated table falls short.
+ */
+static inline void rpmSinCos(float omega, float *sinom, float *cosom)
+{
+    const float pos = constrainf(omega, 0, M_PIf) * (RPM_SINCOS_TABLE_SIZE / M_PIf);
+    const int index = lrintf(pos);
+
+    const float d = (pos - index) * (M_PIf / RPM_SINCOS_TABLE_SIZE);
+    const float d2 = d * d;
+    const float sind = d - d * d2 / 6;
+    const float cosd = 1 - d2 / 2 + d2 * d2 / 24;
+
+    const rpmSinCos_t *entry = &sinCosTable[index];
+
+    *sinom = entry->sin * cosd + entry->cos * sind;
+    *cosom = entry->cos * cosd - entry->sin * sind;
+}
+
+/*
+ * Normalised notch coefficients, as in biquadFilterUpdate(BIQUAD_NOTCH)
+ */
+static void rpmNotchSetCoefs(int index, float freq, float rate, float Q)
+{
+    float sinom, cosom;
+
+    rpmSinCos(M_2PIf * freq / rate, &sinom, &cosom);
+
+    const float alpha = sinom / (2 * Q);
+    const float a0inv = 1 / (1 + alpha);
+
+    notchEngine.b0[index] = a0inv;
+    notchEngine.b1[index] = -2 * cosom * a0inv;
+    notchEngine.a2[index] = (1 - alpha) * a0inv;
+}
+
 INIT_CODE void rpmFilterInit(void)
 {
     const rpmFilterConfig_t *config = rpmFilterConfig();
@@ -79,6 +198,12 @@ INIT_CODE void rpmFilterInit(void)
 
     #define CHECK_SOURCE(motor) if (!isMotorFastRpmSourceActive(motor)) goto error
 
+    for (int index = 0; index <= RPM_SINCOS_TABLE_SIZE; index++) {
+        const float omega = index * (M_PIf / RPM_SINCOS_TABLE_SIZE);
+        sinCosTable[index].sin = sinf(omega);
+        sinCosTable[index].cos = cosf(omega);
+    }
+
     for (int index = 0; index < RPM_FILTER_BANK_COUNT; index++)
     {
         if (config->filter_bank_rpm_source[index] == 0 ||
@@ -96,6 +221,8 @@ INIT_CODE void rpmFilterInit(void)
 
         rpmFilterBank_t *bank = &filterBank[bankNumber];
 
+        bank->configIndex = index;
+
         // RPM source for this bank
         const unsigned source = config->filter_bank_rpm_source[index];
 
@@ -172,14 +299,23 @@ INIT_CODE void rpmFilterInit(void)
 
     // Set activeBankCount to the number of configured notches
     activeBankCount = bankNumber;
+    adaptiveQ = config->filter_adaptive_q;
 
     // Init all filters @minHz. As soon as the motor is running, the filters are updated to the real RPM.
+    updateRateHz = gyro.filterRateHz;
+
     for (int index = 0; index < activeBankCount; index++) {
         rpmFilterBank_t *bank = &filterBank[index];
-        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-            biquadFilterInit(&bank->notch[axis], bank->minHz, gyro.filterRateHz, bank->notchQ, BIQUAD_NOTCH);
-        }
+        rpmNotchSetCoefs(index, bank->minHz, updateRateHz, bank->notchQ);
+        bank->notchHz = bank->minHz;
+        bank->Q = bank->notchQ;
+        bank->amplitude = 0;
+        memset(&notchEngine.state[index], 0, sizeof(rpmNotchState_t));
+        notchEngine.energy[index] = 0;
     }
+    notchEngine.energyCount = 0;
+
+    rpmFilterResetAnalysis();
 
     return;
 
@@ -189,14 +325,212 @@ error:
     setArmingDisabled(ARMING_DISABLED_RPMFILTER);
 }
 
-FAST_CODE float rpmFilterGyro(int axis, float value)
+FAST_CODE void rpmFilterGyro(float *data)
+{
+    float X = data[0];
+    float Y = data[1];
+    float Z = data[2];
+
+    /*
+     * All banks are applied to all three axes in one pass. The axes
+     * are independent dependency chains sharing the same coefficients,
+     * which lets the FPU pipeline (and dual-issue on M7) overlap them.
+     *
+     *   y = b0 * (x + x2) + b1 * (x1 - y1) - a2 * y2
+     *
+     * Since the notches are locked to the rotor orders, the part removed
+     * by each one (x - y, a band-pass at the notch) tracks the amplitude
+     * of that harmonic without any spectral search.
+     */
+    for (int index = 0; index < activeBankCount; index++) {
+        const float b0 = notchEngine.b0[index];
+        const float b1 = notchEngine.b1[index];
+        const float a2 = notchEngine.a2[index];
+
+        rpmNotchState_t *state = &notchEngine.state[index];
+
+        const float oX = b0 * (X + state->x2[0]) + b1 * (state->x1[0] - state->y1[0]) - a2 * state->y2[0];
+        const float oY = b0 * (Y + state->x2[1]) + b1 * (state->x1[1] - state->y1[1]) - a2 * state->y2[1];
+        const float oZ = b0 * (Z + state->x2[2]) + b1 * (state->x1[2] - state->y1[2]) - a2 * state->y2[2];
+
+        notchEngine.energy[index] += sq(X - oX) + sq(Y - oY) + sq(Z - oZ);
+
+        state->x2[0] = state->x1[0];
+        state->x2[1] = state->x1[1];
+        state->x2[2] = state->x1[2];
+
+        state->x1[0] = X;
+        state->x1[1] = Y;
+        state->x1[2] = Z;
+
+        state->y2[0] = state->y1[0];
+        state->y2[1] = state->y1[1];
+        state->y2[2] = state->y1[2];
+
+        state->y1[0] = X = oX;
+        state->y1[1] = Y = oY;
+        state->y1[2] = Z = oZ;
+    }
+
+    notchEngine.energyCount++;
+
+    data[0] = X;
+    data[1] = Y;
+    data[2] = Z;
+}
+
+/*
+ * Track the harmonic amplitudes and derive the adaptive Q.
+ *
+ * A harmonic stronger than the bank average gets a wider notch (lower Q),
+ * a weaker one a narrower notch with less phase delay.
+ */
+static void rpmFilterUpdateAmplitudes(float *notchQ)
+{
+    const uint32_t count = notchEngine.energyCount;
+
+    float mean = 0;
+
+    for (int index = 0; index < activeBankCount; index++) {
+        rpmFilterBank_t *bank = &filterBank[index];
+
+        if (count > 0) {
+            const float rms = sqrtf(notchEngine.energy[index] / count);
+            bank->amplitude += (rms - bank->amplitude) * RPM_AMPLITUDE_GAIN;
+            notchEngine.energy[index] = 0;
+        }
+
+        mean += bank->amplitude;
+    }
+
+    notchEngine.energyCount = 0;
+    mean /= activeBankCount;
+
+    // Hover analysis: a running average of the amplitudes in flight
+    if (ARMING_FLAG(ARMED) && isSpooledUp()) {
+        if (analysis.count < RPM_ANALYSIS_MAX_COUNT)
+            analysis.count++;
+
+        const float gain = 1.0f / analysis.count;
+
+        for (int index = 0; index < activeBankCount; index++) {
+            const rpmFilterBank_t *bank = &filterBank[index];
+            analysis.amplitude[index] += (bank->amplitude - analysis.amplitude[index]) * gain;
+            analysis.notchHz[index] += (bank->notchHz - analysis.notchHz[index]) * gain;
+        }
+    }
+
+    for (int index = 0; index < activeBankCount; index++) {
+        const rpmFilterBank_t *bank = &filterBank[index];
+
+        if (adaptiveQ && bank->amplitude > 0 && mean > 0) {
+            const float scale = constrainf(sqrtf(mean / bank->amplitude), RPM_ADAPTIVE_Q_MIN, RPM_ADAPTIVE_Q_MAX);
+            notchQ[index] = bank->notchQ * scale;
+        } else {
+            notchQ[index] = bank->notchQ;
+        }
+
+        if (index < 8) {
+            DEBUG(RPM_ORDERS, index, lrintf(bank->amplitude * 100));
+        }
+    }
+}
+
+int rpmFilterGetBankCount(void)
 {
+    return activeBankCount;
+}
+
+float rpmFilterGetBankAmplitude(int bank)
+{
+    return (bank >= 0 && bank < activeBankCount) ? filterBank[bank].amplitude : 0;
+}
+
+void rpmFilterResetAnalysis(void)
+{
+    memset(&analysis, 0, sizeof(analysis));
+}
+
+uint32_t rpmFilterGetAnalysisCount(void)
+{
+    return analysis.count;
+}
+
+/*
+ * Propose the minimal bank set from the hover analysis.
+ *
+ * The energy of each harmonic is its amplitude squared. The banks are
+ * kept strongest first, until they cover targetPercent of the energy
+ * removed by all banks; the rest are not worth their CPU time. The Q of
+ * the kept banks is scaled the same way as the adaptive Q, relative to
+ * the average of the kept banks.
+ *
+ * Returns the number of entries in tune, one per active bank.
+ */
+int rpmFilterGetTuning(uint8_t targetPercent, rpmFilterTuning_t *tune)
+{
+    const rpmFilterConfig_t *config = rpmFilterConfig();
+
+    bool kept[RPM_FILTER_BANK_COUNT] = { false };
+
+    float total = 0;
+
+    for (int index = 0; index < activeBankCount; index++) {
+        total += sq(analysis.amplitude[index]);
+    }
+
+    const float target = total * constrain(targetPercent, 1, 100) / 100;
+
+    float covered = 0;
+    float mean = 0;
+    int keptCount = 0;
+
+    while (keptCount < activeBankCount && (covered < target || keptCount == 0)) {
+        int select = -1;
+
+        for (int index = 0; index < activeBankCount; index++) {
+            if (!kept[index] && (select < 0 || analysis.amplitude[index] > analysis.amplitude[select]))
+                select = index;
+        }
+
+        kept[select] = true;
+        covered += sq(analysis.amplitude[select]);
+        mean += analysis.amplitude[select];
+        keptCount++;
+    }
+
+    mean /= keptCount;
+
     for (int index = 0; index < activeBankCount; index++) {
-        value = biquadFilterApplyDF1(&filterBank[index].notch[axis], value);
+        const rpmFilterBank_t *bank = &filterBank[index];
+        const float amplitude = analysis.amplitude[index];
+
+        tune[index].configIndex = bank->configIndex;
+        tune[index].amplitude = amplitude;
+        tune[index].notchHz = analysis.notchHz[index];
+        tune[index].share = (total > 0) ? sq(amplitude) / total : 0;
+        tune[index].keep = kept[index];
+
+        if (kept[index] && amplitude > 0 && mean > 0) {
+            const float scale = constrainf(sqrtf(mean / amplitude), RPM_ADAPTIVE_Q_MIN, RPM_ADAPTIVE_Q_MAX);
+            tune[index].notchQ = constrain(lrintf(bank->notchQ * scale * 10), 5, 100);
+        } else {
+            tune[index].notchQ = config->filter_bank_notch_q[bank->configIndex];
+        }
     }
-    return value;
+
+    return activeBankCount;
 }
 
+/*
+ * Update the notch coefficients of the banks that have moved the most.
+ *
+ * The cost of a bank is evaluating its target frequency. The coefficients
+ * are recomputed only for the banks whose frequency has changed by more
+ * than RPM_UPDATE_THRESHOLD, largest relative change first. When the RPM
+ * is steady nothing gets recomputed, and during RPM transients the moving
+ * banks are not delayed by the others in a round-robin.
+ */
 void rpmFilterUpdate()
 {
     if (activeBankCount > 0) {
@@ -204,34 +538,30 @@ void rpmFilterUpdate()
         // Actual update rate
         const float updateRate = gyro.filterRateHz * schedulerGetCycleTimeMultiplier();
 
-        // Number of banks to update in one update cycle
-        for (int i = 0; i < RPM_UPDATE_BANK_COUNT; i++) {
+        // All coefficients are invalid if the rate has changed
+        const bool rateChanged = (updateRate != updateRateHz);
+
+        float notchHz[RPM_FILTER_BANK_COUNT];
+        float notchQ[RPM_FILTER_BANK_COUNT];
+        float change[RPM_FILTER_BANK_COUNT];
+
+        updateRateHz = updateRate;
+
+        rpmFilterUpdateAmplitudes(notchQ);
 
-            // Current filter bank
-            rpmFilterBank_t *bank = &filterBank[updateBankNumber];
+        for (int index = 0; index < activeBankCount; index++) {
+            rpmFilterBank_t *bank = &filterBank[index];
 
             // Calculate notch filter center frequency
             const float rpm = getMotorRPMf(bank->motor);
             const float freq = rpm * bank->ratio;
             const float notch = constrainf(freq, bank->minHz, bank->maxHz);
 
-            // Notch filters for Roll,Pitch,Yaw
-            biquadFilter_t *R = &bank->notch[0];
-            biquadFilter_t *P = &bank->notch[1];
-            biquadFilter_t *Y = &bank->notch[2];
-
-            // Update the filter coefficients
-            biquadFilterUpdate(R, notch, updateRate, bank->notchQ, BIQUAD_NOTCH);
-
-            // Transfer the filter coefficients from Roll axis filter into Pitch and Yaw
-            P->b0 = Y->b0 = R->b0;
-            P->b1 = Y->b1 = R->b1;
-            P->b2 = Y->b2 = R->b2;
-            P->a1 = Y->a1 = R->a1;
-            P->a2 = Y->a2 = R->a2;
+            notchHz[index] = notch;
+            change[index] = rateChanged ? 1.0f : fmaxf(fabsf(notch - bank->notchHz) / notch, fabsf(notchQ[index] - bank->Q) / bank->Q);
 
             // Set debug if bank number matches
-            if (updateBankNumber == debugAxis) {
+            if (index == debugAxis) {
                 DEBUG(RPM_FILTER, 0, rpm);
                 DEBUG(RPM_FILTER, 1, freq * 10);
                 DEBUG(RPM_FILTER, 2, notch * 10);
@@ -239,11 +569,41 @@ void rpmFilterUpdate()
                 DEBUG(RPM_FILTER, 4, bank->motor);
                 DEBUG(RPM_FILTER, 5, bank->minHz * 10);
                 DEBUG(RPM_FILTER, 6, bank->maxHz * 10);
-                DEBUG(RPM_FILTER, 7, bank->notchQ * 10);
+                DEBUG(RPM_FILTER, 7, bank->Q * 10);
+            }
+        }
+
+        // Number of banks to update in one update cycle
+        for (int i = 0; i < RPM_UPDATE_BANK_COUNT; i++) {
+            int select = -1;
+            float maxChange = RPM_UPDATE_THRESHOLD;
+
+            for (int index = 0; index < activeBankCount; index++) {
+                if (change[index] > maxChange) {
+                    maxChange = change[index];
+                    select = index;
+                }
             }
 
-            // Next bank
-            updateBankNumber = (updateBankNumber + 1) % activeBankCount;
+            if (select < 0)
+                break;
+
+            rpmFilterBank_t *bank = &filterBank[select];
+
+            // Update the filter coefficients, shared by Roll,Pitch,Yaw
+            rpmNotchSetCoefs(select, notchHz[select], updateRate, notchQ[select]);
+
+            bank->notchHz = notchHz[select];
+            bank->Q = notchQ[select];
+            change[select] = 0;
+        }
+
+        // Banks not reached are refreshed in the next cycles
+        if (rateChanged) {
+            for (int index = 0; index < activeBankCount; index++) {
+                if (change[index] > 0)
+                    filterBank[index].notchHz = 0;
+            }
         }
     }
 }
@@ -20,6 +20,22 @@
 #include "pg/pg.h"
 #include "pg/rpm_filter.h"
 
+typedef struct {
+    uint8_t  configIndex;       // Bank index in rpmFilterConfig
+    bool     keep;              // Needed to reach the target
+    uint8_t  notchQ;            // Proposed filter_bank_notch_q
+    float    amplitude;         // Average hover amplitude
+    float    notchHz;           // Average hover notch frequency
+    float    share;             // Share of the total harmonic energy
+} rpmFilterTuning_t;
+
 void  rpmFilterInit(void);
-float rpmFilterGyro(int axis, float values);
+void  rpmFilterGyro(float *data);
 void  rpmFilterUpdate(void);
+
+int   rpmFilterGetBankCount(void);
+float rpmFilterGetBankAmplitude(int bank);
+
+void  rpmFilterResetAnalysis(void);
+uint32_t rpmFilterGetAnalysisCount(void);
+int   rpmFilterGetTuning(uint8_t targetPercent, rpmFilterTuning_t *tune);
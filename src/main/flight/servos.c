@@ -52,9 +52,16 @@ static FAST_DATA_ZERO_INIT float        servoInput[MAX_SUPPORTED_SERVOS];
 static FAST_DATA_ZERO_INIT float        servoOutput[MAX_SUPPORTED_SERVOS];
 static FAST_DATA_ZERO_INIT float        servoResolution[MAX_SUPPORTED_SERVOS];
 
+static FAST_DATA_ZERO_INIT float        servoPeriod[MAX_SUPPORTED_SERVOS];
+static FAST_DATA_ZERO_INIT float        servoStep[MAX_SUPPORTED_SERVOS];
+
 static FAST_DATA_ZERO_INIT int16_t      servoOverride[MAX_SUPPORTED_SERVOS];
 
 static FAST_DATA_ZERO_INIT timerChannel_t servoChannel[MAX_SUPPORTED_SERVOS];
+static FAST_DATA_ZERO_INIT timCCR_t     servoCcr[MAX_SUPPORTED_SERVOS];
+
+static FAST_DATA_ZERO_INIT uint8_t      servoTimerCount;
+static FAST_DATA_ZERO_INIT TIM_TypeDef *servoTimer[MAX_SUPPORTED_SERVOS];
 
 
 PG_REGISTER_WITH_RESET_FN(servoConfig_t, servoConfig, PG_SERVO_CONFIG, 0);
@@ -119,6 +126,15 @@ void validateAndFixServoConfig(void)
     }
 }
 
+void servoUpdateLimits(uint8_t servo)
+{
+    // Max change per update; 0 disables the speed limit
+    if (servo < MAX_SUPPORTED_SERVOS) {
+        const uint16_t speed = servoParams(servo)->speed;
+        servoStep[servo] = speed ? 1200 * servoPeriod[servo] / speed : 0;
+    }
+}
+
 void servoInit(void)
 {
     const ioTag_t *ioTags = servoConfig()->ioTags;
@@ -130,6 +146,10 @@ void servoInit(void)
     {
         servoOutput[index] = servoParams(index)->mid;
         servoOverride[index] = SERVO_OVERRIDE_OFF;
+
+        // Servo positions are updated in the PID loop
+        servoPeriod[index] = pidGetDT();
+        servoUpdateLimits(index);
     }
 
     for (index = 0; index < MAX_SUPPORTED_SERVOS && ioTags[index]; index++)
@@ -200,6 +220,22 @@ void servoInit(void)
 
         pwmOutConfig(&servoChannel[index], timer[index], timebase, timebase / update_rate, 0, 0);
     }
+
+    // Collect the timers in use
+    for (index = 0; index < servoCount; index++)
+    {
+        for (jndex = 0; jndex < servoTimerCount; jndex++) {
+            if (servoTimer[jndex] == timer[index]->tim)
+                break;
+        }
+        if (jndex == servoTimerCount)
+            servoTimer[servoTimerCount++] = timer[index]->tim;
+    }
+
+    // Align the PWM frames of all servo timers
+    for (index = 0; index < servoTimerCount; index++) {
+        servoTimer[index]->CNT = 0;
+    }
 }
 
 void servoShutdown(void)
@@ -218,9 +254,23 @@ void servoShutdown(void)
 static inline void servoSetOutput(uint8_t index, float pos)
 {
     servoOutput[index] = pos;
+    servoCcr[index] = lrintf(pos * servoResolution[index]);
+}
+
+static inline void servoCommitOutputs(void)
+{
+    // CCRs are preloaded. Holding off the update event while the new values
+    // are written makes all channels of a timer latch them on the same edge.
+    for (int i = 0; i < servoTimerCount; i++)
+        servoTimer[i]->CR1 |= TIM_CR1_UDIS;
+
+    for (int i = 0; i < servoCount; i++) {
+        if (servoChannel[i].ccr)
+            *servoChannel[i].ccr = servoCcr[i];
+    }
 
-    if (servoChannel[index].ccr)
-        *servoChannel[index].ccr = lrintf(pos * servoResolution[index]);
+    for (int i = 0; i < servoTimerCount; i++)
+        servoTimer[i]->CR1 &= ~TIM_CR1_UDIS;
 }
 
 static inline float limitTravel(uint8_t servo, float pos, float min, float max)
@@ -235,18 +285,10 @@ static inline float limitTravel(uint8_t servo, float pos, float min, float max)
     return pos;
 }
 
-static inline float limitSpeed(float old, float new, float speed)
+static inline float limitSpeed(float old, float new, float step)
 {
-    float rate = 1200 * pidGetDT() / speed;
-    float diff = new - old;
-
-    if (diff > rate)
-        new = old + rate;
-    else if (diff < -rate)
-        new = old - rate;
-
-    return new;
- }
+    return constrainf(new, old - step, old + step);
+}
 
  static inline float limitRatio(float old, float new, float ratio)
  {
@@ -273,15 +315,13 @@ void servoUpdate(void)
 
     for (int i = 0; i < servoCount; i++)
     {
-        const servoParam_t *servo = servoParams(i);
-
         if (!ARMING_FLAG(ARMED) && hasServoOverride(i))
             input[i] = servoOverride[i] / 1000.0f;
         else
             input[i] = mixerGetServoOutput(i);
 
-        if (servo->speed && mixerIsCyclicServo(i)) {
-            const float limit = 1200 * pidGetDT() / servo->speed;
+        if (servoStep[i] > 0 && mixerIsCyclicServo(i)) {
+            const float limit = servoStep[i];
             const float speed = fabsf(input[i] - servoInput[i]);
             if (speed > limit)
                 cyclic_ratio = fminf(cyclic_ratio, limit / speed);
@@ -293,11 +333,11 @@ void servoUpdate(void)
         const servoParam_t *servo = servoParams(i);
         float pos = input[i];
 
-        if (servo->speed > 0) {
+        if (servoStep[i] > 0) {
             if (mixerIsCyclicServo(i))
                 pos = limitRatio(servoInput[i], pos, cyclic_ratio);
             else
-                pos = limitSpeed(servoInput[i], pos, servo->speed);
+                pos = limitSpeed(servoInput[i], pos, servoStep[i]);
         }
 
         servoInput[i] = pos;
@@ -317,6 +357,8 @@ void servoUpdate(void)
 
         servoSetOutput(i, pos);
     }
+
+    servoCommitOutputs();
 }
 
 #endif
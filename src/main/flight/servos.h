@@ -69,6 +69,7 @@ PG_DECLARE(servoConfig_t, servoConfig);
 void servoInit(void);
 void servoUpdate(void);
 void servoShutdown(void);
+void servoUpdateLimits(uint8_t servo);
 
 void validateAndFixServoConfig(void);
 
@@ -29,10 +29,13 @@
 #include "config/config.h"
 #include "config/feature.h"
 
+#include "drivers/time.h"
+
 #include "flight/pid.h"
 #include "flight/imu.h"
 #include "flight/position.h"
 #include "flight/governor.h"
+#include "flight/sysid.h"
 
 #include "fc/runtime_config.h"
 #include "fc/rc.h"
@@ -46,6 +49,8 @@
 #define SP_MAX_UP_CUTOFF                   20.0f
 #define SP_MAX_DN_CUTOFF                    0.5f
 
+#define SP_LATENCY_WINDOW                    100
+
 typedef struct
 {
     float deflection[4];
@@ -68,10 +73,35 @@ typedef struct
     uint16_t responseCutoff[4];
     uint16_t activeCutoff[4];
 
+    bool predict;
+    timeUs_t predictFrameTimeUs;
+    float predictCycles;
+
+    float predictBase[4];
+    float predictDelta[4];
+    float predictRate[4];
+    float predictCount[4];
+
 } setpointData_t;
 
 static FAST_DATA_ZERO_INIT setpointData_t sp;
 
+typedef struct
+{
+    timeUs_t frameTimeUs;
+
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    float sum;
+    float sumSq;
+
+    setpointLatency_t stats;
+
+} setpointLatencyData_t;
+
+static FAST_DATA_ZERO_INIT setpointLatencyData_t lat;
+
 
 float getSetpoint(int axis)
 {
@@ -83,6 +113,11 @@ float getDeflection(int axis)
     return sp.deflection[axis];
 }
 
+const setpointLatency_t *getSetpointLatency(void)
+{
+    return &lat.stats;
+}
+
 
 static float setpointAutoSmoothingCutoff(float frameTimeUs)
 {
@@ -108,6 +143,9 @@ void setpointUpdateTiming(float frameTimeUs)
         }
     }
 
+    // PID cycles in one frame period, the prediction horizon
+    sp.predictCycles = constrainf(frameTimeUs * 1e-6f * pidGetPidFrequency(), 1, 1000);
+
     DEBUG(SETPOINT, 7, frameTimeUs);
 }
 
@@ -127,6 +165,9 @@ INIT_CODE void setpointInit(void)
 {
     sp.smoothingFactor = 25e6f / constrain(rcControlsConfig()->rc_smoothness, 1, 250);
 
+    sp.predict = (rcControlsConfig()->rc_smoothing_mode == RC_SMOOTHING_PREDICT);
+    sp.predictCycles = 1;
+
     sp.maxGainUp = pt1FilterGain(SP_MAX_UP_CUTOFF, pidGetPidFrequency());
     sp.maxGainDown = pt1FilterGain(SP_MAX_DN_CUTOFF, pidGetPidFrequency());
 
@@ -139,12 +180,84 @@ INIT_CODE void setpointInit(void)
     }
 }
 
+static void setpointUpdateLatency(void)
+{
+    const timeUs_t frameTimeUs = getRcCommandTimeUs();
+
+    // Sample once per new RX frame reaching the setpoint
+    if (frameTimeUs != lat.frameTimeUs) {
+        const uint32_t latencyUs = MAX(cmpTimeUs(micros(), frameTimeUs), 0);
+
+        lat.frameTimeUs = frameTimeUs;
+
+        if (lat.count == 0) {
+            lat.min = lat.max = latencyUs;
+            lat.sum = lat.sumSq = 0;
+        } else {
+            lat.min = MIN(lat.min, latencyUs);
+            lat.max = MAX(lat.max, latencyUs);
+        }
+
+        lat.sum += latencyUs;
+        lat.sumSq += sq((float)latencyUs);
+
+        if (++lat.count >= SP_LATENCY_WINDOW) {
+            const float avg = lat.sum / lat.count;
+            const float var = lat.sumSq / lat.count - sq(avg);
+
+            lat.stats.min = MIN(lat.min, (uint32_t)UINT16_MAX);
+            lat.stats.max = MIN(lat.max, (uint32_t)UINT16_MAX);
+            lat.stats.avg = MIN(lrintf(avg), UINT16_MAX);
+            lat.stats.jitter = MIN(lrintf(sqrtf(MAX(var, 0.0f))), UINT16_MAX);
+            lat.count = 0;
+        }
+    }
+}
+
+/*
+ * Extrapolate the deflection from the last two RX frames for one frame
+ * period at the PID rate. A reversal is not extrapolated, and the output
+ * drops back to the last frame value if no change arrives within a frame
+ * period. Frames repeating the same value within the measured cadence
+ * (see currentMult in rc.c) don't reset the prediction.
+ */
+static float setpointPredict(int axis, float deflection, bool newFrame)
+{
+    if (deflection != sp.predictBase[axis]) {
+        const float delta = deflection - sp.predictBase[axis];
+        sp.predictRate[axis] = (delta * sp.predictDelta[axis] > 0) ? delta / sp.predictCycles : 0;
+        sp.predictDelta[axis] = delta;
+        sp.predictBase[axis] = deflection;
+        sp.predictCount[axis] = 0;
+    }
+    else if (newFrame && sp.predictCount[axis] >= sp.predictCycles) {
+        sp.predictRate[axis] = 0;
+        sp.predictDelta[axis] = 0;
+    }
+
+    if (sp.predictCount[axis] < sp.predictCycles)
+        sp.predictCount[axis]++;
+
+    return limitf(sp.predictBase[axis] + sp.predictRate[axis] * sp.predictCount[axis], 1.0f);
+}
+
 void setpointUpdate(void)
 {
+    setpointUpdateLatency();
+
+    sysidUpdate();
+
+    const timeUs_t frameTimeUs = getRcCommandTimeUs();
+    const bool newFrame = (frameTimeUs != sp.predictFrameTimeUs);
+    sp.predictFrameTimeUs = frameTimeUs;
+
     for (int axis = 0; axis < 4; axis++) {
         float deflection, delta;
 
-        deflection = sp.deflection[axis] = getRcDeflection(axis);
+        deflection = getRcDeflection(axis);
+        if (sp.predict)
+            deflection = setpointPredict(axis, deflection, newFrame);
+        sp.deflection[axis] = deflection;
         DEBUG_AXIS(SETPOINT, axis, 0, deflection * 1000);
 
         delta = sq(deflection)- sp.maximum[axis];
@@ -184,10 +297,12 @@ void setpointUpdate(void)
         SP = sp.limited[axis] = slewLimit(sp.limited[axis], SP, sp.accelLimit[axis]);
         DEBUG_AXIS(SETPOINT, axis, 2, SP * 1000);
 
-        SP = sp.deflection[axis] = filterApply(&sp.filter[axis], SP);
+        if (!sp.predict)
+            SP = filterApply(&sp.filter[axis], SP);
+        sp.deflection[axis] = SP;
         DEBUG_AXIS(SETPOINT, axis, 3, SP * 1000);
 
-        SP = sp.setpoint[axis] = applyRatesCurve(axis, SP);
+        SP = sp.setpoint[axis] = sysidApply(axis, applyRatesCurve(axis, SP));
         DEBUG_AXIS(SETPOINT, axis, 4, SP);
     }
 }
@@ -25,6 +25,13 @@
 #include "pg/pid.h"
 
 
+typedef struct {
+    uint16_t min;               // RX frame to setpoint latency in us
+    uint16_t avg;
+    uint16_t max;
+    uint16_t jitter;            // standard deviation in us
+} setpointLatency_t;
+
 float getSetpoint(int axis);
 float getDeflection(int axis);
 
@@ -35,6 +42,8 @@ void setpointUpdateTiming(float frameTimeUs);
 
 void setpointUpdate(void);
 
+const setpointLatency_t *getSetpointLatency(void);
+
 bool isHandsOn(void);
 bool isAirborne(void);
 
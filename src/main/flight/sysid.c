@@ -0,0 +1,231 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * System identification excitation
+ *
+ * With the SYSTEM ID mode switched on while spooled up, a known signal is
+ * added to the rate setpoint of each selected axis in turn, for
+ * sysid_duration on every axis:
+ *
+ *   CHIRP   Exponential sine sweep from sysid_min_freq to sysid_max_freq,
+ *           with equal time in every octave
+ *
+ *   PRBS    Maximum length 11-bit pseudo random binary sequence, clocked
+ *           at 2.5 x sysid_max_freq for a flat spectrum up to max_freq
+ *
+ * The sum goes into the logged setpoint, and each axis start is logged
+ * with its exact time, so the input and the gyro/PID/mixer response can
+ * be taken from a full rate blackbox log (blackbox_trigger_sysid).
+ *
+ * The signal is advanced once per PID loop. Turning the switch off, or
+ * dropping out of the spooled up state, stops the excitation at once.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "platform.h"
+
+#ifdef USE_SYSID
+
+#include "common/maths.h"
+
+#include "drivers/time.h"
+
+#include "fc/rc_modes.h"
+#include "fc/runtime_config.h"
+
+#include "flight/governor.h"
+#include "flight/pid.h"
+#include "flight/sysid.h"
+
+#include "pg/sysid.h"
+
+// PRBS clock relative to the highest frequency of interest
+#define SYSID_PRBS_CLOCK_RATIO      2.5f
+
+// PRBS generator seed, any non-zero 11-bit value
+#define SYSID_PRBS_SEED             0x5A5
+
+typedef struct {
+    sysidStatus_t   status;
+
+    bool            request;
+
+    uint8_t         axes;
+    float           amplitude;
+    float           duration;
+    float           elapsed;
+
+    // Chirp
+    float           minFreq;
+    float           freq;
+    float           freqGain;
+    float           phase;
+
+    // PRBS
+    uint16_t        lfsr;
+    float           bitPeriod;
+    float           bitTime;
+
+    float           excitation;
+
+} sysidData_t;
+
+static FAST_DATA_ZERO_INIT sysidData_t sysid;
+
+
+static void sysidStartAxis(uint8_t axis)
+{
+    sysid.status.axis = axis;
+    sysid.status.state = SYSID_STATE_RUNNING;
+    sysid.status.startTimeUs = micros();
+
+    sysid.elapsed = 0;
+    sysid.freq = sysid.minFreq;
+    sysid.phase = 0;
+    sysid.lfsr = SYSID_PRBS_SEED;
+    sysid.bitTime = 0;
+    sysid.excitation = 0;
+}
+
+// Next selected axis after the given one, or -1
+static int sysidNextAxis(int axis)
+{
+    for (axis++; axis < XYZ_AXIS_COUNT; axis++) {
+        if (sysid.axes & BIT(axis))
+            return axis;
+    }
+
+    return -1;
+}
+
+static void sysidStop(uint8_t state)
+{
+    sysid.status.state = state;
+    sysid.excitation = 0;
+}
+
+static void sysidStart(void)
+{
+    const sysidConfig_t *config = sysidConfig();
+
+    const float dT = pidGetDT();
+    const float nyquist = 0.5f / dT;
+
+    const float minFreq = constrainf(config->min_freq / 10.0f, 0.1f, nyquist);
+    const float maxFreq = constrainf(config->max_freq / 10.0f, minFreq, nyquist);
+
+    sysid.status.signal = config->signal;
+
+    sysid.axes = config->axes;
+    sysid.amplitude = config->amplitude;
+    sysid.duration = fmaxf(config->duration / 10.0f, 1.0f);
+
+    sysid.minFreq = minFreq;
+    sysid.freqGain = powf(maxFreq / minFreq, dT / sysid.duration);
+
+    sysid.bitPeriod = 1.0f / fminf(maxFreq * SYSID_PRBS_CLOCK_RATIO, nyquist * 2);
+
+    const int axis = sysidNextAxis(-1);
+
+    if (axis < 0)
+        sysidStop(SYSID_STATE_ABORTED);
+    else
+        sysidStartAxis(axis);
+}
+
+static float sysidChirp(float dT)
+{
+    const float value = sin_approx(sysid.phase);
+
+    sysid.phase += M_2PIf * sysid.freq * dT;
+    if (sysid.phase >= M_PIf)
+        sysid.phase -= M_2PIf;
+
+    sysid.freq *= sysid.freqGain;
+
+    return value;
+}
+
+static float sysidPRBS(float dT)
+{
+    // x^11 + x^9 + 1
+    if (sysid.bitTime <= 0) {
+        const uint16_t bit = ((sysid.lfsr >> 10) ^ (sysid.lfsr >> 8)) & 1;
+        sysid.lfsr = ((sysid.lfsr << 1) | bit) & 0x7ff;
+        sysid.bitTime += sysid.bitPeriod;
+    }
+
+    sysid.bitTime -= dT;
+
+    return (sysid.lfsr & 1) ? 1.0f : -1.0f;
+}
+
+void sysidUpdate(void)
+{
+    const bool request = ARMING_FLAG(ARMED) && isSpooledUp() && IS_RC_MODE_ACTIVE(BOXSYSID);
+
+    if (request && !sysid.request) {
+        sysidStart();
+    }
+    else if (!request && sysid.status.state == SYSID_STATE_RUNNING) {
+        sysidStop(SYSID_STATE_ABORTED);
+    }
+
+    sysid.request = request;
+
+    if (sysid.status.state == SYSID_STATE_RUNNING) {
+        const float dT = pidGetDT();
+
+        if (sysid.elapsed >= sysid.duration) {
+            const int axis = sysidNextAxis(sysid.status.axis);
+            if (axis < 0) {
+                sysidStop(SYSID_STATE_DONE);
+                return;
+            }
+            sysidStartAxis(axis);
+        }
+
+        const float value = (sysid.status.signal == SYSID_SIGNAL_PRBS) ? sysidPRBS(dT) : sysidChirp(dT);
+
+        sysid.excitation = sysid.amplitude * value;
+        sysid.elapsed += dT;
+    }
+}
+
+float sysidApply(uint8_t axis, float setpoint)
+{
+    if (sysid.status.state == SYSID_STATE_RUNNING && axis == sysid.status.axis)
+        setpoint += sysid.excitation;
+
+    return setpoint;
+}
+
+bool sysidIsActive(void)
+{
+    return sysid.status.state == SYSID_STATE_RUNNING;
+}
+
+const sysidStatus_t *sysidGetStatus(void)
+{
+    return &sysid.status;
+}
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/time.h"
+
+#include "pg/sysid.h"
+
+typedef enum {
+    SYSID_STATE_OFF = 0,
+    SYSID_STATE_RUNNING,
+    SYSID_STATE_DONE,
+    SYSID_STATE_ABORTED,
+} sysidState_e;
+
+typedef struct {
+    uint8_t     state;          // sysidState_e
+    uint8_t     axis;           // Axis being excited
+    uint8_t     signal;         // sysidSignal_e
+    timeUs_t    startTimeUs;    // First excitation sample on this axis
+} sysidStatus_t;
+
+#ifdef USE_SYSID
+
+void sysidUpdate(void);
+float sysidApply(uint8_t axis, float setpoint);
+
+bool sysidIsActive(void);
+const sysidStatus_t *sysidGetStatus(void);
+
+#else
+
+static inline void sysidUpdate(void) { }
+static inline float sysidApply(uint8_t axis, float setpoint) { (void)axis; return setpoint; }
+
+#endif
@@ -55,6 +55,9 @@ typedef struct {
     float       Gain;
     float       AngleLimit;
     float       LookaheadTime;
+    float       LookaheadScale;
+    float       CurrentAngle[2];
+    float       ProjectedAngle[2];
     sign_t      AxisState[2];
 } acroTrainer_t;
 
@@ -66,6 +69,7 @@ INIT_CODE void acroTrainerInit(const pidProfile_t *pidProfile)
     acroTrainer.Gain = pidProfile->trainer.gain / 10.0f;
     acroTrainer.AngleLimit = pidProfile->trainer.angle_limit;
     acroTrainer.LookaheadTime = pidProfile->trainer.lookahead_ms / 1000.0f;
+    acroTrainer.LookaheadScale = acroTrainer.LookaheadTime / ACRO_TRAINER_LOOKAHEAD_RATE_LIMIT;
 }
 
 void acroTrainerReset(void)
@@ -87,6 +91,29 @@ static inline sign_t Sign(float x)
     return (x > 0) ? 1 : -1;
 }
 
+//
+// Current and projected roll/pitch angles, evaluated once per PID cycle
+//
+// The projection uses a sliding window based on gyro rate (faster rotation
+// means larger window), scaling proportionally with gyro rate from 0-500dps.
+//
+
+void acroTrainerUpdate(void)
+{
+    if (acroTrainer.Active) {
+        const rollAndPitchTrims_t *angleTrim = &accelerometerConfig()->accelerometerTrims;
+
+        for (int axis = FD_ROLL; axis <= FD_PITCH; axis++) {
+            const float gyroRate = gyro.gyroADCf[axis];
+            const float checkInterval = fminf(fabsf(gyroRate) * acroTrainer.LookaheadScale, acroTrainer.LookaheadTime);
+            const float currentAngle = (attitude.raw[axis] - angleTrim->raw[axis]) / 10.0f;
+
+            acroTrainer.CurrentAngle[axis] = currentAngle;
+            acroTrainer.ProjectedAngle[axis] = gyroRate * checkInterval + currentAngle;
+        }
+    }
+}
+
 //
 // Acro Trainer - Manipulate the setPoint to limit axis angle while in acro mode
 //
@@ -103,8 +130,7 @@ float acroTrainerApply(int axis, float setPoint)
 {
     if (acroTrainer.Active && (axis == FD_ROLL || axis == FD_PITCH))
     {
-        const rollAndPitchTrims_t *angleTrim = &accelerometerConfig()->accelerometerTrims;
-        const float currentAngle = (attitude.raw[axis] - angleTrim->raw[axis]) / 10.0f;
+        const float currentAngle = acroTrainer.CurrentAngle[axis];
         const sign_t angleSign = Sign(currentAngle);
         const sign_t setpointSign = Sign(setPoint);
         float projectedAngle = 0;
@@ -127,12 +153,9 @@ float acroTrainerApply(int axis, float setPoint)
             setPoint = limitf((acroTrainer.AngleLimit * angleSign - currentAngle) * acroTrainer.Gain, ACRO_TRAINER_SETPOINT_LIMIT);
         }
         else {
-            // Not currently over the limit so project the angle based on current angle and
-            // gyro angular rate using a sliding window based on gyro rate (faster rotation means larger window.
+            // Not currently over the limit so use the projected angle.
             // If the projected angle exceeds the limit then apply limiting to minimize overshoot.
-            // Calculate the lookahead window by scaling proportionally with gyro rate from 0-500dps
-            float checkInterval = constrainf(fabsf(gyro.gyroADCf[axis]) / ACRO_TRAINER_LOOKAHEAD_RATE_LIMIT, 0.0f, 1.0f) * acroTrainer.LookaheadTime;
-            projectedAngle = (gyro.gyroADCf[axis] * checkInterval) + currentAngle;
+            projectedAngle = acroTrainer.ProjectedAngle[axis];
 
             const sign_t projectedAngleSign = Sign(projectedAngle);
             if ((fabsf(projectedAngle) > acroTrainer.AngleLimit) && (projectedAngleSign == setpointSign)) {
@@ -32,4 +32,5 @@ void acroTrainerInit(const pidProfile_t *pidProfile);
 void acroTrainerReset(void);
 void acroTrainerSetState(bool state);
 
+void acroTrainerUpdate(void);
 float acroTrainerApply(int axis, float setPoint);
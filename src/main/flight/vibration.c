@@ -0,0 +1,150 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "platform.h"
+
+#ifdef USE_VIBRATION_ANALYSIS
+
+#include "common/maths.h"
+#include "common/sdft.h"
+#include "common/utils.h"
+
+#include "sensors/acceleration.h"
+
+#include "flight/motors.h"
+#include "flight/vibration.h"
+
+/*
+ * Accelerometer vibration analysis for the bench and the OSD.
+ *
+ * The acc samples are averaged down to VIBRATION_SAMPLE_RATE_HZ and fed
+ * into a SDFT per axis, in batches spread over the acc updates. The
+ * spectrum is read in a low priority task, giving the amplitude at the
+ * main and tail rotor 1/rev from the Hann windowed spectrum, and the
+ * broadband RMS from the raw spectrum (Parseval, DC excluded).
+ */
+
+typedef struct {
+    int         sampleCount;
+    int         sampleIndex;
+    float       sampleCountRcp;
+    float       resolutionHz;
+    float       sampleAccum[XYZ_AXIS_COUNT];
+    float       sampleAvg[XYZ_AXIS_COUNT];
+    sdft_t      sdft[XYZ_AXIS_COUNT];
+} vibrationState_t;
+
+static vibrationState_t vib;
+
+static vibration_t vibration;
+
+
+const vibration_t *vibrationGetData(void)
+{
+    return &vibration;
+}
+
+void vibrationPush(const float *accADC)
+{
+    if (vib.sampleCount) {
+        if (vib.sampleIndex == vib.sampleCount) {
+            vib.sampleIndex = 0;
+            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+                vib.sampleAvg[axis] = vib.sampleAccum[axis] * vib.sampleCountRcp;
+                vib.sampleAccum[axis] = 0;
+            }
+        }
+
+        sdftPushBatchXYZ(vib.sdft, vib.sampleAvg, vib.sampleIndex);
+
+        vib.sampleIndex++;
+
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            vib.sampleAccum[axis] += accADC[axis];
+        }
+    }
+}
+
+// Amplitude at a frequency, the larger of the two bins around it
+static float orderAmplitude(const float *spectrum, float freq)
+{
+    const float bin = freq / vib.resolutionHz;
+
+    if (bin < 1 || bin > SDFT_BIN_COUNT - 1) {
+        return 0;
+    }
+
+    const int index = bin;
+    const int next = MIN(index + 1, SDFT_BIN_COUNT - 1);
+
+    return sqrtf(fmaxf(spectrum[index], spectrum[next]));
+}
+
+void vibrationUpdate(timeUs_t currentTimeUs)
+{
+    UNUSED(currentTimeUs);
+
+    if (!vib.sampleCount) {
+        return;
+    }
+
+    float spectrum[SDFT_BIN_COUNT];
+
+    // Sinusoid of amplitude A shows as A·N/2 in both spectra
+    const float scale = 2000.0f * acc.dev.acc_1G_rec / SDFT_SAMPLE_SIZE;
+
+    const float mainFreq = getHeadSpeed() / 60.0f;
+    const float tailFreq = getTailSpeed() / 60.0f;
+
+    vibration.mainFreq = lrintf(mainFreq * 10);
+    vibration.tailFreq = lrintf(tailFreq * 10);
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        sdftWinSq(&vib.sdft[axis], spectrum);
+
+        vibration.mainRotor[axis] = MIN(lrintf(orderAmplitude(spectrum, mainFreq) * scale), UINT16_MAX);
+        vibration.tailRotor[axis] = MIN(lrintf(orderAmplitude(spectrum, tailFreq) * scale), UINT16_MAX);
+
+        sdftMagSq(&vib.sdft[axis], spectrum);
+
+        float power = 0;
+        for (int bin = 1; bin < SDFT_BIN_COUNT; bin++) {
+            power += spectrum[bin];
+        }
+
+        vibration.rms[axis] = MIN(lrintf(sqrtf(power / 2) * scale), UINT16_MAX);
+    }
+}
+
+void vibrationInit(void)
+{
+    if (acc.sampleRateHz) {
+        vib.sampleCount = MAX(acc.sampleRateHz / VIBRATION_SAMPLE_RATE_HZ, 1);
+        vib.sampleCountRcp = 1.0f / vib.sampleCount;
+        vib.resolutionHz = (float)acc.sampleRateHz / vib.sampleCount / SDFT_SAMPLE_SIZE;
+
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            sdftInit(&vib.sdft[axis], 1, SDFT_BIN_COUNT - 1, vib.sampleCount);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,39 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "common/axis.h"
+#include "common/time.h"
+
+#define VIBRATION_SAMPLE_RATE_HZ    500
+
+typedef struct {
+    uint16_t    mainFreq;                       // Main rotor 1/rev in 0.1Hz
+    uint16_t    tailFreq;                       // Tail rotor 1/rev in 0.1Hz
+    uint16_t    mainRotor[XYZ_AXIS_COUNT];      // Main rotor 1/rev amplitude in mG
+    uint16_t    tailRotor[XYZ_AXIS_COUNT];      // Tail rotor 1/rev amplitude in mG
+    uint16_t    rms[XYZ_AXIS_COUNT];            // Broadband RMS in mG
+} vibration_t;
+
+void vibrationInit(void);
+void vibrationPush(const float *accADC);
+void vibrationUpdate(timeUs_t currentTimeUs);
+
+const vibration_t *vibrationGetData(void);
@@ -31,6 +31,11 @@
  * to allocate a file on disk, we can carve it out of the freefile, and know that the clusters will be contiguous
  * without needing to read the FAT at all (the freefile's FAT is completely determined from its start cluster and file
  * size, which we get from the directory entry). This allows for extremely fast append-only logging.
+ *
+ * A file opened in contiguous mode grows one super cluster at a time, so the FAT and the two directory entries (the
+ * freefile's first, so a crash can't cross-link the two files) are only rewritten once per super cluster rather than
+ * once per cluster. The data sectors of the new super cluster are pre-erased, and the cache flush continues a
+ * multi-block write whenever the next sector is dirty, so the data is streamed to the card sequentially.
  */
 
 #include <stdint.h>
@@ -60,7 +65,17 @@
     #define ONLY_EXPOSE_FOR_TESTING static
 #endif
 
+/*
+ * Number of 512 byte sectors in the cache. Targets can override this to
+ * give the SD card more room to absorb write latency spikes.
+ */
+#ifndef AFATFS_NUM_CACHE_SECTORS
+#ifdef STM32H7
+#define AFATFS_NUM_CACHE_SECTORS 16
+#else
 #define AFATFS_NUM_CACHE_SECTORS 11
+#endif
+#endif
 
 // FAT filesystems are allowed to differ from these parameters, but we choose not to support those weird filesystems:
 #define AFATFS_SECTOR_SIZE  512
@@ -468,6 +483,7 @@ typedef struct afatfs_t {
 
     int cacheDirtyEntries; // The number of cache entries in the AFATFS_CACHE_STATE_DIRTY state
     bool cacheFlushInProgress;
+    uint32_t cacheFlushNextSector; // The sector that would continue the last multi-block write
 
     afatfsFile_t openFiles[AFATFS_MAX_OPEN_FILES];
 
@@ -703,6 +719,37 @@ static void afatfs_sdcardWriteComplete(sdcardBlockOperation_e operation, uint32_
     }
 }
 
+static bool afatfs_cacheSectorIsFlushable(const afatfsCacheBlockDescriptor_t *descriptor)
+{
+    return descriptor->state == AFATFS_CACHE_STATE_DIRTY && !descriptor->locked;
+}
+
+#ifdef AFATFS_MIN_MULTIPLE_BLOCK_WRITE_COUNT
+/**
+ * Count the flushable sectors in the cache that are consecutive on disk, starting with the given sector.
+ */
+static uint32_t afatfs_cacheDirtyRunLength(uint32_t sectorIndex)
+{
+    uint32_t runLength = 0;
+    bool found;
+
+    do {
+        found = false;
+        for (int i = 0; i < AFATFS_NUM_CACHE_SECTORS; i++) {
+            if (afatfs.cacheDescriptor[i].sectorIndex == sectorIndex + runLength
+                && afatfs_cacheSectorIsFlushable(&afatfs.cacheDescriptor[i])
+            ) {
+                found = true;
+                runLength++;
+                break;
+            }
+        }
+    } while (found && runLength < AFATFS_NUM_CACHE_SECTORS);
+
+    return runLength;
+}
+#endif
+
 /**
  * Attempt to flush the dirty cache entry with the given index to the SDcard.
  */
@@ -713,6 +760,13 @@ static void afatfs_cacheFlushSector(int cacheIndex)
 #ifdef AFATFS_MIN_MULTIPLE_BLOCK_WRITE_COUNT
     if (cacheDescriptor->consecutiveEraseBlockCount) {
         sdcard_beginWriteBlocks(cacheDescriptor->sectorIndex, cacheDescriptor->consecutiveEraseBlockCount);
+    } else if (cacheDescriptor->sectorIndex != afatfs.cacheFlushNextSector) {
+        // Coalesce a run of dirty sectors that follow this one into a single multi-block write
+        const uint32_t runLength = afatfs_cacheDirtyRunLength(cacheDescriptor->sectorIndex);
+
+        if (runLength > 1) {
+            sdcard_beginWriteBlocks(cacheDescriptor->sectorIndex, runLength);
+        }
     }
 #endif
 
@@ -722,12 +776,14 @@ static void afatfs_cacheFlushSector(int cacheIndex)
             afatfs.cacheDirtyEntries--;
             cacheDescriptor->state = AFATFS_CACHE_STATE_WRITING;
             afatfs.cacheFlushInProgress = true;
+            afatfs.cacheFlushNextSector = cacheDescriptor->sectorIndex + 1;
             break;
 
         case SDCARD_OPERATION_SUCCESS:
             // Buffer is already transmitted
             afatfs.cacheDirtyEntries--;
             cacheDescriptor->state = AFATFS_CACHE_STATE_IN_SYNC;
+            afatfs.cacheFlushNextSector = cacheDescriptor->sectorIndex + 1;
             break;
 
         case SDCARD_OPERATION_BUSY:
@@ -852,16 +908,20 @@ static int afatfs_allocateCacheSector(uint32_t sectorIndex)
 bool afatfs_flush(void)
 {
     if (afatfs.cacheDirtyEntries > 0) {
-        // Flush the oldest flushable sector
+        // Continue a multi-block write if possible, otherwise flush the oldest flushable sector
         uint32_t earliestSectorTime = 0xFFFFFFFF;
         int earliestSectorIndex = -1;
 
         for (int i = 0; i < AFATFS_NUM_CACHE_SECTORS; i++) {
-            if (afatfs.cacheDescriptor[i].state == AFATFS_CACHE_STATE_DIRTY && !afatfs.cacheDescriptor[i].locked
-                && (earliestSectorIndex == -1 || afatfs.cacheDescriptor[i].writeTimestamp < earliestSectorTime)
-            ) {
-                earliestSectorIndex = i;
-                earliestSectorTime = afatfs.cacheDescriptor[i].writeTimestamp;
+            if (afatfs_cacheSectorIsFlushable(&afatfs.cacheDescriptor[i])) {
+                if (afatfs.cacheDescriptor[i].sectorIndex == afatfs.cacheFlushNextSector) {
+                    earliestSectorIndex = i;
+                    break;
+                }
+                if (earliestSectorIndex == -1 || afatfs.cacheDescriptor[i].writeTimestamp < earliestSectorTime) {
+                    earliestSectorIndex = i;
+                    earliestSectorTime = afatfs.cacheDescriptor[i].writeTimestamp;
+                }
             }
         }
 
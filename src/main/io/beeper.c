@@ -79,6 +79,11 @@
 
 #define MAX_MULTI_BEEPS 64   //size limit for 'beep_multiBeeps[]'
 
+// The beeper task only wakes up at the pattern edges while a sound is
+// played, and otherwise polls the beeper modes at a low rate
+#define BEEPER_TASK_RATE_HZ 100
+#define BEEPER_IDLE_RATE_HZ 20
+
 #define BEEPER_COMMAND_REPEAT 0xFE
 #define BEEPER_COMMAND_STOP   0xFF
 
@@ -273,6 +278,20 @@ void beeper(beeperMode_e mode)
 
     beeperPos = 0;
     beeperNextToggleTime = 0;
+
+    // Start playing on the next scheduler pass
+    rescheduleTask(TASK_BEEPER, TASK_PERIOD_HZ(BEEPER_TASK_RATE_HZ));
+}
+
+static void beeperScheduleNext(timeUs_t currentTimeUs)
+{
+    if (currentBeeperEntry == NULL) {
+        rescheduleTask(TASK_SELF, TASK_PERIOD_HZ(BEEPER_IDLE_RATE_HZ));
+    } else if (beeperNextToggleTime > currentTimeUs) {
+        rescheduleTask(TASK_SELF, beeperNextToggleTime - currentTimeUs);
+    } else {
+        rescheduleTask(TASK_SELF, TASK_PERIOD_HZ(BEEPER_TASK_RATE_HZ));
+    }
 }
 
 void beeperSilence(void)
@@ -385,11 +404,13 @@ void beeperUpdate(timeUs_t currentTimeUs)
 
     // Beeper routine doesn't need to update if there aren't any sounds ongoing
     if (currentBeeperEntry == NULL) {
+        beeperScheduleNext(currentTimeUs);
         return;
     }
 
     if (beeperNextToggleTime > currentTimeUs) {
         schedulerIgnoreTaskExecTime();
+        beeperScheduleNext(currentTimeUs);
         return;
     }
 
@@ -441,6 +462,7 @@ void beeperUpdate(timeUs_t currentTimeUs)
 #endif
 
     beeperProcessCommand(currentTimeUs);
+    beeperScheduleNext(currentTimeUs);
 }
 
 /*
@@ -29,6 +29,7 @@
 
 #include "cli/cli.h"
 
+#include "common/maths.h"
 #include "common/utils.h"
 
 #include "drivers/display.h"
@@ -42,8 +43,30 @@
 
 #include "pg/vcd.h"
 
+#define MSP_OSD_MAX_STRING_LENGTH  30
+
+#define MSP_OSD_MAX_ROWS           16
+#define MSP_OSD_MAX_COLS           30
+
+// Bytes of an MSPv1 frame and write string header around the text
+#define MSP_OSD_WRITE_OVERHEAD     10
+
 static displayPort_t mspDisplayPort;
 
+/*
+ * Writes go to a local canvas, and drawScreen() only sends the spans
+ * that differ from what the remote display already shows. Nearby changes
+ * on a row are sent as one string when the unchanged cells in between
+ * cost less than another frame.
+ */
+typedef struct {
+    uint8_t chr[MSP_OSD_MAX_ROWS][MSP_OSD_MAX_COLS];
+    uint8_t attr[MSP_OSD_MAX_ROWS][MSP_OSD_MAX_COLS];
+} mspCanvas_t;
+
+static mspCanvas_t pendingCanvas;
+static mspCanvas_t remoteCanvas;
+
 static int output(displayPort_t *displayPort, uint8_t cmd, uint8_t *buf, int len)
 {
     UNUSED(displayPort);
@@ -81,21 +104,101 @@ static int release(displayPort_t *displayPort)
     return output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
 }
 
+static void canvasClear(mspCanvas_t *canvas)
+{
+    memset(canvas->chr, ' ', sizeof(canvas->chr));
+    memset(canvas->attr, 0, sizeof(canvas->attr));
+}
+
 static int clearScreen(displayPort_t *displayPort, displayClearOption_e options)
 {
     UNUSED(options);
 
     uint8_t subcmd[] = { 2 };
 
+    canvasClear(&pendingCanvas);
+    canvasClear(&remoteCanvas);
+
     return output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
 }
 
+static inline bool cellChanged(unsigned row, unsigned col)
+{
+    return pendingCanvas.chr[row][col] != remoteCanvas.chr[row][col] ||
+           pendingCanvas.attr[row][col] != remoteCanvas.attr[row][col];
+}
+
+// Send the next changed span on the row, returns false if there is none
+static bool sendNextSpan(displayPort_t *displayPort, unsigned row, unsigned *col)
+{
+    const unsigned cols = MIN(displayPort->cols, MSP_OSD_MAX_COLS);
+
+    unsigned start = *col;
+    while (start < cols && !cellChanged(row, start)) {
+        start++;
+    }
+
+    if (start >= cols) {
+        *col = cols;
+        return false;
+    }
+
+    const uint8_t attr = pendingCanvas.attr[row][start];
+    unsigned last = start;
+
+    for (unsigned c = start + 1; c < cols && c - start < MSP_OSD_MAX_STRING_LENGTH; c++) {
+        if (pendingCanvas.attr[row][c] != attr) {
+            break;
+        }
+        if (cellChanged(row, c)) {
+            last = c;
+        } else if (c - last > MSP_OSD_WRITE_OVERHEAD) {
+            break;
+        }
+    }
+
+    const unsigned len = last - start + 1;
+    uint8_t buf[MSP_OSD_MAX_STRING_LENGTH + 4];
+
+    buf[0] = 3;
+    buf[1] = row;
+    buf[2] = start;
+    buf[3] = attr;
+
+    memcpy(&buf[4], &pendingCanvas.chr[row][start], len);
+
+    output(displayPort, MSP_DISPLAYPORT, buf, len + 4);
+
+    memcpy(&remoteCanvas.chr[row][start], &pendingCanvas.chr[row][start], len);
+    memcpy(&remoteCanvas.attr[row][start], &pendingCanvas.attr[row][start], len);
+
+    *col = last + 1;
+
+    return true;
+}
+
+// Returns true while changes are left to send
 static bool drawScreen(displayPort_t *displayPort)
 {
+    const unsigned rows = MIN(displayPort->rows, MSP_OSD_MAX_ROWS);
+
+    for (unsigned row = 0; row < rows; row++) {
+        unsigned col = 0;
+        while (col < MSP_OSD_MAX_COLS) {
+            // Leave the rest for the next call rather than overrun the port
+            if (mspSerialTxBytesFree() < MSP_OSD_WRITE_OVERHEAD + MSP_OSD_MAX_STRING_LENGTH) {
+                return true;
+            }
+            if (!sendNextSpan(displayPort, row, &col)) {
+                break;
+            }
+        }
+    }
+
     uint8_t subcmd[] = { 4 };
     output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
 
-    return 0;
+    return false;
 }
 
 static int screenSize(const displayPort_t *displayPort)
@@ -105,26 +208,24 @@ static int screenSize(const displayPort_t *displayPort)
 
 static int writeString(displayPort_t *displayPort, uint8_t col, uint8_t row, uint8_t attr, const char *string)
 {
-#define MSP_OSD_MAX_STRING_LENGTH 30 // FIXME move this
-    uint8_t buf[MSP_OSD_MAX_STRING_LENGTH + 4];
-
-    int len = strlen(string);
-    if (len >= MSP_OSD_MAX_STRING_LENGTH) {
-        len = MSP_OSD_MAX_STRING_LENGTH;
+    if (row >= MIN(displayPort->rows, MSP_OSD_MAX_ROWS)) {
+        return 0;
     }
 
-    buf[0] = 3;
-    buf[1] = row;
-    buf[2] = col;
-    buf[3] = displayPortProfileMsp()->attrValues[attr] & ~DISPLAYPORT_MSP_ATTR_BLINK & DISPLAYPORT_MSP_ATTR_MASK;
+    uint8_t mspAttr = displayPortProfileMsp()->attrValues[attr] & ~DISPLAYPORT_MSP_ATTR_BLINK & DISPLAYPORT_MSP_ATTR_MASK;
 
     if (attr & DISPLAYPORT_ATTR_BLINK) {
-        buf[3] |= DISPLAYPORT_MSP_ATTR_BLINK;
+        mspAttr |= DISPLAYPORT_MSP_ATTR_BLINK;
     }
 
-    memcpy(&buf[4], string, len);
+    const unsigned cols = MIN(displayPort->cols, MSP_OSD_MAX_COLS);
+
+    for (; *string && col < cols; string++, col++) {
+        pendingCanvas.chr[row][col] = *string;
+        pendingCanvas.attr[row][col] = mspAttr;
+    }
 
-    return output(displayPort, MSP_DISPLAYPORT, buf, len + 4);
+    return 0;
 }
 
 static int writeChar(displayPort_t *displayPort, uint8_t col, uint8_t row, uint8_t attr, uint8_t c)
@@ -133,7 +234,7 @@ static int writeChar(displayPort_t *displayPort, uint8_t col, uint8_t row, uint8
 
     buf[0] = c;
     buf[1] = 0;
-    return writeString(displayPort, col, row, attr, buf); //!!TODO - check if there is a direct MSP command to do this
+    return writeString(displayPort, col, row, attr, buf);
 }
 
 static bool isTransferInProgress(const displayPort_t *displayPort)
@@ -188,6 +289,9 @@ displayPort_t *displayPortMspInit(void)
         mspDisplayPort.useDeviceBlink = true;
     }
 
+    // The remote display keeps its canvas until cleared
+    mspDisplayPort.retainsCanvas = true;
+
     redraw(&mspDisplayPort);
     return &mspDisplayPort;
 }
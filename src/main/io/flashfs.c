@@ -39,6 +39,7 @@
 #include "platform.h"
 
 #include "build/debug.h"
+#include "common/maths.h"
 #include "common/printf.h"
 #include "drivers/flash.h"
 #include "drivers/light_led.h"
@@ -113,13 +114,21 @@ static void flashfsSetTailAddress(uint32_t address)
 void flashfsEraseCompletely(void)
 {
     if (flashGeometry->sectors > 0 && flashPartitionCount() > 0) {
-        // if there's a single FLASHFS partition and it uses the entire flash then do a full erase
-        const bool doFullErase = (flashPartitionCount() == 1) && (FLASH_PARTITION_SECTOR_COUNT(flashPartition) == flashGeometry->sectors);
+        /* Everything past the end of the written data is already erased (flashfsIdentifyStartOfFreeSpace()
+         * depends on that), so only the sectors holding data need erasing. They are erased from the last one
+         * backwards, so an erase that is interrupted still leaves the data that remains at the start of the
+         * partition, and the free space is found correctly on the next boot.
+         */
+        const uint32_t usedSectors = (tailAddress + flashGeometry->sectorSize - 1) / flashGeometry->sectorSize;
+
+        // if there's a single FLASHFS partition and it uses the entire flash then a full erase may be quicker
+        const bool doFullErase = (flashPartitionCount() == 1) && (FLASH_PARTITION_SECTOR_COUNT(flashPartition) == flashGeometry->sectors) &&
+            (usedSectors >= flashGeometry->sectors);
         if (doFullErase) {
             flashEraseCompletely();
-        } else {
-            // start asynchronous erase of all sectors
-            eraseSectorCurrent = flashPartition->startSector;
+        } else if (usedSectors > 0) {
+            // start asynchronous erase of the used sectors
+            eraseSectorCurrent = flashPartition->startSector + usedSectors;
             flashfsState = FLASHFS_ERASING;
         }
     }
@@ -338,13 +347,47 @@ uint32_t flashfsGetOffset(void)
     return tailAddress + bufferSizes[0] + bufferSizes[1];
 }
 
+/*
+ * Limit a write to FLASHFS_FLUSH_CHUNK_SIZE bytes. Returns the new buffer count.
+ */
+static int flashfsLimitDirtyDataBuffers(uint32_t bufferSizes[], int bufCount)
+{
+    if (bufferSizes[0] >= FLASHFS_FLUSH_CHUNK_SIZE) {
+        bufferSizes[0] = FLASHFS_FLUSH_CHUNK_SIZE;
+        bufferSizes[1] = 0;
+        return MIN(bufCount, 1);
+    }
+
+    bufferSizes[1] = MIN(bufferSizes[1], FLASHFS_FLUSH_CHUNK_SIZE - bufferSizes[0]);
+
+    return bufCount;
+}
+
+/*
+ * With room for more than one chunk in the buffer, only program full chunks (up to the
+ * end of the page) while the rest keeps filling, so every program operation is as
+ * large as possible.
+ */
+static bool flashfsChunkIsPending(const uint32_t bufferSizes[])
+{
+    if ((FLASHFS_WRITE_BUFFER_SIZE < 2 * FLASHFS_FLUSH_CHUNK_SIZE) || (flashGeometry->pageSize == 0)) {
+        return false;
+    }
+
+    const uint32_t toPageEnd = flashGeometry->pageSize - (tailAddress % flashGeometry->pageSize);
+
+    return (bufferSizes[0] + bufferSizes[1]) < MIN(toPageEnd, FLASHFS_FLUSH_CHUNK_SIZE);
+}
+
 /**
  * If the flash is ready to accept writes, flush the buffer to it.
  *
+ * Unless force is set, a partial chunk is held back until it is complete.
+ *
  * Returns true if all data in the buffer has been flushed to the device, or false if
  * there is still data to be written (call flush again later).
  */
-bool flashfsFlushAsync(void)
+bool flashfsFlushAsync(bool force)
 {
     uint8_t const * buffers[2];
     uint32_t bufferSizes[2];
@@ -374,6 +417,12 @@ bool flashfsFlushAsync(void)
 #endif
 
     bufCount = flashfsGetDirtyDataBuffers(buffers, bufferSizes);
+
+    if (!force && flashfsChunkIsPending(bufferSizes)) {
+        return false;
+    }
+
+    bufCount = flashfsLimitDirtyDataBuffers(bufferSizes, bufCount);
     if (bufCount) {
         flashfsWriteBuffers(buffers, bufferSizes, bufCount, false);
     }
@@ -382,10 +431,9 @@ bool flashfsFlushAsync(void)
 }
 
 /**
- * Wait for the flash to become ready and begin flushing any buffered data to flash.
+ * Wait for the flash to become ready and flush all buffered data to flash.
  *
- * The flash will still be busy some time after this sync completes, but space will
- * be freed up to accept more writes in the write buffer.
+ * The buffer may span several pages, each of which is a separate program operation.
  */
 void flashfsFlushSync(void)
 {
@@ -393,13 +441,14 @@ void flashfsFlushSync(void)
     uint32_t bufferSizes[2];
     int bufCount;
 
-    if (flashfsBufferIsEmpty()) {
-        return; // Nothing to flush
-    }
+    while (!flashfsBufferIsEmpty() && !flashfsIsEOF()) {
+        // Wait for the previous write to release its part of the buffer
+        while (!flashfsNewData() || !flashIsReady());
 
-    bufCount = flashfsGetDirtyDataBuffers(buffers, bufferSizes);
-    if (bufCount) {
-        flashfsWriteBuffers(buffers, bufferSizes, bufCount, true);
+        bufCount = flashfsGetDirtyDataBuffers(buffers, bufferSizes);
+        if (bufCount) {
+            flashfsWriteBuffers(buffers, bufferSizes, bufCount, true);
+        }
     }
 
     while (!flashIsReady());
@@ -412,11 +461,11 @@ void flashfsEraseAsync(void)
 {
     if (flashfsState == FLASHFS_ERASING) {
         if ((flashfsIsSupported() && flashIsReady())) {
-            if (eraseSectorCurrent <= flashPartition->endSector) {
-                // Erase sector
+            if (eraseSectorCurrent > flashPartition->startSector) {
+                // Erase the next sector downwards
+                eraseSectorCurrent--;
                 uint32_t sectorAddress = eraseSectorCurrent * flashGeometry->sectorSize;
                 flashEraseSector(sectorAddress);
-                eraseSectorCurrent++;
                 LED1_TOGGLE;
             } else {
                 // Done erasing
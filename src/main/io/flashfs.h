@@ -20,9 +20,15 @@
 
 #pragma once
 
+#ifndef FLASHFS_WRITE_BUFFER_SIZE
 #define FLASHFS_WRITE_BUFFER_SIZE 256
+#endif
 #define FLASHFS_WRITE_BUFFER_USABLE (FLASHFS_WRITE_BUFFER_SIZE - 1)
 
+// Largest single program operation started by an asynchronous flush. Some drivers
+// load the page data synchronously, so this bounds the time spent in the caller.
+#define FLASHFS_FLUSH_CHUNK_SIZE 256u
+
 void flashfsEraseCompletely(void);
 void flashfsEraseRange(uint32_t start, uint32_t end);
 
@@ -41,7 +47,7 @@ void flashfsWrite(const uint8_t *data, unsigned int len);
 
 int flashfsReadAbs(uint32_t offset, uint8_t *data, unsigned int len);
 
-bool flashfsFlushAsync(void);
+bool flashfsFlushAsync(bool force);
 void flashfsFlushSync(void);
 void flashfsEraseAsync(void);
 
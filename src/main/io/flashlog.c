@@ -0,0 +1,322 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * Flash log
+ *
+ * Append only store of small records in the RECORDS partition of the
+ * external NOR flash, for the persistent stats and the events that should
+ * survive a power cycle. Writing a record does not touch the config.
+ *
+ * The partition has two sectors. Each starts with a FLASH_LOG_SECTOR
+ * record holding a sequence number, and the sector with the higher one is
+ * the current sector. Records have a fixed size, so the erased slots are
+ * all at the end of a sector, and the first free one is found with a
+ * binary search at boot. Appending is O(1): the record goes into a queue,
+ * from which a dispatcher entry writes one record per run, whenever both
+ * the flash and flashfs are idle.
+ *
+ * When the current sector is full, the other one is erased and becomes
+ * the current sector, so the log keeps at least one sector of history.
+ * The latest FLASH_LOG_STATS record is written again at the start of the
+ * new sector, so the stats are never lost to a rotation.
+ *
+ * Each record carries a CRC. A record cut short by a power loss fails the
+ * check and is skipped by the readers.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#ifdef USE_FLASH_LOG
+
+#include "common/crc.h"
+#include "common/utils.h"
+
+#include "drivers/flash.h"
+
+#include "fc/dispatch.h"
+
+#include "io/flashfs.h"
+#include "io/flashlog.h"
+
+STATIC_ASSERT(sizeof(flashLogRecord_t) == FLASH_LOG_RECORD_SIZE, flash_log_record_size);
+STATIC_ASSERT((FLASH_LOG_QUEUE_SIZE & (FLASH_LOG_QUEUE_SIZE - 1)) == 0, flash_log_queue_size_not_power_of_2);
+
+#define FLASH_LOG_QUEUE_MASK        (FLASH_LOG_QUEUE_SIZE - 1)
+#define FLASH_LOG_RETRY_US          1000
+
+static struct {
+    const flashPartition_t *partition;
+    uint32_t sectorSize;
+    unsigned slots;                         // Records per sector, including the sector record
+    unsigned used[FLASH_RECORDS_SECTORS];   // Slots written
+    uint32_t sequence[FLASH_RECORDS_SECTORS];
+    bool     valid[FLASH_RECORDS_SECTORS];
+    int8_t   current;                       // Sector being appended to, -1 before the first format
+    int8_t   erasing;                       // Sector being erased, -1 if none
+    bool     haveStats;
+    bool     rewriteStats;
+    flashLogRecord_t stats;                 // Latest FLASH_LOG_STATS record
+    flashLogRecord_t buffer;                // Record being programmed
+    flashLogRecord_t queue[FLASH_LOG_QUEUE_SIZE];
+    uint8_t  head;
+    uint8_t  tail;
+} flog;
+
+
+static uint32_t flashLogAddress(unsigned sector, unsigned slot)
+{
+    return (flog.partition->startSector + sector) * flog.sectorSize + slot * FLASH_LOG_RECORD_SIZE;
+}
+
+static uint16_t flashLogCrc(const flashLogRecord_t *record)
+{
+    const uint16_t crc = crc16_ccitt_update(0, record, 2);
+
+    return crc16_ccitt_update(crc, record->data, record->length);
+}
+
+static void flashLogBuild(flashLogRecord_t *record, flashLogType_e type, const void *data, unsigned length)
+{
+    record->type = type;
+    record->length = length;
+
+    memcpy(record->data, data, length);
+    memset(record->data + length, 0xFF, FLASH_LOG_PAYLOAD_SIZE - length);
+
+    record->crc = flashLogCrc(record);
+}
+
+static bool flashLogReadSlot(unsigned sector, unsigned slot, flashLogRecord_t *record)
+{
+    if (flashReadBytes(flashLogAddress(sector, slot), (uint8_t *)record, FLASH_LOG_RECORD_SIZE) != FLASH_LOG_RECORD_SIZE)
+        return false;
+
+    return record->type != FLASH_LOG_ERASED && record->length <= FLASH_LOG_PAYLOAD_SIZE &&
+        record->crc == flashLogCrc(record);
+}
+
+// First erased slot of a sector
+static unsigned flashLogFindEnd(unsigned sector)
+{
+    unsigned low = 1;
+    unsigned high = flog.slots;
+
+    while (low < high) {
+        const unsigned mid = (low + high) / 2;
+        uint8_t type = FLASH_LOG_ERASED;
+
+        flashReadBytes(flashLogAddress(sector, mid), &type, 1);
+
+        if (type == FLASH_LOG_ERASED)
+            high = mid;
+        else
+            low = mid + 1;
+    }
+
+    return low;
+}
+
+static bool flashLogFlashIdle(void)
+{
+#ifdef USE_FLASHFS
+    if (flashfsIsSupported() && !flashfsIsReady())
+        return false;
+#endif
+    return flashIsReady();
+}
+
+static void flashLogWrite(struct dispatchEntry_s *self)
+{
+    if (!flashLogFlashIdle()) {
+        dispatchAdd(self, FLASH_LOG_RETRY_US);
+        return;
+    }
+
+    // The erase is complete, start the sector
+    if (flog.erasing >= 0) {
+        const unsigned sector = flog.erasing;
+        const uint32_t sequence = (flog.current >= 0) ? flog.sequence[flog.current] + 1 : 1;
+
+        flashLogBuild(&flog.buffer, FLASH_LOG_SECTOR, &sequence, sizeof(sequence));
+        flashPageProgram(flashLogAddress(sector, 0), (const uint8_t *)&flog.buffer, FLASH_LOG_RECORD_SIZE, NULL);
+
+        flog.sequence[sector] = sequence;
+        flog.valid[sector] = true;
+        flog.used[sector] = 1;
+        flog.current = sector;
+        flog.erasing = -1;
+        flog.rewriteStats = flog.haveStats;
+
+        dispatchAdd(self, FLASH_LOG_RETRY_US);
+        return;
+    }
+
+    if (flog.current < 0 || flog.used[flog.current] >= flog.slots) {
+        const unsigned sector = (flog.current < 0) ? 0 : flog.current ^ 1;
+
+        flog.valid[sector] = false;
+        flog.used[sector] = 0;
+        flog.erasing = sector;
+
+        flashEraseSector(flashLogAddress(sector, 0));
+
+        dispatchAdd(self, FLASH_LOG_RETRY_US);
+        return;
+    }
+
+    if (flog.rewriteStats) {
+        flog.buffer = flog.stats;
+        flog.rewriteStats = false;
+    }
+    else if (flog.tail != flog.head) {
+        flog.buffer = flog.queue[flog.tail & FLASH_LOG_QUEUE_MASK];
+        flog.tail++;
+    }
+    else {
+        return;
+    }
+
+    flashPageProgram(flashLogAddress(flog.current, flog.used[flog.current]), (const uint8_t *)&flog.buffer, FLASH_LOG_RECORD_SIZE, NULL);
+    flog.used[flog.current]++;
+
+    if (flog.tail != flog.head)
+        dispatchAdd(self, FLASH_LOG_RETRY_US);
+}
+
+static dispatchEntry_t flashLogWriteEntry =
+{
+    .dispatch = flashLogWrite,
+};
+
+void flashLogInit(void)
+{
+    memset(&flog, 0, sizeof(flog));
+
+    flog.current = -1;
+    flog.erasing = -1;
+    flog.partition = flashPartitionFindByType(FLASH_PARTITION_TYPE_RECORDS);
+
+    if (!flog.partition)
+        return;
+
+    flog.sectorSize = flashGetGeometry()->sectorSize;
+    flog.slots = flog.sectorSize / FLASH_LOG_RECORD_SIZE;
+
+    for (unsigned sector = 0; sector < FLASH_RECORDS_SECTORS; sector++) {
+        flashLogRecord_t record;
+
+        if (flashLogReadSlot(sector, 0, &record) && record.type == FLASH_LOG_SECTOR && record.length == sizeof(uint32_t)) {
+            memcpy(&flog.sequence[sector], record.data, sizeof(uint32_t));
+            flog.valid[sector] = true;
+            flog.used[sector] = flashLogFindEnd(sector);
+
+            if (flog.current < 0 || (int32_t)(flog.sequence[sector] - flog.sequence[flog.current]) > 0)
+                flog.current = sector;
+        }
+    }
+
+    flog.haveStats = flashLogFindLatest(FLASH_LOG_STATS, &flog.stats);
+
+    dispatchEnable();
+}
+
+bool flashLogIsReady(void)
+{
+    return flog.partition != NULL;
+}
+
+bool flashLogAppend(flashLogType_e type, const void *data, unsigned length)
+{
+    if (!flog.partition || length > FLASH_LOG_PAYLOAD_SIZE)
+        return false;
+
+    if ((uint8_t)(flog.head - flog.tail) >= FLASH_LOG_QUEUE_SIZE)
+        return false;
+
+    flashLogRecord_t *record = &flog.queue[flog.head & FLASH_LOG_QUEUE_MASK];
+
+    flashLogBuild(record, type, data, length);
+    flog.head++;
+
+    if (type == FLASH_LOG_STATS) {
+        flog.stats = *record;
+        flog.haveStats = true;
+    }
+
+    dispatchAdd(&flashLogWriteEntry, 0);
+
+    return true;
+}
+
+// The older sector, if it holds records
+static int flashLogPrevious(void)
+{
+    if (flog.current < 0)
+        return -1;
+
+    const unsigned sector = flog.current ^ 1;
+
+    return (flog.valid[sector] && flog.erasing != (int8_t)sector) ? (int)sector : -1;
+}
+
+unsigned flashLogCount(void)
+{
+    const int previous = flashLogPrevious();
+    unsigned count = 0;
+
+    if (previous >= 0)
+        count += flog.used[previous] - 1;
+    if (flog.current >= 0)
+        count += flog.used[flog.current] - 1;
+
+    return count;
+}
+
+// Index 0 is the oldest record in the log
+bool flashLogRead(unsigned index, flashLogRecord_t *record)
+{
+    const int previous = flashLogPrevious();
+
+    if (previous >= 0) {
+        if (index < flog.used[previous] - 1)
+            return flashLogReadSlot(previous, index + 1, record);
+        index -= flog.used[previous] - 1;
+    }
+
+    if (flog.current >= 0 && index < flog.used[flog.current] - 1)
+        return flashLogReadSlot(flog.current, index + 1, record);
+
+    return false;
+}
+
+bool flashLogFindLatest(flashLogType_e type, flashLogRecord_t *record)
+{
+    for (unsigned index = flashLogCount(); index > 0; index--) {
+        if (flashLogRead(index - 1, record) && record->type == type)
+            return true;
+    }
+
+    return false;
+}
+
+#endif
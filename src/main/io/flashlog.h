@@ -0,0 +1,54 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define FLASH_LOG_RECORD_SIZE       32u     // Must divide the flash page size
+#define FLASH_LOG_PAYLOAD_SIZE      (FLASH_LOG_RECORD_SIZE - 4)
+#define FLASH_LOG_QUEUE_SIZE        16u     // Records waiting to be written, power of two
+#define FLASH_LOG_PAGE_SIZE         8u      // Records per MSP reply
+
+typedef enum {
+    FLASH_LOG_SECTOR = 1,       // First record of a sector: uint32_t sequence
+    FLASH_LOG_STATS,            // statsRecord_t
+    FLASH_LOG_EVENT,            // Up to three eventLogRecord_t
+    FLASH_LOG_ERASED = 0xFF,
+} flashLogType_e;
+
+typedef struct {
+    uint8_t  type;              // flashLogType_e
+    uint8_t  length;            // Bytes of data used
+    uint16_t crc;               // CRC16-CCITT of type, length and data
+    uint8_t  data[FLASH_LOG_PAYLOAD_SIZE];
+} flashLogRecord_t;
+
+#ifdef USE_FLASH_LOG
+
+void flashLogInit(void);
+bool flashLogIsReady(void);
+
+bool flashLogAppend(flashLogType_e type, const void *data, unsigned length);
+bool flashLogFindLatest(flashLogType_e type, flashLogRecord_t *record);
+
+unsigned flashLogCount(void);
+bool flashLogRead(unsigned index, flashLogRecord_t *record);
+
+#endif
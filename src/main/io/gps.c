@@ -54,6 +54,7 @@
 #include "flight/imu.h"
 #include "flight/pid.h"
 #include "flight/gps_rescue.h"
+#include "flight/position.h"
 
 #include "scheduler/scheduler.h"
 
@@ -268,12 +269,9 @@ typedef enum {
     GPS_STATE_COUNT
 } gpsState_e;
 
-// Max time to wait for received data
-#define GPS_MAX_WAIT_DATA_RX 30
-
 gpsData_t gpsData;
 
-PG_REGISTER_WITH_RESET_TEMPLATE(gpsConfig_t, gpsConfig, PG_GPS_CONFIG, 0);
+PG_REGISTER_WITH_RESET_TEMPLATE(gpsConfig_t, gpsConfig, PG_GPS_CONFIG, 1);
 
 PG_RESET_TEMPLATE(gpsConfig_t, gpsConfig,
     .provider = GPS_NMEA,
@@ -284,7 +282,8 @@ PG_RESET_TEMPLATE(gpsConfig_t, gpsConfig,
     .gps_ublox_mode = UBLOX_AIRBORNE,
     .gps_set_home_point_once = false,
     .gps_use_3d_speed = false,
-    .sbas_integrity = false
+    .sbas_integrity = false,
+    .gps_update_rate_hz = GPS_UPDATE_RATE_DEFAULT,
 );
 
 static void shiftPacketLog(void)
@@ -525,6 +524,22 @@ static void ubloxSetNavRate(uint16_t measRate, uint16_t navRate, uint16_t timeRe
     ubloxSendConfigMessage(&tx_buffer, MSG_CFG_RATE, sizeof(ubx_cfg_rate));
 }
 
+// Set the measurement rate, with one navigation solution per measurement
+static void ubloxSetUpdateRate(uint8_t rateHz) {
+    ubloxSetNavRate(1000 / rateHz, 1, 1);
+}
+
+// Satellite info once a second
+static void ubloxSetSatInfoRate(bool enable) {
+    const uint8_t rate = enable ? gpsData.ubloxNavRateHz : 0;
+
+    if (gpsData.ubloxUseSAT) {
+        ubloxSetMessageRate(CLASS_NAV, MSG_SAT, rate);
+    } else {
+        ubloxSetMessageRate(CLASS_NAV, MSG_SVINFO, rate);
+    }
+}
+
 static void ubloxSetSbas() {
     ubx_message tx_buffer;
 
@@ -625,6 +640,7 @@ void gpsInitUblox(void)
                     case 0:
                         gpsData.ubloxUsePVT = true;
                         gpsData.ubloxUseSAT = true;
+                        gpsData.ubloxNavRateHz = constrain(gpsConfig()->gps_update_rate_hz, 1, GPS_UPDATE_RATE_MAX);
                         ubloxSendNAV5Message(gpsConfig()->gps_ublox_mode == UBLOX_AIRBORNE);
                         break;
                     case 1: //Disable NMEA Messages
@@ -674,14 +690,10 @@ void gpsInitUblox(void)
                         }
                         break;
                     case 11:
-                        if (gpsData.ubloxUseSAT) {
-                            ubloxSetMessageRate(CLASS_NAV, MSG_SAT, 5); // set SAT MSG rate (every 5 cycles)
-                        } else {
-                            ubloxSetMessageRate(CLASS_NAV, MSG_SVINFO, 5); // set SVINFO MSG rate (every 5 cycles)
-                        }
+                        ubloxSetSatInfoRate(true);
                         break;
                     case 12:
-                        ubloxSetNavRate(0xC8, 1, 1); // set rate to 5Hz (measurement period: 200ms, navigation rate: 1 cycle)
+                        ubloxSetUpdateRate(gpsData.ubloxNavRateHz);
                         break;
                     case 13:
                         ubloxSetSbas();
@@ -723,6 +735,10 @@ void gpsInitUblox(void)
                         if (gpsData.state_position == 11) { // If we were asking for NAV-SAT...
                             gpsData.ubloxUseSAT = false;   // ...retry asking for NAV-SVINFO
                             gpsData.ackState = UBLOX_ACK_IDLE;
+                        } else if (gpsData.state_position == 12 && gpsData.ubloxNavRateHz > GPS_UPDATE_RATE_DEFAULT) {
+                            // The receiver can't run this fast, retry at the default rate
+                            gpsData.ubloxNavRateHz = GPS_UPDATE_RATE_DEFAULT;
+                            gpsData.ackState = UBLOX_ACK_IDLE;
                         } else {
                             gpsSetState(GPS_STATE_CONFIGURE);
                         }
@@ -772,7 +788,7 @@ void gpsUpdate(timeUs_t currentTimeUs)
     // read out available GPS bytes
     if (gpsPort) {
         while (serialRxBytesWaiting(gpsPort)) {
-            if (cmpTimeUs(micros(), currentTimeUs) > GPS_MAX_WAIT_DATA_RX) {
+            if (schedulerTaskSliceExpired()) {
                 // Wait 1ms and come back
                 rescheduleTask(TASK_SELF, TASK_PERIOD_HZ(TASK_GPS_RATE_FAST));
                 return;
@@ -826,11 +842,7 @@ void gpsUpdate(timeUs_t currentTimeUs)
                     switch (gpsData.state_position) {
                         case 0:
                             if (!isConfiguratorConnected()) {
-                                if (gpsData.ubloxUseSAT) {
-                                    ubloxSetMessageRate(CLASS_NAV, MSG_SAT, 0); // disable SAT MSG
-                                } else {
-                                    ubloxSetMessageRate(CLASS_NAV, MSG_SVINFO, 0); // disable SVINFO MSG
-                                }
+                                ubloxSetSatInfoRate(false);
                                 gpsData.state_position = 1;
                             }
                             break;
@@ -845,11 +857,7 @@ void gpsUpdate(timeUs_t currentTimeUs)
                             break;
                         case 2:
                             if (isConfiguratorConnected()) {
-                                if (gpsData.ubloxUseSAT) {
-                                    ubloxSetMessageRate(CLASS_NAV, MSG_SAT, 5); // set SAT MSG rate (every 5 cycles)
-                                } else {
-                                    ubloxSetMessageRate(CLASS_NAV, MSG_SVINFO, 5); // set SVINFO MSG rate (every 5 cycles)
-                                }
+                                ubloxSetSatInfoRate(true);
                                 gpsData.state_position = 0;
                             }
                             break;
@@ -1867,6 +1875,8 @@ void onGpsNewData(void)
         GPS_calculateDistanceFlownVerticalSpeed(false);
     }
 
+    positionNewGpsData();
+
 #ifdef USE_GPS_RESCUE
     rescueNewGpsData();
 #endif
@@ -84,6 +84,9 @@ typedef enum {
 
 #define GPS_BAUDRATE_MAX GPS_BAUDRATE_9600
 
+#define GPS_UPDATE_RATE_DEFAULT     5
+#define GPS_UPDATE_RATE_MAX         25
+
 typedef struct gpsConfig_s {
     gpsProvider_e provider;
     sbasMode_e sbasMode;
@@ -94,6 +97,7 @@ typedef struct gpsConfig_s {
     uint8_t gps_set_home_point_once;
     uint8_t gps_use_3d_speed;
     uint8_t sbas_integrity;
+    uint8_t gps_update_rate_hz;
 } gpsConfig_t;
 
 PG_DECLARE(gpsConfig_t, gpsConfig);
@@ -135,6 +139,7 @@ typedef struct gpsData_s {
     ubloxAckState_e ackState;
     bool ubloxUsePVT;
     bool ubloxUseSAT;
+    uint8_t ubloxNavRateHz;         // Navigation solution rate accepted by the receiver
 } gpsData_t;
 
 #define GPS_PACKET_LOG_ENTRY_COUNT 21 // To make this useful we should log as many packets as we can fit characters a single line of a OLED display.
@@ -34,8 +34,6 @@
 #include "pg/pinio.h"
 #include "pg/piniobox.h"
 
-#include "scheduler/scheduler.h"
-
 #include "piniobox.h"
 
 typedef struct pinioBoxRuntimeConfig_s {
@@ -53,28 +51,19 @@ void pinioBoxInit(const pinioBoxConfig_t *pinioBoxConfig)
 
         pinioBoxRuntimeConfig.boxId[i] = box ? box->boxId : BOXID_NONE;
     }
+
+    pinioBoxUpdate();
 }
 
-void pinioBoxUpdate(timeUs_t currentTimeUs)
+/*
+ * Called when the mode activation state or the conditions change
+ */
+void pinioBoxUpdate(void)
 {
-    UNUSED(currentTimeUs);
-
     for (int i = 0; i < PINIO_COUNT; i++) {
         if (pinioBoxRuntimeConfig.boxId[i] != BOXID_NONE) {
             pinioSet(i, getBoxIdState(pinioBoxRuntimeConfig.boxId[i]));
         }
     }
 }
-
-void pinioBoxTaskControl(void)
-{
-    bool enableTask = false;
-    for (int i = 0; i < PINIO_COUNT; i++) {
-        if (pinioBoxRuntimeConfig.boxId[i] != BOXID_NONE && isModeActivationConditionPresent(pinioBoxRuntimeConfig.boxId[i])) {
-            enableTask = true;
-            break;
-        }
-    }
-    setTaskEnabled(TASK_PINIOBOX, enableTask);
-}
 #endif
@@ -21,5 +21,4 @@
 #include "pg/piniobox.h"
 
 void pinioBoxInit(const pinioBoxConfig_t *pinioBoxConfig);
-void pinioBoxUpdate(timeUs_t currentTimeUs);
-void pinioBoxTaskControl(void);
+void pinioBoxUpdate(void);
@@ -110,11 +110,22 @@ static uint8_t suart_getc_(uint8_t *bt)
     return 1;
 }
 
+// End of the last stop bit sent
+static uint32_t suartTxTime;
+
 static void suart_putc_(uint8_t *tx_b)
 {
-    // shift out stopbit first
-    uint16_t bitmask = (*tx_b << 2) | 1 | (1 << 10);
-    uint32_t btime = micros();
+    // start bit, 8 data bits, stop bit
+    uint16_t bitmask = (*tx_b << 1) | (1 << 9);
+    uint32_t btime = suartTxTime;
+
+    // continue back to back from the previous byte, or restart the bit clock if late
+    if (cmpTimeUs(micros(), btime) > 0) {
+        btime = micros();
+    } else {
+        while (cmpTimeUs(btime, micros()) > 0);
+    }
+
     while (1) {
         if (bitmask & 1) {
             ESC_SET_HI; // 1
@@ -124,9 +135,11 @@ static void suart_putc_(uint8_t *tx_b)
         }
         btime = btime + BIT_TIME;
         bitmask = (bitmask >> 1);
-        if (bitmask == 0) break; // stopbit shifted out - but don't wait
-        while (micros() < btime);
+        if (bitmask == 0) break; // stopbit on the line - the next byte waits for it
+        while (cmpTimeUs(btime, micros()) > 0);
     }
+
+    suartTxTime = btime;
 }
 
 static uint8_16_u CRC_16;
@@ -178,6 +191,9 @@ timeout:
 static void BL_SendBuf(uint8_t *pstring, uint8_t len)
 {
     ESC_OUTPUT;
+    ESC_SET_HI;
+    // idle for one bit before the first start bit
+    suartTxTime = micros() + BIT_TIME;
     CRC_16.word=0;
     do {
         suart_putc_(pstring);
@@ -272,7 +288,8 @@ static uint8_t BL_SendCMDSetBuffer(ioMem_t *pMem)
         sCMD[2] = 1;
     }
     BL_SendBuf(sCMD, 4);
-    if (BL_GetACK(2) != brNONE) return 0;
+    // no reply is expected, one start bit window is enough to catch an error
+    if (BL_GetACK(0) != brNONE) return 0;
     BL_SendBuf(pMem->D_PTR_I, pMem->D_NUM_BYTES);
     return (BL_GetACK(40) == brSUCCESS);
 }
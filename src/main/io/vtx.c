@@ -75,6 +75,17 @@ typedef enum {
     VTX_PARAM_COUNT
 } vtxScheduleParams_e;
 
+// Band, channel and power changes are sent once the requested settings
+// have been stable this long, so scrolling through them sends only the last
+#define VTX_SETTLE_TIME_US          300000
+
+// A setting the device hasn't taken is resent after a growing interval
+#define VTX_RETRY_INTERVAL_US       500000
+#define VTX_RETRY_BACKOFF_MAX       3
+
+static timeUs_t vtxRetryTimeUs[VTX_PARAM_COUNT];
+static uint8_t vtxRetryCount[VTX_PARAM_COUNT];
+
 void vtxInit(void)
 {
     bool settingsUpdated = false;
@@ -237,6 +248,43 @@ static bool vtxProcessStateUpdate(vtxDevice_t *vtxDevice)
     return (bool)memcmp(&vtxSettingsState, &vtxState, sizeof(vtxSettingsConfig_t));
 }
 
+static bool vtxSettingsSettled(timeUs_t currentTimeUs)
+{
+    static vtxSettingsConfig_t lastSettings;
+    static timeUs_t lastChangeUs;
+
+    const vtxSettingsConfig_t settings = vtxGetSettings();
+
+    if (settings.band != lastSettings.band || settings.channel != lastSettings.channel ||
+        settings.freq != lastSettings.freq || settings.power != lastSettings.power) {
+        lastSettings = settings;
+        lastChangeUs = currentTimeUs;
+
+        // New settings are sent without waiting for an earlier retry
+        memset(vtxRetryCount, 0, sizeof(vtxRetryCount));
+        memset(vtxRetryTimeUs, 0, sizeof(vtxRetryTimeUs));
+    }
+
+    return cmpTimeUs(currentTimeUs, lastChangeUs) >= VTX_SETTLE_TIME_US;
+}
+
+static bool vtxRetryAllowed(uint8_t param, timeUs_t currentTimeUs)
+{
+    return vtxRetryCount[param] == 0 || cmpTimeUs(currentTimeUs, vtxRetryTimeUs[param]) >= 0;
+}
+
+static void vtxRetryUpdate(uint8_t param, bool sent, timeUs_t currentTimeUs)
+{
+    if (sent) {
+        vtxRetryTimeUs[param] = currentTimeUs + (VTX_RETRY_INTERVAL_US << MIN(vtxRetryCount[param], VTX_RETRY_BACKOFF_MAX));
+        if (vtxRetryCount[param] < 255) {
+            vtxRetryCount[param]++;
+        }
+    } else {
+        vtxRetryCount[param] = 0;
+    }
+}
+
 void vtxUpdate(timeUs_t currentTimeUs)
 {
     static uint8_t currentSchedule = 0;
@@ -250,10 +298,20 @@ void vtxUpdate(timeUs_t currentTimeUs)
         // Check input sources for config updates
         vtxControlInputPoll();
 
+        const bool settled = vtxSettingsSettled(currentTimeUs);
+
         const uint8_t startingSchedule = currentSchedule;
         bool vtxUpdatePending = false;
         do {
-            switch (currentSchedule) {
+            const uint8_t param = currentSchedule;
+
+            if ((param == VTX_PARAM_POWER || param == VTX_PARAM_BANDCHAN) &&
+                (!settled || !vtxRetryAllowed(param, currentTimeUs))) {
+                currentSchedule = (currentSchedule + 1) % VTX_PARAM_COUNT;
+                continue;
+            }
+
+            switch (param) {
                 case VTX_PARAM_POWER:
                     vtxUpdatePending = vtxProcessPower(vtxDevice);
                     break;
@@ -275,6 +333,9 @@ void vtxUpdate(timeUs_t currentTimeUs)
                 default:
                     break;
             }
+            if (param == VTX_PARAM_POWER || param == VTX_PARAM_BANDCHAN) {
+                vtxRetryUpdate(param, vtxUpdatePending, currentTimeUs);
+            }
             currentSchedule = (currentSchedule + 1) % VTX_PARAM_COUNT;
         } while (!vtxUpdatePending && currentSchedule != startingSchedule);
 
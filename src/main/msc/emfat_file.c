@@ -287,7 +287,8 @@ void emfat_init_files(void)
     flashfsInit();
     LED0_OFF;
 
-    flashfsUsedSpace = flashfsIdentifyStartOfFreeSpace();
+    // flashfsInit() has already located the start of the free space
+    flashfsUsedSpace = flashfsGetOffset();
 
     // Detect and create entries for each individual log
     const int logCount = emfat_find_log(&entries[PREDEFINED_ENTRY_COUNT], EMFAT_MAX_LOG_ENTRY, flashfsUsedSpace);
@@ -29,11 +29,13 @@
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "platform.h"
 
 #ifdef USE_SDCARD
 
+#include "common/maths.h"
 #include "common/utils.h"
 
 #include "drivers/dma.h"
@@ -73,6 +75,22 @@
 #define STORAGE_BLK_NBR                  0x10000
 #define STORAGE_BLK_SIZ                  0x200
 
+/* The host reads one block per call. Sequential reads are served from two
+ * read-ahead windows: while one is copied out, the card is already
+ * filling the other with the blocks that follow it.
+ */
+#define STORAGE_READ_AHEAD_BLOCKS        8
+
+typedef struct {
+    uint32_t start;
+    uint16_t count;
+} readAheadWindow_t;
+
+static uint8_t readAheadBuffer[2][STORAGE_READ_AHEAD_BLOCKS * STORAGE_BLK_SIZ] __attribute__ ((aligned (32)));
+static readAheadWindow_t readAheadWindow[2];
+static int8_t readAheadPending = -1;
+static uint32_t readAheadNextBlock = 0;
+
 static int8_t STORAGE_Init (uint8_t lun);
 
 #ifdef USE_HAL_DRIVER
@@ -149,6 +167,63 @@ USBD_STORAGE_cb_TypeDef USBD_MSC_MICRO_SDIO_fops =
 };
 #endif
 
+static void readAheadWait(void)
+{
+    if (readAheadPending >= 0) {
+        while (SD_CheckRead());
+        while (SD_GetState() == false);
+        readAheadPending = -1;
+    }
+}
+
+static void readAheadReset(void)
+{
+    readAheadPending = -1;
+    readAheadWindow[0].count = 0;
+    readAheadWindow[1].count = 0;
+}
+
+static void readAheadInvalidate(void)
+{
+    readAheadWait();
+    readAheadReset();
+}
+
+static bool readAheadStart(int index, uint32_t blk_addr)
+{
+    uint32_t count = STORAGE_READ_AHEAD_BLOCKS;
+    if (SD_CardInfo.CardCapacity > 0) {
+        count = MIN(count, SD_CardInfo.CardCapacity - MIN(blk_addr, SD_CardInfo.CardCapacity));
+    }
+
+    readAheadWindow[index].count = 0;
+
+    if (count == 0 || SD_ReadBlocks_DMA(blk_addr, (uint32_t*) readAheadBuffer[index], 512, count) != 0) {
+        return false;
+    }
+
+    readAheadWindow[index].start = blk_addr;
+    readAheadWindow[index].count = count;
+    readAheadPending = index;
+
+    return true;
+}
+
+static int readAheadFind(uint32_t blk_addr, uint16_t blk_len)
+{
+    for (int index = 0; index < 2; index++) {
+        const readAheadWindow_t *window = &readAheadWindow[index];
+        if (blk_addr >= window->start && blk_addr + blk_len <= window->start + window->count) {
+            if (index == readAheadPending) {
+                readAheadWait();
+            }
+            return index;
+        }
+    }
+
+    return -1;
+}
+
 /*******************************************************************************
 * Function Name  : Read_Memory
 * Description    : Handle the Read operation from the microSD card.
@@ -166,6 +241,8 @@ static int8_t STORAGE_Init (uint8_t lun)
     UNUSED(lun);
     LED0_OFF;
 
+    readAheadReset();
+
 #ifdef USE_DMA_SPEC
     const dmaChannelSpec_t *dmaChannelSpec = dmaGetChannelSpecByPeripheral(DMA_PERIPH_SDIO, 0, sdioConfig()->dmaopt);
 
@@ -227,6 +304,7 @@ static int8_t  STORAGE_IsReady (uint8_t lun)
 {
     UNUSED(lun);
     int8_t ret = -1;
+    readAheadWait();
     if (SD_GetState() == true && sdcard_isInserted()) {
         ret = 0;
     }
@@ -260,16 +338,49 @@ static int8_t STORAGE_Read (uint8_t lun,
 {
     UNUSED(lun);
     if (!sdcard_isInserted()) {
+        readAheadReset();
         return -1;
     }
-    //buf should be 32bit aligned, but usually is so we don't do byte alignment
-    if (SD_ReadBlocks_DMA(blk_addr, (uint32_t*) buf, 512, blk_len) == 0) {
-        while (SD_CheckRead());
-        while(SD_GetState() == false);
-        mscSetActive();
-        return 0;
+
+    int index = readAheadFind(blk_addr, blk_len);
+
+    if (index < 0) {
+        readAheadWait();
+
+        if (blk_addr != readAheadNextBlock || blk_len > STORAGE_READ_AHEAD_BLOCKS) {
+            // Random access goes straight to the card
+            readAheadNextBlock = blk_addr + blk_len;
+
+            //buf should be 32bit aligned, but usually is so we don't do byte alignment
+            if (SD_ReadBlocks_DMA(blk_addr, (uint32_t*) buf, 512, blk_len) == 0) {
+                while (SD_CheckRead());
+                while(SD_GetState() == false);
+                mscSetActive();
+                return 0;
+            }
+            return -1;
+        }
+
+        index = 0;
+        if (!readAheadStart(index, blk_addr)) {
+            return -1;
+        }
+        readAheadWait();
     }
-    return -1;
+
+    const readAheadWindow_t *window = &readAheadWindow[index];
+    memcpy(buf, readAheadBuffer[index] + (blk_addr - window->start) * STORAGE_BLK_SIZ, blk_len * STORAGE_BLK_SIZ);
+    readAheadNextBlock = blk_addr + blk_len;
+
+    // Have the card fetch the following window while the host takes this one
+    const int other = index ^ 1;
+    const uint32_t windowEnd = window->start + window->count;
+    if (readAheadPending < 0 && (readAheadWindow[other].count == 0 || readAheadWindow[other].start != windowEnd)) {
+        readAheadStart(other, windowEnd);
+    }
+
+    mscSetActive();
+    return 0;
 }
 /*******************************************************************************
 * Function Name  : Write_Memory
@@ -287,6 +398,7 @@ static int8_t STORAGE_Write (uint8_t lun,
     if (!sdcard_isInserted()) {
         return -1;
     }
+    readAheadInvalidate();
     //buf should be 32bit aligned, but usually is so we don't do byte alignment
     if (SD_WriteBlocks_DMA(blk_addr, (uint32_t*) buf, 512, blk_len) == 0) {
         while (SD_CheckWrite());
@@ -33,6 +33,7 @@
 
 #include "build/build_config.h"
 #include "build/debug.h"
+#include "build/profiler.h"
 #include "build/version.h"
 
 #include "cli/cli.h"
@@ -40,6 +41,7 @@
 #include "common/axis.h"
 #include "common/bitarray.h"
 #include "common/color.h"
+#include "common/crc.h"
 #include "common/huffman.h"
 #include "common/maths.h"
 #include "common/streambuf.h"
@@ -72,11 +74,13 @@
 #include "drivers/freq.h"
 
 #include "fc/board_info.h"
+#include "fc/boot_timeline.h"
 #include "fc/rc_rates.h"
 #include "fc/core.h"
 #include "fc/dispatch.h"
 #include "fc/rc.h"
 #include "fc/rc_adjustments.h"
+#include "fc/eventlog.h"
 #include "fc/rc_controls.h"
 #include "fc/rc_modes.h"
 #include "fc/runtime_config.h"
@@ -88,13 +92,16 @@
 #include "flight/mixer.h"
 #include "flight/pid.h"
 #include "flight/position.h"
+#include "flight/setpoint.h"
 #include "flight/rpm_filter.h"
 #include "flight/servos.h"
 #include "flight/governor.h"
+#include "flight/vibration.h"
 
 #include "io/asyncfatfs/asyncfatfs.h"
 #include "io/beeper.h"
 #include "io/flashfs.h"
+#include "io/flashlog.h"
 #include "io/gps.h"
 #include "io/ledstrip.h"
 #include "io/serial.h"
@@ -233,6 +240,9 @@ static bool mspIsMspArmingEnabled(void)
 
 #define MSP_PASSTHROUGH_ESC_4WAY 0xff
 
+// Payload bytes per MSP2_GET/SET_CONFIG_BLOB chunk
+#define MSP_CONFIG_BLOB_CHUNK_SIZE 128u
+
 static uint8_t mspPassthroughMode;
 static uint8_t mspPassthroughArgument;
 
@@ -397,7 +407,7 @@ void mspReboot(dispatchEntry_t* self)
 
 dispatchEntry_t mspRebootEntry =
 {
-    mspReboot, 0, NULL, false
+    .dispatch = mspReboot,
 };
 
 void writeReadEeprom(dispatchEntry_t* self)
@@ -421,7 +431,7 @@ void writeReadEeprom(dispatchEntry_t* self)
 
 dispatchEntry_t writeReadEepromEntry =
 {
-    writeReadEeprom, 0, NULL, false
+    .dispatch = writeReadEeprom,
 };
 
 static void serializeSDCardSummaryReply(sbuf_t *dst)
@@ -504,6 +514,46 @@ static void serializeDataflashSummaryReply(sbuf_t *dst)
     }
 }
 
+#ifdef USE_HUFFMAN
+/*
+ * Code the reply payload written since payload, if the request allows it
+ * and the coded payload with its uncompressed size is shorter.
+ */
+void mspHuffmanReply(const mspPacket_t *cmd, mspPacket_t *reply, uint8_t *payload)
+{
+    static uint8_t codeBuf[MSP_HUFFMAN_SIZE_MAX];
+
+    const int size = reply->buf.ptr - payload;
+
+    if (!(cmd->flags & MSP_FLAG_HUFFMAN) || size < MSP_HUFFMAN_SIZE_MIN || size > MSP_HUFFMAN_SIZE_MAX) {
+        return;
+    }
+
+    // The encoder clears one byte past the limit before it gives up
+    huffmanState_t state = {
+        .bytesWritten = 0,
+        .outByte = codeBuf,
+        .outBufLen = size - HUFFMAN_INFO_SIZE - 1,
+        .outBit = 0x80,
+    };
+    *state.outByte = 0;
+
+    if (huffmanEncodeBufStreaming(&state, payload, size, huffmanTable) == -1) {
+        // no gain
+        return;
+    }
+
+    if (state.outBit != 0x80) {
+        ++state.bytesWritten;
+    }
+
+    reply->buf.ptr = payload;
+    sbufWriteU16(&reply->buf, size);
+    sbufWriteData(&reply->buf, codeBuf, state.bytesWritten);
+    reply->flags |= MSP_FLAG_HUFFMAN;
+}
+#endif
+
 #ifdef USE_FLASHFS
 enum compressionType_e {
     NO_COMPRESSION,
@@ -763,11 +813,17 @@ static bool mspCommonProcessOutCommand(int16_t cmdMSP, sbuf_t *dst, mspPostProce
         break;
 
     case MSP_ANALOG:
-        sbufWriteU8(dst, (uint8_t)constrain(getLegacyBatteryVoltage(), 0, UINT8_MAX));
-        sbufWriteU16(dst, (uint16_t)constrain(getBatteryCapacityUsed(), 0, UINT16_MAX));
-        sbufWriteU16(dst, getRssi());
-        sbufWriteU16(dst, (uint16_t)constrain(getBatteryCurrent(), 0, UINT16_MAX));
-        sbufWriteU16(dst, (uint16_t)constrain(getBatteryVoltage(), 0, UINT16_MAX));
+        {
+            uint8_t *ptr = sbufReserve(dst, 9);
+            if (ptr) {
+                ptr = sbufPutU8(ptr, (uint8_t)constrain(getLegacyBatteryVoltage(), 0, UINT8_MAX));
+                ptr = sbufPutU16(ptr, (uint16_t)constrain(getBatteryCapacityUsed(), 0, UINT16_MAX));
+                ptr = sbufPutU16(ptr, getRssi());
+                ptr = sbufPutU16(ptr, (uint16_t)constrain(getBatteryCurrent(), 0, UINT16_MAX));
+                ptr = sbufPutU16(ptr, (uint16_t)constrain(getBatteryVoltage(), 0, UINT16_MAX));
+                sbufCommit(dst, ptr);
+            }
+        }
         break;
 
     case MSP_DEBUG:
@@ -1076,22 +1132,26 @@ static bool mspProcessOutCommand(int16_t cmdMSP, sbuf_t *dst)
             }
 #endif
 
-            for (int i = 0; i < 3; i++) {
+            uint8_t *ptr = sbufReserve(dst, 18);
+            if (ptr) {
+                for (int i = 0; i < 3; i++) {
 #if defined(USE_ACC)
-                sbufWriteU16(dst, lrintf(acc.accADC[i] / scale));
+                    ptr = sbufPutU16(ptr, lrintf(acc.accADC[i] / scale));
 #else
-                sbufWriteU16(dst, 0);
+                    ptr = sbufPutU16(ptr, 0);
 #endif
-            }
-            for (int i = 0; i < 3; i++) {
-                sbufWriteU16(dst, gyroRateDps(i));
-            }
-            for (int i = 0; i < 3; i++) {
+                }
+                for (int i = 0; i < 3; i++) {
+                    ptr = sbufPutU16(ptr, gyroRateDps(i));
+                }
+                for (int i = 0; i < 3; i++) {
 #if defined(USE_MAG)
-                sbufWriteU16(dst, lrintf(mag.magADC[i]));
+                    ptr = sbufPutU16(ptr, lrintf(mag.magADC[i]));
 #else
-                sbufWriteU16(dst, 0);
+                    ptr = sbufPutU16(ptr, 0);
 #endif
+                }
+                sbufCommit(dst, ptr);
             }
         }
         break;
@@ -1107,8 +1167,14 @@ static bool mspProcessOutCommand(int16_t cmdMSP, sbuf_t *dst)
 
 #ifdef USE_SERVOS
     case MSP_SERVO:
-        for (int i = 0; i < MAX_SUPPORTED_SERVOS; i++) {
-            sbufWriteU16(dst, getServoOutput(i));
+        {
+            uint8_t *ptr = sbufReserve(dst, MAX_SUPPORTED_SERVOS * 2);
+            if (ptr) {
+                for (int i = 0; i < MAX_SUPPORTED_SERVOS; i++) {
+                    ptr = sbufPutU16(ptr, getServoOutput(i));
+                }
+                sbufCommit(dst, ptr);
+            }
         }
         break;
 
@@ -1247,9 +1313,111 @@ static bool mspProcessOutCommand(int16_t cmdMSP, sbuf_t *dst)
         }
 #endif
 
+#ifdef USE_LOOP_PROFILER
+    case MSP2_GET_LOOP_PROFILE:
+        sbufWriteU8(dst, profileIsActive() ? PROFILE_STAGE_COUNT : 0);
+        sbufWriteU8(dst, PROFILE_HISTOGRAM_BUCKETS);
+        if (profileIsActive()) {
+            for (profileStage_e stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+                profileStage_t info;
+                getProfileStage(stage, &info);
+                sbufWriteU32(dst, info.count);
+                sbufWriteU16(dst, clockCyclesTo10thMicros(info.minCycles));
+                sbufWriteU16(dst, clockCyclesTo10thMicros(profileStageMeanCycles(&info)));
+                sbufWriteU16(dst, clockCyclesTo10thMicros(info.maxCycles));
+                for (int bucket = 0; bucket < PROFILE_HISTOGRAM_BUCKETS; bucket++) {
+                    sbufWriteU16(dst, MIN(info.histogram[bucket], (uint32_t)UINT16_MAX));
+                }
+            }
+            profileReset();
+        }
+        break;
+#endif
+
+#ifdef USE_TASK_BUDGET_STATISTICS
+    case MSP2_GET_TASK_BUDGET:
+        // Only the tasks that have run, to keep the reply within the minimum MSP buffer
+        for (taskId_e taskId = 0; taskId < TASK_COUNT; taskId++) {
+            taskInfo_t taskInfo;
+            getTaskInfo(taskId, &taskInfo);
+            if (!taskInfo.isEnabled || !taskInfo.budgetSamples) {
+                continue;
+            }
+            sbufWriteU8(dst, taskId);
+            sbufWriteU32(dst, taskInfo.budgetSamples);
+            sbufWriteU16(dst, MIN(taskInfo.percentileExecutionTimeUs, (timeUs_t)UINT16_MAX));
+            sbufWriteU16(dst, MIN(taskInfo.worstExecutionTimeUs, (timeUs_t)UINT16_MAX));
+            sbufWriteU32(dst, taskInfo.deadlineOverrunCount);
+            sbufWriteU16(dst, MIN(taskInfo.maxDeadlineOverrunUs, (timeUs_t)UINT16_MAX));
+            schedulerResetTaskBudget(taskId);
+        }
+        break;
+#endif
+
+#ifdef USE_VIBRATION_ANALYSIS
+    case MSP2_GET_VIBRATION:
+        {
+            const vibration_t *vib = vibrationGetData();
+            sbufWriteU16(dst, vib->mainFreq);
+            sbufWriteU16(dst, vib->tailFreq);
+            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+                sbufWriteU16(dst, vib->mainRotor[axis]);
+                sbufWriteU16(dst, vib->tailRotor[axis]);
+                sbufWriteU16(dst, vib->rms[axis]);
+            }
+        }
+        break;
+#endif
+
+#ifdef USE_GOVERNOR_AUTOTUNE
+    case MSP2_GET_GOV_AUTOTUNE:
+        {
+            const govAutotune_t *autotune = getGovernorAutotune();
+            sbufWriteU8(dst, autotune->state);
+            sbufWriteU8(dst, autotune->steps);
+            sbufWriteU16(dst, constrain(lrintf(autotune->gain * 1000), 0, UINT16_MAX));
+            sbufWriteU16(dst, constrain(lrintf(autotune->delay * 1000), 0, UINT16_MAX));
+            sbufWriteU16(dst, constrain(lrintf(autotune->tau * 1000), 0, UINT16_MAX));
+            sbufWriteU8(dst, autotune->p_gain);
+            sbufWriteU8(dst, autotune->i_gain);
+            sbufWriteU8(dst, autotune->d_gain);
+        }
+        break;
+#endif
+
+    case MSP2_GET_RX_LATENCY:
+        {
+            const setpointLatency_t *rxLatency = getSetpointLatency();
+            sbufWriteU16(dst, rxLatency->min);
+            sbufWriteU16(dst, rxLatency->avg);
+            sbufWriteU16(dst, rxLatency->max);
+            sbufWriteU16(dst, rxLatency->jitter);
+        }
+        break;
+
+#ifdef USE_SDCARD
+    case MSP2_GET_SDCARD_LATENCY:
+        sbufWriteU8(dst, SDCARD_LATENCY_BUCKET_COUNT);
+        sbufWriteU16(dst, SDCARD_LATENCY_BUCKET_BASE_US);
+        for (int op = SDCARD_BLOCK_OPERATION_READ; op <= SDCARD_BLOCK_OPERATION_WRITE; op++) {
+            const sdcardLatencyStats_t *stats = sdcard_getLatencyStats(op);
+            for (int i = 0; i < SDCARD_LATENCY_BUCKET_COUNT; i++) {
+                sbufWriteU32(dst, stats->bucket[i]);
+            }
+            sbufWriteU32(dst, stats->maxUs);
+        }
+        break;
+#endif
+
     case MSP_RC:
-        for (int i = 0; i < activeRcChannelCount; i++) {
-            sbufWriteU16(dst, (int16_t)rcInput[i]);
+        {
+            uint8_t *ptr = sbufReserve(dst, activeRcChannelCount * 2);
+            if (ptr) {
+                for (int i = 0; i < activeRcChannelCount; i++) {
+                    ptr = sbufPutU16(ptr, (int16_t)rcInput[i]);
+                }
+                sbufCommit(dst, ptr);
+            }
         }
         break;
 
@@ -1267,9 +1435,15 @@ static bool mspProcessOutCommand(int16_t cmdMSP, sbuf_t *dst)
         break;
 
     case MSP_ATTITUDE:
-        sbufWriteU16(dst, attitude.values.roll);
-        sbufWriteU16(dst, attitude.values.pitch);
-        sbufWriteU16(dst, DECIDEGREES_TO_DEGREES(attitude.values.yaw));
+        {
+            uint8_t *ptr = sbufReserve(dst, 6);
+            if (ptr) {
+                ptr = sbufPutU16(ptr, attitude.values.roll);
+                ptr = sbufPutU16(ptr, attitude.values.pitch);
+                ptr = sbufPutU16(ptr, DECIDEGREES_TO_DEGREES(attitude.values.yaw));
+                sbufCommit(dst, ptr);
+            }
+        }
         break;
 
     case MSP_ALTITUDE:
@@ -1952,6 +2126,8 @@ static bool mspProcessOutCommand(int16_t cmdMSP, sbuf_t *dst)
         sbufWriteU8(dst, governorConfig()->gov_rpm_filter);
         sbufWriteU8(dst, governorConfig()->gov_tta_filter);
         sbufWriteU8(dst, governorConfig()->gov_ff_filter);
+        sbufWriteU8(dst, governorConfig()->gov_latency_comp);
+        sbufWriteU8(dst, governorConfig()->gov_sag_comp);
         break;
 
     default:
@@ -1976,6 +2152,119 @@ static mspResult_e mspFcProcessOutCommandWithArg(mspDescriptor_t srcDesc, int16_
             serializeBoxReply(dst, page, &serializeBoxPermanentIdFn);
         }
         break;
+#ifdef USE_SCHEDULER_TRACE
+    case MSP2_GET_SCHEDULER_TRACE:
+        {
+            const unsigned page = sbufBytesRemaining(src) ? sbufReadU8(src) : 0;
+            const unsigned count = (schedulerTraceState() == SCHEDULER_TRACE_FROZEN) ? schedulerTraceCount() : 0;
+            const unsigned first = page * SCHEDULER_TRACE_PAGE_SIZE;
+            const unsigned entries = (first < count) ? MIN(count - first, SCHEDULER_TRACE_PAGE_SIZE) : 0;
+
+            sbufWriteU8(dst, schedulerTraceState());
+            sbufWriteU16(dst, count);
+            sbufWriteU16(dst, clockMicrosToCycles(1));
+            sbufWriteU8(dst, page);
+            sbufWriteU8(dst, entries);
+
+            for (unsigned index = first; index < first + entries; index++) {
+                const schedulerTraceEntry_t *entry = schedulerTraceGet(index);
+                sbufWriteU32(dst, entry->startCycles);
+                sbufWriteU32(dst, entry->durationCycles);
+                sbufWriteU8(dst, entry->taskId);
+                sbufWriteU8(dst, entry->priority);
+                sbufWriteU8(dst, entry->flags);
+            }
+        }
+        break;
+#endif
+#ifdef USE_FLASH_LOG
+    case MSP2_GET_FLASH_LOG:
+        {
+            const unsigned first = (sbufBytesRemaining(src) >= 2) ? sbufReadU16(src) : 0;
+            const unsigned count = flashLogCount();
+            const unsigned entries = (first < count) ? MIN(count - first, FLASH_LOG_PAGE_SIZE) : 0;
+
+            sbufWriteU16(dst, count);
+            sbufWriteU16(dst, first);
+            sbufWriteU8(dst, entries);
+
+            // Records are sent as stored, the CRC is checked by the reader
+            for (unsigned index = first; index < first + entries; index++) {
+                flashLogRecord_t record;
+                flashLogRead(index, &record);
+                sbufWriteData(dst, &record, sizeof(record));
+            }
+        }
+        break;
+#endif
+#ifdef USE_BOOT_TIMELINE
+    case MSP2_GET_BOOT_TIMELINE:
+        {
+            const unsigned page = sbufBytesRemaining(src) ? sbufReadU8(src) : 0;
+            const unsigned count = bootTimelineCount();
+            const unsigned first = page * BOOT_TIMELINE_PAGE_SIZE;
+            const unsigned entries = (first < count) ? MIN(count - first, BOOT_TIMELINE_PAGE_SIZE) : 0;
+
+            sbufWriteU8(dst, count);
+            sbufWriteU8(dst, page);
+            sbufWriteU8(dst, entries);
+
+            for (unsigned index = first; index < first + entries; index++) {
+                const bootTimelineEntry_t *entry = bootTimelineGet(index);
+                sbufWriteU32(dst, entry->timeUs);
+                sbufWriteStringWithZeroTerminator(dst, entry->name);
+            }
+        }
+        break;
+#endif
+#ifdef USE_EVENT_LOG
+    case MSP2_GET_EVENT_LOG:
+        {
+            const unsigned page = sbufBytesRemaining(src) ? sbufReadU8(src) : 0;
+            const unsigned count = eventLogCount();
+            const unsigned first = page * EVENT_LOG_PAGE_SIZE;
+            const unsigned entries = (first < count) ? MIN(count - first, EVENT_LOG_PAGE_SIZE) : 0;
+
+            sbufWriteU16(dst, count);
+            sbufWriteU32(dst, eventLogTotal());
+            sbufWriteU8(dst, page);
+            sbufWriteU8(dst, entries);
+
+            for (unsigned index = first; index < first + entries; index++) {
+                eventLogRecord_t record;
+                eventLogGet(index, &record);
+                sbufWriteU32(dst, record.timeMs);
+                sbufWriteU8(dst, record.boot);
+                sbufWriteU8(dst, record.type);
+                sbufWriteU16(dst, record.value);
+            }
+        }
+        break;
+#endif
+    case MSP2_GET_CONFIG_BLOB:
+        {
+            const unsigned index = (sbufBytesRemaining(src) >= 2) ? sbufReadU16(src) : 0;
+            const unsigned offset = (sbufBytesRemaining(src) >= 2) ? sbufReadU16(src) : 0;
+
+            sbufWriteU16(dst, index);
+            sbufWriteU16(dst, PG_REGISTRY_SIZE);
+
+            if (index < PG_REGISTRY_SIZE) {
+                const pgRegistry_t *reg = &__pg_registry_start[index];
+                const unsigned size = pgSize(reg);
+                const unsigned length = (offset < size) ? MIN(size - offset, MSP_CONFIG_BLOB_CHUNK_SIZE) : 0;
+
+                sbufWriteU16(dst, pgN(reg));
+                sbufWriteU8(dst, pgVersion(reg));
+                sbufWriteU16(dst, size);
+                sbufWriteU16(dst, offset);
+                sbufWriteU16(dst, crc16_ccitt_update(0, reg->address, size));
+                sbufWriteU8(dst, length);
+                sbufWriteData(dst, reg->address + offset, length);
+            }
+        }
+        break;
+
     case MSP_REBOOT:
         if (sbufBytesRemaining(src)) {
             rebootMode = sbufReadU8(src);
@@ -2427,6 +2716,7 @@ static mspResult_e mspProcessInCommand(mspDescriptor_t srcDesc, int16_t cmdMSP,
         servoParamsMutable(i)->rate = sbufReadU16(src);
         servoParamsMutable(i)->speed = sbufReadU16(src);
         servoParamsMutable(i)->flags = sbufReadU16(src);
+        servoUpdateLimits(i);
         break;
 
     case MSP_SET_SERVO_OVERRIDE:
@@ -2864,6 +3154,52 @@ static mspResult_e mspProcessInCommand(mspDescriptor_t srcDesc, int16_t cmdMSP,
         break;
 #endif
 
+    case MSP2_SET_CONFIG_BLOB:
+        {
+            // Chunks are collected in the PG copy, and applied when complete and valid
+            if (ARMING_FLAG(ARMED) || sbufBytesRemaining(src) < 10) {
+                return MSP_RESULT_ERROR;
+            }
+
+            const pgn_t pgn = sbufReadU16(src);
+            const uint8_t version = sbufReadU8(src);
+            const unsigned size = sbufReadU16(src);
+            const unsigned offset = sbufReadU16(src);
+            const uint16_t crc = sbufReadU16(src);
+            const unsigned length = sbufReadU8(src);
+
+            const pgRegistry_t *reg = pgFind(pgn);
+
+            if (!reg || version != pgVersion(reg) || size != pgSize(reg) ||
+                offset + length > size || length > (unsigned)sbufBytesRemaining(src)) {
+                return MSP_RESULT_ERROR;
+            }
+
+            sbufReadData(src, reg->copy + offset, length);
+
+            if (offset + length == size) {
+                if (crc16_ccitt_update(0, reg->copy, size) != crc) {
+                    return MSP_RESULT_ERROR;
+                }
+                memcpy(reg->address, reg->copy, size);
+            }
+        }
+        break;
+
+#ifdef USE_SCHEDULER_TRACE
+    case MSP2_SET_SCHEDULER_TRACE:
+        {
+            const uint8_t enable = sbufReadU8(src);
+            const timeUs_t triggerUs = (sbufBytesRemaining(src) >= 2) ? sbufReadU16(src) : SCHEDULER_TRACE_TRIGGER_US;
+
+            if (enable)
+                schedulerTraceStart(triggerUs);
+            else
+                schedulerTraceStop();
+        }
+        break;
+#endif
+
 #ifdef USE_DSHOT
     case MSP2_SEND_DSHOT_COMMAND:
         {
@@ -2986,6 +3322,7 @@ static mspResult_e mspProcessInCommand(mspDescriptor_t srcDesc, int16_t cmdMSP,
         mixerInputsMutable(i)->rate = sbufReadU16(src);
         mixerInputsMutable(i)->min = sbufReadU16(src);
         mixerInputsMutable(i)->max = sbufReadU16(src);
+        mixerInitConfig();
         break;
 
     case MSP_SET_MIXER_RULE:
@@ -2998,6 +3335,7 @@ static mspResult_e mspProcessInCommand(mspDescriptor_t srcDesc, int16_t cmdMSP,
         mixerRulesMutable(i)->output = sbufReadU8(src);
         mixerRulesMutable(i)->offset = sbufReadU16(src);
         mixerRulesMutable(i)->weight = sbufReadU16(src);
+        mixerInitConfig();
         break;
 
     case MSP_SET_MIXER_OVERRIDE:
@@ -3271,6 +3609,12 @@ static mspResult_e mspProcessInCommand(mspDescriptor_t srcDesc, int16_t cmdMSP,
         governorConfigMutable()->gov_rpm_filter = sbufReadU8(src);
         governorConfigMutable()->gov_tta_filter = sbufReadU8(src);
         governorConfigMutable()->gov_ff_filter = sbufReadU8(src);
+        if (sbufBytesRemaining(src) >= 1) {
+            governorConfigMutable()->gov_latency_comp = sbufReadU8(src);
+        }
+        if (sbufBytesRemaining(src) >= 1) {
+            governorConfigMutable()->gov_sag_comp = sbufReadU8(src);
+        }
         break;
 
     default:
@@ -3476,6 +3820,112 @@ static mspResult_e mspCommonProcessInCommand(mspDescriptor_t srcDesc, int16_t cm
     return MSP_RESULT_ACK;
 }
 
+typedef enum {
+    MSP_HANDLER_COMMON_OUT,
+    MSP_HANDLER_OUT,
+    MSP_HANDLER_OUT_WITH_ARG,
+    MSP_HANDLER_IN,
+} mspHandler_e;
+
+typedef struct {
+    uint16_t cmd;
+    uint8_t handler;
+} mspCommandEntry_t;
+
+// Commands polled by the configurator and the telemetry MSP passthrough,
+// sorted by command ID. These go straight to the function handling them
+// instead of falling through the other handlers first. All the other
+// commands take the full path in mspFcProcessCommand().
+static const mspCommandEntry_t mspCommandTable[] = {
+    { MSP_STATUS,               MSP_HANDLER_OUT },
+    { MSP_RAW_IMU,              MSP_HANDLER_OUT },
+#ifdef USE_SERVOS
+    { MSP_SERVO,                MSP_HANDLER_OUT },
+#endif
+    { MSP_MOTOR,                MSP_HANDLER_OUT },
+    { MSP_RC,                   MSP_HANDLER_OUT },
+#ifdef USE_GPS
+    { MSP_RAW_GPS,              MSP_HANDLER_OUT },
+    { MSP_COMP_GPS,             MSP_HANDLER_OUT },
+#endif
+    { MSP_ATTITUDE,             MSP_HANDLER_OUT },
+    { MSP_ALTITUDE,             MSP_HANDLER_OUT },
+    { MSP_ANALOG,               MSP_HANDLER_COMMON_OUT },
+    { MSP_RC_COMMAND,           MSP_HANDLER_OUT },
+    { MSP_RX_CHANNELS,          MSP_HANDLER_OUT },
+    { MSP_BOXIDS,               MSP_HANDLER_OUT_WITH_ARG },
+    { MSP_VOLTAGE_METERS,       MSP_HANDLER_COMMON_OUT },
+    { MSP_CURRENT_METERS,       MSP_HANDLER_COMMON_OUT },
+    { MSP_BATTERY_STATE,        MSP_HANDLER_COMMON_OUT },
+    { MSP_MOTOR_TELEMETRY,      MSP_HANDLER_OUT },
+    { MSP_MIXER_INPUTS,         MSP_HANDLER_OUT },
+    { MSP_SET_TX_INFO,          MSP_HANDLER_IN },
+    { MSP_TX_INFO,              MSP_HANDLER_OUT },
+    { MSP_MIXER_OVERRIDE,       MSP_HANDLER_OUT },
+    { MSP_SET_MIXER_OVERRIDE,   MSP_HANDLER_IN },
+#ifdef USE_SERVOS
+    { MSP_SERVO_OVERRIDE,       MSP_HANDLER_OUT },
+    { MSP_SET_SERVO_OVERRIDE,   MSP_HANDLER_IN },
+#endif
+    { MSP_MOTOR_OVERRIDE,       MSP_HANDLER_OUT },
+    { MSP_SET_MOTOR_OVERRIDE,   MSP_HANDLER_IN },
+    { MSP_SET_RAW_RC,           MSP_HANDLER_IN },
+    { MSP_SET_MOTOR,            MSP_HANDLER_IN },
+    { MSP_DEBUG,                MSP_HANDLER_COMMON_OUT },
+};
+
+static const mspCommandEntry_t *mspFindCommand(uint16_t cmd)
+{
+    unsigned lo = 0;
+    unsigned hi = ARRAYLEN(mspCommandTable);
+
+    while (lo < hi) {
+        const unsigned mid = (lo + hi) / 2;
+        if (mspCommandTable[mid].cmd < cmd) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo < ARRAYLEN(mspCommandTable) && mspCommandTable[lo].cmd == cmd) {
+        return &mspCommandTable[lo];
+    }
+
+    return NULL;
+}
+
+static bool mspDispatchCommand(const mspCommandEntry_t *entry, mspDescriptor_t srcDesc, sbuf_t *src, sbuf_t *dst, mspPostProcessFnPtr *mspPostProcessFn, mspResult_e *ret)
+{
+    switch (entry->handler) {
+    case MSP_HANDLER_COMMON_OUT:
+        if (!mspCommonProcessOutCommand(entry->cmd, dst, mspPostProcessFn)) {
+            return false;
+        }
+        *ret = MSP_RESULT_ACK;
+        break;
+    case MSP_HANDLER_OUT:
+        if (!mspProcessOutCommand(entry->cmd, dst)) {
+            return false;
+        }
+        *ret = MSP_RESULT_ACK;
+        break;
+    case MSP_HANDLER_OUT_WITH_ARG:
+        *ret = mspFcProcessOutCommandWithArg(srcDesc, entry->cmd, src, dst, mspPostProcessFn);
+        if (*ret == MSP_RESULT_CMD_UNKNOWN) {
+            return false;
+        }
+        break;
+    case MSP_HANDLER_IN:
+        *ret = mspProcessInCommand(srcDesc, entry->cmd, src);
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
 /*
  * Returns MSP_RESULT_ACK, MSP_RESULT_ERROR or MSP_RESULT_NO_REPLY
  */
@@ -3488,6 +3938,14 @@ mspResult_e mspFcProcessCommand(mspDescriptor_t srcDesc, mspPacket_t *cmd, mspPa
     // initialize reply by default
     reply->cmd = cmd->cmd;
 
+    const mspCommandEntry_t *entry = mspFindCommand(cmdMSP);
+    mspResult_e result;
+
+    if (entry && mspDispatchCommand(entry, srcDesc, src, dst, mspPostProcessFn, &result)) {
+        reply->result = result;
+        return result;
+    }
+
     if (mspCommonProcessOutCommand(cmdMSP, dst, mspPostProcessFn)) {
         ret = MSP_RESULT_ACK;
     } else if (mspProcessOutCommand(cmdMSP, dst)) {
@@ -50,10 +50,19 @@ typedef struct mspPacket_s {
     sbuf_t buf;         // payload only w/o header or crc
     int16_t cmd;
     int16_t result;
-    uint8_t flags;      // MSPv2 flags byte. It looks like unused (yet?).
+    uint8_t flags;      // MSPv2 flags byte, MSP_FLAG_*
     uint8_t direction;  // It also looks like unused and might be deleted.
 } mspPacket_t;
 
+// The host sets MSP_FLAG_HUFFMAN in a request to accept a Huffman coded
+// reply. A reply that is coded has the flag set too, and its payload is the
+// U16 uncompressed size followed by the code bits; older firmware never
+// sets the flag, so no further negotiation is needed.
+#define MSP_FLAG_HUFFMAN        (1 << 1)
+
+#define MSP_HUFFMAN_SIZE_MIN    32      // shorter replies are sent as they are
+#define MSP_HUFFMAN_SIZE_MAX    320
+
 typedef int mspDescriptor_t;
 
 struct serialPort_s;
@@ -67,3 +76,9 @@ mspResult_e mspFcProcessCommand(mspDescriptor_t srcDesc, mspPacket_t *cmd, mspPa
 void mspFcProcessReply(mspPacket_t *reply);
 
 mspDescriptor_t mspDescriptorAlloc(void);
+
+#ifdef USE_HUFFMAN
+void mspHuffmanReply(const mspPacket_t *cmd, mspPacket_t *reply, uint8_t *payload);
+#else
+static inline void mspHuffmanReply(const mspPacket_t *cmd, mspPacket_t *reply, uint8_t *payload) { (void)cmd; (void)reply; (void)payload; }
+#endif
@@ -24,6 +24,8 @@
 
 #include "platform.h"
 
+#include "blackbox/blackbox.h"
+
 #include "common/bitarray.h"
 #include "common/streambuf.h"
 #include "common/utils.h"
@@ -33,6 +35,7 @@
 #include "config/config.h"
 #include "fc/runtime_config.h"
 
+#include "flight/governor.h"
 #include "flight/mixer.h"
 #include "flight/pid.h"
 
@@ -101,6 +104,9 @@ static const box_t boxes[CHECKBOX_ITEM_COUNT] =
     BOXITEM(BOXSTICKCOMMANDDISABLE, "STICK COMMANDS DISABLE", 51),
     BOXITEM(BOXBEEPERMUTE, "BEEPER MUTE", 52),
     BOXITEM(BOXRESCUE, "RESCUE", 53),
+    BOXITEM(BOXBLACKBOXTRIGGER, "BLACKBOX TRIGGER", 54),
+    BOXITEM(BOXGOVTUNE, "GOVERNOR AUTOTUNE", 55),
+    BOXITEM(BOXSYSID, "SYSTEM ID", 56),
 };
 
 // mask of enabled IDs, calculated on startup based on enabled features. boxId_e is used as bit index
@@ -219,6 +225,9 @@ void initActiveBoxIds(void)
 
 #ifdef USE_BLACKBOX
     BME(BOXBLACKBOX);
+    if (blackboxConfig()->trigger & BIT(BLACKBOX_TRIGGER_SWITCH)) {
+        BME(BOXBLACKBOXTRIGGER);
+    }
 #ifdef USE_FLASHFS
     BME(BOXBLACKBOXERASE);
 #endif
@@ -267,6 +276,16 @@ void initActiveBoxIds(void)
 
     BME(BOXSTICKCOMMANDDISABLE);
 
+#ifdef USE_GOVERNOR_AUTOTUNE
+    if (governorConfig()->gov_mode >= GM_STANDARD) {
+        BME(BOXGOVTUNE);
+    }
+#endif
+
+#ifdef USE_SYSID
+    BME(BOXSYSID);
+#endif
+
 #undef BME
     // check that all enabled IDs are in boxes array (check may be skipped when using findBoxById() functions)
     for (boxId_e boxId = 0;  boxId < CHECKBOX_ITEM_COUNT; boxId++)
@@ -24,3 +24,19 @@
 #define MSP2_SEND_DSHOT_COMMAND             0x3003
 #define MSP2_GET_VTX_DEVICE_STATUS          0x3004
 #define MSP2_GET_OSD_WARNINGS               0x3005  // returns active OSD warning message text
+#define MSP2_GET_LOOP_PROFILE               0x3006  // returns per-stage loop profiler statistics
+#define MSP2_GET_SCHEDULER_TRACE            0x3007  // returns one page of the frozen scheduler trace
+#define MSP2_SET_SCHEDULER_TRACE            0x3008  // arms or stops the scheduler trace
+#define MSP2_SET_MSP_SUBSCRIPTION           0x3009  // sets the MSP commands pushed periodically on this port
+#define MSP2_MSP_SUBSCRIPTION_DATA          0x300A  // pushed frame with the replies of the subscribed commands
+#define MSP2_GET_CONFIG_BLOB                0x300B  // returns a chunk of a raw parameter group
+#define MSP2_SET_CONFIG_BLOB                0x300C  // writes a chunk of a raw parameter group
+#define MSP2_GET_RX_LATENCY                 0x300D  // returns RX frame to setpoint latency statistics
+#define MSP2_GET_SDCARD_LATENCY             0x300E  // returns SD card read/write latency histograms
+#define MSP2_GET_TASK_BUDGET                0x300F  // returns per-task execution percentile and gyro deadline overruns
+#define MSP2_DATAFLASH_STREAM               0x3010  // streams a range of the dataflash as back to back MSP_DATAFLASH_READ replies
+#define MSP2_GET_VIBRATION                  0x3011  // returns rotor order amplitudes and broadband RMS of the accelerometer
+#define MSP2_GET_EVENT_LOG                  0x3012  // returns one page of the runtime event log
+#define MSP2_GET_GOV_AUTOTUNE               0x3013  // returns the governor autotune state and results
+#define MSP2_GET_FLASH_LOG                  0x3014  // returns a run of raw records from the flash log
+#define MSP2_GET_BOOT_TIMELINE              0x3015  // returns one page of the init phase timestamps
@@ -28,6 +28,7 @@
 
 #include "cli/cli.h"
 
+#include "common/maths.h"
 #include "common/streambuf.h"
 #include "common/utils.h"
 #include "common/crc.h"
@@ -35,13 +36,36 @@
 #include "drivers/system.h"
 
 #include "io/displayport_msp.h"
+#include "io/flashfs.h"
 
 #include "msp/msp.h"
+#include "msp/msp_protocol.h"
+#include "msp/msp_protocol_v2_betaflight.h"
 
 #include "msp_serial.h"
 
 static mspPort_t mspPorts[MAX_MSP_PORT_COUNT];
 
+static uint8_t mspSerialOutBuf[MSP_PORT_OUTBUF_SIZE];
+
+// Commands without side effects that may be subscribed to
+static const uint16_t mspSubscribableCommands[] = {
+    MSP_STATUS,
+    MSP_RAW_IMU,
+    MSP_SERVO,
+    MSP_MOTOR,
+    MSP_RC,
+    MSP_RAW_GPS,
+    MSP_ATTITUDE,
+    MSP_ALTITUDE,
+    MSP_ANALOG,
+    MSP_VOLTAGE_METERS,
+    MSP_CURRENT_METERS,
+    MSP_BATTERY_STATE,
+    MSP_MOTOR_TELEMETRY,
+    MSP_DEBUG,
+};
+
 static void resetMspPort(mspPort_t *mspPortToReset, serialPort_t *serialPort, bool sharedWithTelemetry)
 {
     memset(mspPortToReset, 0, sizeof(mspPort_t));
@@ -391,10 +415,169 @@ static int mspSerialEncode(mspPort_t *msp, mspPacket_t *packet, mspVersion_e msp
     return mspSerialSendFrame(msp, hdrBuf, hdrLen, sbufPtr(&packet->buf), dataLen, crcBuf, crcLen);
 }
 
-static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspProcessCommandFnPtr mspProcessCommandFn)
+static bool mspIsSubscribableCommand(uint16_t cmd)
+{
+    for (unsigned i = 0; i < ARRAYLEN(mspSubscribableCommands); i++) {
+        if (mspSubscribableCommands[i] == cmd) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * MSP2_SET_MSP_SUBSCRIPTION
+ *
+ *   U16 interval in ms (0 = stop)
+ *   U8  number of commands
+ *   U16 command ids
+ *
+ * Replies with the number of commands accepted. The subscription is
+ * handled here, as it belongs to the port rather than to the FC.
+ */
+static void mspSerialSetSubscription(mspPort_t *msp, sbuf_t *src, sbuf_t *dst)
+{
+    mspSubscription_t *sub = &msp->subscription;
+
+    memset(sub, 0, sizeof(*sub));
+
+    if (sbufBytesRemaining(src) >= 3) {
+        const uint16_t interval = sbufReadU16(src);
+        const uint8_t count = sbufReadU8(src);
+
+        for (int i = 0; i < count && sbufBytesRemaining(src) >= 2; i++) {
+            const uint16_t cmd = sbufReadU16(src);
+            if (sub->count < MSP_SUBSCRIPTION_MAX_COMMANDS && mspIsSubscribableCommand(cmd)) {
+                sub->cmd[sub->count++] = cmd;
+            }
+        }
+
+        if (interval) {
+            sub->intervalMs = MAX(interval, MSP_SUBSCRIPTION_MIN_INTERVAL);
+        } else {
+            sub->count = 0;
+        }
+    }
+
+    sub->lastPushMs = millis();
+
+    sbufWriteU8(dst, sub->count);
+}
+
+#ifdef USE_FLASHFS
+
+// MSPv2 over v1 jumbo header, both checksums and the read reply info
+#define MSP_DATAFLASH_STREAM_OVERHEAD   (12 + 2 + 7)
+
+/*
+ * MSP2_DATAFLASH_STREAM
+ *
+ *   U32 start address
+ *   U32 length (0 = stop)
+ *
+ * Replies with the address and length accepted. The range is then
+ * pushed as MSP_DATAFLASH_READ replies, back to back, as fast as the
+ * TX buffer drains. The flash is read while the previous chunk is still
+ * going out, and the host doesn't have to send a request per chunk.
+ * Any other command received on the port stops the stream.
+ */
+static void mspSerialStartDataflashStream(mspPort_t *msp, sbuf_t *src, sbuf_t *dst)
 {
-    static uint8_t mspSerialOutBuf[MSP_PORT_OUTBUF_SIZE];
+    mspDataflashStream_t *stream = &msp->stream;
 
+    stream->address = 0;
+    stream->remaining = 0;
+
+    if (sbufBytesRemaining(src) >= 8) {
+        const uint32_t address = sbufReadU32(src);
+        const uint32_t length = sbufReadU32(src);
+        const uint32_t size = flashfsGetSize();
+
+        if (address < size) {
+            stream->address = address;
+            stream->remaining = MIN(length, size - address);
+        }
+    }
+
+    stream->lastPushMs = millis();
+
+    sbufWriteU32(dst, stream->address);
+    sbufWriteU32(dst, stream->remaining);
+}
+
+static void mspSerialProcessDataflashStream(mspPort_t *msp, mspProcessCommandFnPtr mspProcessCommandFn)
+{
+    mspDataflashStream_t *stream = &msp->stream;
+
+    if (!stream->remaining || msp->c_state != MSP_IDLE) {
+        return;
+    }
+
+    const timeMs_t currentTimeMs = millis();
+
+    // Host gone
+    if (cmp32(currentTimeMs, stream->lastPushMs) > MSP_DATAFLASH_STREAM_TIMEOUT) {
+        stream->remaining = 0;
+        return;
+    }
+
+    for (int i = 0; i < MSP_DATAFLASH_STREAM_BURST && stream->remaining; i++) {
+        // Chunk sized to the free TX buffer space, so that the write never blocks
+        const int room = MIN((int)serialTxBytesFree(msp->port) - MSP_DATAFLASH_STREAM_OVERHEAD, MSP_PORT_DATAFLASH_BUFFER_SIZE);
+        const int length = MIN((uint32_t)MAX(room, 0), stream->remaining);
+
+        if (length == 0 || (length < MSP_DATAFLASH_STREAM_MIN_CHUNK && (uint32_t)length < stream->remaining)) {
+            break;
+        }
+
+        uint8_t requestBuf[7];
+        sbuf_t request = { .ptr = requestBuf, .end = ARRAYEND(requestBuf) };
+
+        sbufWriteU32(&request, stream->address);
+        sbufWriteU16(&request, length);
+        sbufWriteU8(&request, 0);   // no compression
+
+        mspPacket_t reply = {
+            .buf = { .ptr = mspSerialOutBuf, .end = ARRAYEND(mspSerialOutBuf), },
+            .cmd = -1,
+            .flags = 0,
+            .result = 0,
+            .direction = MSP_DIRECTION_REPLY,
+        };
+        mspPacket_t command = {
+            .buf = { .ptr = requestBuf, .end = request.ptr, },
+            .cmd = MSP_DATAFLASH_READ,
+            .flags = 0,
+            .result = 0,
+            .direction = MSP_DIRECTION_REQUEST,
+        };
+
+        mspPostProcessFnPtr mspPostProcessFn = NULL;
+        const mspResult_e status = mspProcessCommandFn(msp->descriptor, &command, &reply, &mspPostProcessFn);
+
+        sbufSwitchToReader(&reply.buf, mspSerialOutBuf);
+
+        // Reply starts with U32 address, U16 read length
+        const uint16_t bytesRead = (sbufBytesRemaining(&reply.buf) >= 6) ? (mspSerialOutBuf[4] | (mspSerialOutBuf[5] << 8)) : 0;
+
+        if (status != MSP_RESULT_ACK || bytesRead == 0) {
+            stream->remaining = 0;
+            break;
+        }
+
+        if (!mspSerialEncode(msp, &reply, msp->mspVersion)) {
+            break;
+        }
+
+        stream->address += bytesRead;
+        stream->remaining -= MIN(bytesRead, stream->remaining);
+        stream->lastPushMs = currentTimeMs;
+    }
+}
+#endif
+
+static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspProcessCommandFnPtr mspProcessCommandFn)
+{
     mspPacket_t reply = {
         .buf = { .ptr = mspSerialOutBuf, .end = ARRAYEND(mspSerialOutBuf), },
         .cmd = -1,
@@ -413,9 +596,32 @@ static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspPr
     };
 
     mspPostProcessFnPtr mspPostProcessFn = NULL;
-    const mspResult_e status = mspProcessCommandFn(msp->descriptor, &command, &reply, &mspPostProcessFn);
+    mspResult_e status;
+
+#ifdef USE_FLASHFS
+    // Any command from the host ends a running stream
+    msp->stream.remaining = 0;
+#endif
+
+    if (command.cmd == MSP2_SET_MSP_SUBSCRIPTION) {
+        reply.cmd = command.cmd;
+        mspSerialSetSubscription(msp, &command.buf, &reply.buf);
+        status = MSP_RESULT_ACK;
+#ifdef USE_FLASHFS
+    } else if (command.cmd == MSP2_DATAFLASH_STREAM) {
+        reply.cmd = command.cmd;
+        mspSerialStartDataflashStream(msp, &command.buf, &reply.buf);
+        status = MSP_RESULT_ACK;
+#endif
+    } else {
+        status = mspProcessCommandFn(msp->descriptor, &command, &reply, &mspPostProcessFn);
+    }
 
     if (status != MSP_RESULT_NO_REPLY) {
+        // The flags byte only exists in MSPv2
+        if (msp->mspVersion != MSP_V1) {
+            mspHuffmanReply(&command, &reply, outBufHead);
+        }
         sbufSwitchToReader(&reply.buf, outBufHead); // change streambuf direction
         mspSerialEncode(msp, &reply, msp->mspVersion);
     }
@@ -423,6 +629,96 @@ static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspPr
     return mspPostProcessFn;
 }
 
+/*
+ * Push the replies of the subscribed commands in one MSPv2 frame.
+ *
+ * Each reply is stored as U16 cmd, U16 size, payload. Only as many
+ * replies as fit into the free TX buffer space are batched; the next
+ * frame continues with the commands left out, so that all of them
+ * are served even on a slow link.
+ */
+static void mspSerialProcessSubscription(mspPort_t *msp, mspProcessCommandFnPtr mspProcessCommandFn)
+{
+    static uint8_t batchBuf[MSP_SUBSCRIPTION_BUF_SIZE];
+
+    mspSubscription_t *sub = &msp->subscription;
+
+    if (!sub->count || msp->c_state != MSP_IDLE) {
+        return;
+    }
+
+    const timeMs_t currentTimeMs = millis();
+
+    // Host gone
+    if (cmp32(currentTimeMs, msp->lastActivityMs) > MSP_SUBSCRIPTION_TIMEOUT) {
+        sub->count = 0;
+        return;
+    }
+
+    if (cmp32(currentTimeMs, sub->lastPushMs) < sub->intervalMs) {
+        return;
+    }
+
+    // Room for the payload after the frame header and checksum
+    const int room = MIN((int)serialTxBytesFree(msp->port) - MSP_MAX_HEADER_SIZE - 1, MSP_SUBSCRIPTION_BUF_SIZE);
+
+    sbuf_t batch = { .ptr = batchBuf, .end = batchBuf + MAX(room, 0) };
+
+    int index = sub->next;
+
+    for (int i = 0; i < sub->count; i++) {
+        mspPacket_t reply = {
+            .buf = { .ptr = mspSerialOutBuf, .end = ARRAYEND(mspSerialOutBuf), },
+            .cmd = -1,
+            .flags = 0,
+            .result = 0,
+            .direction = MSP_DIRECTION_REPLY,
+        };
+        mspPacket_t command = {
+            .buf = { .ptr = msp->inBuf, .end = msp->inBuf, },
+            .cmd = sub->cmd[index],
+            .flags = 0,
+            .result = 0,
+            .direction = MSP_DIRECTION_REQUEST,
+        };
+
+        mspPostProcessFnPtr mspPostProcessFn = NULL;
+        const mspResult_e status = mspProcessCommandFn(msp->descriptor, &command, &reply, &mspPostProcessFn);
+
+        if (status == MSP_RESULT_ACK) {
+            const int size = reply.buf.ptr - mspSerialOutBuf;
+
+            if (sbufBytesRemaining(&batch) < size + 4) {
+                break;
+            }
+
+            sbufWriteU16(&batch, command.cmd);
+            sbufWriteU16(&batch, size);
+            sbufWriteData(&batch, mspSerialOutBuf, size);
+        }
+
+        index = (index + 1) % sub->count;
+    }
+
+    sub->next = index;
+
+    if (batch.ptr == batchBuf) {
+        return;
+    }
+
+    mspPacket_t push = {
+        .buf = { .ptr = batchBuf, .end = batch.ptr, },
+        .cmd = MSP2_MSP_SUBSCRIPTION_DATA,
+        .flags = 0,
+        .result = 0,
+        .direction = MSP_DIRECTION_REPLY,
+    };
+
+    if (mspSerialEncode(msp, &push, MSP_V2_NATIVE)) {
+        sub->lastPushMs = currentTimeMs;
+    }
+}
+
 static void mspEvaluateNonMspData(mspPort_t * mspPort, uint8_t receivedChar)
 {
    if (receivedChar == serialConfig()->reboot_character) {
@@ -530,6 +826,11 @@ void mspSerialProcess(mspEvaluateNonMspData_e evaluateNonMspData, mspProcessComm
         } else {
             mspProcessPendingRequest(mspPort);
         }
+
+        mspSerialProcessSubscription(mspPort, mspProcessCommandFn);
+#ifdef USE_FLASHFS
+        mspSerialProcessDataflashStream(mspPort, mspProcessCommandFn);
+#endif
     }
 }
 
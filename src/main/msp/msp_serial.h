@@ -95,6 +95,33 @@ typedef struct __attribute__((packed)) {
 
 #define MSP_MAX_HEADER_SIZE     9
 
+// MSP subscriptions: commands pushed periodically without polling
+#define MSP_SUBSCRIPTION_MAX_COMMANDS   8
+#define MSP_SUBSCRIPTION_MIN_INTERVAL   5       // ms
+#define MSP_SUBSCRIPTION_TIMEOUT        5000    // ms without host activity
+#define MSP_SUBSCRIPTION_BUF_SIZE       512
+
+typedef struct mspSubscription_s {
+    uint16_t cmd[MSP_SUBSCRIPTION_MAX_COMMANDS];
+    uint8_t  count;
+    uint8_t  next;                  // first command of the next batch
+    uint16_t intervalMs;
+    timeMs_t lastPushMs;
+} mspSubscription_t;
+
+#ifdef USE_FLASHFS
+// Dataflash streaming: chunks pushed without a request per chunk
+#define MSP_DATAFLASH_STREAM_BURST      4       // chunks per port update at most
+#define MSP_DATAFLASH_STREAM_MIN_CHUNK  256     // wait for the TX buffer to drain below this
+#define MSP_DATAFLASH_STREAM_TIMEOUT    5000    // ms without TX buffer progress
+
+typedef struct mspDataflashStream_s {
+    uint32_t address;               // next address to send
+    uint32_t remaining;             // bytes left to send, 0 = idle
+    timeMs_t lastPushMs;
+} mspDataflashStream_t;
+#endif
+
 struct serialPort_s;
 typedef struct mspPort_s {
     struct serialPort_s *port; // null when port unused.
@@ -112,6 +139,10 @@ typedef struct mspPort_s {
     uint8_t checksum2;
     bool sharedWithTelemetry;
     mspDescriptor_t descriptor;
+    mspSubscription_t subscription;
+#ifdef USE_FLASHFS
+    mspDataflashStream_t stream;
+#endif
 } mspPort_t;
 
 void mspSerialInit(void);
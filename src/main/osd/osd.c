@@ -211,7 +211,6 @@ const osd_stats_e osdStatsDisplayOrder[OSD_STAT_COUNT] = {
 // Pass an empty formatString for default.
 int osdPrintFloat(char *buffer, char leadingSymbol, float value, char *formatString, unsigned decimalPlaces, bool round, char trailingSymbol)
 {
-    char mask[7];
     int pos = 0;
     int multiplier = 1;
     for (unsigned i = 0; i < decimalPlaces; i++) {
@@ -230,10 +229,14 @@ int osdPrintFloat(char *buffer, char leadingSymbol, float value, char *formatStr
         buffer[pos++] = '-';
     }
 
-    pos += tfp_sprintf(buffer + pos, (strlen(formatString) ? formatString : "%01u"), integerPart);
+    if (formatString[0]) {
+        pos += tfp_sprintf(buffer + pos, formatString, integerPart);
+    } else {
+        pos += fmtUnsigned(buffer + pos, integerPart, 0, 0);
+    }
     if (decimalPlaces) {
-        tfp_sprintf((char *)&mask, ".%%0%uu", decimalPlaces); // builds up the format string to be like ".%03u" for decimalPlaces == 3 as an example
-        pos += tfp_sprintf(buffer + pos, mask, fractionalPart);
+        buffer[pos++] = '.';
+        pos += fmtUnsigned(buffer + pos, fractionalPart, decimalPlaces, '0');
     }
 
     if (trailingSymbol != SYM_NONE) {
@@ -1122,7 +1125,7 @@ typedef enum {
 
 osdState_e osdState = OSD_STATE_INIT;
 
-#define OSD_UPDATE_INTERVAL_US (1000000 / osdConfig()->framerate_hz)
+#define OSD_UPDATE_INTERVAL_US ((1000000 / osdConfig()->framerate_hz) << schedulerGetLoadShedLevel())
 
 // Called periodically by the scheduler
 bool osdUpdateCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTimeUs)
@@ -1257,16 +1260,6 @@ void osdUpdate(timeUs_t currentTimeUs)
             break;
         }
 
-        if (backgroundLayerSupported) {
-            // Background layer is supported, overlay it onto the foreground
-            // so that we only need to draw the active parts of the elements.
-            displayLayerCopy(osdDisplayPort, DISPLAYPORT_LAYER_FOREGROUND, DISPLAYPORT_LAYER_BACKGROUND);
-        } else {
-            // Background layer not supported, just clear the foreground in preparation
-            // for drawing the elements including their backgrounds.
-            displayClearScreen(osdDisplayPort, DISPLAY_CLEAR_NONE);
-        }
-
 #ifdef USE_GPS
         static bool lastGpsSensorState;
         // Handle the case that the GPS_SENSOR may be delayed in activation
@@ -1278,6 +1271,18 @@ void osdUpdate(timeUs_t currentTimeUs)
         }
 #endif // USE_GPS
 
+        if (!osdElementsStartFrame(osdDisplayPort)) {
+            // Canvas is retained, only the changed elements are redrawn
+        } else if (backgroundLayerSupported) {
+            // Background layer is supported, overlay it onto the foreground
+            // so that we only need to draw the active parts of the elements.
+            displayLayerCopy(osdDisplayPort, DISPLAYPORT_LAYER_FOREGROUND, DISPLAYPORT_LAYER_BACKGROUND);
+        } else {
+            // Background layer not supported, just clear the foreground in preparation
+            // for drawing the elements including their backgrounds.
+            displayClearScreen(osdDisplayPort, DISPLAY_CLEAR_NONE);
+        }
+
         osdSyncBlink();
 
         osdState = OSD_STATE_GROUP_ELEMENTS;
@@ -143,6 +143,7 @@
 #include "flight/imu.h"
 #include "flight/mixer.h"
 #include "flight/pid.h"
+#include "flight/vibration.h"
 
 #include "io/gps.h"
 #include "io/vtx.h"
@@ -232,15 +233,166 @@ static uint32_t blinkBits[(OSD_ITEM_COUNT + 31) / 32];
 
 enum {UP, DOWN};
 
-static int osdDisplayWrite(osdElementParms_t *element, uint8_t x, uint8_t y, uint8_t attr, const char *s)
+// Incremental rendering
+//
+// On displays that retain their canvas between frames, only elements whose
+// formatted text changed are rewritten. Elements that write to the display
+// themselves can't be compared, so their footprint is erased and they are
+// redrawn in full every frame.
+#define OSD_ELEMENT_REFRESH_HZ  1   // Full canvas refresh rate, recovers from lost display frames
+#define OSD_ERASE_CHUNK         16  // Longest string of spaces written at once
+
+typedef struct {
+    uint8_t x0, y0;
+    uint8_t x1, y1;
+} osdFootprint_t;
+
+typedef struct {
+    uint32_t hash;                  // Hash of the element text drawn last, 0 if unknown
+    osdFootprint_t footprint;       // Screen area last drawn by the element
+    osdFootprint_t background;      // Screen area last drawn by the element background
+    bool direct;                    // Element wrote to the display itself
+    bool dirty;                     // Element has to be redrawn this frame
+} osdElementCache_t;
+
+static osdElementCache_t elementCache[OSD_ITEM_COUNT];
+static osdFootprint_t writeFootprint;   // Area written by the element being drawn
+static bool writeDirect;                // Element being drawn wrote to the display itself
+static bool incrementalFrame;
+static bool forceFullRefresh = true;
+static uint8_t canvasClearCount;
+static unsigned framesSinceRefresh;
+
+// Refresh scheduling
+//
+// Elements showing slowly changing data are only formatted at their own
+// rate. In between, the last text is left on a retained canvas, or written
+// again from the text store. The due frames are staggered by the position
+// in the active list, so that the slow elements don't all land on the
+// same frame. Elements not listed are drawn every frame.
+#define OSD_ELEMENT_TEXT_SLOTS  12  // Slow elements beyond this are drawn every frame
+#define OSD_ELEMENT_NO_SLOT     0xFF
+
+static const uint8_t osdElementRefreshHz[OSD_ITEM_COUNT] = {
+    [OSD_ITEM_TIMER_1]              = 1,
+    [OSD_ITEM_TIMER_2]              = 1,
+    [OSD_MAH_DRAWN]                 = 5,
+    [OSD_MAIN_BATT_USAGE]           = 5,
+    [OSD_GPS_SATS]                  = 5,
+    [OSD_HOME_DIST]                 = 5,
+    [OSD_FLIGHT_DIST]               = 5,
+    [OSD_EFFICIENCY]                = 5,
+    [OSD_ESC_TMP]                   = 5,
+    [OSD_REMAINING_TIME_ESTIMATE]   = 1,
+    [OSD_RTC_DATETIME]              = 1,
+    [OSD_CORE_TEMPERATURE]          = 1,
+    [OSD_TOTAL_FLIGHTS]             = 1,
+    [OSD_VIBRATION]                 = 5,
+};
+
+typedef struct {
+    uint32_t hash;                  // Hash of the stored text
+    uint8_t x, y;
+    uint8_t attr;
+    bool valid;                     // Text can be written again without the element
+    char text[OSD_ELEMENT_BUFFER_LENGTH];
+} osdElementText_t;
+
+static osdElementText_t elementText[OSD_ELEMENT_TEXT_SLOTS];
+static uint8_t elementTextSlot[OSD_ITEM_COUNT];
+static osdElementText_t *writeText;     // Text store of the element being drawn
+static unsigned frameCounter;
+
+static void footprintReset(osdFootprint_t *fp)
+{
+    fp->x0 = fp->y0 = UINT8_MAX;
+    fp->x1 = fp->y1 = 0;
+}
+
+static bool footprintIsEmpty(const osdFootprint_t *fp)
+{
+    return fp->x1 < fp->x0;
+}
+
+static void footprintExtend(osdFootprint_t *fp, uint8_t x, uint8_t y, unsigned len)
+{
+    if (len > 0) {
+        const uint8_t x1 = x + len - 1;
+        fp->x0 = MIN(fp->x0, x);
+        fp->x1 = MAX(fp->x1, x1);
+        fp->y0 = MIN(fp->y0, y);
+        fp->y1 = MAX(fp->y1, y);
+    }
+}
+
+static bool footprintOverlaps(const osdFootprint_t *a, const osdFootprint_t *b)
+{
+    return !footprintIsEmpty(a) && !footprintIsEmpty(b) &&
+        a->x0 <= b->x1 && b->x0 <= a->x1 && a->y0 <= b->y1 && b->y0 <= a->y1;
+}
+
+static void osdEraseFootprint(displayPort_t *osdDisplayPort, osdFootprint_t *fp)
+{
+    if (!footprintIsEmpty(fp)) {
+        char spaces[OSD_ERASE_CHUNK + 1];
+
+        for (int y = fp->y0; y <= fp->y1; y++) {
+            for (int x = fp->x0; x <= fp->x1; x += OSD_ERASE_CHUNK) {
+                const int len = MIN(fp->x1 - x + 1, OSD_ERASE_CHUNK);
+                memset(spaces, ' ', len);
+                spaces[len] = 0;
+                displayWrite(osdDisplayPort, x, y, DISPLAYPORT_ATTR_NONE, spaces);
+            }
+        }
+
+        footprintReset(fp);
+    }
+}
+
+static uint32_t osdElementHash(uint8_t x, uint8_t y, uint8_t attr, const char *s)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261U;
+
+    hash = (hash ^ x) * 16777619U;
+    hash = (hash ^ y) * 16777619U;
+    hash = (hash ^ attr) * 16777619U;
+
+    while (*s) {
+        hash = (hash ^ (uint8_t)*s++) * 16777619U;
+    }
+
+    return hash ? hash : 1;
+}
+
+static void osdElementCacheReset(osdElementCache_t *cache)
+{
+    cache->hash = 0;
+    footprintReset(&cache->footprint);
+    footprintReset(&cache->background);
+    cache->direct = false;
+    cache->dirty = false;
+}
+
+static int osdElementWrite(osdElementParms_t *element, uint8_t x, uint8_t y, uint8_t attr, const char *s)
 {
     if (IS_BLINK(element->item)) {
         attr |= DISPLAYPORT_ATTR_BLINK;
     }
 
+    footprintExtend(&writeFootprint, x, y, strlen(s));
+
     return displayWrite(element->osdDisplayPort, x, y, attr, s);
 }
 
+static int osdDisplayWrite(osdElementParms_t *element, uint8_t x, uint8_t y, uint8_t attr, const char *s)
+{
+    // Element draws itself, its output can't be cached
+    writeDirect = true;
+
+    return osdElementWrite(element, x, y, attr, s);
+}
+
 static int osdDisplayWriteChar(osdElementParms_t *element, uint8_t x, uint8_t y, uint8_t attr, char c)
 {
     char buf[2];
@@ -418,7 +570,16 @@ void osdFormatDistanceString(char *ptr, int distance, char leadingSymbol)
 
 static void osdFormatPID(char * buff, const char * label, const pidf_t * pid)
 {
-    tfp_sprintf(buff, "%s %3d %3d %3d %3d", label, pid->P, pid->I, pid->D, pid->F);
+    const int len = strlen(label);
+
+    memcpy(buff, label, len);
+    buff += len;
+
+    const int values[] = { pid->P, pid->I, pid->D, pid->F };
+    for (unsigned i = 0; i < ARRAYLEN(values); i++) {
+        *buff++ = ' ';
+        buff += fmtInt(buff, values[i], 3, ' ');
+    }
 }
 
 #ifdef USE_RTC_TIME
@@ -1085,6 +1246,23 @@ static void osdElementTxUplinkPower(osdElementParms_t *element)
 }
 #endif // USE_RX_LINK_UPLINK_POWER
 
+#ifdef USE_VIBRATION_ANALYSIS
+static void osdElementVibration(osdElementParms_t *element)
+{
+    const vibration_t *vib = vibrationGetData();
+    unsigned mainRotor = 0, tailRotor = 0, rms = 0;
+
+    // Worst axis of each, in mG
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        mainRotor = MAX(mainRotor, vib->mainRotor[axis]);
+        tailRotor = MAX(tailRotor, vib->tailRotor[axis]);
+        rms = MAX(rms, vib->rms[axis]);
+    }
+
+    tfp_sprintf(element->buff, "VIB%4u%4u%4u", MIN(mainRotor, 9999), MIN(tailRotor, 9999), MIN(rms, 9999));
+}
+#endif
+
 #ifdef USE_BLACKBOX
 static void osdElementLogStatus(osdElementParms_t *element)
 {
@@ -1605,6 +1783,9 @@ const osdElementDrawFn osdElementDrawFunction[OSD_ITEM_COUNT] = {
 #ifdef USE_PERSISTENT_STATS
     [OSD_TOTAL_FLIGHTS]           = osdElementTotalFlights,
 #endif
+#ifdef USE_VIBRATION_ANALYSIS
+    [OSD_VIBRATION]               = osdElementVibration,
+#endif
 };
 
 // Define the mapping between the OSD element id and the function to draw its background (static part)
@@ -1634,12 +1815,16 @@ static void osdAddActiveElement(osd_items_e element)
 void osdAddActiveElements(void)
 {
     activeOsdElementCount = 0;
+    forceFullRefresh = true;
 
 #ifdef USE_ACC
     if (sensors(SENSOR_ACC)) {
         osdAddActiveElement(OSD_ARTIFICIAL_HORIZON);
         osdAddActiveElement(OSD_G_FORCE);
         osdAddActiveElement(OSD_UP_DOWN_REFERENCE);
+#ifdef USE_VIBRATION_ANALYSIS
+        osdAddActiveElement(OSD_VIBRATION);
+#endif
     }
 #endif
 
@@ -1675,6 +1860,71 @@ void osdAddActiveElements(void)
 #ifdef USE_PERSISTENT_STATS
     osdAddActiveElement(OSD_TOTAL_FLIGHTS);
 #endif
+
+    // Give the slow elements a text store, in display order
+    unsigned slot = 0;
+
+    memset(elementTextSlot, OSD_ELEMENT_NO_SLOT, sizeof(elementTextSlot));
+
+    for (unsigned i = 0; i < activeOsdElementCount && slot < OSD_ELEMENT_TEXT_SLOTS; i++) {
+        const uint8_t item = activeOsdElementArray[i];
+        if (osdElementRefreshHz[item]) {
+            elementText[slot].valid = false;
+            elementTextSlot[item] = slot++;
+        }
+    }
+}
+
+static void osdDrawElementText(osdElementParms_t *element, uint8_t x, uint8_t y, char *buff)
+{
+    osdElementCache_t *cache = &elementCache[element->item];
+
+    if (!writeDirect) {
+        const uint8_t attr = element->attr | (IS_BLINK(element->item) ? DISPLAYPORT_ATTR_BLINK : 0);
+        const uint32_t hash = osdElementHash(x, y, attr, buff);
+
+        if (writeText) {
+            writeText->hash = hash;
+            writeText->x = x;
+            writeText->y = y;
+            writeText->attr = element->attr;
+            strcpy(writeText->text, buff);
+        }
+
+        if (incrementalFrame) {
+            if (hash == cache->hash && !cache->dirty) {
+                // Unchanged, leave it on the canvas
+                writeFootprint = cache->footprint;
+                return;
+            }
+
+            const osdFootprint_t *last = &cache->footprint;
+            const unsigned len = strlen(buff);
+
+            if (last->x0 == x && last->y0 == y && last->y1 == y) {
+                // Overwrite the remains of longer text with spaces
+                const unsigned width = MIN(last->x1 - last->x0 + 1, OSD_ELEMENT_BUFFER_LENGTH - 1);
+                if (width > len) {
+                    memset(&buff[len], ' ', width - len);
+                    buff[width] = 0;
+                }
+            } else {
+                osdEraseFootprint(element->osdDisplayPort, &cache->footprint);
+            }
+
+            osdElementWrite(element, x, y, element->attr, buff);
+
+            // Padding is not part of the element
+            footprintReset(&writeFootprint);
+            footprintExtend(&writeFootprint, x, y, len);
+            cache->hash = hash;
+            return;
+        }
+
+        cache->hash = hash;
+    }
+
+    osdElementWrite(element, x, y, element->attr, buff);
 }
 
 static void osdDrawSingleElement(displayPort_t *osdDisplayPort, uint8_t item)
@@ -1704,7 +1954,7 @@ static void osdDrawSingleElement(displayPort_t *osdDisplayPort, uint8_t item)
     // Call the element drawing function
     osdElementDrawFunction[item](&element);
     if (element.drawElement) {
-        osdDisplayWrite(&element, elemPosX, elemPosY, element.attr, buff);
+        osdDrawElementText(&element, elemPosX, elemPosY, buff);
     }
 }
 
@@ -1731,12 +1981,112 @@ static void osdDrawSingleElementBackground(displayPort_t *osdDisplayPort, uint8_
     // Call the element background drawing function
     osdElementBackgroundFunction[item](&element);
     if (element.drawElement) {
-        osdDisplayWrite(&element, elemPosX, elemPosY, DISPLAYPORT_ATTR_NONE, buff);
+        osdElementWrite(&element, elemPosX, elemPosY, DISPLAYPORT_ATTR_NONE, buff);
+    }
+}
+
+static void osdElementCacheUpdate(displayPort_t *osdDisplayPort, osdElementCache_t *cache)
+{
+    if (incrementalFrame) {
+        if (writeDirect && !cache->direct) {
+            // Cached text was not erased, redraw everything in the next frame
+            forceFullRefresh = true;
+        } else if (footprintIsEmpty(&writeFootprint)) {
+            // Nothing drawn this frame, e.g. blinked off
+            osdEraseFootprint(osdDisplayPort, &cache->footprint);
+        }
+    }
+
+    if (writeDirect || footprintIsEmpty(&writeFootprint)) {
+        cache->hash = 0;
     }
+
+    cache->footprint = writeFootprint;
+    cache->direct = writeDirect;
+    cache->dirty = false;
+}
+
+// Returns true if the canvas has to be cleared and all elements redrawn
+bool osdElementsStartFrame(displayPort_t *osdDisplayPort)
+{
+    const unsigned refreshFrames = MAX(osdConfig()->framerate_hz / OSD_ELEMENT_REFRESH_HZ, 1);
+
+    frameCounter++;
+
+    if (osdDisplayPort->clearCount != canvasClearCount) {
+        // Someone else used the display, start over with fresh data
+        for (unsigned i = 0; i < OSD_ELEMENT_TEXT_SLOTS; i++) {
+            elementText[i].valid = false;
+        }
+    }
+
+    incrementalFrame = osdDisplayPort->retainsCanvas && !backgroundLayerSupported && !forceFullRefresh &&
+        (osdDisplayPort->clearCount == canvasClearCount) && (++framesSinceRefresh < refreshFrames);
+
+    if (!incrementalFrame) {
+        forceFullRefresh = false;
+        framesSinceRefresh = 0;
+        for (unsigned i = 0; i < OSD_ITEM_COUNT; i++) {
+            osdElementCacheReset(&elementCache[i]);
+        }
+        return true;
+    }
+
+    // Self drawn elements are erased and redrawn in full
+    for (unsigned i = 0; i < activeOsdElementCount; i++) {
+        osdElementCache_t *cache = &elementCache[activeOsdElementArray[i]];
+
+        if (cache->direct && !footprintIsEmpty(&cache->footprint)) {
+            // Elements under the erased area have to be redrawn as well
+            for (unsigned j = 0; j < activeOsdElementCount; j++) {
+                osdElementCache_t *other = &elementCache[activeOsdElementArray[j]];
+                if (footprintOverlaps(&cache->footprint, &other->footprint) ||
+                    footprintOverlaps(&cache->footprint, &other->background)) {
+                    other->dirty = true;
+                }
+            }
+            osdEraseFootprint(osdDisplayPort, &cache->footprint);
+        }
+    }
+
+    return false;
 }
 
 static uint8_t activeElement = 0;
 
+static bool osdElementDue(uint8_t item, const osdElementText_t *text, const osdElementCache_t *cache)
+{
+    if (!text->valid || cache->dirty || IS_BLINK(item)) {
+        return true;
+    }
+
+    unsigned rateHz = osdElementRefreshHz[item];
+
+    if (item == OSD_ITEM_TIMER_1 || item == OSD_ITEM_TIMER_2) {
+        const uint16_t timer = osdConfig()->timers[item - OSD_ITEM_TIMER_1];
+        if (OSD_TIMER_PRECISION(timer) != OSD_TIMER_PREC_SECOND) {
+            // Fractions of a second have to be drawn every frame
+            rateHz = 0;
+        }
+    }
+
+    const unsigned frames = rateHz ? osdConfig()->framerate_hz / rateHz : 0;
+
+    return frames <= 1 || ((frameCounter + activeElement) % frames) == 0;
+}
+
+// Write the stored text of an element that is not due
+static void osdDrawElementFromText(displayPort_t *osdDisplayPort, uint8_t item, const osdElementText_t *text)
+{
+    if (text->text[0]) {
+        osdElementParms_t element = {
+            .item = item,
+            .osdDisplayPort = osdDisplayPort,
+        };
+        osdElementWrite(&element, text->x, text->y, text->attr, text->text);
+    }
+}
+
 uint8_t osdGetActiveElement()
 {
     return activeElement;
@@ -1757,17 +2107,50 @@ bool osdDrawNextActiveElement(displayPort_t *osdDisplayPort, timeUs_t currentTim
         return false;
     }
 
-    if (!backgroundLayerSupported) {
+    const uint8_t item = activeOsdElementArray[activeElement];
+    osdElementCache_t *cache = &elementCache[item];
+
+    if (!backgroundLayerSupported && (!incrementalFrame || cache->dirty)) {
         // If the background layer isn't supported then we
         // have to draw the element's static layer as well.
-        osdDrawSingleElementBackground(osdDisplayPort, activeOsdElementArray[activeElement]);
+        footprintReset(&writeFootprint);
+        osdDrawSingleElementBackground(osdDisplayPort, item);
+        cache->background = writeFootprint;
     }
 
-    osdDrawSingleElement(osdDisplayPort, activeOsdElementArray[activeElement]);
+    const uint8_t slot = elementTextSlot[item];
+    osdElementText_t *text = (slot != OSD_ELEMENT_NO_SLOT) ? &elementText[slot] : NULL;
+
+    footprintReset(&writeFootprint);
+    writeDirect = false;
+
+    if (!text || osdElementDue(item, text, cache)) {
+        if (text) {
+            text->text[0] = 0;
+            writeText = text;
+        }
+
+        osdDrawSingleElement(osdDisplayPort, item);
+        osdElementCacheUpdate(osdDisplayPort, cache);
+
+        if (text) {
+            // Self drawn and blinking elements can't be replayed
+            text->valid = !writeDirect && !IS_BLINK(item);
+            writeText = NULL;
+        }
+    } else if (!incrementalFrame) {
+        osdDrawElementFromText(osdDisplayPort, item, text);
+        cache->hash = text->hash;
+        osdElementCacheUpdate(osdDisplayPort, cache);
+    }
+    // Otherwise the element is left on the retained canvas as is
 
     if (++activeElement >= activeOsdElementCount) {
         activeElement = 0;
         retval = false;
+
+        // Canvas is in sync with the cache until someone else clears it
+        canvasClearCount = osdDisplayPort->clearCount;
     }
 
     return retval;
@@ -1789,6 +2172,7 @@ void osdElementsInit(bool backgroundLayerFlag)
 {
     backgroundLayerSupported = backgroundLayerFlag;
     activeOsdElementCount = 0;
+    forceFullRefresh = true;
     pt1FilterInit(&batteryEfficiencyFilt, EFFICIENCY_CUTOFF_HZ, osdConfig()->framerate_hz);
 }
 
@@ -1918,7 +2302,8 @@ bool osdElementsNeedAccelerometer(void)
            osdElementIsActive(OSD_ROLL_ANGLE) ||
            osdElementIsActive(OSD_G_FORCE) ||
            osdElementIsActive(OSD_FLIP_ARROW) ||
-           osdElementIsActive(OSD_UP_DOWN_REFERENCE);
+           osdElementIsActive(OSD_UP_DOWN_REFERENCE) ||
+           osdElementIsActive(OSD_VIBRATION);
 }
 
 #endif // USE_ACC
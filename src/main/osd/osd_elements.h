@@ -60,6 +60,7 @@ uint8_t osdGetActiveElementCount();
 bool osdDrawNextActiveElement(displayPort_t *osdDisplayPort, timeUs_t currentTimeUs);
 void osdDrawActiveElementsBackground(displayPort_t *osdDisplayPort);
 void osdElementsInit(bool backgroundLayerFlag);
+bool osdElementsStartFrame(displayPort_t *osdDisplayPort);
 void osdSyncBlink();
 void osdResetAlarms(void);
 void osdUpdateAlarms(void);
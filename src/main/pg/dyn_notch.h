@@ -30,6 +30,7 @@ typedef struct dynNotchConfig_s
     uint8_t  dyn_notch_q;
     uint16_t dyn_notch_min_hz;
     uint16_t dyn_notch_max_hz;
+    uint8_t  dyn_notch_parallel;
 
 } dynNotchConfig_t;
 
@@ -0,0 +1,35 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "common/axis.h"
+
+#include "pg/pg.h"
+
+#define GYRO_BIAS_SENSOR_COUNT  2
+#define GYRO_BIAS_SCALE         16
+#define GYRO_BIAS_SLOPE_SCALE   (1 << 20)
+
+typedef struct gyroBiasConfig_s {
+    uint8_t valid;                                          // Bitmask of gyro sensors with a saved bias
+    uint8_t slopeValid;                                     // Bitmask of gyro sensors with a saved temperature slope
+    int16_t zero[GYRO_BIAS_SENSOR_COUNT][XYZ_AXIS_COUNT];   // Last tracked bias in 1/16 LSB
+    int16_t slope[GYRO_BIAS_SENSOR_COUNT][XYZ_AXIS_COUNT];  // Bias change per raw temperature LSB, in 2^-20 LSB
+} gyroBiasConfig_t;
+
+PG_DECLARE(gyroBiasConfig_t, gyroBiasConfig);
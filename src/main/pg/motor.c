@@ -32,7 +32,7 @@
 #include "pg/pg_ids.h"
 #include "pg/motor.h"
 
-PG_REGISTER_WITH_RESET_FN(motorConfig_t, motorConfig, PG_MOTOR_CONFIG, 1);
+PG_REGISTER_WITH_RESET_FN(motorConfig_t, motorConfig, PG_MOTOR_CONFIG, 3);
 
 void pgResetFn_motorConfig(motorConfig_t *motorConfig)
 {
@@ -59,6 +59,9 @@ void pgResetFn_motorConfig(motorConfig_t *motorConfig)
         motorConfig->motorPoleCount[motorIndex] = 8;
     }
 
+    motorConfig->motorRpmTracker = 0;
+    motorConfig->motorRpmGlitchLimit = 0;
+
     motorConfig->mainRotorGearRatio[0] = 1;
     motorConfig->mainRotorGearRatio[1] = 1;
     motorConfig->tailRotorGearRatio[0] = 1;
@@ -29,8 +29,61 @@
 
 #include "pg.h"
 
+// Registry entries sorted by PG number, built on the first lookup.
+// The registry is placed by the linker, so the order is not known
+// at compile time.
+#define PG_INDEX_SIZE 256
+
+static uint8_t pgIndex[PG_INDEX_SIZE];
+static uint16_t pgIndexCount;
+static bool pgIndexValid;
+
+static void pgIndexBuild(void)
+{
+    pgIndexCount = 0;
+
+    if (PG_REGISTRY_SIZE <= PG_INDEX_SIZE) {
+        for (unsigned i = 0; i < PG_REGISTRY_SIZE; i++) {
+            const pgn_t pgn = pgN(&__pg_registry_start[i]);
+            unsigned pos = pgIndexCount++;
+            while (pos > 0 && pgN(&__pg_registry_start[pgIndex[pos - 1]]) > pgn) {
+                pgIndex[pos] = pgIndex[pos - 1];
+                pos--;
+            }
+            pgIndex[pos] = i;
+        }
+    }
+
+    pgIndexValid = true;
+}
+
 const pgRegistry_t* pgFind(pgn_t pgn)
 {
+    if (!pgIndexValid) {
+        pgIndexBuild();
+    }
+
+    if (pgIndexCount) {
+        unsigned lo = 0;
+        unsigned hi = pgIndexCount;
+        while (lo < hi) {
+            const unsigned mid = (lo + hi) / 2;
+            if (pgN(&__pg_registry_start[pgIndex[mid]]) < pgn) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo < pgIndexCount) {
+            const pgRegistry_t *reg = &__pg_registry_start[pgIndex[lo]];
+            if (pgN(reg) == pgn) {
+                return reg;
+            }
+        }
+        return NULL;
+    }
+
+    // Registry doesn't fit in the index
     PG_FOREACH(reg) {
         if (pgN(reg) == pgn) {
             return reg;
@@ -89,6 +142,16 @@ bool pgLoad(const pgRegistry_t* reg, const void *from, int size, int version)
     return false;
 }
 
+bool pgIsDirty(const pgRegistry_t *reg)
+{
+    return *reg->fnv_hash != fnv_update(FNV_OFFSET_BASIS, reg->address, pgSize(reg));
+}
+
+void pgMarkClean(const pgRegistry_t *reg)
+{
+    *reg->fnv_hash = fnv_update(FNV_OFFSET_BASIS, reg->address, pgSize(reg));
+}
+
 int pgStore(const pgRegistry_t* reg, void *to, int size)
 {
     const int take = MIN(size, pgSize(reg));
@@ -31,14 +31,15 @@
 #include "pid.h"
 
 
-PG_REGISTER_WITH_RESET_TEMPLATE(pidConfig_t, pidConfig, PG_PID_CONFIG, 3);
+PG_REGISTER_WITH_RESET_TEMPLATE(pidConfig_t, pidConfig, PG_PID_CONFIG, 4);
 
 PG_RESET_TEMPLATE(pidConfig_t, pidConfig,
     .pid_process_denom = PID_PROCESS_DENOM_DEFAULT,
     .filter_process_denom = FILTER_PROCESS_DENOM_DEFAULT,
+    .pid_process_headroom = 0,
 );
 
-PG_REGISTER_ARRAY_WITH_RESET_FN(pidProfile_t, PID_PROFILE_COUNT, pidProfiles, PG_PID_PROFILE, 0);
+PG_REGISTER_ARRAY_WITH_RESET_FN(pidProfile_t, PID_PROFILE_COUNT, pidProfiles, PG_PID_PROFILE, 1);
 
 void resetPidProfile(pidProfile_t *pidProfile)
 {
@@ -64,6 +65,8 @@ void resetPidProfile(pidProfile_t *pidProfile)
         .offset_bleed_rate_curve = { 0,0,0,0,0,0,2,4,30,250,250,250,250,250,250,250 },
         .offset_bleed_limit_curve = { 0,0,0,0,0,0,15,40,100,150,200,250,250,250,250,250 },
         .offset_charge_curve = { 0,100,100,100,100,100,95,90,82,76,72,68,65,62,60,58 },
+        .pid_headspeed_curve = { 100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100 },
+        .precomp_headspeed_curve = { 100,100,100,100,100,100,100,100,100,100,100,100,100,100,100,100 },
         .error_rotation = true,
         .iterm_relax_type = ITERM_RELAX_RPY,
         .iterm_relax_level = { 40, 40, 40 },
@@ -28,6 +28,7 @@
 typedef struct {
     uint8_t pid_process_denom;
     uint8_t filter_process_denom;
+    uint8_t pid_process_headroom;
 } pidConfig_t;
 
 PG_DECLARE(pidConfig_t, pidConfig);
@@ -141,6 +142,9 @@ typedef struct pidProfile_s {
     uint8_t             offset_bleed_limit_curve[LOOKUP_CURVE_POINTS];
     uint8_t             offset_charge_curve[LOOKUP_CURVE_POINTS];
 
+    uint8_t             pid_headspeed_curve[LOOKUP_CURVE_POINTS];
+    uint8_t             precomp_headspeed_curve[LOOKUP_CURVE_POINTS];
+
     uint8_t             error_rotation;
 
     uint8_t             iterm_relax_type;
@@ -25,7 +25,7 @@
 #include "pg/pg_ids.h"
 #include "pg/position.h"
 
-PG_REGISTER_WITH_RESET_TEMPLATE(positionConfig_t, positionConfig, PG_POSITION, 0);
+PG_REGISTER_WITH_RESET_TEMPLATE(positionConfig_t, positionConfig, PG_POSITION, 2);
 
 PG_RESET_TEMPLATE(positionConfig_t, positionConfig,
     .alt_source = ALT_SOURCE_DEFAULT,
@@ -35,4 +35,6 @@ PG_RESET_TEMPLATE(positionConfig_t, positionConfig,
     .gps_offset_lpf = 5,
     .gps_min_sats = 12,
     .vario_lpf = 25,
+    .alt_fusion_lpf = 20,
+    .nav_fusion_lpf = 20,
 );
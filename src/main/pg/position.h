@@ -34,6 +34,8 @@ typedef struct positionConfig_s {
     uint8_t gps_offset_lpf;
     uint8_t gps_min_sats;
     uint8_t vario_lpf;
+    uint8_t alt_fusion_lpf;
+    uint8_t nav_fusion_lpf;
 } positionConfig_t;
 
 PG_DECLARE(positionConfig_t, positionConfig);
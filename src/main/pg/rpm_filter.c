@@ -23,7 +23,7 @@
 #include "pg/pg_ids.h"
 #include "pg/rpm_filter.h"
 
-PG_REGISTER(rpmFilterConfig_t, rpmFilterConfig, PG_RPM_FILTER_CONFIG, 0);
+PG_REGISTER(rpmFilterConfig_t, rpmFilterConfig, PG_RPM_FILTER_CONFIG, 1);
 
 #endif
 
@@ -27,6 +27,7 @@ typedef struct rpmFilteConfig_s
     uint16_t filter_bank_rpm_ratio[RPM_FILTER_BANK_COUNT];      // RPM ratio *1000
     uint16_t filter_bank_rpm_limit[RPM_FILTER_BANK_COUNT];      // RPM minimum limit
     uint8_t  filter_bank_notch_q[RPM_FILTER_BANK_COUNT];        // Notch Q *10
+    uint8_t  filter_adaptive_q;                                 // Adapt notch Q to the tracked harmonic amplitude
 
 } rpmFilterConfig_t;
 
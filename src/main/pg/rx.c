@@ -67,7 +67,7 @@ void pgResetFn_rxConfig(rxConfig_t *rxConfig)
 #endif
 }
 
-PG_REGISTER_WITH_RESET_TEMPLATE(rcControlsConfig_t, rcControlsConfig, PG_RC_CONTROLS_CONFIG, 0);
+PG_REGISTER_WITH_RESET_TEMPLATE(rcControlsConfig_t, rcControlsConfig, PG_RC_CONTROLS_CONFIG, 1);
 
 PG_RESET_TEMPLATE(rcControlsConfig_t, rcControlsConfig,
     .rc_center = 1500,
@@ -79,6 +79,7 @@ PG_RESET_TEMPLATE(rcControlsConfig_t, rcControlsConfig,
     .rc_yaw_deadband = 2,
     .rc_smoothness = 50,
     .rc_threshold = { 25, 25, 25, 50 },
+    .rc_smoothing_mode = RC_SMOOTHING_LOWPASS,
 );
 
 #endif
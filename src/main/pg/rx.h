@@ -63,6 +63,12 @@ typedef struct rcControlsConfig_s {
     uint8_t  rc_yaw_deadband;           // A deadband around the stick center for yaw axis
     uint8_t  rc_smoothness;             // Minimum RPYC smoothing level
     uint8_t  rc_threshold[4];           // Threshold for stick activity
+    uint8_t  rc_smoothing_mode;         // RPYC smoothing by lowpass or by frame prediction
 } rcControlsConfig_t;
 
+typedef enum {
+    RC_SMOOTHING_LOWPASS = 0,
+    RC_SMOOTHING_PREDICT,
+} rcSmoothingMode_e;
+
 PG_DECLARE(rcControlsConfig_t, rcControlsConfig);
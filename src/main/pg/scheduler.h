@@ -34,6 +34,9 @@
 typedef struct schedulerConfig_s {
     uint16_t rxRelaxDeterminism;
     uint16_t osdRelaxDeterminism;
+    uint8_t  deadlineScheduling;
+    uint8_t  idleSleep;
+    uint8_t  loadShedding;
 } schedulerConfig_t;
 
 PG_DECLARE(schedulerConfig_t, schedulerConfig);
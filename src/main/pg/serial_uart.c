@@ -35,7 +35,7 @@
 #include "drivers/serial.h"
 #include "drivers/serial_uart.h"
 
-PG_REGISTER_ARRAY_WITH_RESET_FN(serialUartConfig_t, UARTDEV_CONFIG_MAX, serialUartConfig, PG_SERIAL_UART_CONFIG, 0);
+PG_REGISTER_ARRAY_WITH_RESET_FN(serialUartConfig_t, UARTDEV_CONFIG_MAX, serialUartConfig, PG_SERIAL_UART_CONFIG, 1);
 
 typedef struct uartDmaopt_s {
     UARTDevice_e device;
@@ -81,6 +81,7 @@ void pgResetFn_serialUartConfig(serialUartConfig_t *config)
     for (unsigned i = 0; i < UARTDEV_CONFIG_MAX; i++) {
         config[i].txDmaopt = -1;
         config[i].rxDmaopt = -1;
+        config[i].rxBufferSize = 0;
     }
 
     for (unsigned i = 0; i < ARRAYLEN(uartDmaopt); i++) {
@@ -32,6 +32,7 @@
 typedef struct serialUartConfig_s {
     int8_t txDmaopt;
     int8_t rxDmaopt;
+    uint16_t rxBufferSize;      // 0 = default, larger ones are taken from a shared pool
 } serialUartConfig_t;
 
 PG_DECLARE_ARRAY(serialUartConfig_t, UARTDEV_CONFIG_MAX, serialUartConfig);
@@ -0,0 +1,36 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "pg/pg.h"
+
+typedef enum {
+    SYSID_SIGNAL_CHIRP = 0,
+    SYSID_SIGNAL_PRBS,
+} sysidSignal_e;
+
+typedef struct sysidConfig_s {
+    uint8_t  signal;            // sysidSignal_e
+    uint8_t  axes;              // Bitmask of the excited axes, roll = 1, pitch = 2, yaw = 4
+    uint16_t amplitude;         // Excitation amplitude in deg/s
+    uint16_t duration;          // Excitation time per axis in 0.1s
+    uint16_t min_freq;          // Chirp start frequency in 0.1Hz
+    uint16_t max_freq;          // Chirp end frequency, PRBS bandwidth in 0.1Hz
+} sysidConfig_t;
+
+PG_DECLARE(sysidConfig_t, sysidConfig);
@@ -30,6 +30,7 @@
 #include "build/build_config.h"
 #include "build/debug.h"
 
+#include "common/bitunpack.h"
 #include "common/crc.h"
 #include "common/maths.h"
 #include "common/utils.h"
@@ -63,11 +64,23 @@
 
 #define CRSF_FRAME_ERROR_COUNT_THRESHOLD    3
 
+#define CRSF_RC_FRAME_QUEUE_SIZE            4 // must be a power of 2
+
 STATIC_UNIT_TESTED bool crsfFrameDone = false;
 STATIC_UNIT_TESTED crsfFrame_t crsfFrame;
 STATIC_UNIT_TESTED crsfFrame_t crsfChannelDataFrame;
 STATIC_UNIT_TESTED uint32_t crsfChannelData[CRSF_MAX_CHANNEL];
 
+// Single producer, single consumer queue of received RC frames. The
+// producer is the serial ISR, or the frame status poll when the port
+// uses RX DMA. The consumer only ever takes the latest frame, and it
+// never touches the slot the producer writes next.
+STATIC_ASSERT((CRSF_RC_FRAME_QUEUE_SIZE & (CRSF_RC_FRAME_QUEUE_SIZE - 1)) == 0, crsf_rc_frame_queue_size_not_power_of_2);
+
+static crsfFrame_t crsfRcFrameQueue[CRSF_RC_FRAME_QUEUE_SIZE];
+static volatile uint8_t crsfRcFrameQueueHead = 0;
+static uint8_t crsfRcFrameQueueTail = 0;
+
 static serialPort_t *serialPort;
 static timeUs_t crsfFrameStartAtUs = 0;
 static uint8_t telemetryBuf[CRSF_FRAME_SIZE_MAX];
@@ -396,8 +409,8 @@ STATIC_UNIT_TESTED void crsfDataReceive(uint16_t c, void *data)
                 case CRSF_FRAMETYPE_SUBSET_RC_CHANNELS_PACKED:
                     if (crsfFrame.frame.deviceAddress == CRSF_ADDRESS_FLIGHT_CONTROLLER) {
                         rxRuntimeState->lastRcFrameTimeUs = currentTimeUs;
-                        crsfFrameDone = true;
-                        memcpy(&crsfChannelDataFrame, &crsfFrame, sizeof(crsfFrame));
+                        memcpy(&crsfRcFrameQueue[crsfRcFrameQueueHead & (CRSF_RC_FRAME_QUEUE_SIZE - 1)], &crsfFrame, sizeof(crsfFrame));
+                        crsfRcFrameQueueHead++;
                     }
                     break;
 
@@ -479,44 +492,48 @@ STATIC_UNIT_TESTED void crsfDataReceive(uint16_t c, void *data)
     }
 }
 
-STATIC_UNIT_TESTED uint8_t crsfFrameStatus(rxRuntimeState_t *rxRuntimeState)
+static void crsfUnpackChannels(const uint8_t *data, unsigned startChannel, unsigned numOfChannels, unsigned channelBits)
 {
-    UNUSED(rxRuntimeState);
+    if (startChannel < CRSF_MAX_CHANNEL) {
+        bitUnpack32(&crsfChannelData[startChannel], data, MIN(numOfChannels, CRSF_MAX_CHANNEL - startChannel), channelBits);
+    }
+}
 
+STATIC_UNIT_TESTED uint8_t crsfFrameStatus(rxRuntimeState_t *rxRuntimeState)
+{
 #if defined(USE_CRSF_LINK_STATISTICS)
     crsfCheckRssi(micros());
 #endif
+
+    // With RX DMA the receive callback is not used and the bytes
+    // collect in the DMA buffer without interrupts. Parse them here.
+    if (serialPort) {
+        for (uint32_t count = serialRxBytesWaiting(serialPort); count > 0; count--) {
+            crsfDataReceive(serialRead(serialPort), rxRuntimeState);
+        }
+    }
+
+    const uint8_t queueHead = crsfRcFrameQueueHead;
+    if (queueHead != crsfRcFrameQueueTail) {
+        memcpy(&crsfChannelDataFrame, &crsfRcFrameQueue[(queueHead - 1) & (CRSF_RC_FRAME_QUEUE_SIZE - 1)], sizeof(crsfChannelDataFrame));
+        crsfRcFrameQueueTail = queueHead;
+        crsfFrameDone = true;
+    }
+
     if (crsfFrameDone) {
         crsfFrameDone = false;
 
         // unpack the RC channels
         if (crsfChannelDataFrame.frame.type == CRSF_FRAMETYPE_RC_CHANNELS_PACKED) {
             // use ordinary RC frame structure (0x16)
-            const crsfPayloadRcChannelsPacked_t* const rcChannels = (crsfPayloadRcChannelsPacked_t*)&crsfChannelDataFrame.frame.payload;
             channelScale = CRSF_RC_CHANNEL_SCALE_LEGACY;
-            crsfChannelData[0] = rcChannels->chan0;
-            crsfChannelData[1] = rcChannels->chan1;
-            crsfChannelData[2] = rcChannels->chan2;
-            crsfChannelData[3] = rcChannels->chan3;
-            crsfChannelData[4] = rcChannels->chan4;
-            crsfChannelData[5] = rcChannels->chan5;
-            crsfChannelData[6] = rcChannels->chan6;
-            crsfChannelData[7] = rcChannels->chan7;
-            crsfChannelData[8] = rcChannels->chan8;
-            crsfChannelData[9] = rcChannels->chan9;
-            crsfChannelData[10] = rcChannels->chan10;
-            crsfChannelData[11] = rcChannels->chan11;
-            crsfChannelData[12] = rcChannels->chan12;
-            crsfChannelData[13] = rcChannels->chan13;
-            crsfChannelData[14] = rcChannels->chan14;
-            crsfChannelData[15] = rcChannels->chan15;
+            crsfUnpackChannels(crsfChannelDataFrame.frame.payload, 0, CRSF_MAX_CHANNEL, 11);
         } else {
             // use subset RC frame structure (0x17)
-            uint8_t readByteIndex = 0;
             const uint8_t *payload = crsfChannelDataFrame.frame.payload;
 
             // get the configuration byte
-            uint8_t configByte = payload[readByteIndex++];
+            uint8_t configByte = payload[0];
 
             // get the channel number of start channel
             uint8_t startChannel = configByte & CRSF_SUBSET_RC_STARTING_CHANNEL_MASK;
@@ -524,29 +541,24 @@ STATIC_UNIT_TESTED uint8_t crsfFrameStatus(rxRuntimeState_t *rxRuntimeState)
 
             // get the channel resolution settings
             uint8_t channelBits;
-            uint16_t channelMask;
             uint8_t channelRes = configByte & CRSF_SUBSET_RC_RES_CONFIGURATION_MASK;
             configByte >>= CRSF_SUBSET_RC_RES_CONFIGURATION_BITS;
             switch (channelRes) {
             case CRSF_SUBSET_RC_RES_CONF_10B:
                 channelBits = CRSF_SUBSET_RC_RES_BITS_10B;
-                channelMask = CRSF_SUBSET_RC_RES_MASK_10B;
                 channelScale = CRSF_SUBSET_RC_CHANNEL_SCALE_10B;
                 break;
             default:
             case CRSF_SUBSET_RC_RES_CONF_11B:
                 channelBits = CRSF_SUBSET_RC_RES_BITS_11B;
-                channelMask = CRSF_SUBSET_RC_RES_MASK_11B;
                 channelScale = CRSF_SUBSET_RC_CHANNEL_SCALE_11B;
                 break;
             case CRSF_SUBSET_RC_RES_CONF_12B:
                 channelBits = CRSF_SUBSET_RC_RES_BITS_12B;
-                channelMask = CRSF_SUBSET_RC_RES_MASK_12B;
                 channelScale = CRSF_SUBSET_RC_CHANNEL_SCALE_12B;
                 break;
             case CRSF_SUBSET_RC_RES_CONF_13B:
                 channelBits = CRSF_SUBSET_RC_RES_BITS_13B;
-                channelMask = CRSF_SUBSET_RC_RES_MASK_13B;
                 channelScale = CRSF_SUBSET_RC_CHANNEL_SCALE_13B;
                 break;
             }
@@ -558,18 +570,7 @@ STATIC_UNIT_TESTED uint8_t crsfFrameStatus(rxRuntimeState_t *rxRuntimeState)
             uint8_t numOfChannels = ((crsfChannelDataFrame.frame.frameLength - CRSF_FRAME_LENGTH_TYPE_CRC - 1) * 8) / channelBits;
 
             // unpack the channel data
-            uint8_t bitsMerged = 0;
-            uint32_t readValue = 0;
-            for (uint8_t n = 0; n < numOfChannels; n++) {
-                while (bitsMerged < channelBits) {
-                    uint8_t readByte = payload[readByteIndex++];
-                    readValue |= ((uint32_t) readByte) << bitsMerged;
-                    bitsMerged += 8;
-                }
-                crsfChannelData[startChannel + n] = readValue & channelMask;
-                readValue >>= channelBits;
-                bitsMerged -= channelBits;
-            }
+            crsfUnpackChannels(payload + 1, startChannel, numOfChannels, channelBits);
         }
         return RX_FRAME_COMPLETE;
     }
@@ -605,9 +605,11 @@ static void unpackBindPacket(volatile uint8_t *packet)
     receiver.configChanged = true; //after initialize as it sets it to false
 }
 
-/**
- * Process the assembled MSP packet in mspBuffer[]
- **/
+#ifdef USE_MSP_OVER_TELEMETRY
+// Set by the radio interrupt chain when mspBuffer[] holds a complete MSP packet
+static volatile bool mspPacketPending = false;
+#endif
+
 static void processRFMspPacket(volatile uint8_t *packet)
 {
     // Always examine MSP packets for bind information if in bind mode
@@ -629,21 +631,43 @@ static void processRFMspPacket(volatile uint8_t *packet)
     if (currentMspConfirmValue != getCurrentMspConfirm()) {
         nextTelemetryType = ELRS_TELEMETRY_TYPE_LINK;
     }
+
+    // The receiver stays locked until the RX task has processed the packet
     if (hasFinishedMspData()) {
-        if (mspBuffer[ELRS_MSP_COMMAND_INDEX] == ELRS_MSP_SET_RX_CONFIG && mspBuffer[ELRS_MSP_COMMAND_INDEX + 1] == ELRS_MSP_MODEL_ID) { //mspReceiverComplete
-            if (rxExpressLrsSpiConfig()->modelId != mspBuffer[9]) { //UpdateModelMatch
-                rxExpressLrsSpiConfigMutable()->modelId = mspBuffer[9];
-                receiver.configChanged = true;
-                receiver.connectionState = ELRS_DISCONNECT_PENDING;
-            }
-        } else if (connectionHasModelMatch) {
-            processMspPacket(mspBuffer);
+        mspPacketPending = true;
+    }
+#endif
+}
+
+#ifdef USE_MSP_OVER_TELEMETRY
+/**
+ * Process the assembled MSP packet in mspBuffer[] from the RX task
+ **/
+static void processPendingMspPacket(void)
+{
+    if (!mspPacketPending) {
+        return;
+    }
+
+    if (mspBuffer[ELRS_MSP_COMMAND_INDEX] == ELRS_MSP_SET_RX_CONFIG && mspBuffer[ELRS_MSP_COMMAND_INDEX + 1] == ELRS_MSP_MODEL_ID) { //mspReceiverComplete
+        if (rxExpressLrsSpiConfig()->modelId != mspBuffer[9]) { //UpdateModelMatch
+            rxExpressLrsSpiConfigMutable()->modelId = mspBuffer[9];
+            receiver.configChanged = true;
+            receiver.connectionState = ELRS_DISCONNECT_PENDING;
+        }
+    } else if (connectionHasModelMatch) {
+        if (!isMspReplySlotFree()) {
+            return;
         }
+        processMspPacket(mspBuffer);
+    }
 
+    ATOMIC_BLOCK(NVIC_PRIO_MAX) {
+        mspPacketPending = false;
         mspReceiverUnlock();
     }
-#endif
 }
+#endif
 
 static bool processRFSyncPacket(volatile uint8_t *packet, const uint32_t timeStampMs)
 {
@@ -1094,6 +1118,10 @@ rx_spi_received_e expressLrsDataReceived(uint8_t *payloadBuffer)
         enterBindingMode();
     }
 
+#ifdef USE_MSP_OVER_TELEMETRY
+    processPendingMspPacket();
+#endif
+
     const uint32_t timeStampMs = millis();
     handleConnectionStateUpdate(timeStampMs);
     handleConfigUpdate(timeStampMs);
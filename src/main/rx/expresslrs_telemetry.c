@@ -46,6 +46,10 @@
 #include "sensors/sensors.h"
 
 static uint8_t tlmBuffer[CRSF_FRAME_SIZE_MAX];
+#ifdef USE_MSP_OVER_TELEMETRY
+// MSP replies are built outside the radio interrupts, so they get their own buffer
+static uint8_t mspTlmBuffer[CRSF_FRAME_SIZE_MAX];
+#endif
 
 typedef enum {
     CRSF_FRAME_GPS_INDEX = 0,
@@ -279,7 +283,13 @@ static uint8_t mspFrameSize = 0;
 
 static void bufferMspResponse(uint8_t *payload, const uint8_t payloadSize)
 {
-    mspFrameSize = getCrsfMspFrame(tlmBuffer, payload, payloadSize);
+    mspFrameSize = getCrsfMspFrame(mspTlmBuffer, payload, payloadSize);
+}
+
+// The previous reply must have been sent before the next one is built
+bool isMspReplySlotFree(void)
+{
+    return !mspReplyPending && !isTelemetrySenderActive();
 }
 
 void processMspPacket(uint8_t *packet)
@@ -356,7 +366,7 @@ bool getNextTelemetryPayload(uint8_t *nextPayloadSize, uint8_t **payloadData)
         return true;
     } else if (mspReplyPending) {
         *nextPayloadSize = mspFrameSize;
-        *payloadData = tlmBuffer;
+        *payloadData = mspTlmBuffer;
         mspReplyPending = false;
         return true;
     } else
@@ -57,4 +57,5 @@ void setMspDataToReceive(const uint8_t maxLength, uint8_t* dataToReceive, const
 void receiveMspData(const uint8_t packageIndex, const volatile uint8_t* receiveData);
 bool hasFinishedMspData(void);
 void mspReceiverUnlock(void);
+bool isMspReplySlotFree(void);
 void processMspPacket(uint8_t *packet);
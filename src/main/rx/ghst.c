@@ -45,13 +45,14 @@
 
 #include "rx/rx.h"
 #include "rx/ghst.h"
+#include "rx/serial_frame.h"
 
 #include "telemetry/ghst.h"
 
 #define GHST_PORT_OPTIONS               (SERIAL_STOPBITS_1 | SERIAL_PARITY_NO | SERIAL_BIDIR | SERIAL_BIDIR_PP)
 #define GHST_PORT_MODE                  MODE_RXTX   // bidirectional on single pin
 
-#define GHST_MAX_FRAME_TIME_US          500         // 14 bytes @ 420k = ~450us
+#define GHST_MAX_BYTE_GAP_US            250         // one byte @ 420k = ~24us
 #define GHST_TIME_BETWEEN_FRAMES_US     4500        // fastest frame rate = 222.22Hz, or 4500us
 
 #define GHST_RSSI_DBM_MIN (-117)            // Long Range mode value
@@ -65,11 +66,10 @@
 
 #define GHST_PAYLOAD_OFFSET offsetof(ghstFrameDef_t, type)
 
-STATIC_UNIT_TESTED volatile bool ghstFrameAvailable = false;
 STATIC_UNIT_TESTED volatile bool ghstValidatedFrameAvailable = false;
 STATIC_UNIT_TESTED volatile bool ghstTransmittingTelemetry = false;
 
-STATIC_UNIT_TESTED ghstFrame_t ghstIncomingFrame;   // incoming frame, raw, not CRC checked, destination address not checked
+STATIC_UNIT_TESTED serialFrame_t ghstIncomingFrame; // incoming frame, raw, not CRC checked, destination address not checked
 STATIC_UNIT_TESTED ghstFrame_t ghstValidatedFrame;  // validated frame, CRC is ok, destination address is ok, ready for decode
 
 STATIC_UNIT_TESTED uint32_t ghstChannelData[GHST_MAX_NUM_CHANNELS];
@@ -82,7 +82,6 @@ enum {
 };
 
 static serialPort_t *serialPort;
-static timeUs_t ghstRxFrameStartAtUs = 0;
 static timeUs_t ghstRxFrameEndAtUs = 0;
 static uint8_t telemetryBuf[GHST_FRAME_SIZE_MAX];
 static uint8_t telemetryBufLen = 0;
@@ -137,42 +136,20 @@ STATIC_UNIT_TESTED uint8_t ghstFrameCRC(ghstFrame_t *pGhstFrame)
     return crc;
 }
 
-// Receive ISR callback, called back from serial port
-STATIC_UNIT_TESTED void ghstDataReceive(uint16_t c, void *data)
+static int ghstFrameLength(const uint8_t *data, unsigned count)
 {
-    UNUSED(data);
-
-    static uint8_t ghstFrameIdx = 0;
-    const timeUs_t currentTimeUs = microsISR();
-
-    if (cmpTimeUs(currentTimeUs, ghstRxFrameStartAtUs) > GHST_MAX_FRAME_TIME_US) {
-        // Character received after the max. frame time, assume that this is a new frame
-        ghstFrameIdx = 0;
+    if (count < GHST_FRAME_LENGTH_ADDRESS + GHST_FRAME_LENGTH_FRAMELENGTH) {
+        return 0;
     }
 
-    if (ghstFrameIdx == 0) {
-        // timestamp the start of the frame, to allow us to detect frame sync issues
-        ghstRxFrameStartAtUs = currentTimeUs;
-    }
-
-    // assume frame is 5 bytes long until we have received the frame length
     // full frame length includes the length of the address and framelength fields
-    const int fullFrameLength = ghstFrameIdx < 3 ? 5 : ghstIncomingFrame.frame.len + GHST_FRAME_LENGTH_ADDRESS + GHST_FRAME_LENGTH_FRAMELENGTH;
-
-    if (ghstFrameIdx < fullFrameLength) {
-        ghstIncomingFrame.bytes[ghstFrameIdx++] = (uint8_t)c;
-        if (ghstFrameIdx >= fullFrameLength) {
-            ghstFrameIdx = 0;
+    const int fullFrameLength = data[1] + GHST_FRAME_LENGTH_ADDRESS + GHST_FRAME_LENGTH_FRAMELENGTH;
 
-            // NOTE: this data is not yet CRC checked, nor do we know whether we are the correct recipient, this is
-            // handled in ghstFrameStatus
-            memcpy(&ghstValidatedFrame, &ghstIncomingFrame, sizeof(ghstIncomingFrame));
-            ghstFrameAvailable = true;
-
-            // remember what time the incoming (Rx) packet ended, so that we can ensure a quite bus before sending telemetry
-            ghstRxFrameEndAtUs = microsISR();
-        }
+    if (data[1] < GHST_FRAME_LENGTH_TYPE_CRC + 1 || fullFrameLength > (int)sizeof(ghstFrame_t)) {
+        return -1;
     }
+
+    return fullFrameLength;
 }
 
 static bool shouldSendTelemetryFrame(void)
@@ -187,8 +164,12 @@ STATIC_UNIT_TESTED uint8_t ghstFrameStatus(rxRuntimeState_t *rxRuntimeState)
     UNUSED(rxRuntimeState);
     static int16_t crcErrorCount = 0;
 
-    if (ghstFrameAvailable) {
-        ghstFrameAvailable = false;
+    if (serialFrameRead(&ghstIncomingFrame)) {
+        // NOTE: this data is not yet CRC checked, nor do we know whether we are the correct recipient
+        memcpy(ghstValidatedFrame.bytes, ghstIncomingFrame.data, ghstIncomingFrame.length);
+
+        // remember what time the incoming (Rx) packet ended, so that we can ensure a quite bus before sending telemetry
+        ghstRxFrameEndAtUs = ghstIncomingFrame.endUs;
 
         const uint8_t crc = ghstFrameCRC(&ghstValidatedFrame);
         const int fullFrameLength = ghstValidatedFrame.frame.len + GHST_FRAME_LENGTH_ADDRESS + GHST_FRAME_LENGTH_FRAMELENGTH;
@@ -332,15 +313,16 @@ bool ghstRxInit(const rxConfig_t *rxConfig, rxRuntimeState_t *rxRuntimeState)
         return false;
     }
 
-    serialPort = openSerialPort(portConfig->identifier,
-        FUNCTION_RX_SERIAL,
-        ghstDataReceive,
-        NULL,
+    serialPort = serialFrameOpen(portConfig,
         GHST_RX_BAUDRATE,
         GHST_PORT_MODE,
-        GHST_PORT_OPTIONS | (rxConfig->serialrx_inverted ? SERIAL_INVERTED : 0)
+        GHST_PORT_OPTIONS | (rxConfig->serialrx_inverted ? SERIAL_INVERTED : 0),
+        ghstFrameLength,
+        GHST_MAX_BYTE_GAP_US
         );
-    serialPort->idleCallback = ghstIdle;
+    if (serialPort) {
+        serialPort->idleCallback = ghstIdle;
+    }
 
     if (rssiSource == RSSI_SOURCE_NONE) {
         rssiSource = RSSI_SOURCE_RX_PROTOCOL;
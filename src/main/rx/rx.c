@@ -32,6 +32,7 @@
 #include "common/maths.h"
 #include "common/utils.h"
 #include "common/filter.h"
+#include "common/movavg.h"
 
 #include "config/config.h"
 #include "config/config_reset.h"
@@ -42,6 +43,7 @@
 #include "drivers/time.h"
 
 #include "fc/rc_controls.h"
+#include "fc/eventlog.h"
 #include "fc/rc_modes.h"
 #include "fc/runtime_config.h"
 #include "fc/tasks.h"
@@ -56,6 +58,7 @@
 
 #include "rx/rx.h"
 #include "rx/pwm.h"
+#include "rx/rx_timing.h"
 #include "rx/fport.h"
 #include "rx/sbus.h"
 #include "rx/spektrum.h"
@@ -113,8 +116,10 @@ float rcInput[MAX_SUPPORTED_RC_CHANNEL_COUNT];            // actual value used (
 
 uint32_t validRxSignalTimeout[MAX_SUPPORTED_RC_CHANNEL_COUNT];
 
+static uint32_t rxHoldChannelMask = 0;                  // channels holding their last valid value
+static timeMs_t rxHoldExpiryMs = 0;                     // first hold period to run out
+
 #define MAX_INVALID_PULSE_TIME_MS 300                   // hold time in milliseconds after bad channel or Rx link loss
-// will not be actioned until the nearest multiple of 100ms
 #define PPM_AND_PWM_SAMPLE_COUNT 3
 
 #define DELAY_20_MS (20 * 1000)                         // 20ms in us
@@ -125,6 +130,9 @@ uint32_t validRxSignalTimeout[MAX_SUPPORTED_RC_CHANNEL_COUNT];
 rxRuntimeState_t rxRuntimeState;
 static uint8_t rcSampleIndex = 0;
 
+static timeUs_t rxFrameReceivedUs = 0;     // timestamp of the last received frame
+static timeUs_t rxChannelsTimeUs = 0;      // timestamp of the frame in rcInput
+
 PG_REGISTER_ARRAY_WITH_RESET_FN(rxFailsafeChannelConfig_t, MAX_SUPPORTED_RC_CHANNEL_COUNT, rxFailsafeChannelConfigs, PG_RX_FAILSAFE_CHANNEL_CONFIG, 0);
 void pgResetFn_rxFailsafeChannelConfigs(rxFailsafeChannelConfig_t *rxFailsafeChannelConfigs)
 {
@@ -385,16 +393,12 @@ void resumeRxSignal(void)
 #ifdef USE_RX_LINK_QUALITY_INFO
 #define LINK_QUALITY_SAMPLE_COUNT 16
 
+static int16_t linkQualitySamples[LINK_QUALITY_SAMPLE_COUNT];
+static movingAverage_t linkQualityAverage = MOVING_AVERAGE_INIT(linkQualitySamples);
+
 STATIC_UNIT_TESTED uint16_t updateLinkQualitySamples(uint16_t value)
 {
-    static uint16_t samples[LINK_QUALITY_SAMPLE_COUNT];
-    static uint8_t sampleIndex = 0;
-    static uint16_t sum = 0;
-
-    sum += value - samples[sampleIndex];
-    samples[sampleIndex] = value;
-    sampleIndex = (sampleIndex + 1) % LINK_QUALITY_SAMPLE_COUNT;
-    return sum / LINK_QUALITY_SAMPLE_COUNT;
+    return movingAverageUpdate(&linkQualityAverage, value);
 }
 
 void rxSetRfMode(uint8_t rfModeValue)
@@ -504,7 +508,13 @@ void rxFrameCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTimeUs)
     if (signalReceived) {
         //  true only when a new packet arrives
         needRxSignalBefore = currentTimeUs + needRxSignalMaxDelayUs;
+        if (!rxSignalReceived) {
+            eventLog(EVENT_RX_SIGNAL, 1);
+        }
         rxSignalReceived = true; // immediately process packet data
+        // use the protocol timestamp if available, otherwise the time the frame was detected
+        rxFrameReceivedUs = rxRuntimeState.rcFrameTimeUsFn ? rxRuntimeState.rcFrameTimeUsFn() : currentTimeUs;
+        rxTimingUpdate(rxFrameReceivedUs);
         if (useDataDrivenProcessing) {
             rxDataProcessingRequired = true;
             //  process the new Rx packet when it arrives
@@ -513,11 +523,18 @@ void rxFrameCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTimeUs)
         //  watch for next packet
         if (cmpTimeUs(currentTimeUs, needRxSignalBefore) > 0) {
             //  initial time to signalReceived failure is 100ms, then we check every 100ms
+            if (rxSignalReceived) {
+                eventLog(EVENT_RX_SIGNAL, 0);
+            }
             rxSignalReceived = false;
             needRxSignalBefore = currentTimeUs + needRxSignalMaxDelayUs;
             //  review and process rcInput values every 100ms in case failsafe changed them
             rxDataProcessingRequired = true;
         }
+        else if (rxHoldChannelMask && cmp32(millis(), rxHoldExpiryMs) >= 0) {
+            //  apply stage 1 values as soon as the hold period is over
+            rxDataProcessingRequired = true;
+        }
     }
 
     DEBUG_SET(DEBUG_RX_SIGNAL_LOSS, 0, rxSignalReceived);
@@ -571,6 +588,9 @@ void detectAndApplySignalLossBehaviour(void)
     const uint32_t currentTimeMs = millis();
     const bool failsafeAuxSwitch = IS_RC_MODE_ACTIVE(BOXFAILSAFE);
 
+    uint32_t holdChannelMask = 0;
+    timeMs_t holdExpiryMs = currentTimeMs + MAX_INVALID_PULSE_TIME_MS;
+
     //  set rxFlightChannelsValid false when a packet is bad or we use a failsafe switch
     rxFlightChannelsValid = rxSignalReceived && !failsafeAuxSwitch;
 
@@ -591,6 +611,11 @@ void detectAndApplySignalLossBehaviour(void)
             if (cmp32(currentTimeMs, validRxSignalTimeout[channel]) < 0) {
                 // HOLD last valid value on bad channel/s (300ms)
                 sample = rcInput[channel];
+
+                holdChannelMask |= BIT(channel);
+                if (cmp32(validRxSignalTimeout[channel], holdExpiryMs) < 0) {
+                    holdExpiryMs = validRxSignalTimeout[channel];
+                }
             }
             // Stage 1 failsafe after timeout (300ms)
             else {
@@ -612,6 +637,9 @@ void detectAndApplySignalLossBehaviour(void)
         }
     }
 
+    rxHoldChannelMask = holdChannelMask;
+    rxHoldExpiryMs = holdExpiryMs;
+
     if (rxFlightChannelsValid) {
         //  --> start the timer to exit stage 2 failsafe
         failsafeOnValidDataReceived();
@@ -647,6 +675,8 @@ bool calculateRxChannelsAndUpdateFailsafe(timeUs_t currentTimeUs)
     readRxChannels();                       // returns rcChannel
     detectAndApplySignalLossBehaviour();    // returns rcInput
 
+    rxChannelsTimeUs = rxFrameReceivedUs;
+
     rcSampleIndex++;
 
     return true;
@@ -676,16 +706,12 @@ void setRssiDirect(uint16_t newRssi, rssiSource_e source)
 
 #define RSSI_SAMPLE_COUNT 16
 
+static int16_t rssiSamples[RSSI_SAMPLE_COUNT];
+static movingAverage_t rssiAverage = MOVING_AVERAGE_INIT(rssiSamples);
+
 static uint16_t updateRssiSamples(uint16_t value)
 {
-    static uint16_t samples[RSSI_SAMPLE_COUNT];
-    static uint8_t sampleIndex = 0;
-    static unsigned sum = 0;
-
-    sum += value - samples[sampleIndex];
-    samples[sampleIndex] = value;
-    sampleIndex = (sampleIndex + 1) % RSSI_SAMPLE_COUNT;
-    return sum / RSSI_SAMPLE_COUNT;
+    return movingAverageUpdate(&rssiAverage, value);
 }
 
 void setRssi(uint16_t rssiValue, rssiSource_e source)
@@ -786,16 +812,12 @@ int16_t getRssiDbm(void)
 
 #define RSSI_SAMPLE_COUNT_DBM 16
 
+static int16_t rssiDbmSamples[RSSI_SAMPLE_COUNT_DBM];
+static movingAverage_t rssiDbmAverage = MOVING_AVERAGE_INIT(rssiDbmSamples);
+
 static int16_t updateRssiDbmSamples(int16_t value)
 {
-    static int16_t samplesdbm[RSSI_SAMPLE_COUNT_DBM];
-    static uint8_t sampledbmIndex = 0;
-    static int sumdbm = 0;
-
-    sumdbm += value - samplesdbm[sampledbmIndex];
-    samplesdbm[sampledbmIndex] = value;
-    sampledbmIndex = (sampledbmIndex + 1) % RSSI_SAMPLE_COUNT_DBM;
-    return sumdbm / RSSI_SAMPLE_COUNT_DBM;
+    return movingAverageUpdate(&rssiDbmAverage, value);
 }
 
 void setRssiDbm(int16_t rssiDbmValue, rssiSource_e source)
@@ -873,4 +895,9 @@ timeDelta_t rxGetFrameDelta(timeDelta_t *frameAgeUs)
 timeUs_t rxFrameTimeUs(void)
 {
     return rxRuntimeState.lastRcFrameTimeUs;
+}
+
+timeUs_t rxGetChannelsTimeUs(void)
+{
+    return rxChannelsTimeUs;
 }
\ No newline at end of file
@@ -228,3 +228,4 @@ uint16_t rxGetRefreshRate(void);
 timeDelta_t rxGetFrameDelta(timeDelta_t *frameAgeUs);
 
 timeUs_t rxFrameTimeUs(void);
+timeUs_t rxGetChannelsTimeUs(void);
@@ -0,0 +1,150 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * RX frame timing
+ *
+ * Estimates the frame period of the RX link from the frame timestamps,
+ * which the drivers take in the receive interrupt or at the end of the
+ * frame, whatever the protocol. The estimate is a second order phase
+ * locked loop: each frame is compared against the time predicted from
+ * the previous ones, and the error corrects both the predicted phase and
+ * the period. Missing frames are skipped over by whole periods.
+ *
+ * The period is acquired from the first two frames in range. Once frames
+ * stay within a quarter period of the prediction the loop is locked. It
+ * starts over when the average error grows, when every frame skips a
+ * period, or when the link stops for long, as after a rate change.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "platform.h"
+
+#include "common/maths.h"
+
+#include "rx/rx_timing.h"
+
+static struct {
+    rxTiming_t state;
+    timeUs_t frameTimeUs;       // last frame timestamp
+    timeUs_t phaseUs;           // estimated time of the last frame
+    uint8_t lockCount;
+    uint8_t skipCount;
+} rxt;
+
+
+void rxTimingReset(void)
+{
+    memset(&rxt, 0, sizeof(rxt));
+}
+
+static void rxTimingAcquire(timeUs_t frameTimeUs)
+{
+    const timeDelta_t deltaUs = cmpTimeUs(frameTimeUs, rxt.frameTimeUs);
+
+    if (rxt.frameTimeUs && deltaUs >= RX_TIMING_PERIOD_MIN_US && deltaUs <= RX_TIMING_PERIOD_MAX_US) {
+        rxt.state.periodUs = deltaUs;
+        rxt.phaseUs = frameTimeUs;
+    }
+
+    rxt.frameTimeUs = frameTimeUs;
+}
+
+// Start over from this frame
+static void rxTimingRestart(timeUs_t frameTimeUs)
+{
+    rxTimingReset();
+    rxt.frameTimeUs = frameTimeUs;
+}
+
+void rxTimingUpdate(timeUs_t frameTimeUs)
+{
+    if (frameTimeUs == rxt.frameTimeUs)
+        return;
+
+    if (rxt.state.periodUs == 0) {
+        rxTimingAcquire(frameTimeUs);
+        return;
+    }
+
+    const float periodUs = rxt.state.periodUs;
+
+    // Whole periods since the last frame
+    const int periods = MAX(lrintf(cmpTimeUs(frameTimeUs, rxt.phaseUs) / periodUs), 1);
+
+    if (periods > RX_TIMING_GAP_COUNT) {
+        rxTimingRestart(frameTimeUs);
+        return;
+    }
+
+    const timeUs_t expectedUs = rxt.phaseUs + lrintf(periods * periodUs);
+    const float errorUs = cmpTimeUs(frameTimeUs, expectedUs);
+
+    // Frames keep skipping periods when the rate dropped to a fraction
+    rxt.skipCount = (periods > 1) ? rxt.skipCount + 1 : 0;
+
+    if (rxt.skipCount >= RX_TIMING_SKIP_COUNT || rxt.state.jitterUs > periodUs / RX_TIMING_JITTER_LIMIT) {
+        rxTimingRestart(frameTimeUs);
+        return;
+    }
+
+    if (fabsf(errorUs) > periodUs / 4) {
+        rxt.lockCount = 0;
+        rxt.state.locked = false;
+    }
+    else if (rxt.lockCount < RX_TIMING_LOCK_COUNT) {
+        rxt.lockCount++;
+    }
+    else {
+        rxt.state.locked = true;
+    }
+
+    rxt.frameTimeUs = frameTimeUs;
+    rxt.phaseUs = expectedUs + lrintf(errorUs * RX_TIMING_PHASE_GAIN);
+
+    rxt.state.periodUs = constrainf(periodUs + errorUs * RX_TIMING_PERIOD_GAIN / periods,
+        RX_TIMING_PERIOD_MIN_US, RX_TIMING_PERIOD_MAX_US);
+    rxt.state.jitterUs += (fabsf(errorUs) - rxt.state.jitterUs) * RX_TIMING_JITTER_GAIN;
+
+    rxt.state.frames++;
+    rxt.state.missed += periods - 1;
+}
+
+const rxTiming_t *rxTimingGet(void)
+{
+    return &rxt.state;
+}
+
+float rxTimingGetPeriodUs(void)
+{
+    return rxt.state.periodUs;
+}
+
+float rxTimingGetJitterUs(void)
+{
+    return rxt.state.jitterUs;
+}
+
+bool rxTimingIsLocked(void)
+{
+    return rxt.state.locked;
+}
@@ -0,0 +1,53 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/time.h"
+
+#define RX_TIMING_PERIOD_MIN_US     490     // Fastest frame rate tracked, about 2kHz
+#define RX_TIMING_PERIOD_MAX_US     40000   // Slowest frame rate tracked, 25Hz
+
+#define RX_TIMING_PHASE_GAIN        0.1f    // Share of the frame time error taken into the phase
+#define RX_TIMING_PERIOD_GAIN       0.01f   // Share of the frame time error taken into the period
+#define RX_TIMING_JITTER_GAIN       0.03f   // Jitter averaging, about 32 frames
+
+#define RX_TIMING_LOCK_COUNT        16      // Frames within a quarter period before the estimate is used
+#define RX_TIMING_JITTER_LIMIT      8       // Jitter over this fraction of the period restarts the acquisition
+#define RX_TIMING_SKIP_COUNT        8       // Frames in a row that skip a period restart the acquisition
+#define RX_TIMING_GAP_COUNT         50      // Missing frames that restart the acquisition
+
+typedef struct {
+    float periodUs;             // estimated frame period, 0 until acquired
+    float jitterUs;             // average frame time error against the estimate
+    uint32_t frames;            // frames received since acquisition
+    uint32_t missed;            // frames missed since acquisition
+    bool locked;
+} rxTiming_t;
+
+void rxTimingReset(void);
+void rxTimingUpdate(timeUs_t frameTimeUs);
+
+const rxTiming_t *rxTimingGet(void);
+
+float rxTimingGetPeriodUs(void);
+float rxTimingGetJitterUs(void);
+bool rxTimingIsLocked(void);
@@ -26,6 +26,7 @@
 
 #ifdef USE_SBUS_CHANNELS
 
+#include "common/bitunpack.h"
 #include "common/utils.h"
 
 #include "pg/rx.h"
@@ -38,28 +39,17 @@
 #define SBUS_FLAG_CHANNEL_17        (1 << 0)
 #define SBUS_FLAG_CHANNEL_18        (1 << 1)
 
+#define SBUS_PACKED_CHANNEL_COUNT 16
+#define SBUS_PACKED_CHANNEL_BITS  11
+
 #define SBUS_DIGITAL_CHANNEL_MIN 173
 #define SBUS_DIGITAL_CHANNEL_MAX 1812
 
 uint8_t sbusChannelsDecode(rxRuntimeState_t *rxRuntimeState, const sbusChannels_t *channels)
 {
     uint16_t *sbusChannelData = rxRuntimeState->channelData;
-    sbusChannelData[0] = channels->chan0;
-    sbusChannelData[1] = channels->chan1;
-    sbusChannelData[2] = channels->chan2;
-    sbusChannelData[3] = channels->chan3;
-    sbusChannelData[4] = channels->chan4;
-    sbusChannelData[5] = channels->chan5;
-    sbusChannelData[6] = channels->chan6;
-    sbusChannelData[7] = channels->chan7;
-    sbusChannelData[8] = channels->chan8;
-    sbusChannelData[9] = channels->chan9;
-    sbusChannelData[10] = channels->chan10;
-    sbusChannelData[11] = channels->chan11;
-    sbusChannelData[12] = channels->chan12;
-    sbusChannelData[13] = channels->chan13;
-    sbusChannelData[14] = channels->chan14;
-    sbusChannelData[15] = channels->chan15;
+
+    bitUnpack16(sbusChannelData, (const uint8_t *)channels, SBUS_PACKED_CHANNEL_COUNT, SBUS_PACKED_CHANNEL_BITS);
 
     if (channels->flags & SBUS_FLAG_CHANNEL_17) {
         sbusChannelData[16] = SBUS_DIGITAL_CHANNEL_MAX;
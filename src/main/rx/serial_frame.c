@@ -0,0 +1,173 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Framed serial RX
+ *
+ * Shared byte-to-frame layer for the serial RX protocols with a length
+ * derived from the frame header. Only one serial RX protocol runs at a
+ * time, so there is a single receiver.
+ *
+ * On an interrupt driven port every byte is timestamped in the receive
+ * callback. With RX DMA the callback is not used; the bytes collect in
+ * the DMA ring and are drained by serialFrameRead(), and all bytes of
+ * one drain get the time of the drain.
+ *
+ * A frame is ended by its length, and a partial frame is dropped when the
+ * line has been idle for longer than the protocol allows between bytes.
+ * Completed frames go into a single producer, single consumer queue, and
+ * the reader always takes the latest one.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <stddef.h>
+
+#include "platform.h"
+
+#ifdef USE_SERIAL_RX
+
+#include "common/utils.h"
+
+#include "drivers/serial.h"
+#include "drivers/time.h"
+
+#include "io/serial.h"
+
+#include "rx/serial_frame.h"
+
+STATIC_ASSERT((SERIAL_FRAME_QUEUE_SIZE & (SERIAL_FRAME_QUEUE_SIZE - 1)) == 0, serial_frame_queue_size_not_power_of_2);
+
+#define SERIAL_FRAME_QUEUE_MASK     (SERIAL_FRAME_QUEUE_SIZE - 1)
+
+static struct {
+    serialPort_t *port;
+    serialFrameLengthFn frameLength;
+    timeDelta_t maxGapUs;
+    timeUs_t lastByteUs;
+    uint8_t position;
+    bool drained;
+    uint16_t errors;
+    serialFrame_t queue[SERIAL_FRAME_QUEUE_SIZE];
+    volatile uint8_t head;
+    uint8_t tail;
+} rx;
+
+static void serialFrameDrop(void)
+{
+    rx.position = 0;
+    rx.errors++;
+}
+
+// The frame being received is the queue slot at the head
+static void serialFrameReceive(uint8_t c, timeUs_t now, bool timed)
+{
+    serialFrame_t *frame = &rx.queue[rx.head & SERIAL_FRAME_QUEUE_MASK];
+
+    if (timed && rx.position > 0 && cmpTimeUs(now, rx.lastByteUs) > rx.maxGapUs) {
+        serialFrameDrop();
+    }
+
+    rx.lastByteUs = now;
+
+    if (rx.position == 0) {
+        frame->startUs = now;
+    }
+
+    frame->data[rx.position++] = c;
+
+    const int length = rx.frameLength(frame->data, rx.position);
+
+    if (length < 0 || length > SERIAL_FRAME_SIZE_MAX || (length == 0 && rx.position >= SERIAL_FRAME_SIZE_MAX)) {
+        serialFrameDrop();
+    }
+    else if (length > 0 && rx.position >= length) {
+        frame->length = length;
+        frame->endUs = now;
+        rx.position = 0;
+        rx.head++;
+    }
+}
+
+// Receive ISR callback
+static void serialFrameDataReceive(uint16_t c, void *data)
+{
+    UNUSED(data);
+
+    serialFrameReceive(c, microsISR(), true);
+}
+
+serialPort_t *serialFrameOpen(const serialPortConfig_t *portConfig,
+    uint32_t baudRate, portMode_e mode, portOptions_e options,
+    serialFrameLengthFn frameLength, timeDelta_t maxGapUs)
+{
+    memset(&rx, 0, sizeof(rx));
+
+    rx.frameLength = frameLength;
+    rx.maxGapUs = maxGapUs;
+
+    rx.port = openSerialPort(portConfig->identifier,
+        FUNCTION_RX_SERIAL,
+        serialFrameDataReceive,
+        NULL,
+        baudRate,
+        mode,
+        options
+        );
+
+    return rx.port;
+}
+
+bool serialFrameRead(serialFrame_t *frame)
+{
+    if (rx.port) {
+        const timeUs_t now = micros();
+        uint32_t count = serialRxBytesWaiting(rx.port);
+
+        if (count > 0) {
+            rx.drained = true;
+            while (count--) {
+                serialFrameReceive(serialRead(rx.port), now, false);
+            }
+        }
+        else if (rx.drained && rx.position > 0 && cmpTimeUs(now, rx.lastByteUs) > rx.maxGapUs) {
+            // Nothing arrived since the last drain: the line went idle mid-frame
+            serialFrameDrop();
+        }
+    }
+
+    const uint8_t head = rx.head;
+
+    if (head == rx.tail) {
+        return false;
+    }
+
+    const serialFrame_t *latest = &rx.queue[(head - 1) & SERIAL_FRAME_QUEUE_MASK];
+
+    memcpy(frame, latest, offsetof(serialFrame_t, data) + latest->length);
+    rx.tail = head;
+
+    return true;
+}
+
+uint16_t serialFrameErrors(void)
+{
+    return rx.errors;
+}
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/time.h"
+
+#include "drivers/serial.h"
+
+#include "io/serial.h"
+
+#define SERIAL_FRAME_SIZE_MAX       72      // SUMD with 32 channels is 69 bytes
+#define SERIAL_FRAME_QUEUE_SIZE     4       // must be a power of 2
+
+typedef struct {
+    timeUs_t startUs;           // arrival of the first byte
+    timeUs_t endUs;             // arrival of the last byte
+    uint8_t  length;
+    uint8_t  data[SERIAL_FRAME_SIZE_MAX];
+} serialFrame_t;
+
+// Full length of the frame from its first count bytes: 0 while it is not
+// known yet, -1 if the bytes cannot be the start of a frame.
+typedef int (*serialFrameLengthFn)(const uint8_t *data, unsigned count);
+
+serialPort_t *serialFrameOpen(const serialPortConfig_t *portConfig,
+    uint32_t baudRate, portMode_e mode, portOptions_e options,
+    serialFrameLengthFn frameLength, timeDelta_t maxGapUs);
+
+bool serialFrameRead(serialFrame_t *frame);
+
+uint16_t serialFrameErrors(void);
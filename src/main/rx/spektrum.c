@@ -49,6 +49,7 @@
 #include "pg/rx.h"
 
 #include "rx/rx.h"
+#include "rx/serial_frame.h"
 #include "rx/spektrum.h"
 
 #include "config/feature.h"
@@ -63,10 +64,10 @@ uint8_t rssi_channel;
 
 static uint8_t spek_chan_shift;
 static uint8_t spek_chan_mask;
-static bool rcFrameComplete = false;
 static bool spekHiRes = false;
 
-static volatile uint8_t spekFrame[SPEK_FRAME_SIZE];
+static serialFrame_t spekRxFrame;
+static uint8_t *const spekFrame = spekRxFrame.data;
 
 static rxRuntimeState_t *rxRuntimeStatePtr;
 static serialPort_t *serialPort;
@@ -76,31 +77,12 @@ static uint8_t telemetryBuf[SRXL_FRAME_SIZE_MAX];
 static uint8_t telemetryBufLen = 0;
 #endif
 
-// Receive ISR callback
-static void spektrumDataReceive(uint16_t c, void *data)
+static int spektrumFrameLength(const uint8_t *data, unsigned count)
 {
-    rxRuntimeState_t *const rxRuntimeState = (rxRuntimeState_t *const)data;
+    UNUSED(data);
+    UNUSED(count);
 
-    static timeUs_t spekTimeLast = 0;
-    static uint8_t spekFramePosition = 0;
-
-    const timeUs_t now = microsISR();
-    const timeUs_t spekTimeInterval = cmpTimeUs(now, spekTimeLast);
-    spekTimeLast = now;
-
-    if (spekTimeInterval > SPEKTRUM_NEEDED_FRAME_INTERVAL) {
-        spekFramePosition = 0;
-    }
-
-    if (spekFramePosition < SPEK_FRAME_SIZE) {
-        spekFrame[spekFramePosition++] = (uint8_t)c;
-        if (spekFramePosition < SPEK_FRAME_SIZE) {
-            rcFrameComplete = false;
-        } else {
-            rxRuntimeState->lastRcFrameTimeUs = now;
-            rcFrameComplete = true;
-        }
-    }
+    return SPEK_FRAME_SIZE;
 }
 
 
@@ -108,8 +90,6 @@ uint32_t spekChannelData[SPEKTRUM_MAX_SUPPORTED_CHANNEL_COUNT];
 
 static uint8_t spektrumFrameStatus(rxRuntimeState_t *rxRuntimeState)
 {
-    UNUSED(rxRuntimeState);
-
 #if defined(USE_TELEMETRY_SRXL)
     static timeUs_t telemetryFrameRequestedUs = 0;
 
@@ -118,8 +98,8 @@ static uint8_t spektrumFrameStatus(rxRuntimeState_t *rxRuntimeState)
 
     uint8_t result = RX_FRAME_PENDING;
 
-    if (rcFrameComplete) {
-        rcFrameComplete = false;
+    if (serialFrameRead(&spekRxFrame)) {
+        rxRuntimeState->lastRcFrameTimeUs = spekRxFrame.endUs;
 
 #if defined(USE_SPEKTRUM_REAL_RSSI) || defined(USE_SPEKTRUM_FAKE_RSSI)
         spektrumHandleRSSI(spekFrame);
@@ -394,14 +374,13 @@ bool spektrumInit(const rxConfig_t *rxConfig, rxRuntimeState_t *rxRuntimeState)
     rxRuntimeState->rcProcessFrameFn = spektrumProcessFrame;
 #endif
 
-    serialPort = openSerialPort(portConfig->identifier,
-        FUNCTION_RX_SERIAL,
-        spektrumDataReceive,
-        rxRuntimeState,
+    serialPort = serialFrameOpen(portConfig,
         SPEKTRUM_BAUDRATE,
         portShared || srxlEnabled ? MODE_RXTX : MODE_RX,
         (rxConfig->serialrx_inverted ? SERIAL_INVERTED : 0) |
-        ((srxlEnabled || rxConfig->halfDuplex) ? SERIAL_BIDIR : 0)
+        ((srxlEnabled || rxConfig->halfDuplex) ? SERIAL_BIDIR : 0),
+        spektrumFrameLength,
+        SPEKTRUM_NEEDED_FRAME_INTERVAL
         );
 
 #if defined(USE_TELEMETRY_SRXL)
@@ -108,9 +108,10 @@ static unsigned writeBufferIdx = 0;
 static serialPort_t *serialPort;
 
 static uint8_t busMasterDeviceId = 0xFF;
-static bool telemetryRequested = false;
 
+// The next telemetry frame is encoded ahead of our reply slot
 static uint8_t telemetryFrame[22];
+static bool telemetryFrameReady = false;
 
 uint8_t globalResult = 0;
 
@@ -198,7 +199,12 @@ bool srxl2ProcessControlData(const Srxl2Header* header, rxRuntimeState_t *rxRunt
     const Srxl2ControlDataSubHeader* controlData = (Srxl2ControlDataSubHeader*)(header + 1);
     const uint8_t ownId = (FlightController << 4) | unitId;
     if (controlData->replyId == ownId) {
-        telemetryRequested = true;
+        if (telemetryFrameReady) {
+            // The bus master may have changed since the frame was encoded
+            telemetryFrame[3] = busMasterDeviceId;
+            srxl2RxWriteData(telemetryFrame, sizeof(telemetryFrame));
+            telemetryFrameReady = false;
+        }
         DEBUG_PRINTF("command: %x replyId: %x ownId: %x\r\n", controlData->command, controlData->replyId, ownId);
     }
 
@@ -532,9 +538,9 @@ bool srxl2RxIsActive(void)
     return serialPort;
 }
 
-bool srxl2TelemetryRequested(void)
+bool srxl2TelemetryBufferEmpty(void)
 {
-    return telemetryRequested;
+    return !telemetryFrameReady;
 }
 
 void srxl2InitializeFrame(sbuf_t *dst)
@@ -550,10 +556,10 @@ void srxl2InitializeFrame(sbuf_t *dst)
 
 void srxl2FinalizeFrame(sbuf_t *dst)
 {
-  sbufSwitchToReader(dst, telemetryFrame);
-  // Include 2 additional bytes of length since we're letting the srxl2RxWriteData function add the CRC in
-  srxl2RxWriteData(sbufPtr(dst), sbufBytesRemaining(dst) + 2);
-  telemetryRequested = false;
+    UNUSED(dst);
+
+    // Sent with its CRC when the bus master polls us next
+    telemetryFrameReady = true;
 }
 
 void srxl2Bind(void)
@@ -41,6 +41,7 @@
 #include "pg/rx.h"
 
 #include "rx/rx.h"
+#include "rx/serial_frame.h"
 #include "rx/sumd.h"
 
 // driver for SUMD receiver using UART2
@@ -69,64 +70,40 @@
 #define SUMDV3_FRAME_STATE_OK 0x03
 #define SUMD_FRAME_STATE_FAILSAFE 0x81
 
-static bool sumdFrameDone = false;
 static uint16_t sumdChannels[MAX_SUPPORTED_RC_CHANNEL_COUNT];
-static uint16_t crc;
 
-static uint8_t sumd[SUMD_BUFFSIZE] = { 0, };
-static uint8_t sumdChannelCount;
-static timeUs_t lastFrameTimeUs = 0;
+static serialFrame_t sumdFrame;
 
-// Receive ISR callback
-static void sumdDataReceive(uint16_t c, void *data)
+static int sumdFrameLength(const uint8_t *data, unsigned count)
 {
-    UNUSED(data);
-
-    static timeUs_t sumdTimeLast;
-    static uint8_t sumdIndex;
-
-    const timeUs_t now = microsISR();
-    if (cmpTimeUs(now, sumdTimeLast) > SUMD_TIME_NEEDED_PER_FRAME) {
-        sumdIndex = 0;
-    }
-    sumdTimeLast = now;
-
-    if (sumdIndex == SUMD_SYNC_BYTE_INDEX) {
-        if (c != SUMD_SYNCBYTE) {
-            return;
-        } else {
-            sumdFrameDone = false; // lazy main loop didnt fetch the stuff
-            crc = 0;
-        }
-    } else if (sumdIndex == SUMD_CHANNEL_COUNT_INDEX) {
-        sumdChannelCount = (uint8_t)c;
+    if (data[SUMD_SYNC_BYTE_INDEX] != SUMD_SYNCBYTE) {
+        return -1;
     }
 
-    if (sumdIndex < SUMD_BUFFSIZE) {
-        sumd[sumdIndex] = (uint8_t)c;
+    if (count <= SUMD_CHANNEL_COUNT_INDEX) {
+        return 0;
     }
 
-    sumdIndex++;
-    if (sumdIndex <= sumdChannelCount * SUMD_BYTES_PER_CHANNEL + SUMD_HEADER_LENGTH) {
-        crc = crc16_ccitt(crc, (uint8_t)c);
-    } else if (sumdIndex == sumdChannelCount * SUMD_BYTES_PER_CHANNEL + SUMD_HEADER_LENGTH + SUMD_CRC_LENGTH) {
-        lastFrameTimeUs = now;
-        sumdIndex = 0;
-        sumdFrameDone = true;
+    const unsigned channelCount = data[SUMD_CHANNEL_COUNT_INDEX];
+
+    if (channelCount > SUMD_MAX_CHANNEL) {
+        return -1;
     }
+
+    return SUMD_HEADER_LENGTH + channelCount * SUMD_BYTES_PER_CHANNEL + SUMD_CRC_LENGTH;
 }
 
 static uint8_t sumdFrameStatus(rxRuntimeState_t *rxRuntimeState)
 {
-    UNUSED(rxRuntimeState);
-
     uint8_t frameStatus = RX_FRAME_PENDING;
 
-    if (!sumdFrameDone) {
+    if (!serialFrameRead(&sumdFrame)) {
         return frameStatus;
     }
 
-    sumdFrameDone = false;
+    const uint8_t *sumd = sumdFrame.data;
+    const uint8_t sumdChannelCount = sumd[SUMD_CHANNEL_COUNT_INDEX];
+    const uint16_t crc = crc16_ccitt_update(0, sumd, SUMD_HEADER_LENGTH + sumdChannelCount * SUMD_BYTES_PER_CHANNEL);
 
     // verify CRC
     if (crc == ((sumd[SUMD_BYTES_PER_CHANNEL * sumdChannelCount + SUMD_OFFSET_CHANNEL_1_HIGH] << 8) |
@@ -155,7 +132,7 @@ static uint8_t sumdFrameStatus(rxRuntimeState_t *rxRuntimeState)
     }
 
     if (!(frameStatus & (RX_FRAME_FAILSAFE | RX_FRAME_DROPPED))) {
-        rxRuntimeState->lastRcFrameTimeUs = lastFrameTimeUs;
+        rxRuntimeState->lastRcFrameTimeUs = sumdFrame.endUs;
     }
 
     return frameStatus;
@@ -189,13 +166,12 @@ bool sumdInit(const rxConfig_t *rxConfig, rxRuntimeState_t *rxRuntimeState)
     bool portShared = false;
 #endif
 
-    serialPort_t *sumdPort = openSerialPort(portConfig->identifier,
-        FUNCTION_RX_SERIAL,
-        sumdDataReceive,
-        NULL,
+    serialPort_t *sumdPort = serialFrameOpen(portConfig,
         SUMD_BAUDRATE,
         portShared ? MODE_RXTX : MODE_RX,
-        (rxConfig->serialrx_inverted ? SERIAL_INVERTED : 0) | (rxConfig->halfDuplex ? SERIAL_BIDIR : 0)
+        (rxConfig->serialrx_inverted ? SERIAL_INVERTED : 0) | (rxConfig->halfDuplex ? SERIAL_BIDIR : 0),
+        sumdFrameLength,
+        SUMD_TIME_NEEDED_PER_FRAME
         );
 
 #ifdef USE_TELEMETRY
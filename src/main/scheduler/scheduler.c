@@ -95,6 +95,11 @@ static uint32_t averageCPULoad = 0;
 static uint32_t averageSystemLoad = 0;
 static uint32_t maxRealTimeLoad = 0;
 
+static bool idleSleepEnabled = false;
+static uint32_t idleSleepCycles = 0;
+static int32_t idleSleepMinCycles = 0;
+static uint32_t averageIdleLoad = 0;
+
 static FAST_DATA_ZERO_INIT int taskQueuePos = 0;
 STATIC_UNIT_TESTED FAST_DATA_ZERO_INIT int taskQueueSize = 0;
 
@@ -103,6 +108,11 @@ static FAST_DATA_ZERO_INIT bool gyroEnabled;
 static int32_t desiredPeriodCycles;
 static uint32_t lastTargetCycles;
 
+static uint8_t loadShedLevel = 0;
+static uint8_t loadShedHoldCount = 0;
+static uint8_t loadShedRecoverCount = 0;
+static uint32_t gyroSkippedCycles = 0;
+
 static uint8_t skippedRxAttempts = 0;
 #ifdef USE_OSD
 static uint8_t skippedOSDAttempts = 0;
@@ -117,6 +127,9 @@ static uint32_t nextTimingCycles;
 
 static timeMs_t lastFailsafeCheckMs = 0;
 
+static bool taskSliceActive = false;
+static uint32_t taskSliceEndCycles;
+
 // No need for a linked list for the queue, since items are only inserted at startup
 
 STATIC_UNIT_TESTED FAST_DATA_ZERO_INIT task_t* taskQueueArray[TASK_COUNT + 1]; // extra item for NULL pointer at end of queue
@@ -183,6 +196,80 @@ static inline task_t *queueNext(void)
     return taskQueueArray[++taskQueuePos]; // guaranteed to be NULL at end of queue
 }
 
+// Tasks that can run slower when the CPU is short of time
+static bool isLoadShedTask(taskId_e taskId)
+{
+    switch (taskId) {
+#ifdef USE_OSD
+        case TASK_OSD:
+#endif
+#ifdef USE_LED_STRIP
+        case TASK_LEDSTRIP:
+#endif
+#ifdef USE_DASHBOARD
+        case TASK_DASHBOARD:
+#endif
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+ * Halve the rate of the cosmetic tasks, one level at a time, while the
+ * real time load is high or gyro cycles are being skipped. Restore a
+ * level after a stretch of headroom.
+ */
+static void updateLoadShedding(void)
+{
+    const uint16_t load = getMaxRealTimeLoad();
+    const bool overloaded = (load > SCHED_SHED_LOAD_HIGH || gyroSkippedCycles > 0);
+    const bool headroom = (load < SCHED_SHED_LOAD_LOW && gyroSkippedCycles == 0);
+    uint8_t level = loadShedLevel;
+
+    gyroSkippedCycles = 0;
+
+    if (loadShedHoldCount < SCHED_SHED_HOLD_COUNT) {
+        loadShedHoldCount++;
+    }
+
+    loadShedRecoverCount = headroom ? loadShedRecoverCount + 1 : 0;
+
+    if (!schedulerConfig()->loadShedding) {
+        level = 0;
+    }
+    else if (overloaded) {
+        if (level < SCHED_SHED_LEVEL_MAX && loadShedHoldCount >= SCHED_SHED_HOLD_COUNT) {
+            level++;
+        }
+    }
+    else if (level > 0 && loadShedRecoverCount >= SCHED_SHED_RECOVER_COUNT) {
+        level--;
+    }
+
+    if (level != loadShedLevel) {
+        loadShedLevel = level;
+        loadShedHoldCount = 0;
+        loadShedRecoverCount = 0;
+
+        for (int taskId = 0; taskId < TASK_COUNT; taskId++) {
+            if (isLoadShedTask(taskId)) {
+                getTask(taskId)->periodShift = level;
+            }
+        }
+    }
+}
+
+uint8_t schedulerGetLoadShedLevel(void)
+{
+    return loadShedLevel;
+}
+
+static inline timeDelta_t getTaskPeriodUs(const task_t *task)
+{
+    return task->attribute->desiredPeriodUs << task->periodShift;
+}
+
 void taskSystemLoad(timeUs_t currentTimeUs)
 {
     static timeUs_t lastExecutedAtUs;
@@ -203,11 +290,19 @@ void taskSystemLoad(timeUs_t currentTimeUs)
         schedulerIgnoreTaskExecTime();
     }
 
+    // Calculate time spent sleeping
+    if (deltaTime) {
+        averageIdleLoad = 1000 * (timeUs_t)clockCyclesToMicros(idleSleepCycles) / deltaTime;
+        idleSleepCycles = 0;
+    }
+
     // Update max RT load
     unsigned RTLoad = 100000 * maxRealTimeCycles / desiredPeriodCycles;
     maxRealTimeLoad = (RTLoad > maxRealTimeLoad) ? RTLoad : maxRealTimeLoad - ((maxRealTimeLoad - RTLoad) >> 3);
     maxRealTimeCycles = 0;
 
+    updateLoadShedding();
+
 #if defined(SIMULATOR_BUILD)
     averageCPULoad = 0;
     averageSystemLoad = 0;
@@ -227,6 +322,78 @@ void getCheckFuncInfo(cfCheckFuncInfo_t *checkFuncInfo)
     checkFuncInfo->averageDeltaTimeUs = checkFuncMovingSumDeltaTimeUs / TASK_STATS_MOVING_SUM_COUNT;
 }
 
+#if defined(USE_TASK_BUDGET_STATISTICS)
+// Bucket N >= 2 starts at (2 + (N & 1)) << (N / 2 - 1) us, buckets 0 and 1 hold 0us and 1us
+static timeUs_t taskBudgetBucketStart(int bucket)
+{
+    return (bucket < 2) ? (timeUs_t)bucket : (timeUs_t)(2 + (bucket & 1)) << (bucket / 2 - 1);
+}
+
+static FAST_CODE void taskBudgetRecord(task_t *task, timeUs_t executionTimeUs)
+{
+    int bucket = MIN(executionTimeUs, 1u);
+
+    if (executionTimeUs >= 2) {
+        const int msb = 31 - __builtin_clz(executionTimeUs);
+        bucket = MIN(2 * msb + (int)((executionTimeUs >> (msb - 1)) & 1), TASK_BUDGET_BUCKETS - 1);
+    }
+
+    // Keep the shape of the distribution when a bucket saturates
+    if (task->execHistogram[bucket] == UINT16_MAX) {
+        for (int i = 0; i < TASK_BUDGET_BUCKETS; i++) {
+            task->execHistogram[i] >>= 1;
+        }
+    }
+
+    task->execHistogram[bucket]++;
+    task->worstExecutionTimeUs = MAX(task->worstExecutionTimeUs, executionTimeUs);
+}
+
+static void getTaskBudget(const task_t *task, taskInfo_t *taskInfo)
+{
+    uint32_t samples = 0;
+
+    for (int i = 0; i < TASK_BUDGET_BUCKETS; i++) {
+        samples += task->execHistogram[i];
+    }
+
+    // Upper end of the bucket holding the percentile, limited by the worst case seen
+    const uint32_t threshold = samples - (samples * (100 - TASK_BUDGET_PERCENTILE)) / 100;
+    timeUs_t percentileUs = task->worstExecutionTimeUs;
+    uint32_t count = 0;
+
+    for (int i = 0; i < TASK_BUDGET_BUCKETS - 1; i++) {
+        count += task->execHistogram[i];
+        if (count >= threshold && count > 0) {
+            percentileUs = MIN(taskBudgetBucketStart(i + 1) - 1, task->worstExecutionTimeUs);
+            break;
+        }
+    }
+
+    taskInfo->budgetSamples = samples;
+    taskInfo->worstExecutionTimeUs = task->worstExecutionTimeUs;
+    taskInfo->percentileExecutionTimeUs = percentileUs;
+    taskInfo->deadlineOverrunCount = task->deadlineOverrunCount;
+    taskInfo->maxDeadlineOverrunUs = task->maxDeadlineOverrunUs;
+}
+#endif
+
+void schedulerResetTaskBudget(taskId_e taskId)
+{
+#if defined(USE_TASK_BUDGET_STATISTICS)
+    task_t *task = (taskId == TASK_SELF) ? currentTask : (taskId < TASK_COUNT) ? getTask(taskId) : NULL;
+
+    if (task) {
+        memset(task->execHistogram, 0, sizeof(task->execHistogram));
+        task->worstExecutionTimeUs = 0;
+        task->deadlineOverrunCount = 0;
+        task->maxDeadlineOverrunUs = 0;
+    }
+#else
+    UNUSED(taskId);
+#endif
+}
+
 void getTaskInfo(taskId_e taskId, taskInfo_t * taskInfo)
 {
     taskInfo->isEnabled = queueContains(getTask(taskId));
@@ -245,6 +412,15 @@ void getTaskInfo(taskId_e taskId, taskInfo_t * taskInfo)
     taskInfo->runCount = getTask(taskId)->runCount;
     taskInfo->execTime = getTask(taskId)->execTime;
 #endif
+#if defined(USE_TASK_BUDGET_STATISTICS)
+    getTaskBudget(getTask(taskId), taskInfo);
+#endif
+}
+
+// The task last dispatched by the scheduler
+taskId_e getCurrentTaskId(void)
+{
+    return currentTask ? (taskId_e)(currentTask - tasks) : TASK_NONE;
 }
 
 void rescheduleTask(taskId_e taskId, timeDelta_t newPeriodUs)
@@ -263,6 +439,20 @@ void rescheduleTask(taskId_e taskId, timeDelta_t newPeriodUs)
     // Catch the case where the gyro loop is adjusted
     if (taskId == TASK_GYRO) {
         desiredPeriodCycles = (int32_t)clockMicrosToCycles((uint32_t)getTask(TASK_GYRO)->attribute->desiredPeriodUs);
+
+    idleSleepMinCycles = clockMicrosToCycles(SCHED_IDLE_MIN_US);
+    idleSleepEnabled = schedulerConfig()->idleSleep;
+
+#if !defined(UNIT_TEST) && !defined(SIMULATOR_BUILD)
+    // Keep the core clock running in sleep so that the DWT cycle counter stays valid
+    if (idleSleepEnabled) {
+#if defined(DBGMCU_CR_DBG_SLEEPD1)
+        DBGMCU->CR |= DBGMCU_CR_DBG_SLEEPD1;
+#elif defined(DBGMCU_CR_DBG_SLEEP)
+        DBGMCU->CR |= DBGMCU_CR_DBG_SLEEP;
+#endif
+    }
+#endif
     }
 }
 
@@ -389,6 +579,108 @@ FAST_CODE timeDelta_t schedulerGetNextStateTime()
     return currentTask->anticipatedExecutionTime >> TASK_EXEC_TIME_SHIFT;
 }
 
+#ifdef USE_SCHEDULER_TRACE
+static schedulerTraceEntry_t traceBuffer[SCHEDULER_TRACE_SIZE];
+static uint32_t traceHead;          // Total entries written since start
+static uint32_t traceRemaining;     // Entries still to record after the trigger
+static uint32_t traceTriggerCycles;
+static schedulerTraceState_e traceState = SCHEDULER_TRACE_IDLE;
+
+void schedulerTraceStart(timeUs_t triggerUs)
+{
+    traceState = SCHEDULER_TRACE_IDLE;
+
+    traceHead = 0;
+    traceRemaining = SCHEDULER_TRACE_SIZE / 2;
+    traceTriggerCycles = triggerUs ? clockMicrosToCycles(triggerUs) : UINT32_MAX;
+
+    traceState = SCHEDULER_TRACE_RUNNING;
+}
+
+void schedulerTraceStop(void)
+{
+    traceState = SCHEDULER_TRACE_IDLE;
+}
+
+schedulerTraceState_e schedulerTraceState(void)
+{
+    return traceState;
+}
+
+unsigned schedulerTraceCount(void)
+{
+    return MIN(traceHead, SCHEDULER_TRACE_SIZE);
+}
+
+// Index 0 is the oldest entry in the buffer
+const schedulerTraceEntry_t *schedulerTraceGet(unsigned index)
+{
+    if (index >= schedulerTraceCount())
+        return NULL;
+
+    const uint32_t first = traceHead - schedulerTraceCount();
+
+    return &traceBuffer[(first + index) & (SCHEDULER_TRACE_SIZE - 1)];
+}
+
+static FAST_CODE void schedulerTraceRecord(const task_t *task, uint32_t startCycles, uint32_t durationCycles, uint16_t priority)
+{
+    if (traceState == SCHEDULER_TRACE_RUNNING || traceState == SCHEDULER_TRACE_TRIGGERED) {
+        schedulerTraceEntry_t *entry = &traceBuffer[traceHead & (SCHEDULER_TRACE_SIZE - 1)];
+
+        entry->startCycles = startCycles;
+        entry->durationCycles = durationCycles;
+        entry->taskId = task - tasks;
+        entry->priority = MIN(priority, UINT8_MAX);
+        entry->flags = 0;
+
+        traceHead++;
+
+        if (traceState == SCHEDULER_TRACE_RUNNING) {
+            if (durationCycles > traceTriggerCycles) {
+                entry->flags |= SCHEDULER_TRACE_TRIGGER;
+                traceState = SCHEDULER_TRACE_TRIGGERED;
+            }
+        }
+        else if (--traceRemaining == 0) {
+            traceState = SCHEDULER_TRACE_FROZEN;
+        }
+    }
+}
+
+static FAST_CODE void schedulerTraceMarkLate(void)
+{
+    if ((traceState == SCHEDULER_TRACE_RUNNING || traceState == SCHEDULER_TRACE_TRIGGERED) && traceHead) {
+        traceBuffer[(traceHead - 1) & (SCHEDULER_TRACE_SIZE - 1)].flags |= SCHEDULER_TRACE_LATE;
+    }
+}
+#endif
+
+static FAST_CODE void schedulerStartTaskSlice(const task_t *task)
+{
+    taskSliceEndCycles = getCycleCounter() + clockMicrosToCycles(SCHED_TASK_SLICE_US);
+
+    // The slice of a background task also ends before the next gyro cycle
+    if (gyroEnabled && task->attribute->staticPriority != TASK_PRIORITY_REALTIME) {
+        const uint32_t gyroLimitCycles = schedulerGetNextTargetCycles() - taskGuardCycles;
+        if (cmpTimeCycles(gyroLimitCycles, taskSliceEndCycles) < 0) {
+            taskSliceEndCycles = gyroLimitCycles;
+        }
+    }
+
+    taskSliceActive = true;
+}
+
+/*
+ * Long running tasks call this between steps of their work, and return
+ * when it is true to resume on their next run. It is never true outside
+ * of a task.
+ */
+bool schedulerTaskSliceExpired(void)
+{
+    return taskSliceActive && cmpTimeCycles(getCycleCounter(), taskSliceEndCycles) >= 0;
+}
+
 FAST_CODE timeUs_t schedulerExecuteTask(task_t *selectedTask, timeUs_t currentTimeUs)
 {
     timeUs_t taskExecutionTimeUs = 0;
@@ -401,13 +693,24 @@ FAST_CODE timeUs_t schedulerExecuteTask(task_t *selectedTask, timeUs_t currentTi
         float period = currentTimeUs - selectedTask->lastExecutedAtUs;
 
         selectedTask->lastExecutedAtUs = currentTimeUs;
-        selectedTask->lastDesiredAt += selectedTask->attribute->desiredPeriodUs;
+        selectedTask->lastDesiredAt += getTaskPeriodUs(selectedTask);
+#ifdef USE_SCHEDULER_TRACE
+        const uint16_t selectedPriority = selectedTask->dynamicPriority;
+#endif
         selectedTask->dynamicPriority = 0;
 
         // Execute task
+#ifdef USE_SCHEDULER_TRACE
+        const uint32_t traceStartCycles = getCycleCounter();
+#endif
+        schedulerStartTaskSlice(selectedTask);
         const timeUs_t currentTimeBeforeTaskCallUs = micros();
         selectedTask->attribute->taskFunc(currentTimeBeforeTaskCallUs);
         const timeUs_t currentTimeAfterTaskCallUs = micros();
+        taskSliceActive = false;
+#ifdef USE_SCHEDULER_TRACE
+        schedulerTraceRecord(selectedTask, traceStartCycles, getCycleCounter() - traceStartCycles, selectedPriority);
+#endif
 
         taskExecutionTimeUs = currentTimeAfterTaskCallUs - currentTimeBeforeTaskCallUs;
         taskTotalExecutionTime += taskExecutionTimeUs;
@@ -436,6 +739,10 @@ FAST_CODE timeUs_t schedulerExecuteTask(task_t *selectedTask, timeUs_t currentTi
             selectedTask->maxExecutionTimeUs = MAX(selectedTask->maxExecutionTimeUs, taskExecutionTimeUs);
         }
 
+#if defined(USE_TASK_BUDGET_STATISTICS)
+        taskBudgetRecord(selectedTask, taskExecutionTimeUs);
+#endif
+
         selectedTask->totalExecutionTimeUs += taskExecutionTimeUs;   // time consumed by scheduler + task
         selectedTask->movingAverageCycleTimeUs += 0.05f * (period - selectedTask->movingAverageCycleTimeUs);
 #if defined(USE_LATE_TASK_STATISTICS)
@@ -470,6 +777,9 @@ FAST_CODE void scheduler(void)
     uint32_t startCycles;
     task_t *selectedTask = NULL;
     uint16_t selectedTaskDynamicPriority = 0;
+    task_t *deadlineTask = NULL;
+    timeUs_t deadlineTaskUs = 0;
+    bool taskExecuted = false;
     uint32_t nextTargetCycles = 0;
     int32_t schedLoopRemainingCycles;
 
@@ -496,6 +806,7 @@ FAST_CODE void scheduler(void)
              * task is non-deterministic
              * Recover as best we can, advancing scheduling by a whole number of cycles
              */
+            gyroSkippedCycles += 1 + (schedLoopRemainingCycles / -desiredPeriodCycles);
             nextTargetCycles += desiredPeriodCycles * (1 + (schedLoopRemainingCycles / -desiredPeriodCycles));
             schedLoopRemainingCycles = cmpTimeCycles(nextTargetCycles, nowCycles);
         }
@@ -619,6 +930,9 @@ FAST_CODE void scheduler(void)
     if (!gyroEnabled || (schedLoopRemainingCycles > (int32_t)clockMicrosToCycles(CHECK_GUARD_MARGIN_US))) {
         currentTimeUs = micros();
 
+        // Deadline class only applies once the gyro paces the loop
+        const bool deadlineEnabled = gyroEnabled && schedulerConfig()->deadlineScheduling;
+
         // Update task dynamic priorities
         for (task_t *task = queueFirst(); task != NULL; task = queueNext()) {
             if (task->attribute->staticPriority != TASK_PRIORITY_REALTIME) {
@@ -626,7 +940,7 @@ FAST_CODE void scheduler(void)
                 if (task->attribute->checkFunc) {
                     // Increase priority for event driven tasks
                     if (task->dynamicPriority > 0) {
-                        task->taskAgePeriods = 1 + (cmpTimeUs(currentTimeUs, task->lastSignaledAtUs) / task->attribute->desiredPeriodUs);
+                        task->taskAgePeriods = 1 + (cmpTimeUs(currentTimeUs, task->lastSignaledAtUs) / getTaskPeriodUs(task));
                         task->dynamicPriority = 1 + task->attribute->staticPriority * task->taskAgePeriods;
                         totalWaitingTaskCount++;
                     } else if (task->attribute->checkFunc(currentTimeUs, cmpTimeUs(currentTimeUs, task->lastExecutedAtUs))) {
@@ -645,14 +959,36 @@ FAST_CODE void scheduler(void)
                 } else {
                     // Task is time-driven, dynamicPriority is last execution age (measured in desiredPeriods)
                     // Task age is calculated from last execution
-                    task->taskAgePeriods = (cmpTimeUs(currentTimeUs, task->lastExecutedAtUs) / task->attribute->desiredPeriodUs);
+                    task->taskAgePeriods = (cmpTimeUs(currentTimeUs, task->lastExecutedAtUs) / getTaskPeriodUs(task));
                     if (task->taskAgePeriods > 0) {
                         task->dynamicPriority = 1 + task->attribute->staticPriority * task->taskAgePeriods;
                         totalWaitingTaskCount++;
                     }
                 }
 
-                if (task->dynamicPriority > selectedTaskDynamicPriority) {
+                if (deadlineEnabled && task->attribute->taskClass == TASK_CLASS_DEADLINE) {
+                    if (task->dynamicPriority > 0) {
+                        timeDelta_t taskRequiredTimeUs = task->anticipatedExecutionTime >> TASK_EXEC_TIME_SHIFT;
+                        int32_t taskRequiredTimeCycles = (int32_t)clockMicrosToCycles((uint32_t)taskRequiredTimeUs);
+                        taskRequiredTimeCycles += checkCycles + taskGuardCycles;
+
+                        // Deadline is one period after the task became ready
+                        const timeUs_t releaseUs = task->attribute->checkFunc ? task->lastSignaledAtUs :
+                            task->lastExecutedAtUs + getTaskPeriodUs(task);
+                        const timeUs_t taskDeadlineUs = releaseUs + getTaskPeriodUs(task);
+
+                        // Never start a deadline task that would run into the next gyro cycle
+                        if (taskRequiredTimeCycles < schedLoopRemainingCycles) {
+                            if (!deadlineTask || cmpTimeUs(taskDeadlineUs, deadlineTaskUs) < 0) {
+                                deadlineTaskUs = taskDeadlineUs;
+                                deadlineTask = task;
+                            }
+                        } else if (task->taskAgePeriods > TASK_AGE_EXPEDITE_DEADLINE) {
+                            // A stale high estimate would starve the task, so shrink it once it has waited for long
+                            task->anticipatedExecutionTime *= TASK_AGE_EXPEDITE_SCALE;
+                        }
+                    }
+                } else if (task->dynamicPriority > selectedTaskDynamicPriority) {
                     timeDelta_t taskRequiredTimeUs = task->anticipatedExecutionTime >> TASK_EXEC_TIME_SHIFT;
                     int32_t taskRequiredTimeCycles = (int32_t)clockMicrosToCycles((uint32_t)taskRequiredTimeUs);
                     // Allow a little extra time
@@ -671,6 +1007,16 @@ FAST_CODE void scheduler(void)
 
         }
 
+        // Use the slack for the earliest deadline, unless a priority task is pending
+        // and the deadline task has not yet missed its deadline
+        if (deadlineTask) {
+            if (!selectedTask || ((cmpTimeUs(currentTimeUs, deadlineTaskUs) >= 0) &&
+                                  (deadlineTask->dynamicPriority > selectedTaskDynamicPriority))) {
+                selectedTaskDynamicPriority = deadlineTask->dynamicPriority;
+                selectedTask = deadlineTask;
+            }
+        }
+
         totalWaitingTaskSamples++;
 
         // The number of cycles taken to run the checkers is quite consistent with some higher spikes, but
@@ -693,10 +1039,17 @@ FAST_CODE void scheduler(void)
 
             if (!gyroEnabled || (taskRequiredTimeCycles < schedLoopRemainingCycles)) {
                 uint32_t antipatedEndCycles = nowCycles + taskRequiredTimeCycles;
+                taskExecuted = true;
                 taskExecutionTimeUs += schedulerExecuteTask(selectedTask, currentTimeUs);
                 nowCycles = getCycleCounter();
                 int32_t cyclesOverdue = cmpTimeCycles(nowCycles, antipatedEndCycles);
 
+#ifdef USE_SCHEDULER_TRACE
+                if (cyclesOverdue > 0) {
+                    schedulerTraceMarkLate();
+                }
+#endif
+
 #if defined(USE_LATE_TASK_STATISTICS)
                 if (cyclesOverdue > 0) {
                     if ((currentTask - tasks) != TASK_SERIAL) {
@@ -709,6 +1062,16 @@ FAST_CODE void scheduler(void)
                 }
 #endif  // USE_LATE_TASK_STATISTICS
 
+#if defined(USE_TASK_BUDGET_STATISTICS)
+                // Time by which this task pushed back the next gyro cycle
+                const int32_t cyclesPastDeadline = cmpTimeCycles(nowCycles, nextTargetCycles);
+                if (gyroEnabled && cyclesPastDeadline > 0) {
+                    const timeUs_t overrunUs = clockCyclesToMicros(cyclesPastDeadline);
+                    currentTask->deadlineOverrunCount++;
+                    currentTask->maxDeadlineOverrunUs = MAX(currentTask->maxDeadlineOverrunUs, overrunUs);
+                }
+#endif
+
                 if ((currentTask - tasks) == TASK_RX) {
                     skippedRxAttempts = 0;
                 }
@@ -728,6 +1091,8 @@ FAST_CODE void scheduler(void)
 #if defined(USE_LATE_TASK_STATISTICS)
                 taskCount++;
 #endif  // USE_LATE_TASK_STATISTICS
+            } else if (selectedTask == deadlineTask) {
+                // Deadline class tasks are expedited during selection
             } else if ((selectedTask->taskAgePeriods > TASK_AGE_EXPEDITE_COUNT) ||
 #ifdef USE_OSD
                        (((selectedTask - tasks) == TASK_OSD) && (TASK_AGE_EXPEDITE_OSD != 0) && (++skippedOSDAttempts > TASK_AGE_EXPEDITE_OSD)) ||
@@ -740,6 +1105,24 @@ FAST_CODE void scheduler(void)
         }
     }
 
+#if !defined(UNIT_TEST) && !defined(SIMULATOR_BUILD)
+    // Nothing left to run before the next gyro cycle. Sleep until an interrupt arrives;
+    // the gyro EXTI is locked to the cycle start so it wakes the loop on time.
+    if (idleSleepEnabled && gyroEnabled && !taskExecuted && !selectedTask) {
+        const gyroDev_t *gyro = gyroActiveDev();
+
+        if (gyro->gyroModeSPI != GYRO_EXTI_NO_INT && gyro->gyro_rate_sync) {
+            nowCycles = getCycleCounter();
+            schedLoopRemainingCycles = cmpTimeCycles(nextTargetCycles, nowCycles);
+
+            if (schedLoopRemainingCycles > schedLoopStartCycles + idleSleepMinCycles) {
+                __WFI();
+                idleSleepCycles += getCycleCounter() - nowCycles;
+            }
+        }
+    }
+#endif
+
 #if !defined(UNIT_TEST)
     DEBUG_SET(DEBUG_SCHEDULER, 2, micros() - schedulerStartTimeUs - taskExecutionTimeUs); // time spent in scheduler
 #endif
@@ -786,7 +1169,23 @@ uint8_t getMaxRealTimeLoadPercent(void)
     return maxRealTimeLoad / 1000;
 }
 
+uint16_t getAverageIdleLoad(void)
+{
+    return averageIdleLoad;
+}
+
+uint8_t getAverageIdleLoadPercent(void)
+{
+    return averageIdleLoad / 10;
+}
+
 float schedulerGetCycleTimeMultiplier(void)
 {
     return (float)clockMicrosToCycles(getTask(TASK_GYRO)->attribute->desiredPeriodUs) / desiredPeriodCycles;
 }
+
+// Cycle counter value at which the next gyro cycle is due
+uint32_t schedulerGetNextTargetCycles(void)
+{
+    return lastTargetCycles + desiredPeriodCycles;
+}
@@ -44,6 +44,8 @@
 
 #define CHECK_GUARD_MARGIN_US           2   // Add a margin to the amount of time allowed for a check function to run
 
+#define SCHED_IDLE_MIN_US               10  // Only sleep if the next gyro cycle is at least this far away
+
 // Some tasks have occasional peaks in execution time so normal moving average duration estimation doesn't work
 // Decay the estimated max task duration by 1/(1 << TASK_EXEC_TIME_SHIFT) on every invocation
 #define TASK_EXEC_TIME_SHIFT            7
@@ -52,11 +54,31 @@
 #define TASK_AGE_EXPEDITE_OSD           schedulerConfig()->osdRelaxDeterminism  // Make OSD tasks more schedulable if it's failed to be scheduled this many times
 #define TASK_AGE_EXPEDITE_COUNT         1   // Make aged tasks more schedulable
 #define TASK_AGE_EXPEDITE_SCALE         0.9 // By scaling their expected execution time
+#define TASK_AGE_EXPEDITE_DEADLINE      8   // Deadline class tasks are only expedited after missing this many periods
 
 // Gyro interrupt counts over which to measure loop time and skew
 #define GYRO_RATE_COUNT 10000
 #define GYRO_LOCK_COUNT 50
 
+// Per task execution time histogram, two buckets per octave of microseconds
+#define TASK_BUDGET_BUCKETS             24
+#define TASK_BUDGET_PERCENTILE          99
+
+// Scheduler execution trace
+#define SCHEDULER_TRACE_SIZE            256u // Must be a power of two
+#define SCHEDULER_TRACE_TRIGGER_US      500 // Default single run duration that freezes the trace
+#define SCHEDULER_TRACE_PAGE_SIZE       20u // Entries per MSP reply
+
+// Load shedding of the cosmetic tasks, checked by TASK_SYSTEM at 10Hz
+#define SCHED_SHED_LOAD_HIGH            800 // getMaxRealTimeLoad() that sheds a level
+#define SCHED_SHED_LOAD_LOW             600 // getMaxRealTimeLoad() that counts as headroom
+#define SCHED_SHED_HOLD_COUNT           5   // System load runs between shedding steps
+#define SCHED_SHED_RECOVER_COUNT        20  // System load runs of headroom to restore a level
+#define SCHED_SHED_LEVEL_MAX            3   // Each level halves the task rates
+
+// Cooperative slicing of long running tasks, see schedulerTaskSliceExpired()
+#define SCHED_TASK_SLICE_US             50  // Longest a task should run before it yields
+
 typedef enum {
     TASK_PRIORITY_REALTIME = -1, // Task will be run outside the scheduler logic
     TASK_PRIORITY_LOWEST = 1,
@@ -67,6 +89,11 @@ typedef enum {
     TASK_PRIORITY_MAX = 255
 } taskPriority_e;
 
+typedef enum {
+    TASK_CLASS_PRIORITY = 0,    // Selected by static priority and age
+    TASK_CLASS_DEADLINE,        // Earliest deadline first, only run if it fits the slack before the next gyro cycle
+} taskClass_e;
+
 typedef struct {
     timeUs_t     maxExecutionTimeUs;
     timeUs_t     totalExecutionTimeUs;
@@ -91,6 +118,13 @@ typedef struct {
     uint32_t     lateCount;
     timeUs_t     execTime;
 #endif
+#if defined(USE_TASK_BUDGET_STATISTICS)
+    uint32_t     budgetSamples;
+    timeUs_t     worstExecutionTimeUs;
+    timeUs_t     percentileExecutionTimeUs;
+    uint32_t     deadlineOverrunCount;
+    timeUs_t     maxDeadlineOverrunUs;
+#endif
 } taskInfo_t;
 
 typedef enum {
@@ -120,9 +154,6 @@ typedef enum {
 #ifdef USE_BARO
     TASK_BARO,
 #endif
-#ifdef USE_RANGEFINDER
-    TASK_RANGEFINDER,
-#endif
 #ifdef USE_DASHBOARD
     TASK_DASHBOARD,
 #endif
@@ -162,14 +193,18 @@ typedef enum {
     TASK_ADC_INTERNAL,
 #endif
 
-#ifdef USE_PINIOBOX
-    TASK_PINIOBOX,
-#endif
-
 #ifdef USE_CRSF_V3
     TASK_SPEED_NEGOTIATION,
 #endif
 
+#ifdef USE_BLACKBOX
+    TASK_BLACKBOX,
+#endif
+
+#ifdef USE_VIBRATION_ANALYSIS
+    TASK_VIBRATION,
+#endif
+
     /* Count of real tasks */
     TASK_COUNT,
 
@@ -186,6 +221,7 @@ typedef struct {
     void (*taskFunc)(timeUs_t currentTimeUs);
     timeDelta_t desiredPeriodUs;        // target period of execution
     const int8_t staticPriority;        // dynamicPriority grows in steps of this size
+    const uint8_t taskClass;            // taskClass_e
 } task_attribute_t;
 
 typedef struct {
@@ -199,6 +235,7 @@ typedef struct {
     timeUs_t lastExecutedAtUs;          // last time of invocation
     timeUs_t lastSignaledAtUs;          // time of invocation event for event-driven tasks
     timeUs_t lastDesiredAt;             // time of last desired execution
+    uint8_t  periodShift;               // desiredPeriodUs doubled this many times by load shedding
 
     // Statistics
     float    movingAverageCycleTimeUs;
@@ -213,10 +250,39 @@ typedef struct {
     uint32_t lateCount;
     timeUs_t execTime;
 #endif
+#if defined(USE_TASK_BUDGET_STATISTICS)
+    uint16_t execHistogram[TASK_BUDGET_BUCKETS];  // execution time histogram, halved on saturation
+    timeUs_t worstExecutionTimeUs;      // ungated worst case since the last reset
+    uint32_t deadlineOverrunCount;      // runs that ended after the next gyro cycle was due
+    timeUs_t maxDeadlineOverrunUs;      // worst delay caused to the gyro cycle
+#endif
 } task_t;
 
+#ifdef USE_SCHEDULER_TRACE
+typedef enum {
+    SCHEDULER_TRACE_LATE    = 0x01,      // Task overran its anticipated end time
+    SCHEDULER_TRACE_TRIGGER = 0x02,      // Entry that froze the trace
+} schedulerTraceFlags_e;
+
+typedef struct {
+    uint32_t startCycles;
+    uint32_t durationCycles;
+    uint8_t  taskId;
+    uint8_t  priority;                  // Dynamic priority when selected, saturated
+    uint8_t  flags;
+} schedulerTraceEntry_t;
+
+typedef enum {
+    SCHEDULER_TRACE_IDLE = 0,
+    SCHEDULER_TRACE_RUNNING,            // Recording, waiting for a trigger run
+    SCHEDULER_TRACE_TRIGGERED,          // Trigger seen, filling the post-trigger half
+    SCHEDULER_TRACE_FROZEN,             // Buffer held until read out
+} schedulerTraceState_e;
+#endif
+
 void getCheckFuncInfo(cfCheckFuncInfo_t *checkFuncInfo);
 void getTaskInfo(taskId_e taskId, taskInfo_t *taskInfo);
+taskId_e getCurrentTaskId(void);
 void rescheduleTask(taskId_e taskId, timeDelta_t newPeriodUs);
 void setTaskEnabled(taskId_e taskId, bool newEnabledState);
 timeDelta_t getTaskDeltaTimeUs(taskId_e taskId);
@@ -227,8 +293,10 @@ bool schedulerGetIgnoreTaskExecTime();
 void schedulerResetTaskStatistics(taskId_e taskId);
 void schedulerResetTaskMaxExecutionTime(taskId_e taskId);
 void schedulerResetCheckFunctionMaxExecutionTime(void);
+void schedulerResetTaskBudget(taskId_e taskId);
 void schedulerSetNextStateTime(timeDelta_t nextStateTime);
 timeDelta_t schedulerGetNextStateTime();
+bool schedulerTaskSliceExpired(void);
 void schedulerInit(void);
 void scheduler(void);
 timeUs_t schedulerExecuteTask(task_t *selectedTask, timeUs_t currentTimeUs);
@@ -240,4 +308,16 @@ uint8_t getAverageCPULoadPercent(void);
 uint8_t getAverageSystemLoadPercent(void);
 uint16_t getMaxRealTimeLoad(void);
 uint8_t getMaxRealTimeLoadPercent(void);
+uint8_t schedulerGetLoadShedLevel(void);
+uint16_t getAverageIdleLoad(void);
+uint8_t getAverageIdleLoadPercent(void);
 float schedulerGetCycleTimeMultiplier(void);
+uint32_t schedulerGetNextTargetCycles(void);
+
+#ifdef USE_SCHEDULER_TRACE
+void schedulerTraceStart(timeUs_t triggerUs);
+void schedulerTraceStop(void);
+schedulerTraceState_e schedulerTraceState(void);
+unsigned schedulerTraceCount(void);
+const schedulerTraceEntry_t *schedulerTraceGet(unsigned index);
+#endif
@@ -27,34 +27,18 @@
 
 #include "build/debug.h"
 
+#include "common/movavg.h"
 #include "common/utils.h"
 
 #include "drivers/adc.h"
 
-typedef struct movingAverageStateUint16_s {
-    uint32_t sum;
-    uint16_t *values;
-    uint8_t size;
-    uint8_t pos;
-} movingAverageStateUint16_t;
-
-uint16_t updateMovingAverageUint16(movingAverageStateUint16_t *state, uint16_t newValue)
-{
-    state->sum -= state->values[state->pos];
-    state->values[state->pos] = newValue;
-    state->sum += newValue;
-    state->pos = (state->pos + 1) % state->size;
-
-    return state->sum / state->size;
-}
-
 static uint16_t adcVrefintValue;
-static uint16_t adcVrefintValues[8];
-movingAverageStateUint16_t adcVrefintAverageState = { 0, adcVrefintValues, 8, 0 } ;
+static int16_t adcVrefintValues[8];
+static movingAverage_t adcVrefintAverageState = MOVING_AVERAGE_INIT(adcVrefintValues);
 
 static uint16_t adcTempsensorValue;
-static uint16_t adcTempsensorValues[8];
-movingAverageStateUint16_t adcTempsensorAverageState = { 0, adcTempsensorValues, 8, 0 } ;
+static int16_t adcTempsensorValues[8];
+static movingAverage_t adcTempsensorAverageState = MOVING_AVERAGE_INIT(adcTempsensorValues);
 
 static int16_t coreTemperature;
 static uint16_t vrefMv;
@@ -84,8 +68,8 @@ void adcInternalProcess(timeUs_t currentTimeUs)
     uint16_t vrefintSample = adcInternalReadVrefint();
     uint16_t tempsensorSample = adcInternalReadTempsensor();
 
-    adcVrefintValue = updateMovingAverageUint16(&adcVrefintAverageState, vrefintSample);
-    adcTempsensorValue = updateMovingAverageUint16(&adcTempsensorAverageState, tempsensorSample);
+    adcVrefintValue = movingAverageUpdate(&adcVrefintAverageState, vrefintSample);
+    adcTempsensorValue = movingAverageUpdate(&adcTempsensorAverageState, tempsensorSample);
 
     vrefMv = adcInternalCompensateVref(adcVrefintValue);
     coreTemperature = adcInternalComputeTemperature(adcTempsensorValue, vrefMv);
@@ -17,6 +17,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 #include <math.h>
 
 #include "platform.h"
@@ -125,6 +126,8 @@ static filter_t voltageFilter;
 static voltageMeter_t voltageMeter;
 static currentMeter_t currentMeter;
 
+static batterySnapshot_t batterySnapshot;
+
 static lowVoltageCutoff_t lowVoltageCutoff;
 
 static uint16_t batteryWarningVoltage;
@@ -208,6 +211,11 @@ uint32_t getBatteryCapacityUsed(void)
     return currentMeter.capacity;
 }
 
+const batterySnapshot_t * getBatterySnapshot(void)
+{
+    return &batterySnapshot;
+}
+
 batteryState_e getBatteryState(void)
 {
     return batteryState;
@@ -432,12 +440,25 @@ void taskBatteryAlerts(timeUs_t currentTimeUs)
 }
 
 
+/** Battery Snapshot **/
+
+static void batteryUpdateSnapshot(timeUs_t currentTimeUs)
+{
+    // Voltage, current and consumption from the same update,
+    // so that the consumers don't mix readings of different age
+    batterySnapshot.timestamp = currentTimeUs;
+    batterySnapshot.voltageSample = voltageMeter.sample;
+    batterySnapshot.voltage = batteryVoltage;
+    batterySnapshot.currentSample = currentMeter.sample;
+    batterySnapshot.current = batteryCurrent;
+    batterySnapshot.capacity = currentMeter.capacity;
+}
+
+
 /** Battery Voltage Task **/
 
 void taskBatteryVoltageUpdate(timeUs_t currentTimeUs)
 {
-    UNUSED(currentTimeUs);
-
     voltageSensorADCRefresh();
 
 #ifdef USE_ESC_SENSOR
@@ -461,6 +482,8 @@ void taskBatteryVoltageUpdate(timeUs_t currentTimeUs)
             break;
     }
 
+    batteryUpdateSnapshot(currentTimeUs);
+
     DEBUG(BATTERY, 0, voltageMeter.sample);
     DEBUG(BATTERY, 1, batteryVoltage);
 }
@@ -474,7 +497,7 @@ void taskBatteryCurrentUpdate(timeUs_t currentTimeUs)
 
 #ifdef USE_ESC_SENSOR
     if (featureIsEnabled(FEATURE_ESC_SENSOR)) {
-        currentSensorESCRefresh();
+        currentSensorESCRefresh(currentTimeUs);
     }
 #endif
 
@@ -494,6 +517,8 @@ void taskBatteryCurrentUpdate(timeUs_t currentTimeUs)
             break;
     }
 
+    batteryUpdateSnapshot(currentTimeUs);
+
     DEBUG(BATTERY, 2, currentMeter.sample);
     DEBUG(BATTERY, 3, batteryCurrent);
 }
@@ -503,6 +528,7 @@ void batteryInit(void)
 {
     voltageMeterReset(&voltageMeter);
     currentMeterReset(&currentMeter);
+    memset(&batterySnapshot, 0, sizeof(batterySnapshot));
 
     voltageSensorADCInit();
     currentSensorADCInit();
@@ -92,6 +92,15 @@ typedef struct lowVoltageCutoff_s {
     timeUs_t startTime;
 } lowVoltageCutoff_t;
 
+typedef struct {
+    timeUs_t timestamp;
+    uint32_t voltageSample;                 // mV
+    uint32_t voltage;                       // mV, filtered
+    uint32_t currentSample;                 // mA
+    uint32_t current;                       // mA, filtered
+    uint32_t capacity;                      // mAh
+} batterySnapshot_t;
+
 typedef enum {
     BATTERY_OK = 0,
     BATTERY_WARNING,
@@ -112,6 +121,7 @@ batteryState_e getConsumptionState(void);
 
 const voltageMeter_t * getBatteryVoltageMeter();
 const currentMeter_t * getBatteryCurrentMeter();
+const batterySnapshot_t * getBatterySnapshot(void);
 
 const char * getBatteryStateString(void);
 
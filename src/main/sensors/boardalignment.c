@@ -78,7 +78,43 @@ FAST_CODE void alignSensorViaMatrix(float *dest, fp_rotationMatrix_t* sensorRota
     }
 }
 
-FAST_CODE void alignSensorViaRotation(float *dest, uint8_t rotation)
+/*
+ * Build a single matrix for the sensor and board alignment, so that
+ * both are applied with one multiply per sample.
+ *
+ * Returns false if the result is a pure axis permutation, in which
+ * case alignSensorViaPermutation() can be used instead.
+ */
+bool buildSensorAlignmentMatrix(fp_rotationMatrix_t *rm, sensor_align_e alignment, const sensorAlignment_t *customAlignment)
+{
+    if (alignment != ALIGN_CUSTOM && standardBoardAlignment) {
+        return false;
+    }
+
+    sensorAlignment_t sensorAlignment = *customAlignment;
+    buildAlignmentFromStandardAlignment(&sensorAlignment, (alignment == ALIGN_DEFAULT) ? CW0_DEG : alignment);
+
+    fp_rotationMatrix_t sensorRotation;
+    buildRotationMatrixFromAlignment(&sensorAlignment, &sensorRotation);
+
+    if (standardBoardAlignment) {
+        *rm = sensorRotation;
+        return true;
+    }
+
+    // applyMatrixRotation() uses the transpose, so board after sensor is S * B
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            rm->m[i][j] = sensorRotation.m[i][0] * boardRotation.m[0][j] +
+                          sensorRotation.m[i][1] * boardRotation.m[1][j] +
+                          sensorRotation.m[i][2] * boardRotation.m[2][j];
+        }
+    }
+
+    return true;
+}
+
+FAST_CODE void alignSensorViaPermutation(float *dest, uint8_t rotation)
 {
     const float x = dest[X];
     const float y = dest[Y];
@@ -127,6 +163,11 @@ FAST_CODE void alignSensorViaRotation(float *dest, uint8_t rotation)
         dest[Z] = -z;
         break;
     }
+}
+
+FAST_CODE void alignSensorViaRotation(float *dest, uint8_t rotation)
+{
+    alignSensorViaPermutation(dest, rotation);
 
     if (!standardBoardAlignment) {
         alignBoard(dest);
@@ -22,6 +22,7 @@
 
 #include "common/axis.h"
 #include "common/maths.h"
+#include "common/sensor_alignment.h"
 
 #include "pg/pg.h"
 
@@ -35,5 +36,8 @@ PG_DECLARE(boardAlignment_t, boardAlignment);
 
 void alignSensorViaMatrix(float *dest, fp_rotationMatrix_t* rotationMatrix);
 void alignSensorViaRotation(float *dest, uint8_t rotation);
+void alignSensorViaPermutation(float *dest, uint8_t rotation);
+
+bool buildSensorAlignmentMatrix(fp_rotationMatrix_t *rm, sensor_align_e alignment, const sensorAlignment_t *customAlignment);
 
 void initBoardAlignment(const boardAlignment_t *boardAlignment);
@@ -27,6 +27,7 @@
 #if defined(USE_MAG)
 
 #include "common/axis.h"
+#include "common/utils.h"
 
 #include "config/config.h"
 
@@ -43,8 +44,10 @@
 #include "drivers/compass/compass_mpu925x_ak8963.h"
 #include "drivers/compass/compass_qmc5883l.h"
 
+#include "drivers/exti.h"
 #include "drivers/io.h"
 #include "drivers/light_led.h"
+#include "drivers/nvic.h"
 #include "drivers/time.h"
 
 #include "fc/runtime_config.h"
@@ -111,9 +114,18 @@ void pgResetFn_compassConfig(compassConfig_t *compassConfig)
     compassConfig->interruptTag = IO_TAG(MAG_INT_EXTI);
 }
 
+// Sampling rate for sensors that don't report their ODR
+#define COMPASS_DEFAULT_RATE_HZ     10
+
+// Retry interval while a read is in progress
+#define COMPASS_READ_RETRY_US       1000
+
 static int16_t magADCRaw[XYZ_AXIS_COUNT];
 static uint8_t magInit = 0;
 
+static timeUs_t magSampleDueAtUs = 0;
+static timeDelta_t magSamplePeriodUs = 0;
+
 void compassPreInit(void)
 {
 #ifdef USE_SPI
@@ -302,6 +314,42 @@ bool compassDetect(magDev_t *dev, sensor_align_e *alignment)
 }
 #endif // !SIMULATOR_BUILD
 
+#ifdef USE_MAG_DATA_READY_SIGNAL
+static void compassExtiHandler(extiCallbackRec_t *cb)
+{
+    magDev_t *mag = container_of(cb, magDev_t, exti);
+
+    mag->dataReady = true;
+}
+#endif
+
+static void compassConfigureDataReadyInterrupt(magDev_t *mag)
+{
+#ifdef USE_MAG_DATA_READY_SIGNAL
+    if (mag->magIntExtiTag == IO_TAG_NONE) {
+        return;
+    }
+
+    const IO_t magIntIO = IOGetByTag(mag->magIntExtiTag);
+
+#ifdef ENSURE_MAG_DATA_READY_IS_HIGH
+    uint8_t status = IORead(magIntIO);
+    if (!status) {
+        return;
+    }
+#endif
+
+    IOInit(magIntIO, OWNER_COMPASS_EXTI, 0);
+    EXTIHandlerInit(&mag->exti, compassExtiHandler);
+    EXTIConfig(magIntIO, &mag->exti, NVIC_PRIO_MPU_INT_EXTI, IOCFG_IN_FLOATING, BETAFLIGHT_EXTI_TRIGGER_RISING);
+    EXTIEnable(magIntIO);
+
+    mag->useDataReady = true;
+#else
+    UNUSED(mag);
+#endif
+}
+
 bool compassInit(void)
 {
     // initialize and calibration. turn on led during mag calibration (calibration routine blinks it)
@@ -325,6 +373,16 @@ bool compassInit(void)
 
     buildRotationMatrixFromAlignment(&compassConfig()->mag_customAlignment, &magDev.rotationMatrix);
 
+    if (magDev.sampleRateHz == 0) {
+        magDev.sampleRateHz = COMPASS_DEFAULT_RATE_HZ;
+    }
+
+    magSamplePeriodUs = TASK_PERIOD_HZ(magDev.sampleRateHz);
+
+    compassConfigureDataReadyInterrupt(&magDev);
+
+    rescheduleTask(TASK_COMPASS, magSamplePeriodUs);
+
     return true;
 }
 
@@ -349,14 +407,32 @@ bool compassIsCalibrationComplete(void)
     return tCal == 0;
 }
 
-uint32_t compassUpdate(timeUs_t currentTimeUs)
+/*
+ * The compass task is event driven. With the DRDY interrupt configured,
+ * a sample is read as soon as the sensor flags it, and the ODR timer only
+ * acts as a fallback for a missed edge. Otherwise the sensor is read at
+ * its output data rate.
+ */
+bool compassCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTimeUs)
 {
+    UNUSED(currentDeltaTimeUs);
+
+    return magDev.dataReady || cmpTimeUs(currentTimeUs, magSampleDueAtUs) >= 0;
+}
+
+void compassUpdate(timeUs_t currentTimeUs)
+{
+    magDev.dataReady = false;
+
     if (busBusy(&magDev.dev, NULL) || !magDev.read(&magDev, magADCRaw)) {
         // No action was taken as the read has not completed
         schedulerIgnoreTaskExecRate();
-        return 1000; // Wait 1ms between states
+        magSampleDueAtUs = currentTimeUs + COMPASS_READ_RETRY_US;
+        return;
     }
 
+    magSampleDueAtUs = currentTimeUs + (magDev.useDataReady ? 2 * magSamplePeriodUs : magSamplePeriodUs);
+
     for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
         mag.magADC[axis] = magADCRaw[axis];
     }
@@ -391,7 +467,5 @@ uint32_t compassUpdate(timeUs_t currentTimeUs)
             saveConfigAndNotify();
         }
     }
-
-    return TASK_PERIOD_HZ(10);
 }
 #endif // USE_MAG
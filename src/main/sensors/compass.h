@@ -62,7 +62,8 @@ typedef struct compassConfig_s {
 PG_DECLARE(compassConfig_t, compassConfig);
 
 bool compassIsHealthy(void);
-uint32_t compassUpdate(timeUs_t currentTime);
+bool compassCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTimeUs);
+void compassUpdate(timeUs_t currentTime);
 bool compassInit(void);
 void compassPreInit(void);
 void compassStartCalibration(void);
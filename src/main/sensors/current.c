@@ -111,7 +111,8 @@ void currentSensorADCRefresh(timeUs_t currentTimeUs)
 #ifdef USE_ADC
     static timeUs_t lastServiced = 0;
 
-    const timeDelta_t udpateDelta = cmp32(currentTimeUs, lastServiced);
+    // Nothing to integrate on the first call
+    const timeDelta_t updateDelta = lastServiced ? cmpTimeUs(currentTimeUs, lastServiced) : 0;
     lastServiced = currentTimeUs;
 
     for (unsigned i = 0; i < MAX_CURRENT_SENSOR_ADC; i++) {
@@ -124,9 +125,10 @@ void currentSensorADCRefresh(timeUs_t currentTimeUs)
             const uint16_t sample = adcGetChannel(channel);
             const float current = currentSensorADCToCurrent(i, sample);
 
+            // Trapezoidal integration between the oversampled readings
+            state->capacity += (uint64_t)(current + state->sample) * updateDelta / 2;
             state->sample = current;
             state->current = filterApply(&state->filter, current);
-            state->capacity += current * udpateDelta;
 
             DEBUG_AXIS(CURRENT_SENSOR, i, 0, sample);
             DEBUG_AXIS(CURRENT_SENSOR, i, 1, current);
@@ -182,6 +184,10 @@ void currentSensorADCInit(void)
 
 currentSensorState_t currentESCSensor;
 
+static uint32_t currentESCReported;     // mAh
+static uint64_t currentESCLocal;        // mAus
+static uint64_t currentESCOffset;       // mAus
+
 bool currentSensorESCReadMotor(uint8_t motorNumber, currentMeter_t *meter)
 {
     escSensorData_t *escData = getEscSensorData(motorNumber);
@@ -208,16 +214,37 @@ bool currentSensorESCReadTotal(currentMeter_t *meter)
     return state->enabled;
 }
 
-void currentSensorESCRefresh(void)
+void currentSensorESCRefresh(timeUs_t currentTimeUs)
 {
+    static timeUs_t lastServiced = 0;
+
     escSensorData_t *escData = getEscSensorData(ESC_SENSOR_COMBINED);
     currentSensorState_t * state = &currentESCSensor;
 
+    const timeDelta_t updateDelta = lastServiced ? cmpTimeUs(currentTimeUs, lastServiced) : 0;
+    lastServiced = currentTimeUs;
+
     if (escData && escData->age <= ESC_BATTERY_AGE_MAX) {
-        const uint32_t current = escData->current + escSensorConfig()->current_offset;
+        const uint32_t offset = escSensorConfig()->current_offset;
+        const uint32_t current = escData->current + offset;
+
+        // The ESC reports whole mAh, often at a low rate. Integrate the
+        // reported current in between, restarting from the ESC total
+        // whenever it changes, and never running more than 1mAh ahead.
+        if (escData->consumption != currentESCReported) {
+            currentESCReported = escData->consumption;
+            currentESCLocal = 0;
+        }
+        else {
+            currentESCLocal = MIN(currentESCLocal + (uint64_t)escData->current * updateDelta, 3600000000u - 1);
+        }
+
+        // The offset is not seen by the ESCs
+        currentESCOffset += (uint64_t)offset * updateDelta;
+
         state->sample = current;
         state->current = filterApply(&state->filter, current);
-        state->capacity = escData->consumption + (escSensorConfig()->current_offset * millis() / 3600000u);
+        state->capacity = currentESCReported + (currentESCLocal + currentESCOffset) / 3600000000u;
         state->enabled = true;
     }
     else {
@@ -230,6 +257,10 @@ void currentSensorESCInit(void)
 {
     memset(&currentESCSensor, 0, sizeof(currentESCSensor));
 
+    currentESCReported = 0;
+    currentESCLocal = 0;
+    currentESCOffset = 0;
+
     lowpassFilterInit(&currentESCSensor.filter, LPF_BESSEL,
         escSensorConfig()->filter_cutoff,
         batteryConfig()->ibatUpdateHz, 0);
@@ -62,7 +62,7 @@ void currentSensorADCRefresh(timeUs_t currentTimeUs);
 bool currentSensorADCRead(currentSensorADC_e sensor, currentMeter_t *meter);
 
 void currentSensorESCInit(void);
-void currentSensorESCRefresh(void);
+void currentSensorESCRefresh(timeUs_t currentTimeUs);
 bool currentSensorESCReadTotal(currentMeter_t *meter);
 bool currentSensorESCReadMotor(uint8_t motorNumber, currentMeter_t *meter);
 
@@ -18,6 +18,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -46,6 +47,7 @@
 #include "drivers/dshot_dpwm.h"
 #include "drivers/serial.h"
 #include "drivers/serial_uart.h"
+#include "drivers/time.h"
 
 #include "flight/mixer.h"
 
@@ -54,7 +56,7 @@
 #include "esc_sensor.h"
 
 
-PG_REGISTER_WITH_RESET_TEMPLATE(escSensorConfig_t, escSensorConfig, PG_ESC_SENSOR_CONFIG, 0);
+PG_REGISTER_WITH_RESET_TEMPLATE(escSensorConfig_t, escSensorConfig, PG_ESC_SENSOR_CONFIG, 1);
 
 PG_RESET_TEMPLATE(escSensorConfig_t, escSensorConfig,
         .protocol = ESC_SENSOR_PROTO_NONE,
@@ -64,6 +66,7 @@ PG_RESET_TEMPLATE(escSensorConfig_t, escSensorConfig,
         .hw4_current_offset = 0,
         .hw4_current_gain = 0,
         .hw4_voltage_gain = 0,
+        .bl_pipeline = 0,
 );
 
 
@@ -97,6 +100,7 @@ enum {
     DEBUG_FRAME_CRC_ERRORS,
     DEBUG_FRAME_TIMEOUTS,
     DEBUG_FRAME_BUFFER,
+    DEBUG_FRAME_OVERRUNS,
 };
 
 #define TELEMETRY_BUFFER_SIZE    40
@@ -119,8 +123,8 @@ static bool combinedNeedsUpdate = true;
 static timeUs_t dataUpdateUs = 0;
 static timeUs_t consumptionUpdateUs = 0;
 
-static float consumptionDelta = 0.0f;
-static float totalConsumption = 0.0f;
+static uint32_t consumptionCurrent = 0;     // mA
+static uint64_t totalConsumption = 0;       // mAus
 
 static uint32_t totalByteCount = 0;
 static uint32_t totalFrameCount = 0;
@@ -248,22 +252,137 @@ static void checkFrameTimeout(timeUs_t currentTimeUs, timeDelta_t timeout)
 
 static void setConsumptionCurrent(float current)
 {
-    // Pre-convert Aµs to mAh
-    consumptionDelta = current * (1000.0f / 3600e6f);
-
+    consumptionCurrent = (current > 0) ? current * 1000 : 0;
 }
 
 static void updateConsumption(timeUs_t currentTimeUs)
 {
-    // Increment consumption
-    totalConsumption += cmpTimeUs(currentTimeUs, consumptionUpdateUs) * consumptionDelta;
+    // Integrate in mAus - a float mAh total loses the small
+    // per-cycle increments once the total gets large
+    if (consumptionUpdateUs) {
+        totalConsumption += (uint64_t)consumptionCurrent * cmpTimeUs(currentTimeUs, consumptionUpdateUs);
+    }
 
     // Save update time
     consumptionUpdateUs = currentTimeUs;
 
-    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_CAPACITY, totalConsumption);
+    const uint32_t consumption = totalConsumption / 3600000000u;
+
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_CAPACITY, consumption);
 
-    escSensorData[0].consumption = totalConsumption;
+    escSensorData[0].consumption = consumption;
+}
+
+
+/*
+ * Frame capture
+ *
+ *     - Used by protocols with a fixed sync pattern and frame length
+ *     - Frames are assembled in the serial RX interrupt
+ *     - Complete frames are timestamped on their first byte and queued
+ *     - The sensor task checks and decodes each frame once
+ *
+ */
+
+#define FRAME_QUEUE_SIZE         4               // power of two
+#define FRAME_SYNC_MAX           8
+#define FRAME_IDLE_TIMEOUT       2000            // 2ms line idle restarts the frame
+
+typedef bool (*frameCheckCallbackPtr)(const uint8_t *frame);
+typedef void (*frameDecodeCallbackPtr)(const uint8_t *frame);
+
+typedef struct {
+    uint8_t syncLength;                     // sync pattern length
+    uint8_t sync[FRAME_SYNC_MAX];           // sync pattern at the start of frame
+    uint8_t frameLength;                    // frame length incl. sync and CRC
+    uint8_t syncFrames;                     // frames to drop after power-up
+    frameCheckCallbackPtr check;            // CRC / validity check, NULL if none
+    frameDecodeCallbackPtr decode;          // frame decoder
+} frameDescriptor_t;
+
+typedef struct {
+    timeUs_t timestamp;
+    uint8_t data[TELEMETRY_BUFFER_SIZE];
+} escFrame_t;
+
+static const frameDescriptor_t *frameDesc = NULL;
+
+static escFrame_t frameQueue[FRAME_QUEUE_SIZE];
+
+static volatile uint8_t frameQueueHead = 0;
+static volatile uint8_t frameQueueTail = 0;
+
+static timeUs_t frameStartUs = 0;
+static timeUs_t frameByteUs = 0;
+
+static uint32_t totalOverrunCount = 0;
+
+static FAST_CODE void frameDataReceive(uint16_t c, void *data)
+{
+    UNUSED(data);
+
+    const frameDescriptor_t *desc = frameDesc;
+    const timeUs_t currentTimeUs = microsISR();
+
+    totalByteCount++;
+
+    // Line has been idle => any partial frame is lost
+    if (readBytes > 0 && cmpTimeUs(currentTimeUs, frameByteUs) > FRAME_IDLE_TIMEOUT) {
+        frameSyncError();
+    }
+
+    frameByteUs = currentTimeUs;
+
+    if (readBytes == 0) {
+        frameStartUs = currentTimeUs;
+    }
+
+    buffer[readBytes++] = c;
+
+    if (readBytes <= desc->syncLength) {
+        if (c != desc->sync[readBytes - 1])
+            frameSyncError();
+        else if (readBytes == desc->syncLength)
+            syncCount++;
+    }
+    else if (readBytes == desc->frameLength) {
+        readBytes = 0;
+        if (syncCount > desc->syncFrames) {
+            const uint8_t head = frameQueueHead;
+            if ((uint8_t)(head - frameQueueTail) < FRAME_QUEUE_SIZE) {
+                escFrame_t *frame = &frameQueue[head % FRAME_QUEUE_SIZE];
+                memcpy(frame->data, buffer, desc->frameLength);
+                frame->timestamp = frameStartUs;
+                frameQueueHead = head + 1;
+            }
+            else {
+                totalOverrunCount++;
+            }
+        }
+    }
+}
+
+static void frameSensorProcess(void)
+{
+    const frameDescriptor_t *desc = frameDesc;
+
+    while (frameQueueTail != frameQueueHead) {
+        const escFrame_t *frame = &frameQueue[frameQueueTail % FRAME_QUEUE_SIZE];
+
+        if (desc->check == NULL || desc->check(frame->data)) {
+            desc->decode(frame->data);
+
+            escSensorData[0].timestamp = frame->timestamp;
+            dataUpdateUs = frame->timestamp;
+
+            totalFrameCount++;
+        }
+        else {
+            totalCrcErrorCount++;
+        }
+
+        frameQueueTail++;
+    }
 }
 
 
@@ -286,7 +405,10 @@ static void updateConsumption(timeUs_t currentTimeUs)
 
 #define BLHELI32_BOOT_DELAY       5000            // 5 seconds
 #define BLHELI32_REQ_TIMEOUT      100             // 100 ms (data transfer takes only 900us)
+#define BLHELI32_PIPE_TIMEOUT     10              // 10 ms in pipelined mode
 #define BLHELI32_FRAME_SIZE       10
+#define BLHELI32_MISS_LIMIT       4               // consecutive misses before an ESC is skipped
+#define BLHELI32_PROBE_INTERVAL   64              // skipped ESCs are probed every N requests
 
 enum {
     BLHELI32_FRAME_FAILED    = 0,
@@ -299,20 +421,35 @@ enum {
     DSHOT_TRIGGER_ACTIVE = 1,
 };
 
-static uint32_t dshotTriggerTimestamp = 0;
+static volatile uint32_t dshotTriggerTimestamp = 0;
 static uint8_t dshotTriggerState = DSHOT_TRIGGER_WAIT;
 
-static uint8_t currentEsc = 0;
+static volatile uint8_t currentEsc = 0;
 
+// Pipelined mode: completed frames are handed over from the RX callback
+static bool blPipeline = false;
+static uint8_t blFrame[MAX_SUPPORTED_MOTORS][BLHELI32_FRAME_SIZE];
+static volatile bool blFrameReady[MAX_SUPPORTED_MOTORS];
+static uint8_t blMissCount[MAX_SUPPORTED_MOTORS];
+static uint8_t blProbeCount = 0;
 
-static FAST_CODE void blDataReceive(uint16_t c, void *data)
+
+static void blSelectNextEsc(void)
 {
-    UNUSED(data);
+    const uint8_t motorCount = getMotorCount();
 
-    totalByteCount++;
+    if (blPipeline) {
+        // Skip non-responding ESCs, but probe them once in a while
+        const bool probe = (++blProbeCount % BLHELI32_PROBE_INTERVAL) == 0;
 
-    if (bufferPos < bufferSize) {
-        buffer[bufferPos++] = c;
+        for (int i = 0; i < motorCount; i++) {
+            currentEsc = (currentEsc + 1) % motorCount;
+            if (probe || blMissCount[currentEsc] < BLHELI32_MISS_LIMIT)
+                return;
+        }
+    }
+    else {
+        currentEsc = (currentEsc + 1) % motorCount;
     }
 }
 
@@ -326,53 +463,63 @@ static void sendDShotTelemetryReqeust(timeMs_t currentTimeMs)
     getMotorDmaOutput(currentEsc)->protocolControl.requestTelemetry = true;
 }
 
-static void blSelectNextEsc(void)
+static FAST_CODE void blDataReceive(uint16_t c, void *data)
 {
-    currentEsc = (currentEsc + 1) % getMotorCount();
+    UNUSED(data);
+
+    totalByteCount++;
+
+    if (bufferPos < bufferSize) {
+        buffer[bufferPos++] = c;
+
+        // Hand the frame over and request the next one right away
+        if (blPipeline && bufferPos == bufferSize) {
+            memcpy(blFrame[currentEsc], buffer, BLHELI32_FRAME_SIZE);
+            blFrameReady[currentEsc] = true;
+            blSelectNextEsc();
+            sendDShotTelemetryReqeust(microsISR() / 1000);
+        }
+    }
 }
 
-static uint8_t blDecodeTelemetryFrame(void)
+static bool blDecodeFrame(uint8_t esc, const uint8_t *frame)
 {
-    // First, check the variables that can change in the interrupt
-    if (bufferPos < bufferSize)
-        return BLHELI32_FRAME_PENDING;
-
     // Verify CRC8 checksum
-    uint16_t chksum = crc8_kiss_update(0, buffer, BLHELI32_FRAME_SIZE - 1);
-    uint16_t tlmsum = buffer[BLHELI32_FRAME_SIZE - 1];
+    uint16_t chksum = crc8_kiss_update(0, frame, BLHELI32_FRAME_SIZE - 1);
+    uint16_t tlmsum = frame[BLHELI32_FRAME_SIZE - 1];
 
     if (chksum == tlmsum) {
-        uint16_t temp = buffer[0];
-        uint16_t volt = buffer[1] << 8 | buffer[2];
-        uint16_t curr = buffer[3] << 8 | buffer[4];
-        uint16_t capa = buffer[5] << 8 | buffer[6];
-        uint16_t erpm = buffer[7] << 8 | buffer[8];
-
-        escSensorData[currentEsc].age = 0;
-        escSensorData[currentEsc].erpm = erpm * 100;
-        escSensorData[currentEsc].voltage = volt * 10;
-        escSensorData[currentEsc].current = curr * 10;
-        escSensorData[currentEsc].consumption = capa;
-        escSensorData[currentEsc].temperature = temp * 10;
+        uint16_t temp = frame[0];
+        uint16_t volt = frame[1] << 8 | frame[2];
+        uint16_t curr = frame[3] << 8 | frame[4];
+        uint16_t capa = frame[5] << 8 | frame[6];
+        uint16_t erpm = frame[7] << 8 | frame[8];
+
+        escSensorData[esc].age = 0;
+        escSensorData[esc].erpm = erpm * 100;
+        escSensorData[esc].voltage = volt * 10;
+        escSensorData[esc].current = curr * 10;
+        escSensorData[esc].consumption = capa;
+        escSensorData[esc].temperature = temp * 10;
 
         combinedNeedsUpdate = true;
 
         totalFrameCount++;
 
-        if (currentEsc == 0) {
+        if (esc == 0) {
             DEBUG(ESC_SENSOR, DEBUG_ESC_1_RPM, erpm * 100);
             DEBUG(ESC_SENSOR, DEBUG_ESC_1_TEMP, temp * 10);
             DEBUG(ESC_SENSOR, DEBUG_ESC_1_VOLTAGE, volt);
             DEBUG(ESC_SENSOR, DEBUG_ESC_1_CURRENT, curr);
         }
-        else if (currentEsc == 1) {
+        else if (esc == 1) {
             DEBUG(ESC_SENSOR, DEBUG_ESC_2_RPM, erpm * 100);
             DEBUG(ESC_SENSOR, DEBUG_ESC_2_TEMP, temp * 10);
             DEBUG(ESC_SENSOR, DEBUG_ESC_2_VOLTAGE, volt);
             DEBUG(ESC_SENSOR, DEBUG_ESC_2_CURRENT, curr);
         }
 
-        if (currentEsc == debugAxis) {
+        if (esc == debugAxis) {
             DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_RPM, erpm);
             DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_TEMP, temp);
             DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_VOLTAGE, volt);
@@ -381,12 +528,58 @@ static uint8_t blDecodeTelemetryFrame(void)
             DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_AGE, 0);
         }
 
-        return BLHELI32_FRAME_COMPLETE;
+        return true;
     }
 
     totalCrcErrorCount++;
 
-    return BLHELI32_FRAME_FAILED;
+    return false;
+}
+
+static uint8_t blDecodeTelemetryFrame(void)
+{
+    // First, check the variables that can change in the interrupt
+    if (bufferPos < bufferSize)
+        return BLHELI32_FRAME_PENDING;
+
+    return blDecodeFrame(currentEsc, buffer) ? BLHELI32_FRAME_COMPLETE : BLHELI32_FRAME_FAILED;
+}
+
+static void blPipelineProcess(timeMs_t currentTimeMs)
+{
+    const uint8_t motorCount = getMotorCount();
+
+    // Decode all frames received since the last call
+    for (int esc = 0; esc < motorCount; esc++) {
+        if (blFrameReady[esc]) {
+            if (blDecodeFrame(esc, blFrame[esc])) {
+                blMissCount[esc] = 0;
+            }
+            else {
+                increaseDataAge(esc);
+            }
+            blFrameReady[esc] = false;
+        }
+    }
+
+    // Current ESC did not answer
+    if (currentTimeMs >= dshotTriggerTimestamp + BLHELI32_PIPE_TIMEOUT) {
+        // Stop the RX callback from touching the request state
+        bufferSize = 0;
+
+        // Frame may have completed just before the callback was stopped
+        if (currentTimeMs >= dshotTriggerTimestamp + BLHELI32_PIPE_TIMEOUT) {
+            const uint8_t esc = currentEsc;
+            if (blMissCount[esc] < BLHELI32_MISS_LIMIT)
+                blMissCount[esc]++;
+            increaseDataAge(esc);
+            totalTimeoutCount++;
+
+            blSelectNextEsc();
+        }
+
+        sendDShotTelemetryReqeust(currentTimeMs);
+    }
 }
 
 static void blSensorProcess(timeUs_t currentTimeUs)
@@ -402,7 +595,10 @@ static void blSensorProcess(timeUs_t currentTimeUs)
             break;
 
         case DSHOT_TRIGGER_ACTIVE:
-            if (currentTimeMs < dshotTriggerTimestamp + BLHELI32_REQ_TIMEOUT) {
+            if (blPipeline) {
+                blPipelineProcess(currentTimeMs);
+            }
+            else if (currentTimeMs < dshotTriggerTimestamp + BLHELI32_REQ_TIMEOUT) {
                 uint8_t state = blDecodeTelemetryFrame();
                 switch (state) {
                     case BLHELI32_FRAME_PENDING:
@@ -745,110 +941,62 @@ static uint16_t calculateCRC16_MODBUS(const uint8_t *ptr, size_t len)
     return crc;
 }
 
-static bool processHW5TelemetryStream(uint8_t dataByte)
+static bool hw5CheckFrame(const uint8_t *frame)
 {
-    totalByteCount++;
-
-    buffer[readBytes++] = dataByte;
-
-    if (readBytes == 1) {
-        if (dataByte != 0xFE)
-            frameSyncError();
-    }
-    else if (readBytes == 2) {
-        if (dataByte != 0x01)
-            frameSyncError();
-    }
-    else if (readBytes == 3) {
-        if (dataByte != 0x00)
-            frameSyncError();
-    }
-    else if (readBytes == 4) {
-        if (dataByte != 0x03)
-            frameSyncError();
-    }
-    else if (readBytes == 5) {
-        if (dataByte != 0x30)
-            frameSyncError();
-    }
-    else if (readBytes == 6) {
-        if (dataByte != 0x5C)
-            frameSyncError();
-    }
-    else if (readBytes == 7) {
-        if (dataByte != 0x17)
-            frameSyncError();
-        else
-            syncCount++;
-    }
-    else if (readBytes == 32) {
-        readBytes = 0;
-        return true;
-    }
+    const uint16_t crc = frame[31] << 8 | frame[30];
 
-    return false;
+    return calculateCRC16_MODBUS(frame, 30) == crc;
 }
 
-static void hw5SensorProcess(timeUs_t currentTimeUs)
+static void hw5DecodeFrame(const uint8_t *frame)
 {
-    // check for any available bytes in the rx buffer
-    while (serialRxBytesWaiting(escSensorPort)) {
-        if (processHW5TelemetryStream(serialRead(escSensorPort))) {
-            uint16_t crc = buffer[31] << 8 | buffer[30];
-
-            if (calculateCRC16_MODBUS(buffer, 30) == crc) {
-                uint32_t rpm = buffer[14] << 8 | buffer[13];
-                uint16_t power = buffer[9];
-                uint16_t fault = buffer[12];
-                uint16_t voltage = buffer[16] << 8 | buffer[15];
-                uint16_t current = buffer[18] << 8 | buffer[17];
-                uint16_t tempFET = buffer[19];
-                uint16_t tempBEC = buffer[20];
-                uint16_t voltBEC = buffer[22];
-                uint16_t currBEC = buffer[23];
-
-                // When throttle changes to zero, the last current reading is
-                // repeated until the motor has totally stopped.
-                if (power == 0) {
-                    current = 0;
-                }
+    uint32_t rpm = frame[14] << 8 | frame[13];
+    uint16_t power = frame[9];
+    uint16_t fault = frame[12];
+    uint16_t voltage = frame[16] << 8 | frame[15];
+    uint16_t current = frame[18] << 8 | frame[17];
+    uint16_t tempFET = frame[19];
+    uint16_t tempBEC = frame[20];
+    uint16_t voltBEC = frame[22];
+    uint16_t currBEC = frame[23];
 
-                setConsumptionCurrent(current * 0.1f);
+    // When throttle changes to zero, the last current reading is
+    // repeated until the motor has totally stopped.
+    if (power == 0) {
+        current = 0;
+    }
 
-                escSensorData[0].age = 0;
-                escSensorData[0].erpm = rpm * 10;
-                escSensorData[0].throttle = power * 10;
-                escSensorData[0].pwm = power * 10;
-                escSensorData[0].voltage = voltage * 100;
-                escSensorData[0].current = current * 100;
-                escSensorData[0].temperature = tempFET * 10;
-                escSensorData[0].temperature2 = tempBEC * 10;
-                escSensorData[0].bec_voltage = voltBEC * 100;
-                escSensorData[0].bec_current = currBEC * 100;
-                escSensorData[0].status = fault;
+    setConsumptionCurrent(current * 0.1f);
 
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_RPM, rpm * 10);
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_TEMP, tempFET * 10);
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_VOLTAGE, voltage * 10);
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_CURRENT, current * 10);
+    escSensorData[0].age = 0;
+    escSensorData[0].erpm = rpm * 10;
+    escSensorData[0].throttle = power * 10;
+    escSensorData[0].pwm = power * 10;
+    escSensorData[0].voltage = voltage * 100;
+    escSensorData[0].current = current * 100;
+    escSensorData[0].temperature = tempFET * 10;
+    escSensorData[0].temperature2 = tempBEC * 10;
+    escSensorData[0].bec_voltage = voltBEC * 100;
+    escSensorData[0].bec_current = currBEC * 100;
+    escSensorData[0].status = fault;
 
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_RPM, rpm);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_PWM, power);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_TEMP, tempFET);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_VOLTAGE, voltage);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_CURRENT, current);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_EXTRA, tempBEC);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_AGE, 0);
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_RPM, rpm * 10);
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_TEMP, tempFET * 10);
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_VOLTAGE, voltage * 10);
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_CURRENT, current * 10);
 
-                dataUpdateUs = currentTimeUs;
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_RPM, rpm);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_PWM, power);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_TEMP, tempFET);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_VOLTAGE, voltage);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_CURRENT, current);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_EXTRA, tempBEC);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_AGE, 0);
+}
 
-                totalFrameCount++;
-            }
-            else {
-                totalCrcErrorCount++;
-            }
-        }
-    }
+static void hw5SensorProcess(timeUs_t currentTimeUs)
+{
+    frameSensorProcess();
 
     // Update consumption on every cycle
     updateConsumption(currentTimeUs);
@@ -1097,76 +1245,51 @@ static void kontronikSensorProcess(timeUs_t currentTimeUs)
  *
  */
 
-static bool processOMPTelemetryStream(uint8_t dataByte)
+static bool ompCheckFrame(const uint8_t *frame)
 {
-    totalByteCount++;
-
-    buffer[readBytes++] = dataByte;
-
-    if (readBytes == 1) {
-        if (dataByte != 0xDD)
-            frameSyncError();
-        else
-            syncCount++;
-    }
-    else if (readBytes == 32) {
-        readBytes = 0;
-        if (syncCount > 2)
-            return true;
-    }
-
-    return false;
+    // Make sure this is OMP M4 ESC
+    return frame[1] == 0x01 && frame[2] == 0x20 && frame[11] == 0 && frame[18] == 0 && frame[20] == 0;
 }
 
-static void ompSensorProcess(timeUs_t currentTimeUs)
+static void ompDecodeFrame(const uint8_t *frame)
 {
-    // check for any available bytes in the rx buffer
-    while (serialRxBytesWaiting(escSensorPort)) {
-        if (processOMPTelemetryStream(serialRead(escSensorPort))) {
-            // Make sure this is OMP M4 ESC
-            if (buffer[1] == 0x01 && buffer[2] == 0x20 && buffer[11] == 0 && buffer[18] == 0 && buffer[20] == 0) {
-                uint16_t rpm = buffer[8] << 8 | buffer[9];
-                uint16_t throttle = buffer[7];
-                uint16_t pwm = buffer[12];
-                uint16_t temp = buffer[10];
-                uint16_t voltage = buffer[3] << 8 | buffer[4];
-                uint16_t current = buffer[5] << 8 | buffer[6];
-                uint16_t capacity = buffer[15] << 8 | buffer[16];
-                uint16_t status = buffer[13] << 8 | buffer[14];
+    uint16_t rpm = frame[8] << 8 | frame[9];
+    uint16_t throttle = frame[7];
+    uint16_t pwm = frame[12];
+    uint16_t temp = frame[10];
+    uint16_t voltage = frame[3] << 8 | frame[4];
+    uint16_t current = frame[5] << 8 | frame[6];
+    uint16_t capacity = frame[15] << 8 | frame[16];
+    uint16_t status = frame[13] << 8 | frame[14];
 
-                escSensorData[0].age = 0;
-                escSensorData[0].erpm = rpm * 10;
-                escSensorData[0].throttle = throttle * 10;
-                escSensorData[0].pwm = pwm * 10;
-                escSensorData[0].voltage = voltage * 100;
-                escSensorData[0].current = current * 100;
-                escSensorData[0].consumption = capacity;
-                escSensorData[0].temperature = temp * 10;
-                escSensorData[0].status = status;
-
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_RPM, rpm * 10);
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_TEMP, temp * 10);
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_VOLTAGE, voltage * 10);
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_CURRENT, current * 10);
+    escSensorData[0].age = 0;
+    escSensorData[0].erpm = rpm * 10;
+    escSensorData[0].throttle = throttle * 10;
+    escSensorData[0].pwm = pwm * 10;
+    escSensorData[0].voltage = voltage * 100;
+    escSensorData[0].current = current * 100;
+    escSensorData[0].consumption = capacity;
+    escSensorData[0].temperature = temp * 10;
+    escSensorData[0].status = status;
 
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_RPM, rpm);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_PWM, pwm);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_TEMP, temp);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_VOLTAGE, voltage);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_CURRENT, current);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_CAPACITY, capacity);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_EXTRA, status);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_AGE, 0);
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_RPM, rpm * 10);
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_TEMP, temp * 10);
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_VOLTAGE, voltage * 10);
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_CURRENT, current * 10);
 
-                dataUpdateUs = currentTimeUs;
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_RPM, rpm);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_PWM, pwm);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_TEMP, temp);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_VOLTAGE, voltage);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_CURRENT, current);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_CAPACITY, capacity);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_EXTRA, status);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_AGE, 0);
+}
 
-                totalFrameCount++;
-            }
-            else {
-                totalCrcErrorCount++;
-            }
-        }
-    }
+static void ompSensorProcess(timeUs_t currentTimeUs)
+{
+    frameSensorProcess();
 
     // Maximum frame spacing 50ms, sync after 3 frames
     checkFrameTimeout(currentTimeUs, 500000);
@@ -1218,77 +1341,52 @@ static void ompSensorProcess(timeUs_t currentTimeUs)
  *
  */
 
-static bool processZTWTelemetryStream(uint8_t dataByte)
+static bool ztwCheckFrame(const uint8_t *frame)
 {
-    totalByteCount++;
-
-    buffer[readBytes++] = dataByte;
-
-    if (readBytes == 1) {
-        if (dataByte != 0xDD)
-            frameSyncError();
-        else
-            syncCount++;
-    }
-    else if (readBytes == 32) {
-        readBytes = 0;
-        if (syncCount > 2)
-            return true;
-    }
-
-    return false;
+    return frame[1] == 0x01 && frame[2] == 0x20;
 }
 
-static void ztwSensorProcess(timeUs_t currentTimeUs)
+static void ztwDecodeFrame(const uint8_t *frame)
 {
-    // check for any available bytes in the rx buffer
-    while (serialRxBytesWaiting(escSensorPort)) {
-        if (processZTWTelemetryStream(serialRead(escSensorPort))) {
-            if (buffer[1] == 0x01 && buffer[2] == 0x20) {
-                uint16_t rpm = buffer[8] << 8 | buffer[9];
-                uint16_t temp = buffer[10];
-                uint16_t throttle = buffer[7];
-                uint16_t power = buffer[12];
-                uint16_t voltage = buffer[3] << 8 | buffer[4];
-                uint16_t current = buffer[5] << 8 | buffer[6];
-                uint16_t capacity = buffer[15] << 8 | buffer[16];
-                uint16_t status = buffer[13] << 8 | buffer[14];
-                uint16_t voltBEC = buffer[19];
+    uint16_t rpm = frame[8] << 8 | frame[9];
+    uint16_t temp = frame[10];
+    uint16_t throttle = frame[7];
+    uint16_t power = frame[12];
+    uint16_t voltage = frame[3] << 8 | frame[4];
+    uint16_t current = frame[5] << 8 | frame[6];
+    uint16_t capacity = frame[15] << 8 | frame[16];
+    uint16_t status = frame[13] << 8 | frame[14];
+    uint16_t voltBEC = frame[19];
 
-                escSensorData[0].age = 0;
-                escSensorData[0].erpm = rpm * 10;
-                escSensorData[0].throttle = throttle * 10;
-                escSensorData[0].pwm = power * 10;
-                escSensorData[0].voltage = voltage * 100;
-                escSensorData[0].current = current * 100;
-                escSensorData[0].consumption = capacity;
-                escSensorData[0].temperature = temp * 10;
-                escSensorData[0].bec_voltage = voltBEC * 1000;
-                escSensorData[0].status = status;
-
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_RPM, rpm * 10);
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_TEMP, temp * 10);
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_VOLTAGE, voltage * 10);
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_CURRENT, current * 10);
+    escSensorData[0].age = 0;
+    escSensorData[0].erpm = rpm * 10;
+    escSensorData[0].throttle = throttle * 10;
+    escSensorData[0].pwm = power * 10;
+    escSensorData[0].voltage = voltage * 100;
+    escSensorData[0].current = current * 100;
+    escSensorData[0].consumption = capacity;
+    escSensorData[0].temperature = temp * 10;
+    escSensorData[0].bec_voltage = voltBEC * 1000;
+    escSensorData[0].status = status;
 
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_RPM, rpm);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_PWM, power);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_TEMP, temp);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_VOLTAGE, voltage);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_CURRENT, current);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_CAPACITY, capacity);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_EXTRA, status);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_AGE, 0);
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_RPM, rpm * 10);
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_TEMP, temp * 10);
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_VOLTAGE, voltage * 10);
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_CURRENT, current * 10);
 
-                dataUpdateUs = currentTimeUs;
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_RPM, rpm);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_PWM, power);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_TEMP, temp);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_VOLTAGE, voltage);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_CURRENT, current);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_CAPACITY, capacity);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_EXTRA, status);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_AGE, 0);
+}
 
-                totalFrameCount++;
-            }
-            else {
-                totalCrcErrorCount++;
-            }
-        }
-    }
+static void ztwSensorProcess(timeUs_t currentTimeUs)
+{
+    frameSensorProcess();
 
     // Maximum frame spacing 50ms, sync after 3 frames
     checkFrameTimeout(currentTimeUs, 500000);
@@ -1355,82 +1453,53 @@ static uint16_t calculateFletcher16(const uint8_t *ptr, size_t len)
     return s1 << 8 | s0;
 }
 
-static bool processAPDTelemetryStream(uint8_t dataByte)
+static bool apdCheckFrame(const uint8_t *frame)
 {
-    totalByteCount++;
-
-    buffer[readBytes++] = dataByte;
+    const uint16_t crc = frame[21] << 8 | frame[20];
 
-    if (readBytes == 1) {
-        if (dataByte != 0xFF)
-            frameSyncError();
-    }
-    else if (readBytes == 2) {
-        if (dataByte != 0xFF)
-            frameSyncError();
-        else
-            syncCount++;
-    }
-    else if (readBytes == 22) {
-        readBytes = 0;
-        if (syncCount > 2)
-            return true;
-    }
-
-    return false;
+    return calculateFletcher16(frame + 2, 18) == crc;
 }
 
-static void apdSensorProcess(timeUs_t currentTimeUs)
+static void apdDecodeFrame(const uint8_t *frame)
 {
-    // check for any available bytes in the rx buffer
-    while (serialRxBytesWaiting(escSensorPort)) {
-        if (processAPDTelemetryStream(serialRead(escSensorPort))) {
-            uint16_t crc = buffer[21] << 8 | buffer[20];
-
-            if (calculateFletcher16(buffer + 2, 18) == crc) {
-                uint16_t rpm = buffer[13] << 24 | buffer[12] << 16 | buffer[11] << 8 | buffer[10];
-                uint16_t tadc = buffer[3] << 8 | buffer[2];
-                uint16_t throttle = buffer[15] << 8 | buffer[14];
-                uint16_t power = buffer[17] << 8 | buffer[16];
-                uint16_t voltage = buffer[1] << 8 | buffer[0];
-                uint16_t current = buffer[5] << 8 | buffer[4];
-                uint16_t status = buffer[18];
+    uint16_t rpm = frame[13] << 24 | frame[12] << 16 | frame[11] << 8 | frame[10];
+    uint16_t tadc = frame[3] << 8 | frame[2];
+    uint16_t throttle = frame[15] << 8 | frame[14];
+    uint16_t power = frame[17] << 8 | frame[16];
+    uint16_t voltage = frame[1] << 8 | frame[0];
+    uint16_t current = frame[5] << 8 | frame[4];
+    uint16_t status = frame[18];
 
-                float temp = calcTempAPD(tadc);
-
-                setConsumptionCurrent(current * 0.08f);
-
-                escSensorData[0].age = 0;
-                escSensorData[0].erpm = rpm;
-                escSensorData[0].throttle = throttle;
-                escSensorData[0].pwm = power;
-                escSensorData[0].voltage = voltage * 10;
-                escSensorData[0].current = current * 80;
-                escSensorData[0].temperature = lrintf(temp * 10);
-                escSensorData[0].status = status;
+    float temp = calcTempAPD(tadc);
 
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_RPM, rpm);
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_TEMP, lrintf(temp * 10));
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_VOLTAGE, voltage);
-                DEBUG(ESC_SENSOR, DEBUG_ESC_1_CURRENT, current * 8);
+    setConsumptionCurrent(current * 0.08f);
 
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_RPM, rpm);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_PWM, power);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_TEMP, tadc);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_VOLTAGE, voltage);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_CURRENT, current);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_EXTRA, status);
-                DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_AGE, 0);
+    escSensorData[0].age = 0;
+    escSensorData[0].erpm = rpm;
+    escSensorData[0].throttle = throttle;
+    escSensorData[0].pwm = power;
+    escSensorData[0].voltage = voltage * 10;
+    escSensorData[0].current = current * 80;
+    escSensorData[0].temperature = lrintf(temp * 10);
+    escSensorData[0].status = status;
+
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_RPM, rpm);
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_TEMP, lrintf(temp * 10));
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_VOLTAGE, voltage);
+    DEBUG(ESC_SENSOR, DEBUG_ESC_1_CURRENT, current * 8);
 
-                dataUpdateUs = currentTimeUs;
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_RPM, rpm);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_PWM, power);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_TEMP, tadc);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_VOLTAGE, voltage);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_CURRENT, current);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_EXTRA, status);
+    DEBUG(ESC_SENSOR_DATA, DEBUG_DATA_AGE, 0);
+}
 
-                totalFrameCount++;
-            }
-            else {
-                totalCrcErrorCount++;
-            }
-        }
-    }
+static void apdSensorProcess(timeUs_t currentTimeUs)
+{
+    frameSensorProcess();
 
     // Update consumption on every cycle
     updateConsumption(currentTimeUs);
@@ -2515,6 +2584,48 @@ static void recordSensorProcess(timeUs_t currentTimeUs)
 }
 
 
+/*
+ * Frame descriptors
+ *
+ */
+
+static const frameDescriptor_t hw5FrameDesc = {
+    .syncLength = 7,
+    .sync = { 0xFE, 0x01, 0x00, 0x03, 0x30, 0x5C, 0x17 },
+    .frameLength = 32,
+    .syncFrames = 0,
+    .check = hw5CheckFrame,
+    .decode = hw5DecodeFrame,
+};
+
+static const frameDescriptor_t ompFrameDesc = {
+    .syncLength = 1,
+    .sync = { 0xDD },
+    .frameLength = 32,
+    .syncFrames = 2,
+    .check = ompCheckFrame,
+    .decode = ompDecodeFrame,
+};
+
+static const frameDescriptor_t ztwFrameDesc = {
+    .syncLength = 1,
+    .sync = { 0xDD },
+    .frameLength = 32,
+    .syncFrames = 2,
+    .check = ztwCheckFrame,
+    .decode = ztwDecodeFrame,
+};
+
+static const frameDescriptor_t apdFrameDesc = {
+    .syncLength = 2,
+    .sync = { 0xFF, 0xFF },
+    .frameLength = 22,
+    .syncFrames = 2,
+    .check = apdCheckFrame,
+    .decode = apdDecodeFrame,
+};
+
+
 void escSensorProcess(timeUs_t currentTimeUs)
 {
     if (escSensorPort && motorIsEnabled()) {
@@ -2558,6 +2669,7 @@ void escSensorProcess(timeUs_t currentTimeUs)
         DEBUG(ESC_SENSOR_FRAME, DEBUG_FRAME_CRC_ERRORS, totalCrcErrorCount);
         DEBUG(ESC_SENSOR_FRAME, DEBUG_FRAME_TIMEOUTS, totalTimeoutCount);
         DEBUG(ESC_SENSOR_FRAME, DEBUG_FRAME_BUFFER, readBytes);
+        DEBUG(ESC_SENSOR_FRAME, DEBUG_FRAME_OVERRUNS, totalOverrunCount);
     }
 }
 
@@ -2577,6 +2689,7 @@ bool INIT_CODE escSensorInit(void)
 
     switch (escSensorConfig()->protocol) {
         case ESC_SENSOR_PROTO_BLHELI32:
+            blPipeline = escSensorConfig()->bl_pipeline;
             callback = blDataReceive;
             baudrate = 115200;
             break;
@@ -2592,9 +2705,23 @@ bool INIT_CODE escSensorInit(void)
             options |= SERIAL_PARITY_EVEN;
             break;
         case ESC_SENSOR_PROTO_OMPHOBBY:
+            frameDesc = &ompFrameDesc;
+            callback = frameDataReceive;
+            baudrate = 115200;
+            break;
         case ESC_SENSOR_PROTO_ZTW:
+            frameDesc = &ztwFrameDesc;
+            callback = frameDataReceive;
+            baudrate = 115200;
+            break;
         case ESC_SENSOR_PROTO_HW5:
+            frameDesc = &hw5FrameDesc;
+            callback = frameDataReceive;
+            baudrate = 115200;
+            break;
         case ESC_SENSOR_PROTO_APD:
+            frameDesc = &apdFrameDesc;
+            callback = frameDataReceive;
             baudrate = 115200;
             break;
         case ESC_SENSOR_PROTO_OPENYGE:
@@ -51,6 +51,7 @@ typedef struct escSensorConfig_s {
     uint8_t hw4_current_gain;       // HobbyWing V4 current gain
     uint8_t hw4_voltage_gain;       // HobbyWing V4 voltage gain
     uint8_t filter_cutoff;          // Frequency cutoff in Hz
+    uint8_t bl_pipeline;            // BLHeli32: request next ESC as soon as a frame is complete
 } escSensorConfig_t;
 
 PG_DECLARE(escSensorConfig_t, escSensorConfig);
@@ -68,6 +69,7 @@ typedef struct {
     uint32_t  bec_voltage;      // mV
     uint32_t  bec_current;      // mA
     uint32_t  status;           // status / fault codes
+    timeUs_t  timestamp;        // Frame capture time (framed protocols)
 } escSensorData_t;
 
 #define ESC_DATA_INVALID 255
@@ -27,6 +27,7 @@
 #include "platform.h"
 
 #include "build/debug.h"
+#include "build/profiler.h"
 
 #include "common/axis.h"
 #include "common/maths.h"
@@ -37,11 +38,14 @@
 #include "pg/pg.h"
 #include "pg/pg_ids.h"
 #include "pg/gyrodev.h"
+#include "pg/gyro_bias.h"
 
 #include "drivers/bus_spi.h"
 #include "drivers/io.h"
 
 #include "config/config.h"
+#include "fc/dispatch.h"
+#include "fc/eventlog.h"
 #include "fc/runtime_config.h"
 
 #ifdef USE_DYN_NOTCH_FILTER
@@ -76,6 +80,7 @@ FAST_DATA uint8_t activePidLoopDenom = 1;
 FAST_DATA uint8_t activeFilterLoopDenom = 1;
 
 static bool firstArmingCalibrationWasStarted = false;
+static bool firstCalibrationWasStarted = false;
 
 #ifdef UNIT_TEST
 STATIC_UNIT_TESTED gyroSensor_t * const gyroSensorPtr = &gyro.gyroSensor1;
@@ -88,7 +93,17 @@ STATIC_UNIT_TESTED gyroDev_t * const gyroDevPtr = &gyro.gyroSensor1.gyroDev;
 #define GYRO_OVERFLOW_TRIGGER_THRESHOLD 31980  // 97.5% full scale (1950dps for 2000dps gyro)
 #define GYRO_OVERFLOW_RESET_THRESHOLD 30340    // 92.5% full scale (1850dps for 2000dps gyro)
 
-PG_REGISTER_WITH_RESET_FN(gyroConfig_t, gyroConfig, PG_GYRO_CONFIG, 9);
+#define GYRO_BIAS_RESTORE_TIME      25      // Stationary time before the saved bias is used [1/100 s]
+#define GYRO_BIAS_RESTORE_LIMIT     4.0f    // Max difference between the measured and saved bias [LSB]
+#define GYRO_BIAS_TRACK_LIMIT       2.0f    // Max bias change per tracking window [LSB]
+#define GYRO_BIAS_SAVE_LIMIT        0.5f    // Bias change needed to save it again [LSB]
+#define GYRO_BIAS_WRITE_DELAY_US    500000  // Let the disarming process complete first
+
+#define GYRO_TEMP_SPAN_MIN          1700    // Temperature range needed to fit the slope [raw LSB], ~5°C for MPU6xxx
+#define GYRO_TEMP_SLOPE_LIMIT       0.01f   // Max bias change per raw temperature LSB (~0.2°/s/°C)
+#define GYRO_TEMP_SAVE_LIMIT        0.0002f // Slope change needed to save it again
+
+PG_REGISTER_WITH_RESET_FN(gyroConfig_t, gyroConfig, PG_GYRO_CONFIG, 15);
 
 #ifndef GYRO_CONFIG_USE_GYRO_DEFAULT
 #define GYRO_CONFIG_USE_GYRO_DEFAULT GYRO_CONFIG_USE_GYRO_1
@@ -115,6 +130,12 @@ void pgResetFn_gyroConfig(gyroConfig_t *gyroConfig)
     gyroConfig->gyro_soft_notch_cutoff_2 = 0;
     gyroConfig->checkOverflow = GYRO_OVERFLOW_CHECK_ALL_AXES;
     gyroConfig->gyro_offset_yaw = 0;
+    gyroConfig->gyro_fifo_burst = 0;
+    gyroConfig->gyro_fixed_point = false;
+    gyroConfig->gyro_fusion = false;
+    gyroConfig->gyro_rate_correction = false;
+    gyroConfig->gyro_bias_tracking = true;
+    gyroConfig->gyro_bias_temp_comp = true;
 }
 
 static inline bool isGyroSensorCalibrationComplete(const gyroSensor_t *gyroSensor)
@@ -155,6 +176,109 @@ static bool isOnFirstGyroCalibrationCycle(const gyroCalibration_t *gyroCalibrati
     return gyroCalibration->cyclesRemaining == gyroCalculateCalibratingCycles();
 }
 
+static uint8_t gyroSensorIndex(const gyroSensor_t *gyroSensor)
+{
+#ifdef USE_MULTI_GYRO
+    if (gyroSensor == &gyro.gyroSensor2) {
+        return 1;
+    }
+#else
+    UNUSED(gyroSensor);
+#endif
+    return 0;
+}
+
+static void gyroSetBias(gyroSensor_t *gyroSensor, int axis, float bias)
+{
+    gyroSensor->gyroDev.gyroZero[axis] = bias;
+    if (axis == Z) {
+        gyroSensor->gyroDev.gyroZero[axis] -= ((float)gyroConfig()->gyro_offset_yaw / 100);
+    }
+}
+
+static float gyroGetBias(const gyroSensor_t *gyroSensor, int axis)
+{
+    float bias = gyroSensor->gyroDev.gyroZero[axis];
+    if (axis == Z) {
+        bias += ((float)gyroConfig()->gyro_offset_yaw / 100);
+    }
+    return bias;
+}
+
+static float gyroTempCorrection(const gyroSensor_t *gyroSensor, int axis, float temp)
+{
+    const gyroTempModel_t *model = &gyroSensor->tempModel;
+
+    if (model->active && gyroSensor->gyroDev.hasTemperatureRaw) {
+        return model->slope[axis] * (temp - model->biasTemp);
+    }
+
+    return 0;
+}
+
+static void gyroLoadTempModel(gyroSensor_t *gyroSensor)
+{
+    gyroTempModel_t *model = &gyroSensor->tempModel;
+    const uint8_t index = gyroSensorIndex(gyroSensor);
+
+    memset(model, 0, sizeof(*model));
+
+    if (gyroBiasConfig()->slopeValid & BIT(index)) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            model->slope[axis] = (float)gyroBiasConfig()->slope[index][axis] / GYRO_BIAS_SLOPE_SCALE;
+        }
+        model->active = gyroConfig()->gyro_bias_temp_comp;
+    }
+}
+
+/*
+ * A new bias was measured at the given temperature. Add it to the least
+ * squares fit, and once the measurements cover enough of a temperature
+ * range, use the fitted slope.
+ */
+static void gyroBiasMeasured(gyroSensor_t *gyroSensor, float temp)
+{
+    gyroTempModel_t *model = &gyroSensor->tempModel;
+
+    model->biasTemp = temp;
+
+    if (!gyroSensor->gyroDev.hasTemperatureRaw) {
+        return;
+    }
+
+    if (model->n == 0) {
+        model->tempRef = temp;
+        model->tempMin = temp;
+        model->tempMax = temp;
+    }
+
+    const float t = temp - model->tempRef;
+
+    model->tempMin = MIN(model->tempMin, temp);
+    model->tempMax = MAX(model->tempMax, temp);
+
+    model->n += 1;
+    model->st += t;
+    model->stt += t * t;
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        const float b = gyroGetBias(gyroSensor, axis);
+        model->sb[axis] += b;
+        model->stb[axis] += t * b;
+    }
+
+    const float det = model->n * model->stt - model->st * model->st;
+
+    if (model->tempMax - model->tempMin >= GYRO_TEMP_SPAN_MIN && det > 0) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            const float slope = (model->n * model->stb[axis] - model->st * model->sb[axis]) / det;
+            model->slope[axis] = constrainf(slope, -GYRO_TEMP_SLOPE_LIMIT, GYRO_TEMP_SLOPE_LIMIT);
+        }
+        model->fitted = true;
+        model->active = gyroConfig()->gyro_bias_temp_comp;
+    }
+}
+
 static void gyroSetCalibrationCycles(gyroSensor_t *gyroSensor)
 {
 #if defined(USE_FAKE_GYRO) && !defined(UNIT_TEST)
@@ -164,6 +288,14 @@ static void gyroSetCalibrationCycles(gyroSensor_t *gyroSensor)
     }
 #endif
     gyroSensor->calibration.cyclesRemaining = gyroCalculateCalibratingCycles();
+    gyroSensor->tracking.cyclesRemaining = 0;
+
+    // Only the power up calibration may use the saved bias
+    gyroSensor->restoreBias = gyroConfig()->gyro_bias_tracking && !firstCalibrationWasStarted;
+
+    if (gyroSensor->restoreBias) {
+        gyroLoadTempModel(gyroSensor);
+    }
 }
 
 void gyroStartCalibration(bool isFirstArmingCalibration)
@@ -177,6 +309,8 @@ void gyroStartCalibration(bool isFirstArmingCalibration)
     gyroSetCalibrationCycles(&gyro.gyroSensor2);
 #endif
 
+    firstCalibrationWasStarted = true;
+
     if (isFirstArmingCalibration) {
         firstArmingCalibrationWasStarted = true;
     }
@@ -187,8 +321,204 @@ bool isFirstArmingGyroCalibrationRunning(void)
     return firstArmingCalibrationWasStarted && !gyroIsCalibrationComplete();
 }
 
+static void gyroCalibrationDone(void)
+{
+    schedulerResetTaskStatistics(TASK_SELF); // so calibration cycles do not pollute tasks statistics
+    if (!firstArmingCalibrationWasStarted || (getArmingDisableFlags() & ~ARMING_DISABLED_CALIBRATING) == 0) {
+        beeper(BEEPER_GYRO_CALIBRATED);
+    }
+}
+
+/*
+ * At power up, if the model has been still for a short while and the
+ * mean matches the bias saved on the last disarm, the calibration is
+ * finished early. Otherwise the full calibration runs as usual.
+ */
+static bool gyroRestoreBias(gyroSensor_t *gyroSensor, uint8_t gyroMovementCalibrationThreshold)
+{
+    const float cycles = gyroCalculateCalibratingCycles() - gyroSensor->calibration.cyclesRemaining + 1;
+
+    if (cycles < (GYRO_BIAS_RESTORE_TIME * 10000) / gyro.sampleLooptime) {
+        return false;
+    }
+
+    // One attempt only
+    gyroSensor->restoreBias = false;
+
+    const uint8_t index = gyroSensorIndex(gyroSensor);
+
+    if (!gyroMovementCalibrationThreshold || !(gyroBiasConfig()->valid & BIT(index))) {
+        return false;
+    }
+
+    float bias[XYZ_AXIS_COUNT];
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        const float stddev = devStandardDeviation(&gyroSensor->calibration.var[axis]);
+        const float saved = (float)gyroBiasConfig()->zero[index][axis] / GYRO_BIAS_SCALE;
+
+        bias[axis] = gyroSensor->calibration.sum[axis] / cycles;
+
+        if (stddev > gyroMovementCalibrationThreshold || fabsf(bias[axis] - saved) > GYRO_BIAS_RESTORE_LIMIT) {
+            return false;
+        }
+    }
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        gyroSetBias(gyroSensor, axis, bias[axis]);
+    }
+    gyroBiasMeasured(gyroSensor, gyroSensor->calibration.tempSum / cycles);
+
+    gyroSensor->calibration.cyclesRemaining = 0;
+    gyroCalibrationDone();
+
+    return true;
+}
+
+/*
+ * While disarmed, the bias is re-measured over windows of the calibration
+ * length. A window is used only if the model was still, and if the mean
+ * is close to the current bias, so slow drift is followed but handling
+ * the model is not mistaken for bias.
+ */
+static void gyroTrackBias(gyroSensor_t *gyroSensor, uint8_t gyroMovementCalibrationThreshold)
+{
+    gyroCalibration_t *tracking = &gyroSensor->tracking;
+
+    if (!gyroMovementCalibrationThreshold) {
+        return;
+    }
+
+    if (tracking->cyclesRemaining <= 0) {
+        tracking->cyclesRemaining = gyroCalculateCalibratingCycles();
+        tracking->tempSum = 0.0f;
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            tracking->sum[axis] = 0.0f;
+            devClear(&tracking->var[axis]);
+        }
+    }
+
+    tracking->tempSum += gyroSensor->gyroDev.temperatureRaw;
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        tracking->sum[axis] += gyroSensor->gyroDev.gyroADCRaw[axis];
+        devPush(&tracking->var[axis], gyroSensor->gyroDev.gyroADCRaw[axis]);
+    }
+
+    if (--tracking->cyclesRemaining == 0) {
+        const float cycles = gyroCalculateCalibratingCycles();
+        const float temp = tracking->tempSum / cycles;
+        float bias[XYZ_AXIS_COUNT];
+
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            const float stddev = devStandardDeviation(&tracking->var[axis]);
+            const float expected = gyroGetBias(gyroSensor, axis) + gyroTempCorrection(gyroSensor, axis, temp);
+
+            bias[axis] = tracking->sum[axis] / cycles;
+
+            if (stddev > gyroMovementCalibrationThreshold || fabsf(bias[axis] - expected) > GYRO_BIAS_TRACK_LIMIT) {
+                return;
+            }
+        }
+
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            gyroSetBias(gyroSensor, axis, bias[axis]);
+        }
+        gyroBiasMeasured(gyroSensor, temp);
+    }
+}
+
+static void gyroBiasWrite(struct dispatchEntry_s* self)
+{
+    UNUSED(self);
+
+    // Only the bias is appended to the saved config
+    writePGToEEPROM(PG_GYRO_BIAS_CONFIG);
+}
+
+static dispatchEntry_t gyroBiasWriteEntry =
+{
+    .dispatch = gyroBiasWrite,
+};
+
+static bool gyroBiasUpdateSaved(const gyroSensor_t *gyroSensor)
+{
+    const uint8_t index = gyroSensorIndex(gyroSensor);
+    bool changed = !(gyroBiasConfig()->valid & BIT(index));
+
+    if (!isGyroSensorCalibrationComplete(gyroSensor)) {
+        return false;
+    }
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        const float bias = gyroGetBias(gyroSensor, axis);
+        const float saved = (float)gyroBiasConfig()->zero[index][axis] / GYRO_BIAS_SCALE;
+        if (fabsf(bias - saved) > GYRO_BIAS_SAVE_LIMIT) {
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            const float bias = gyroGetBias(gyroSensor, axis) * GYRO_BIAS_SCALE;
+            gyroBiasConfigMutable()->zero[index][axis] = lrintf(constrainf(bias, INT16_MIN, INT16_MAX));
+        }
+        gyroBiasConfigMutable()->valid |= BIT(index);
+    }
+
+    const gyroTempModel_t *model = &gyroSensor->tempModel;
+
+    if (model->fitted) {
+        bool slopeChanged = !(gyroBiasConfig()->slopeValid & BIT(index));
+
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            const float saved = (float)gyroBiasConfig()->slope[index][axis] / GYRO_BIAS_SLOPE_SCALE;
+            if (fabsf(model->slope[axis] - saved) > GYRO_TEMP_SAVE_LIMIT) {
+                slopeChanged = true;
+            }
+        }
+
+        if (slopeChanged) {
+            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+                gyroBiasConfigMutable()->slope[index][axis] = lrintf(model->slope[axis] * GYRO_BIAS_SLOPE_SCALE);
+            }
+            gyroBiasConfigMutable()->slopeValid |= BIT(index);
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+void gyroBiasOnDisarm(void)
+{
+    if (!gyroConfig()->gyro_bias_tracking) {
+        return;
+    }
+
+    bool changed = false;
+
+    if (gyro.gyroToUse == GYRO_CONFIG_USE_GYRO_1 || gyro.gyroToUse == GYRO_CONFIG_USE_GYRO_BOTH) {
+        changed |= gyroBiasUpdateSaved(&gyro.gyroSensor1);
+    }
+#ifdef USE_MULTI_GYRO
+    if (gyro.gyroToUse == GYRO_CONFIG_USE_GYRO_2 || gyro.gyroToUse == GYRO_CONFIG_USE_GYRO_BOTH) {
+        changed |= gyroBiasUpdateSaved(&gyro.gyroSensor2);
+    }
+#endif
+
+    // A dirty config is saved in full on disarm
+    if (changed && !isConfigDirty()) {
+        dispatchAdd(&gyroBiasWriteEntry, GYRO_BIAS_WRITE_DELAY_US);
+    }
+}
+
 STATIC_UNIT_TESTED void performGyroCalibration(gyroSensor_t *gyroSensor, uint8_t gyroMovementCalibrationThreshold)
 {
+    if (isOnFirstGyroCalibrationCycle(&gyroSensor->calibration)) {
+        gyroSensor->calibration.tempSum = 0.0f;
+    }
+    gyroSensor->calibration.tempSum += gyroSensor->gyroDev.temperatureRaw;
+
     for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
         // Reset g[axis] at start of calibration
         if (isOnFirstGyroCalibrationCycle(&gyroSensor->calibration)) {
@@ -217,18 +547,17 @@ STATIC_UNIT_TESTED void performGyroCalibration(gyroSensor_t *gyroSensor, uint8_t
             }
 
             // please take care with exotic boardalignment !!
-            gyroSensor->gyroDev.gyroZero[axis] = gyroSensor->calibration.sum[axis] / gyroCalculateCalibratingCycles();
-            if (axis == Z) {
-              gyroSensor->gyroDev.gyroZero[axis] -= ((float)gyroConfig()->gyro_offset_yaw / 100);
-            }
+            gyroSetBias(gyroSensor, axis, gyroSensor->calibration.sum[axis] / gyroCalculateCalibratingCycles());
         }
     }
 
+    if (gyroSensor->restoreBias && gyroRestoreBias(gyroSensor, gyroMovementCalibrationThreshold)) {
+        return;
+    }
+
     if (isOnFinalGyroCalibrationCycle(&gyroSensor->calibration)) {
-        schedulerResetTaskStatistics(TASK_SELF); // so calibration cycles do not pollute tasks statistics
-        if (!firstArmingCalibrationWasStarted || (getArmingDisableFlags() & ~ARMING_DISABLED_CALIBRATING) == 0) {
-            beeper(BEEPER_GYRO_CALIBRATED);
-        }
+        gyroBiasMeasured(gyroSensor, gyroSensor->calibration.tempSum / gyroCalculateCalibratingCycles());
+        gyroCalibrationDone();
     }
 
     --gyroSensor->calibration.cyclesRemaining;
@@ -306,19 +635,45 @@ static FAST_CODE void checkForOverflow(timeUs_t currentTimeUs)
         if (overflowCheck & gyro.overflowAxisMask) {
             overflowDetected = true;
             overflowTimeUs = currentTimeUs;
+            eventLog(EVENT_GYRO_OVERFLOW, overflowCheck);
         }
 #endif // SIMULATOR_BUILD
     }
 }
+
+static FAST_CODE void checkForSaturation(timeUs_t currentTimeUs)
+{
+    // Saturated axes as flagged by the driver on each raw sample since the last check
+    const uint8_t saturation = gyro.saturation;
+    gyro.saturation = 0;
+
+    if (overflowDetected) {
+        // Reset after 50ms without saturation on any axis
+        if (saturation) {
+            overflowTimeUs = currentTimeUs;
+        }
+        else if (cmpTimeUs(currentTimeUs, overflowTimeUs) > 50000) {
+            overflowDetected = false;
+        }
+    }
+    else if (saturation & gyro.overflowAxisMask) {
+        overflowDetected = true;
+        overflowTimeUs = currentTimeUs;
+    }
+}
 #endif // USE_GYRO_OVERFLOW_CHECK
 
-static FAST_CODE void gyroUpdateSensor(gyroSensor_t *gyroSensor)
+static FAST_CODE bool gyroUpdateSensor(gyroSensor_t *gyroSensor)
 {
     if (!gyroSensor->gyroDev.readFn(&gyroSensor->gyroDev)) {
-        return;
+        return false;
     }
     gyroSensor->gyroDev.dataReady = false;
 
+#ifdef USE_GYRO_OVERFLOW_CHECK
+    gyro.saturation |= gyroSensor->gyroDev.saturation;
+#endif
+
     if (isGyroSensorCalibrationComplete(gyroSensor)) {
         // move 16-bit gyro data into 32-bit variables to avoid overflows in calculations
 
@@ -332,21 +687,63 @@ static FAST_CODE void gyroUpdateSensor(gyroSensor_t *gyroSensor)
         gyroSensor->gyroDev.gyroADC[Z] = gyroSensor->gyroDev.gyroADCRaw[Z] - gyroSensor->gyroDev.gyroZero[Z];
 #endif
 
-        if (gyroSensor->gyroDev.gyroAlign == ALIGN_CUSTOM) {
-            alignSensorViaMatrix(gyroSensor->gyroDev.gyroADC, &gyroSensor->gyroDev.rotationMatrix);
+        if (gyroSensor->tempModel.active && gyroSensor->gyroDev.hasTemperatureRaw) {
+            const float temp = gyroSensor->gyroDev.temperatureRaw;
+            gyroSensor->gyroDev.gyroADC[X] -= gyroTempCorrection(gyroSensor, X, temp);
+            gyroSensor->gyroDev.gyroADC[Y] -= gyroTempCorrection(gyroSensor, Y, temp);
+            gyroSensor->gyroDev.gyroADC[Z] -= gyroTempCorrection(gyroSensor, Z, temp);
+        }
+
+        if (gyroSensor->alignViaMatrix) {
+            applyMatrixRotation(gyroSensor->gyroDev.gyroADC, &gyroSensor->gyroDev.rotationMatrix);
         } else {
-            alignSensorViaRotation(gyroSensor->gyroDev.gyroADC, gyroSensor->gyroDev.gyroAlign);
+            alignSensorViaPermutation(gyroSensor->gyroDev.gyroADC, gyroSensor->gyroDev.gyroAlign);
+        }
+
+        if (gyroConfig()->gyro_bias_tracking && !ARMING_FLAG(ARMED)) {
+            gyroTrackBias(gyroSensor, gyroConfig()->gyroMovementCalibrationThreshold);
+        } else {
+            gyroSensor->tracking.cyclesRemaining = 0;
         }
     } else {
         performGyroCalibration(gyroSensor, gyroConfig()->gyroMovementCalibrationThreshold);
     }
+
+    return true;
 }
 
-FAST_CODE void gyroUpdate(void)
+#ifdef USE_MULTI_GYRO
+/*
+ * Per-axis noise variance, estimated from the sample-to-sample difference.
+ * At the raw gyro rate the first difference is dominated by sensor noise,
+ * and the motion component is common to both sensors.
+ */
+static FAST_CODE float gyroSensorNoiseVariance(gyroSensor_t *gyroSensor, int axis, float sample)
+{
+    const float delta = sample - gyroSensor->noisePrev[axis];
+
+    gyroSensor->noisePrev[axis] = sample;
+
+    return pt1FilterApply(&gyroSensor->noiseVariance[axis], sq(delta));
+}
+
+// Inverse variance weighted mean of the two sensors
+static FAST_CODE float gyroFuseSamples(int axis, float sample1, float sample2)
+{
+    const float var1 = gyroSensorNoiseVariance(&gyro.gyroSensor1, axis, sample1) + 1e-6f;
+    const float var2 = gyroSensorNoiseVariance(&gyro.gyroSensor2, axis, sample2) + 1e-6f;
+
+    return (sample1 * var2 + sample2 * var1) / (var1 + var2);
+}
+#endif
+
+static FAST_CODE void gyroUpdateSample(void)
 {
+    bool updated = false;
+
     switch (gyro.gyroToUse) {
     case GYRO_CONFIG_USE_GYRO_1:
-        gyroUpdateSensor(&gyro.gyroSensor1);
+        updated = gyroUpdateSensor(&gyro.gyroSensor1);
         if (isGyroSensorCalibrationComplete(&gyro.gyroSensor1)) {
             gyro.gyroADC[X] = gyro.gyroSensor1.gyroDev.gyroADC[X] * gyro.gyroSensor1.gyroDev.scale;
             gyro.gyroADC[Y] = gyro.gyroSensor1.gyroDev.gyroADC[Y] * gyro.gyroSensor1.gyroDev.scale;
@@ -355,7 +752,7 @@ FAST_CODE void gyroUpdate(void)
         break;
 #ifdef USE_MULTI_GYRO
     case GYRO_CONFIG_USE_GYRO_2:
-        gyroUpdateSensor(&gyro.gyroSensor2);
+        updated = gyroUpdateSensor(&gyro.gyroSensor2);
         if (isGyroSensorCalibrationComplete(&gyro.gyroSensor2)) {
             gyro.gyroADC[X] = gyro.gyroSensor2.gyroDev.gyroADC[X] * gyro.gyroSensor2.gyroDev.scale;
             gyro.gyroADC[Y] = gyro.gyroSensor2.gyroDev.gyroADC[Y] * gyro.gyroSensor2.gyroDev.scale;
@@ -363,9 +760,16 @@ FAST_CODE void gyroUpdate(void)
         }
         break;
     case GYRO_CONFIG_USE_GYRO_BOTH:
-        gyroUpdateSensor(&gyro.gyroSensor1);
-        gyroUpdateSensor(&gyro.gyroSensor2);
-        if (isGyroSensorCalibrationComplete(&gyro.gyroSensor1) && isGyroSensorCalibrationComplete(&gyro.gyroSensor2)) {
+        updated = gyroUpdateSensor(&gyro.gyroSensor1);
+        updated |= gyroUpdateSensor(&gyro.gyroSensor2);
+        if (gyro.gyroFusion && isGyroSensorCalibrationComplete(&gyro.gyroSensor1) && isGyroSensorCalibrationComplete(&gyro.gyroSensor2)) {
+            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+                gyro.gyroADC[axis] = gyroFuseSamples(axis,
+                    gyro.gyroSensor1.gyroDev.gyroADC[axis] * gyro.gyroSensor1.gyroDev.scale,
+                    gyro.gyroSensor2.gyroDev.gyroADC[axis] * gyro.gyroSensor2.gyroDev.scale);
+            }
+        }
+        else if (isGyroSensorCalibrationComplete(&gyro.gyroSensor1) && isGyroSensorCalibrationComplete(&gyro.gyroSensor2)) {
             gyro.gyroADC[X] = ((gyro.gyroSensor1.gyroDev.gyroADC[X] * gyro.gyroSensor1.gyroDev.scale) + (gyro.gyroSensor2.gyroDev.gyroADC[X] * gyro.gyroSensor2.gyroDev.scale)) / 2.0f;
             gyro.gyroADC[Y] = ((gyro.gyroSensor1.gyroDev.gyroADC[Y] * gyro.gyroSensor1.gyroDev.scale) + (gyro.gyroSensor2.gyroDev.gyroADC[Y] * gyro.gyroSensor2.gyroDev.scale)) / 2.0f;
             gyro.gyroADC[Z] = ((gyro.gyroSensor1.gyroDev.gyroADC[Z] * gyro.gyroSensor1.gyroDev.scale) + (gyro.gyroSensor2.gyroDev.gyroADC[Z] * gyro.gyroSensor2.gyroDev.scale)) / 2.0f;
@@ -374,9 +778,45 @@ FAST_CODE void gyroUpdate(void)
 #endif
     }
 
-    gyro.gyroADCd[X] = filterStackApply(gyro.decimator[X], gyro.gyroADC[X], 2);
-    gyro.gyroADCd[Y] = filterStackApply(gyro.decimator[Y], gyro.gyroADC[Y], 2);
-    gyro.gyroADCd[Z] = filterStackApply(gyro.decimator[Z], gyro.gyroADC[Z], 2);
+    // No new sample, the decimator must only see each sample once
+    if (!updated) {
+        return;
+    }
+
+    PROFILE_START(GYRO_DECIMATOR);
+
+    if (gyro.fixedPointFilters) {
+        gyro.gyroADCd[X] = filterFixedStackApply(gyro.decimatorFixed[X], gyro.gyroADC[X], 2);
+        gyro.gyroADCd[Y] = filterFixedStackApply(gyro.decimatorFixed[Y], gyro.gyroADC[Y], 2);
+        gyro.gyroADCd[Z] = filterFixedStackApply(gyro.decimatorFixed[Z], gyro.gyroADC[Z], 2);
+    } else {
+        gyro.gyroADCd[X] = filterStackApply(gyro.decimator[X], gyro.gyroADC[X], 2);
+        gyro.gyroADCd[Y] = filterStackApply(gyro.decimator[Y], gyro.gyroADC[Y], 2);
+        gyro.gyroADCd[Z] = filterStackApply(gyro.decimator[Z], gyro.gyroADC[Z], 2);
+    }
+
+    PROFILE_END(GYRO_DECIMATOR);
+}
+
+FAST_CODE void gyroUpdate(void)
+{
+    PROFILE_START(GYRO_UPDATE);
+
+    unsigned samples = 1;
+
+#ifdef USE_GYRO_SAMPLE_QUEUE
+    // Consume all queued samples after a late cycle or a FIFO burst,
+    // so that the decimator sees every sample
+    if (gyro.rawSensorDev->queue.active) {
+        samples = constrain(gyroQueueCount(&gyro.rawSensorDev->queue), 1, GYRO_QUEUE_SIZE);
+    }
+#endif
+
+    while (samples--) {
+        gyroUpdateSample();
+    }
+
+    PROFILE_END(GYRO_UPDATE);
 }
 
 #define GYRO_FILTER_FUNCTION_NAME filterGyro
@@ -399,12 +839,16 @@ FAST_CODE void gyroFiltering(timeUs_t currentTimeUs)
 {
     UNUSED(currentTimeUs);
 
+    PROFILE_START(GYRO_FILTER);
+
     if (gyro.gyroDebugMode == DEBUG_NONE) {
         filterGyro();
     } else {
         filterGyroDebug();
     }
 
+    PROFILE_END(GYRO_FILTER);
+
 #ifdef USE_MULTI_GYRO
     if (gyro.useDualGyroDebugging) {
         switch (gyro.gyroToUse) {
@@ -439,7 +883,10 @@ FAST_CODE void gyroFiltering(timeUs_t currentTimeUs)
 
 #ifdef USE_GYRO_OVERFLOW_CHECK
     if (gyroConfig()->checkOverflow && !gyro.gyroHasOverflowProtection) {
-        checkForOverflow(currentTimeUs);
+        if (gyro.gyroHasSaturationFlags)
+            checkForSaturation(currentTimeUs);
+        else
+            checkForOverflow(currentTimeUs);
     }
 #endif
 }
@@ -496,16 +943,20 @@ void dynLpfUpdate(timeUs_t currentTimeUs)
 {
     static timeUs_t lastDynLpfUpdateUs = 0;
 
-    if (gyro.dynLpfFilter) {
+    if (gyro.dynLpfFilter && cmpTimeUs(currentTimeUs, lastDynLpfUpdateUs) >= DYN_LPF_UPDATE_DELAY_US) {
         const float ratio = getFullHeadSpeedRatio();
-        if (cmpTimeUs(currentTimeUs, lastDynLpfUpdateUs) >= DYN_LPF_UPDATE_DELAY_US) {
-            const float cutoffFreq = constrainf(ratio * gyro.dynLpfHz, gyro.dynLpfMin, gyro.dynLpfMax);
-            DEBUG_SET(DEBUG_DYN_LPF, 2, lrintf(cutoffFreq));
+        const float cutoffFreq = constrainf(ratio * gyro.dynLpfHz, gyro.dynLpfMin, gyro.dynLpfMax);
+        DEBUG_SET(DEBUG_DYN_LPF, 2, lrintf(cutoffFreq));
+
+        // Recalculate the coefficients only when the cutoff has moved past the hysteresis band
+        if (fabsf(cutoffFreq - gyro.dynLpfCutoff) > gyro.dynLpfCutoff * DYN_LPF_HYSTERESIS) {
             for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
                 filterUpdate(&gyro.lowpassFilter[axis], cutoffFreq, gyro.filterRateHz);
             }
-            lastDynLpfUpdateUs = currentTimeUs;
+            gyro.dynLpfCutoff = cutoffFreq;
         }
+
+        lastDynLpfUpdateUs = currentTimeUs;
     }
 }
 
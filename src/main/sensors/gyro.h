@@ -40,6 +40,7 @@
 #define LPF_MAX_HZ                      1000
 #define DYN_LPF_MAX_HZ                  1000
 #define DYN_LPF_UPDATE_DELAY_US         5000
+#define DYN_LPF_HYSTERESIS              0.01f
 
 #define GYRO_LPF1_TYPE_DEFAULT          LPF_1ST_ORDER
 #define GYRO_LPF1_HZ_DEFAULT            100
@@ -49,6 +50,10 @@
 #define GYRO_LPF2_TYPE_DEFAULT          LPF_NONE
 #define GYRO_LPF2_HZ_DEFAULT            50
 
+#define GYRO_FILTER_STACK_SIZE          4   // LPF1, LPF2 and two static notches
+
+#define GYRO_FUSION_NOISE_CUTOFF        2   // Hz, noise variance averaging
+
 
 typedef enum gyroDetectionFlags_e {
     GYRO_NONE_MASK = 0,
@@ -63,12 +68,39 @@ typedef enum gyroDetectionFlags_e {
 typedef struct gyroCalibration_s {
     float sum[XYZ_AXIS_COUNT];
     stdev_t var[XYZ_AXIS_COUNT];
+    float tempSum;
     int32_t cyclesRemaining;
 } gyroCalibration_t;
 
+// Linear bias vs. raw sensor temperature, fitted to the bias measurements
+typedef struct gyroTempModel_s {
+    bool active;                    // slope is valid
+    bool fitted;                    // slope fitted to this session's measurements
+    float slope[XYZ_AXIS_COUNT];    // bias change per raw temperature LSB
+    float biasTemp;                 // raw temperature when gyroZero was measured
+    // Least squares sums, temperature relative to tempRef
+    float tempRef;
+    float tempMin;
+    float tempMax;
+    float n;
+    float st;
+    float stt;
+    float sb[XYZ_AXIS_COUNT];
+    float stb[XYZ_AXIS_COUNT];
+} gyroTempModel_t;
+
 typedef struct gyroSensor_s {
     gyroDev_t gyroDev;
     gyroCalibration_t calibration;
+    gyroCalibration_t tracking;     // background bias tracking while disarmed
+    gyroTempModel_t tempModel;
+    bool restoreBias;               // try the saved bias at the first calibration
+    bool alignViaMatrix;            // gyroDev.rotationMatrix holds sensor and board alignment
+#ifdef USE_MULTI_GYRO
+    // High-frequency noise estimate for dual gyro fusion
+    float noisePrev[XYZ_AXIS_COUNT];
+    pt1Filter_t noiseVariance[XYZ_AXIS_COUNT];
+#endif
 } gyroSensor_t;
 
 typedef struct gyro_s {
@@ -94,7 +126,15 @@ typedef struct gyro_s {
     gyroDev_t *rawSensorDev;           // pointer to the sensor providing the raw data for DEBUG_GYRO_RAW
 
     // gyro decimation filter stack
-    biquadFilter_t decimator[XYZ_AXIS_COUNT][2];
+    union {
+        biquadFilter_t decimator[XYZ_AXIS_COUNT][2];
+        biquadFixedFilter_t decimatorFixed[XYZ_AXIS_COUNT][2];
+    };
+    bool fixedPointFilters;
+
+    // Measured sample rate correction, see gyroGetSampleRateCorrection()
+    bool rateCorrection;
+    float samplePeriodNominal;
 
     // gyro lowpass filters
     filter_t lowpassFilter[XYZ_AXIS_COUNT];
@@ -104,18 +144,35 @@ typedef struct gyro_s {
     filter_t notchFilter1[XYZ_AXIS_COUNT];
     filter_t notchFilter2[XYZ_AXIS_COUNT];
 
+    // Static biquad sections (LPF and notch) cascaded per axis in one array
+    biquadFilter_t filterStack[XYZ_AXIS_COUNT][GYRO_FILTER_STACK_SIZE];
+    uint8_t filterStackCount;
+
+    // Remaining active static filter stages, disabled ones left out
+    filter_t *lowpassStage[2];
+    filter_t *notchStage[2];
+    uint8_t lowpassStageCount;
+    uint8_t notchStageCount;
+
     uint16_t accSampleRateHz;
     uint8_t gyroToUse;
     uint8_t gyroDebugMode;
 
     bool gyroHasOverflowProtection;
+    bool gyroHasSaturationFlags;
+    uint8_t saturation;             // saturated axes since the last overflow check
     bool useDualGyroDebugging;
 
+#ifdef USE_MULTI_GYRO
+    bool gyroFusion;
+#endif
+
 #ifdef USE_DYN_LPF
     bool dynLpfFilter;
     uint16_t dynLpfHz;
     uint16_t dynLpfMin;
     uint16_t dynLpfMax;
+    float dynLpfCutoff;
 #endif
 
 #ifdef USE_GYRO_OVERFLOW_CHECK
@@ -168,6 +225,13 @@ typedef struct gyroConfig_s {
 
     uint8_t gyrosDetected; // What gyros should detection be attempted for on startup. Automatically set on first startup.
 
+    uint8_t gyro_fifo_burst;    // Samples read from the sensor FIFO per interrupt (0 = FIFO burst mode off)
+    uint8_t gyro_fixed_point;   // Fixed-point decimator and static notch filters
+    uint8_t gyro_fusion;        // Noise weighted fusion instead of plain average with two gyros
+    uint8_t gyro_rate_correction; // Use the measured gyro sample rate in the dynamic notch
+    uint8_t gyro_bias_tracking; // Track the gyro bias while disarmed and restore it at power up
+    uint8_t gyro_bias_temp_comp; // Correct the bias for the sensor temperature
+
 } gyroConfig_t;
 
 PG_DECLARE(gyroConfig_t, gyroConfig);
@@ -177,6 +241,7 @@ void gyroFiltering(timeUs_t currentTimeUs);
 bool gyroGetAccumulationAverage(float *accumulation);
 void gyroStartCalibration(bool isFirstArmingCalibration);
 bool isFirstArmingGyroCalibrationRunning(void);
+void gyroBiasOnDisarm(void);
 bool gyroIsCalibrationComplete(void);
 void gyroReadTemperature(void);
 int16_t gyroGetTemperature(void);
@@ -19,6 +19,8 @@
 
 static FAST_CODE void GYRO_FILTER_FUNCTION_NAME(void)
 {
+    float gyroADCv[XYZ_AXIS_COUNT];
+
     for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
         // DEBUG_GYRO_RAW records the raw value read from the sensor (not zero offset, not scaled)
         GYRO_FILTER_DEBUG_SET(DEBUG_GYRO_RAW, axis, gyro.rawSensorDev->gyroADCRaw[axis]);
@@ -31,28 +33,48 @@ static FAST_CODE void GYRO_FILTER_FUNCTION_NAME(void)
         GYRO_FILTER_AXIS_DEBUG_SET(axis, DEBUG_GYRO_SAMPLE, 0, lrintf(gyro.gyroADC[axis]));
 
         // Downsampled (decimated) gyro signal
-        float gyroADCf = gyro.gyroADCd[axis];
+        gyroADCv[axis] = gyro.gyroADCd[axis];
 
         // DEBUG_GYRO_SAMPLE(1) Record the post-downsample value for the selected debug axis
-        GYRO_FILTER_AXIS_DEBUG_SET(axis, DEBUG_GYRO_SAMPLE, 1, lrintf(gyroADCf));
+        GYRO_FILTER_AXIS_DEBUG_SET(axis, DEBUG_GYRO_SAMPLE, 1, lrintf(gyroADCv[axis]));
+    }
 
 #ifdef USE_RPM_FILTER
-        gyroADCf = rpmFilterGyro(axis, gyroADCf);
+    // RPM filter banks are applied to all axes in one pass
+    PROFILE_START(GYRO_RPM_FILTER);
+    rpmFilterGyro(gyroADCv);
+    PROFILE_END(GYRO_RPM_FILTER);
 #endif
 
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        float gyroADCf = gyroADCv[axis];
+
+        PROFILE_LAP_START(lap);
+
         // DEBUG_GYRO_SAMPLE(2) Record the post-RPM Filter value for the selected debug axis
         GYRO_FILTER_AXIS_DEBUG_SET(axis, DEBUG_GYRO_SAMPLE, 2, lrintf(gyroADCf));
 
-        // apply static filters
-        gyroADCf = filterApply(&gyro.lowpass2Filter[axis], gyroADCf);
-        gyroADCf = filterApply(&gyro.lowpassFilter[axis], gyroADCf);
+        // apply non-biquad static filters
+        for (int stage = 0; stage < gyro.lowpassStageCount; stage++) {
+            filter_t *filter = &gyro.lowpassStage[stage][axis];
+            gyroADCf = filter->apply(&filter->data, gyroADCf);
+        }
+
+        PROFILE_LAP(lap, GYRO_LPF);
 
         // DEBUG_GYRO_SAMPLE(3) Record the post-LPF Filter value for the selected debug axis
         GYRO_FILTER_AXIS_DEBUG_SET(axis, DEBUG_GYRO_SAMPLE, 3, lrintf(gyroADCf));
 
-        // apply notch filters
-        gyroADCf = filterApply(&gyro.notchFilter2[axis], gyroADCf);
-        gyroADCf = filterApply(&gyro.notchFilter1[axis], gyroADCf);
+        // apply static biquad LPF and notch sections in one cascade
+        gyroADCf = filterStackApply(gyro.filterStack[axis], gyroADCf, gyro.filterStackCount);
+
+        // apply remaining notch filters
+        for (int stage = 0; stage < gyro.notchStageCount; stage++) {
+            filter_t *filter = &gyro.notchStage[stage][axis];
+            gyroADCf = filter->apply(&filter->data, gyroADCf);
+        }
+
+        PROFILE_LAP(lap, GYRO_NOTCH);
 
         // DEBUG_GYRO_SAMPLE(4) Record the post-Notch Filter value for the selected debug axis
         GYRO_FILTER_AXIS_DEBUG_SET(axis, DEBUG_GYRO_SAMPLE, 4, lrintf(gyroADCf));
@@ -61,6 +83,8 @@ static FAST_CODE void GYRO_FILTER_FUNCTION_NAME(void)
         if (isDynNotchActive()) {
             gyroADCf = dynNotchFilter(axis, gyroADCf);
 
+            PROFILE_LAP(lap, GYRO_DYN_NOTCH);
+
             // DEBUG_GYRO_SAMPLE(5) Record the post-Dyn Notch Filter value for the selected debug axis
             GYRO_FILTER_AXIS_DEBUG_SET(axis, DEBUG_GYRO_SAMPLE, 5, lrintf(gyroADCf));
         }
@@ -71,4 +95,13 @@ static FAST_CODE void GYRO_FILTER_FUNCTION_NAME(void)
 
         gyro.gyroADCf[axis] = gyroADCf;
     }
+
+    // Per-axis stages are summed over all axes
+    PROFILE_COMMIT(GYRO_LPF);
+    PROFILE_COMMIT(GYRO_NOTCH);
+#ifdef USE_DYN_NOTCH_FILTER
+    if (isDynNotchActive()) {
+        PROFILE_COMMIT(GYRO_DYN_NOTCH);
+    }
+#endif
 }
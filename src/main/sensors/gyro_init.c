@@ -60,11 +60,14 @@
 #endif
 
 #include "drivers/accgyro/gyro_sync.h"
+#include "drivers/system.h"
 
+#include "fc/dispatch.h"
 #include "fc/runtime_config.h"
 
 #include "pg/gyrodev.h"
 
+#include "sensors/boardalignment.h"
 #include "sensors/gyro.h"
 #include "sensors/sensors.h"
 
@@ -77,7 +80,11 @@
 // The gyro buffer is split 50/50, the first half for the transmit buffer, the second half for the receive buffer
 // This buffer is large enough for the gyros currently supported in accgyro_mpu.c but should be reviewed id other
 // gyro types are supported with SPI DMA.
+#ifdef USE_GYRO_FIFO_BURST
+#define GYRO_BUF_SIZE (2 * GYRO_DEV_BUF_SIZE)
+#else
 #define GYRO_BUF_SIZE 32
+#endif
 
 static gyroDetectionFlags_t gyroDetectionFlags = GYRO_NONE_MASK;
 
@@ -119,10 +126,53 @@ static void gyroInitLowpassFilter(filter_t *lowpassFilter, int type, float cutof
 static void gyroInitDecimationFilter(float cutoff, float sampleRate)
 {
     for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-        biquadFilterInit(&gyro.decimator[axis][0], BUTTER_4A_C * cutoff, sampleRate, BUTTER_4A_Q, BIQUAD_LPF);
-        biquadFilterInit(&gyro.decimator[axis][1], BUTTER_4B_C * cutoff, sampleRate, BUTTER_4B_Q, BIQUAD_LPF);
+        if (gyro.fixedPointFilters) {
+            biquadFixedFilterInit(&gyro.decimatorFixed[axis][0], BUTTER_4A_C * cutoff, sampleRate, BUTTER_4A_Q, BIQUAD_LPF);
+            biquadFixedFilterInit(&gyro.decimatorFixed[axis][1], BUTTER_4B_C * cutoff, sampleRate, BUTTER_4B_Q, BIQUAD_LPF);
+        } else {
+            biquadFilterInit(&gyro.decimator[axis][0], BUTTER_4A_C * cutoff, sampleRate, BUTTER_4A_Q, BIQUAD_LPF);
+            biquadFilterInit(&gyro.decimator[axis][1], BUTTER_4B_C * cutoff, sampleRate, BUTTER_4B_Q, BIQUAD_LPF);
+        }
+    }
+}
+
+#ifdef USE_MULTI_GYRO
+static void gyroInitFusionFilter(gyroSensor_t *gyroSensor, float sampleRate)
+{
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        gyroSensor->noisePrev[axis] = 0;
+        pt1FilterInit(&gyroSensor->noiseVariance[axis], GYRO_FUSION_NOISE_CUTOFF, sampleRate);
     }
 }
+#endif
+
+// Plain biquad sections go into the per-axis cascade, anything else becomes a separate stage
+static void gyroAddFilterStage(filter_t **stages, uint8_t *count, filter_t *filter)
+{
+    if (filterIsBiquadSection(filter) && gyro.filterStackCount < GYRO_FILTER_STACK_SIZE) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            gyro.filterStack[axis][gyro.filterStackCount] = filter[axis].data.sos;
+        }
+        gyro.filterStackCount++;
+    }
+    else if (filterIsActive(filter)) {
+        stages[(*count)++] = filter;
+    }
+}
+
+// Build the list of active static filters, so that disabled stages cost nothing in filterGyro()
+static void gyroInitFilterChain(void)
+{
+    gyro.filterStackCount = 0;
+
+    gyro.lowpassStageCount = 0;
+    gyroAddFilterStage(gyro.lowpassStage, &gyro.lowpassStageCount, gyro.lowpass2Filter);
+    gyroAddFilterStage(gyro.lowpassStage, &gyro.lowpassStageCount, gyro.lowpassFilter);
+
+    gyro.notchStageCount = 0;
+    gyroAddFilterStage(gyro.notchStage, &gyro.notchStageCount, gyro.notchFilter2);
+    gyroAddFilterStage(gyro.notchStage, &gyro.notchStageCount, gyro.notchFilter1);
+}
 
 void gyroInitFilters(void)
 {
@@ -132,11 +182,25 @@ void gyroInitFilters(void)
         gyro.dynLpfHz     = gyroConfig()->gyro_lpf1_static_hz;
         gyro.dynLpfMin    = gyroConfig()->gyro_lpf1_dyn_min_hz;
         gyro.dynLpfMax    = gyroConfig()->gyro_lpf1_dyn_max_hz;
+        gyro.dynLpfCutoff = gyroConfig()->gyro_lpf1_static_hz;
     } else {
         gyro.dynLpfFilter = false;
     }
 #endif
 
+#ifdef USE_MULTI_GYRO
+    gyro.gyroFusion = (gyro.gyroToUse == GYRO_CONFIG_USE_GYRO_BOTH) && gyroConfig()->gyro_fusion;
+
+    gyroInitFusionFilter(&gyro.gyroSensor1, gyro.sampleRateHz);
+    gyroInitFusionFilter(&gyro.gyroSensor2, gyro.sampleRateHz);
+#endif
+
+    gyro.fixedPointFilters = gyroConfig()->gyro_fixed_point;
+
+    gyro.rateCorrection = gyroConfig()->gyro_rate_correction;
+    gyro.samplePeriodNominal = (gyro.sampleRateHz > 0) ?
+        (float)clockMicrosToCycles(1000000) * (1 << GYRO_TIMING_SHIFT) / gyro.sampleRateHz : 0;
+
     gyroInitDecimationFilter(
         gyroConfig()->gyro_decimation_hz,
         gyro.sampleRateHz
@@ -163,7 +227,7 @@ void gyroInitFilters(void)
         gyroConfig()->gyro_soft_notch_hz_1,
         gyroConfig()->gyro_soft_notch_cutoff_1,
         gyro.filterRateHz,
-        0
+        gyro.fixedPointFilters ? LPF_FIXED : 0
     );
 
     gyroInitNotchFilter(
@@ -171,8 +235,10 @@ void gyroInitFilters(void)
         gyroConfig()->gyro_soft_notch_hz_2,
         gyroConfig()->gyro_soft_notch_cutoff_2,
         gyro.filterRateHz,
-        0
+        gyro.fixedPointFilters ? LPF_FIXED : 0
     );
+
+    gyroInitFilterChain();
 }
 
 #if defined(USE_GYRO_SLEW_LIMITER)
@@ -198,7 +264,7 @@ void gyroInitSensor(gyroSensor_t *gyroSensor, const gyroDeviceConfig_t *config)
     gyroSensor->gyroDev.gyro_high_fsr = gyroConfig()->gyro_high_fsr;
     gyroSensor->gyroDev.gyro_rate_sync = gyroConfig()->gyro_rate_sync;
     gyroSensor->gyroDev.gyroAlign = config->alignment;
-    buildRotationMatrixFromAlignment(&config->customAlignment, &gyroSensor->gyroDev.rotationMatrix);
+    gyroSensor->alignViaMatrix = buildSensorAlignmentMatrix(&gyroSensor->gyroDev.rotationMatrix, config->alignment, &config->customAlignment);
     gyroSensor->gyroDev.mpuIntExtiTag = config->extiTag;
     gyroSensor->gyroDev.hardware_lpf = gyroConfig()->gyro_hardware_lpf;
 
@@ -236,6 +302,20 @@ void gyroInitSensor(gyroSensor_t *gyroSensor, const gyroDeviceConfig_t *config)
         break;
     }
 
+    // Drivers that flag saturated samples in the read
+    switch (gyroSensor->gyroDev.gyroHardware) {
+    case GYRO_MPU6000:
+    case GYRO_BMI270:
+    case GYRO_ICM42605:
+    case GYRO_ICM42688P:
+        gyroSensor->gyroDev.gyroHasSaturationFlags = true;
+        break;
+
+    default:
+        gyroSensor->gyroDev.gyroHasSaturationFlags = false;
+        break;
+    }
+
     gyroInitSensorFilters(gyroSensor);
 }
 
@@ -443,6 +523,17 @@ static bool gyroDetectSensor(gyroSensor_t *gyroSensor, const gyroDeviceConfig_t
     return gyroHardware != GYRO_NONE;
 }
 
+bool gyroDetectedFromCache(void)
+{
+#if defined(USE_GYRO_MPU6050) || defined(USE_GYRO_MPU3050) || defined(USE_GYRO_MPU6500) || defined(USE_GYRO_SPI_MPU6500) || defined(USE_GYRO_SPI_MPU6000) \
+ || defined(USE_ACC_MPU6050) || defined(USE_GYRO_SPI_MPU9250) || defined(USE_GYRO_SPI_ICM20601) || defined(USE_GYRO_SPI_ICM20649) \
+ || defined(USE_GYRO_SPI_ICM20689) || defined(USE_GYRO_L3GD20) || defined(USE_ACCGYRO_BMI160) || defined(USE_ACCGYRO_BMI270) || defined(USE_ACCGYRO_LSM6DSO) || defined(USE_GYRO_SPI_ICM42605) || defined(USE_GYRO_SPI_ICM42688P)
+    return mpuDetectedFromCache();
+#else
+    return false;
+#endif
+}
+
 static void gyroPreInitSensor(const gyroDeviceConfig_t *config)
 {
 #if defined(USE_GYRO_MPU6050) || defined(USE_GYRO_MPU3050) || defined(USE_GYRO_MPU6500) || defined(USE_GYRO_SPI_MPU6500) || defined(USE_GYRO_SPI_MPU6000) \
@@ -477,20 +568,24 @@ bool gyroInit(void)
     gyro.gyroDebugMode = DEBUG_NONE;
     gyro.useDualGyroDebugging = false;
     gyro.gyroHasOverflowProtection = true;
-
-    switch (debugMode) {
-    case DEBUG_GYRO_RAW:
-    case DEBUG_GYRO_SCALED:
-    case DEBUG_GYRO_FILTERED:
-    case DEBUG_DYN_LPF:
-    case DEBUG_GYRO_SAMPLE:
-        gyro.gyroDebugMode = debugMode;
-        break;
-    case DEBUG_DUAL_GYRO_DIFF:
-    case DEBUG_DUAL_GYRO_RAW:
-    case DEBUG_DUAL_GYRO_SCALED:
-        gyro.useDualGyroDebugging = true;
-        break;
+    gyro.gyroHasSaturationFlags = true;
+
+    for (int index = 0; index < DEBUG_MODE_COUNT; index++) {
+        switch (debugModes[index]) {
+        case DEBUG_GYRO_RAW:
+        case DEBUG_GYRO_SCALED:
+        case DEBUG_GYRO_FILTERED:
+        case DEBUG_DYN_LPF:
+        case DEBUG_GYRO_SAMPLE:
+            if (gyro.gyroDebugMode == DEBUG_NONE)
+                gyro.gyroDebugMode = debugModes[index];
+            break;
+        case DEBUG_DUAL_GYRO_DIFF:
+        case DEBUG_DUAL_GYRO_RAW:
+        case DEBUG_DUAL_GYRO_SCALED:
+            gyro.useDualGyroDebugging = true;
+            break;
+        }
     }
 
     gyroDetectionFlags = GYRO_NONE_MASK;
@@ -550,6 +645,7 @@ bool gyroInit(void)
 
         gyroInitSensor(&gyro.gyroSensor2, gyroDeviceConfig(1));
         gyro.gyroHasOverflowProtection =  gyro.gyroHasOverflowProtection && gyro.gyroSensor2.gyroDev.gyroHasOverflowProtection;
+        gyro.gyroHasSaturationFlags = gyro.gyroHasSaturationFlags && gyro.gyroSensor2.gyroDev.gyroHasSaturationFlags;
         detectedSensors[SENSOR_INDEX_GYRO] = gyro.gyroSensor2.gyroDev.gyroHardware;
     }
 #endif
@@ -565,6 +661,7 @@ bool gyroInit(void)
         gyro.gyroSensor1.gyroDev.dev.rxBuf = &gyroBuf1[GYRO_BUF_SIZE / 2];
         gyroInitSensor(&gyro.gyroSensor1, gyroDeviceConfig(0));
         gyro.gyroHasOverflowProtection =  gyro.gyroHasOverflowProtection && gyro.gyroSensor1.gyroDev.gyroHasOverflowProtection;
+        gyro.gyroHasSaturationFlags = gyro.gyroHasSaturationFlags && gyro.gyroSensor1.gyroDev.gyroHasSaturationFlags;
         detectedSensors[SENSOR_INDEX_GYRO] = gyro.gyroSensor1.gyroDev.gyroHardware;
     }
 
@@ -589,6 +686,11 @@ bool gyroInit(void)
         gyro.accSampleRateHz = 0;
     }
 
+    // The tracked bias is saved on disarm
+    if (gyroConfig()->gyro_bias_tracking) {
+        dispatchEnable();
+    }
+
     return true;
 }
 
@@ -623,6 +725,35 @@ gyroDev_t *gyroActiveDev(void)
     return &ACTIVE_GYRO->gyroDev;
 }
 
+// Mean sample interval and jitter of the active gyro from the EXTI timestamps, in ns
+bool gyroGetSampleTiming(uint32_t *periodNs, uint32_t *jitterNs)
+{
+    const gyroDev_t *dev = gyroActiveDev();
+
+    if (dev->samplePeriod <= 0) {
+        return false;
+    }
+
+    const float nsPerUnit = 1000.0f / ((float)clockMicrosToCycles(1) * (1 << GYRO_TIMING_SHIFT));
+
+    *periodNs = lrintf(dev->samplePeriod * nsPerUnit);
+    *jitterNs = lrintf(dev->sampleJitter * nsPerUnit);
+
+    return true;
+}
+
+// Ratio of the measured to the nominal gyro sample rate
+float gyroGetSampleRateCorrection(void)
+{
+    const gyroDev_t *dev = gyroActiveDev();
+
+    if (gyro.rateCorrection && dev->samplePeriod > 0) {
+        return constrainf(gyro.samplePeriodNominal / dev->samplePeriod, 0.9f, 1.1f);
+    }
+
+    return 1.0f;
+}
+
 const mpuDetectionResult_t *gyroMpuDetectionResult(void)
 {
     return &ACTIVE_GYRO->gyroDev.mpuDetectionResult;
@@ -26,10 +26,13 @@
 void gyroSetLooptime(uint8_t pidDenom, uint8_t filterDenom);
 void gyroPreInit(void);
 bool gyroInit(void);
+bool gyroDetectedFromCache(void);
 void gyroInitFilters(void);
 void gyroInitSensor(gyroSensor_t *gyroSensor, const gyroDeviceConfig_t *config);
 gyroDetectionFlags_t getGyroDetectionFlags(void);
 gyroDev_t *gyroActiveDev(void);
+bool gyroGetSampleTiming(uint32_t *periodNs, uint32_t *jitterNs);
+float gyroGetSampleRateCorrection(void);
 struct mpuDetectionResult_s;
 const struct mpuDetectionResult_s *gyroMpuDetectionResult(void);
 int16_t gyroRateDps(int axis);
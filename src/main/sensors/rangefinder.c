@@ -43,8 +43,11 @@
 #include "drivers/rangefinder/rangefinder_lidartf.h"
 #include "drivers/time.h"
 
+#include "fc/dispatch.h"
 #include "fc/runtime_config.h"
 
+#include "flight/imu.h"
+
 #include "pg/pg.h"
 #include "pg/pg_ids.h"
 
@@ -64,6 +67,14 @@ int16_t rangefinderCfAltCm; // Complimentary Filter altitude
 
 rangefinder_t rangefinder;
 
+static timeDelta_t rangefinderPeriodUs;
+
+static void rangefinderDispatch(dispatchEntry_t *self);
+
+static dispatchEntry_t rangefinderDispatchEntry = {
+    .dispatch = rangefinderDispatch,
+};
+
 #define RANGEFINDER_HARDWARE_TIMEOUT_MS         500     // Accept 500ms of non-responsive sensor, report HW failure otherwise
 
 #define RANGEFINDER_DYNAMIC_THRESHOLD           600     //Used to determine max. usable rangefinder disatance
@@ -102,7 +113,7 @@ static bool rangefinderDetect(rangefinderDev_t * dev, uint8_t rangefinderHardwar
             {
                 if (hcsr04Detect(dev, sonarConfig())) {   // FIXME: Do actual detection if HC-SR04 is plugged in
                     rangefinderHardware = RANGEFINDER_HCSR04;
-                    rescheduleTask(TASK_RANGEFINDER, TASK_PERIOD_MS(RANGEFINDER_HCSR04_TASK_PERIOD_MS));
+                    rangefinderPeriodUs = RANGEFINDER_HCSR04_TASK_PERIOD_MS * 1000;
                 }
             }
 #endif
@@ -112,7 +123,7 @@ static bool rangefinderDetect(rangefinderDev_t * dev, uint8_t rangefinderHardwar
 #if defined(USE_RANGEFINDER_TF)
             if (lidarTFminiDetect(dev)) {
                 rangefinderHardware = RANGEFINDER_TFMINI;
-                rescheduleTask(TASK_RANGEFINDER, TASK_PERIOD_MS(RANGEFINDER_TF_TASK_PERIOD_MS));
+                rangefinderPeriodUs = RANGEFINDER_TF_TASK_PERIOD_MS * 1000;
             }
 #endif
             break;
@@ -121,7 +132,7 @@ static bool rangefinderDetect(rangefinderDev_t * dev, uint8_t rangefinderHardwar
 #if defined(USE_RANGEFINDER_TF)
             if (lidarTF02Detect(dev)) {
                 rangefinderHardware = RANGEFINDER_TF02;
-                rescheduleTask(TASK_RANGEFINDER, TASK_PERIOD_MS(RANGEFINDER_TF_TASK_PERIOD_MS));
+                rangefinderPeriodUs = RANGEFINDER_TF_TASK_PERIOD_MS * 1000;
             }
 #endif
             break;
@@ -168,6 +179,11 @@ bool rangefinderInit(void)
     rangefinderMaxAltWithTiltCm = rangefinderMaxRangeCm * rangefinder.maxTiltCos;
     rangefinderCfAltCm = rangefinder.dev.maxRangeCm / 2 ; // Complimentary Filter altitude
 
+    if (featureIsEnabled(FEATURE_RANGEFINDER)) {
+        dispatchEnable();
+        dispatchAdd(&rangefinderDispatchEntry, rangefinderPeriodUs);
+    }
+
     return true;
 }
 
@@ -220,7 +236,7 @@ static int16_t computePseudoSnr(int32_t newReading) {
 }
 
 /*
- * This is called periodically by the scheduler
+ * This is called by the dispatcher when the sensor is due
  */
 void rangefinderUpdate(void)
 {
@@ -229,6 +245,19 @@ void rangefinderUpdate(void)
     }
 }
 
+/*
+ * The sensor has a fixed conversion time, so there is nothing to poll
+ * for in between. Read the result and start the next conversion when
+ * it is due, then plan the next deadline.
+ */
+static void rangefinderDispatch(dispatchEntry_t *self)
+{
+    rangefinderUpdate();
+    rangefinderProcess(getCosTiltAngle());
+
+    dispatchAdd(self, rangefinderPeriodUs);
+}
+
 bool isSurfaceAltitudeValid() {
 
     /*
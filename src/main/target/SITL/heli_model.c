@@ -0,0 +1,317 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "platform.h"
+
+#include "common/maths.h"
+
+#include "fc/runtime_config.h"
+
+#include "flight/mixer.h"
+#include "flight/motors.h"
+
+#include "pg/motor.h"
+
+#include "heli_model.h"
+
+/*
+ * The body frame is FRD and the earth frame NED, as in fdm_packet.
+ *
+ * Rotor figures are given at the nominal headspeed and scale with the
+ * square of the headspeed. Cyclic and collective are the normalised
+ * swashplate inputs recovered from the servo outputs. Flapping is not
+ * modelled, the rotor moments act on the fuselage directly.
+ */
+
+#define GRAVITY     9.80665f
+
+typedef struct {
+    float mass;                 // kg
+    float inertia[3];           // kg m^2, fuselage
+    float rotorInertia;         // kg m^2, main rotor around the shaft
+    float nominalSpeed;         // rad/s
+    float maxSpeed;             // rad/s, unloaded headspeed at full throttle
+    float stallTorque;          // Nm, motor torque on the main shaft at standstill
+    float profileTorque;        // Nm, rotor drag at zero pitch
+    float inducedTorque;        // Nm, rotor drag added at full collective
+    float maxThrust;            // N, at full collective
+    float cyclicMoment[2];      // Nm, roll/pitch at full cyclic
+    float cyclicDamping[2];     // Nm s, roll/pitch rotor damping
+    float tailMoment;           // Nm, at full tail pitch or tail motor speed
+    float tailDamping;          // Nm s
+    float drag;                 // 1/s, airframe drag
+    float tailMotorSpeed;       // rpm, at full tail throttle
+    float tailMotorTau;         // s, tail motor spin-up time constant
+} heliModelParams_t;
+
+// A 700 size helicopter
+static const heliModelParams_t params = {
+    .mass = 3.5f,
+    .inertia = { 0.08f, 0.25f, 0.25f },
+    .rotorInertia = 0.25f,
+    .nominalSpeed = 209.4f,
+    .maxSpeed = 272.3f,
+    .stallTorque = 70.0f,
+    .profileTorque = 2.0f,
+    .inducedTorque = 23.0f,
+    .maxThrust = 86.0f,
+    .cyclicMoment = { 32.0f, 67.0f },
+    .cyclicDamping = { 2.0f, 4.2f },
+    .tailMoment = 19.0f,
+    .tailDamping = 1.5f,
+    .drag = 0.2f,
+    .tailMotorSpeed = 30000.0f,
+    .tailMotorTau = 0.05f,
+};
+
+typedef struct {
+    double  time;               // s
+    float   headSpeed;          // rad/s
+    float   tailSpeed;          // rpm, tail motor
+    float   rate[3];            // rad/s, body
+    float   quat[4];            // w,x,y,z, body to earth
+    float   vel[3];             // m/s, earth
+    float   pos[3];             // m, earth
+    float   accel[3];           // m/s^2, specific force in body
+} heliModelState_t;
+
+static heliModelState_t state;
+
+
+/** Helpers **/
+
+static void quatRotate(const float q[4], const float v[3], float out[3])
+{
+    const float w = q[0], x = q[1], y = q[2], z = q[3];
+
+    out[0] = (1 - 2*(y*y + z*z)) * v[0] + 2*(x*y - w*z) * v[1] + 2*(x*z + w*y) * v[2];
+    out[1] = 2*(x*y + w*z) * v[0] + (1 - 2*(x*x + z*z)) * v[1] + 2*(y*z - w*x) * v[2];
+    out[2] = 2*(x*z - w*y) * v[0] + 2*(y*z + w*x) * v[1] + (1 - 2*(x*x + y*y)) * v[2];
+}
+
+static void quatRotateInverse(const float q[4], const float v[3], float out[3])
+{
+    const float qc[4] = { q[0], -q[1], -q[2], -q[3] };
+
+    quatRotate(qc, v, out);
+}
+
+static void quatIntegrate(float q[4], const float rate[3], float dt)
+{
+    const float w = q[0], x = q[1], y = q[2], z = q[3];
+    const float a = rate[0] * dt / 2;
+    const float b = rate[1] * dt / 2;
+    const float c = rate[2] * dt / 2;
+
+    q[0] = w - x*a - y*b - z*c;
+    q[1] = x + w*a + y*c - z*b;
+    q[2] = y + w*b - x*c + z*a;
+    q[3] = z + w*c + x*b - y*a;
+
+    const float norm = sqrtf(sq(q[0]) + sq(q[1]) + sq(q[2]) + sq(q[3]));
+
+    for (int i = 0; i < 4; i++)
+        q[i] /= norm;
+}
+
+// Level the attitude, keeping the heading
+static void quatLevel(float q[4])
+{
+    const float yaw = atan2_approx(2 * (q[0]*q[3] + q[1]*q[2]), 1 - 2 * (sq(q[2]) + sq(q[3])));
+
+    q[0] = cos_approx(yaw / 2);
+    q[1] = 0;
+    q[2] = 0;
+    q[3] = sin_approx(yaw / 2);
+}
+
+static void swashCCPM(float S0, float S1, float S2, float kR, float kP, float *R, float *P, float *C)
+{
+    *R = (S1 - S2) / (2 * kR);
+    *P = (S1 + S2 - 2 * S0) / (2 * (1 + kP));
+    *C = 2 * (S0 + *P);
+}
+
+// Invert the swash mixer to get roll, pitch and collective back from the servos
+static void heliModelSwash(float *R, float *P, float *C)
+{
+    const float S0 = mixerGetServoOutput(0);
+    const float S1 = mixerGetServoOutput(1);
+    const float S2 = mixerGetServoOutput(2);
+
+    switch (mixerConfig()->swash_type) {
+        case SWASH_TYPE_120:
+            swashCCPM(S0, S1, S2, 0.86602540f, 0.5f, R, P, C);
+            break;
+        case SWASH_TYPE_135:
+            swashCCPM(S0, S1, S2, 0.70710678f, 0.70710678f, R, P, C);
+            break;
+        case SWASH_TYPE_140:
+            swashCCPM(S0, S1, S2, 0.64278760f, 0.76604444f, R, P, C);
+            break;
+        case SWASH_TYPE_90L:
+            *P = S0;
+            *R = S1;
+            *C = 0;
+            break;
+        case SWASH_TYPE_90V:
+            *P = (S0 + S1) * 0.70710678f;
+            *R = (S0 - S1) * 0.70710678f;
+            *C = 0;
+            break;
+        default:
+            // Custom rule mixers are read as a direct swash
+            *P = S0;
+            *R = S1;
+            *C = S2;
+            break;
+    }
+
+    *R = constrainf(*R, -1, 1);
+    *P = constrainf(*P, -1, 1);
+    *C = constrainf(*C, -1, 1);
+}
+
+
+/** Interface **/
+
+void heliModelInit(void)
+{
+    memset(&state, 0, sizeof(state));
+
+    state.quat[0] = 1;
+}
+
+void heliModelStep(fdm_packet *pkt, float dt)
+{
+    const bool armed = ARMING_FLAG(ARMED);
+    const float throttle = armed ? constrainf(mixerGetMotorOutput(0), 0, 1) : 0;
+
+    float roll, pitch, coll;
+    heliModelSwash(&roll, &pitch, &coll);
+
+    // Headspeed from the motor drive against the rotor drag
+    const float speedRatio = state.headSpeed / params.nominalSpeed;
+    const float speedRatio2 = sq(speedRatio);
+
+    const float driveTorque = fmaxf(params.stallTorque * (throttle - state.headSpeed / params.maxSpeed), 0);
+    const float dragTorque = speedRatio2 * (params.profileTorque + params.inducedTorque * sq(coll));
+
+    state.headSpeed = fmaxf(state.headSpeed + (driveTorque - dragTorque) / params.rotorInertia * dt, 0);
+
+    // Tail thrust in FC yaw direction. A tail motor only pushes against the torque.
+    float tailThrust;
+
+    if (mixerMotorizedTail()) {
+        const float tailThrottle = armed ? constrainf(mixerGetMotorOutput(1), 0, 1) : 0;
+        state.tailSpeed += (tailThrottle * params.tailMotorSpeed - state.tailSpeed) * dt / (params.tailMotorTau + dt);
+        tailThrust = mixerRotationSign() * params.tailMoment * sq(state.tailSpeed / params.tailMotorSpeed);
+    }
+    else {
+        tailThrust = params.tailMoment * speedRatio2 * constrainf(mixerGetServoOutput(3), -1, 1);
+    }
+
+    // Body moments. FC pitch and yaw are opposite to FRD.
+    const float moment[3] = {
+         params.cyclicMoment[0] * speedRatio2 * roll  - params.cyclicDamping[0] * speedRatio * state.rate[0],
+        -params.cyclicMoment[1] * speedRatio2 * pitch - params.cyclicDamping[1] * speedRatio * state.rate[1],
+        -tailThrust + mixerRotationSign() * driveTorque - params.tailDamping * state.rate[2],
+    };
+
+    const float *I = params.inertia;
+    const float *w = state.rate;
+
+    const float rateDot[3] = {
+        (moment[0] - (I[2] - I[1]) * w[1] * w[2]) / I[0],
+        (moment[1] - (I[0] - I[2]) * w[2] * w[0]) / I[1],
+        (moment[2] - (I[1] - I[0]) * w[0] * w[1]) / I[2],
+    };
+
+    // Rotor thrust and airframe drag
+    const float thrust[3] = { 0, 0, -params.maxThrust * speedRatio2 * coll / params.mass };
+    float force[3];
+
+    quatRotate(state.quat, thrust, force);
+
+    for (int i = 0; i < 3; i++)
+        force[i] -= params.drag * state.vel[i];
+
+    const bool onGround = (state.pos[2] >= 0 && force[2] + GRAVITY >= 0);
+
+    if (onGround) {
+        // Resting on the skids
+        force[0] = 0;
+        force[1] = 0;
+        force[2] = -GRAVITY;
+
+        for (int i = 0; i < 3; i++) {
+            state.rate[i] = 0;
+            state.vel[i] = 0;
+        }
+
+        state.pos[2] = 0;
+
+        quatLevel(state.quat);
+    }
+    else {
+        for (int i = 0; i < 3; i++)
+            state.rate[i] += rateDot[i] * dt;
+
+        quatIntegrate(state.quat, state.rate, dt);
+
+        state.vel[0] += force[0] * dt;
+        state.vel[1] += force[1] * dt;
+        state.vel[2] += (force[2] + GRAVITY) * dt;
+
+        for (int i = 0; i < 3; i++)
+            state.pos[i] += state.vel[i] * dt;
+    }
+
+    quatRotateInverse(state.quat, force, state.accel);
+
+    state.time += (double)dt;
+
+    pkt->timestamp = state.time;
+
+    for (int i = 0; i < 3; i++) {
+        pkt->imu_angular_velocity_rpy[i] = (double)state.rate[i];
+        pkt->imu_linear_acceleration_xyz[i] = (double)state.accel[i];
+        pkt->velocity_xyz[i] = (double)state.vel[i];
+        pkt->position_xyz[i] = (double)state.pos[i];
+    }
+
+    for (int i = 0; i < 4; i++)
+        pkt->imu_orientation_quat[i] = (double)state.quat[i];
+}
+
+float heliModelGetMotorERPM(uint8_t motor)
+{
+    const int polePairs = constrain(motorConfig()->motorPoleCount[motor] / 2, 1, 100);
+
+    if (motor == 0)
+        return state.headSpeed * (60 / M_2PIf) / getMainGearRatio() * polePairs;
+
+    if (motor == 1 && mixerMotorizedTail())
+        return state.tailSpeed * polePairs;
+
+    return 0;
+}
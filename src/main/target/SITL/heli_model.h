@@ -0,0 +1,36 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "platform.h"
+
+/*
+ * Built-in helicopter model for SITL.
+ *
+ * A rigid body with a single main rotor, driven from the mixer outputs.
+ * The model integrates the headspeed, the rotor and tail moments and the
+ * translational motion, and reports the result in the same fdm_packet
+ * form as an external simulator, so the sensors are fed the same way.
+ */
+
+void heliModelInit(void);
+void heliModelStep(fdm_packet *pkt, float dt);
+
+float heliModelGetMotorERPM(uint8_t motor);
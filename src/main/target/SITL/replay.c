@@ -0,0 +1,449 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+#include "platform.h"
+
+#include "common/axis.h"
+#include "common/maths.h"
+
+#include "drivers/accgyro/accgyro_fake.h"
+
+#include "fc/rc_controls.h"
+#include "fc/runtime_config.h"
+
+#include "flight/mixer.h"
+#include "flight/motors.h"
+#include "flight/pid.h"
+#include "flight/servos.h"
+
+#include "pg/motor.h"
+#include "pg/rx.h"
+
+#include "rx/rx.h"
+#include "rx/msp.h"
+
+#include "sensors/gyro.h"
+
+#include "replay.h"
+
+#define REPLAY_LINE_SIZE        8192
+#define REPLAY_MAX_COLUMNS      512
+
+#define REPLAY_RX_PERIOD        5000        // us
+#define REPLAY_ARM_TIMEOUT      5000000     // us
+#define REPLAY_ARM_CHANNEL      5           // AUX1
+
+#define REPLAY_GYRO_SCALE       16.4f       // fake gyro LSB per deg/s
+#define REPLAY_ACC_1G           256
+
+typedef enum {
+    REPLAY_CALIBRATE,
+    REPLAY_ARMING,
+    REPLAY_RUNNING,
+    REPLAY_DONE,
+} replayState_e;
+
+typedef struct {
+    int     time;
+    int     gyro[XYZ_AXIS_COUNT];
+    int     acc[XYZ_AXIS_COUNT];
+    int     command[CONTROL_CHANNEL_COUNT];
+    int     headspeed;
+    int     tailspeed;
+} replayColumns_t;
+
+typedef struct {
+    double  time;                           // us, log time
+    float   gyro[XYZ_AXIS_COUNT];           // fake gyro LSB
+    float   acc[XYZ_AXIS_COUNT];            // fake acc LSB
+    float   command[CONTROL_CHANNEL_COUNT]; // rcCommand
+    float   headspeed;                      // rpm
+    float   tailspeed;                      // rpm
+} replayFrame_t;
+
+typedef struct {
+    FILE           *input;
+    FILE           *output;
+
+    replayColumns_t column;
+    bool            gyroFromDebug;
+
+    replayState_e   state;
+    uint64_t        stateUs;
+    uint64_t        rxUs;
+
+    double          logStart;
+    replayFrame_t   prev;
+    replayFrame_t   next;
+    replayFrame_t   now;
+
+    uint32_t        frames;
+    char            line[REPLAY_LINE_SIZE];
+} replay_t;
+
+static replay_t replay;
+
+
+/** Input **/
+
+// blackbox_decode names the columns like "time (us)" or "gyroRAW[0]"
+static int replayFindColumn(char **names, int count, const char *name)
+{
+    for (int i = 0; i < count; i++) {
+        if (strcmp(names[i], name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+static char *replayTrim(char *str)
+{
+    while (isspace((unsigned char)*str))
+        str++;
+
+    char *end = str + strlen(str);
+    while (end > str && isspace((unsigned char)end[-1]))
+        *--end = 0;
+
+    char *unit = strstr(str, " (");
+    if (unit)
+        *unit = 0;
+
+    return str;
+}
+
+static int replaySplit(char *line, char **fields)
+{
+    int count = 0;
+
+    for (char *field = strtok(line, ","); field && count < REPLAY_MAX_COLUMNS; field = strtok(NULL, ","))
+        fields[count++] = replayTrim(field);
+
+    return count;
+}
+
+static bool replayReadHeader(void)
+{
+    char *names[REPLAY_MAX_COLUMNS];
+    char name[32];
+
+    if (!fgets(replay.line, sizeof(replay.line), replay.input))
+        return false;
+
+    const int count = replaySplit(replay.line, names);
+
+    replay.column.time = replayFindColumn(names, count, "time");
+    replay.column.headspeed = replayFindColumn(names, count, "headspeed");
+    replay.column.tailspeed = replayFindColumn(names, count, "tailspeed");
+
+    for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+        // DEBUG_GYRO_RAW has the sensor counts, gyroRAW the unfiltered rate
+        snprintf(name, sizeof(name), replay.gyroFromDebug ? "debug[%d]" : "gyroRAW[%d]", i);
+        replay.column.gyro[i] = replayFindColumn(names, count, name);
+        snprintf(name, sizeof(name), "accADC[%d]", i);
+        replay.column.acc[i] = replayFindColumn(names, count, name);
+    }
+
+    for (int i = 0; i < CONTROL_CHANNEL_COUNT; i++) {
+        snprintf(name, sizeof(name), "rcCommand[%d]", i);
+        replay.column.command[i] = replayFindColumn(names, count, name);
+    }
+
+    if (replay.column.time < 0 || replay.column.gyro[X] < 0) {
+        printf("[replay]No time or %s column in the log\n", replay.gyroFromDebug ? "debug" : "gyroRAW");
+        return false;
+    }
+
+    return true;
+}
+
+static float replayField(char **fields, int count, int column, float value)
+{
+    return (column >= 0 && column < count) ? strtof(fields[column], NULL) : value;
+}
+
+static bool replayReadFrame(replayFrame_t *frame)
+{
+    char *fields[REPLAY_MAX_COLUMNS];
+
+    // Skip the event and empty lines
+    do {
+        if (!fgets(replay.line, sizeof(replay.line), replay.input))
+            return false;
+    } while (!isdigit((unsigned char)replay.line[0]));
+
+    const int count = replaySplit(replay.line, fields);
+    const float gyroScale = replay.gyroFromDebug ? 1 : REPLAY_GYRO_SCALE;
+
+    frame->time = strtod(fields[replay.column.time], NULL);
+
+    for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+        frame->gyro[i] = replayField(fields, count, replay.column.gyro[i], 0) * gyroScale;
+        frame->acc[i] = replayField(fields, count, replay.column.acc[i], (i == Z) ? REPLAY_ACC_1G : 0);
+    }
+
+    for (int i = 0; i < CONTROL_CHANNEL_COUNT; i++)
+        frame->command[i] = replayField(fields, count, replay.column.command[i], 0);
+
+    frame->headspeed = replayField(fields, count, replay.column.headspeed, 0);
+    frame->tailspeed = replayField(fields, count, replay.column.tailspeed, 0);
+
+    return true;
+}
+
+
+/** Output **/
+
+static void replayWriteHeader(void)
+{
+    fprintf(replay.output, "time (us)");
+
+    for (int i = 0; i < XYZ_AXIS_COUNT; i++)
+        fprintf(replay.output, ",gyroADC[%d]", i);
+
+    static const char * const terms[] = { "axisP", "axisI", "axisD", "axisF" };
+
+    for (unsigned t = 0; t < ARRAYLEN(terms); t++)
+        for (int i = 0; i < XYZ_AXIS_COUNT; i++)
+            fprintf(replay.output, ",%s[%d]", terms[t], i);
+
+    for (int i = 0; i < 4; i++)
+        fprintf(replay.output, ",mixer[%d]", i);
+
+    for (int i = 0; i < getMotorCount(); i++)
+        fprintf(replay.output, ",motor[%d]", i);
+
+    for (int i = 0; i < getServoCount(); i++)
+        fprintf(replay.output, ",servo[%d]", i);
+
+    fprintf(replay.output, ",headspeed,tailspeed\n");
+}
+
+// Same scaling as the blackbox
+static void replayWriteFrame(const replayFrame_t *frame)
+{
+    const pidAxisData_t *pidData = pidGetAxisData();
+
+    fprintf(replay.output, "%.0f", frame->time);
+
+    for (int i = 0; i < XYZ_AXIS_COUNT; i++)
+        fprintf(replay.output, ",%ld", lrintf(gyro.gyroADCf[i]));
+
+    for (int i = 0; i < XYZ_AXIS_COUNT; i++)
+        fprintf(replay.output, ",%ld", lrintf(pidData[i].P * 1000));
+    for (int i = 0; i < XYZ_AXIS_COUNT; i++)
+        fprintf(replay.output, ",%ld", lrintf(pidData[i].I * 1000));
+    for (int i = 0; i < XYZ_AXIS_COUNT; i++)
+        fprintf(replay.output, ",%ld", lrintf(pidData[i].D * 1000));
+    for (int i = 0; i < XYZ_AXIS_COUNT; i++)
+        fprintf(replay.output, ",%ld", lrintf(pidData[i].F * 1000));
+
+    fprintf(replay.output, ",%ld,%ld,%ld,%ld",
+        lrintf(mixerGetInput(MIXER_IN_STABILIZED_ROLL) * 1000),
+        lrintf(mixerGetInput(MIXER_IN_STABILIZED_PITCH) * 1000),
+        lrintf(mixerGetInput(MIXER_IN_STABILIZED_YAW) * 1000),
+        lrintf(mixerGetInput(MIXER_IN_STABILIZED_COLLECTIVE) * 1000));
+
+    for (int i = 0; i < getMotorCount(); i++)
+        fprintf(replay.output, ",%d", getMotorOutput(i));
+
+    for (int i = 0; i < getServoCount(); i++)
+        fprintf(replay.output, ",%d", getServoOutput(i));
+
+    fprintf(replay.output, ",%d,%d\n", getHeadSpeed(), getTailSpeed());
+
+    replay.frames++;
+}
+
+
+/** Feeding the firmware **/
+
+// Invert updateRcCommands(), without the deadband. No commands is sticks
+// centered and throttle at the arming position.
+static void replaySendRx(const float *command, bool arm)
+{
+    uint16_t frame[MAX_SUPPORTED_RC_CHANNEL_COUNT];
+
+    const rcControlsConfig_t *rc = rcControlsConfig();
+
+    for (int i = 0; i < MAX_SUPPORTED_RC_CHANNEL_COUNT; i++)
+        frame[i] = rc->rc_center;
+
+    for (int axis = 0; axis < 4; axis++) {
+        const float value = command ? command[axis] : 0;
+        frame[rxConfig()->rcmap[axis]] = rc->rc_center + value / 500 * rc->rc_deflection;
+    }
+
+    frame[rxConfig()->rcmap[THROTTLE]] = command ?
+        scaleRangef(command[THROTTLE], 0, 1000, rc->rc_min_throttle, rc->rc_max_throttle) : rc->rc_arm_throttle;
+
+    frame[rxConfig()->rcmap[REPLAY_ARM_CHANNEL]] = arm ? 2000 : 1000;
+
+    rxMspFrameReceive(frame, MAX_SUPPORTED_RC_CHANNEL_COUNT);
+}
+
+static void replayFeed(const replayFrame_t *frame)
+{
+    fakeGyroSet(fakeGyroDev, lrintf(frame->gyro[X]), lrintf(frame->gyro[Y]), lrintf(frame->gyro[Z]));
+    fakeAccSet(fakeAccDev, lrintf(frame->acc[X]), lrintf(frame->acc[Y]), lrintf(frame->acc[Z]));
+}
+
+static void replayFeedIdle(uint64_t timeUs, bool arm)
+{
+    memset(&replay.now, 0, sizeof(replay.now));
+    replay.now.acc[Z] = REPLAY_ACC_1G;
+
+    replayFeed(&replay.now);
+
+    if (timeUs - replay.rxUs >= REPLAY_RX_PERIOD) {
+        replaySendRx(NULL, arm);
+        replay.rxUs = timeUs;
+    }
+}
+
+static void replayInterpolate(double logTime)
+{
+    const replayFrame_t *a = &replay.prev;
+    const replayFrame_t *b = &replay.next;
+
+    const double span = b->time - a->time;
+    const float k = (span > 0) ? constrainf((logTime - a->time) / span, 0, 1) : 1;
+
+    for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+        replay.now.gyro[i] = a->gyro[i] + k * (b->gyro[i] - a->gyro[i]);
+        replay.now.acc[i] = a->acc[i] + k * (b->acc[i] - a->acc[i]);
+    }
+
+    // The RC commands are stepped in the log already
+    for (int i = 0; i < CONTROL_CHANNEL_COUNT; i++)
+        replay.now.command[i] = a->command[i];
+
+    replay.now.headspeed = a->headspeed + k * (b->headspeed - a->headspeed);
+    replay.now.tailspeed = a->tailspeed + k * (b->tailspeed - a->tailspeed);
+}
+
+
+/** Interface **/
+
+bool replayInit(const char *inputFile, const char *outputFile, bool gyroFromDebug)
+{
+    memset(&replay, 0, sizeof(replay));
+
+    replay.gyroFromDebug = gyroFromDebug;
+
+    replay.input = fopen(inputFile, "r");
+    if (!replay.input) {
+        printf("[replay]Can't open %s\n", inputFile);
+        return false;
+    }
+
+    if (!replayReadHeader() || !replayReadFrame(&replay.next)) {
+        printf("[replay]Can't read %s\n", inputFile);
+        return false;
+    }
+
+    replay.output = fopen(outputFile, "w");
+    if (!replay.output) {
+        printf("[replay]Can't create %s\n", outputFile);
+        return false;
+    }
+
+    replay.prev = replay.next;
+    replay.logStart = replay.next.time;
+    replay.state = REPLAY_CALIBRATE;
+
+    printf("[replay]%s -> %s\n", inputFile, outputFile);
+
+    return true;
+}
+
+bool replayUpdate(uint64_t timeUs)
+{
+    switch (replay.state) {
+        case REPLAY_CALIBRATE:
+            replayFeedIdle(timeUs, false);
+            if (gyroIsCalibrationComplete()) {
+                replay.state = REPLAY_ARMING;
+                replay.stateUs = timeUs;
+            }
+            break;
+
+        case REPLAY_ARMING:
+            // Arm with AUX1 before starting, so the PID and mixer run as in flight
+            replayFeedIdle(timeUs, true);
+            if (ARMING_FLAG(ARMED) || timeUs - replay.stateUs > REPLAY_ARM_TIMEOUT) {
+                if (!ARMING_FLAG(ARMED))
+                    printf("[replay]Not armed, replaying disarmed\n");
+                replayWriteHeader();
+                replay.state = REPLAY_RUNNING;
+                replay.stateUs = timeUs;
+            }
+            break;
+
+        case REPLAY_RUNNING: {
+            const double logTime = replay.logStart + (timeUs - replay.stateUs);
+
+            while (replay.next.time <= logTime) {
+                // The pipeline has run on the inputs of this row now
+                replayWriteFrame(&replay.next);
+                replay.prev = replay.next;
+                if (!replayReadFrame(&replay.next)) {
+                    printf("[replay]Done, %u frames\n", replay.frames);
+                    fclose(replay.input);
+                    fclose(replay.output);
+                    replay.state = REPLAY_DONE;
+                    return false;
+                }
+            }
+
+            replayInterpolate(logTime);
+            replayFeed(&replay.now);
+
+            if (timeUs - replay.rxUs >= REPLAY_RX_PERIOD) {
+                replaySendRx(replay.now.command, true);
+                replay.rxUs = timeUs;
+            }
+            break;
+        }
+
+        case REPLAY_DONE:
+            return false;
+    }
+
+    return true;
+}
+
+float replayGetMotorERPM(uint8_t motor)
+{
+    const int polePairs = constrain(motorConfig()->motorPoleCount[motor] / 2, 1, 100);
+
+    if (motor == 0)
+        return replay.now.headspeed / getMainGearRatio() * polePairs;
+
+    if (motor == 1)
+        return replay.now.tailspeed / getTailGearRatio() * polePairs;
+
+    return 0;
+}
@@ -0,0 +1,37 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Blackbox log replay for SITL.
+ *
+ * Reads a log as exported to CSV by blackbox_decode, and feeds the
+ * unfiltered gyro, accelerometer, RC commands and head/tail speed
+ * back into the fake sensors, the MSP receiver and the RPM source.
+ * The filters, PID controller and mixer run as usual, and their
+ * outputs are written to a new CSV with the blackbox field names,
+ * one row per input row, so the two can be diffed.
+ */
+
+bool replayInit(const char *inputFile, const char *outputFile, bool gyroFromDebug);
+bool replayUpdate(uint64_t timeUs);
+
+float replayGetMotorERPM(uint8_t motor);
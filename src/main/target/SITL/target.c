@@ -56,6 +56,8 @@ const timerHardware_t timerHardware[1]; // unused
 
 #include "dyad.h"
 #include "target/SITL/udplink.h"
+#include "target/SITL/heli_model.h"
+#include "target/SITL/replay.h"
 
 uint32_t SystemCoreClock;
 
@@ -70,6 +72,27 @@ static udpLink_t stateLink, pwmLink;
 static pthread_mutex_t updateLock;
 static pthread_mutex_t mainLoopLock;
 
+// Lockstep: the firmware time only advances with the simulation
+#define SIM_LOCKSTEP_PASSES     8       // scheduler passes per gyro cycle
+#define SIM_LOCKSTEP_MIN_STEP   10      // us, while the gyro is not scheduled
+#define SIM_LOCKSTEP_TIMEOUT    500     // ms, waiting for the external simulator
+
+static bool simLockstep = false;
+static bool simHeliModel = false;
+static bool simReplay = false;
+static uint64_t simTimeUs = 0;
+static uint64_t simStepUs = 0;
+static uint64_t simDurationUs = 0;
+static unsigned simIdlePasses = 0;
+
+// Parallel instances: all ports are offset by the instance number
+#define SIM_PWM_PORT            9002
+#define SIM_STATE_PORT          9003
+#define SIM_INSTANCE_PORTS      10
+
+static int simInstance = 0;
+static char eepromFileName[32] = EEPROM_FILENAME;
+
 int timeval_sub(struct timespec *result, struct timespec *x, struct timespec *y);
 
 int lockMainPID(void) {
@@ -82,26 +105,11 @@ int lockMainPID(void) {
 void sendMotorUpdate() {
     udpSend(&pwmLink, &pwmPkt, sizeof(servo_packet));
 }
-void updateState(const fdm_packet* pkt) {
-    static double last_timestamp = 0; // in seconds
-    static uint64_t last_realtime = 0; // in uS
-    static struct timespec last_ts; // last packet
-
-    struct timespec now_ts;
-    clock_gettime(CLOCK_MONOTONIC, &now_ts);
-
-    const uint64_t realtime_now = micros64_real();
-    if (realtime_now > last_realtime + 500*1e3) { // 500ms timeout
-        last_timestamp = pkt->timestamp;
-        last_realtime = realtime_now;
-        sendMotorUpdate();
-        return;
-    }
-
-    const double deltaSim = pkt->timestamp - last_timestamp;  // in seconds
-    if (deltaSim < 0) { // don't use old packet
-        return;
-    }
+// Feed the sensors from a simulator packet
+static void applyState(const fdm_packet* pkt, double deltaSim) {
+#if !defined(SIMULATOR_IMU_SYNC)
+    UNUSED(deltaSim);
+#endif
 
     int16_t x,y,z;
     x = constrain(-pkt->imu_linear_acceleration_xyz[0] * ACC_SCALE, -32767, 32767);
@@ -151,7 +159,30 @@ void updateState(const fdm_packet* pkt) {
     imuSetHasNewData(deltaSim*1e6);
     imuUpdateAttitude(micros());
 #endif
+}
 
+void updateState(const fdm_packet* pkt) {
+    static double last_timestamp = 0; // in seconds
+    static uint64_t last_realtime = 0; // in uS
+    static struct timespec last_ts; // last packet
+
+    struct timespec now_ts;
+    clock_gettime(CLOCK_MONOTONIC, &now_ts);
+
+    const uint64_t realtime_now = micros64_real();
+    if (!simLockstep && realtime_now > last_realtime + 500*1e3) { // 500ms timeout
+        last_timestamp = pkt->timestamp;
+        last_realtime = realtime_now;
+        sendMotorUpdate();
+        return;
+    }
+
+    const double deltaSim = pkt->timestamp - last_timestamp;  // in seconds
+    if (deltaSim < 0) { // don't use old packet
+        return;
+    }
+
+    applyState(pkt, deltaSim);
 
     if (deltaSim < 0.02 && deltaSim > 0) { // simulator should run faster than 50Hz
 //        simRate = simRate * 0.5 + (1e6 * deltaSim / (realtime_now - last_realtime)) * 0.5;
@@ -215,6 +246,44 @@ void systemInit(void) {
 
     SystemCoreClock = 500 * 1e6; // fake 500MHz
 
+    const char *env = getenv("SITL_LOCKSTEP");
+    simLockstep = env && atoi(env);
+
+    env = getenv("SITL_MODEL");
+    simHeliModel = env && strcmp(env, "heli") == 0;
+
+    // replaying a log runs in lockstep without a simulator
+    env = getenv("SITL_REPLAY");
+    if (env) {
+        const char *out = getenv("SITL_REPLAY_OUT");
+        const char *gyro = getenv("SITL_REPLAY_GYRO");
+        if (!replayInit(env, out ? out : "replay.csv", gyro && strcmp(gyro, "debug") == 0)) {
+            exit(1);
+        }
+        simReplay = true;
+        simLockstep = true;
+        simHeliModel = false;
+    }
+
+    env = getenv("SITL_DURATION");
+    if (env) {
+        simDurationUs = atof(env) * 1e6;
+    }
+
+    env = getenv("SITL_INSTANCE");
+    if (env) {
+        simInstance = atoi(env);
+        snprintf(eepromFileName, sizeof(eepromFileName), "eeprom_%d.bin", simInstance);
+        tcpSetPortOffset(simInstance * SIM_INSTANCE_PORTS);
+        printf("[system]instance %d\n", simInstance);
+    }
+
+    // Unix domain sockets instead of UDP to the simulator
+    const char *simSocket = getenv("SITL_SOCKET");
+
+    printf("[system]%s time, %s\n", simLockstep ? "lockstep" : "realtime",
+        simReplay ? "log replay" : simHeliModel ? "built-in heli model" : "external simulator");
+
     if (pthread_mutex_init(&updateLock, NULL) != 0) {
         printf("Create updateLock error!\n");
         exit(1);
@@ -231,16 +300,35 @@ void systemInit(void) {
         exit(1);
     }
 
-    ret = udpInit(&pwmLink, "127.0.0.1", 9002, false);
-    printf("init PwmOut UDP link...%d\n", ret);
+    if (simHeliModel) {
+        heliModelInit();
+    } else if (!simReplay && simSocket) {
+        char path[sizeof(pwmLink.su.sun_path)];
 
-    ret = udpInit(&stateLink, NULL, 9003, true);
-    printf("start UDP server...%d\n", ret);
+        snprintf(path, sizeof(path), "%s.pwm", simSocket);
+        ret = udpInitUnix(&pwmLink, path, false);
+        printf("init PwmOut link %s...%d\n", path, ret);
 
-    ret = pthread_create(&udpWorker, NULL, udpThread, NULL);
-    if (ret != 0) {
-        printf("Create udpWorker error!\n");
-        exit(1);
+        snprintf(path, sizeof(path), "%s.state", simSocket);
+        ret = udpInitUnix(&stateLink, path, true);
+        printf("start state server %s...%d\n", path, ret);
+    } else if (!simReplay) {
+        ret = udpInit(&pwmLink, "127.0.0.1", SIM_PWM_PORT + simInstance * SIM_INSTANCE_PORTS, false);
+        printf("init PwmOut UDP link...%d\n", ret);
+
+        ret = udpInit(&stateLink, NULL, SIM_STATE_PORT + simInstance * SIM_INSTANCE_PORTS, true);
+        printf("start UDP server...%d\n", ret);
+    }
+
+    if (!simHeliModel && !simReplay) {
+        // in lockstep the main loop exchanges the packets itself
+        if (!simLockstep) {
+            ret = pthread_create(&udpWorker, NULL, udpThread, NULL);
+            if (ret != 0) {
+                printf("Create udpWorker error!\n");
+                exit(1);
+            }
+        }
     }
 
     // serial can't been slow down
@@ -251,7 +339,9 @@ void systemResetHard(void){
     printf("[system]Reset!\n");
     workerRunning = false;
     pthread_join(tcpWorker, NULL);
-    pthread_join(udpWorker, NULL);
+    if (!simHeliModel && !simReplay && !simLockstep) {
+        pthread_join(udpWorker, NULL);
+    }
     exit(0);
 }
 
@@ -296,6 +386,11 @@ uint64_t millis64_real() {
 uint64_t micros64() {
     static uint64_t last = 0;
     static uint64_t out = 0;
+
+    if (simLockstep) {
+        return simTimeUs;
+    }
+
     uint64_t now = nanos64_real();
 
     out += (now - last) * simRate;
@@ -308,6 +403,11 @@ uint64_t micros64() {
 uint64_t millis64() {
     static uint64_t last = 0;
     static uint64_t out = 0;
+
+    if (simLockstep) {
+        return simTimeUs / 1000;
+    }
+
     uint64_t now = nanos64_real();
 
     out += (now - last) * simRate;
@@ -352,6 +452,10 @@ void microsleep(uint32_t usec) {
 }
 
 void delayMicroseconds(uint32_t us) {
+    if (simLockstep) {
+        simTimeUs += us;
+        return;
+    }
     microsleep(us / simRate);
 }
 
@@ -360,6 +464,11 @@ void delayMicroseconds_real(uint32_t us) {
 }
 
 void delay(uint32_t ms) {
+    if (simLockstep) {
+        simTimeUs += ms * 1000ULL;
+        return;
+    }
+
     uint64_t start = millis64();
 
     while ((millis64() - start) < ms) {
@@ -367,6 +476,68 @@ void delay(uint32_t ms) {
     }
 }
 
+// Simulation part
+static void simulatorStepModel(uint64_t stepUs) {
+    heliModelStep(&fdmPkt, stepUs * 1e-6f);
+    applyState(&fdmPkt, stepUs * 1e-6);
+}
+
+// Called by the main loop after each scheduler pass
+void simulatorIdle(void) {
+    if (simDurationUs && micros64() >= simDurationUs) {
+        printf("[system]Simulation time is up\n");
+        systemResetHard();
+    }
+
+    if (!simLockstep) {
+        delayMicroseconds_real(50); // max rate 20kHz
+
+        if (simHeliModel) {
+            const uint64_t now = micros64();
+            simulatorStepModel(MIN(now - simStepUs, (uint64_t)20000));
+            simStepUs = now;
+        }
+        return;
+    }
+
+    // let the tasks due in this gyro cycle run before moving the time on
+    if (++simIdlePasses < SIM_LOCKSTEP_PASSES) {
+        return;
+    }
+    simIdlePasses = 0;
+
+    // step right onto the next gyro cycle, so the scheduler never waits for it
+    int32_t stepUs = cmpTimeCycles(schedulerGetNextTargetCycles(), getCycleCounter());
+    if (stepUs <= 0) {
+        stepUs = SIM_LOCKSTEP_MIN_STEP;
+    }
+
+    if (simReplay) {
+        // feed the log inputs due at the next gyro cycle
+        if (!replayUpdate(simTimeUs + stepUs)) {
+            systemResetHard();
+        }
+    } else if (simHeliModel) {
+        simulatorStepModel(stepUs);
+    } else {
+        udpSend(&pwmLink, &pwmPkt, sizeof(servo_packet));
+        if (udpRecv(&stateLink, &fdmPkt, sizeof(fdm_packet), SIM_LOCKSTEP_TIMEOUT) == sizeof(fdm_packet)) {
+            updateState(&fdmPkt);
+        }
+    }
+
+    simTimeUs += stepUs;
+}
+
+// the built-in model and the log spin the main motor and a tail motor
+bool simulatorHasMotorRpm(uint8_t motor) {
+    return (simHeliModel || simReplay) && motor < 2;
+}
+
+float simulatorGetMotorERPM(uint8_t motor) {
+    return simReplay ? replayGetMotorERPM(motor) : heliModelGetMotorERPM(motor);
+}
+
 // Subtract the ‘struct timespec’ values X and Y,  storing the result in RESULT.
 // Return 1 if the difference is negative, otherwise 0.
 // result = x - y
@@ -465,6 +636,9 @@ static void pwmCompleteMotorUpdate(void)
     pwmPkt.motor_speed[1] = motorsPwm[2] / outScale;
     pwmPkt.motor_speed[2] = motorsPwm[3] / outScale;
 
+    // the built-in model, replay and lockstep mode do their own updates
+    if (simHeliModel || simReplay || simLockstep) return;
+
     // get one "fdm_packet" can only send one "servo_packet"!!
     if (pthread_mutex_trylock(&updateLock) != 0) return;
     udpSend(&pwmLink, &pwmPkt, sizeof(servo_packet));
@@ -532,7 +706,7 @@ void FLASH_Unlock(void) {
     }
 
     // open or create
-    eepromFd = fopen(EEPROM_FILENAME,"r+");
+    eepromFd = fopen(eepromFileName,"r+");
     if (eepromFd != NULL) {
         // obtain file size:
         fseek(eepromFd , 0 , SEEK_END);
@@ -541,15 +715,15 @@ void FLASH_Unlock(void) {
 
         size_t n = fread(eepromData, 1, sizeof(eepromData), eepromFd);
         if (n == lSize) {
-            printf("[FLASH_Unlock] loaded '%s', size = %ld / %ld\n", EEPROM_FILENAME, lSize, sizeof(eepromData));
+            printf("[FLASH_Unlock] loaded '%s', size = %ld / %ld\n", eepromFileName, lSize, sizeof(eepromData));
         } else {
-            fprintf(stderr, "[FLASH_Unlock] failed to load '%s'\n", EEPROM_FILENAME);
+            fprintf(stderr, "[FLASH_Unlock] failed to load '%s'\n", eepromFileName);
             return;
         }
     } else {
-        printf("[FLASH_Unlock] created '%s', size = %ld\n", EEPROM_FILENAME, sizeof(eepromData));
-        if ((eepromFd = fopen(EEPROM_FILENAME, "w+")) == NULL) {
-            fprintf(stderr, "[FLASH_Unlock] failed to create '%s'\n", EEPROM_FILENAME);
+        printf("[FLASH_Unlock] created '%s', size = %ld\n", eepromFileName, sizeof(eepromData));
+        if ((eepromFd = fopen(eepromFileName, "w+")) == NULL) {
+            fprintf(stderr, "[FLASH_Unlock] failed to create '%s'\n", eepromFileName);
             return;
         }
         if (fwrite(eepromData, sizeof(eepromData), 1, eepromFd) != 1) {
@@ -565,7 +739,7 @@ void FLASH_Lock(void) {
         fwrite(eepromData, 1, sizeof(eepromData), eepromFd);
         fclose(eepromFd);
         eepromFd = NULL;
-        printf("[FLASH_Lock] saved '%s'\n", EEPROM_FILENAME);
+        printf("[FLASH_Lock] saved '%s'\n", eepromFileName);
     } else {
         fprintf(stderr, "[FLASH_Lock] eeprom is not unlocked\n");
     }
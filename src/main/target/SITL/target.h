@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 #include "common/utils.h"
 
@@ -260,4 +261,8 @@ uint64_t millis64(void);
 
 int lockMainPID(void);
 
+void simulatorIdle(void);
+bool simulatorHasMotorRpm(uint8_t motor);
+float simulatorGetMotorERPM(uint8_t motor);
+
 
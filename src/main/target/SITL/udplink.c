@@ -10,6 +10,7 @@
 #include <fcntl.h>
 #include <sys/socket.h>
 #include <sys/time.h>
+#include <unistd.h>
 
 #include "udplink.h"
 
@@ -24,6 +25,7 @@ int udpInit(udpLink_t* link, const char* addr, int port, bool isServer) {
     fcntl(link->fd, F_SETFL, fcntl(link->fd, F_GETFL, 0) | O_NONBLOCK); // nonblock
 
     link->isServer = isServer;
+    link->isUnix = false;
     memset(&link->si, 0, sizeof(link->si));
     link->si.sin_family = AF_INET;
     link->si.sin_port = htons(port);
@@ -43,7 +45,33 @@ int udpInit(udpLink_t* link, const char* addr, int port, bool isServer) {
     return 0;
 }
 
+// Same datagram link over a Unix domain socket, for simulators on the same host
+int udpInitUnix(udpLink_t* link, const char* path, bool isServer) {
+    if ((link->fd = socket(AF_UNIX, SOCK_DGRAM, 0)) == -1) {
+        return -2;
+    }
+
+    fcntl(link->fd, F_SETFL, fcntl(link->fd, F_GETFL, 0) | O_NONBLOCK); // nonblock
+
+    link->isServer = isServer;
+    link->isUnix = true;
+    memset(&link->su, 0, sizeof(link->su));
+    link->su.sun_family = AF_UNIX;
+    strncpy(link->su.sun_path, path, sizeof(link->su.sun_path) - 1);
+
+    if (isServer) {
+        unlink(link->su.sun_path); // left over from a previous run
+        if (bind(link->fd, (const struct sockaddr *)&link->su, sizeof(link->su)) == -1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
 int udpSend(udpLink_t* link, const void* data, size_t size) {
+    if (link->isUnix) {
+        return sendto(link->fd, data, size, 0, (struct sockaddr *)&link->su, sizeof(link->su));
+    }
     return sendto(link->fd, data, size, 0, (struct sockaddr *)&link->si, sizeof(link->si));
 }
 
@@ -61,7 +89,11 @@ int udpRecv(udpLink_t* link, void* data, size_t size, uint32_t timeout_ms) {
         return -1;
     }
 
-    socklen_t len;
+    if (link->isUnix) {
+        return recv(link->fd, data, size, 0);
+    }
+
+    socklen_t len = sizeof(link->recv);
     int ret;
     ret = recvfrom(link->fd, data, size, 0, (struct sockaddr *)&link->recv, &len);
     return ret;
@@ -14,6 +14,7 @@
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <sys/un.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -23,12 +24,15 @@ typedef struct {
     int fd;
     struct sockaddr_in si;
     struct sockaddr_in recv;
+    struct sockaddr_un su;
     int port;
     char* addr;
     bool isServer;
+    bool isUnix;
 } udpLink_t;
 
 int udpInit(udpLink_t* link, const char* addr, int port, bool isServer);
+int udpInitUnix(udpLink_t* link, const char* path, bool isServer);
 int udpRecv(udpLink_t* link, void* data, size_t size, uint32_t timeout_ms);
 int udpSend(udpLink_t* link, const void* data, size_t size);
 
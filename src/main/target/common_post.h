@@ -207,6 +207,7 @@
 
 #ifndef USE_FLASH_CHIP
 #undef USE_FLASHFS
+#undef USE_FLASH_LOG
 #endif
 
 #if (!defined(USE_SDCARD) && !defined(USE_FLASHFS)) || !defined(USE_BLACKBOX)
@@ -251,6 +252,15 @@
 #define USE_SPI_GYRO
 #endif
 
+// Queue DMA gyro samples between the SPI callback and the gyro task
+#if (defined(USE_SPI_GYRO) || defined(USE_ACCGYRO_BMI270)) && !defined(SIMULATOR_BUILD)
+#define USE_GYRO_SAMPLE_QUEUE
+#endif
+
+#if defined(USE_GYRO_SAMPLE_QUEUE) && (defined(USE_GYRO_SPI_ICM42605) || defined(USE_GYRO_SPI_ICM42688P) || defined(USE_ACCGYRO_BMI270))
+#define USE_GYRO_FIFO_BURST
+#endif
+
 // CX10 is a special case of SPI RX which requires XN297
 #if defined(USE_RX_CX10)
 #define USE_RX_XN297
@@ -346,6 +356,10 @@
 #undef USE_DMA_SPEC
 #endif
 
+#if !defined(USE_TIMER_DMA) || !defined(USE_PPM)
+#undef USE_PPM_DMA
+#endif
+
 #if !defined(USE_DMA_SPEC)
 #undef USE_TIMER_MGMT
 #endif
@@ -48,6 +48,9 @@
 #define USE_PERSISTENT_OBJECTS
 #define USE_CUSTOM_DEFAULTS_ADDRESS
 #define USE_LATE_TASK_STATISTICS
+#define USE_TASK_BUDGET_STATISTICS
+#define USE_LOOP_PROFILER
+#define USE_BENCHMARK
 
 #if defined(STM32F40_41xxx) || defined(STM32F411xE)
 #define USE_OVERCLOCK
@@ -75,6 +78,12 @@
 #define USE_PERSISTENT_OBJECTS
 #define USE_CUSTOM_DEFAULTS_ADDRESS
 #define USE_LATE_TASK_STATISTICS
+#define USE_TASK_BUDGET_STATISTICS
+#define USE_LOOP_PROFILER
+#define USE_BENCHMARK
+#define USE_SCHEDULER_TRACE
+#define USE_VIBRATION_ANALYSIS
+#define FLASHFS_WRITE_BUFFER_SIZE 2048
 #endif // STM32F7
 
 #ifdef STM32H7
@@ -98,6 +107,13 @@
 #define USE_PERSISTENT_MSC_RTC
 #define USE_DSHOT_CACHE_MGMT
 #define USE_LATE_TASK_STATISTICS
+#define USE_TASK_BUDGET_STATISTICS
+#define SDFT_SAMPLE_SIZE 128
+#define USE_LOOP_PROFILER
+#define USE_BENCHMARK
+#define USE_SCHEDULER_TRACE
+#define USE_VIBRATION_ANALYSIS
+#define FLASHFS_WRITE_BUFFER_SIZE 4096
 #endif
 
 #ifdef STM32G4
@@ -117,6 +133,9 @@
 #define USE_TIMER_MGMT
 #define USE_PERSISTENT_OBJECTS
 #define USE_LATE_TASK_STATISTICS
+#define USE_TASK_BUDGET_STATISTICS
+#define USE_LOOP_PROFILER
+#define USE_BENCHMARK
 #endif
 
 #if defined(STM32F4) || defined(STM32F7) || defined(STM32H7) || defined(STM32G4)
@@ -261,6 +280,12 @@ extern uint8_t _dmaram_end__;
 
 #if (TARGET_FLASH_SIZE > 128)
 #define USE_GYRO_OVERFLOW_CHECK
+#define USE_EVENT_LOG
+#define USE_BOOT_TIMELINE
+#define USE_LOOP_WATCHDOG
+#define USE_GOVERNOR_AUTOTUNE
+#define USE_SYSID
+#define USE_PPM_DMA
 #define USE_DSHOT_DMAR
 #define USE_SERIALRX_FPORT      // FrSky FPort
 #define USE_TELEMETRY_CRSF
@@ -377,6 +402,7 @@ extern uint8_t _dmaram_end__;
 #define USE_TELEMETRY_ENABLE_SENSORS
 #define USE_VTX_TABLE
 #define USE_PERSISTENT_STATS
+#define USE_FLASH_LOG
 #define USE_PROFILE_NAMES
 #define USE_SERIALRX_SRXL2     // Spektrum SRXL2 protocol
 #define USE_CUSTOM_BOX_NAMES
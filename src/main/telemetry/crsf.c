@@ -40,6 +40,7 @@
 #include "common/printf.h"
 #include "common/streambuf.h"
 #include "common/time.h"
+#include "common/typeconversion.h"
 #include "common/utils.h"
 
 #include "drivers/nvic.h"
@@ -78,7 +79,8 @@
 #include "crsf.h"
 
 
-#define CRSF_CYCLETIME_US                   100000 // 100ms, 10 Hz
+#define CRSF_TELEMETRY_SLOT_US              20000  // 20ms, 50 Hz
+#define CRSF_TELEMETRY_REFRESH_MAX_US       500000 // resend unchanged frames at 2 Hz
 #define CRSF_DEVICEINFO_VERSION             0x01
 #define CRSF_DEVICEINFO_PARAMETER_COUNT     0
 
@@ -99,8 +101,6 @@ static mspBuffer_t mspRxBuffer;
 
 #if defined(USE_CRSF_V3)
 
-#define CRSF_TELEMETRY_FRAME_INTERVAL_MAX_US 20000 // 20ms
-
 static bool isCrsfV3Running = false;
 typedef struct {
     uint8_t hasPendingReply:1;
@@ -171,33 +171,31 @@ bool bufferCrsfMspFrame(uint8_t *frameStart, int frameLength)
 bool handleCrsfMspFrameBuffer(mspResponseFnPtr responseFn)
 {
     static bool replyPending = false;
-    if (replyPending) {
-        if (crsfRxIsTelemetryBufEmpty()) {
-            replyPending = sendMspReply(CRSF_FRAME_TX_MSP_FRAME_SIZE, responseFn);
-        }
-        return replyPending;
-    }
-    if (!mspRxBuffer.len) {
-        return false;
-    }
-    int pos = 0;
-    while (true) {
-        const uint8_t mspFrameLength = mspRxBuffer.bytes[pos];
-        if (handleMspFrame(&mspRxBuffer.bytes[CRSF_MSP_LENGTH_OFFSET + pos], mspFrameLength, NULL)) {
-            if (crsfRxIsTelemetryBufEmpty()) {
-                replyPending = sendMspReply(CRSF_FRAME_TX_MSP_FRAME_SIZE, responseFn);
-            } else {
+
+    // Take in new request chunks also while a reply is going out.
+    // Requests completed meanwhile are queued behind it.
+    if (mspRxBuffer.len) {
+        int pos = 0;
+        bool done = false;
+        while (!done) {
+            const uint8_t mspFrameLength = mspRxBuffer.bytes[pos];
+            if (handleMspFrame(&mspRxBuffer.bytes[CRSF_MSP_LENGTH_OFFSET + pos], mspFrameLength, NULL)) {
                 replyPending = true;
             }
-        }
-        pos += CRSF_MSP_LENGTH_OFFSET + mspFrameLength;
-        ATOMIC_BLOCK(NVIC_PRIO_SERIALUART1) {
-            if (pos >= mspRxBuffer.len) {
-                mspRxBuffer.len = 0;
-                return replyPending;
+            pos += CRSF_MSP_LENGTH_OFFSET + mspFrameLength;
+            ATOMIC_BLOCK(NVIC_PRIO_SERIALUART1) {
+                if (pos >= mspRxBuffer.len) {
+                    mspRxBuffer.len = 0;
+                    done = true;
+                }
             }
         }
     }
+
+    if (replyPending && crsfRxIsTelemetryBufEmpty()) {
+        replyPending = sendMspReply(CRSF_FRAME_TX_MSP_FRAME_SIZE, responseFn);
+    }
+
     return replyPending;
 }
 #endif
@@ -360,17 +358,21 @@ static int8_t crsfGpsSatsReuse(uint8_t reuse, int8_t value)
 void crsfFrameGps(sbuf_t *dst)
 {
     // use sbufWrite since CRC does not include frame length
-    sbufWriteU8(dst, CRSF_FRAME_GPS_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE_CRC);
-    sbufWriteU8(dst, CRSF_FRAMETYPE_GPS);
-    sbufWriteU32BigEndian(dst, gpsSol.llh.lat); // CRSF and betaflight use same units for degrees
-    sbufWriteU32BigEndian(dst, gpsSol.llh.lon);
-    sbufWriteU16BigEndian(dst, crsfGpsReuse(telemetryConfig()->crsf_gps_ground_speed_reuse,
-        (gpsSol.groundSpeed * 36 + 50) / 100)); // gpsSol.groundSpeed is in cm/s
-    sbufWriteU16BigEndian(dst, crsfGpsReuse(telemetryConfig()->crsf_gps_heading_reuse,
-        gpsSol.groundCourse * 10)); // gpsSol.groundCourse is degrees * 10
-    sbufWriteU16BigEndian(dst, crsfGpsAltitudeReuse(telemetryConfig()->crsf_gps_altitude_reuse,
-        getEstimatedAltitudeCm()) + 1000);
-    sbufWriteU8(dst, crsfGpsSatsReuse(telemetryConfig()->crsf_gps_sats_reuse, gpsSol.numSat));
+    uint8_t *ptr = sbufReserve(dst, CRSF_FRAME_GPS_PAYLOAD_SIZE + 2);
+    if (ptr) {
+        ptr = sbufPutU8(ptr, CRSF_FRAME_GPS_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE_CRC);
+        ptr = sbufPutU8(ptr, CRSF_FRAMETYPE_GPS);
+        ptr = sbufPutU32BigEndian(ptr, gpsSol.llh.lat); // CRSF and betaflight use same units for degrees
+        ptr = sbufPutU32BigEndian(ptr, gpsSol.llh.lon);
+        ptr = sbufPutU16BigEndian(ptr, crsfGpsReuse(telemetryConfig()->crsf_gps_ground_speed_reuse,
+            (gpsSol.groundSpeed * 36 + 50) / 100)); // gpsSol.groundSpeed is in cm/s
+        ptr = sbufPutU16BigEndian(ptr, crsfGpsReuse(telemetryConfig()->crsf_gps_heading_reuse,
+            gpsSol.groundCourse * 10)); // gpsSol.groundCourse is degrees * 10
+        ptr = sbufPutU16BigEndian(ptr, crsfGpsAltitudeReuse(telemetryConfig()->crsf_gps_altitude_reuse,
+            getEstimatedAltitudeCm()) + 1000);
+        ptr = sbufPutU8(ptr, crsfGpsSatsReuse(telemetryConfig()->crsf_gps_sats_reuse, gpsSol.numSat));
+        sbufCommit(dst, ptr);
+    }
 }
 
 /*
@@ -384,20 +386,24 @@ uint8_t     Battery remaining ( percent )
 void crsfFrameBatterySensor(sbuf_t *dst)
 {
     // use sbufWrite since CRC does not include frame length
-    sbufWriteU8(dst, CRSF_FRAME_BATTERY_SENSOR_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE_CRC);
-    sbufWriteU8(dst, CRSF_FRAMETYPE_BATTERY_SENSOR);
-    if (telemetryConfig()->report_cell_voltage) {
-        sbufWriteU16BigEndian(dst, (getBatteryAverageCellVoltage() + 5) / 10); // vbat is in units of 0.01V
-    } else {
-        sbufWriteU16BigEndian(dst, getLegacyBatteryVoltage());
+    uint8_t *ptr = sbufReserve(dst, CRSF_FRAME_BATTERY_SENSOR_PAYLOAD_SIZE + 2);
+    if (ptr) {
+        ptr = sbufPutU8(ptr, CRSF_FRAME_BATTERY_SENSOR_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE_CRC);
+        ptr = sbufPutU8(ptr, CRSF_FRAMETYPE_BATTERY_SENSOR);
+        if (telemetryConfig()->report_cell_voltage) {
+            ptr = sbufPutU16BigEndian(ptr, (getBatteryAverageCellVoltage() + 5) / 10); // vbat is in units of 0.01V
+        } else {
+            ptr = sbufPutU16BigEndian(ptr, getLegacyBatteryVoltage());
+        }
+        ptr = sbufPutU16BigEndian(ptr, getLegacyBatteryCurrent());
+        const uint32_t mAhDrawn = getBatteryCapacityUsed();
+        const uint8_t batteryRemainingPercentage = calculateBatteryPercentageRemaining();
+        ptr = sbufPutU8(ptr, (mAhDrawn >> 16));
+        ptr = sbufPutU8(ptr, (mAhDrawn >> 8));
+        ptr = sbufPutU8(ptr, (uint8_t)mAhDrawn);
+        ptr = sbufPutU8(ptr, batteryRemainingPercentage);
+        sbufCommit(dst, ptr);
     }
-    sbufWriteU16BigEndian(dst, getLegacyBatteryCurrent());
-    const uint32_t mAhDrawn = getBatteryCapacityUsed();
-    const uint8_t batteryRemainingPercentage = calculateBatteryPercentageRemaining();
-    sbufWriteU8(dst, (mAhDrawn >> 16));
-    sbufWriteU8(dst, (mAhDrawn >> 8));
-    sbufWriteU8(dst, (uint8_t)mAhDrawn);
-    sbufWriteU8(dst, batteryRemainingPercentage);
 }
 
 /*
@@ -507,11 +513,15 @@ static int16_t crsfAttitudeReuse(uint8_t reuse, int attitude)
 // fill dst buffer with crsf-attitude telemetry frame
 void crsfFrameAttitude(sbuf_t *dst)
 {
-    sbufWriteU8(dst, CRSF_FRAME_ATTITUDE_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE_CRC);
-    sbufWriteU8(dst, CRSF_FRAMETYPE_ATTITUDE);
-    sbufWriteU16BigEndian(dst, crsfAttitudeReuse(telemetryConfig()->crsf_att_pitch_reuse, attitude.values.pitch));
-    sbufWriteU16BigEndian(dst, crsfAttitudeReuse(telemetryConfig()->crsf_att_roll_reuse, attitude.values.roll));
-    sbufWriteU16BigEndian(dst, crsfAttitudeReuse(telemetryConfig()->crsf_att_yaw_reuse, attitude.values.yaw));
+    uint8_t *ptr = sbufReserve(dst, CRSF_FRAME_ATTITUDE_PAYLOAD_SIZE + 2);
+    if (ptr) {
+        ptr = sbufPutU8(ptr, CRSF_FRAME_ATTITUDE_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE_CRC);
+        ptr = sbufPutU8(ptr, CRSF_FRAMETYPE_ATTITUDE);
+        ptr = sbufPutU16BigEndian(ptr, crsfAttitudeReuse(telemetryConfig()->crsf_att_pitch_reuse, attitude.values.pitch));
+        ptr = sbufPutU16BigEndian(ptr, crsfAttitudeReuse(telemetryConfig()->crsf_att_roll_reuse, attitude.values.roll));
+        ptr = sbufPutU16BigEndian(ptr, crsfAttitudeReuse(telemetryConfig()->crsf_att_yaw_reuse, attitude.values.yaw));
+        sbufCommit(dst, ptr);
+    }
 }
 
 /*
@@ -582,37 +592,37 @@ static void crsfGovernorInfo(char *buf)
 static void crsfHeadspeedInfo(char *buf)
 {
     int val = getHeadSpeed();
-    tfp_sprintf(buf, "%d", val);
+    fmtInt(buf, val, 0, 0);
 }
 
 static void crsfThrottleInfo(char *buf)
 {
     int val = lrintf(getGovernorOutput() * 100);
-    tfp_sprintf(buf, "%d", val);
+    fmtInt(buf, val, 0, 0);
 }
 
 static void crsfMCUTempInfo(char *buf)
 {
     int val = getCoreTemperatureCelsius();
-    tfp_sprintf(buf, "%d", val);
+    fmtInt(buf, val, 0, 0);
 }
 
 static void crsfMCULoadInfo(char *buf)
 {
     int val = getAverageCPULoadPercent();
-    tfp_sprintf(buf, "%d", val);
+    fmtInt(buf, val, 0, 0);
 }
 
 static void crsfSysLoadInfo(char *buf)
 {
     int val = getAverageSystemLoadPercent();
-    tfp_sprintf(buf, "%d", val);
+    fmtInt(buf, val, 0, 0);
 }
 
 static void crsfRTLoadInfo(char *buf)
 {
     int val = getMaxRealTimeLoadPercent();
-    tfp_sprintf(buf, "%d", val);
+    fmtInt(buf, val, 0, 0);
 }
 
 static void crsfESCTempInfo(char *buf)
@@ -620,7 +630,7 @@ static void crsfESCTempInfo(char *buf)
     escSensorData_t *escData = getEscSensorData(ESC_SENSOR_COMBINED);
     if (escData) {
         int val = escData->temperature / 10;
-        tfp_sprintf(buf, "%d", val);
+        fmtInt(buf, val, 0, 0);
     }
 }
 
@@ -630,7 +640,7 @@ static void crsfVoltageMetereInfo(char *buf, voltageMeterId_e id)
 
     if (voltageMeterRead(id, &meter)) {
         int val = meter.voltage / 10;
-        tfp_sprintf(buf, "%d.%02d", val / 100, val % 100);
+        fmtFixed(buf, val, 2);
     }
 }
 
@@ -639,7 +649,9 @@ static void crsfAdjFuncInfo(char *buf)
     if (getAdjustmentsRangeName()) {
         int fun = getAdjustmentsRangeFunc();
         int val = getAdjustmentsRangeValue();
-        tfp_sprintf(buf, "%d:%d", fun, val);
+        buf += fmtInt(buf, fun, 0, 0);
+        *buf++ = ':';
+        fmtInt(buf, val, 0, 0);
     }
 }
 
@@ -648,7 +660,9 @@ static void crsfGovAdjFuncInfo(char *buf)
     if (getAdjustmentsRangeName()) {
         int fun = getAdjustmentsRangeFunc();
         int val = getAdjustmentsRangeValue();
-        tfp_sprintf(buf, "%d:%d", fun, val);
+        buf += fmtInt(buf, fun, 0, 0);
+        *buf++ = ':';
+        fmtInt(buf, val, 0, 0);
     }
     else {
         crsfGovernorInfo(buf);
@@ -901,19 +915,33 @@ static void crsfFrameDisplayPortClear(sbuf_t *dst)
 
 #endif
 
-// schedule array to decide how often each type of frame is sent
+// frames shared between the telemetry slots
 typedef enum {
     CRSF_FRAME_START_INDEX = 0,
     CRSF_FRAME_ATTITUDE_INDEX = CRSF_FRAME_START_INDEX,
     CRSF_FRAME_BATTERY_SENSOR_INDEX,
     CRSF_FRAME_FLIGHT_MODE_INDEX,
     CRSF_FRAME_GPS_INDEX,
-    CRSF_FRAME_HEARTBEAT_INDEX,
     CRSF_SCHEDULE_COUNT_MAX
 } crsfFrameTypeIndex_e;
 
-static uint8_t crsfScheduleCount;
-static uint8_t crsfSchedule[CRSF_SCHEDULE_COUNT_MAX];
+// wanted refresh interval of each frame
+static const timeDelta_t crsfFrameInterval[CRSF_SCHEDULE_COUNT_MAX] = {
+    [CRSF_FRAME_ATTITUDE_INDEX]         = 50000,
+    [CRSF_FRAME_BATTERY_SENSOR_INDEX]   = 50000,
+    [CRSF_FRAME_FLIGHT_MODE_INDEX]      = 50000,
+    [CRSF_FRAME_GPS_INDEX]              = 100000,
+};
+
+// last frame sent of each type
+typedef struct {
+    timeUs_t lastSent;
+    uint8_t  len;
+    uint8_t  frame[CRSF_FRAME_SIZE_MAX];
+} crsfFrameCache_t;
+
+static uint8_t crsfScheduleMask;
+static crsfFrameCache_t crsfFrameCache[CRSF_SCHEDULE_COUNT_MAX];
 
 #if defined(USE_MSP_OVER_TELEMETRY)
 
@@ -942,52 +970,106 @@ static void crsfSendMspResponse(uint8_t *payload, const uint8_t payloadSize)
 }
 #endif
 
-static void processCrsf(void)
+static void crsfFrameEncode(sbuf_t *dst, crsfFrameTypeIndex_e index)
+{
+    switch (index) {
+        case CRSF_FRAME_ATTITUDE_INDEX:
+            crsfFrameAttitude(dst);
+            break;
+        case CRSF_FRAME_BATTERY_SENSOR_INDEX:
+            crsfFrameBatterySensor(dst);
+            break;
+        case CRSF_FRAME_FLIGHT_MODE_INDEX:
+            crsfFrameFlightMode(dst);
+            break;
+#ifdef USE_GPS
+        case CRSF_FRAME_GPS_INDEX:
+            crsfFrameGps(dst);
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
+/*
+ * Pick the frame for this telemetry slot.
+ *
+ * Each frame is rated by its age against its wanted interval, and the
+ * most overdue one is sent. A frame that was sent less than half its
+ * interval ago is not encoded at all. Frames whose encoding matches
+ * the one sent last are only repeated at CRSF_TELEMETRY_REFRESH_MAX_US,
+ * which leaves their slots to the values that are changing.
+ */
+static void processCrsf(timeUs_t currentTimeUs)
 {
     if (!crsfRxIsTelemetryBufEmpty()) {
         return; // do nothing if telemetry ouptut buffer is not empty yet.
     }
 
-    static uint8_t crsfScheduleIndex = 0;
-
-    const uint8_t currentSchedule = crsfSchedule[crsfScheduleIndex];
-
     sbuf_t crsfPayloadBuf;
     sbuf_t *dst = &crsfPayloadBuf;
 
-    if (currentSchedule & BIT(CRSF_FRAME_ATTITUDE_INDEX)) {
-        crsfInitializeFrame(dst);
-        crsfFrameAttitude(dst);
-        crsfFinalize(dst);
-    }
-    if (currentSchedule & BIT(CRSF_FRAME_BATTERY_SENSOR_INDEX)) {
-        crsfInitializeFrame(dst);
-        crsfFrameBatterySensor(dst);
-        crsfFinalize(dst);
-    }
+    uint8_t bestFrame[CRSF_FRAME_SIZE_MAX];
+    uint8_t bestLen = 0;
+    uint32_t bestScore = 0;
+    int bestIndex = -1;
+
+    for (int index = CRSF_FRAME_START_INDEX; index < CRSF_SCHEDULE_COUNT_MAX; index++) {
+        if (!(crsfScheduleMask & BIT(index))) {
+            continue;
+        }
+
+        crsfFrameCache_t *cache = &crsfFrameCache[index];
+
+        timeDelta_t elapsed = cmpTimeUs(currentTimeUs, cache->lastSent);
+        if (elapsed < 0 || elapsed > CRSF_TELEMETRY_REFRESH_MAX_US) {
+            elapsed = CRSF_TELEMETRY_REFRESH_MAX_US;
+        }
+
+        if (elapsed < crsfFrameInterval[index] / 2) {
+            continue;
+        }
 
-    if (currentSchedule & BIT(CRSF_FRAME_FLIGHT_MODE_INDEX)) {
         crsfInitializeFrame(dst);
-        crsfFrameFlightMode(dst);
-        crsfFinalize(dst);
+        crsfFrameEncode(dst, index);
+
+        const uint8_t len = sbufPtr(dst) - crsfFrame;
+        const bool changed = (len != cache->len || memcmp(crsfFrame, cache->frame, len) != 0);
+
+        if (!changed && elapsed < CRSF_TELEMETRY_REFRESH_MAX_US) {
+            continue;
+        }
+
+        const uint32_t score = (uint32_t)elapsed * 100 / crsfFrameInterval[index];
+
+        if (score > bestScore) {
+            memcpy(bestFrame, crsfFrame, len);
+            bestLen = len;
+            bestScore = score;
+            bestIndex = index;
+        }
     }
-#ifdef USE_GPS
-    if (currentSchedule & BIT(CRSF_FRAME_GPS_INDEX)) {
+
+    if (bestIndex >= 0) {
+        crsfFrameCache_t *cache = &crsfFrameCache[bestIndex];
+
+        memcpy(cache->frame, bestFrame, bestLen);
+        cache->len = bestLen;
+        cache->lastSent = currentTimeUs;
+
         crsfInitializeFrame(dst);
-        crsfFrameGps(dst);
+        sbufWriteData(dst, &bestFrame[1], bestLen - 1);
         crsfFinalize(dst);
     }
-#endif
-
 #if defined(USE_CRSF_V3)
-    if (currentSchedule & BIT(CRSF_FRAME_HEARTBEAT_INDEX)) {
+    else {
+        // keep telemetry/heartbeat frames going at 50Hz
         crsfInitializeFrame(dst);
         crsfFrameHeartbeat(dst);
         crsfFinalize(dst);
     }
 #endif
-
-    crsfScheduleIndex = (crsfScheduleIndex + 1) % crsfScheduleCount;
 }
 
 void crsfScheduleDeviceInfoResponse(void)
@@ -1010,16 +1092,18 @@ void initCrsfTelemetry(void)
     mspReplyPending = false;
 #endif
 
-    int index = 0;
+    crsfScheduleMask = 0;
+    memset(crsfFrameCache, 0, sizeof(crsfFrameCache));
+
     if (sensors(SENSOR_ACC) && telemetryIsSensorEnabled(SENSOR_PITCH | SENSOR_ROLL | SENSOR_HEADING)) {
-        crsfSchedule[index++] = BIT(CRSF_FRAME_ATTITUDE_INDEX);
+        crsfScheduleMask |= BIT(CRSF_FRAME_ATTITUDE_INDEX);
     }
     if ((isBatteryVoltageConfigured() && telemetryIsSensorEnabled(SENSOR_VOLTAGE))
         || (isBatteryCurrentConfigured() && telemetryIsSensorEnabled(SENSOR_CURRENT | SENSOR_FUEL))) {
-        crsfSchedule[index++] = BIT(CRSF_FRAME_BATTERY_SENSOR_INDEX);
+        crsfScheduleMask |= BIT(CRSF_FRAME_BATTERY_SENSOR_INDEX);
     }
     if (telemetryIsSensorEnabled(SENSOR_MODE)) {
-        crsfSchedule[index++] = BIT(CRSF_FRAME_FLIGHT_MODE_INDEX);
+        crsfScheduleMask |= BIT(CRSF_FRAME_FLIGHT_MODE_INDEX);
     }
 #ifdef USE_GPS
     if ((featureIsEnabled(FEATURE_GPS)
@@ -1028,19 +1112,10 @@ void initCrsfTelemetry(void)
        || telemetryConfig()->crsf_gps_heading_reuse
        || telemetryConfig()->crsf_gps_altitude_reuse
        || telemetryConfig()->crsf_gps_sats_reuse) {
-        crsfSchedule[index++] = BIT(CRSF_FRAME_GPS_INDEX);
+        crsfScheduleMask |= BIT(CRSF_FRAME_GPS_INDEX);
     }
 #endif
 
-#if defined(USE_CRSF_V3)
-    while (index < (CRSF_CYCLETIME_US / CRSF_TELEMETRY_FRAME_INTERVAL_MAX_US) && index < CRSF_SCHEDULE_COUNT_MAX) {
-        // schedule heartbeat to ensure that telemetry/heartbeat frames are sent at minimum 50Hz
-        crsfSchedule[index++] = BIT(CRSF_FRAME_HEARTBEAT_INDEX);
-    }
-#endif
-
-    crsfScheduleCount = (uint8_t)index;
-
 #if defined(USE_CRSF_CMS_TELEMETRY)
     crsfDisplayportRegister();
 #endif
@@ -1175,11 +1250,10 @@ void handleCrsfTelemetry(timeUs_t currentTimeUs)
     }
 #endif
 
-    // Actual telemetry data only needs to be sent at a low frequency, ie 10Hz
-    // Spread out scheduled frames evenly so each frame is sent at the same frequency.
-    if (currentTimeUs >= crsfLastCycleTime + (CRSF_CYCLETIME_US / crsfScheduleCount)) {
+    // Telemetry frames are sent in fixed slots, the scheduler picks one frame per slot
+    if (cmpTimeUs(currentTimeUs, crsfLastCycleTime) >= CRSF_TELEMETRY_SLOT_US) {
         crsfLastCycleTime = currentTimeUs;
-        processCrsf();
+        processCrsf(currentTimeUs);
     }
 }
 
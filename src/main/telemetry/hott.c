@@ -112,6 +112,7 @@ static uint32_t lastHottAlarmSoundTime = 0;
 static bool hottIsSending = false;
 
 static uint8_t *hottMsg = NULL;
+static const uint8_t *hottMsgFrame = NULL;
 static uint8_t hottMsgRemainingBytesToSendCount;
 static uint8_t hottMsgCrc;
 
@@ -126,8 +127,10 @@ static const serialPortConfig_t *portConfig;
 static bool hottTelemetryEnabled =  false;
 static portSharing_e hottPortSharing;
 
-static HOTT_GPS_MSG_t hottGPSMessage;
-static HOTT_EAM_MSG_t hottEAMMessage;
+// Double buffered, so that a frame is never updated while it is sent
+static HOTT_GPS_MSG_t hottGPSMessage[2];
+static HOTT_EAM_MSG_t hottEAMMessage[2];
+static uint8_t hottMessageIndex = 0;
 
 #if defined (USE_HOTT_TEXTMODE) && defined (USE_CMS)
 static hottTextModeMsg_t hottTextModeMessage;
@@ -172,10 +175,12 @@ static void initialiseGPSMessage(HOTT_GPS_MSG_t *msg, size_t size)
 
 static void initialiseMessages(void)
 {
-    initialiseEAMMessage(&hottEAMMessage, sizeof(hottEAMMessage));
+    for (int i = 0; i < 2; i++) {
+        initialiseEAMMessage(&hottEAMMessage[i], sizeof(hottEAMMessage[i]));
 #ifdef USE_GPS
-    initialiseGPSMessage(&hottGPSMessage, sizeof(hottGPSMessage));
+        initialiseGPSMessage(&hottGPSMessage[i], sizeof(hottGPSMessage[i]));
 #endif
+    }
 #if defined (USE_HOTT_TEXTMODE) && defined (USE_CMS)
     initialiseTextmodeMessage(&hottTextModeMessage);
 #endif
@@ -440,24 +445,38 @@ static void hottSendResponse(uint8_t *buffer, int length)
     }
 
     hottMsg = buffer;
+    hottMsgFrame = buffer;
     hottMsgRemainingBytesToSendCount = length + HOTT_CRC_SIZE;
 }
 
 static inline void hottSendGPSResponse(void)
 {
-    hottSendResponse((uint8_t *)&hottGPSMessage, sizeof(hottGPSMessage));
+    hottSendResponse((uint8_t *)&hottGPSMessage[hottMessageIndex], sizeof(HOTT_GPS_MSG_t));
 }
 
 static inline void hottSendEAMResponse(void)
 {
-    hottSendResponse((uint8_t *)&hottEAMMessage, sizeof(hottEAMMessage));
+    hottSendResponse((uint8_t *)&hottEAMMessage[hottMessageIndex], sizeof(HOTT_EAM_MSG_t));
 }
 
-static void hottPrepareMessages(void) {
-    hottPrepareEAMResponse(&hottEAMMessage);
+static bool hottPrepareMessages(void)
+{
+    const uint8_t spare = hottMessageIndex ^ 1;
+
+    // A frame from the spare buffer may still be going out
+    if (hottMsgRemainingBytesToSendCount > 0 &&
+        (hottMsgFrame == (uint8_t *)&hottEAMMessage[spare] || hottMsgFrame == (uint8_t *)&hottGPSMessage[spare])) {
+        return false;
+    }
+
+    // Build the frames ahead of the requests, which then only start the transmit
+    hottPrepareEAMResponse(&hottEAMMessage[spare]);
 #ifdef USE_GPS
-    hottPrepareGPSResponse(&hottGPSMessage);
+    hottPrepareGPSResponse(&hottGPSMessage[spare]);
 #endif
+    hottMessageIndex = spare;
+
+    return true;
 }
 
 #if defined (USE_HOTT_TEXTMODE) && defined (USE_CMS)
@@ -688,8 +707,7 @@ void handleHoTTTelemetry(timeUs_t currentTimeUs)
         return;
     }
 
-    if (shouldPrepareHoTTMessages(currentTimeUs)) {
-        hottPrepareMessages();
+    if (shouldPrepareHoTTMessages(currentTimeUs) && hottPrepareMessages()) {
         lastMessagesPreparedAt = currentTimeUs;
     }
 
@@ -106,24 +106,26 @@ void initIbusTelemetry(void)
 
 void handleIbusTelemetry(void)
 {
-    if (!ibusTelemetryEnabled) {
-        return;
-    }
+    if (ibusTelemetryEnabled) {
+        while (serialRxBytesWaiting(ibusSerialPort) > 0) {
+            uint8_t c = serialRead(ibusSerialPort);
 
-    while (serialRxBytesWaiting(ibusSerialPort) > 0) {
-        uint8_t c = serialRead(ibusSerialPort);
+            if (outboundBytesToIgnoreOnRxCount) {
+                outboundBytesToIgnoreOnRxCount--;
+                continue;
+            }
 
-        if (outboundBytesToIgnoreOnRxCount) {
-            outboundBytesToIgnoreOnRxCount--;
-            continue;
-        }
+            pushOntoTail(ibusReceiveBuffer, IBUS_RX_BUF_LEN, c);
 
-        pushOntoTail(ibusReceiveBuffer, IBUS_RX_BUF_LEN, c);
-
-        if (isChecksumOkIa6b(ibusReceiveBuffer, IBUS_RX_BUF_LEN)) {
-            outboundBytesToIgnoreOnRxCount += respondToIbusRequest(ibusReceiveBuffer);
+            if (isChecksumOkIa6b(ibusReceiveBuffer, IBUS_RX_BUF_LEN)) {
+                outboundBytesToIgnoreOnRxCount += respondToIbusRequest(ibusReceiveBuffer);
+            }
         }
     }
+
+    // Encode the values after answering, so that a poll never waits for it.
+    // When the port is shared with serial RX, the polls are answered from there.
+    updateIbusTelemetry();
 }
 
 
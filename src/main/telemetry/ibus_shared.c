@@ -31,6 +31,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <limits.h>
 
 #include "platform.h"
@@ -125,10 +126,19 @@ const uint8_t FULL_ACC_IDS[] = {
 
 #endif //defined(USE_TELEMETRY_IBUS_EXTENDED)
 
+typedef struct {
+    uint8_t sensorType;
+    uint8_t length;
+    uint8_t data[IBUS_BUFFSIZE - IBUS_HEADER_FOOTER_SIZE];
+} ibusSensorCache_t;
+
 static serialPort_t *ibusSerialPort = NULL;
 static ibusAddress_t ibusBaseAddress = INVALID_IBUS_ADDRESS;
 static uint8_t sendBuffer[IBUS_BUFFSIZE];
 
+// Encoded measurements, refreshed from the telemetry task
+static ibusSensorCache_t sensorCache[IBUS_SENSOR_COUNT];
+
 
 static void setValue(uint8_t* bufferPtr, uint8_t sensorType, uint8_t length);
 
@@ -425,13 +435,26 @@ static void setValue(uint8_t* bufferPtr, uint8_t sensorType, uint8_t length)
         bufferPtr[i] = value.byte[i];
     }
 }
+static void updateSensorCache(ibusSensorCache_t *cache, uint8_t sensorType)
+{
+    cache->length = getSensorLength(sensorType);
+    setValue(cache->data, sensorType, cache->length);
+    cache->sensorType = sensorType;
+}
+
 static void setIbusMeasurement(ibusAddress_t address)
 {
     uint8_t sensorID = getSensorID(address);
-    uint8_t sensorLength = getSensorLength(sensorID);
-    sendBuffer[0] = IBUS_HEADER_FOOTER_SIZE + sensorLength;
+    ibusSensorCache_t *cache = &sensorCache[address - ibusBaseAddress];
+
+    // Only before the first refresh, or after a sensor change
+    if (cache->sensorType != sensorID) {
+        updateSensorCache(cache, sensorID);
+    }
+
+    sendBuffer[0] = IBUS_HEADER_FOOTER_SIZE + cache->length;
     sendBuffer[1] = IBUS_COMMAND_MEASUREMENT | address;
-    setValue(sendBuffer + 2, sensorID, sensorLength);
+    memcpy(sendBuffer + 2, cache->data, cache->length);
 }
 
 static bool isCommand(ibusCommand_e expected, const uint8_t *ibusPacket)
@@ -484,6 +507,21 @@ void initSharedIbusTelemetry(serialPort_t *port)
 {
     ibusSerialPort = port;
     ibusBaseAddress = INVALID_IBUS_ADDRESS;
+    memset(sensorCache, 0, sizeof(sensorCache));
+}
+
+void updateIbusTelemetry(void)
+{
+    if (!ibusSerialPort) {
+        return;
+    }
+
+    for (unsigned i = 0; i < IBUS_SENSOR_COUNT; i++) {
+        const uint8_t sensorType = telemetryConfig()->flysky_sensors[i];
+        if (sensorType != IBUS_SENSOR_TYPE_NONE) {
+            updateSensorCache(&sensorCache[i], sensorType);
+        }
+    }
 }
 
 
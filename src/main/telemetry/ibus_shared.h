@@ -82,6 +82,7 @@ typedef enum {
 
 uint8_t respondToIbusRequest(uint8_t const * const ibusPacket);
 void initSharedIbusTelemetry(serialPort_t * port);
+void updateIbusTelemetry(void);
 
 #endif //defined(TELEMETRY) && defined(TELEMETRY_IBUS)
 
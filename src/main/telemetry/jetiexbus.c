@@ -175,10 +175,12 @@ union{
 
 static uint8_t jetiExBusTelemetryFrame[40];
 static uint8_t jetiExBusTransceiveState = EXBUS_TRANS_RX;
+static bool jetiExBusFrameReady = false;
 static uint8_t firstActiveSensor = 0;
 static uint32_t exSensorEnabled = 0;
 
-static uint8_t sendJetiExBusTelemetry(uint8_t packetID, uint8_t item);
+static uint8_t prepareJetiExBusTelemetry(uint8_t item);
+static void sendJetiExBusTelemetry(uint8_t packetID);
 static uint8_t getNextActiveSensor(uint8_t currentSensor);
 
 // Jeti Ex Telemetry CRC calculations for a frame
@@ -478,6 +480,13 @@ void handleJetiExBusTelemetry(void)
     static uint8_t item = 0;
     uint32_t timeDiff;
 
+    // Build the next frame between requests, so that a request is
+    // answered by only stamping the packet ID and starting the transmit
+    if (!jetiExBusFrameReady && jetiExBusTransceiveState == EXBUS_TRANS_RX) {
+        item = prepareJetiExBusTelemetry(item);
+        jetiExBusFrameReady = true;
+    }
+
     // Check if we shall reset frame position due to time
     if (jetiExBusRequestState == EXBUS_STATE_RECEIVED) {
 
@@ -491,9 +500,9 @@ void handleJetiExBusTelemetry(void)
         }
 
         if ((jetiExBusRequestFrame[EXBUS_HEADER_DATA_ID] == EXBUS_EX_REQUEST) && (jetiExBusCalcCRC16(jetiExBusRequestFrame, jetiExBusRequestFrame[EXBUS_HEADER_MSG_LEN]) == 0)) {
-            if (serialRxBytesWaiting(jetiExBusPort) == 0) {
+            if (serialRxBytesWaiting(jetiExBusPort) == 0 && jetiExBusFrameReady) {
                 jetiExBusTransceiveState = EXBUS_TRANS_TX;
-                item = sendJetiExBusTelemetry(jetiExBusRequestFrame[EXBUS_HEADER_PACKET_ID], item);
+                sendJetiExBusTelemetry(jetiExBusRequestFrame[EXBUS_HEADER_PACKET_ID]);
                 jetiExBusRequestState = EXBUS_STATE_PROCESSED;
                 return;
             }
@@ -512,7 +521,7 @@ void handleJetiExBusTelemetry(void)
     }
 }
 
-uint8_t sendJetiExBusTelemetry(uint8_t packetID, uint8_t item)
+uint8_t prepareJetiExBusTelemetry(uint8_t item)
 {
     static uint8_t sensorDescriptionCounter = 0xFF;
     static uint8_t requestLoop = 0xFF;
@@ -530,7 +539,6 @@ uint8_t sendJetiExBusTelemetry(uint8_t packetID, uint8_t item)
         }
 
         createExTelemetryTextMessage(jetiExTelemetryFrame, sensorDescriptionCounter, &jetiExSensors[sensorDescriptionCounter]);
-        createExBusMessage(jetiExBusTelemetryFrame, jetiExTelemetryFrame, packetID);
         requestLoop--;
         if (requestLoop == 0) {
             item = firstActiveSensor;
@@ -541,7 +549,6 @@ uint8_t sendJetiExBusTelemetry(uint8_t packetID, uint8_t item)
         }
     } else {
         item = createExTelemetryValueMessage(jetiExTelemetryFrame, item);
-        createExBusMessage(jetiExBusTelemetryFrame, jetiExTelemetryFrame, packetID);
 
         if (!allSensorsActive) {
             if (sensors(SENSOR_GPS)) {
@@ -551,9 +558,17 @@ uint8_t sendJetiExBusTelemetry(uint8_t packetID, uint8_t item)
         }
     }
 
+    return item;
+}
+
+void sendJetiExBusTelemetry(uint8_t packetID)
+{
+    // The packet ID is covered by the Ex Bus CRC, so only that is left to do
+    createExBusMessage(jetiExBusTelemetryFrame, &jetiExBusTelemetryFrame[EXBUS_HEADER_DATA], packetID);
+
+    // The frame is copied into the TX buffer and sent from the UART interrupt
     serialWriteBuf(jetiExBusPort, jetiExBusTelemetryFrame, jetiExBusTelemetryFrame[EXBUS_HEADER_MSG_LEN]);
     jetiExBusTransceiveState = EXBUS_TRANS_IS_TX_COMPLETED;
-
-    return item;
+    jetiExBusFrameReady = false;
 }
 #endif
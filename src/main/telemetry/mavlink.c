@@ -70,6 +70,9 @@
 #include "telemetry/telemetry.h"
 #include "telemetry/mavlink.h"
 
+// Only one link, don't reserve parser state for more
+#define MAVLINK_COMM_NUM_BUFFERS 1
+
 // mavlink library uses unnames unions that's causes GCC to complain if -Wpedantic is used
 // until this is resolved in mavlink library - ignore -Wpedantic for mavlink code
 #pragma GCC diagnostic push
@@ -77,9 +80,13 @@
 #include "common/mavlink.h"
 #pragma GCC diagnostic pop
 
-#define TELEMETRY_MAVLINK_INITIAL_PORT_MODE MODE_TX
-#define TELEMETRY_MAVLINK_MAXRATE 50
-#define TELEMETRY_MAVLINK_DELAY ((1000 * 1000) / TELEMETRY_MAVLINK_MAXRATE)
+#define TELEMETRY_MAVLINK_INITIAL_PORT_MODE MODE_RXTX
+#define TELEMETRY_MAVLINK_MAXRATE 100U
+
+// Not in the bundled message set
+#define MAV_CMD_SET_MESSAGE_INTERVAL 511
+
+#define MAVLINK_FRAME_LEN(payload) (MAVLINK_NUM_NON_PAYLOAD_BYTES + (payload))
 
 extern uint16_t rssi; // FIXME dependency on mw.c
 
@@ -87,51 +94,17 @@ static serialPort_t *mavlinkPort = NULL;
 static const serialPortConfig_t *portConfig;
 
 static bool mavlinkTelemetryEnabled =  false;
+static bool mavlinkReceiveEnabled = false;
 static portSharing_e mavlinkPortSharing;
 
-/* MAVLink datastream rates in Hz */
-static const uint8_t mavRates[] = {
-    [MAV_DATA_STREAM_EXTENDED_STATUS] = 2, //2Hz
-    [MAV_DATA_STREAM_RC_CHANNELS] = 5, //5Hz
-    [MAV_DATA_STREAM_POSITION] = 2, //2Hz
-    [MAV_DATA_STREAM_EXTRA1] = 10, //10Hz
-    [MAV_DATA_STREAM_EXTRA2] = 10 //2Hz
-};
-
-#define MAXSTREAMS (sizeof(mavRates) / sizeof(mavRates[0]))
-
-static uint8_t mavTicks[MAXSTREAMS];
 static mavlink_message_t mavMsg;
-static uint8_t mavBuffer[MAVLINK_MAX_PACKET_LEN];
-static uint32_t lastMavlinkMessage = 0;
-
-static int mavlinkStreamTrigger(enum MAV_DATA_STREAM streamNum)
-{
-    uint8_t rate = (uint8_t) mavRates[streamNum];
-    if (rate == 0) {
-        return 0;
-    }
-
-    if (mavTicks[streamNum] == 0) {
-        // we're triggering now, setup the next trigger point
-        if (rate > TELEMETRY_MAVLINK_MAXRATE) {
-            rate = TELEMETRY_MAVLINK_MAXRATE;
-        }
-
-        mavTicks[streamNum] = (TELEMETRY_MAVLINK_MAXRATE / rate);
-        return 1;
-    }
+static mavlink_message_t mavRxMsg;
 
-    // count down at TASK_RATE_HZ
-    mavTicks[streamNum]--;
-    return 0;
-}
-
-
-static void mavlinkSerialWrite(uint8_t * buf, uint16_t length)
+static void mavlinkSendMessage(void)
 {
-    for (int i = 0; i < length; i++)
-        serialWrite(mavlinkPort, buf[i]);
+    // The pack functions leave the whole frame, checksum included,
+    // contiguous from the magic byte. Copy it straight into the TX buffer.
+    serialWriteBuf(mavlinkPort, &mavMsg.magic, MAVLINK_FRAME_LEN(mavMsg.len));
 }
 
 static int16_t headingOrScaledMilliAmpereHoursDrawn(void)
@@ -150,6 +123,7 @@ void freeMAVLinkTelemetryPort(void)
     closeSerialPort(mavlinkPort);
     mavlinkPort = NULL;
     mavlinkTelemetryEnabled = false;
+    mavlinkReceiveEnabled = false;
 }
 
 void initMAVLinkTelemetry(void)
@@ -177,6 +151,7 @@ void configureMAVLinkTelemetryPort(void)
     }
 
     mavlinkTelemetryEnabled = true;
+    mavlinkReceiveEnabled = true;
 }
 
 void checkMAVLinkTelemetryState(void)
@@ -185,6 +160,8 @@ void checkMAVLinkTelemetryState(void)
         if (!mavlinkTelemetryEnabled && telemetrySharedPort != NULL) {
             mavlinkPort = telemetrySharedPort;
             mavlinkTelemetryEnabled = true;
+            // The serial RX driver owns the input
+            mavlinkReceiveEnabled = false;
         }
     } else {
         bool newTelemetryEnabledValue = telemetryDetermineEnabledState(mavlinkPortSharing);
@@ -202,8 +179,6 @@ void checkMAVLinkTelemetryState(void)
 
 void mavlinkSendSystemStatus(void)
 {
-    uint16_t msgLength;
-
     uint32_t onboardControlAndSensors = 35843;
 
     /*
@@ -261,13 +236,11 @@ void mavlinkSendSystemStatus(void)
         0,
         // errors_count4 Autopilot-specific errors
         0);
-    msgLength = mavlink_msg_to_send_buffer(mavBuffer, &mavMsg);
-    mavlinkSerialWrite(mavBuffer, msgLength);
+    mavlinkSendMessage();
 }
 
 void mavlinkSendRCChannelsAndRSSI(void)
 {
-    uint16_t msgLength;
     mavlink_msg_rc_channels_raw_pack(0, 200, &mavMsg,
         // time_boot_ms Timestamp (milliseconds since system boot)
         millis(),
@@ -291,14 +264,12 @@ void mavlinkSendRCChannelsAndRSSI(void)
         (activeRcChannelCount >= 8) ? rcInput[7] : 0,
         // rssi Receive signal strength indicator, 0: 0%, 254: 100%
         scaleRange(getRssi(), 0, RSSI_MAX_VALUE, 0, 254));
-    msgLength = mavlink_msg_to_send_buffer(mavBuffer, &mavMsg);
-    mavlinkSerialWrite(mavBuffer, msgLength);
+    mavlinkSendMessage();
 }
 
 #if defined(USE_GPS)
 void mavlinkSendPosition(void)
 {
-    uint16_t msgLength;
     uint8_t gpsFixType = 0;
 
     if (!sensors(SENSOR_GPS))
@@ -337,8 +308,7 @@ void mavlinkSendPosition(void)
         gpsSol.groundCourse * 10,
         // satellites_visible Number of satellites visible. If unknown, set to 255
         gpsSol.numSat);
-    msgLength = mavlink_msg_to_send_buffer(mavBuffer, &mavMsg);
-    mavlinkSerialWrite(mavBuffer, msgLength);
+    mavlinkSendMessage();
 
     // Global position
     mavlink_msg_global_position_int_pack(0, 200, &mavMsg,
@@ -361,8 +331,7 @@ void mavlinkSendPosition(void)
         // heading Current heading in degrees, in compass units (0..360, 0=north)
         headingOrScaledMilliAmpereHoursDrawn()
     );
-    msgLength = mavlink_msg_to_send_buffer(mavBuffer, &mavMsg);
-    mavlinkSerialWrite(mavBuffer, msgLength);
+    mavlinkSendMessage();
 
     mavlink_msg_gps_global_origin_pack(0, 200, &mavMsg,
         // latitude Latitude (WGS84), expressed as * 1E7
@@ -371,14 +340,12 @@ void mavlinkSendPosition(void)
         GPS_home[GPS_LONGITUDE],
         // altitude Altitude(WGS84), expressed as * 1000
         0);
-    msgLength = mavlink_msg_to_send_buffer(mavBuffer, &mavMsg);
-    mavlinkSerialWrite(mavBuffer, msgLength);
+    mavlinkSendMessage();
 }
 #endif
 
 void mavlinkSendAttitude(void)
 {
-    uint16_t msgLength;
     mavlink_msg_attitude_pack(0, 200, &mavMsg,
         // time_boot_ms Timestamp (milliseconds since system boot)
         millis(),
@@ -389,18 +356,46 @@ void mavlinkSendAttitude(void)
         // yaw Yaw angle (rad)
         DECIDEGREES_TO_RADIANS(attitude.values.yaw),
         // rollspeed Roll angular speed (rad/s)
-        0,
+        DEGREES_TO_RADIANS(gyro.gyroADCf[FD_ROLL]),
         // pitchspeed Pitch angular speed (rad/s)
-        0,
+        DEGREES_TO_RADIANS(-gyro.gyroADCf[FD_PITCH]),
         // yawspeed Yaw angular speed (rad/s)
+        DEGREES_TO_RADIANS(-gyro.gyroADCf[FD_YAW]));
+    mavlinkSendMessage();
+}
+
+void mavlinkSendImu(void)
+{
+    // Body frame is front-right-down, as in the attitude message
+    const float accScale = 1000 * acc.dev.acc_1G_rec;
+    const float gyroScale = 1000 * (M_PIf / 180);
+
+    mavlink_msg_scaled_imu_pack(0, 200, &mavMsg,
+        // time_boot_ms Timestamp (milliseconds since system boot)
+        millis(),
+        // xacc X acceleration (mg)
+        lrintf(acc.accADC[X] * accScale),
+        // yacc Y acceleration (mg)
+        lrintf(-acc.accADC[Y] * accScale),
+        // zacc Z acceleration (mg)
+        lrintf(-acc.accADC[Z] * accScale),
+        // xgyro Angular speed around X axis (millirad /sec)
+        lrintf(gyro.gyroADCf[FD_ROLL] * gyroScale),
+        // ygyro Angular speed around Y axis (millirad /sec)
+        lrintf(-gyro.gyroADCf[FD_PITCH] * gyroScale),
+        // zgyro Angular speed around Z axis (millirad /sec)
+        lrintf(-gyro.gyroADCf[FD_YAW] * gyroScale),
+        // xmag X Magnetic field (milli tesla)
+        0,
+        // ymag Y Magnetic field (milli tesla)
+        0,
+        // zmag Z Magnetic field (milli tesla)
         0);
-    msgLength = mavlink_msg_to_send_buffer(mavBuffer, &mavMsg);
-    mavlinkSerialWrite(mavBuffer, msgLength);
+    mavlinkSendMessage();
 }
 
 void mavlinkSendHUDAndHeartbeat(void)
 {
-    uint16_t msgLength;
     float mavAltitude = 0;
     float mavGroundSpeed = 0;
     float mavAirSpeed = 0;
@@ -428,8 +423,7 @@ void mavlinkSendHUDAndHeartbeat(void)
         mavAltitude,
         // climb Current climb rate in meters/second
         mavClimbRate);
-    msgLength = mavlink_msg_to_send_buffer(mavBuffer, &mavMsg);
-    mavlinkSerialWrite(mavBuffer, msgLength);
+    mavlinkSendMessage();
 
 
     uint8_t mavModes = MAV_MODE_FLAG_MANUAL_INPUT_ENABLED;
@@ -470,37 +464,172 @@ void mavlinkSendHUDAndHeartbeat(void)
         mavCustomMode,
         // system_status System status flag, see MAV_STATE ENUM
         mavSystemState);
-    msgLength = mavlink_msg_to_send_buffer(mavBuffer, &mavMsg);
-    mavlinkSerialWrite(mavBuffer, msgLength);
+    mavlinkSendMessage();
 }
 
-void processMAVLinkTelemetry(void)
+typedef struct {
+    uint8_t stream;         // MAV_DATA_STREAM the handler belongs to
+    uint8_t msgid;          // Message id for MAV_CMD_SET_MESSAGE_INTERVAL
+    uint8_t rate;           // Default rate in Hz
+    uint16_t length;        // Bytes sent by the handler
+    void (*send)(void);
+} mavlinkMessage_t;
+
+static const mavlinkMessage_t mavMessages[] = {
+    {
+        MAV_DATA_STREAM_EXTENDED_STATUS, MAVLINK_MSG_ID_SYS_STATUS, 2,
+        MAVLINK_FRAME_LEN(MAVLINK_MSG_ID_SYS_STATUS_LEN),
+        mavlinkSendSystemStatus
+    },
+    {
+        MAV_DATA_STREAM_RC_CHANNELS, MAVLINK_MSG_ID_RC_CHANNELS_RAW, 5,
+        MAVLINK_FRAME_LEN(MAVLINK_MSG_ID_RC_CHANNELS_RAW_LEN),
+        mavlinkSendRCChannelsAndRSSI
+    },
+#ifdef USE_GPS
+    {
+        MAV_DATA_STREAM_POSITION, MAVLINK_MSG_ID_GPS_RAW_INT, 2,
+        MAVLINK_FRAME_LEN(MAVLINK_MSG_ID_GPS_RAW_INT_LEN) +
+        MAVLINK_FRAME_LEN(MAVLINK_MSG_ID_GLOBAL_POSITION_INT_LEN) +
+        MAVLINK_FRAME_LEN(MAVLINK_MSG_ID_GPS_GLOBAL_ORIGIN_LEN),
+        mavlinkSendPosition
+    },
+#endif
+    {
+        MAV_DATA_STREAM_EXTRA1, MAVLINK_MSG_ID_ATTITUDE, 10,
+        MAVLINK_FRAME_LEN(MAVLINK_MSG_ID_ATTITUDE_LEN),
+        mavlinkSendAttitude
+    },
+    {
+        MAV_DATA_STREAM_EXTRA2, MAVLINK_MSG_ID_VFR_HUD, 10,
+        MAVLINK_FRAME_LEN(MAVLINK_MSG_ID_VFR_HUD_LEN) +
+        MAVLINK_FRAME_LEN(MAVLINK_MSG_ID_HEARTBEAT_LEN),
+        mavlinkSendHUDAndHeartbeat
+    },
+    {
+        MAV_DATA_STREAM_RAW_SENSORS, MAVLINK_MSG_ID_SCALED_IMU, 0,
+        MAVLINK_FRAME_LEN(MAVLINK_MSG_ID_SCALED_IMU_LEN),
+        mavlinkSendImu
+    },
+};
+
+#define MAVLINK_MESSAGE_COUNT ARRAYLEN(mavMessages)
+
+/* Message intervals in us, zero when disabled */
+static timeDelta_t mavInterval[MAVLINK_MESSAGE_COUNT];
+static timeUs_t mavNextTime[MAVLINK_MESSAGE_COUNT];
+static bool mavIntervalInit = false;
+
+static timeDelta_t mavlinkRateToInterval(unsigned rate)
 {
-    // is executed @ TELEMETRY_MAVLINK_MAXRATE rate
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTENDED_STATUS)) {
-        mavlinkSendSystemStatus();
+    if (rate == 0)
+        return 0;
+
+    return 1000000 / MIN(rate, TELEMETRY_MAVLINK_MAXRATE);
+}
+
+static void mavlinkSetMessageInterval(unsigned index, timeDelta_t interval, timeUs_t currentTimeUs)
+{
+    mavInterval[index] = interval;
+    mavNextTime[index] = currentTimeUs;
+}
+
+static void mavlinkSetStreamRate(unsigned stream, unsigned rate, timeUs_t currentTimeUs)
+{
+    const timeDelta_t interval = mavlinkRateToInterval(rate);
+
+    for (unsigned i = 0; i < MAVLINK_MESSAGE_COUNT; i++) {
+        if (stream == MAV_DATA_STREAM_ALL || stream == mavMessages[i].stream) {
+            mavlinkSetMessageInterval(i, interval, currentTimeUs);
+        }
     }
+}
 
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_RC_CHANNELS)) {
-        mavlinkSendRCChannelsAndRSSI();
+static void mavlinkResetIntervals(timeUs_t currentTimeUs)
+{
+    for (unsigned i = 0; i < MAVLINK_MESSAGE_COUNT; i++) {
+        mavlinkSetMessageInterval(i, mavlinkRateToInterval(mavMessages[i].rate), currentTimeUs);
     }
+}
 
-#ifdef USE_GPS
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_POSITION)) {
-        mavlinkSendPosition();
+static uint8_t mavlinkCommandSetMessageInterval(const mavlink_command_long_t *cmd, timeUs_t currentTimeUs)
+{
+    // param1: message id, param2: interval in us, -1 to disable, 0 for the default
+    for (unsigned i = 0; i < MAVLINK_MESSAGE_COUNT; i++) {
+        if (mavMessages[i].msgid == (int)cmd->param1) {
+            timeDelta_t interval;
+            if (cmd->param2 < 0)
+                interval = 0;
+            else if (cmd->param2 == 0)
+                interval = mavlinkRateToInterval(mavMessages[i].rate);
+            else
+                interval = MAX(cmd->param2, 1000000 / TELEMETRY_MAVLINK_MAXRATE);
+            mavlinkSetMessageInterval(i, interval, currentTimeUs);
+            return MAV_RESULT_ACCEPTED;
+        }
     }
-#endif
 
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTRA1)) {
-        mavlinkSendAttitude();
+    return MAV_RESULT_UNSUPPORTED;
+}
+
+static void mavlinkHandleMessage(const mavlink_message_t *msg, timeUs_t currentTimeUs)
+{
+    switch (msg->msgid) {
+        case MAVLINK_MSG_ID_REQUEST_DATA_STREAM: {
+            mavlink_request_data_stream_t req;
+            mavlink_msg_request_data_stream_decode(msg, &req);
+            mavlinkSetStreamRate(req.req_stream_id, req.start_stop ? req.req_message_rate : 0, currentTimeUs);
+            break;
+        }
+        case MAVLINK_MSG_ID_COMMAND_LONG: {
+            mavlink_command_long_t cmd;
+            mavlink_msg_command_long_decode(msg, &cmd);
+            const uint8_t result = (cmd.command == MAV_CMD_SET_MESSAGE_INTERVAL) ?
+                mavlinkCommandSetMessageInterval(&cmd, currentTimeUs) : MAV_RESULT_UNSUPPORTED;
+            if (serialTxBytesFree(mavlinkPort) >= MAVLINK_FRAME_LEN(MAVLINK_MSG_ID_COMMAND_ACK_LEN)) {
+                mavlink_msg_command_ack_pack(0, 200, &mavMsg, cmd.command, result);
+                mavlinkSendMessage();
+            }
+            break;
+        }
+        default:
+            break;
     }
+}
+
+static void mavlinkProcessInput(timeUs_t currentTimeUs)
+{
+    mavlink_status_t status;
 
-    if (mavlinkStreamTrigger(MAV_DATA_STREAM_EXTRA2)) {
-        mavlinkSendHUDAndHeartbeat();
+    while (serialRxBytesWaiting(mavlinkPort)) {
+        if (mavlink_parse_char(MAVLINK_COMM_0, serialRead(mavlinkPort), &mavRxMsg, &status)) {
+            mavlinkHandleMessage(&mavRxMsg, currentTimeUs);
+        }
     }
 }
 
-void handleMAVLinkTelemetry(void)
+static void processMAVLinkTelemetry(timeUs_t currentTimeUs)
+{
+    for (unsigned i = 0; i < MAVLINK_MESSAGE_COUNT; i++) {
+        const mavlinkMessage_t *msg = &mavMessages[i];
+
+        if (mavInterval[i] == 0 || cmpTimeUs(currentTimeUs, mavNextTime[i]) < 0)
+            continue;
+
+        // Pace by the UART: a message that doesn't fit now is sent on a later call
+        if (serialTxBytesFree(mavlinkPort) < msg->length)
+            continue;
+
+        msg->send();
+
+        // Keep the phase, but don't burst to catch up after a stall
+        mavNextTime[i] += mavInterval[i];
+        if (cmpTimeUs(currentTimeUs, mavNextTime[i]) >= 0)
+            mavNextTime[i] = currentTimeUs + mavInterval[i];
+    }
+}
+
+void handleMAVLinkTelemetry(timeUs_t currentTimeUs)
 {
     if (!mavlinkTelemetryEnabled) {
         return;
@@ -510,11 +639,16 @@ void handleMAVLinkTelemetry(void)
         return;
     }
 
-    uint32_t now = micros();
-    if ((now - lastMavlinkMessage) >= TELEMETRY_MAVLINK_DELAY) {
-        processMAVLinkTelemetry();
-        lastMavlinkMessage = now;
+    if (!mavIntervalInit) {
+        mavlinkResetIntervals(currentTimeUs);
+        mavIntervalInit = true;
+    }
+
+    if (mavlinkReceiveEnabled) {
+        mavlinkProcessInput(currentTimeUs);
     }
+
+    processMAVLinkTelemetry(currentTimeUs);
 }
 
 #endif
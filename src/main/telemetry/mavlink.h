@@ -20,8 +20,10 @@
 
 #pragma once
 
+#include "common/time.h"
+
 void initMAVLinkTelemetry(void);
-void handleMAVLinkTelemetry(void);
+void handleMAVLinkTelemetry(timeUs_t currentTimeUs);
 void checkMAVLinkTelemetryState(void);
 
 void freeMAVLinkTelemetryPort(void);
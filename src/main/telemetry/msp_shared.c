@@ -121,11 +121,52 @@ enum { // byte position(index) in msp-over-telemetry request payload
     MSP_INDEX_PAYLOAD_V2    = MSP_INDEX_SIZE_V2_HI    + 1, // MSPv2 first byte of payload itself
 };
 
+/*
+ * Requests that complete while the previous response is still being
+ * sent are queued, so that the client can keep several requests in
+ * flight. They are answered in order.
+ */
+#define MSP_TLM_REQUEST_QUEUE_SIZE      4
+#define MSP_TLM_QUEUED_REQUEST_SIZE     64
+
+typedef struct {
+    uint16_t cmd;
+    uint8_t flags;
+    uint8_t version;
+    uint8_t size;
+    uint8_t data[MSP_TLM_QUEUED_REQUEST_SIZE];
+} mspQueuedRequest_t;
+
+/*
+ * Responses that never change are kept after the first time
+ */
+#define MSP_TLM_CACHED_RESPONSE_SIZE    48
+
+typedef struct {
+    uint16_t cmd;
+    uint8_t size;
+    uint8_t data[MSP_TLM_CACHED_RESPONSE_SIZE];
+} mspCachedResponse_t;
+
+static mspCachedResponse_t responseCache[] = {
+    { .cmd = MSP_API_VERSION },
+    { .cmd = MSP_FC_VARIANT },
+    { .cmd = MSP_FC_VERSION },
+    { .cmd = MSP_BUILD_INFO },
+};
+
 STATIC_UNIT_TESTED uint8_t requestBuffer[MSP_TLM_INBUF_SIZE];
 STATIC_UNIT_TESTED uint8_t responseBuffer[MSP_TLM_OUTBUF_SIZE];
 STATIC_UNIT_TESTED mspPacket_t requestPacket;
 STATIC_UNIT_TESTED mspPacket_t responsePacket;
-static uint8_t lastRequestVersion; // MSP version of last request. Temporary solution. It's better to keep it in requestPacket.
+static uint8_t requestVersion;  // MSP version of the request being received
+static uint8_t responseVersion; // MSP version of the response being sent
+static bool responsePending;
+
+static mspQueuedRequest_t requestQueue[MSP_TLM_REQUEST_QUEUE_SIZE];
+static uint8_t requestQueueHead;
+static uint8_t requestQueueCount;
+static uint8_t *requestSkips;
 
 static mspDescriptor_t mspSharedDescriptor = -1;
 
@@ -134,6 +175,10 @@ void initSharedMsp(void)
     responsePacket.buf.ptr = responseBuffer;
     responsePacket.buf.end = ARRAYEND(responseBuffer);
 
+    responsePending = false;
+    requestQueueHead = 0;
+    requestQueueCount = 0;
+
     mspSharedDescriptor = mspDescriptorAlloc();
 }
 
@@ -142,26 +187,65 @@ mspDescriptor_t getMspTelemetryDescriptor(void)
     return mspSharedDescriptor;
 }
 
-static void processMspPacket(void)
+static mspCachedResponse_t *findCachedResponse(mspPacket_t *request)
+{
+    if (sbufBytesRemaining(&request->buf) == 0) {
+        for (unsigned i = 0; i < ARRAYLEN(responseCache); i++) {
+            if (responseCache[i].cmd == request->cmd) {
+                return &responseCache[i];
+            }
+        }
+    }
+    return NULL;
+}
+
+static void processMspPacket(mspPacket_t *request, uint8_t version)
 {
     responsePacket.cmd = 0;
     responsePacket.result = 0;
+    responsePacket.flags = 0;
     responsePacket.buf.ptr = responseBuffer;
     responsePacket.buf.end = ARRAYEND(responseBuffer);
 
-    mspPostProcessFnPtr mspPostProcessFn = NULL;
-    if (mspFcProcessCommand(mspSharedDescriptor, &requestPacket, &responsePacket, &mspPostProcessFn) == MSP_RESULT_ERROR) {
-        sbufWriteU8(&responsePacket.buf, TELEMETRY_MSP_ERROR);
+    mspCachedResponse_t *cached = findCachedResponse(request);
+    if (cached && cached->size) {
+        responsePacket.cmd = request->cmd;
+        sbufWriteData(&responsePacket.buf, cached->data, cached->size);
+    } else {
+        mspPostProcessFnPtr mspPostProcessFn = NULL;
+        if (mspFcProcessCommand(mspSharedDescriptor, request, &responsePacket, &mspPostProcessFn) == MSP_RESULT_ERROR) {
+            sbufWriteU8(&responsePacket.buf, TELEMETRY_MSP_ERROR);
+        }
+        else if (cached) {
+            const int size = responsePacket.buf.ptr - responseBuffer;
+            if (size > 0 && size <= MSP_TLM_CACHED_RESPONSE_SIZE) {
+                memcpy(cached->data, responseBuffer, size);
+                cached->size = size;
+            }
+        }
+        if (mspPostProcessFn) {
+            mspPostProcessFn(NULL);
+        }
     }
-    if (mspPostProcessFn) {
-        mspPostProcessFn(NULL);
+
+    // Coded after the cache, which keeps the plain reply
+    if (version == 2) {
+        mspHuffmanReply(request, &responsePacket, responseBuffer);
     }
 
     sbufSwitchToReader(&responsePacket.buf, responseBuffer);
+
+    responseVersion = version;
+    responsePending = true;
 }
 
 void sendMspErrorResponse(uint8_t error, int16_t cmd)
 {
+    // Can't report it without breaking the response in flight
+    if (responsePending) {
+        return;
+    }
+
     responsePacket.cmd = cmd;
     responsePacket.result = 0;
     responsePacket.buf.ptr = responseBuffer;
@@ -169,14 +253,58 @@ void sendMspErrorResponse(uint8_t error, int16_t cmd)
     sbufWriteU8(&responsePacket.buf, error);
     responsePacket.result = TELEMETRY_MSP_RES_ERROR;
     sbufSwitchToReader(&responsePacket.buf, responseBuffer);
+
+    responseVersion = requestVersion;
+    responsePending = true;
+}
+
+static void queueMspRequest(void)
+{
+    const int size = sbufBytesRemaining(&requestPacket.buf);
+
+    if (requestQueueCount >= MSP_TLM_REQUEST_QUEUE_SIZE || size > MSP_TLM_QUEUED_REQUEST_SIZE) {
+        return; // dropped, the client will retry
+    }
+
+    mspQueuedRequest_t *req = &requestQueue[(requestQueueHead + requestQueueCount) % MSP_TLM_REQUEST_QUEUE_SIZE];
+
+    req->cmd = requestPacket.cmd;
+    req->flags = requestPacket.flags;
+    req->version = requestVersion;
+    req->size = size;
+    memcpy(req->data, requestPacket.buf.ptr, size);
+
+    requestQueueCount++;
+}
+
+static uint16_t processQueuedMspRequest(void)
+{
+    mspQueuedRequest_t *req = &requestQueue[requestQueueHead];
+
+    // Processed from the queue slot, the next request may be arriving in requestBuffer
+    mspPacket_t request = {
+        .buf = { .ptr = req->data, .end = req->data + req->size, },
+        .cmd = req->cmd,
+        .flags = req->flags,
+        .result = 0,
+    };
+
+    processMspPacket(&request, req->version);
+
+    requestQueueHead = (requestQueueHead + 1) % MSP_TLM_REQUEST_QUEUE_SIZE;
+    requestQueueCount--;
+
+    return request.cmd;
 }
 
 // despite its name, the function actually handles telemetry frame payload with MSP in it
 // it reads the MSP into requestPacket stucture and handles it after receiving all the chunks.
+//
+// Returns true if there is a response to send.
 bool handleMspFrame(uint8_t *const payload, uint8_t const payloadLength, uint8_t *const skipsBeforeResponse)
 {
     if (payloadLength < MIN_LENGTH_CHUNK) {
-        return false;   // prevent analyzing garbage data
+        return responsePending;   // prevent analyzing garbage data
     }
 
     static uint8_t mspStarted = 0;
@@ -186,25 +314,28 @@ bool handleMspFrame(uint8_t *const payload, uint8_t const payloadLength, uint8_t
 
     const uint8_t status = payload[MSP_INDEX_STATUS];
     const uint8_t seqNumber = status & MSP_STATUS_SEQUENCE_MASK;
-    lastRequestVersion = (status & MSP_STATUS_VERSION_MASK) >> MSP_STATUS_VERSION_SHIFT;
+    const uint8_t version = (status & MSP_STATUS_VERSION_MASK) >> MSP_STATUS_VERSION_SHIFT;
 
-    if (lastRequestVersion > TELEMETRY_MSP_VERSION) {
+    requestSkips = skipsBeforeResponse;
+
+    if (version > TELEMETRY_MSP_VERSION) {
+        requestVersion = version;
         sendMspErrorResponse(TELEMETRY_MSP_VER_MISMATCH, 0);
-        return true;
+        return responsePending;
     }
 
     if (status & MSP_STATUS_START_MASK) { // first packet in sequence
         uint16_t mspPayloadSize;
-        if (lastRequestVersion == 1) { // MSPv1
+        if (version == 1) { // MSPv1
             if (payloadLength < MIN_LENGTH_REQUEST_V1) {
-                return false;   // prevent analyzing garbage data
+                return responsePending;   // prevent analyzing garbage data
             }
 
             mspPayloadSize = payload[MSP_INDEX_SIZE_V1];
             requestPacket.cmd = payload[MSP_INDEX_ID_V1];
             if (mspPayloadSize == 0xff) { // jumbo frame
                 if (payloadLength < MIN_LENGTH_REQUEST_JUMBO) {
-                    return false;   // prevent analyzing garbage data
+                    return responsePending;   // prevent analyzing garbage data
                 }
                 mspPayloadSize = *(uint16_t*)&payload[MSP_INDEX_SIZE_JUMBO_LO];
                 sbufInit(&sbufInput, payload + MSP_INDEX_PAYLOAD_JUMBO, payload + payloadLength);
@@ -213,13 +344,14 @@ bool handleMspFrame(uint8_t *const payload, uint8_t const payloadLength, uint8_t
             }
         } else { // MSPv2
             if (payloadLength < MIN_LENGTH_REQUEST_V2) {
-                return false;   // prevent analyzing garbage data
+                return responsePending;   // prevent analyzing garbage data
             }
             requestPacket.flags = payload[MSP_INDEX_FLAG_V2];
             requestPacket.cmd = *(uint16_t*)&payload[MSP_INDEX_ID_LO];
             mspPayloadSize = *(uint16_t*)&payload[MSP_INDEX_SIZE_V2_LO];
             sbufInit(&sbufInput, payload + MSP_INDEX_PAYLOAD_V2, payload + payloadLength);
         }
+        requestVersion = version;
         if (mspPayloadSize <= sizeof(requestBuffer)) { // prevent buffer overrun
             requestPacket.result = 0;
             requestPacket.buf.ptr = requestBuffer;
@@ -227,16 +359,20 @@ bool handleMspFrame(uint8_t *const payload, uint8_t const payloadLength, uint8_t
             mspStarted = 1;
         } else { // this MSP packet is too big to fit in the buffer.
             sendMspErrorResponse(TELEMETRY_MSP_REQUEST_IS_TOO_BIG, requestPacket.cmd);
-            return true;
+            return responsePending;
         }
     } else { // second onward chunk
         if (!mspStarted) { // no start packet yet, throw this one away
-            return false;
+            return responsePending;
         } else {
+            if (seqNumber == lastSeq) {
+                // repeated chunk, already have it
+                return responsePending;
+            }
             if (((lastSeq + 1) & MSP_STATUS_SEQUENCE_MASK) != seqNumber) {
                 // packet loss detected!
                 mspStarted = 0;
-                return false;
+                return responsePending;
             }
         }
         sbufInit(&sbufInput, payload + 1, payload + payloadLength);
@@ -250,7 +386,7 @@ bool handleMspFrame(uint8_t *const payload, uint8_t const payloadLength, uint8_t
     if (payloadExpecting > payloadIncoming) {
         sbufWriteData(&requestPacket.buf, sbufInput.ptr, payloadIncoming);
         sbufAdvance(&sbufInput, payloadIncoming);
-        return false;
+        return responsePending;
     } else { // this is the last/only chunk 
         if (payloadExpecting) {
             sbufWriteData(&requestPacket.buf, sbufInput.ptr, payloadExpecting);
@@ -258,14 +394,20 @@ bool handleMspFrame(uint8_t *const payload, uint8_t const payloadLength, uint8_t
         }
     }
 
+    mspStarted = 0;
+    sbufSwitchToReader(&requestPacket.buf, requestBuffer);
+
+    if (responsePending) {
+        queueMspRequest();
+        return true;
+    }
+
     // Skip a few telemetry requests if command is MSP_EEPROM_WRITE
     if (requestPacket.cmd == MSP_EEPROM_WRITE && skipsBeforeResponse) {
         *skipsBeforeResponse = TELEMETRY_REQUEST_SKIPS_AFTER_EEPROMWRITE;
     }
 
-    mspStarted = 0;
-    sbufSwitchToReader(&requestPacket.buf, requestBuffer);
-    processMspPacket();
+    processMspPacket(&requestPacket, requestVersion);
     return true;
 }
 
@@ -273,6 +415,19 @@ bool sendMspReply(const uint8_t payloadSizeMax, mspResponseFnPtr responseFn)
 {
     static uint8_t seq = 0;
 
+    if (!responsePending) {
+        if (requestQueueCount == 0) {
+            return false;
+        }
+        const uint16_t cmd = processQueuedMspRequest();
+
+        // Same as in handleMspFrame, hold the response after a write to eeprom
+        if (cmd == MSP_EEPROM_WRITE && requestSkips) {
+            *requestSkips = TELEMETRY_REQUEST_SKIPS_AFTER_EEPROMWRITE;
+            return true;
+        }
+    }
+
     uint8_t payloadArray[payloadSizeMax];
     sbuf_t payloadBufStruct;
     sbuf_t *payloadBuf = sbufInit(&payloadBufStruct, payloadArray, payloadArray + payloadSizeMax);
@@ -281,14 +436,14 @@ bool sendMspReply(const uint8_t payloadSizeMax, mspResponseFnPtr responseFn)
     if (responsePacket.buf.ptr == responseBuffer) {
         // this is the first frame of the response packet. Add proper header and size.
         // header
-        uint8_t status = MSP_STATUS_START_MASK | (seq++ & MSP_STATUS_SEQUENCE_MASK) | (lastRequestVersion << MSP_STATUS_VERSION_SHIFT);
+        uint8_t status = MSP_STATUS_START_MASK | (seq++ & MSP_STATUS_SEQUENCE_MASK) | (responseVersion << MSP_STATUS_VERSION_SHIFT);
         if (responsePacket.result < 0) {
             status |= MSP_STATUS_ERROR_MASK;
         }
         sbufWriteU8(payloadBuf, status);
 
         const int size = sbufBytesRemaining(&responsePacket.buf);  // size might be bigger than 0xff
-        if (lastRequestVersion == 1) { // MSPv1
+        if (responseVersion == 1) { // MSPv1
             if (size >= 0xff) {
                 // Sending Jumbo-frame
                 sbufWriteU8(payloadBuf, 0xff);
@@ -304,7 +459,7 @@ bool sendMspReply(const uint8_t payloadSizeMax, mspResponseFnPtr responseFn)
             sbufWriteU16(payloadBuf, (uint16_t)size);        // size is 16 bit in MSPv2
         }
     } else {
-        sbufWriteU8(payloadBuf, (seq++ & MSP_STATUS_SEQUENCE_MASK) | (lastRequestVersion << MSP_STATUS_VERSION_SHIFT)); // header without 'start' flag
+        sbufWriteU8(payloadBuf, (seq++ & MSP_STATUS_SEQUENCE_MASK) | (responseVersion << MSP_STATUS_VERSION_SHIFT)); // header without 'start' flag
     }
 
     const int inputRemainder = sbufBytesRemaining(&responsePacket.buf);// size might be bigger than 0xff
@@ -323,7 +478,10 @@ bool sendMspReply(const uint8_t payloadSizeMax, mspResponseFnPtr responseFn)
     sbufSwitchToReader(&responsePacket.buf, responseBuffer);// for CRC calculation
 
     responseFn(payloadArray, payloadBuf->ptr - payloadArray);
-    return false;
+
+    // Go on with the next queued request, if any
+    responsePending = false;
+    return requestQueueCount > 0;
 }
 
 #endif
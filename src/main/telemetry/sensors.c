@@ -0,0 +1,83 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Shared telemetry sensor scheduler.
+ *
+ * A backend registers its sensors with a target refresh interval, and
+ * asks for the next sensor whenever it has a slot to send. The sensor
+ * picked is the one with the largest age relative to its interval, so
+ * sensors with short intervals are sent more often, and no sensor is
+ * starved when the link can't keep up with all the intervals.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "platform.h"
+
+#ifdef USE_TELEMETRY
+
+#include "common/maths.h"
+
+#include "telemetry/sensors.h"
+
+// Ages are capped to keep the scores within 32 bits
+#define TELEMETRY_SENSOR_MAX_AGE    60000
+
+void telemetrySensorScheduleInit(telemetrySensorSchedule_t *schedule, telemetrySensor_t *sensors, uint8_t size)
+{
+    schedule->sensors = sensors;
+    schedule->size = size;
+    schedule->count = 0;
+}
+
+bool telemetrySensorAdd(telemetrySensorSchedule_t *schedule, uint16_t id, uint16_t interval)
+{
+    if (schedule->count < schedule->size) {
+        telemetrySensor_t *sensor = &schedule->sensors[schedule->count++];
+        sensor->id = id;
+        sensor->interval = MAX(interval, 1);
+        sensor->lastSent = 0;
+        return true;
+    }
+    return false;
+}
+
+const telemetrySensor_t *telemetrySensorNext(telemetrySensorSchedule_t *schedule, timeMs_t currentTimeMs)
+{
+    telemetrySensor_t *next = NULL;
+    uint32_t nextScore = 0;
+
+    for (int i = 0; i < schedule->count; i++) {
+        telemetrySensor_t *sensor = &schedule->sensors[i];
+        const uint32_t age = MIN(currentTimeMs - sensor->lastSent, (uint32_t)TELEMETRY_SENSOR_MAX_AGE);
+        const uint32_t score = (age << 10) / sensor->interval;
+        if (!next || score > nextScore) {
+            next = sensor;
+            nextScore = score;
+        }
+    }
+
+    if (next) {
+        next->lastSent = currentTimeMs;
+    }
+
+    return next;
+}
+
+#endif
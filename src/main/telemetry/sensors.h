@@ -0,0 +1,44 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/time.h"
+
+// Target refresh intervals in ms, the priority of a sensor
+#define TELEMETRY_SENSOR_FAST       250
+#define TELEMETRY_SENSOR_NORMAL     500
+#define TELEMETRY_SENSOR_SLOW       1000
+
+typedef struct {
+    uint16_t    id;             // backend specific sensor id
+    uint16_t    interval;       // target refresh interval in ms
+    timeMs_t    lastSent;
+} telemetrySensor_t;
+
+typedef struct {
+    telemetrySensor_t  *sensors;
+    uint8_t             size;
+    uint8_t             count;
+} telemetrySensorSchedule_t;
+
+void telemetrySensorScheduleInit(telemetrySensorSchedule_t *schedule, telemetrySensor_t *sensors, uint8_t size);
+bool telemetrySensorAdd(telemetrySensorSchedule_t *schedule, uint16_t id, uint16_t interval);
+const telemetrySensor_t *telemetrySensorNext(telemetrySensorSchedule_t *schedule, timeMs_t currentTimeMs);
@@ -83,6 +83,7 @@
 #include "sensors/sensors.h"
 
 #include "telemetry/msp_shared.h"
+#include "telemetry/sensors.h"
 #include "telemetry/smartport.h"
 #include "telemetry/telemetry.h"
 
@@ -162,28 +163,15 @@ enum
 // if adding more sensors then increase this value (should be equal to the maximum number of ADD_SENSOR calls)
 #define MAX_DATAIDS 25
 
-static uint16_t frSkyDataIdTable[MAX_DATAIDS];
-
 #ifdef USE_ESC_SENSOR_TELEMETRY
-// number of sensors to send between sending the ESC sensors
-#define ESC_SENSOR_PERIOD 7
-
-// if adding more esc sensors then increase this value
-#define MAX_ESC_DATAIDS 4
-
-static uint16_t frSkyEscDataIdTable[MAX_ESC_DATAIDS];
+// if adding more esc sensors then increase this value (one for each motor and the combined sensor)
+#define MAX_ESC_DATAIDS (4 * (MAX_SUPPORTED_MOTORS + 1))
+#else
+#define MAX_ESC_DATAIDS 0
 #endif
 
-typedef struct frSkyTableInfo_s {
-    uint16_t * table;
-    uint8_t size;
-    uint8_t index;
-} frSkyTableInfo_t;
-
-static frSkyTableInfo_t frSkyDataIdTableInfo = { frSkyDataIdTable, 0, 0 };
-#ifdef USE_ESC_SENSOR_TELEMETRY
-static frSkyTableInfo_t frSkyEscDataIdTableInfo = {frSkyEscDataIdTable, 0, 0};
-#endif
+static telemetrySensor_t frSkySensors[MAX_DATAIDS + MAX_ESC_DATAIDS];
+static telemetrySensorSchedule_t frSkySchedule;
 
 #define SMARTPORT_BAUD 57600
 #define SMARTPORT_UART_MODE MODE_RXTX
@@ -312,9 +300,79 @@ void smartPortWriteFrameSerial(const smartPortPayload_t *payload, serialPort_t *
     smartPortSendByte(checksum, NULL, port);
 }
 
+/*
+ * Serial port responder
+ *
+ * The receiver gives a sensor about 4ms after its poll to start the
+ * reply. The poll is detected in the RX interrupt, which sends a frame
+ * prepared earlier by the telemetry task straight away, so a late task
+ * run does not lose the slot. Received MSP requests are handed over to
+ * the task in the same way.
+ */
+
+#define SMARTPORT_TX_FRAME_SIZE (2 * (sizeof(smartPortPayload_t) + 1))
+
+static uint8_t smartPortTxFrame[SMARTPORT_TX_FRAME_SIZE];
+static volatile uint8_t smartPortTxFrameLen = 0;
+
+static smartPortPayload_t smartPortRxPayload;
+static volatile bool smartPortRxPayloadReady = false;
+
+static void smartPortTxFrameAppend(uint8_t c, uint16_t *checksum, uint8_t *len)
+{
+    if (c == FSSP_DLE || c == FSSP_START_STOP) {
+        smartPortTxFrame[(*len)++] = FSSP_DLE;
+        smartPortTxFrame[(*len)++] = c ^ FSSP_DLE_XOR;
+    } else {
+        smartPortTxFrame[(*len)++] = c;
+    }
+
+    if (checksum != NULL) {
+        frskyCheckSumStep(checksum, c);
+    }
+}
+
 static void smartPortWriteFrameInternal(const smartPortPayload_t *payload)
 {
-    smartPortWriteFrameSerial(payload, smartPortSerialPort, 0);
+    const uint8_t *data = (const uint8_t *)payload;
+    uint16_t checksum = 0;
+    uint8_t len = 0;
+
+    for (unsigned i = 0; i < sizeof(smartPortPayload_t); i++) {
+        smartPortTxFrameAppend(*data++, &checksum, &len);
+    }
+    frskyCheckSumFini(&checksum);
+    smartPortTxFrameAppend(checksum, NULL, &len);
+
+    // Publish the frame to the RX interrupt
+    smartPortTxFrameLen = len;
+}
+
+static bool smartPortReadyToSendISR(void)
+{
+    return true;
+}
+
+// Receive ISR callback
+static void smartPortDataReceiveISR(uint16_t c, void *data)
+{
+    UNUSED(data);
+
+    bool clearToSend = false;
+
+    smartPortPayload_t *payload = smartPortDataReceive(c, &clearToSend, smartPortReadyToSendISR, true);
+
+    if (clearToSend) {
+        const uint8_t len = smartPortTxFrameLen;
+        if (len) {
+            serialWriteBuf(smartPortSerialPort, smartPortTxFrame, len);
+            smartPortTxFrameLen = 0;
+        }
+    }
+    else if (payload && !smartPortRxPayloadReady) {
+        smartPortRxPayload = *payload;
+        smartPortRxPayloadReady = true;
+    }
 }
 
 static void smartPortSendPackage(uint16_t id, uint32_t val)
@@ -327,26 +385,25 @@ static void smartPortSendPackage(uint16_t id, uint32_t val)
     smartPortWriteFrame(&payload);
 }
 
-#define ADD_SENSOR(dataId) frSkyDataIdTableInfo.table[frSkyDataIdTableInfo.index++] = dataId
-#define ADD_ESC_SENSOR(dataId) frSkyEscDataIdTableInfo.table[frSkyEscDataIdTableInfo.index++] = dataId
+#define ADD_SENSOR(dataId, interval) telemetrySensorAdd(&frSkySchedule, dataId, interval)
 
 static void initSmartPortSensors(void)
 {
-    frSkyDataIdTableInfo.index = 0;
+    telemetrySensorScheduleInit(&frSkySchedule, frSkySensors, ARRAYLEN(frSkySensors));
 
     //prob need configurator option for these?
     if (telemetryIsSensorEnabled(SENSOR_GOV_MODE)) {
-    ADD_SENSOR(FSSP_DATAID_GOV_MODE);
-    }    
+        ADD_SENSOR(FSSP_DATAID_GOV_MODE, TELEMETRY_SENSOR_FAST);
+    }
 
     if (telemetryIsSensorEnabled(SENSOR_MODE)) {
-        ADD_SENSOR(FSSP_DATAID_T1);
-        ADD_SENSOR(FSSP_DATAID_T2);
+        ADD_SENSOR(FSSP_DATAID_T1, TELEMETRY_SENSOR_NORMAL);
+        ADD_SENSOR(FSSP_DATAID_T2, TELEMETRY_SENSOR_NORMAL);
     }
 
 #if defined(USE_ADC_INTERNAL)
     if (telemetryIsSensorEnabled(SENSOR_TEMPERATURE)) {
-        ADD_SENSOR(FSSP_DATAID_T11);
+        ADD_SENSOR(FSSP_DATAID_T11, TELEMETRY_SENSOR_NORMAL);
     }
 #endif
 
@@ -355,10 +412,10 @@ static void initSmartPortSensors(void)
         if (!telemetryIsSensorEnabled(ESC_SENSOR_VOLTAGE))
 #endif
         {
-            ADD_SENSOR(FSSP_DATAID_VFAS);
+            ADD_SENSOR(FSSP_DATAID_VFAS, TELEMETRY_SENSOR_FAST);
         }
 
-        ADD_SENSOR(FSSP_DATAID_A4);
+        ADD_SENSOR(FSSP_DATAID_A4, TELEMETRY_SENSOR_NORMAL);
     }
 
     if (isBatteryCurrentConfigured() && telemetryIsSensorEnabled(SENSOR_CURRENT)) {
@@ -366,95 +423,91 @@ static void initSmartPortSensors(void)
         if (!telemetryIsSensorEnabled(ESC_SENSOR_CURRENT))
 #endif
         {
-            ADD_SENSOR(FSSP_DATAID_CURRENT);
+            ADD_SENSOR(FSSP_DATAID_CURRENT, TELEMETRY_SENSOR_FAST);
         }
 
         if (telemetryIsSensorEnabled(SENSOR_FUEL)) {
-            ADD_SENSOR(FSSP_DATAID_FUEL);
+            ADD_SENSOR(FSSP_DATAID_FUEL, TELEMETRY_SENSOR_NORMAL);
         }
 
         if (telemetryIsSensorEnabled(SENSOR_CAP_USED)) {
-            ADD_SENSOR(FSSP_DATAID_CAP_USED);
+            ADD_SENSOR(FSSP_DATAID_CAP_USED, TELEMETRY_SENSOR_NORMAL);
         }
     }
 
     if (telemetryIsSensorEnabled(SENSOR_HEADING)) {
-        ADD_SENSOR(FSSP_DATAID_HEADING);
+        ADD_SENSOR(FSSP_DATAID_HEADING, TELEMETRY_SENSOR_NORMAL);
     }
 
 #if defined(USE_ACC)
     if (sensors(SENSOR_ACC)) {
         if (telemetryIsSensorEnabled(SENSOR_PITCH)) {
-            ADD_SENSOR(FSSP_DATAID_PITCH);
+            ADD_SENSOR(FSSP_DATAID_PITCH, TELEMETRY_SENSOR_NORMAL);
         }
         if (telemetryIsSensorEnabled(SENSOR_ROLL)) {
-            ADD_SENSOR(FSSP_DATAID_ROLL);
+            ADD_SENSOR(FSSP_DATAID_ROLL, TELEMETRY_SENSOR_NORMAL);
         }
         if (telemetryIsSensorEnabled(SENSOR_ACC_X)) {
-            ADD_SENSOR(FSSP_DATAID_ACCX);
+            ADD_SENSOR(FSSP_DATAID_ACCX, TELEMETRY_SENSOR_NORMAL);
         }
         if (telemetryIsSensorEnabled(SENSOR_ACC_Y)) {
-            ADD_SENSOR(FSSP_DATAID_ACCY);
+            ADD_SENSOR(FSSP_DATAID_ACCY, TELEMETRY_SENSOR_NORMAL);
         }
         if (telemetryIsSensorEnabled(SENSOR_ACC_Z)) {
-            ADD_SENSOR(FSSP_DATAID_ACCZ);
+            ADD_SENSOR(FSSP_DATAID_ACCZ, TELEMETRY_SENSOR_NORMAL);
         }
     }
 #endif
 
     if (sensors(SENSOR_BARO)) {
         if (telemetryIsSensorEnabled(SENSOR_ALTITUDE)) {
-            ADD_SENSOR(FSSP_DATAID_ALTITUDE);
+            ADD_SENSOR(FSSP_DATAID_ALTITUDE, TELEMETRY_SENSOR_NORMAL);
         }
         if (telemetryIsSensorEnabled(SENSOR_VARIO)) {
-            ADD_SENSOR(FSSP_DATAID_VARIO);
+            ADD_SENSOR(FSSP_DATAID_VARIO, TELEMETRY_SENSOR_NORMAL);
         }
     }
 
 #ifdef USE_GPS
     if (featureIsEnabled(FEATURE_GPS)) {
         if (telemetryIsSensorEnabled(SENSOR_GROUND_SPEED)) {
-            ADD_SENSOR(FSSP_DATAID_SPEED);
+            ADD_SENSOR(FSSP_DATAID_SPEED, TELEMETRY_SENSOR_NORMAL);
         }
         if (telemetryIsSensorEnabled(SENSOR_LAT_LONG)) {
-            ADD_SENSOR(FSSP_DATAID_LATLONG);
-            ADD_SENSOR(FSSP_DATAID_LATLONG); // twice (one for lat, one for long)
+            ADD_SENSOR(FSSP_DATAID_LATLONG, TELEMETRY_SENSOR_NORMAL);
+            ADD_SENSOR(FSSP_DATAID_LATLONG, TELEMETRY_SENSOR_NORMAL); // twice (one for lat, one for long)
         }
         if (telemetryIsSensorEnabled(SENSOR_DISTANCE)) {
-            ADD_SENSOR(FSSP_DATAID_HOME_DIST);
+            ADD_SENSOR(FSSP_DATAID_HOME_DIST, TELEMETRY_SENSOR_NORMAL);
         }
         if (telemetryIsSensorEnabled(SENSOR_ALTITUDE)) {
-            ADD_SENSOR(FSSP_DATAID_GPS_ALT);
+            ADD_SENSOR(FSSP_DATAID_GPS_ALT, TELEMETRY_SENSOR_NORMAL);
         }
     }
 #endif
 
     if (telemetryIsSensorEnabled(SENSOR_ADJUSTMENT)) {
-        ADD_SENSOR(FSSP_DATAID_ADJFUNC);
-        ADD_SENSOR(FSSP_DATAID_ADJVALUE);
+        ADD_SENSOR(FSSP_DATAID_ADJFUNC, TELEMETRY_SENSOR_NORMAL);
+        ADD_SENSOR(FSSP_DATAID_ADJVALUE, TELEMETRY_SENSOR_NORMAL);
     }
 
-    frSkyDataIdTableInfo.size = frSkyDataIdTableInfo.index;
-    frSkyDataIdTableInfo.index = 0;
-
 #ifdef USE_ESC_SENSOR_TELEMETRY
-    frSkyEscDataIdTableInfo.index = 0;
-
-    if (telemetryIsSensorEnabled(ESC_SENSOR_VOLTAGE)) {
-        ADD_ESC_SENSOR(FSSP_DATAID_VFAS);
-    }
-    if (telemetryIsSensorEnabled(ESC_SENSOR_CURRENT)) {
-        ADD_ESC_SENSOR(FSSP_DATAID_CURRENT);
-    }
-    if (telemetryIsSensorEnabled(ESC_SENSOR_RPM)) {
-        ADD_ESC_SENSOR(FSSP_DATAID_RPM);
-    }
-    if (telemetryIsSensorEnabled(ESC_SENSOR_TEMPERATURE)) {
-        ADD_ESC_SENSOR(FSSP_DATAID_TEMP);
+    // The combined ESC sensor carries the headspeed and the totals
+    for (int offset = 0; offset <= getMotorCount(); offset++) {
+        const uint16_t interval = offset ? TELEMETRY_SENSOR_SLOW : TELEMETRY_SENSOR_FAST;
+        if (telemetryIsSensorEnabled(ESC_SENSOR_VOLTAGE)) {
+            ADD_SENSOR(FSSP_DATAID_VFAS + offset, interval);
+        }
+        if (telemetryIsSensorEnabled(ESC_SENSOR_CURRENT)) {
+            ADD_SENSOR(FSSP_DATAID_CURRENT + offset, interval);
+        }
+        if (telemetryIsSensorEnabled(ESC_SENSOR_RPM)) {
+            ADD_SENSOR(FSSP_DATAID_RPM + offset, interval);
+        }
+        if (telemetryIsSensorEnabled(ESC_SENSOR_TEMPERATURE)) {
+            ADD_SENSOR(FSSP_DATAID_TEMP + offset, TELEMETRY_SENSOR_SLOW);
+        }
     }
-
-    frSkyEscDataIdTableInfo.size = frSkyEscDataIdTableInfo.index;
-    frSkyEscDataIdTableInfo.index = 0;
 #endif
 }
 
@@ -504,7 +557,10 @@ static void configureSmartPortTelemetryPort(void)
     if (portConfig) {
         portOptions_e portOptions = (telemetryConfig()->halfDuplex ? SERIAL_BIDIR : SERIAL_UNIDIR) | (telemetryConfig()->telemetry_inverted ? SERIAL_NOT_INVERTED : SERIAL_INVERTED);
 
-        smartPortSerialPort = openSerialPort(portConfig->identifier, FUNCTION_TELEMETRY_SMARTPORT, NULL, NULL, SMARTPORT_BAUD, SMARTPORT_UART_MODE, portOptions);
+        smartPortTxFrameLen = 0;
+        smartPortRxPayloadReady = false;
+
+        smartPortSerialPort = openSerialPort(portConfig->identifier, FUNCTION_TELEMETRY_SMARTPORT, smartPortDataReceiveISR, NULL, SMARTPORT_BAUD, SMARTPORT_UART_MODE, portOptions);
     }
 }
 
@@ -533,13 +589,10 @@ static void smartPortSendMspResponse(uint8_t *data, const uint8_t dataSize) {
 
 void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clearToSend, const timeUs_t *requestTimeout)
 {
-    static uint8_t smartPortIdCycleCnt = 0;
     static uint8_t t1Cnt = 0;
     static uint8_t t2Cnt = 0;
     static uint8_t skipRequests = 0;
-#ifdef USE_ESC_SENSOR_TELEMETRY
-    static uint8_t smartPortIdOffset = 0;
-#endif
+    static bool sendLongitude = false;
 
 #if defined(USE_MSP_OVER_TELEMETRY)
     if (skipRequests) {
@@ -594,40 +647,13 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
         }
 #endif
 
-        // we can send back any data we want, our tables keep track of the order and frequency of each data type we send
-        frSkyTableInfo_t * tableInfo = &frSkyDataIdTableInfo;
-
-#ifdef USE_ESC_SENSOR_TELEMETRY
-        if (smartPortIdCycleCnt >= ESC_SENSOR_PERIOD) {
-            // send ESC sensors
-            tableInfo = &frSkyEscDataIdTableInfo;
-            if (tableInfo->index == tableInfo->size) { // end of ESC table, return to other sensors
-                tableInfo->index = 0;
-                smartPortIdCycleCnt = 0;
-                smartPortIdOffset++;
-                if (smartPortIdOffset == getMotorCount() + 1) { // each motor and ESC_SENSOR_COMBINED
-                    smartPortIdOffset = 0;
-                }
-            }
-        }
-        if (smartPortIdCycleCnt < ESC_SENSOR_PERIOD) {
-            // send other sensors
-            tableInfo = &frSkyDataIdTableInfo;
-#endif
-            if (tableInfo->index == tableInfo->size) { // end of table reached, loop back
-                tableInfo->index = 0;
-            }
-#ifdef USE_ESC_SENSOR_TELEMETRY
-        }
-#endif
-        uint16_t id = tableInfo->table[tableInfo->index];
-#ifdef USE_ESC_SENSOR_TELEMETRY
-        if (smartPortIdCycleCnt >= ESC_SENSOR_PERIOD) {
-            id += smartPortIdOffset;
+        // we can send back any data we want, the schedule keeps track of the order and frequency of each data type we send
+        const telemetrySensor_t *sensor = telemetrySensorNext(&frSkySchedule, millis());
+        if (!sensor) {
+            return;
         }
-#endif
-        smartPortIdCycleCnt++;
-        tableInfo->index++;
+
+        const uint16_t id = sensor->id;
 
         int32_t tmpi;
         uint32_t tmp2 = 0;
@@ -894,8 +920,9 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
                     uint32_t tmpui = 0;
                     // the same ID is sent twice, one for longitude, one for latitude
                     // the MSB of the sent uint32_t helps FrSky keep track
-                    // the even/odd bit of our counter helps us keep track
-                    if (tableInfo->index & 1) {
+                    // alternating between the two helps us keep track
+                    sendLongitude = !sendLongitude;
+                    if (sendLongitude) {
                         tmpui = abs(gpsSol.llh.lon);  // now we have unsigned value and one bit to spare
                         tmpui = (tmpui + tmpui / 2) / 25 | 0x80000000;  // 6/100 = 1.5/25, division by power of 2 is fast
                         if (gpsSol.llh.lon < 0) tmpui |= 0x40000000;
@@ -945,24 +972,24 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
     }
 }
 
-static bool serialReadyToSend(void)
-{
-    return (serialRxBytesWaiting(smartPortSerialPort) == 0);
-}
-
 void handleSmartPortTelemetry(void)
 {
     const timeUs_t requestTimeout = micros() + SMARTPORT_SERVICE_TIMEOUT_US;
 
     if (telemetryState == TELEMETRY_STATE_INITIALIZED_SERIAL && smartPortSerialPort) {
-        smartPortPayload_t *payload = NULL;
-        bool clearToSend = false;
-        while (serialRxBytesWaiting(smartPortSerialPort) > 0 && !payload) {
-            uint8_t c = serialRead(smartPortSerialPort);
-            payload = smartPortDataReceive(c, &clearToSend, serialReadyToSend, true);
+        smartPortPayload_t payload;
+        bool payloadReady = false;
+
+        if (smartPortRxPayloadReady) {
+            payload = smartPortRxPayload;
+            payloadReady = true;
+            smartPortRxPayloadReady = false;
         }
 
-            processSmartPortTelemetry(payload, &clearToSend, &requestTimeout);
+        // Prepare the next frame once the previous one has been sent
+        bool clearToSend = (smartPortTxFrameLen == 0);
+
+        processSmartPortTelemetry(payloadReady ? &payload : NULL, &clearToSend, &requestTimeout);
     }
 }
 #endif
@@ -232,7 +232,7 @@ void telemetryProcess(uint32_t currentTime)
     handleJetiExBusTelemetry();
 #endif
 #ifdef USE_TELEMETRY_MAVLINK
-    handleMAVLinkTelemetry();
+    handleMAVLinkTelemetry(currentTime);
 #endif
 #ifdef USE_TELEMETRY_CRSF
     handleCrsfTelemetry(currentTime);
@@ -47,10 +47,14 @@
 
 /* Includes ------------------------------------------------------------------*/
 
+#include <string.h>
+
 #include "platform.h"
 
 #include "build/atomic.h"
 
+#include "common/maths.h"
+
 #include "usbd_conf.h"
 #include "usbd_core.h"
 #include "usbd_desc.h"
@@ -67,7 +71,11 @@
 #define APP_RX_DATA_SIZE  2048
 #define APP_TX_DATA_SIZE  2048
 
-#define APP_TX_BLOCK_SIZE 512
+#define APP_TX_BLOCK_SIZE 1024
+
+// Partial packets are held back this many polling intervals while more
+// data keeps coming, so that the transfers are made of full packets
+#define APP_TX_FLUSH_TICKS 2
 
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
@@ -257,51 +265,90 @@ static int8_t CDC_Itf_Control (uint8_t cmd, uint8_t* pbuf, uint16_t length)
   * @param  htim: TIM handle
   * @retval None
   */
-void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+static volatile uint32_t txInFlight;    // bytes handed to the IN endpoint
+
+/*
+ * Start the next IN transfer, if the endpoint is idle.
+ *
+ * Without flush only whole packets are sent, the tail is left for the
+ * flush deadline. Runs from the polling timer and, where the USB stack
+ * reports it, from the transfer complete callback, so that the next
+ * transfer follows the previous one without waiting for the timer.
+ */
+static void CDC_Itf_TransmitNext(bool flush)
 {
-    if (htim->Instance != TIMusb) {
+    USBD_CDC_HandleTypeDef *hcdc = (USBD_CDC_HandleTypeDef*)USBD_Device.pCDC_ClassData;
+
+    if (hcdc == NULL || hcdc->TxState != 0) {
         return;
     }
 
+    // endpoint has finished transmitting previous block,
+    // move the ring buffer tail. The stack sends the ZLP itself.
+    if (txInFlight) {
+        UserTxBufPtrOut = (UserTxBufPtrOut + txInFlight) % APP_TX_DATA_SIZE;
+        txInFlight = 0;
+    }
+
+    const uint32_t ptrIn = UserTxBufPtrIn;
     uint32_t buffsize;
-    static uint32_t lastBuffsize = 0;
 
-    USBD_CDC_HandleTypeDef *hcdc = (USBD_CDC_HandleTypeDef*)USBD_Device.pCDC_ClassData;
+    if (UserTxBufPtrOut == ptrIn) {
+        return;
+    }
 
-    if (hcdc->TxState == 0) {
-        // endpoint has finished transmitting previous block
-        if (lastBuffsize) {
-            bool needZeroLengthPacket = lastBuffsize % 64 == 0;
-
-            // move the ring buffer tail based on the previous succesful transmission
-            UserTxBufPtrOut += lastBuffsize;
-            if (UserTxBufPtrOut == APP_TX_DATA_SIZE) {
-                UserTxBufPtrOut = 0;
-            }
-            lastBuffsize = 0;
-
-            if (needZeroLengthPacket) {
-                USBD_CDC_SetTxBuffer(&USBD_Device, (uint8_t*)&UserTxBuffer[UserTxBufPtrOut], 0);
-                return;
-            }
-        }
-        if (UserTxBufPtrOut != UserTxBufPtrIn) {
-            if (UserTxBufPtrOut > UserTxBufPtrIn) { /* Roll-back */
-                buffsize = APP_TX_DATA_SIZE - UserTxBufPtrOut;
-            } else {
-                buffsize = UserTxBufPtrIn - UserTxBufPtrOut;
-            }
-            if (buffsize > APP_TX_BLOCK_SIZE) {
-                buffsize = APP_TX_BLOCK_SIZE;
-            }
-
-            USBD_CDC_SetTxBuffer(&USBD_Device, (uint8_t*)&UserTxBuffer[UserTxBufPtrOut], buffsize);
-
-            if (USBD_CDC_TransmitPacket(&USBD_Device) == USBD_OK) {
-                lastBuffsize = buffsize;
-            }
+    if (UserTxBufPtrOut > ptrIn) { /* Roll-back */
+        buffsize = APP_TX_DATA_SIZE - UserTxBufPtrOut;
+    } else {
+        buffsize = ptrIn - UserTxBufPtrOut;
+    }
+
+    if (buffsize > APP_TX_BLOCK_SIZE) {
+        buffsize = APP_TX_BLOCK_SIZE;
+    }
+
+    if (!flush) {
+        buffsize -= buffsize % CDC_DATA_FS_MAX_PACKET_SIZE;
+        if (buffsize == 0) {
+            return;
         }
     }
+
+    // The transfer may complete before the call returns
+    txInFlight = buffsize;
+
+    USBD_CDC_SetTxBuffer(&USBD_Device, (uint8_t*)&UserTxBuffer[UserTxBufPtrOut], buffsize);
+
+    if (USBD_CDC_TransmitPacket(&USBD_Device) != USBD_OK) {
+        txInFlight = 0;
+    }
+}
+
+/**
+  * @brief  TIM period elapsed callback
+  * @param  htim: TIM handle
+  * @retval None
+  */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance != TIMusb) {
+        return;
+    }
+
+    static uint32_t lastPtrIn;
+    static uint8_t heldTicks;
+
+    // Flush once the writer went quiet, or the tail has waited long enough
+    const uint32_t ptrIn = UserTxBufPtrIn;
+    const bool flush = (ptrIn == lastPtrIn) || (++heldTicks >= APP_TX_FLUSH_TICKS);
+
+    lastPtrIn = ptrIn;
+
+    if (flush) {
+        heldTicks = 0;
+    }
+
+    CDC_Itf_TransmitNext(flush);
 }
 
 /**
@@ -332,6 +379,8 @@ static int8_t CDC_Itf_TransmitCplt(uint8_t *Buf, uint32_t *Len, uint8_t epnum)
     UNUSED(Len);
     UNUSED(epnum);
 
+    CDC_Itf_TransmitNext(false);
+
     return (USBD_OK);
 }
 #endif
@@ -434,15 +483,28 @@ uint32_t CDC_Send_FreeBytes(void)
  */
 uint32_t CDC_Send_DATA(const uint8_t *ptrBuffer, uint32_t sendLength)
 {
-    for (uint32_t i = 0; i < sendLength; i++) {
-        while (CDC_Send_FreeBytes() == 0) {
+    uint32_t sent = 0;
+
+    while (sent < sendLength) {
+        uint32_t freeBytes;
+
+        while ((freeBytes = CDC_Send_FreeBytes()) == 0) {
             // block until there is free space in the ring buffer
             delay(1);
         }
+
+        // Copy as much as fits up to the end of the ring buffer,
+        // then publish it to the transmit side in one go
+        const uint32_t ptrIn = UserTxBufPtrIn;
+        uint32_t count = MIN(sendLength - sent, MIN(freeBytes, APP_TX_DATA_SIZE - ptrIn));
+
+        memcpy((uint8_t *)&UserTxBuffer[ptrIn], &ptrBuffer[sent], count);
+
         ATOMIC_BLOCK(NVIC_BUILD_PRIORITY(6, 0)) { // Paranoia
-            UserTxBuffer[UserTxBufPtrIn] = ptrBuffer[i];
-            UserTxBufPtrIn = (UserTxBufPtrIn + 1) % APP_TX_DATA_SIZE;
+            UserTxBufPtrIn = (ptrIn + count) % APP_TX_DATA_SIZE;
         }
+
+        sent += count;
     }
     return sendLength;
 }
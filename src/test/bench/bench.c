@@ -0,0 +1,325 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "bench.h"
+
+// Each case is run until it has taken at least this long
+#define BENCH_MIN_TIME_NS       200000000ULL
+#define BENCH_MIN_ITERATIONS    1000
+#define BENCH_MAX_ITERATIONS    100000000
+
+// Under emulation the time is virtual, so a fixed count is enough
+#ifdef BENCH_QEMU
+#define BENCH_FIXED_ITERATIONS  20000
+#endif
+
+// Allowed instruction count growth over the baseline, unless the baseline says otherwise
+#define BENCH_DEFAULT_TOLERANCE 2.0
+
+#define BENCH_BASELINE_MAX      64
+
+extern const benchSuite_t benchSuite_filter;
+extern const benchSuite_t benchSuite_sdft;
+extern const benchSuite_t benchSuite_rpm_filter;
+extern const benchSuite_t benchSuite_dyn_notch;
+extern const benchSuite_t benchSuite_pid;
+extern const benchSuite_t benchSuite_mixer;
+extern const benchSuite_t benchSuite_blackbox;
+
+static const benchSuite_t * const benchSuites[] = {
+    &benchSuite_filter,
+    &benchSuite_sdft,
+    &benchSuite_rpm_filter,
+    &benchSuite_dyn_notch,
+    &benchSuite_pid,
+    &benchSuite_mixer,
+    &benchSuite_blackbox,
+};
+
+float benchSamples[BENCH_SAMPLE_COUNT];
+
+volatile float benchSink;
+volatile int32_t benchSinkInt;
+
+static uint32_t benchSeed = 0x12345678;
+
+float benchRandom(void)
+{
+    // xorshift32, uniform in [-1,1)
+    benchSeed ^= benchSeed << 13;
+    benchSeed ^= benchSeed >> 17;
+    benchSeed ^= benchSeed << 5;
+
+    return (int32_t)benchSeed * (1.0f / 2147483648.0f);
+}
+
+float benchSignal(uint32_t n)
+{
+    // Gyro-like signal: slow motion, two vibration lines and noise at 8kHz
+    const float t = n * (1.0f / 8000.0f);
+
+    return 200.0f * sinf(2 * M_PI * 3.0f * t) +
+            20.0f * sinf(2 * M_PI * 112.0f * t) +
+             8.0f * sinf(2 * M_PI * 237.5f * t) +
+             2.0f * benchRandom();
+}
+
+typedef struct {
+    uint32_t iterations;
+    uint64_t ns;
+    uint64_t instructions;
+} benchResult_t;
+
+typedef struct {
+    char name[64];
+    double instructions;        // per op
+    double tolerance;           // percent
+} benchBaseline_t;
+
+static benchBaseline_t benchBaselines[BENCH_BASELINE_MAX];
+static int benchBaselineCount;
+
+static int benchRegressions;
+
+typedef enum {
+    BENCH_OUTPUT_REPORT,
+    BENCH_OUTPUT_CHECK,
+    BENCH_OUTPUT_BASELINE,
+} benchOutput_e;
+
+static benchOutput_e benchOutput = BENCH_OUTPUT_REPORT;
+
+/*
+ * Baseline file: one benchmark per line, "suite/name insn/op [tolerance%]".
+ * Empty lines and lines starting with '#' are ignored.
+ */
+static bool benchLoadBaseline(const char *fileName)
+{
+    FILE *file = fopen(fileName, "r");
+    char line[128];
+
+    if (!file) {
+        printf("Cannot open baseline %s\n", fileName);
+        return false;
+    }
+
+    while (fgets(line, sizeof(line), file) && benchBaselineCount < BENCH_BASELINE_MAX) {
+        benchBaseline_t *baseline = &benchBaselines[benchBaselineCount];
+
+        if (line[0] == '#') {
+            continue;
+        }
+
+        baseline->tolerance = BENCH_DEFAULT_TOLERANCE;
+
+        if (sscanf(line, "%63s %lf %lf", baseline->name, &baseline->instructions, &baseline->tolerance) >= 2) {
+            benchBaselineCount++;
+        }
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+static const benchBaseline_t *benchFindBaseline(const char *fullName)
+{
+    for (int i = 0; i < benchBaselineCount; i++) {
+        if (strcmp(benchBaselines[i].name, fullName) == 0) {
+            return &benchBaselines[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void benchCheckResult(const char *fullName, double instructions)
+{
+    const benchBaseline_t *baseline = benchFindBaseline(fullName);
+
+    if (!baseline) {
+        printf("%10s\n", "new");
+        return;
+    }
+
+    const double change = 100.0 * (instructions - baseline->instructions) / baseline->instructions;
+
+    if (change > baseline->tolerance) {
+        printf("%+9.1f%% REGRESSION (baseline %.1f, tolerance %.1f%%)\n", change, baseline->instructions, baseline->tolerance);
+        benchRegressions++;
+    } else {
+        printf("%+9.1f%%\n", change);
+    }
+}
+
+static benchResult_t benchMeasure(const benchCase_t *bench, uint32_t iterations)
+{
+    benchResult_t result = { .iterations = iterations };
+
+    const uint64_t startInstructions = benchInstructions();
+    const uint64_t startNs = benchNowNs();
+
+    bench->run(iterations);
+
+    result.ns = benchNowNs() - startNs;
+    result.instructions = benchInstructions() - startInstructions;
+
+    return result;
+}
+
+static void benchRunCase(const benchSuite_t *suite, const benchCase_t *bench, const char *fullName, uint32_t fixedIterations)
+{
+    if (bench->setup) {
+        bench->setup();
+    }
+
+    // Warm up caches and branch predictors
+    benchMeasure(bench, BENCH_MIN_ITERATIONS);
+
+    benchResult_t result;
+
+    if (fixedIterations) {
+        result = benchMeasure(bench, fixedIterations);
+    } else {
+        uint32_t iterations = BENCH_MIN_ITERATIONS;
+        while (true) {
+            result = benchMeasure(bench, iterations);
+            if (result.ns >= BENCH_MIN_TIME_NS || iterations >= BENCH_MAX_ITERATIONS) {
+                break;
+            }
+            iterations *= (result.ns < BENCH_MIN_TIME_NS / 100) ? 10 : 2;
+        }
+    }
+
+    const double nsPerOp = (double)result.ns / result.iterations;
+    const double instructionsPerOp = (double)result.instructions / result.iterations;
+
+    if (benchOutput == BENCH_OUTPUT_BASELINE) {
+        printf("%-40s %10.1f %6.1f\n", fullName, instructionsPerOp, BENCH_DEFAULT_TOLERANCE);
+        return;
+    }
+
+    printf("%-12s %-28s %10u %10.1f ", suite->name, bench->name, result.iterations, nsPerOp);
+
+    if (!benchInstructionsAvailable()) {
+        printf("%10s\n", "-");
+    } else if (benchOutput == BENCH_OUTPUT_CHECK) {
+        printf("%10.1f ", instructionsPerOp);
+        benchCheckResult(fullName, instructionsPerOp);
+    } else {
+        printf("%10.1f\n", instructionsPerOp);
+    }
+}
+
+static void benchUsage(const char *name)
+{
+    printf("Usage: %s [-l] [-n iterations] [-c baseline | -b] [filter]\n", name);
+    printf("  -l             list the benchmarks\n");
+    printf("  -n iterations  run a fixed number of iterations\n");
+    printf("  -c baseline    fail if an instruction count exceeds its baseline\n");
+    printf("  -b             print the instruction counts as a new baseline\n");
+    printf("  filter         only run benchmarks whose suite/name contains this\n");
+}
+
+int main(int argc, char *argv[])
+{
+    const char *filter = NULL;
+    uint32_t fixedIterations = 0;
+    bool list = false;
+
+#ifdef BENCH_FIXED_ITERATIONS
+    fixedIterations = BENCH_FIXED_ITERATIONS;
+#endif
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-l") == 0) {
+            list = true;
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            fixedIterations = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            if (!benchLoadBaseline(argv[++i])) {
+                return 1;
+            }
+            benchOutput = BENCH_OUTPUT_CHECK;
+        } else if (strcmp(argv[i], "-b") == 0) {
+            benchOutput = BENCH_OUTPUT_BASELINE;
+        } else if (argv[i][0] == '-') {
+            benchUsage(argv[0]);
+            return 1;
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    benchPlatformInit();
+
+    if (benchOutput != BENCH_OUTPUT_REPORT && !list && !benchInstructionsAvailable()) {
+        printf("Instruction counter not available\n");
+        return 1;
+    }
+
+    for (int i = 0; i < BENCH_SAMPLE_COUNT; i++) {
+        benchSamples[i] = benchSignal(i);
+    }
+
+    if (!list) {
+        if (benchOutput == BENCH_OUTPUT_BASELINE) {
+            printf("# Instruction count budgets of the kernel microbenchmarks, checked by\n");
+            printf("# \"make bench-check\" on a Cortex-M7 under QEMU with -icount shift=0.\n");
+            printf("#\n");
+            printf("# One benchmark per line: suite/name, instructions per op, allowed growth in\n");
+            printf("# percent (%.1f if omitted). Benchmarks without a line are reported as new.\n", BENCH_DEFAULT_TOLERANCE);
+            printf("# Regenerate with \"make bench-baseline\" after an intended change, and review\n");
+            printf("# the diff - the recorded counts depend on the arm-none-eabi-gcc version.\n");
+            printf("#\n");
+            printf("# benchmark                              insn/op  tolerance%%\n");
+        } else if (benchOutput == BENCH_OUTPUT_CHECK) {
+            printf("%-12s %-28s %10s %10s %10s %10s\n", "suite", "benchmark", "iterations", "ns/op", "insn/op", "change");
+        } else {
+            printf("%-12s %-28s %10s %10s %10s\n", "suite", "benchmark", "iterations", "ns/op", "insn/op");
+        }
+    }
+
+    for (unsigned s = 0; s < sizeof(benchSuites) / sizeof(benchSuites[0]); s++) {
+        const benchSuite_t *suite = benchSuites[s];
+        for (int c = 0; c < suite->count; c++) {
+            const benchCase_t *bench = &suite->cases[c];
+            char fullName[64];
+            snprintf(fullName, sizeof(fullName), "%s/%s", suite->name, bench->name);
+            if (filter && !strstr(fullName, filter)) {
+                continue;
+            }
+            if (list) {
+                printf("%s\n", fullName);
+            } else {
+                benchRunCase(suite, bench, fullName, fixedIterations);
+            }
+        }
+    }
+
+    if (benchRegressions) {
+        printf("%d benchmark(s) over budget\n", benchRegressions);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Microbenchmarks for the flight-critical kernels.
+ *
+ * Each case has an optional setup, run once before timing, and a run
+ * function that performs the given number of operations. The harness
+ * reports the cost of one operation in nanoseconds and instructions.
+ */
+
+typedef struct {
+    const char * name;
+    void (*setup)(void);
+    void (*run)(uint32_t iterations);
+} benchCase_t;
+
+typedef struct {
+    const char * name;
+    const benchCase_t * cases;
+    int count;
+} benchSuite_t;
+
+#define BENCH_SUITE(_name, _cases) \
+    const benchSuite_t benchSuite_ ## _name = { #_name, _cases, sizeof(_cases) / sizeof(_cases[0]) }
+
+// Deterministic pseudo-random test signal
+float benchRandom(void);
+float benchSignal(uint32_t n);
+
+// Precomputed test signal, so that generating it is not measured
+#define BENCH_SAMPLE_COUNT  1024
+#define BENCH_SAMPLE(n)     benchSamples[(n) & (BENCH_SAMPLE_COUNT - 1)]
+
+extern float benchSamples[BENCH_SAMPLE_COUNT];
+
+// Keeps the compiler from discarding results
+extern volatile float benchSink;
+extern volatile int32_t benchSinkInt;
+
+// Time and instruction counters of the platform
+void benchPlatformInit(void);
+uint64_t benchNowNs(void);
+bool benchInstructionsAvailable(void);
+uint64_t benchInstructions(void);
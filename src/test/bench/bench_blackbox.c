@@ -0,0 +1,96 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "platform.h"
+
+#include "blackbox/blackbox_encoding.h"
+
+#include "bench.h"
+#include "bench_stubs.h"
+
+// Frame deltas of gyro-like magnitude
+static int32_t sampleDelta(uint32_t n)
+{
+    return (int32_t)(BENCH_SAMPLE(n) * 4);
+}
+
+static void runSignedVB(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++)
+        blackboxWriteSignedVB(sampleDelta(i));
+    benchSinkInt = benchBlackboxBytes;
+}
+
+static void runTag2_3S32(uint32_t iterations)
+{
+    int32_t values[3];
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        values[0] = sampleDelta(i);
+        values[1] = sampleDelta(i + 1);
+        values[2] = sampleDelta(i + 2);
+        blackboxWriteTag2_3S32(values);
+    }
+
+    benchSinkInt = benchBlackboxBytes;
+}
+
+static void runTag8_4S16(uint32_t iterations)
+{
+    int32_t values[4];
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (int j = 0; j < 4; j++)
+            values[j] = (j == 3) ? 0 : sampleDelta(i + j);
+        blackboxWriteTag8_4S16(values);
+    }
+
+    benchSinkInt = benchBlackboxBytes;
+}
+
+static void runTag8_8SVB(uint32_t iterations)
+{
+    int32_t values[8];
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (int j = 0; j < 8; j++)
+            values[j] = (j & 1) ? 0 : sampleDelta(i + j);
+        blackboxWriteTag8_8SVB(values, 8);
+    }
+
+    benchSinkInt = benchBlackboxBytes;
+}
+
+static void runFloat(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++)
+        blackboxWriteFloat(BENCH_SAMPLE(i));
+    benchSinkInt = benchBlackboxBytes;
+}
+
+static const benchCase_t cases[] = {
+    { "signed_vb",          NULL,           runSignedVB },
+    { "tag2_3s32",          NULL,           runTag2_3S32 },
+    { "tag8_4s16",          NULL,           runTag8_4S16 },
+    { "tag8_8svb",          NULL,           runTag8_8SVB },
+    { "float",              NULL,           runFloat },
+};
+
+BENCH_SUITE(blackbox, cases);
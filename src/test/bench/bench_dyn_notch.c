@@ -0,0 +1,89 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "platform.h"
+
+#include "common/axis.h"
+
+#include "flight/dyn_notch_filter.h"
+
+#include "bench.h"
+#include "bench_stubs.h"
+
+// Defaults of the dynamic notch configuration
+static void setupDynNotch(bool parallel)
+{
+    const dynNotchConfig_t config = {
+        .dyn_notch_count = 4,
+        .dyn_notch_q = 20,
+        .dyn_notch_min_hz = 25,
+        .dyn_notch_max_hz = 245,
+        .dyn_notch_parallel = parallel,
+    };
+
+    benchFlightInit();
+
+    dynNotchInit(&config);
+}
+
+static void setupSerial(void)
+{
+    setupDynNotch(false);
+}
+
+static void setupParallel(void)
+{
+    setupDynNotch(true);
+}
+
+static void runFilter(uint32_t iterations)
+{
+    float out = 0;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++)
+            out += dynNotchFilter(axis, BENCH_SAMPLE(i + axis));
+    }
+
+    benchSink = out;
+}
+
+// One gyro loop: filter all axes and run the analysis step
+static void runLoop(uint32_t iterations)
+{
+    float out = 0;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++)
+            out += dynNotchFilter(axis, BENCH_SAMPLE(i + axis));
+        dynNotchUpdate();
+    }
+
+    benchSink = out;
+    benchSinkInt = getMaxFFT();
+}
+
+static const benchCase_t cases[] = {
+    { "filter_xyz",         setupSerial,    runFilter },
+    { "loop",               setupSerial,    runLoop },
+    { "loop_parallel",      setupParallel,  runLoop },
+};
+
+BENCH_SUITE(dyn_notch, cases);
@@ -0,0 +1,132 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "platform.h"
+
+#include "common/filter.h"
+
+#include "bench.h"
+
+#define FILTER_RATE     4000.0f
+#define STACK_COUNT     4
+
+static pt1Filter_t pt1;
+static pt2Filter_t pt2;
+static biquadFilter_t biquad;
+static biquadFilter_t stack[STACK_COUNT];
+static biquadFixedFilter_t stackFixed[STACK_COUNT];
+static filter_t lowpass;
+
+static void setupFilters(void)
+{
+    pt1FilterInit(&pt1, 100, FILTER_RATE);
+    pt2FilterInit(&pt2, 100, FILTER_RATE);
+
+    biquadFilterInit(&biquad, 150, FILTER_RATE, 3.0f, BIQUAD_NOTCH);
+
+    // Gyro notch stack: two RPM-free static notches and a 4th order lowpass
+    biquadFilterInit(&stack[0], 150, FILTER_RATE, 3.0f, BIQUAD_NOTCH);
+    biquadFilterInit(&stack[1], 300, FILTER_RATE, 3.0f, BIQUAD_NOTCH);
+    biquadFilterInit(&stack[2], 120, FILTER_RATE, BUTTER_4A_Q, BIQUAD_LPF);
+    biquadFilterInit(&stack[3], 120, FILTER_RATE, BUTTER_4B_Q, BIQUAD_LPF);
+
+    biquadFixedFilterInit(&stackFixed[0], 150, FILTER_RATE, 3.0f, BIQUAD_NOTCH);
+    biquadFixedFilterInit(&stackFixed[1], 300, FILTER_RATE, 3.0f, BIQUAD_NOTCH);
+    biquadFixedFilterInit(&stackFixed[2], 120, FILTER_RATE, BUTTER_4A_Q, BIQUAD_LPF);
+    biquadFixedFilterInit(&stackFixed[3], 120, FILTER_RATE, BUTTER_4B_Q, BIQUAD_LPF);
+
+    lowpassFilterInit(&lowpass, LPF_BUTTER, 100, FILTER_RATE, 0);
+}
+
+static void runPt1(uint32_t iterations)
+{
+    float out = 0;
+    for (uint32_t i = 0; i < iterations; i++)
+        out += pt1FilterApply(&pt1, BENCH_SAMPLE(i));
+    benchSink = out;
+}
+
+static void runPt2(uint32_t iterations)
+{
+    float out = 0;
+    for (uint32_t i = 0; i < iterations; i++)
+        out += pt2FilterApply(&pt2, BENCH_SAMPLE(i));
+    benchSink = out;
+}
+
+static void runBiquadDF1(uint32_t iterations)
+{
+    float out = 0;
+    for (uint32_t i = 0; i < iterations; i++)
+        out += biquadFilterApplyDF1(&biquad, BENCH_SAMPLE(i));
+    benchSink = out;
+}
+
+static void runBiquadTF2(uint32_t iterations)
+{
+    float out = 0;
+    for (uint32_t i = 0; i < iterations; i++)
+        out += biquadFilterApplyTF2(&biquad, BENCH_SAMPLE(i));
+    benchSink = out;
+}
+
+static void runBiquadUpdate(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++)
+        biquadFilterUpdate(&biquad, 100 + (i & 127), FILTER_RATE, 3.0f, BIQUAD_NOTCH);
+    benchSink = biquad.b0;
+}
+
+static void runStack(uint32_t iterations)
+{
+    float out = 0;
+    for (uint32_t i = 0; i < iterations; i++)
+        out += filterStackApply(stack, BENCH_SAMPLE(i), STACK_COUNT);
+    benchSink = out;
+}
+
+static void runStackFixed(uint32_t iterations)
+{
+    float out = 0;
+    for (uint32_t i = 0; i < iterations; i++)
+        out += filterFixedStackApply(stackFixed, BENCH_SAMPLE(i), STACK_COUNT);
+    benchSink = out;
+}
+
+static void runLowpassIndirect(uint32_t iterations)
+{
+    float out = 0;
+    for (uint32_t i = 0; i < iterations; i++)
+        out += filterApply(&lowpass, BENCH_SAMPLE(i));
+    benchSink = out;
+}
+
+static const benchCase_t cases[] = {
+    { "pt1_apply",          setupFilters,   runPt1 },
+    { "pt2_apply",          setupFilters,   runPt2 },
+    { "biquad_df1_apply",   setupFilters,   runBiquadDF1 },
+    { "biquad_tf2_apply",   setupFilters,   runBiquadTF2 },
+    { "biquad_notch_update", setupFilters,  runBiquadUpdate },
+    { "stack4_apply",       setupFilters,   runStack },
+    { "stack4_fixed_apply", setupFilters,   runStackFixed },
+    { "lowpass_indirect",   setupFilters,   runLowpassIndirect },
+};
+
+BENCH_SUITE(filter, cases);
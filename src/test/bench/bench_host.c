@@ -0,0 +1,77 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "bench.h"
+
+static int perfFd = -1;
+
+void benchPlatformInit(void)
+{
+#ifdef __linux__
+    // Retired user space instructions of this process, if the kernel allows it
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    perfFd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+
+    if (perfFd >= 0) {
+        ioctl(perfFd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(perfFd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+uint64_t benchNowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+bool benchInstructionsAvailable(void)
+{
+    return perfFd >= 0;
+}
+
+uint64_t benchInstructions(void)
+{
+    uint64_t count = 0;
+
+    if (perfFd >= 0 && read(perfFd, &count, sizeof(count)) != sizeof(count)) {
+        count = 0;
+    }
+
+    return count;
+}
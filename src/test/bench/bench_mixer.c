@@ -0,0 +1,77 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "platform.h"
+
+#include "flight/mixer.h"
+#include "flight/pid.h"
+
+#include "bench.h"
+#include "bench_stubs.h"
+
+static void setupMixer(bool rules)
+{
+    benchFlightInit();
+
+    if (rules) {
+        // Throttle scaled by a channel makes the mixer non-linear
+        mixerRule_t *rule = mixerRulesMutable(0);
+        rule->oper = MIXER_OP_MUL;
+        rule->input = MIXER_IN_RC_CHANNEL_AUX1;
+        rule->output = MIXER_MOTOR_OFFSET;
+        rule->weight = 1000;
+    }
+
+    // PID outputs come from the controller in hover
+    pidInit(pidProfiles(0));
+
+    mixerInit();
+}
+
+static void setupCompiled(void)
+{
+    setupMixer(false);
+}
+
+static void setupRules(void)
+{
+    setupMixer(true);
+}
+
+static void runUpdate(uint32_t iterations)
+{
+    float out = 0;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        benchFlight.setpoint[0] = BENCH_SAMPLE(i);
+        benchFlight.setpoint[1] = BENCH_SAMPLE(i + 1);
+        mixerUpdate();
+        out += mixerGetServoOutput(0) + mixerGetServoOutput(1) + mixerGetServoOutput(2);
+    }
+
+    benchSink = out;
+}
+
+static const benchCase_t cases[] = {
+    { "update_compiled",    setupCompiled,  runUpdate },
+    { "update_rules",       setupRules,     runUpdate },
+};
+
+BENCH_SUITE(mixer, cases);
@@ -0,0 +1,83 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "platform.h"
+
+#include "common/axis.h"
+
+#include "flight/pid.h"
+
+#include "sensors/gyro.h"
+
+#include "bench.h"
+#include "bench_stubs.h"
+
+static void setupPid(uint8_t mode)
+{
+    benchFlightInit();
+
+    pidProfilesMutable(0)->pid_mode = mode;
+
+    pidInit(pidProfiles(0));
+}
+
+static void setupMode0(void)
+{
+    setupPid(0);
+}
+
+static void setupMode1(void)
+{
+    setupPid(1);
+}
+
+static void setupMode2(void)
+{
+    setupPid(2);
+}
+
+static void setupMode3(void)
+{
+    setupPid(3);
+}
+
+static void runController(uint32_t iterations)
+{
+    float out = 0;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        gyro.gyroADCf[X] = BENCH_SAMPLE(i);
+        gyro.gyroADCf[Y] = BENCH_SAMPLE(i + 1);
+        gyro.gyroADCf[Z] = BENCH_SAMPLE(i + 2);
+        pidController(pidProfiles(0), i * 250);
+        out += pidGetOutput(PID_ROLL) + pidGetOutput(PID_PITCH) + pidGetOutput(PID_YAW);
+    }
+
+    benchSink = out;
+}
+
+static const benchCase_t cases[] = {
+    { "controller_mode0",   setupMode0,     runController },
+    { "controller_mode1",   setupMode1,     runController },
+    { "controller_mode2",   setupMode2,     runController },
+    { "controller_mode3",   setupMode3,     runController },
+};
+
+BENCH_SUITE(pid, cases);
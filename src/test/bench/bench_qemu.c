@@ -0,0 +1,112 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Cortex-M platform for running the benchmarks on the QEMU mps2-an500
+ * (Cortex-M7) machine, with output over semihosting.
+ *
+ * QEMU does not model the DWT cycle counter. It is run with '-icount shift=0',
+ * which advances the virtual clock by 1ns per instruction, so SysTick time
+ * measures executed instructions: ns/op and insn/op are the same here.
+ */
+
+#include <stdint.h>
+
+#include "bench.h"
+
+#define SYST_CSR    (*(volatile uint32_t *)0xE000E010)
+#define SYST_RVR    (*(volatile uint32_t *)0xE000E014)
+#define SYST_CVR    (*(volatile uint32_t *)0xE000E018)
+#define SCB_CPACR   (*(volatile uint32_t *)0xE000ED88)
+
+// mps2-an500 system clock
+#define BENCH_CPU_HZ        25000000
+#define BENCH_SYSTICK_LOAD  0x00FFFFFF
+
+static volatile uint32_t sysTickWraps;
+
+extern uint32_t __stack;
+extern void _start(void);
+
+void SysTick_Handler(void)
+{
+    sysTickWraps++;
+}
+
+static void Default_Handler(void)
+{
+    while (1);
+}
+
+void Reset_Handler(void)
+{
+    // Enable the FPU before any float code runs
+    SCB_CPACR |= (0xF << 20);
+    __asm volatile ("dsb\n isb");
+
+    // newlib crt0 sets up .bss, semihosting and the command line, then calls main()
+    _start();
+}
+
+__attribute__((section(".isr_vector"), used))
+static void (* const vectorTable[16])(void) = {
+    (void (*)(void))&__stack,
+    Reset_Handler,
+    Default_Handler,    // NMI
+    Default_Handler,    // HardFault
+    Default_Handler,    // MemManage
+    Default_Handler,    // BusFault
+    Default_Handler,    // UsageFault
+    0, 0, 0, 0,
+    Default_Handler,    // SVC
+    Default_Handler,    // DebugMon
+    0,
+    Default_Handler,    // PendSV
+    SysTick_Handler,
+};
+
+void benchPlatformInit(void)
+{
+    SYST_RVR = BENCH_SYSTICK_LOAD;
+    SYST_CVR = 0;
+    SYST_CSR = 0x07;    // processor clock, interrupt, enable
+}
+
+uint64_t benchNowNs(void)
+{
+    uint32_t wraps, ticks;
+
+    // Re-read if SysTick wrapped in between
+    do {
+        wraps = sysTickWraps;
+        ticks = BENCH_SYSTICK_LOAD - SYST_CVR;
+    } while (wraps != sysTickWraps);
+
+    const uint64_t cycles = (uint64_t)wraps * (BENCH_SYSTICK_LOAD + 1) + ticks;
+
+    return cycles * (1000000000ULL / BENCH_CPU_HZ);
+}
+
+bool benchInstructionsAvailable(void)
+{
+    return true;
+}
+
+uint64_t benchInstructions(void)
+{
+    return benchNowNs();
+}
@@ -0,0 +1,113 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "platform.h"
+
+#include "common/axis.h"
+
+#include "flight/rpm_filter.h"
+
+#include "bench.h"
+#include "bench_stubs.h"
+
+static void setupBank(int index, uint8_t source, uint8_t q)
+{
+    rpmFilterConfig_t *config = rpmFilterConfigMutable();
+
+    config->filter_bank_rpm_source[index] = source;
+    config->filter_bank_rpm_ratio[index] = 10000;
+    config->filter_bank_rpm_limit[index] = 1000;
+    config->filter_bank_notch_q[index] = q;
+}
+
+// Main rotor 1x-4x, tail rotor 1x-2x, main motor and tail motor
+static void setupRpmFilter(bool adaptive)
+{
+    benchFlightInit();
+
+    setupBank(0, 11, 25);
+    setupBank(1, 12, 25);
+    setupBank(2, 13, 25);
+    setupBank(3, 14, 25);
+    setupBank(4, 21, 25);
+    setupBank(5, 22, 25);
+    setupBank(6, 10, 50);
+    setupBank(7, 20, 50);
+
+    rpmFilterConfigMutable()->filter_adaptive_q = adaptive;
+
+    rpmFilterInit();
+    rpmFilterUpdate();
+}
+
+static void setupFixedQ(void)
+{
+    setupRpmFilter(false);
+}
+
+static void setupAdaptiveQ(void)
+{
+    setupRpmFilter(true);
+}
+
+static void runGyro(uint32_t iterations)
+{
+    float data[XYZ_AXIS_COUNT];
+    float out = 0;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        data[X] = BENCH_SAMPLE(i);
+        data[Y] = BENCH_SAMPLE(i + 1);
+        data[Z] = BENCH_SAMPLE(i + 2);
+        rpmFilterGyro(data);
+        out += data[X] + data[Y] + data[Z];
+    }
+
+    benchSink = out;
+}
+
+static void runUpdateSteady(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++)
+        rpmFilterUpdate();
+    benchSink = rpmFilterGetBankAmplitude(0);
+}
+
+static void runUpdateTransient(uint32_t iterations)
+{
+    // Headspeed swinging by +-5% every 64 updates
+    for (uint32_t i = 0; i < iterations; i++) {
+        const float rpm = 20000 + 1000 * BENCH_SAMPLE(i * 16) / 200;
+        benchFlight.motorRPM[0] = rpm;
+        benchFlight.motorRPM[1] = rpm;
+        rpmFilterUpdate();
+    }
+    benchSink = rpmFilterGetBankAmplitude(0);
+}
+
+static const benchCase_t cases[] = {
+    { "gyro_8banks",            setupFixedQ,    runGyro },
+    { "gyro_8banks_adaptive",   setupAdaptiveQ, runGyro },
+    { "update_steady",          setupFixedQ,    runUpdateSteady },
+    { "update_transient",       setupFixedQ,    runUpdateTransient },
+    { "update_adaptive",        setupAdaptiveQ, runUpdateTransient },
+};
+
+BENCH_SUITE(rpm_filter, cases);
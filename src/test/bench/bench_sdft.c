@@ -0,0 +1,71 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "platform.h"
+
+#include "common/sdft.h"
+
+#include "bench.h"
+
+// Bin range and batching as used by the dynamic notch
+#define START_BIN       1
+#define END_BIN         (SDFT_BIN_COUNT - 1)
+#define BATCH_COUNT     3
+
+static sdft_t sdft[XYZ_AXIS_COUNT];
+static float spectrum[XYZ_AXIS_COUNT][SDFT_BIN_COUNT];
+
+static void setupSdft(void)
+{
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        sdftInit(&sdft[axis], START_BIN, END_BIN, BATCH_COUNT);
+    }
+}
+
+static void runPush(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++)
+        sdftPush(&sdft[0], BENCH_SAMPLE(i));
+    benchSink = crealf(sdft[0].data[START_BIN]);
+}
+
+static void runPushBatchXYZ(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++) {
+        const float sample[XYZ_AXIS_COUNT] = { BENCH_SAMPLE(i), BENCH_SAMPLE(i + 1), BENCH_SAMPLE(i + 2) };
+        sdftPushBatchXYZ(sdft, sample, i % BATCH_COUNT);
+    }
+    benchSink = crealf(sdft[0].data[START_BIN]);
+}
+
+static void runWinSqXYZ(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++)
+        sdftWinSqXYZ(sdft, spectrum);
+    benchSink = spectrum[0][START_BIN];
+}
+
+static const benchCase_t cases[] = {
+    { "push",               setupSdft,      runPush },
+    { "push_batch_xyz",     setupSdft,      runPushBatchXYZ },
+    { "winsq_xyz",          setupSdft,      runWinSqXYZ },
+};
+
+BENCH_SUITE(sdft, cases);
@@ -0,0 +1,266 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The rest of the flight controller, as seen by the kernels under test.
+ *
+ * The inputs are plain variables that the benchmark cases set up to
+ * represent a helicopter in flight.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+#include "platform.h"
+
+#include "build/debug.h"
+
+#include "blackbox/blackbox_io.h"
+
+#include "fc/rc.h"
+#include "fc/runtime_config.h"
+
+#include "rx/rx.h"
+
+#include "flight/governor.h"
+#include "flight/leveling.h"
+#include "flight/motors.h"
+#include "flight/rescue.h"
+#include "flight/setpoint.h"
+
+#include "scheduler/scheduler.h"
+
+#include "sensors/gyro.h"
+#include "sensors/gyro_init.h"
+
+#include "drivers/time.h"
+
+#include "pg/pg.h"
+
+#include "bench_stubs.h"
+
+uint8_t debugModes[DEBUG_MODE_COUNT];
+uint8_t debugAxis;
+int32_t debug[DEBUG_SLOT_COUNT];
+int32_t *debugBank[DEBUG_COUNT];
+uint32_t __timing[DEBUG_SLOT_COUNT];
+
+uint8_t armingFlags;
+uint16_t flightModeFlags;
+
+float rcCommand[MAX_SUPPORTED_RC_CHANNEL_COUNT];
+
+gyro_t gyro;
+
+benchFlightState_t benchFlight;
+
+uint32_t benchBlackboxBytes;
+
+void benchFlightInit(void)
+{
+    pgResetAll();
+
+    gyro.sampleRateHz = 8000;
+    gyro.filterRateHz = 4000;
+    gyro.targetRateHz = 4000;
+    gyro.sampleLooptime = 125;
+    gyro.filterLooptime = 250;
+    gyro.targetLooptime = 250;
+
+    // 10:1 main gear, 4.5:1 tail gear, 2000rpm headspeed
+    benchFlight.mainGearRatio = 0.1f;
+    benchFlight.tailGearRatio = 0.45f;
+    benchFlight.motorRPM[0] = 20000;
+    benchFlight.motorRPM[1] = 20000;
+
+    benchFlight.setpoint[0] = 120;
+    benchFlight.setpoint[1] = -80;
+    benchFlight.setpoint[2] = 40;
+    benchFlight.setpoint[3] = 150;
+    benchFlight.throttle = 0.6f;
+
+    // AUX1 at full, used by the mixer rules
+    rcCommand[4] = 500;
+}
+
+timeUs_t micros(void)
+{
+    return 0;
+}
+
+float schedulerGetCycleTimeMultiplier(void)
+{
+    return 1.0f;
+}
+
+void setArmingDisabled(armingDisableFlags_e flag)
+{
+    UNUSED(flag);
+}
+
+float gyroGetSampleRateCorrection(void)
+{
+    return 1.0f;
+}
+
+bool gyroOverflowDetected(void)
+{
+    return false;
+}
+
+uint8_t getMotorCount(void)
+{
+    return 2;
+}
+
+bool isMotorFastRpmSourceActive(uint8_t motor)
+{
+    UNUSED(motor);
+    return true;
+}
+
+float getMainGearRatio(void)
+{
+    return benchFlight.mainGearRatio;
+}
+
+float getTailGearRatio(void)
+{
+    return benchFlight.tailGearRatio;
+}
+
+float getMotorRPMf(uint8_t motor)
+{
+    return benchFlight.motorRPM[motor];
+}
+
+float getSetpoint(int axis)
+{
+    return benchFlight.setpoint[axis];
+}
+
+float getRcDeflection(int axis)
+{
+    return benchFlight.setpoint[axis] / 500.0f;
+}
+
+float getThrottle(void)
+{
+    return benchFlight.throttle;
+}
+
+bool isAirborne(void)
+{
+    return true;
+}
+
+bool isSpooledUp(void)
+{
+    return true;
+}
+
+float getSpoolUpRatio(void)
+{
+    return 1.0f;
+}
+
+float getGovernorOutput(void)
+{
+    return benchFlight.throttle;
+}
+
+float getTTAIncrease(void)
+{
+    return 0;
+}
+
+void governorInitProfile(const pidProfile_t *pidProfile)
+{
+    UNUSED(pidProfile);
+}
+
+void governorUpdate(void)
+{
+}
+
+void levelingInit(const pidProfile_t *pidProfile)
+{
+    UNUSED(pidProfile);
+}
+
+float angleModeApply(int axis, float pidSetpoint)
+{
+    UNUSED(axis);
+    return pidSetpoint;
+}
+
+float horizonModeApply(int axis, float pidSetpoint)
+{
+    UNUSED(axis);
+    return pidSetpoint;
+}
+
+void rescueInitProfile(const pidProfile_t *pidProfile)
+{
+    UNUSED(pidProfile);
+}
+
+float rescueApply(uint8_t axis, float setpoint)
+{
+    UNUSED(axis);
+    return setpoint;
+}
+
+int32_t blackboxHeaderBudget;
+
+void blackboxWrite(uint8_t value)
+{
+    benchBlackboxBytes += value | 1;
+}
+
+void blackboxWriteBytes(const uint8_t *data, int length)
+{
+    while (length-- > 0) {
+        benchBlackboxBytes += *data++ | 1;
+    }
+}
+
+int blackboxWriteString(const char *s)
+{
+    int len = 0;
+
+    while (s[len]) {
+        blackboxWrite(s[len++]);
+    }
+
+    return len;
+}
+
+int tfp_format(void *putp, void (*putf) (void *, char), const char *fmt, va_list va)
+{
+    char buf[128];
+
+    const int len = vsnprintf(buf, sizeof(buf), fmt, va);
+
+    for (int i = 0; i < len && i < (int)sizeof(buf) - 1; i++) {
+        putf(putp, buf[i]);
+    }
+
+    return len;
+}
@@ -0,0 +1,37 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Flight state seen by the kernels through the stubbed interfaces
+typedef struct {
+    float mainGearRatio;
+    float tailGearRatio;
+    float motorRPM[2];
+    float setpoint[4];
+    float throttle;
+} benchFlightState_t;
+
+extern benchFlightState_t benchFlight;
+
+// Bytes written through the stubbed blackbox device
+extern uint32_t benchBlackboxBytes;
+
+// Default configuration, 8kHz gyro with 4kHz filtering and a hovering helicopter
+void benchFlightInit(void);
@@ -416,3 +416,54 @@ TEST(AlignSensorTest, AlignmentBitmasks)
     EXPECT_EQ(2, ALIGNMENT_AXIS_ROTATIONS(bits, FD_PITCH));
     EXPECT_EQ(0, ALIGNMENT_AXIS_ROTATIONS(bits, FD_ROLL));
 }
+
+static void testCombinedMatrix(sensor_align_e alignment, const sensorAlignment_t *customAlignment)
+{
+    fp_rotationMatrix_t combined;
+    EXPECT_TRUE(buildSensorAlignmentMatrix(&combined, alignment, customAlignment));
+
+    for (int n = 0; n < 4; n++) {
+        float src[XYZ_AXIS_COUNT] = { (float)(rand() % 5), (float)(rand() % 5), (float)(rand() % 5) };
+        float test[XYZ_AXIS_COUNT] = { src[X], src[Y], src[Z] };
+
+        if (alignment == ALIGN_CUSTOM) {
+            fp_rotationMatrix_t sensorRotationMatrix;
+            buildRotationMatrixFromAlignment(customAlignment, &sensorRotationMatrix);
+            alignSensorViaMatrix(test, &sensorRotationMatrix);
+        } else {
+            alignSensorViaRotation(test, alignment);
+        }
+
+        applyMatrixRotation(src, &combined);
+
+        EXPECT_NEAR(test[X], src[X], TOL) << "Combined alignment does not match in X-Axis. alignment: " << alignment;
+        EXPECT_NEAR(test[Y], src[Y], TOL) << "Combined alignment does not match in Y-Axis. alignment: " << alignment;
+        EXPECT_NEAR(test[Z], src[Z], TOL) << "Combined alignment does not match in Z-Axis. alignment: " << alignment;
+    }
+}
+
+TEST(AlignSensorTest, CombinedMatrixStandardBoard)
+{
+    const sensorAlignment_t customAlignment = SENSOR_ALIGNMENT(10, -20, 135);
+    fp_rotationMatrix_t combined;
+
+    EXPECT_FALSE(buildSensorAlignmentMatrix(&combined, CW90_DEG, &customAlignment));
+    EXPECT_FALSE(buildSensorAlignmentMatrix(&combined, ALIGN_DEFAULT, &customAlignment));
+
+    testCombinedMatrix(ALIGN_CUSTOM, &customAlignment);
+}
+
+// Must run last, the board alignment cannot be reset
+TEST(AlignSensorTest, CombinedMatrixRotatedBoard)
+{
+    const boardAlignment_t boardAlignment = { 5, -30, 45 };   // roll, pitch, yaw
+    const sensorAlignment_t customAlignment = SENSOR_ALIGNMENT(10, -20, 135);
+
+    initBoardAlignment(&boardAlignment);
+
+    for (int alignment = CW0_DEG; alignment <= CW270_DEG_FLIP; alignment++) {
+        testCombinedMatrix((sensor_align_e)alignment, &customAlignment);
+    }
+
+    testCombinedMatrix(ALIGN_CUSTOM, &customAlignment);
+}
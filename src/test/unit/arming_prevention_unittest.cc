@@ -1090,6 +1090,9 @@ extern "C" {
     float scaleRangef(float, float, float, float, float) { return 0.0f; }
     bool crashRecoveryModeActive(void) { return false; }
     int32_t getEstimatedAltitudeCm(void) { return 0; }
+    bool positionNavValid(void) { return false; }
+    float getPositionNorth(void) { return 0.0f; }
+    float getPositionEast(void) { return 0.0f; }
     bool gpsIsHealthy() { return false; }
     bool isAltitudeOffset(void) { return false; }
     float getCosTiltAngle(void) { return 0.0f; }
@@ -1105,6 +1108,6 @@ extern "C" {
     void updateRcRefreshRate(timeUs_t) {};
     uint16_t getAverageSystemLoadPercent(void) { return 0; }
     bool isMotorProtocolEnabled(void) { return true; }
-    void pinioBoxTaskControl(void) {}
+    void pinioBoxUpdate(void) {}
     void schedulerSetNextStateTime(timeDelta_t) {}
 }
@@ -0,0 +1,130 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+    #include "common/bitunpack.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+// Same layout as sbusChannels_t
+typedef struct {
+    unsigned int chan0 : 11;
+    unsigned int chan1 : 11;
+    unsigned int chan2 : 11;
+    unsigned int chan3 : 11;
+    unsigned int chan4 : 11;
+    unsigned int chan5 : 11;
+    unsigned int chan6 : 11;
+    unsigned int chan7 : 11;
+    unsigned int chan8 : 11;
+    unsigned int chan9 : 11;
+    unsigned int chan10 : 11;
+    unsigned int chan11 : 11;
+    unsigned int chan12 : 11;
+    unsigned int chan13 : 11;
+    unsigned int chan14 : 11;
+    unsigned int chan15 : 11;
+    uint8_t flags;
+} __attribute__((__packed__)) testChannels_t;
+
+static void bitPack(uint8_t *data, const uint32_t *values, unsigned count, unsigned bits)
+{
+    for (unsigned n = 0; n < count; n++) {
+        for (unsigned b = 0; b < bits; b++) {
+            const unsigned bitIndex = n * bits + b;
+            if (values[n] & (1U << b)) {
+                data[bitIndex >> 3] |= 1 << (bitIndex & 7);
+            }
+        }
+    }
+}
+
+TEST(BitUnpackTest, MatchesPackedBitfields)
+{
+    testChannels_t channels;
+    memset(&channels, 0, sizeof(channels));
+
+    channels.chan0 = 172;
+    channels.chan1 = 992;
+    channels.chan2 = 1811;
+    channels.chan3 = 0x7FF;
+    channels.chan4 = 0;
+    channels.chan5 = 0x555;
+    channels.chan6 = 0x2AA;
+    channels.chan7 = 1;
+    channels.chan8 = 0x400;
+    channels.chan9 = 123;
+    channels.chan10 = 456;
+    channels.chan11 = 789;
+    channels.chan12 = 1024;
+    channels.chan13 = 2000;
+    channels.chan14 = 1500;
+    channels.chan15 = 0x7FE;
+    channels.flags = 0xFF;
+
+    uint16_t out[16];
+    bitUnpack16(out, (const uint8_t *)&channels, 16, 11);
+
+    EXPECT_EQ(172, out[0]);
+    EXPECT_EQ(992, out[1]);
+    EXPECT_EQ(1811, out[2]);
+    EXPECT_EQ(0x7FF, out[3]);
+    EXPECT_EQ(0, out[4]);
+    EXPECT_EQ(0x555, out[5]);
+    EXPECT_EQ(0x2AA, out[6]);
+    EXPECT_EQ(1, out[7]);
+    EXPECT_EQ(0x400, out[8]);
+    EXPECT_EQ(123, out[9]);
+    EXPECT_EQ(456, out[10]);
+    EXPECT_EQ(789, out[11]);
+    EXPECT_EQ(1024, out[12]);
+    EXPECT_EQ(2000, out[13]);
+    EXPECT_EQ(1500, out[14]);
+    EXPECT_EQ(0x7FE, out[15]);
+}
+
+TEST(BitUnpackTest, AllWidths)
+{
+    for (unsigned bits = 10; bits <= 13; bits++) {
+        const uint32_t mask = (1U << bits) - 1;
+        const unsigned count = 16;
+
+        uint32_t values[count];
+        for (unsigned n = 0; n < count; n++) {
+            values[n] = (n * 0x9E37 + 0x1234) & mask;
+        }
+        values[0] = mask;
+        values[count - 1] = mask;
+
+        // Room for the three byte window of the last field
+        uint8_t data[32];
+        memset(data, 0, sizeof(data));
+        bitPack(data, values, count, bits);
+
+        uint32_t out[count];
+        bitUnpack32(out, data, count, bits);
+
+        for (unsigned n = 0; n < count; n++) {
+            EXPECT_EQ(values[n], out[n]) << "bits " << bits << " channel " << n;
+        }
+    }
+}
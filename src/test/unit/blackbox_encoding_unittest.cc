@@ -246,6 +246,12 @@ PG_REGISTER(blackboxConfig_t, blackboxConfig, PG_BLACKBOX_CONFIG, 0);
 int32_t blackboxHeaderBudget;
 void mspSerialAllocatePorts(void) {}
 void blackboxWrite(uint8_t value) {serialWrite(blackboxPort, value);}
+void blackboxWriteBytes(const uint8_t *data, int length)
+{
+    while (length-- > 0) {
+        serialWrite(blackboxPort, *data++);
+    }
+}
 int blackboxWriteString(const char *s)
 {
     const uint8_t *pos = (uint8_t*)s;
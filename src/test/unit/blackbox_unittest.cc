@@ -37,6 +37,7 @@ extern "C" {
     #include "flight/failsafe.h"
     #include "flight/mixer.h"
     #include "flight/pid.h"
+    #include "flight/setpoint.h"
 
     #include "fc/rc_controls.h"
     #include "fc/rc_modes.h"
@@ -369,6 +370,8 @@ bool isModeActivationConditionPresent(boxId_e) {return false;}
 uint32_t millis(void) {return 0;}
 bool sensors(uint32_t) {return false;}
 void serialWrite(serialPort_t *, uint8_t) {}
+void serialWriteBuf(serialPort_t *, const uint8_t *, int) {}
+uint8_t crc8_update(uint8_t crc, const void *, uint32_t, uint8_t) {return crc;}
 uint32_t serialTxBytesFree(const serialPort_t *) {return 0;}
 bool isSerialTransmitBufferEmpty(const serialPort_t *) {return false;}
 bool featureIsEnabled(uint32_t) {return false;}
@@ -380,8 +383,11 @@ void closeSerialPort(serialPort_t *) {}
 portSharing_e determinePortSharing(const serialPortConfig_t *, serialPortFunction_e ) {return PORTSHARING_UNUSED;}
 failsafePhase_e failsafePhase(void) {return FAILSAFE_IDLE;}
 bool rxAreFlightChannelsValid(void) {return false;}
+static setpointLatency_t setpointLatency;
+const setpointLatency_t *getSetpointLatency(void) {return &setpointLatency;}
 bool rxIsReceivingSignal(void) {return false;}
 bool isRssiConfigured(void) {return false;}
 float getMotorOutputLow(void) {return 0.0;}
 float getMotorOutputHigh(void) {return 0.0;}
+bool schedulerTaskSliceExpired(void) {return false;}
 }
@@ -212,6 +212,8 @@ mag_t mag;
 
 gpsSolutionData_t gpsSol;
 int16_t GPS_verticalSpeedInCmS;
+int32_t GPS_home[2];
+float GPS_scaleLonDown = 1.0f;
 
 uint8_t debugMode;
 int16_t debug[DEBUG16_VALUE_COUNT];
@@ -249,7 +251,7 @@ bool accGetAccumulationAverage(float *) { return false; }
 void mixerSetThrottleAngleCorrection(int) {};
 bool gpsRescueIsRunning(void) { return false; }
 bool isFixedWing(void) { return false; }
-void pinioBoxTaskControl(void) {}
+void pinioBoxUpdate(void) {}
 void schedulerIgnoreTaskExecTime(void) {}
 void schedulerIgnoreTaskStateTime(void) {}
 void schedulerSetNextStateTime(timeDelta_t) {}
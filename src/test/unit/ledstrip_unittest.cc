@@ -396,7 +396,7 @@ bool isFlipOverAfterCrashActive(void) { return false; }
 void ws2811LedStripEnable(void) { }
 
 void setUsedLedCount(unsigned) { }
-void pinioBoxTaskControl(void) {}
+void pinioBoxUpdate(void) {}
 void schedulerIgnoreTaskExecTime(void) {}
 bool schedulerGetIgnoreTaskExecTime() { return false; }
 void schedulerSetNextStateTime(timeDelta_t) {}
@@ -250,3 +250,32 @@ TEST(MathsUnittest, TestFastTrigonometryACos)
     EXPECT_LE(error, 1e-4);
 }
 #endif
+
+TEST(MathsUnittest, TestSinCosApprox)
+{
+    double sinError = 0;
+    double cosError = 0;
+    for (float x = -10 * M_PI; x < 10 * M_PI; x += M_PI / 3000) {
+        float sinx, cosx;
+        sincos_approx(x, &sinx, &cosx);
+        sinError = MAX(sinError, fabs(sinx - sin(x)));
+        cosError = MAX(cosError, fabs(cosx - cos(x)));
+        EXPECT_EQ(sin_approx(x), sinx);
+    }
+    EXPECT_LE(sinError, 3.5e-6);
+    EXPECT_LE(cosError, 3.5e-6);
+}
+
+TEST(MathsUnittest, TestSinCosApproxFast)
+{
+    double sinError = 0;
+    double cosError = 0;
+    for (float x = -10 * M_PI; x < 10 * M_PI; x += M_PI / 3000) {
+        float sinx, cosx;
+        sincos_approx_fast(x, &sinx, &cosx);
+        sinError = MAX(sinError, fabs(sinx - sin(x)));
+        cosError = MAX(cosError, fabs(cosx - cos(x)));
+    }
+    EXPECT_LE(sinError, 1.5e-4);
+    EXPECT_LE(cosError, 1.5e-4);
+}
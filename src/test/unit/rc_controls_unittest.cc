@@ -649,6 +649,6 @@ void resetTryingToArm(void) {}
 void setLedProfile(uint8_t profile) { UNUSED(profile); }
 uint8_t getLedProfile(void) { return 0; }
 void compassStartCalibration(void) {}
-void pinioBoxTaskControl(void) {}
+void pinioBoxUpdate(void) {}
 void schedulerIgnoreTaskExecTime(void) {}
 }
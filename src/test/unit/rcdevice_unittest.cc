@@ -995,6 +995,6 @@ extern "C" {
     bool cmsInMenu;
     uint32_t resumeRefreshAt = 0;
     int getArmingDisableFlags(void) {return 0;}
-    void pinioBoxTaskControl(void) {}
+    void pinioBoxUpdate(void) {}
     attitudeEulerAngles_t attitude = { { 0, 0, 0 } };
 }
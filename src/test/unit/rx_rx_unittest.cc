@@ -266,5 +266,5 @@ extern "C" {
         return 0.0;
     }
 
-    void pinioBoxTaskControl(void) {}
+    void pinioBoxUpdate(void) {}
 }
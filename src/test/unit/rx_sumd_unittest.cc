@@ -75,6 +75,16 @@ uint32_t microsISR(void)
     return micros();
 }
 
+uint32_t serialRxBytesWaiting(const serialPort_t *)
+{
+    return 0;
+}
+
+uint8_t serialRead(serialPort_t *)
+{
+    return 0;
+}
+
 #define SERIAL_BUFFER_SIZE 256
 #define SERIAL_PORT_DUMMY_IDENTIFIER  (serialPortIdentifier_e)0x12
 
@@ -0,0 +1,131 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "platform.h"
+#include "rx/rx_timing.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static void feedFrames(timeUs_t *timeUs, int count, timeDelta_t periodUs, timeDelta_t jitterUs)
+{
+    for (int i = 0; i < count; i++) {
+        *timeUs += periodUs;
+        rxTimingUpdate(*timeUs + ((i & 1) ? jitterUs : -jitterUs));
+    }
+}
+
+TEST(RxTimingTest, AcquiresAndLocks)
+{
+    rxTimingReset();
+
+    timeUs_t timeUs = 1000;
+    rxTimingUpdate(timeUs);
+    EXPECT_EQ(0, rxTimingGetPeriodUs());
+
+    feedFrames(&timeUs, 1, 4000, 0);
+    EXPECT_FLOAT_EQ(4000, rxTimingGetPeriodUs());
+    EXPECT_FALSE(rxTimingIsLocked());
+
+    feedFrames(&timeUs, RX_TIMING_LOCK_COUNT + 1, 4000, 0);
+    EXPECT_TRUE(rxTimingIsLocked());
+    EXPECT_NEAR(4000, rxTimingGetPeriodUs(), 1);
+}
+
+TEST(RxTimingTest, TracksPeriodThroughJitter)
+{
+    rxTimingReset();
+
+    // First delta is 50us off the true period
+    timeUs_t timeUs = 5000;
+    rxTimingUpdate(timeUs);
+    rxTimingUpdate(timeUs + 2050);
+    timeUs += 2000;
+
+    feedFrames(&timeUs, 500, 2000, 100);
+
+    EXPECT_TRUE(rxTimingIsLocked());
+    EXPECT_NEAR(2000, rxTimingGetPeriodUs(), 5);
+    EXPECT_NEAR(100, rxTimingGetJitterUs(), 30);
+}
+
+TEST(RxTimingTest, SkipsMissedFrames)
+{
+    rxTimingReset();
+
+    timeUs_t timeUs = 0x10000;
+    rxTimingUpdate(timeUs);
+    feedFrames(&timeUs, 50, 1000, 0);
+
+    // Three frames lost
+    timeUs += 3000;
+    feedFrames(&timeUs, 1, 1000, 0);
+
+    EXPECT_TRUE(rxTimingIsLocked());
+    EXPECT_EQ(3U, rxTimingGet()->missed);
+    EXPECT_NEAR(1000, rxTimingGetPeriodUs(), 1);
+}
+
+TEST(RxTimingTest, ReacquiresOnRateChange)
+{
+    rxTimingReset();
+
+    timeUs_t timeUs = 1000;
+    rxTimingUpdate(timeUs);
+    feedFrames(&timeUs, 50, 4000, 0);
+    EXPECT_TRUE(rxTimingIsLocked());
+
+    // Link switches to a frame period that is not a multiple of the old one
+    feedFrames(&timeUs, 200, 6500, 0);
+
+    EXPECT_TRUE(rxTimingIsLocked());
+    EXPECT_NEAR(6500, rxTimingGetPeriodUs(), 5);
+}
+
+TEST(RxTimingTest, ReacquiresOnRateDivision)
+{
+    rxTimingReset();
+
+    timeUs_t timeUs = 1000;
+    rxTimingUpdate(timeUs);
+    feedFrames(&timeUs, 50, 4000, 0);
+    EXPECT_TRUE(rxTimingIsLocked());
+
+    // Every other frame skipped from now on
+    feedFrames(&timeUs, 100, 8000, 0);
+
+    EXPECT_TRUE(rxTimingIsLocked());
+    EXPECT_NEAR(8000, rxTimingGetPeriodUs(), 5);
+}
+
+TEST(RxTimingTest, WrapsAroundTimer)
+{
+    rxTimingReset();
+
+    timeUs_t timeUs = UINT32_MAX - 20000;
+    rxTimingUpdate(timeUs);
+    feedFrames(&timeUs, 100, 1000, 10);
+
+    EXPECT_TRUE(rxTimingIsLocked());
+    EXPECT_NEAR(1000, rxTimingGetPeriodUs(), 2);
+}
@@ -30,6 +30,8 @@ extern "C" {
     PG_RESET_TEMPLATE(schedulerConfig_t, schedulerConfig,
         .rxRelaxDeterminism = 25,
         .osdRelaxDeterminism = 25,
+        .deadlineScheduling = 0,
+        .loadShedding = 0,
     );
 }
 
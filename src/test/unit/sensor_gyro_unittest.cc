@@ -32,6 +32,7 @@ extern "C" {
     #include "drivers/accgyro/accgyro_fake.h"
     #include "drivers/accgyro/accgyro_mpu.h"
     #include "drivers/sensor.h"
+    #include "fc/dispatch.h"
     #include "io/beeper.h"
     #include "pg/pg.h"
     #include "pg/pg_ids.h"
@@ -163,4 +164,9 @@ void sensorsSet(uint32_t) {}
 void schedulerResetTaskStatistics(taskId_e) {}
 int getArmingDisableFlags(void) {return 0;}
 void writeEEPROM(void) {}
+void writePGToEEPROM(pgn_t) {}
+bool isConfigDirty(void) {return false;}
+void dispatchEnable(void) {}
+void dispatchAdd(dispatchEntry_t *, int) {}
+uint8_t armingFlags = 0;
 }
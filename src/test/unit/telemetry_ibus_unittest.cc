@@ -374,6 +374,9 @@ protected:
     {
         serialTestResetBuffers();
 
+        //refresh the encoded sensor values
+        handleIbusTelemetry();
+
         memcpy(serialReadStub.buffer, rx, rxCnt);
         serialReadStub.end += rxCnt;
 
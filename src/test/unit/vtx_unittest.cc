@@ -192,7 +192,7 @@ extern "C" {
     void updateRcRefreshRate(timeUs_t) {};
     uint16_t getAverageSystemLoadPercent(void) { return 0; }
     bool isMotorProtocolEnabled(void) { return false; }
-    void pinioBoxTaskControl(void) {}
+    void pinioBoxUpdate(void) {}
     void sbufWriteU8(sbuf_t *, uint8_t) {}
     void sbufWriteU16(sbuf_t *, uint16_t) {}
     void sbufWriteU32(sbuf_t *, uint32_t) {}
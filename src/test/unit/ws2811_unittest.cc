@@ -31,7 +31,9 @@ extern "C" {
 #include "gtest/gtest.h"
 
 extern "C" {
-    void updateLEDDMABuffer(ledStripFormatRGB_e ledFormat, rgbColor24bpp_t *color, unsigned ledIndex);
+    bool updateLEDPackedColor(ledStripFormatRGB_e ledFormat, rgbColor24bpp_t *color, unsigned ledIndex);
+    void ws2811EncodeStart(unsigned ledCount, unsigned bitsPerLed);
+    void ws2811EncodeSlots(uint32_t *buffer, unsigned count);
     void schedulerIgnoreTaskExecTime(void) {}
     void schedulerIgnoreTaskStateTime(void) {}
 }
@@ -41,7 +43,9 @@ TEST(WS2812, updateDMABuffer) {
     rgbColor24bpp_t color1 = { .raw = {0xFF,0xAA,0x55} };
 
     // when
-    updateLEDDMABuffer(LED_GRB, &color1, 0);
+    EXPECT_TRUE(updateLEDPackedColor(LED_GRB, &color1, 0));
+    ws2811EncodeStart(1, 24);
+    ws2811EncodeSlots(ledStripDMABuffer, WS2811_DMA_HALF_SIZE);
 
     // and
     uint8_t byteIndex = 0;
@@ -75,6 +79,14 @@ TEST(WS2812, updateDMABuffer) {
     EXPECT_EQ(BIT_COMPARE_0, ledStripDMABuffer[(byteIndex * 8) + 6]);
     EXPECT_EQ(BIT_COMPARE_1, ledStripDMABuffer[(byteIndex * 8) + 7]);
     byteIndex++;
+
+    // and the reset delay follows the last LED
+    for (unsigned i = byteIndex * 8; i < WS2811_DMA_HALF_SIZE; i++) {
+        EXPECT_EQ(0u, ledStripDMABuffer[i]);
+    }
+
+    // and an unchanged color is not reported
+    EXPECT_FALSE(updateLEDPackedColor(LED_GRB, &color1, 0));
 }
 
 extern "C" {
@@ -90,5 +102,7 @@ bool ws2811LedStripHardwareInit(ioTag_t ioTag) {
 }
 
 void ws2811LedStripDMAEnable(void) {}
+
+uint32_t micros(void) { return 0; }
 }
 
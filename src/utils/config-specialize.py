@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+#
+# This file is part of Rotorflight.
+#
+# Rotorflight is free software. You can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# Rotorflight is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software. If not, see <https://www.gnu.org/licenses/>.
+#
+#
+# Config-specialized builds.
+#
+# 1. Save the output of the CLI 'diff all' or 'dump' command into a file.
+#
+# 2. Build with 'make TARGET=xxx CONFIG_SPECIALIZE=diff.txt'.
+#    The Makefile runs this script to generate config_specialized.h, which
+#    is included right after target.h. The objects go to a separate
+#    directory, so a generic build of the same target is not disturbed.
+#
+# Features that the config turns off are compiled out, and so are the serial
+# RX protocols other than the selected one. The dependent options are then
+# dropped by common_post.h as usual. Features not mentioned in the config are
+# left as the target has them, so a plain 'diff' only prunes what it disables.
+#
+# The resulting firmware cannot enable the pruned features later; flash a
+# generic build to change them.
+#
+
+import argparse
+import re
+import sys
+
+# CLI feature name -> compile-time options it depends on
+FEATURE_OPTIONS = {
+    'GPS':          ('USE_GPS', 'USE_GPS_RESCUE'),
+    'RANGEFINDER':  ('USE_RANGEFINDER',),
+    'TELEMETRY':    ('USE_TELEMETRY',),
+    'LED_STRIP':    ('USE_LED_STRIP',),
+    'DASHBOARD':    ('USE_DASHBOARD',),
+    'OSD':          ('USE_OSD', 'USE_MAX7456'),
+    'CMS':          ('USE_CMS',),
+    'RX_SPI':       ('USE_RX_SPI',),
+    'ESC_SENSOR':   ('USE_ESC_SENSOR',),
+    'FREQ_SENSOR':  ('USE_FREQ_SENSOR',),
+    'DYN_NOTCH':    ('USE_DYN_NOTCH_FILTER',),
+    'RPM_FILTER':   ('USE_RPM_FILTER',),
+}
+
+# 'serialrx_provider' value -> compile-time option of the protocol
+SERIALRX_OPTIONS = {
+    'SPEK1024':     'USE_SERIALRX_SPEKTRUM',
+    'SPEK2048':     'USE_SERIALRX_SPEKTRUM',
+    'SRXL':         'USE_SERIALRX_SPEKTRUM',
+    'SBUS':         'USE_SERIALRX_SBUS',
+    'SUMD':         'USE_SERIALRX_SUMD',
+    'SUMH':         'USE_SERIALRX_SUMH',
+    'XB-B':         'USE_SERIALRX_XBUS',
+    'XB-B-RJ01':    'USE_SERIALRX_XBUS',
+    'IBUS':         'USE_SERIALRX_IBUS',
+    'JETIEXBUS':    'USE_SERIALRX_JETIEXBUS',
+    'CRSF':         'USE_SERIALRX_CRSF',
+    'FPORT':        'USE_SERIALRX_FPORT',
+    'SRXL2':        'USE_SERIALRX_SRXL2',
+    'GHST':         'USE_SERIALRX_GHST',
+}
+
+
+def read_config(path):
+    features = {}
+    settings = {}
+    with open(path) as f:
+        for line in f:
+            line = line.split('#', 1)[0].strip()
+            m = re.match(r'feature\s+(-?)(\S+)$', line, re.IGNORECASE)
+            if m:
+                # Later lines win, so a dump (all disabled, then the enabled ones) works too
+                features[m.group(2).upper()] = (m.group(1) != '-')
+                continue
+            m = re.match(r'set\s+(\S+)\s*=\s*(\S+)$', line, re.IGNORECASE)
+            if m:
+                settings[m.group(1).lower()] = m.group(2).upper()
+    return features, settings
+
+
+def specialize(features, settings):
+    excluded = []
+
+    for feature, enabled in sorted(features.items()):
+        if not enabled and feature in FEATURE_OPTIONS:
+            excluded += [(option, 'feature -{}'.format(feature)) for option in FEATURE_OPTIONS[feature]]
+
+    provider = settings.get('serialrx_provider')
+    if features.get('RX_SERIAL') is False:
+        excluded += [(option, 'feature -RX_SERIAL') for option in sorted(set(SERIALRX_OPTIONS.values()))]
+    elif provider in SERIALRX_OPTIONS:
+        selected = SERIALRX_OPTIONS[provider]
+        excluded += [(option, 'serialrx_provider = {}'.format(provider))
+                     for option in sorted(set(SERIALRX_OPTIONS.values())) if option != selected]
+
+    return excluded
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate the options header of a config-specialized build')
+    parser.add_argument('config', help='CLI diff or dump')
+    parser.add_argument('output', help='header to generate')
+    args = parser.parse_args()
+
+    features, settings = read_config(args.config)
+    excluded = specialize(features, settings)
+
+    with open(args.output, 'w') as f:
+        f.write('// Generated by config-specialize.py from {}\n\n'.format(args.config))
+        f.write('#pragma once\n\n')
+        for option, reason in excluded:
+            f.write('#undef {:<28} // {}\n'.format(option, reason))
+
+    print('config-specialize: {} options compiled out'.format(len(excluded)))
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+#
+# This file is part of Rotorflight.
+#
+# Rotorflight is free software. You can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# Rotorflight is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software. If not, see <https://www.gnu.org/licenses/>.
+#
+#
+# Fast RAM placement from function profiling data.
+#
+# 1. Build with 'make TARGET=xxx FUNCTION_PROFILE=yes', fly or bench run,
+#    and save the output of the CLI 'funcprofile' command into a file.
+#
+# 2. Generate the placement list from the profile and the profiling build:
+#
+#      fast-placement.py generate --elf obj/main/rotorflight_xxx.elf \
+#          --map obj/main/rotorflight_xxx.map --profile funcprofile.txt \
+#          --output placement.txt
+#
+#    The hottest functions not already in fast RAM are selected until the
+#    free space in the fast code region (ITCM or CCM) is used up.
+#
+# 3. Build with 'make TARGET=xxx FAST_PLACEMENT=placement.txt'.
+#    The Makefile runs the 'apply' command on the pre-linked object.
+#
+# The placement list has one '<section> <symbol>' pair per line. Data can be
+# added by hand with '.fastram_bss' or '.fastram_data' as the section.
+#
+
+import argparse
+import re
+import subprocess
+import sys
+
+CODE_SECTIONS = ('.tcm_code', '.ccm_code')
+SOURCE_PREFIXES = ('.text.', '.bss.', '.data.', '.rodata.')
+
+
+def run(cmd):
+    return subprocess.run(cmd, check=True, stdout=subprocess.PIPE,
+                          universal_newlines=True).stdout
+
+
+def read_profile(path):
+    counts = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r'\s*func\s+(0x[0-9a-fA-F]+)\s+(\d+)', line)
+            if m:
+                addr = int(m.group(1), 16) & ~1
+                counts[addr] = counts.get(addr, 0) + int(m.group(2))
+    return counts
+
+
+def read_functions(nm, elf):
+    funcs = {}
+    for line in run([nm, '-S', '--defined-only', elf]).splitlines():
+        parts = line.split()
+        if len(parts) == 4 and parts[2] in ('t', 'T', 'W'):
+            addr = int(parts[0], 16) & ~1
+            funcs[addr] = (parts[3], int(parts[1], 16))
+    return funcs
+
+
+def read_map(path):
+    regions = []
+    sections = {}
+    with open(path) as f:
+        lines = f.read().splitlines()
+
+    in_memory = False
+    for line in lines:
+        if line.startswith('Memory Configuration'):
+            in_memory = True
+            continue
+        if in_memory:
+            if line.startswith('Linker script and memory map'):
+                break
+            m = re.match(r'(\S+)\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)', line)
+            if m and m.group(1) != '*default*':
+                regions.append((m.group(1), int(m.group(2), 16), int(m.group(3), 16)))
+
+    # Output sections start at column 0, the address may be wrapped onto the next line
+    pending = None
+    for line in lines:
+        m = re.match(r'(\.\S+)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+))?', line)
+        if m and not line.startswith(' '):
+            if m.group(2):
+                sections[m.group(1)] = (int(m.group(2), 16), int(m.group(3), 16))
+                pending = None
+            else:
+                pending = m.group(1)
+            continue
+        if pending:
+            m = re.match(r'\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)', line)
+            if m:
+                sections[pending] = (int(m.group(1), 16), int(m.group(2), 16))
+            pending = None
+
+    return regions, sections
+
+
+def find_region(regions, addr):
+    for name, origin, length in regions:
+        if origin <= addr < origin + length:
+            return name, origin, length
+    return None
+
+
+def generate(args):
+    counts = read_profile(args.profile)
+    funcs = read_functions(args.nm, args.elf)
+    regions, sections = read_map(args.map)
+
+    section = args.section
+    if section is None:
+        section = next((s for s in CODE_SECTIONS if s in sections), None)
+    if section is None or section not in sections:
+        sys.exit('No fast code section found in {}'.format(args.map))
+
+    region = find_region(regions, sections[section][0])
+    if region is None:
+        sys.exit('No memory region found for {}'.format(section))
+    name, origin, length = region
+
+    used = sum(size for addr, size in sections.values() if origin <= addr < origin + length)
+    free = length - used - args.reserve
+
+    print('{}: region {} size {} used {} free {}'.format(section, name, length, used, max(free, 0)))
+
+    hot = []
+    for addr, count in counts.items():
+        if addr in funcs and find_region([region], addr) is None:
+            sym, size = funcs[addr]
+            if size > 0 and count >= args.min_count:
+                hot.append((count, size, sym))
+
+    # Hottest first, smaller first on equal counts. Each entry is padded to 4 bytes.
+    hot.sort(key=lambda h: (-h[0], h[1]))
+
+    placed = []
+    for count, size, sym in hot:
+        size = (size + 3) & ~3
+        if size <= free:
+            placed.append((count, size, sym))
+            free -= size
+
+    with open(args.output, 'w') as f:
+        f.write('# Generated by fast-placement.py from {}\n'.format(args.profile))
+        for count, size, sym in placed:
+            f.write('{} {}  # calls {} size {}\n'.format(section, sym, count, size))
+
+    print('{}: placed {} functions, {} bytes left'.format(section, len(placed), max(free, 0)))
+
+
+def read_placement(path):
+    placement = []
+    with open(path) as f:
+        for line in f:
+            line = line.split('#', 1)[0].split()
+            if len(line) == 2:
+                placement.append((line[0], line[1]))
+    return placement
+
+
+def apply(args):
+    names = set()
+    for line in run([args.objdump, '-h', args.input]).splitlines():
+        parts = line.split()
+        if len(parts) > 1 and parts[0].isdigit():
+            names.add(parts[1])
+
+    renames = []
+    for section, sym in read_placement(args.placement):
+        source = next((p + sym for p in SOURCE_PREFIXES if p + sym in names), None)
+        if source is None:
+            print('fast-placement: {} not found, skipped'.format(sym))
+            continue
+        renames += ['--rename-section', '{}={}.{}'.format(source, section, sym)]
+
+    run([args.objcopy] + renames + [args.input, args.output])
+    print('fast-placement: {} sections placed'.format(len(renames) // 2))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Fast RAM placement from profiling data')
+    sub = parser.add_subparsers(dest='command')
+    sub.required = True
+
+    gen = sub.add_parser('generate', help='generate a placement list from a profile')
+    gen.add_argument('--elf', required=True, help='ELF file of the profiling build')
+    gen.add_argument('--map', required=True, help='map file of the profiling build')
+    gen.add_argument('--profile', required=True, help='output of the CLI funcprofile command')
+    gen.add_argument('--output', required=True, help='placement list to write')
+    gen.add_argument('--nm', default='arm-none-eabi-nm', help='nm tool')
+    gen.add_argument('--section', help='fast code section (default: auto)')
+    gen.add_argument('--reserve', type=int, default=256, help='bytes to leave free in the region')
+    gen.add_argument('--min-count', type=int, default=1, help='minimum call count to be placed')
+    gen.set_defaults(func=generate)
+
+    app = sub.add_parser('apply', help='rename sections of a relocatable object')
+    app.add_argument('--placement', required=True, help='placement list')
+    app.add_argument('--objdump', default='arm-none-eabi-objdump', help='objdump tool')
+    app.add_argument('--objcopy', default='arm-none-eabi-objcopy', help='objcopy tool')
+    app.add_argument('input', help='input object')
+    app.add_argument('output', help='output object')
+    app.set_defaults(func=apply)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == '__main__':
+    main()
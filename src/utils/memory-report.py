@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+#
+# This file is part of Rotorflight.
+#
+# Rotorflight is free software. You can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# Rotorflight is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software. If not, see <https://www.gnu.org/licenses/>.
+#
+#
+# Memory usage per module from the linker map.
+#
+#   make TARGET=xxx memory_report
+#
+# or directly:
+#
+#   memory-report.py obj/main/rotorflight_xxx.map [--depth 1] [--region DTCM_RAM]
+#
+# Every input section is charged to the memory region holding it, and
+# initialised data also to the flash region it is loaded from. Modules are
+# object files relative to the object directory; '--depth N' sums them up
+# by the first N directory levels (e.g. 'flight', 'drivers').
+#
+
+import argparse
+import os
+import re
+import sys
+
+
+def read_map(path):
+    regions = []
+    sections = []
+
+    with open(path) as f:
+        lines = f.read().splitlines()
+
+    in_memory = False
+    start = 0
+    for index, line in enumerate(lines):
+        if line.startswith('Memory Configuration'):
+            in_memory = True
+            continue
+        if in_memory:
+            if line.startswith('Linker script and memory map'):
+                start = index
+                break
+            m = re.match(r'(\S+)\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)', line)
+            if m and m.group(1) != '*default*':
+                regions.append((m.group(1), int(m.group(2), 16), int(m.group(3), 16)))
+
+    # Output sections start at column 0, input sections at column 1.
+    # The address of either may be wrapped onto the next line.
+    output = None
+    load = None
+    pending = None
+    for line in lines[start:]:
+        if line.startswith('/DISCARD/'):
+            output = None
+            continue
+        m = re.match(r'(\.\S+)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)(?:\s+load address\s+(0x[0-9a-fA-F]+))?)?', line)
+        if m and not line.startswith(' '):
+            output = m.group(1)
+            load = None
+            if m.group(2):
+                load = (int(m.group(4), 16) - int(m.group(2), 16)) if m.group(4) else None
+                pending = None
+            else:
+                pending = ('output', output)
+            continue
+        if pending and pending[0] == 'output':
+            m = re.match(r'\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)(?:\s+load address\s+(0x[0-9a-fA-F]+))?', line)
+            if m and m.group(3):
+                load = int(m.group(3), 16) - int(m.group(1), 16)
+            pending = None
+            continue
+        if output is None:
+            continue
+
+        m = re.match(r' (\S+)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S.*))?$', line)
+        if m and not line.startswith('  '):
+            if m.group(2):
+                pending = None
+                sections.append((int(m.group(2), 16), int(m.group(3), 16), m.group(4), load))
+            elif m.group(1) not in ('*fill*',):
+                pending = ('input', m.group(1))
+            continue
+        if pending and pending[0] == 'input':
+            m = re.match(r'\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S.*)$', line)
+            if m:
+                sections.append((int(m.group(1), 16), int(m.group(2), 16), m.group(3), load))
+            pending = None
+
+    return regions, sections
+
+
+def find_region(regions, addr):
+    for name, origin, length in regions:
+        if length and origin <= addr < origin + length:
+            return name
+    return None
+
+
+def module_name(obj, depth):
+    # Archive members are charged to the archive
+    m = re.match(r'(.*\.a)\(.*\)$', obj)
+    if m:
+        return os.path.basename(m.group(1))
+
+    obj = obj.replace('\\', '/')
+    m = re.search(r'obj/main/[^/]+/(.*)$', obj)
+    name = m.group(1) if m else os.path.basename(obj)
+
+    if depth:
+        parts = name.split('/')
+        if len(parts) > depth:
+            name = '/'.join(parts[:depth])
+
+    return name
+
+
+def report(args):
+    regions, sections = read_map(args.map)
+
+    usage = {}
+    totals = {}
+    for addr, size, obj, load in sections:
+        if size == 0:
+            continue
+        charged = [find_region(regions, addr)]
+        if load:
+            charged.append(find_region(regions, addr + load))
+        module = module_name(obj, args.depth)
+        for region in charged:
+            if region is None:
+                continue
+            usage.setdefault(module, {})
+            usage[module][region] = usage[module].get(region, 0) + size
+            totals[region] = totals.get(region, 0) + size
+
+    names = [name for name, origin, length in regions if name in totals]
+    if args.region:
+        names = [name for name in names if name in args.region]
+        if not names:
+            sys.exit('No usage found in region {}'.format(', '.join(args.region)))
+
+    width = max([len(m) for m in usage] + [6])
+    print('{:<{}}'.format('Module', width) + ''.join('{:>12}'.format(name[:11]) for name in names))
+
+    rows = [(module, regions_used) for module, regions_used in usage.items()
+            if any(regions_used.get(name, 0) for name in names)]
+    rows.sort(key=lambda row: (-sum(row[1].get(name, 0) for name in names), row[0]))
+    if args.top:
+        rows = rows[:args.top]
+
+    for module, regions_used in rows:
+        print('{:<{}}'.format(module, width) + ''.join('{:>12}'.format(regions_used.get(name, 0)) for name in names))
+
+    print()
+    print('{:<{}}'.format('Used', width) + ''.join('{:>12}'.format(totals[name]) for name in names))
+    lengths = dict((name, length) for name, origin, length in regions)
+    print('{:<{}}'.format('Size', width) + ''.join('{:>12}'.format(lengths[name]) for name in names))
+    print('{:<{}}'.format('Free', width) + ''.join('{:>12}'.format(lengths[name] - totals[name]) for name in names))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Memory usage per module from the linker map')
+    parser.add_argument('map', help='linker map file')
+    parser.add_argument('--depth', type=int, default=0, help='sum up modules by this many directory levels')
+    parser.add_argument('--region', action='append', help='only report this memory region (can be repeated)')
+    parser.add_argument('--top', type=int, default=0, help='only report the largest N modules')
+    args = parser.parse_args()
+
+    report(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())